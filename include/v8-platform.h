@@ -42,6 +42,18 @@ class Task {
   virtual void Run() = 0;
 };
 
+/**
+ * An IdleTask represents a unit of work to be performed in idle time.
+ * The Run method is invoked with the amount of idle time in milliseconds
+ * that is left. The idle task is expected to complete within that time.
+ */
+class IdleTask {
+ public:
+  virtual ~IdleTask() {}
+
+  virtual void Run(double idle_time_in_ms) = 0;
+};
+
 /**
  * V8 Platform abstraction layer.
  *
@@ -77,6 +89,24 @@ class Platform {
    */
   virtual void CallOnForegroundThread(Isolate* isolate, Task* task) = 0;
 
+  /**
+   * Schedules a task to be invoked on a foreground thread wrt a specific
+   * |isolate| when the embedder is idle. Requires that
+   * IdleTasksEnabled(isolate) is true. Idle tasks may be reordered relative
+   * to other task types and may be starved for an arbitrarily long time if
+   * no idle time is available.
+   * The definition of "foreground" is opaque to V8.
+   */
+  virtual void CallIdleOnForegroundThread(Isolate* isolate, IdleTask* task) {
+    // This must be overridden if IdleTasksEnabled() returns true.
+    delete task;
+  }
+
+  /**
+   * Returns true if idle tasks are enabled for the given |isolate|.
+   */
+  virtual bool IdleTasksEnabled(Isolate* isolate) { return false; }
+
  protected:
   virtual ~Platform() {}
 };
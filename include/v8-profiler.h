@@ -105,6 +105,8 @@ class V8_EXPORT CpuProfile {
   /**
     * Returns number of samples recorded. The samples are not recorded unless
     * |record_samples| parameter of CpuProfiler::StartCpuProfiling is true.
+    * With --cpu-profiler-max-samples only the most recent samples are kept,
+    * oldest first.
     */
   int GetSamplesCount() const;
 
@@ -114,6 +116,12 @@ class V8_EXPORT CpuProfile {
     */
   const CpuProfileNode* GetSample(int index) const;
 
+  /**
+    * Returns the time when the sample at the given index was recorded (in
+    * microseconds since the Epoch).
+    */
+  int64_t GetSampleTimestamp(int index) const;
+
   /**
     * Returns time when the profile recording started (in microseconds
     * since the Epoch).
@@ -134,6 +142,8 @@ class V8_EXPORT CpuProfile {
 };
 
 
+struct DeoptimizationStats;
+
 /**
  * Interface for controlling CPU profiling. Instance of the
  * profiler can be retrieved using v8::Isolate::GetCpuProfiler.
@@ -171,6 +181,17 @@ class V8_EXPORT CpuProfiler {
    */
   void SetIdle(bool is_idle);
 
+  /**
+   * Fills |stats| with up to |max_entries| deoptimization points ordered by
+   * the number of deoptimizations, most frequent first, and returns the
+   * number of entries written. Deoptimizations are recorded regardless of
+   * whether profiling is active.
+   */
+  int GetTopDeoptimizations(DeoptimizationStats* stats, int max_entries);
+
+  /** Forgets all deoptimizations recorded so far. */
+  void ClearDeoptimizationStats();
+
  private:
   CpuProfiler();
   ~CpuProfiler();
@@ -339,6 +360,7 @@ class V8_EXPORT HeapSnapshot {
 
 
 class RetainedObjectInfo;
+struct AllocationSiteStats;
 
 /**
  * Interface for controlling heap profiling. Instance of the
@@ -467,6 +489,14 @@ class V8_EXPORT HeapProfiler {
    */
   void SetRetainedObjectInfo(UniqueId id, RetainedObjectInfo* info);
 
+  /**
+   * Fills |stats| with up to |max_sites| allocation sites ordered by the
+   * number of bytes that survived scavenges, largest first, and returns the
+   * number of entries written. The ids can be used to find the sites in a
+   * heap snapshot taken afterwards.
+   */
+  int GetTopAllocationSites(AllocationSiteStats* stats, int max_sites);
+
  private:
   HeapProfiler();
   ~HeapProfiler();
@@ -562,6 +592,44 @@ struct HeapStatsUpdate {
 };
 
 
+/**
+ * A struct for exporting pretenuring statistics of an allocation site.
+ * See HeapProfiler::GetTopAllocationSites.
+ */
+struct AllocationSiteStats {
+  AllocationSiteStats() : id(0), survived_bytes(0), tenured(false) { }
+  SnapshotObjectId id;  // Id of the allocation site object.
+  size_t survived_bytes;  // Bytes allocated at the site that survived.
+  bool tenured;  // Whether the site currently allocates in old space.
+};
+
+
+/**
+ * A struct for exporting deoptimization counts of a single deoptimization
+ * point in a function. See CpuProfiler::GetTopDeoptimizations.
+ */
+struct DeoptimizationStats {
+  enum BailoutType { kEager, kLazy, kSoft, kDebugger };
+
+  DeoptimizationStats()
+      : script_id(0), function_position(0), bailout_id(0),
+        bailout_type(kEager), count(0), function_deopt_count(0),
+        optimization_disabled(false) { }
+  int script_id;  // Id of the script containing the function.
+  int function_position;  // Start position of the function in the script.
+  int bailout_id;  // AST id of the point the code deoptimized at.
+  BailoutType bailout_type;
+  int count;  // Number of deoptimizations at this point.
+  int function_deopt_count;  // Deoptimizations of the whole function.
+  // Whether the function was given up on after too many reoptimizations.
+  bool optimization_disabled;
+
+  // Deoptimizing repeatedly at the same point means the function keeps
+  // being reoptimized with the same wrong assumption.
+  bool IsDeoptLoop() const { return count > 1; }
+};
+
+
 }  // namespace v8
 
 
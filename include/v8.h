@@ -85,6 +85,7 @@ namespace v8 {
 
 class AccessorSignature;
 class Array;
+class ArrayBuffer;
 class Boolean;
 class BooleanObject;
 class Context;
@@ -105,9 +106,11 @@ class NumberObject;
 class Object;
 class ObjectOperationDescriptor;
 class ObjectTemplate;
+class OutputStream;
 class Platform;
 class Primitive;
 class RawOperationDescriptor;
+class ScriptOrigin;
 class Signature;
 class StackFrame;
 class StackTrace;
@@ -151,6 +154,9 @@ template<typename T> class CustomArguments;
 class PropertyCallbackArguments;
 class FunctionCallbackArguments;
 class GlobalHandles;
+class ExternalUtf8StringAdapter;
+class ValueDeserializer;
+class ValueSerializer;
 }
 
 
@@ -455,6 +461,23 @@ class WeakCallbackData {
 };
 
 
+template<class P>
+class PhantomCallbackData {
+ public:
+  typedef void (*Callback)(const PhantomCallbackData<P>& data);
+
+  V8_INLINE Isolate* GetIsolate() const { return isolate_; }
+  V8_INLINE P* GetParameter() const { return parameter_; }
+
+ private:
+  friend class internal::GlobalHandles;
+  PhantomCallbackData(Isolate* isolate, P* parameter)
+    : isolate_(isolate), parameter_(parameter) { }
+  Isolate* isolate_;
+  P* parameter_;
+};
+
+
 /**
  * An object reference that is independent of any handle scope.  Where
  * a Local handle only lives as long as the HandleScope in which it was
@@ -529,6 +552,19 @@ template <class T> class PersistentBase {
 
   V8_INLINE void ClearWeak();
 
+  /**
+   * Like SetWeak, but the object cannot be resurrected. Once the object is
+   * only reachable through phantom handles the garbage collector clears
+   * the handle, and the callback only receives the parameter. The callback
+   * must Reset the handle. No local handle is created for the dying
+   * object, and the callbacks run in one batch at the end of garbage
+   * collection, so phantom handles are cheaper than weak handles.
+   */
+  template<typename P>
+  V8_INLINE void SetPhantom(
+      P* parameter,
+      typename PhantomCallbackData<P>::Callback callback);
+
   /**
    * Marks the reference to this object independent. Garbage collector is free
    * to ignore any object groups containing this object. Weak callback for an
@@ -897,6 +933,33 @@ class V8_EXPORT EscapableHandleScope : public HandleScope {
 };
 
 
+/**
+ * A SealHandleScope acts like a handle scope in which no handle allocations
+ * are allowed. Handles can still be created in inner HandleScopes.
+ *
+ * Hot callbacks that do not create handles can use it instead of opening a
+ * HandleScope of their own. Debug builds of V8 then report any handle that
+ * would leak into the enclosing scope; in release builds it does nothing.
+ */
+class V8_EXPORT SealHandleScope {
+ public:
+  SealHandleScope(Isolate* isolate);
+  ~SealHandleScope();
+
+ private:
+  // Make it hard to create heap-allocated or illegal handle scopes by
+  // disallowing certain operations.
+  SealHandleScope(const SealHandleScope&);
+  void operator=(const SealHandleScope&);
+  void* operator new(size_t size);
+  void operator delete(void*, size_t);
+
+  internal::Isolate* isolate_;
+  internal::Object** prev_limit_;
+  int prev_level_;
+};
+
+
 /**
  * A simple Maybe type, representing an object which may or may not have a
  * value.
@@ -924,6 +987,33 @@ class V8_EXPORT Data {
 };
 
 
+/**
+ * Script source that is handed to V8 in chunks as it becomes available,
+ * e.g. while it is still being received from the network.  This allows V8
+ * to start scanning a script before all of it has arrived, without the
+ * embedder first concatenating the chunks.
+ */
+class V8_EXPORT ExternalSourceStream {  // NOLINT
+ public:
+  enum Encoding {
+    ONE_BYTE,  // Latin-1.
+    UTF8
+  };
+
+  virtual ~ExternalSourceStream() {}
+
+  /**
+   * Called by V8 whenever it needs more source.  Sets |*chunk| to the next
+   * chunk of source and returns its length in bytes, or returns 0 at the end
+   * of the source.  The chunk stays owned by the embedder and must remain
+   * valid until the next call to GetMoreData() or until the stream is
+   * deleted.  Chunks do not need to end on UTF-8 character boundaries.
+   * This method may block until more data is available.
+   */
+  virtual size_t GetMoreData(const uint8_t** chunk) = 0;
+};
+
+
 /**
  * Pre-compilation data that can be associated with a script.  This
  * data can be calculated for a script in advance of actually
@@ -944,6 +1034,34 @@ class V8_EXPORT ScriptData {  // NOLINT
    */
   static ScriptData* PreCompile(Handle<String> source);
 
+  /**
+   * Pre-compiles the specified script (context-independent) from its UTF-8
+   * encoded source.  This does not access the V8 heap or any isolate, so it
+   * can run on a background thread while the isolate keeps executing, e.g.
+   * as a task posted with v8::Platform::CallOnBackgroundThread().  The
+   * result can later be passed as pre_data to Script::New() or
+   * Script::Compile() on the thread owning the isolate, so that only
+   * functions called eagerly are fully parsed there.
+   *
+   * V8 must be initialized before calling this method.  Returns NULL if the
+   * script is nested too deeply to be pre-compiled on the current thread's
+   * stack.
+   *
+   * \param source Pointer to UTF-8 script source code.  Ownership is not
+   *   transferred.
+   * \param length Length of the source in bytes.
+   */
+  static ScriptData* PreCompile(const char* source, int length);
+
+  /**
+   * Like PreCompile(const char*, int), but reads the source from |source|
+   * chunk by chunk, so pre-compilation can proceed while the rest of the
+   * source is still arriving.  Like the former, this can run on a
+   * background thread.  Ownership of |source| is not transferred.
+   */
+  static ScriptData* PreCompile(ExternalSourceStream* source,
+                                ExternalSourceStream::Encoding encoding);
+
   /**
    * Load previous pre-compilation data.
    *
@@ -953,6 +1071,25 @@ class V8_EXPORT ScriptData {  // NOLINT
    */
   static ScriptData* New(const char* data, int length);
 
+  /**
+   * Compiles the specified script (context-independent) and serializes the
+   * generated code into a code cache.  The Data() of the code cache can be
+   * stored, e.g. on disk, loaded again with New() in a later process and
+   * passed as pre_data to Script::New() or Script::Compile(), which then
+   * skip parsing and code generation.  The code cache is only accepted by
+   * the same version of V8 for the same source; otherwise it is ignored and
+   * the script is compiled as usual.
+   *
+   * Returns NULL if the script could not be compiled or if its code cannot
+   * be serialized.
+   *
+   * \param source Script source code.
+   * \param origin Script origin, owned by caller, no references are kept
+   *   when GenerateCodeCache() returns.
+   */
+  static ScriptData* GenerateCodeCache(Handle<String> source,
+                                       ScriptOrigin* origin = NULL);
+
   /**
    * Returns the length of Data().
    */
@@ -1290,6 +1427,122 @@ class V8_EXPORT JSON {
    * \return The corresponding value if successfully parsed.
    */
   static Local<Value> Parse(Local<String> json_string);
+
+  /**
+   * Tries to parse the UTF-8 encoded JSON text in the embedder-owned
+   * buffer |data| and returns it as value if successful. The buffer only
+   * needs to stay valid for the duration of the call. ASCII-only buffers
+   * are parsed in place, without copying them into a V8 string first.
+   *
+   * \param data The UTF-8 encoded text to parse.
+   * \param length The length of |data| in bytes, or -1 if it is
+   *   null-terminated.
+   * \return The corresponding value if successfully parsed.
+   */
+  static Local<Value> Parse(Isolate* isolate, const char* data,
+                            int length = -1);
+
+  /**
+   * Serializes |value| like JSON.stringify without replacer and gap
+   * would, but pushes the text into |stream| in chunks of
+   * stream->GetChunkSize() bytes instead of creating a string. Streams
+   * asking for OutputStream::kUtf8 receive UTF-8, kAscii streams receive
+   * 7-bit text with all other characters escaped. The stream must not
+   * call back into V8.
+   *
+   * \return true if the complete text was written and
+   *   OutputStream::EndOfStream was called. false if |value| has no JSON
+   *   representation, serializing it threw an exception or the stream
+   *   aborted.
+   */
+  static bool Stringify(Isolate* isolate, Handle<Value> value,
+                        OutputStream* stream);
+};
+
+
+/**
+ * Writes values in a compact binary format for handing them to another
+ * isolate, where a ValueDeserializer recreates them. Supported are
+ * primitives, strings, plain objects, arrays, ArrayBuffers, typed arrays,
+ * Maps and Sets; repeated and cyclic references are kept. This is much
+ * faster than a JSON round trip and loses no types.
+ */
+class V8_EXPORT ValueSerializer {
+ public:
+  explicit ValueSerializer(Isolate* isolate);
+  ~ValueSerializer();
+
+  /**
+   * Writes the format version. Must be called before the first value.
+   */
+  void WriteHeader();
+
+  /**
+   * Appends |value|. Returns false, with an exception scheduled, if it or
+   * anything reachable from it cannot be cloned.
+   */
+  bool WriteValue(Handle<Value> value);
+
+  /**
+   * Writes |array_buffer| as a reference to |transfer_id| instead of
+   * copying its contents. Moving the backing store, e.g. with
+   * ArrayBuffer::Externalize and Neuter, and handing it to the receiving
+   * ValueDeserializer under the same id is up to the embedder.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<ArrayBuffer> array_buffer);
+
+  /**
+   * The data written so far. It stays valid until the next write or until
+   * the serializer is destroyed.
+   */
+  const uint8_t* GetBuffer();
+  size_t GetBufferSize();
+
+ private:
+  ValueSerializer(const ValueSerializer&);
+  void operator=(const ValueSerializer&);
+
+  internal::ValueSerializer* private_;
+};
+
+
+/**
+ * Reads values written by a ValueSerializer. Malformed data makes it
+ * throw, never crash.
+ */
+class V8_EXPORT ValueDeserializer {
+ public:
+  /**
+   * |data| must stay valid for the lifetime of the deserializer.
+   */
+  ValueDeserializer(Isolate* isolate, const uint8_t* data, size_t size);
+  ~ValueDeserializer();
+
+  /**
+   * Reads the format version. Returns false if the data was not written
+   * by a compatible ValueSerializer.
+   */
+  bool ReadHeader();
+
+  /**
+   * Reads the next value. Returns an empty handle, with an exception
+   * scheduled, if the data is malformed.
+   */
+  Local<Value> ReadValue();
+
+  /**
+   * Resolves references to |transfer_id| to |array_buffer|, which should
+   * wrap the backing store transferred by the sender.
+   */
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<ArrayBuffer> array_buffer);
+
+ private:
+  ValueDeserializer(const ValueDeserializer&);
+  void operator=(const ValueDeserializer&);
+
+  internal::ValueDeserializer* private_;
 };
 
 
@@ -1668,6 +1921,7 @@ class V8_EXPORT String : public Primitive {
     void operator=(const ExternalStringResourceBase&);
 
     friend class v8::internal::Heap;
+    friend class v8::internal::ExternalUtf8StringAdapter;
   };
 
   /**
@@ -1728,6 +1982,27 @@ class V8_EXPORT String : public Primitive {
 
   typedef ExternalAsciiStringResource ExternalOneByteStringResource;
 
+  /**
+   * An ExternalUtf8StringResource is a wrapper around a UTF-8 encoded
+   * buffer that resides outside V8's heap. See NewExternal for how such a
+   * resource is turned into a string. Note that the data must be immutable.
+   */
+  class V8_EXPORT ExternalUtf8StringResource
+      : public ExternalStringResourceBase {
+   public:
+    /**
+     * Override the destructor to manage the life cycle of the underlying
+     * buffer.
+     */
+    virtual ~ExternalUtf8StringResource() {}
+    /** The string data from the underlying buffer.*/
+    virtual const char* data() const = 0;
+    /** The number of bytes in the buffer.*/
+    virtual size_t length() const = 0;
+   protected:
+    ExternalUtf8StringResource() {}
+  };
+
   /**
    * If the string is an external string, return the ExternalStringResourceBase
    * regardless of the encoding, otherwise return NULL.  The encoding of the
@@ -1813,6 +2088,17 @@ class V8_EXPORT String : public Primitive {
   static Local<String> NewExternal(Isolate* isolate,
                                    ExternalAsciiStringResource* resource);
 
+  /**
+   * Creates a new string from the UTF-8 data defined in the given resource.
+   * If the data is pure ASCII the string is an external one-byte string that
+   * uses the buffer without copying it; its GetExternalAsciiStringResource
+   * is owned by V8 and forwards to |resource|. Otherwise the data is decoded
+   * into a regular string right away and the resource is disposed. Either
+   * way the caller should not otherwise delete or modify the resource.
+   */
+  static Local<String> NewExternal(Isolate* isolate,
+                                   ExternalUtf8StringResource* resource);
+
   /**
    * Associate an external string resource with this string by transforming it
    * in place so that existing references to this string in the JavaScript heap
@@ -2218,6 +2504,15 @@ class V8_EXPORT Object : public Value {
    */
   void TurnOnAccessCheck();
 
+  /**
+   * Reorganizes the properties of an object that was switched to a slower
+   * representation, for instance by deleting one of its properties, so
+   * that they can be accessed quickly again.  Useful for objects that will
+   * no longer change shape.  Objects with very many properties keep their
+   * representation.
+   */
+  void OptimizeForPropertyAccess();
+
   /**
    * Returns the identity hash for this object. The current implementation
    * uses a hidden property on the object to store the identity hash.
@@ -2308,6 +2603,19 @@ class V8_EXPORT Object : public Value {
 
   static Local<Object> New(Isolate* isolate);
 
+  /**
+   * Creates an object with the given own properties, added in order, as if
+   * by ForceSet. Objects created from the same sequence of keys share a map
+   * (also with object literals of that shape) and, once that shape has been
+   * seen, are allocated with all of their fields in place instead of going
+   * through one map transition per property. Keys should be internalized
+   * strings (see String::kInternalizedString) to avoid a lookup per key.
+   */
+  static Local<Object> New(Isolate* isolate,
+                           int length,
+                           Handle<String> keys[],
+                           Handle<Value> values[]);
+
   V8_INLINE static Object* Cast(Value* obj);
 
  private:
@@ -2610,12 +2918,28 @@ class V8_EXPORT ArrayBuffer : public Object {
   static Local<ArrayBuffer> New(Isolate* isolate, void* data,
                                 size_t byte_length);
 
+  /**
+   * Create a new shared ArrayBuffer over an existing memory block.
+   * The same memory block may be wrapped by shared ArrayBuffers in several
+   * isolates at once; use the Atomics functions to synchronize accesses.
+   * The buffer is external and can be neither neutered nor externalized.
+   * The embedder owns the memory and must keep it alive until every
+   * isolate that wraps it has been disposed.
+   */
+  static Local<ArrayBuffer> NewShared(Isolate* isolate, void* data,
+                                      size_t byte_length);
+
   /**
    * Returns true if ArrayBuffer is extrenalized, that is, does not
    * own its memory block.
    */
   bool IsExternal() const;
 
+  /**
+   * Returns true if ArrayBuffer was created with NewShared.
+   */
+  bool IsShared() const;
+
   /**
    * Neuters this ArrayBuffer and all its views (typed arrays).
    * Neutering sets the byte length of the buffer and all typed arrays to zero,
@@ -3839,6 +4163,9 @@ typedef void (*MemoryAllocationCallback)(ObjectSpace space,
 // --- Leave Script Callback ---
 typedef void (*CallCompletedCallback)();
 
+// --- Microtask Callback ---
+typedef void (*MicrotaskCallback)(void* data);
+
 // --- Failed Access Check Callback ---
 typedef void (*FailedAccessCheckCallback)(Local<Object> target,
                                           AccessType type,
@@ -3907,6 +4234,68 @@ class V8_EXPORT HeapStatistics {
 };
 
 
+/**
+ * Timings and sizes of a single garbage collection.
+ *
+ * An instance is passed to the callback installed with
+ * Isolate::SetGCStatisticsCallback after every collection.  Times are in
+ * milliseconds and sizes in bytes.
+ */
+struct GCStatistics {
+  enum Phase {
+    kExternal,  // Embedder callbacks, e.g. weak handle callbacks.
+    kMark,
+    kSweep,
+    kSweepNewSpace,
+    kEvacuate,
+    kUpdatePointers,
+    kWeakCollections,
+    kNumberOfPhases
+  };
+
+  enum Space {
+    kNewSpace,
+    kOldPointerSpace,
+    kOldDataSpace,
+    kCodeSpace,
+    kMapSpace,
+    kCellSpace,
+    kPropertyCellSpace,
+    kLargeObjectSpace,
+    kNumberOfSpaces
+  };
+
+  GCType type;
+
+  // Time since the isolate was initialized at which the collection started.
+  double start_time;
+  double pause;
+  // Time spent in the mutator since the end of the previous collection.
+  double mutator_time;
+  // Only the mark-compact collector reports individual phases, a scavenge
+  // reports just the time spent in embedder callbacks.
+  double phase_times[kNumberOfPhases];
+
+  size_t size_before;
+  size_t size_after;
+  size_t space_size_before[kNumberOfSpaces];
+  size_t space_size_after[kNumberOfSpaces];
+  // Bytes allocated since the end of the previous collection.
+  size_t allocated_bytes;
+  size_t promoted_bytes;
+
+  // Incremental marking steps since the start of marking for mark-compact
+  // collections, or since the previous collection for scavenges.
+  int incremental_marking_steps;
+  double incremental_marking_time;
+  double incremental_marking_longest_step;
+
+  // Free bytes on old space pages the sweeper had not reached yet when the
+  // collection started.
+  size_t unswept_bytes;
+};
+
+
 class RetainedObjectInfo;
 
 /**
@@ -3949,6 +4338,16 @@ class V8_EXPORT Isolate {
     kMinorGarbageCollection
   };
 
+  /**
+   * Levels of memory pressure that can be reported to the isolate via
+   * MemoryPressureNotification.
+   */
+  enum MemoryPressureLevel {
+    kMemoryPressureNone,
+    kMemoryPressureModerate,
+    kMemoryPressureCritical
+  };
+
   /**
    * Creates a new isolate.  Does not change the currently entered
    * isolate.
@@ -3991,6 +4390,14 @@ class V8_EXPORT Isolate {
    */
   void Dispose();
 
+  /**
+   * Gives V8 |idle_time_in_ms| milliseconds to run idle tasks, such as
+   * incremental marking and sweeping steps, that it posted for this
+   * isolate. Only needed when V8 uses its built-in platform; embedders
+   * that provide their own v8::Platform run idle tasks themselves.
+   */
+  void RunIdleTasks(double idle_time_in_ms);
+
   /**
    * Associate embedder-specific data with the isolate. |slot| has to be
    * between 0 and GetNumberOfDataSlots() - 1.
@@ -4144,6 +4551,48 @@ class V8_EXPORT Isolate {
    */
   void RemoveGCEpilogueCallback(GCEpilogueCallback callback);
 
+  typedef void (*GCStatisticsCallback)(Isolate* isolate,
+                                       const GCStatistics* statistics);
+
+  /**
+   * Installs a callback that receives the timings and sizes of every garbage
+   * collection once it has finished.  Only one callback can be installed,
+   * passing NULL removes it.  The statistics are only valid for the duration
+   * of the call, and the callback must not allocate on the V8 heap.
+   */
+  void SetGCStatisticsCallback(GCStatisticsCallback callback);
+
+  /**
+   * Phases of a trace event, using the characters of Chrome's trace event
+   * format.
+   */
+  enum TraceEventPhase {
+    kTraceEventBegin = 'B',
+    kTraceEventEnd = 'E',
+    kTraceEventInstant = 'I'
+  };
+
+  /**
+   * Trace event callback.  |category| and |name| are static strings.
+   * |arg_name| is NULL when the event carries no argument.
+   */
+  typedef void (*TraceEventCallback)(TraceEventPhase phase,
+                                     const char* category,
+                                     const char* name,
+                                     const char* arg_name,
+                                     int arg_value);
+
+  /**
+   * Installs a callback that receives begin and end events for parsing,
+   * compilation, optimization, garbage collection phases and script
+   * execution, and instant events for deoptimizations.  Only one callback
+   * can be installed, passing NULL removes it.  Events of concurrent
+   * recompilation are reported on the compiler thread, so the callback
+   * must be thread safe, and it must not call back into V8.  Calls to API
+   * callbacks are reported as well when --log-timer-events is on.
+   */
+  void SetTraceEventCallback(TraceEventCallback callback);
+
   /**
    * Request V8 to interrupt long running JavaScript code and invoke
    * the given |callback| passing the given |data| to it. After |callback|
@@ -4172,6 +4621,16 @@ class V8_EXPORT Isolate {
    */
   void RequestGarbageCollectionForTesting(GarbageCollectionType type);
 
+  /**
+   * Optional notification that the system is running low on memory.
+   * On moderate pressure V8 drops its code and result caches and starts an
+   * incremental garbage collection, so that the call returns quickly. On
+   * critical pressure V8 additionally performs a full compacting garbage
+   * collection and returns pooled memory to the system, which may block
+   * for a while.
+   */
+  void MemoryPressureNotification(MemoryPressureLevel level);
+
  private:
   Isolate();
   Isolate(const Isolate&);
@@ -4569,6 +5028,14 @@ class V8_EXPORT V8 {
    */
   static void EnqueueMicrotask(Isolate* isolate, Handle<Function> microtask);
 
+  /**
+   * Experimental: Enqueues a C++ callback to the Microtask Work Queue. The
+   * callback is called with the given data when the queue is run.
+   */
+  static void EnqueueMicrotask(Isolate* isolate,
+                               MicrotaskCallback microtask,
+                               void* data = NULL);
+
    /**
    * Experimental: Controls whether the Microtask Work Queue is automatically
    * run when the script call depth decrements to zero.
@@ -4767,6 +5234,10 @@ class V8_EXPORT V8 {
   static void MakeWeak(internal::Object** global_handle,
                        void* data,
                        WeakCallback weak_callback);
+  typedef PhantomCallbackData<void>::Callback PhantomCallback;
+  static void MakePhantom(internal::Object** global_handle,
+                          void* data,
+                          PhantomCallback phantom_callback);
   static void ClearWeak(internal::Object** global_handle);
   static void Eternalize(Isolate* isolate,
                          Value* handle,
@@ -5236,7 +5707,8 @@ struct HeapStatsUpdate;
 class V8_EXPORT OutputStream {  // NOLINT
  public:
   enum OutputEncoding {
-    kAscii = 0  // 7-bit ASCII.
+    kAscii = 0,  // 7-bit ASCII.
+    kUtf8 = 1    // UTF-8, only supported by JSON::Stringify.
   };
   enum WriteResult {
     kContinue = 0,
@@ -5395,7 +5867,7 @@ class Internals {
   static const int kNullValueRootIndex = 7;
   static const int kTrueValueRootIndex = 8;
   static const int kFalseValueRootIndex = 9;
-  static const int kEmptyStringRootIndex = 144;
+  static const int kEmptyStringRootIndex = 143;
 
   static const int kNodeClassIdOffset = 1 * kApiPointerSize;
   static const int kNodeFlagsOffset = 1 * kApiPointerSize + 3;
@@ -5679,6 +6151,18 @@ void PersistentBase<T>::SetWeak(
 }
 
 
+template <class T>
+template <typename P>
+void PersistentBase<T>::SetPhantom(
+    P* parameter,
+    typename PhantomCallbackData<P>::Callback callback) {
+  typedef typename PhantomCallbackData<void>::Callback Callback;
+  V8::MakePhantom(reinterpret_cast<internal::Object**>(this->val_),
+                  parameter,
+                  reinterpret_cast<Callback>(callback));
+}
+
+
 template <class T>
 void PersistentBase<T>::ClearWeak() {
   V8::ClearWeak(reinterpret_cast<internal::Object**>(this->val_));
@@ -187,6 +187,28 @@ void KeyedLoadFieldStub::InitializeInterfaceDescriptor(
 }
 
 
+void LoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  // x0: receiver
+  static Register registers[] = { x0 };
+  descriptor->register_param_count_ = sizeof(registers) / sizeof(registers[0]);
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
+void KeyedLoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  // x1: receiver
+  static Register registers[] = { x1 };
+  descriptor->register_param_count_ = sizeof(registers) / sizeof(registers[0]);
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
 void KeyedStoreFastElementStub::InitializeInterfaceDescriptor(
     Isolate* isolate,
     CodeStubInterfaceDescriptor* descriptor) {
@@ -1377,6 +1399,8 @@ void CodeStub::GenerateStubsAheadOfTime(Isolate* isolate) {
   CreateAllocationSiteStub::GenerateAheadOfTime(isolate);
   BinaryOpICStub::GenerateAheadOfTime(isolate);
   BinaryOpICWithAllocationSiteStub::GenerateAheadOfTime(isolate);
+  KeyedLoadFastElementStub::GenerateAheadOfTime(isolate);
+  TransitionElementsKindStub::GenerateAheadOfTime(isolate);
 }
 
 
@@ -4106,6 +4130,13 @@ void SubStringStub::Generate(MacroAssembler* masm) {
 
   // Shorter than original string's length: an actual substring.
 
+  // Empty substrings need no allocation.
+  Label not_empty;
+  __ Cbnz(result_length, &not_empty);
+  __ LoadRoot(x0, Heap::kempty_stringRootIndex);
+  __ B(&return_x0);
+  __ Bind(&not_empty);
+
   //   x0   to               substring end character offset
   //   x1   result_length    length of substring result
   //   x10  input_string     pointer to input string object
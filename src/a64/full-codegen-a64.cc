@@ -2332,7 +2332,7 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
     // Push the target function under the receiver.
     __ Pop(x10);
     __ Push(x0, x10);
-    flags = CALL_AS_METHOD;
+    flags = RECORD_CALL_TARGET_AS_METHOD;
   }
 
   // Load the arguments.
@@ -2344,6 +2344,10 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
 
   // Record source position for debugger.
   SetSourcePosition(expr->position());
+  if (flags == RECORD_CALL_TARGET_AS_METHOD) {
+    __ LoadObject(x2, FeedbackVector());
+    __ Mov(x3, Operand(Smi::FromInt(expr->CallFeedbackSlot())));
+  }
   CallFunctionStub stub(arg_count, flags);
   __ Peek(x1, (arg_count + 1) * kPointerSize);
   __ CallStub(&stub);
@@ -2385,7 +2389,9 @@ void FullCodeGenerator::EmitKeyedCallWithIC(Call* expr,
 
   // Record source position for debugger.
   SetSourcePosition(expr->position());
-  CallFunctionStub stub(arg_count, CALL_AS_METHOD);
+  __ LoadObject(x2, FeedbackVector());
+  __ Mov(x3, Operand(Smi::FromInt(expr->CallFeedbackSlot())));
+  CallFunctionStub stub(arg_count, RECORD_CALL_TARGET_AS_METHOD);
   __ Peek(x1, (arg_count + 1) * kPointerSize);
   __ CallStub(&stub);
 
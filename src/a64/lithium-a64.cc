@@ -1439,6 +1439,13 @@ LInstruction* LChunkBuilder::DoEnterInlined(HEnterInlined* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  // Optimized try/catch is only implemented by the x64 backend.
+  Abort(kTryCatchStatement);
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoEnvironmentMarker(HEnvironmentMarker* instr) {
   UNREACHABLE();
   return NULL;
@@ -1592,6 +1599,12 @@ LInstruction* LChunkBuilder::DoLeaveInlined(HLeaveInlined* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  Abort(kTryCatchStatement);
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoLoadContextSlot(HLoadContextSlot* instr) {
   LOperand* context = UseRegisterAtStart(instr->value());
   LInstruction* result =
@@ -2695,17 +2695,23 @@ void LCodeGen::DoDivI(LDivI* instr) {
 void LCodeGen::DoDoubleToIntOrSmi(LDoubleToIntOrSmi* instr) {
   DoubleRegister input = ToDoubleRegister(instr->value());
   Register result = ToRegister32(instr->result());
-  Label done, deopt;
+
+  // Deoptimize if the value does not survive a round trip through an int32.
+  // This keeps the successful conversion on the fall-through path.
+  __ TryConvertDoubleToInt32(result, input, double_scratch(), NULL);
+  DeoptimizeIf(ne, instr->environment());
 
   if (instr->hydrogen()->CheckFlag(HValue::kBailoutOnMinusZero)) {
-    __ JumpIfMinusZero(input, &deopt);
+    // Only a zero result can come from -0.0, so the raw bits of the input are
+    // only inspected in that case. If we do not deoptimize, the input was
+    // +0.0, whose bit pattern is zero, so the result is left unchanged.
+    Label done;
+    __ Cbnz(result, &done);
+    __ Fmov(result.X(), input);
+    DeoptimizeIfNegative(result.X(), instr->environment());
+    __ Bind(&done);
   }
 
-  __ TryConvertDoubleToInt32(result, input, double_scratch(), &done);
-  __ Bind(&deopt);
-  Deoptimize(instr->environment());
-  __ Bind(&done);
-
   if (instr->tag_result()) {
     __ SmiTag(result.X());
   }
@@ -3324,26 +3330,17 @@ MemOperand LCodeGen::PrepareKeyedExternalArrayOperand(
       }
     }
   } else {
-    // TODO(all): Try to combine these cases a bit more intelligently.
-    if (additional_offset == 0) {
-      if (key_is_smi) {
-        __ SmiUntag(scratch, key);
-        __ Add(scratch.W(), scratch.W(), additional_index);
-      } else {
-        __ Add(scratch.W(), key.W(), additional_index);
-      }
-      return MemOperand(base, scratch, LSL, element_size_shift);
+    // Fold the additional index into the immediate offset of the memory
+    // operand, so that the key is scaled and added in a single instruction
+    // whether or not it is a smi.
+    if (key_is_smi) {
+      __ Add(scratch, base, Operand::UntagSmiAndScale(key, element_size_shift));
     } else {
-      if (key_is_smi) {
-        __ Add(scratch, base,
-               Operand::UntagSmiAndScale(key, element_size_shift));
-      } else {
-        __ Add(scratch, base, Operand(key, SXTW, element_size_shift));
-      }
-      return MemOperand(
-          scratch,
-          (additional_index << element_size_shift) + additional_offset);
+      __ Add(scratch, base, Operand(key, SXTW, element_size_shift));
     }
+    return MemOperand(
+        scratch,
+        (additional_index << element_size_shift) + additional_offset);
   }
 }
 
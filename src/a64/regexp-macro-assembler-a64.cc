@@ -94,9 +94,10 @@ namespace internal {
  *  - fp[-24]   output_size        Output may fit multiple sets of matches.
  *  - fp[-32]   input              Handle containing the input string.
  *  - fp[-40]   success_counter
+ *  - fp[-48]   backtrack_count    Backtracks taken, if they are limited.
  *  ^^^^^^^^^^^^^ From here and downwards we store 32 bit values ^^^^^^^^^^^^^
- *  - fp[-44]   register N         Capture registers initialized with
- *  - fp[-48]   register N + 1     non_position_value.
+ *  - fp[-52]   register N         Capture registers initialized with
+ *  - fp[-56]   register N + 1     non_position_value.
  *              ...                The first kNumCachedRegisters (N) registers
  *              ...                are cached in x0 to x7.
  *              ...                Only positions must be stored in the first
@@ -167,6 +168,7 @@ RegExpMacroAssemblerA64::~RegExpMacroAssemblerA64() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 int RegExpMacroAssemblerA64::stack_limit_slack()  {
@@ -211,6 +213,13 @@ void RegExpMacroAssemblerA64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerA64::Backtrack() {
   CheckPreemption();
+  if (has_backtrack_limit()) {
+    __ Ldr(x10, MemOperand(frame_pointer(), kBacktrackCount));
+    __ Add(x10, x10, 1);
+    __ Str(x10, MemOperand(frame_pointer(), kBacktrackCount));
+    __ Cmp(x10, backtrack_limit());
+    __ B(eq, &backtrack_limit_label_);
+  }
   Pop(w10);
   __ Add(x10, code_pointer(), Operand(w10, UXTW));
   __ Br(x10);
@@ -716,12 +725,13 @@ Handle<HeapObject> RegExpMacroAssemblerA64::GetCode(Handle<String> source) {
 
   // Set the number of registers we will need to allocate, that is:
   //   - success_counter (X register)
+  //   - backtrack_count (X register)
   //   - (num_registers_ - kNumCachedRegisters) (W registers)
   int num_wreg_to_allocate = num_registers_ - kNumCachedRegisters;
   // Do not allocate registers on the stack if they can all be cached.
   if (num_wreg_to_allocate < 0) { num_wreg_to_allocate = 0; }
-  // Make room for the success_counter.
-  num_wreg_to_allocate += 2;
+  // Make room for the success_counter and the backtrack_count.
+  num_wreg_to_allocate += 4;
 
   // Make sure the stack alignment will be respected.
   int alignment = masm_->ActivationFrameAlignment();
@@ -762,8 +772,9 @@ Handle<HeapObject> RegExpMacroAssemblerA64::GetCode(Handle<String> source) {
   // Allocate space on stack.
   __ Claim(num_wreg_to_allocate, kWRegSizeInBytes);
 
-  // Initialize success_counter with 0.
+  // Initialize success_counter and backtrack_count with 0.
   __ Str(wzr, MemOperand(frame_pointer(), kSuccessCounter));
+  __ Str(xzr, MemOperand(frame_pointer(), kBacktrackCount));
 
   // Find negative length (offset of start relative to end).
   __ Sub(x10, input_start(), input_end());
@@ -1055,6 +1066,12 @@ Handle<HeapObject> RegExpMacroAssemblerA64::GetCode(Handle<String> source) {
     __ B(&return_w0);
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    __ Bind(&backtrack_limit_label_);
+    __ Mov(w0, BACKTRACK_LIMIT);
+    __ B(&return_w0);
+  }
+
   CodeDesc code_desc;
   masm_->GetCode(&code_desc);
   Handle<Code> code = isolate()->factory()->NewCode(
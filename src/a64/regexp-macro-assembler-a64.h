@@ -142,11 +142,13 @@ class RegExpMacroAssemblerA64: public NativeRegExpMacroAssembler {
   // When adding local variables remember to push space for them in
   // the frame in GetCode.
   static const int kSuccessCounter = kInput - kPointerSize;
+  // Number of backtracks taken if there is a backtrack limit.
+  static const int kBacktrackCount = kSuccessCounter - kPointerSize;
   // First position register address on the stack. Following positions are
   // below it. A position is a 32 bit value.
-  static const int kFirstRegisterOnStack = kSuccessCounter - kWRegSizeInBytes;
+  static const int kFirstRegisterOnStack = kBacktrackCount - kWRegSizeInBytes;
   // A capture is a 64 bit value holding two position.
-  static const int kFirstCaptureOnStack = kSuccessCounter - kXRegSizeInBytes;
+  static const int kFirstCaptureOnStack = kBacktrackCount - kXRegSizeInBytes;
 
   // Initial size of code buffer.
   static const size_t kRegExpCodeSize = 1024;
@@ -305,6 +307,7 @@ class RegExpMacroAssemblerA64: public NativeRegExpMacroAssembler {
   Label exit_label_;
   Label check_preempt_label_;
   Label stack_overflow_label_;
+  Label backtrack_limit_label_;
 };
 
 #endif  // V8_INTERPRETED_REGEXP
@@ -25,12 +25,15 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <cmath>
+
 #include "v8.h"
 
 #include "allocation-tracker.h"
 
 #include "heap-snapshot-generator.h"
 #include "frames-inl.h"
+#include "utils/random-number-generator.h"
 
 namespace v8 {
 namespace internal {
@@ -226,10 +229,13 @@ AllocationTracker::AllocationTracker(
     : ids_(ids),
       names_(names),
       id_to_function_info_index_(AddressesMatch),
-      info_index_for_other_state_(0) {
+      info_index_for_other_state_(0),
+      sampling_interval_(FLAG_heap_profiler_sampling_interval),
+      bytes_until_sample_(0) {
   FunctionInfo* info = new FunctionInfo();
   info->name = "(root)";
   function_info_list_.Add(info);
+  if (sampling_interval_ > 0) bytes_until_sample_ = NextSampleInterval();
 }
 
 
@@ -250,10 +256,27 @@ void AllocationTracker::PrepareForSerialization() {
 }
 
 
+intptr_t AllocationTracker::NextSampleInterval() {
+  // Pick the distance to the next sample from an exponential distribution,
+  // so that sampled allocations form a Poisson process over allocated
+  // bytes and are not biased by a periodic allocation pattern.
+  Isolate* isolate = ids_->heap()->isolate();
+  double u = isolate->random_number_generator()->NextDouble();
+  double interval = -std::log(1.0 - u) * sampling_interval_;
+  return static_cast<intptr_t>(Max(1.0, interval));
+}
+
+
 void AllocationTracker::AllocationEvent(Address addr, int size) {
   DisallowHeapAllocation no_allocation;
   Heap* heap = ids_->heap();
 
+  if (sampling_interval_ > 0) {
+    bytes_until_sample_ -= size;
+    if (bytes_until_sample_ > 0) return;
+    bytes_until_sample_ = NextSampleInterval();
+  }
+
   // Mark the new block as FreeSpace to make sure the heap is iterable
   // while we are capturing stack trace.
   FreeListNode::FromAddress(addr)->set_size(heap, size);
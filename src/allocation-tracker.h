@@ -135,6 +135,7 @@ class AllocationTracker {
   unsigned AddFunctionInfo(SharedFunctionInfo* info, SnapshotObjectId id);
   static void DeleteFunctionInfo(FunctionInfo** info);
   unsigned functionInfoIndexForVMState(StateTag state);
+  intptr_t NextSampleInterval();
 
   class UnresolvedLocation {
    public:
@@ -162,6 +163,10 @@ class AllocationTracker {
   List<UnresolvedLocation*> unresolved_locations_;
   unsigned info_index_for_other_state_;
   AddressToTraceMap address_to_trace_;
+  // With --heap-profiler-sampling-interval only one allocation every
+  // sampling_interval_ bytes on average gets its stack recorded.
+  int sampling_interval_;
+  intptr_t bytes_until_sample_;
 
   DISALLOW_COPY_AND_ASSIGN(AllocationTracker);
 };
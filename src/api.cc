@@ -60,13 +60,19 @@
 #include "runtime.h"
 #include "runtime-profiler.h"
 #include "scanner-character-streams.h"
+#include "serialize.h"
 #include "snapshot.h"
 #include "unicode-inl.h"
 #include "utils/random-number-generator.h"
 #include "v8threads.h"
+#include "value-serializer.h"
 #include "version.h"
 #include "vm-state-inl.h"
 
+#ifdef V8_I18N_SUPPORT
+#include "i18n.h"
+#endif
+
 
 #define LOG_API(isolate, expr) LOG(isolate, ApiEntryCall(expr))
 
@@ -560,6 +566,13 @@ void V8::MakeWeak(i::Object** object,
 }
 
 
+void V8::MakePhantom(i::Object** object,
+                     void* parameters,
+                     PhantomCallback phantom_callback) {
+  i::GlobalHandles::MakePhantom(object, parameters, phantom_callback);
+}
+
+
 void V8::ClearWeak(i::Object** obj) {
   i::GlobalHandles::ClearWeakness(obj);
 }
@@ -638,6 +651,33 @@ EscapableHandleScope::EscapableHandleScope(Isolate* v8_isolate) {
 }
 
 
+SealHandleScope::SealHandleScope(Isolate* isolate) {
+  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  isolate_ = internal_isolate;
+#ifdef DEBUG
+  // Shrink the current handle scope so that creating a handle without an
+  // inner HandleScope fails. Only debug builds can shrink a scope to the
+  // middle of a block, see HandleScopeImplementer::DeleteExtensions.
+  i::HandleScopeData* current = internal_isolate->handle_scope_data();
+  prev_limit_ = current->limit;
+  current->limit = current->next;
+  prev_level_ = current->level;
+  current->level = 0;
+#endif
+}
+
+
+SealHandleScope::~SealHandleScope() {
+#ifdef DEBUG
+  i::HandleScopeData* current = isolate_->handle_scope_data();
+  ASSERT_EQ(0, current->level);
+  current->level = prev_level_;
+  ASSERT_EQ(current->next, current->limit);
+  current->limit = prev_limit_;
+#endif
+}
+
+
 i::Object** EscapableHandleScope::Escape(i::Object** escape_value) {
   i::Heap* heap = reinterpret_cast<i::Isolate*>(GetIsolate())->heap();
   Utils::ApiCheck(*escape_slot_ == heap->the_hole_value(),
@@ -1589,6 +1629,32 @@ ScriptData* ScriptData::PreCompile(v8::Handle<String> source) {
 }
 
 
+// Preparses without accessing an isolate, so it can be used on any thread.
+static ScriptData* PreCompileOnCurrentThread(
+    i::Utf16CharacterStream* stream) {
+  i::UnicodeCache unicode_cache;
+  // Takes the address of the limit variable in order to find out where
+  // the top of the current thread's stack is right now.
+  const uintptr_t kLimitSize = i::FLAG_stack_size * i::KB;
+  uintptr_t limit = reinterpret_cast<uintptr_t>(&limit) - kLimitSize;
+  return i::PreParserApi::PreParse(&unicode_cache, stream, limit);
+}
+
+
+ScriptData* ScriptData::PreCompile(const char* source, int length) {
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const unsigned char*>(source), length);
+  return PreCompileOnCurrentThread(&stream);
+}
+
+
+ScriptData* ScriptData::PreCompile(ExternalSourceStream* source,
+                                   ExternalSourceStream::Encoding encoding) {
+  i::ExternalStreamingUtf16CharacterStream stream(source, encoding);
+  return PreCompileOnCurrentThread(&stream);
+}
+
+
 ScriptData* ScriptData::New(const char* data, int length) {
   // Return an empty ScriptData if the length is obviously invalid.
   if (length % sizeof(unsigned) != 0) {
@@ -1611,6 +1677,48 @@ ScriptData* ScriptData::New(const char* data, int length) {
 }
 
 
+ScriptData* ScriptData::GenerateCodeCache(v8::Handle<String> source,
+                                          v8::ScriptOrigin* origin) {
+  i::Handle<i::String> str = Utils::OpenHandle(*source);
+  i::Isolate* isolate = str->GetIsolate();
+  ON_BAILOUT(isolate, "v8::ScriptData::GenerateCodeCache()", return NULL);
+  LOG_API(isolate, "ScriptData::GenerateCodeCache");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::Handle<i::Object> name_obj;
+  int line_offset = 0;
+  int column_offset = 0;
+  if (origin != NULL) {
+    if (!origin->ResourceName().IsEmpty()) {
+      name_obj = Utils::OpenHandle(*origin->ResourceName());
+    }
+    if (!origin->ResourceLineOffset().IsEmpty()) {
+      line_offset = static_cast<int>(origin->ResourceLineOffset()->Value());
+    }
+    if (!origin->ResourceColumnOffset().IsEmpty()) {
+      column_offset =
+          static_cast<int>(origin->ResourceColumnOffset()->Value());
+    }
+  }
+  EXCEPTION_PREAMBLE(isolate);
+  i::ScriptDataImpl* code_cache = NULL;
+  i::Handle<i::SharedFunctionInfo> result =
+      i::Compiler::CompileScript(str,
+                                 name_obj,
+                                 line_offset,
+                                 column_offset,
+                                 false,
+                                 isolate->global_context(),
+                                 NULL,
+                                 &code_cache,
+                                 i::PRODUCE_CACHED_DATA,
+                                 i::NOT_NATIVES_CODE);
+  has_pending_exception = result.is_null();
+  EXCEPTION_BAILOUT_CHECK(isolate, NULL);
+  return code_cache;
+}
+
+
 // --- S c r i p t ---
 
 
@@ -1648,11 +1756,16 @@ Local<Script> Script::New(v8::Handle<String> source,
     EXCEPTION_PREAMBLE(isolate);
     i::ScriptDataImpl* pre_data_impl =
         static_cast<i::ScriptDataImpl*>(pre_data);
+    // Code caches are validated when they are consumed.
+    bool is_code_cache = pre_data_impl != NULL &&
+        i::CodeSerializer::IsCodeCache(pre_data_impl);
     // We assert that the pre-data is sane, even though we can actually
     // handle it if it turns out not to be in release mode.
-    ASSERT(pre_data_impl == NULL || pre_data_impl->SanityCheck());
+    ASSERT(pre_data_impl == NULL || is_code_cache ||
+           pre_data_impl->SanityCheck());
     // If the pre-data isn't sane we simply ignore it
-    if (pre_data_impl != NULL && !pre_data_impl->SanityCheck()) {
+    if (pre_data_impl != NULL && !is_code_cache &&
+        !pre_data_impl->SanityCheck()) {
       pre_data_impl = NULL;
     }
     i::Handle<i::SharedFunctionInfo> result =
@@ -1663,7 +1776,10 @@ Local<Script> Script::New(v8::Handle<String> source,
                                    is_shared_cross_origin,
                                    isolate->global_context(),
                                    NULL,
-                                   pre_data_impl,
+                                   &pre_data_impl,
+                                   pre_data_impl != NULL
+                                       ? i::CONSUME_CACHED_DATA
+                                       : i::NO_CACHED_DATA,
                                    i::NOT_NATIVES_CODE);
     has_pending_exception = result.is_null();
     EXCEPTION_BAILOUT_CHECK(isolate, Local<Script>());
@@ -2273,6 +2389,175 @@ Local<Value> JSON::Parse(Local<String> json_string) {
 }
 
 
+// Exposes an embedder-owned buffer to the JSON parser without copying it.
+class ExternalJsonSource : public String::ExternalAsciiStringResource {
+ public:
+  ExternalJsonSource(const char* data, size_t length)
+      : data_(data), length_(length) { }
+  virtual const char* data() const { return data_; }
+  virtual size_t length() const { return length_; }
+
+ private:
+  const char* data_;
+  size_t length_;
+};
+
+
+Local<Value> JSON::Parse(Isolate* v8_isolate, const char* data, int length) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  EnsureInitializedForIsolate(isolate, "v8::JSON::Parse");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  if (length < 0) length = i::StrLength(data);
+  EXCEPTION_PREAMBLE(isolate);
+  i::Handle<i::Object> result;
+  if (i::String::IsAscii(data, length)) {
+    // The parser copies everything it keeps out of the source, so the
+    // buffer can back it directly.  The external string is disposed right
+    // away, since the buffer may be gone once we return.
+    i::Handle<i::String> source = isolate->factory()->
+        NewExternalStringFromAscii(new ExternalJsonSource(data, length));
+    if (!source.is_null()) {
+      result = i::JsonParser<false>::Parse(source);
+      isolate->heap()->FinalizeExternalString(*source);
+    }
+    if (result.is_null()) {
+      // The error may refer to the source, report it from a copy instead.
+      isolate->clear_pending_exception();
+      isolate->clear_pending_message();
+    }
+  }
+  if (result.is_null()) {
+    i::Handle<i::String> source = isolate->factory()->NewStringFromUtf8(
+        i::Vector<const char>(data, length));
+    if (!source.is_null()) {
+      source = i::Handle<i::String>(FlattenGetString(source));
+      if (source->IsSeqOneByteString()) {
+        result = i::JsonParser<true>::Parse(source);
+      } else {
+        result = i::JsonParser<false>::Parse(source);
+      }
+    }
+  }
+  has_pending_exception = result.is_null();
+  EXCEPTION_BAILOUT_CHECK(isolate, Local<Object>());
+  return Utils::ToLocal(
+      i::Handle<i::Object>::cast(scope.CloseAndEscape(result)));
+}
+
+
+bool JSON::Stringify(Isolate* v8_isolate,
+                     Handle<Value> value,
+                     OutputStream* stream) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  EnsureInitializedForIsolate(isolate, "v8::JSON::Stringify");
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  EXCEPTION_PREAMBLE(isolate);
+  i::Object* result;
+  has_pending_exception = !i::Runtime::StringifyJSONToStream(
+      isolate, Utils::OpenHandle(*value), stream)->ToObject(&result);
+  EXCEPTION_BAILOUT_CHECK(isolate, false);
+  return result->IsTrue();
+}
+
+
+// --- V a l u e S e r i a l i z e r ---
+
+ValueSerializer::ValueSerializer(Isolate* v8_isolate) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  EnsureInitializedForIsolate(isolate, "v8::ValueSerializer::New()");
+  ENTER_V8(isolate);
+  private_ = new i::ValueSerializer(isolate);
+}
+
+
+ValueSerializer::~ValueSerializer() {
+  delete private_;
+}
+
+
+void ValueSerializer::WriteHeader() {
+  private_->WriteHeader();
+}
+
+
+bool ValueSerializer::WriteValue(Handle<Value> value) {
+  i::Isolate* isolate = private_->isolate();
+  ON_BAILOUT(isolate, "v8::ValueSerializer::WriteValue()", return false);
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  EXCEPTION_PREAMBLE(isolate);
+  has_pending_exception = !private_->WriteObject(Utils::OpenHandle(*value));
+  EXCEPTION_BAILOUT_CHECK(isolate, false);
+  return true;
+}
+
+
+void ValueSerializer::TransferArrayBuffer(uint32_t transfer_id,
+                                          Handle<ArrayBuffer> array_buffer) {
+  ENTER_V8(private_->isolate());
+  private_->TransferArrayBuffer(transfer_id,
+                                Utils::OpenHandle(*array_buffer));
+}
+
+
+const uint8_t* ValueSerializer::GetBuffer() {
+  return private_->buffer();
+}
+
+
+size_t ValueSerializer::GetBufferSize() {
+  return private_->buffer_size();
+}
+
+
+ValueDeserializer::ValueDeserializer(Isolate* v8_isolate,
+                                     const uint8_t* data,
+                                     size_t size) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  EnsureInitializedForIsolate(isolate, "v8::ValueDeserializer::New()");
+  Utils::ApiCheck(size <= static_cast<size_t>(i::kMaxInt),
+                  "v8::ValueDeserializer::New()",
+                  "Data is too large");
+  ENTER_V8(isolate);
+  private_ = new i::ValueDeserializer(
+      isolate, i::Vector<const uint8_t>(data, static_cast<int>(size)));
+}
+
+
+ValueDeserializer::~ValueDeserializer() {
+  delete private_;
+}
+
+
+bool ValueDeserializer::ReadHeader() {
+  return private_->ReadHeader();
+}
+
+
+Local<Value> ValueDeserializer::ReadValue() {
+  i::Isolate* isolate = private_->isolate();
+  ON_BAILOUT(isolate, "v8::ValueDeserializer::ReadValue()",
+             return Local<Value>());
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  EXCEPTION_PREAMBLE(isolate);
+  i::Handle<i::Object> result = private_->ReadObject();
+  has_pending_exception = result.is_null();
+  EXCEPTION_BAILOUT_CHECK(isolate, Local<Value>());
+  return Utils::ToLocal(scope.CloseAndEscape(result));
+}
+
+
+void ValueDeserializer::TransferArrayBuffer(
+    uint32_t transfer_id, Handle<ArrayBuffer> array_buffer) {
+  ENTER_V8(private_->isolate());
+  private_->TransferArrayBuffer(transfer_id,
+                                Utils::OpenHandle(*array_buffer));
+}
+
+
 // --- D a t a ---
 
 bool Value::FullIsUndefined() const {
@@ -3512,6 +3797,17 @@ void v8::Object::TurnOnAccessCheck() {
 }
 
 
+void v8::Object::OptimizeForPropertyAccess() {
+  i::Isolate* isolate = Utils::OpenHandle(this)->GetIsolate();
+  ON_BAILOUT(isolate, "v8::Object::OptimizeForPropertyAccess()", return);
+  ENTER_V8(isolate);
+  i::HandleScope scope(isolate);
+  i::Handle<i::JSObject> obj = Utils::OpenHandle(this);
+  if (obj->IsGlobalObject()) return;
+  i::JSObject::TransformToFastProperties(obj, 0);
+}
+
+
 bool v8::Object::IsDirty() {
   return Utils::OpenHandle(this)->IsDirty();
 }
@@ -4199,8 +4495,12 @@ class Utf8LengthHelper : public i::AllStatic {
 
     void VisitOneByteString(const uint8_t* chars, int length) {
       int utf8_length = 0;
+      // Skip the ASCII prefix a word at a time.
+      int i = i::String::NonAsciiStart(reinterpret_cast<const char*>(chars),
+                                       length);
+      chars += i;
       // Add in length 1 for each non-ASCII character.
-      for (int i = 0; i < length; i++) {
+      for (; i < length; i++) {
         utf8_length += *chars++ >> 7;
       }
       // Add in length 1 for each character.
@@ -4461,9 +4761,18 @@ class Utf8WriterVisitor {
       }
       // Write the characters to the stream.
       if (sizeof(Char) == 1) {
-        for (; i < fast_length; i++) {
+        while (i < fast_length) {
+          // Copy runs of ASCII characters, found a word at a time, directly.
+          int ascii_length = i::String::NonAsciiStart(
+              reinterpret_cast<const char*>(chars), fast_length - i);
+          i::OS::MemCopy(buffer, chars, ascii_length);
+          buffer += ascii_length;
+          chars += ascii_length;
+          i += ascii_length;
+          if (i == fast_length) break;
           buffer +=
               Utf8::EncodeOneByte(buffer, static_cast<uint8_t>(*chars++));
+          i++;
           ASSERT(capacity_ == -1 || (buffer - start_) <= capacity_);
         }
       } else {
@@ -5009,6 +5318,7 @@ void v8::V8::LowMemoryNotification() {
   i::Isolate* isolate = i::Isolate::Current();
   if (isolate == NULL || !isolate->IsInitialized()) return;
   isolate->heap()->CollectAllAvailableGarbage("low memory notification");
+  i::ZoneSegmentPool::Trim(0);
 }
 
 
@@ -5444,6 +5754,61 @@ Local<String> v8::String::NewExternal(
 }
 
 
+namespace internal {
+
+// Presents an ASCII-only UTF-8 resource as a one-byte resource, disposing
+// the wrapped resource together with itself.
+class ExternalUtf8StringAdapter
+    : public v8::String::ExternalAsciiStringResource {
+ public:
+  explicit ExternalUtf8StringAdapter(
+      v8::String::ExternalUtf8StringResource* resource)
+      : resource_(resource) {}
+
+  virtual const char* data() const { return resource_->data(); }
+  virtual size_t length() const { return resource_->length(); }
+
+  static void DisposeResource(
+      v8::String::ExternalUtf8StringResource* resource) {
+    resource->Dispose();
+  }
+
+ protected:
+  virtual void Dispose() {
+    DisposeResource(resource_);
+    delete this;
+  }
+
+ private:
+  v8::String::ExternalUtf8StringResource* resource_;
+};
+
+}  // namespace internal
+
+
+Local<String> v8::String::NewExternal(
+    Isolate* isolate,
+    v8::String::ExternalUtf8StringResource* resource) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  EnsureInitializedForIsolate(i_isolate, "v8::String::NewExternal()");
+  LOG_API(i_isolate, "String::NewExternal");
+  ENTER_V8(i_isolate);
+  CHECK(resource && resource->data());
+  const char* data = resource->data();
+  int length = static_cast<int>(resource->length());
+  if (i::String::IsAscii(data, length)) {
+    i::Handle<i::String> result = NewExternalAsciiStringHandle(
+        i_isolate, new i::ExternalUtf8StringAdapter(resource));
+    i_isolate->heap()->external_string_table()->AddString(*result);
+    return Utils::ToLocal(result);
+  }
+  i::Handle<i::String> result = i_isolate->factory()->NewStringFromUtf8(
+      i::Vector<const char>(data, length));
+  i::ExternalUtf8StringAdapter::DisposeResource(resource);
+  return Utils::ToLocal(result);
+}
+
+
 bool v8::String::MakeExternal(
     v8::String::ExternalAsciiStringResource* resource) {
   i::Handle<i::String> obj = Utils::OpenHandle(this);
@@ -5498,6 +5863,49 @@ Local<v8::Object> v8::Object::New(Isolate* isolate) {
 }
 
 
+Local<v8::Object> v8::Object::New(Isolate* isolate,
+                                  int length,
+                                  Handle<String> keys[],
+                                  Handle<Value> values[]) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  EnsureInitializedForIsolate(i_isolate, "v8::Object::New()");
+  LOG_API(i_isolate, "Object::New");
+  ON_BAILOUT(i_isolate, "v8::Object::New()", return Local<v8::Object>());
+  ENTER_V8(i_isolate);
+  i::Factory* factory = i_isolate->factory();
+  i::Handle<i::FixedArray> key_array = factory->NewFixedArray(length);
+  i::Handle<i::FixedArray> value_array = factory->NewFixedArray(length);
+  bool has_index_key = false;
+  for (int i = 0; i < length; i++) {
+    i::Handle<i::String> key =
+        factory->InternalizeString(Utils::OpenHandle(*keys[i]));
+    uint32_t index;
+    if (key->AsArrayIndex(&index)) has_index_key = true;
+    key_array->set(i, *key);
+    value_array->set(i, *Utils::OpenHandle(*values[i]));
+  }
+  EXCEPTION_PREAMBLE(i_isolate);
+  i::Handle<i::JSObject> obj;
+  if (has_index_key) {
+    // Elements do not take part in the map, so index keys take the generic
+    // path.
+    obj = factory->NewJSObject(i_isolate->object_function());
+    for (int i = 0; i < length && !has_pending_exception; i++) {
+      has_pending_exception = i::ForceSetProperty(
+          obj,
+          i::handle(key_array->get(i), i_isolate),
+          i::handle(value_array->get(i), i_isolate),
+          NONE).is_null();
+    }
+  } else {
+    obj = factory->NewJSObjectWithProperties(key_array, value_array);
+    has_pending_exception = obj.is_null();
+  }
+  EXCEPTION_BAILOUT_CHECK(i_isolate, Local<v8::Object>());
+  return Utils::ToLocal(obj);
+}
+
+
 Local<v8::Value> v8::NumberObject::New(Isolate* isolate, double value) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   EnsureInitializedForIsolate(i_isolate, "v8::NumberObject::New()");
@@ -5617,6 +6025,10 @@ void v8::Date::DateTimeConfigurationChangeNotification(Isolate* isolate) {
   ENTER_V8(i_isolate);
 
   i_isolate->date_cache()->ResetDateCache();
+#ifdef V8_I18N_SUPPORT
+  // Cached date formats hold on to the old default time zone.
+  i_isolate->icu_object_cache()->Clear();
+#endif
 
   i::HandleScope scope(i_isolate);
   // Get the function ResetDateCache (defined in date.js).
@@ -5748,6 +6160,11 @@ bool v8::ArrayBuffer::IsExternal() const {
 }
 
 
+bool v8::ArrayBuffer::IsShared() const {
+  return Utils::OpenHandle(this)->is_shared();
+}
+
+
 v8::ArrayBuffer::Contents v8::ArrayBuffer::Externalize() {
   i::Handle<i::JSArrayBuffer> obj = Utils::OpenHandle(this);
   Utils::ApiCheck(!obj->is_external(),
@@ -5768,6 +6185,9 @@ void v8::ArrayBuffer::Neuter() {
   Utils::ApiCheck(obj->is_external(),
                   "v8::ArrayBuffer::Neuter",
                   "Only externalized ArrayBuffers can be neutered");
+  Utils::ApiCheck(!obj->is_shared(),
+                  "v8::ArrayBuffer::Neuter",
+                  "Shared ArrayBuffers cannot be neutered");
   LOG_API(obj->GetIsolate(), "v8::ArrayBuffer::Neuter()");
   ENTER_V8(isolate);
 
@@ -5818,6 +6238,20 @@ Local<ArrayBuffer> v8::ArrayBuffer::New(Isolate* isolate, void* data,
 }
 
 
+Local<ArrayBuffer> v8::ArrayBuffer::NewShared(Isolate* isolate, void* data,
+                                              size_t byte_length) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  EnsureInitializedForIsolate(i_isolate, "v8::ArrayBuffer::NewShared()");
+  LOG_API(i_isolate, "v8::ArrayBuffer::NewShared()");
+  ENTER_V8(i_isolate);
+  i::Handle<i::JSArrayBuffer> obj =
+      i_isolate->factory()->NewJSArrayBuffer();
+  i::Runtime::SetupArrayBuffer(i_isolate, obj, true, data, byte_length);
+  obj->set_is_shared(true);
+  return Utils::ToLocal(obj);
+}
+
+
 Local<ArrayBuffer> v8::ArrayBufferView::Buffer() {
   i::Handle<i::JSArrayBufferView> obj = Utils::OpenHandle(this);
   ASSERT(obj->buffer()->IsJSArrayBuffer());
@@ -6268,7 +6702,16 @@ void V8::RunMicrotasks(Isolate* isolate) {
 void V8::EnqueueMicrotask(Isolate* isolate, Handle<Function> microtask) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   ENTER_V8(i_isolate);
-  i::Execution::EnqueueMicrotask(i_isolate, Utils::OpenHandle(*microtask));
+  i_isolate->microtask_queue()->Enqueue(Utils::OpenHandle(*microtask));
+}
+
+
+void V8::EnqueueMicrotask(Isolate* isolate,
+                          MicrotaskCallback microtask,
+                          void* data) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  ENTER_V8(i_isolate);
+  i_isolate->microtask_queue()->Enqueue(microtask, data);
 }
 
 
@@ -6331,6 +6774,14 @@ void Isolate::RequestGarbageCollectionForTesting(GarbageCollectionType type) {
 }
 
 
+void Isolate::MemoryPressureNotification(MemoryPressureLevel level) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!isolate->IsInitialized()) return;
+  isolate->heap()->MemoryPressureNotification(level);
+  if (level == kMemoryPressureCritical) i::ZoneSegmentPool::Trim(0);
+}
+
+
 Isolate* Isolate::GetCurrent() {
   i::Isolate* isolate = i::Isolate::UncheckedCurrent();
   return reinterpret_cast<Isolate*>(isolate);
@@ -6354,6 +6805,23 @@ void Isolate::Dispose() {
 }
 
 
+void Isolate::SetTraceEventCallback(TraceEventCallback callback) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->logger()->set_trace_event_callback(callback);
+}
+
+
+void Isolate::SetGCStatisticsCallback(GCStatisticsCallback callback) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->SetGCStatisticsCallback(callback);
+}
+
+
+void Isolate::RunIdleTasks(double idle_time_in_ms) {
+  i::V8::RunIdleTasks(this, idle_time_in_ms);
+}
+
+
 void Isolate::Enter() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   isolate->Enter();
@@ -6818,6 +7286,13 @@ const CpuProfileNode* CpuProfile::GetSample(int index) const {
 }
 
 
+int64_t CpuProfile::GetSampleTimestamp(int index) const {
+  const i::CpuProfile* profile = reinterpret_cast<const i::CpuProfile*>(this);
+  i::TimeDelta delta = profile->sample_timestamp(index) - i::Time::UnixEpoch();
+  return delta.InMicroseconds();
+}
+
+
 int64_t CpuProfile::GetStartTime() const {
   const i::CpuProfile* profile = reinterpret_cast<const i::CpuProfile*>(this);
   return (profile->start_time() - i::Time::UnixEpoch()).InMicroseconds();
@@ -6868,6 +7343,20 @@ void CpuProfiler::SetIdle(bool is_idle) {
 }
 
 
+int CpuProfiler::GetTopDeoptimizations(DeoptimizationStats* stats,
+                                       int max_entries) {
+  i::Isolate* isolate = reinterpret_cast<i::CpuProfiler*>(this)->isolate();
+  return isolate->deoptimizer_data()->GetTopDeoptimizations(stats,
+                                                            max_entries);
+}
+
+
+void CpuProfiler::ClearDeoptimizationStats() {
+  i::Isolate* isolate = reinterpret_cast<i::CpuProfiler*>(this)->isolate();
+  isolate->deoptimizer_data()->ClearDeoptimizationStats();
+}
+
+
 static i::HeapGraphEdge* ToInternal(const HeapGraphEdge* edge) {
   return const_cast<i::HeapGraphEdge*>(
       reinterpret_cast<const i::HeapGraphEdge*>(edge));
@@ -7098,6 +7587,13 @@ void HeapProfiler::SetWrapperClassInfoProvider(uint16_t class_id,
 }
 
 
+int HeapProfiler::GetTopAllocationSites(AllocationSiteStats* stats,
+                                        int max_sites) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->
+      GetTopAllocationSites(stats, max_sites);
+}
+
+
 size_t HeapProfiler::GetProfilerMemorySize() {
   return reinterpret_cast<i::HeapProfiler*>(this)->
       GetMemorySizeUsedByProfiler();
@@ -7183,7 +7679,14 @@ namespace internal {
 
 
 void HandleScopeImplementer::FreeThreadResources() {
+  // Keep the spare handle block around. A thread that repeatedly takes and
+  // releases a top-level Locker would otherwise allocate and free a full
+  // handle block on every lock switch. The block is released by the
+  // destructor or handed over to the next archived thread.
+  Object** spare = spare_;
+  spare_ = NULL;
   Free();
+  spare_ = spare;
 }
 
 
@@ -7205,7 +7708,15 @@ int HandleScopeImplementer::ArchiveSpacePerThread() {
 
 
 char* HandleScopeImplementer::RestoreThread(char* storage) {
+  // A spare block retained by FreeThreadResources would be overwritten by
+  // the archived state, so either reuse it or release it.
+  Object** retained_spare = spare_;
   OS::MemCopy(this, storage, sizeof(*this));
+  if (spare_ == NULL) {
+    spare_ = retained_spare;
+  } else if (retained_spare != NULL) {
+    DeleteArray(retained_spare);
+  }
   *isolate_->handle_scope_data() = handle_scope_data_;
   return storage + ArchiveSpacePerThread();
 }
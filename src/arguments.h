@@ -29,6 +29,7 @@
 #define V8_ARGUMENTS_H_
 
 #include "allocation.h"
+#include "counters.h"
 
 namespace v8 {
 namespace internal {
@@ -304,8 +305,11 @@ Type Name(int args_length, Object** args_object, Isolate* isolate)
 
 #define RUNTIME_FUNCTION(Type, Name)                                  \
 static Type __RT_impl_##Name(Arguments args, Isolate* isolate);       \
+static RuntimeCallCounter __RT_counter_##Name =                       \
+    RUNTIME_CALL_COUNTER_INITIALIZER(#Name);                          \
 Type Name(int args_length, Object** args_object, Isolate* isolate) {  \
   CLOBBER_DOUBLE_REGISTERS();                                         \
+  RuntimeCallTimerScope runtime_call_timer(&__RT_counter_##Name);     \
   Arguments args(args_length, args_object);                           \
   return __RT_impl_##Name(args, isolate);                             \
 }                                                                     \
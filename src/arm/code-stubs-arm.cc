@@ -165,6 +165,26 @@ void KeyedLoadFieldStub::InitializeInterfaceDescriptor(
 }
 
 
+void LoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { r0 };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
+void KeyedLoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { r1 };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
 void KeyedStoreFastElementStub::InitializeInterfaceDescriptor(
     Isolate* isolate,
     CodeStubInterfaceDescriptor* descriptor) {
@@ -1453,6 +1473,8 @@ void CodeStub::GenerateStubsAheadOfTime(Isolate* isolate) {
   CreateAllocationSiteStub::GenerateAheadOfTime(isolate);
   BinaryOpICStub::GenerateAheadOfTime(isolate);
   BinaryOpICWithAllocationSiteStub::GenerateAheadOfTime(isolate);
+  KeyedLoadFastElementStub::GenerateAheadOfTime(isolate);
+  TransitionElementsKindStub::GenerateAheadOfTime(isolate);
 }
 
 
@@ -3630,6 +3652,11 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ b(hi, &runtime);
   // Shorter than original string's length: an actual substring.
 
+  // Empty substrings need no allocation.
+  __ cmp(r2, Operand::Zero());
+  __ LoadRoot(r0, Heap::kempty_stringRootIndex, eq);
+  __ b(eq, &return_r0);
+
   // Deal with different string types: update the index if necessary
   // and put the underlying string into r5.
   // r0: original string
@@ -842,6 +842,122 @@ void MathExpGenerator::EmitMathExp(MacroAssembler* masm,
   __ bind(&done);
 }
 
+
+static MemOperand LogConstant(int index, Register base) {
+  return MemOperand(base, index * kDoubleSize);
+}
+
+
+void MathLogGenerator::EmitMathLog(MacroAssembler* masm,
+                                   DwVfpRegister input,
+                                   DwVfpRegister result,
+                                   DwVfpRegister double_scratch1,
+                                   DwVfpRegister double_scratch2,
+                                   LowDwVfpRegister double_scratch3,
+                                   Register temp1,
+                                   Register temp2,
+                                   Register temp3) {
+  ASSERT(!input.is(result));
+  ASSERT(!input.is(double_scratch1));
+  ASSERT(!input.is(double_scratch2));
+  ASSERT(!input.is(double_scratch3));
+  ASSERT(!result.is(double_scratch1));
+  ASSERT(!result.is(double_scratch2));
+  ASSERT(!result.is(double_scratch3));
+  ASSERT(!double_scratch1.is(double_scratch2));
+  ASSERT(!double_scratch1.is(double_scratch3));
+  ASSERT(!double_scratch2.is(double_scratch3));
+  ASSERT(!temp1.is(temp2));
+  ASSERT(!temp1.is(temp3));
+  ASSERT(!temp2.is(temp3));
+
+  Label normalized, special, positive, zero, done;
+
+  // Positive normal numbers have a biased exponent (including the sign bit)
+  // in the range [1, 0x7fe].
+  __ VmovHigh(temp1, input);
+  __ mov(temp2, Operand(temp1, LSR, HeapNumber::kExponentShift));
+  __ sub(temp2, temp2, Operand(1));
+  __ cmp(temp2, Operand(0x7fe));
+  __ b(hs, &special);
+  __ mov(temp2, Operand(-HeapNumber::kExponentBias));
+
+  // Split x = 2^k * m with m in [sqrt(2)/2, sqrt(2)). temp1 holds the upper
+  // word of a positive normal number and temp2 the bias of its exponent.
+  __ bind(&normalized);
+  __ add(temp2, temp2, Operand(temp1, LSR, HeapNumber::kExponentShift));
+  __ Ubfx(temp1, temp1, 0, HeapNumber::kExponentShift);
+  // Carries into bit 20 iff the significand is at least sqrt(2).
+  __ add(temp3, temp1, Operand(0x95f64));
+  __ Ubfx(temp3, temp3, HeapNumber::kExponentShift, 1);
+  __ add(temp2, temp2, temp3);
+  __ rsb(temp3, temp3, Operand(0x3ff));
+  __ orr(temp1, temp1, Operand(temp3, LSL, HeapNumber::kExponentShift));
+  __ VmovHigh(input, temp1);
+
+  // With f = m - 1 and s = f / (2 + f), log(m) = f - hfsq + s * (hfsq + R)
+  // where hfsq = f * f / 2 and R is a polynomial in s * s.
+  __ mov(temp3, Operand(ExternalReference::math_log_constants(0)));
+  __ vldr(double_scratch1, LogConstant(1, temp3));
+  __ vsub(input, input, double_scratch1);
+  __ vldr(result, LogConstant(2, temp3));
+  __ vadd(result, result, input);
+  __ vdiv(double_scratch1, input, result);
+  __ vmul(result, double_scratch1, double_scratch1);
+  __ vldr(double_scratch2, LogConstant(3, temp3));
+  __ vmul(double_scratch2, double_scratch2, result);
+  for (int i = 4; i <= 9; i++) {
+    __ vldr(double_scratch3, LogConstant(i, temp3));
+    __ vadd(double_scratch2, double_scratch2, double_scratch3);
+    __ vmul(double_scratch2, double_scratch2, result);
+  }
+  __ vmul(result, input, input);
+  __ vldr(double_scratch3, LogConstant(10, temp3));
+  __ vmul(result, result, double_scratch3);
+  __ vadd(double_scratch2, double_scratch2, result);
+  __ vmul(double_scratch2, double_scratch2, double_scratch1);
+  // log(x) = k * ln2_hi - ((hfsq - (s * (hfsq + R) + k * ln2_lo)) - f).
+  __ vmov(double_scratch3.low(), temp2);
+  __ vcvt_f64_s32(double_scratch1, double_scratch3.low());
+  __ vldr(double_scratch3, LogConstant(11, temp3));
+  __ vmul(double_scratch3, double_scratch1, double_scratch3);
+  __ vadd(double_scratch2, double_scratch2, double_scratch3);
+  __ vsub(result, result, double_scratch2);
+  __ vsub(result, result, input);
+  __ vldr(double_scratch3, LogConstant(12, temp3));
+  __ vmul(double_scratch1, double_scratch1, double_scratch3);
+  __ vsub(result, double_scratch1, result);
+  __ b(&done);
+
+  // NaN, zero, negative, infinite and subnormal inputs.
+  __ bind(&special);
+  __ VFPCompareAndSetFlags(input, 0.0);
+  __ b(gt, &positive);
+  __ b(eq, &zero);
+  __ mov(temp3,
+         Operand(ExternalReference::address_of_canonical_non_hole_nan()));
+  __ vldr(result, temp3, 0);
+  __ b(&done);
+  __ bind(&zero);
+  __ mov(temp3, Operand(ExternalReference::address_of_negative_infinity()));
+  __ vldr(result, temp3, 0);
+  __ b(&done);
+  __ bind(&positive);
+  // The biased exponent minus one is still in temp2. It is positive for
+  // infinity and -1 for subnormals.
+  __ vmov(result, input);
+  __ cmp(temp2, Operand::Zero());
+  __ b(gt, &done);
+  __ mov(temp3, Operand(ExternalReference::math_log_constants(0)));
+  __ vldr(double_scratch1, LogConstant(0, temp3));
+  __ vmul(input, input, double_scratch1);
+  __ VmovHigh(temp1, input);
+  __ mov(temp2, Operand(-HeapNumber::kExponentBias - 54));
+  __ b(&normalized);
+
+  __ bind(&done);
+}
+
 #undef __
 
 #ifdef DEBUG
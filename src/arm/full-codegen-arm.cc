@@ -2630,7 +2630,7 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
     __ ldr(ip, MemOperand(sp, 0));
     __ push(ip);
     __ str(r0, MemOperand(sp, kPointerSize));
-    flags = CALL_AS_METHOD;
+    flags = RECORD_CALL_TARGET_AS_METHOD;
   }
 
   // Load the arguments.
@@ -2642,6 +2642,10 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
 
   // Record source position for debugger.
   SetSourcePosition(expr->position());
+  if (flags == RECORD_CALL_TARGET_AS_METHOD) {
+    __ Move(r2, FeedbackVector());
+    __ mov(r3, Operand(Smi::FromInt(expr->CallFeedbackSlot())));
+  }
   CallFunctionStub stub(arg_count, flags);
   __ ldr(r1, MemOperand(sp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
@@ -2684,7 +2688,9 @@ void FullCodeGenerator::EmitKeyedCallWithIC(Call* expr,
 
   // Record source position for debugger.
   SetSourcePosition(expr->position());
-  CallFunctionStub stub(arg_count, CALL_AS_METHOD);
+  __ Move(r2, FeedbackVector());
+  __ mov(r3, Operand(Smi::FromInt(expr->CallFeedbackSlot())));
+  CallFunctionStub stub(arg_count, RECORD_CALL_TARGET_AS_METHOD);
   __ ldr(r1, MemOperand(sp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
 
@@ -1135,8 +1135,14 @@ LInstruction* LChunkBuilder::DoMathAbs(HUnaryMathOperation* instr) {
 LInstruction* LChunkBuilder::DoMathLog(HUnaryMathOperation* instr) {
   ASSERT(instr->representation().IsDouble());
   ASSERT(instr->value()->representation().IsDouble());
-  LOperand* input = UseFixedDouble(instr->value(), d0);
-  return MarkAsCall(DefineFixedDouble(new(zone()) LMathLog(input), d0), instr);
+  LOperand* input = UseTempRegister(instr->value());
+  LOperand* double_temp1 = FixedTemp(d3);
+  LOperand* double_temp2 = FixedTemp(d4);
+  LOperand* temp1 = TempRegister();
+  LOperand* temp2 = TempRegister();
+  LMathLog* result = new(zone()) LMathLog(input, double_temp1, double_temp2,
+                                          temp1, temp2);
+  return DefineAsRegister(result);
 }
 
 
@@ -2494,6 +2500,19 @@ LInstruction* LChunkBuilder::DoEnterInlined(HEnterInlined* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  // Optimized try/catch is only implemented by the x64 backend.
+  Abort(kTryCatchStatement);
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  Abort(kTryCatchStatement);
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoLeaveInlined(HLeaveInlined* instr) {
   LInstruction* pop = NULL;
 
@@ -853,13 +853,25 @@ class LMathAbs V8_FINAL : public LTemplateInstruction<1, 2, 0> {
 };
 
 
-class LMathLog V8_FINAL : public LTemplateInstruction<1, 1, 0> {
+class LMathLog V8_FINAL : public LTemplateInstruction<1, 1, 4> {
  public:
-  explicit LMathLog(LOperand* value) {
+  LMathLog(LOperand* value,
+           LOperand* double_temp1,
+           LOperand* double_temp2,
+           LOperand* temp1,
+           LOperand* temp2) {
     inputs_[0] = value;
+    temps_[0] = double_temp1;
+    temps_[1] = double_temp2;
+    temps_[2] = temp1;
+    temps_[3] = temp2;
   }
 
   LOperand* value() { return inputs_[0]; }
+  LOperand* double_temp1() { return temps_[0]; }
+  LOperand* double_temp2() { return temps_[1]; }
+  LOperand* temp1() { return temps_[2]; }
+  LOperand* temp2() { return temps_[3]; }
 
   DECLARE_CONCRETE_INSTRUCTION(MathLog, "math-log")
 };
@@ -3912,11 +3912,16 @@ void LCodeGen::DoMathExp(LMathExp* instr) {
 
 
 void LCodeGen::DoMathLog(LMathLog* instr) {
-  __ PrepareCallCFunction(0, 1, scratch0());
-  __ MovToFloatParameter(ToDoubleRegister(instr->value()));
-  __ CallCFunction(ExternalReference::math_log_double_function(isolate()),
-                   0, 1);
-  __ MovFromFloatResult(ToDoubleRegister(instr->result()));
+  DwVfpRegister input = ToDoubleRegister(instr->value());
+  DwVfpRegister result = ToDoubleRegister(instr->result());
+  DwVfpRegister double_scratch1 = ToDoubleRegister(instr->double_temp1());
+  DwVfpRegister double_scratch2 = ToDoubleRegister(instr->double_temp2());
+  Register temp1 = ToRegister(instr->temp1());
+  Register temp2 = ToRegister(instr->temp2());
+
+  MathLogGenerator::EmitMathLog(
+      masm(), input, result, double_scratch1, double_scratch2,
+      double_scratch0(), temp1, temp2, scratch0());
 }
 
 
@@ -0,0 +1,109 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "array-buffer-pool.h"
+
+namespace v8 {
+namespace internal {
+
+
+ArrayBufferPool::ArrayBufferPool()
+    : pooled_bytes_(0),
+      hits_(0),
+      misses_(0),
+      recycled_(0),
+      released_(0) {
+}
+
+
+int ArrayBufferPool::SizeClass(size_t length) {
+  if (length == 0 || length % kSizeClassGranularity != 0) return -1;
+  size_t size_class = length / kSizeClassGranularity - 1;
+  if (size_class >= static_cast<size_t>(kNumberOfSizeClasses)) return -1;
+  return static_cast<int>(size_class);
+}
+
+
+void* ArrayBufferPool::Allocate(size_t length, bool initialize) {
+  CHECK(V8::ArrayBufferAllocator() != NULL);
+  int size_class = FLAG_array_buffer_pool ? SizeClass(length) : -1;
+  if (size_class >= 0) {
+    List<void*>* free_list = &free_lists_[size_class];
+    if (!free_list->is_empty()) {
+      hits_++;
+      pooled_bytes_ -= length;
+      void* data = free_list->RemoveLast();
+      if (initialize) memset(data, 0, length);
+      return data;
+    }
+    misses_++;
+  }
+  if (initialize) return V8::ArrayBufferAllocator()->Allocate(length);
+  return V8::ArrayBufferAllocator()->AllocateUninitialized(length);
+}
+
+
+void ArrayBufferPool::Free(void* data, size_t length) {
+  CHECK(V8::ArrayBufferAllocator() != NULL);
+  int size_class = FLAG_array_buffer_pool ? SizeClass(length) : -1;
+  if (size_class >= 0) {
+    size_t limit = static_cast<size_t>(FLAG_array_buffer_pool_size) * KB;
+    if (pooled_bytes_ + length <= limit) {
+      recycled_++;
+      pooled_bytes_ += length;
+      free_lists_[size_class].Add(data);
+      return;
+    }
+    released_++;
+  }
+  V8::ArrayBufferAllocator()->Free(data, length);
+}
+
+
+void ArrayBufferPool::Flush() {
+  for (int i = 0; i < kNumberOfSizeClasses; i++) {
+    size_t length = (i + 1) * kSizeClassGranularity;
+    List<void*>* free_list = &free_lists_[i];
+    while (!free_list->is_empty()) {
+      V8::ArrayBufferAllocator()->Free(free_list->RemoveLast(), length);
+    }
+    free_list->Free();
+  }
+  pooled_bytes_ = 0;
+}
+
+
+void ArrayBufferPool::PrintStatistics() {
+  PrintF("array_buffer_pool hits=%d misses=%d recycled=%d released=%d "
+         "pooled_bytes=%" V8_PTR_PREFIX "d\n",
+         hits_, misses_, recycled_, released_,
+         static_cast<intptr_t>(pooled_bytes_));
+}
+
+} }  // namespace v8::internal
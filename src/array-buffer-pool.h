@@ -0,0 +1,85 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_ARRAY_BUFFER_POOL_H_
+#define V8_ARRAY_BUFFER_POOL_H_
+
+#include "allocation.h"
+#include "list.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Recycles the backing stores of ArrayBuffers allocated by V8 when
+// --array-buffer-pool is on.  Only stores whose length is one of a few
+// small size classes are pooled, and they are always handed out again for
+// a buffer of exactly the same length, so the length passed to the
+// embedder's ArrayBuffer::Allocator stays right even for buffers that are
+// later externalized.  Pooled stores are not counted as external memory:
+// they are unreachable from the heap and a GC would not free them.
+class ArrayBufferPool {
+ public:
+  ArrayBufferPool();
+
+  // Returns a backing store of |length| bytes, or NULL if the embedder's
+  // allocator fails.  The store is zero-filled if |initialize| is set.
+  void* Allocate(size_t length, bool initialize);
+
+  // Frees the backing store of a buffer of |length| bytes, keeping it for
+  // reuse if the pool has room for it.
+  void Free(void* data, size_t length);
+
+  // Returns all pooled backing stores to the embedder's allocator.
+  void Flush();
+
+  void PrintStatistics();
+
+  size_t pooled_bytes() const { return pooled_bytes_; }
+  int hits() const { return hits_; }
+  int misses() const { return misses_; }
+
+ private:
+  // Size classes are the multiples of the granularity up to the maximum.
+  static const size_t kSizeClassGranularity = 4 * KB;
+  static const int kNumberOfSizeClasses = 16;
+
+  static int SizeClass(size_t length);
+
+  List<void*> free_lists_[kNumberOfSizeClasses];
+  size_t pooled_bytes_;
+  int hits_;
+  int misses_;
+  int recycled_;
+  int released_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArrayBufferPool);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_ARRAY_BUFFER_POOL_H_
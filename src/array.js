@@ -856,7 +856,8 @@ function ArraySort(comparefn) {
   // In-place QuickSort algorithm.
   // For short (length <= 22) arrays, insertion sort is used for efficiency.
 
-  if (!IS_SPEC_FUNCTION(comparefn)) {
+  var is_default_order = !IS_SPEC_FUNCTION(comparefn);
+  if (is_default_order) {
     comparefn = function (x, y) {
       if (x === y) return 0;
       if (%_IsSmi(x) && %_IsSmi(y)) {
@@ -1115,7 +1116,8 @@ function ArraySort(comparefn) {
     max_prototype_element = CopyFromPrototype(this, length);
   }
 
-  var num_non_undefined = %IsObserved(this) ?
+  var is_observed = %IsObserved(this);
+  var num_non_undefined = is_observed ?
       -1 : %RemoveArrayHoles(this, length);
 
   if (num_non_undefined == -1) {
@@ -1125,7 +1127,11 @@ function ArraySort(comparefn) {
     num_non_undefined = SafeRemoveArrayHoles(this);
   }
 
-  QuickSort(this, 0, num_non_undefined);
+  // Arrays of numbers in the default order are sorted natively.
+  if (!is_array || !is_default_order || is_observed ||
+      !%SortNumberElements(this, num_non_undefined)) {
+    QuickSort(this, 0, num_non_undefined);
+  }
 
   if (!is_array && (num_non_undefined + 1 < max_prototype_element)) {
     // For compatibility with JSC, we shadow any elements in the prototype
@@ -1172,13 +1178,23 @@ function ArrayFilter(f, receiver) {
       }
     }
   } else {
-    // This is a duplicate of the previous loop sans debug stepping.
+    // This is a duplicate of the previous loop sans debug stepping, except
+    // that elements of arrays are read before checking their presence.
+    // Nothing can observe the order of the two for arrays, and the 'in'
+    // check, which is a call into the runtime, is only needed for elements
+    // that read as undefined.
+    var is_array = IS_ARRAY(array);
     for (var i = 0; i < length; i++) {
-      if (i in array) {
-        var element = array[i];
-        if (%_CallFunction(receiver, element, i, array, f)) {
-          accumulator[accumulator_length++] = element;
-        }
+      var element;
+      if (is_array) {
+        element = array[i];
+        if (IS_UNDEFINED(element) && !(i in array)) continue;
+      } else {
+        if (!(i in array)) continue;
+        element = array[i];
+      }
+      if (%_CallFunction(receiver, element, i, array, f)) {
+        accumulator[accumulator_length++] = element;
       }
     }
     // End of duplicate.
@@ -1215,12 +1231,19 @@ function ArrayForEach(f, receiver) {
       }
     }
   } else {
-    // This is a duplicate of the previous loop sans debug stepping.
+    // This is a duplicate of the previous loop sans debug stepping, except
+    // that elements of arrays are read before checking their presence.
+    var is_array = IS_ARRAY(array);
     for (var i = 0; i < length; i++) {
-      if (i in array) {
-        var element = array[i];
-        %_CallFunction(receiver, element, i, array, f);
+      var element;
+      if (is_array) {
+        element = array[i];
+        if (IS_UNDEFINED(element) && !(i in array)) continue;
+      } else {
+        if (!(i in array)) continue;
+        element = array[i];
       }
+      %_CallFunction(receiver, element, i, array, f);
     }
     // End of duplicate.
   }
@@ -1256,12 +1279,19 @@ function ArraySome(f, receiver) {
       }
     }
   } else {
-    // This is a duplicate of the previous loop sans debug stepping.
+    // This is a duplicate of the previous loop sans debug stepping, except
+    // that elements of arrays are read before checking their presence.
+    var is_array = IS_ARRAY(array);
     for (var i = 0; i < length; i++) {
-      if (i in array) {
-        var element = array[i];
-        if (%_CallFunction(receiver, element, i, array, f)) return true;
+      var element;
+      if (is_array) {
+        element = array[i];
+        if (IS_UNDEFINED(element) && !(i in array)) continue;
+      } else {
+        if (!(i in array)) continue;
+        element = array[i];
       }
+      if (%_CallFunction(receiver, element, i, array, f)) return true;
     }
     // End of duplicate.
   }
@@ -1296,12 +1326,19 @@ function ArrayEvery(f, receiver) {
       }
     }
   } else {
-    // This is a duplicate of the previous loop sans debug stepping.
+    // This is a duplicate of the previous loop sans debug stepping, except
+    // that elements of arrays are read before checking their presence.
+    var is_array = IS_ARRAY(array);
     for (var i = 0; i < length; i++) {
-      if (i in array) {
-        var element = array[i];
-        if (!%_CallFunction(receiver, element, i, array, f)) return false;
+      var element;
+      if (is_array) {
+        element = array[i];
+        if (IS_UNDEFINED(element) && !(i in array)) continue;
+      } else {
+        if (!(i in array)) continue;
+        element = array[i];
       }
+      if (!%_CallFunction(receiver, element, i, array, f)) return false;
     }
     // End of duplicate.
   }
@@ -1337,12 +1374,19 @@ function ArrayMap(f, receiver) {
       }
     }
   } else {
-    // This is a duplicate of the previous loop sans debug stepping.
+    // This is a duplicate of the previous loop sans debug stepping, except
+    // that elements of arrays are read before checking their presence.
+    var is_array = IS_ARRAY(array);
     for (var i = 0; i < length; i++) {
-      if (i in array) {
-        var element = array[i];
-        accumulator[i] = %_CallFunction(receiver, element, i, array, f);
+      var element;
+      if (is_array) {
+        element = array[i];
+        if (IS_UNDEFINED(element) && !(i in array)) continue;
+      } else {
+        if (!(i in array)) continue;
+        element = array[i];
       }
+      accumulator[i] = %_CallFunction(receiver, element, i, array, f);
     }
     // End of duplicate.
   }
@@ -114,6 +114,25 @@ static Mutex* math_exp_data_mutex = NULL;
 static double* math_exp_constants_array = NULL;
 static double* math_exp_log_table_array = NULL;
 
+// Constants for the inline Math.log code (MathLogGenerator). The polynomial
+// and the split of ln(2) are the ones of fdlibm's __ieee754_log, the result
+// is within 1 ulp of the exact value.
+static const double math_log_constants_array[] = {
+  18014398509481984.0,       // 2^54, scales subnormals to normal numbers.
+  1.0,
+  2.0,
+  1.479819860511658591e-01,  // Lg7
+  1.531383769920937332e-01,  // Lg6
+  1.818357216161805012e-01,  // Lg5
+  2.222219843214978396e-01,  // Lg4
+  2.857142874366239149e-01,  // Lg3
+  3.999999999940941908e-01,  // Lg2
+  6.666666666666735130e-01,  // Lg1
+  0.5,
+  1.90821492927058770002e-10,  // Low part of ln(2).
+  6.93147180369123816490e-01   // High part of ln(2), 32 significant bits.
+};
+
 // -----------------------------------------------------------------------------
 // Implementation of AssemblerBase
 
@@ -1379,6 +1398,13 @@ ExternalReference ExternalReference::address_of_regexp_stack_memory_size(
   return ExternalReference(isolate->regexp_stack()->memory_size_address());
 }
 
+
+ExternalReference ExternalReference::address_of_regexp_backtrack_count(
+    Isolate* isolate) {
+  return ExternalReference(reinterpret_cast<Address>(
+      isolate->regexp_stack()->backtrack_count_address()));
+}
+
 #endif  // V8_INTERPRETED_REGEXP
 
 
@@ -1404,6 +1430,15 @@ ExternalReference ExternalReference::math_exp_log_table() {
 }
 
 
+ExternalReference ExternalReference::math_log_constants(int constant_index) {
+  ASSERT(0 <= constant_index);
+  ASSERT(static_cast<size_t>(constant_index) <
+         ARRAY_SIZE(math_log_constants_array));
+  return ExternalReference(reinterpret_cast<void*>(
+      const_cast<double*>(math_log_constants_array + constant_index)));
+}
+
+
 ExternalReference ExternalReference::page_flags(Page* page) {
   return ExternalReference(reinterpret_cast<Address>(page) +
                            MemoryChunk::kFlagsOffset);
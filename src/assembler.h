@@ -377,7 +377,9 @@ class RelocInfo BASE_EMBEDDED {
   Code* host() const { return host_; }
 
   // Apply a relocation by delta bytes
-  INLINE(void apply(intptr_t delta));
+  INLINE(void apply(intptr_t delta,
+                    ICacheFlushMode icache_flush_mode =
+                        FLUSH_ICACHE_IF_NEEDED));
 
   // Is the pointer this relocation info refers to coded like a plain pointer
   // or is it strange in some way (e.g. relative or patched into a series of
@@ -388,12 +390,16 @@ class RelocInfo BASE_EMBEDDED {
   // this relocation applies to;
   // can only be called if IsCodeTarget(rmode_) || IsRuntimeEntry(rmode_)
   INLINE(Address target_address());
-  INLINE(void set_target_address(Address target,
-                                 WriteBarrierMode mode = UPDATE_WRITE_BARRIER));
+  INLINE(void set_target_address(
+      Address target,
+      WriteBarrierMode mode = UPDATE_WRITE_BARRIER,
+      ICacheFlushMode icache_flush_mode = FLUSH_ICACHE_IF_NEEDED));
   INLINE(Object* target_object());
   INLINE(Handle<Object> target_object_handle(Assembler* origin));
-  INLINE(void set_target_object(Object* target,
-                                WriteBarrierMode mode = UPDATE_WRITE_BARRIER));
+  INLINE(void set_target_object(
+      Object* target,
+      WriteBarrierMode mode = UPDATE_WRITE_BARRIER,
+      ICacheFlushMode icache_flush_mode = FLUSH_ICACHE_IF_NEEDED));
   INLINE(Address target_runtime_entry(Assembler* origin));
   INLINE(void set_target_runtime_entry(Address target,
                                        WriteBarrierMode mode =
@@ -756,6 +762,8 @@ class ExternalReference BASE_EMBEDDED {
       Isolate* isolate);
   static ExternalReference address_of_regexp_stack_memory_size(
       Isolate* isolate);
+  static ExternalReference address_of_regexp_backtrack_count(
+      Isolate* isolate);
 
   // Static variable Heap::NewSpaceStart()
   static ExternalReference new_space_start(Isolate* isolate);
@@ -810,6 +818,8 @@ class ExternalReference BASE_EMBEDDED {
   static ExternalReference math_exp_constants(int constant_index);
   static ExternalReference math_exp_log_table();
 
+  static ExternalReference math_log_constants(int constant_index);
+
   static ExternalReference page_flags(Page* page);
 
   static ExternalReference ForDeoptEntry(Address entry);
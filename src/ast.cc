@@ -595,7 +595,8 @@ void Expression::RecordToBooleanTypeFeedback(TypeFeedbackOracle* oracle) {
 
 int Call::ComputeFeedbackSlotCount(Isolate* isolate) {
   CallType call_type = GetCallType(isolate);
-  if (call_type == LOOKUP_SLOT_CALL || call_type == OTHER_CALL) {
+  if (call_type == LOOKUP_SLOT_CALL || call_type == OTHER_CALL ||
+      call_type == PROPERTY_CALL) {
     // Call only uses a slot in some cases.
     return 1;
   }
@@ -1125,7 +1126,6 @@ DONT_OPTIMIZE_NODE(ModuleUrl)
 DONT_OPTIMIZE_NODE(ModuleStatement)
 DONT_OPTIMIZE_NODE(Yield)
 DONT_OPTIMIZE_NODE(WithStatement)
-DONT_OPTIMIZE_NODE(TryCatchStatement)
 DONT_OPTIMIZE_NODE(TryFinallyStatement)
 DONT_OPTIMIZE_NODE(DebuggerStatement)
 DONT_OPTIMIZE_NODE(NativeFunctionLiteral)
@@ -1139,6 +1139,16 @@ DONT_SELFOPTIMIZE_NODE(ForOfStatement)
 DONT_CACHE_NODE(ModuleLiteral)
 
 
+void AstConstructionVisitor::VisitTryCatchStatement(TryCatchStatement* node) {
+  increase_node_count();
+  // Crankshaft compiles try/catch only in the outermost function of an
+  // optimized frame, so functions containing one are never inlined.
+  if (!FLAG_optimize_try_catch) set_dont_optimize_reason(kTryCatchStatement);
+  add_flag(kDontInline);
+  add_flag(kDontSelfOptimize);
+}
+
+
 void AstConstructionVisitor::VisitCallRuntime(CallRuntime* node) {
   increase_node_count();
   if (node->is_jsruntime()) {
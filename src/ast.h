@@ -1286,6 +1286,13 @@ class TryCatchStatement V8_FINAL : public TryStatement {
   Variable* variable() { return variable_; }
   Block* catch_block() const { return catch_block_; }
 
+  // Bailout points for optimized code: entering the catch block with the
+  // exception in the result register, entering the try block after the
+  // handler has been pushed, and leaving the statement.
+  BailoutId HandlerId() const { return handler_id_; }
+  BailoutId BodyId() const { return body_id_; }
+  BailoutId ExitId() const { return exit_id_; }
+
  protected:
   TryCatchStatement(Zone* zone,
                     int index,
@@ -1297,13 +1304,19 @@ class TryCatchStatement V8_FINAL : public TryStatement {
       : TryStatement(zone, index, try_block, pos),
         scope_(scope),
         variable_(variable),
-        catch_block_(catch_block) {
+        catch_block_(catch_block),
+        handler_id_(GetNextId(zone)),
+        body_id_(GetNextId(zone)),
+        exit_id_(GetNextId(zone)) {
   }
 
  private:
   Scope* scope_;
   Variable* variable_;
   Block* catch_block_;
+  const BailoutId handler_id_;
+  const BailoutId body_id_;
+  const BailoutId exit_id_;
 };
 
 
@@ -2355,6 +2368,7 @@ class FunctionLiteral V8_FINAL : public Expression {
   // function will be called immediately:
   // - (function() { ... })();
   // - var x = function() { ... }();
+  // - function f() { ... } f(); when preparse data predicts the call.
   bool is_parenthesized() {
     return IsParenthesized::decode(bitfield_) == kIsParenthesized;
   }
@@ -1351,14 +1351,18 @@ void Genesis::InitializeExperimentalGlobal() {
 
   if (FLAG_harmony_collections) {
     {  // -- S e t
-      InstallFunction(global, "Set", JS_SET_TYPE, JSSet::kSize,
-                      isolate()->initial_object_prototype(),
-                      Builtins::kIllegal, true, true);
+      Handle<JSFunction> set_fun =
+          InstallFunction(global, "Set", JS_SET_TYPE, JSSet::kSize,
+                          isolate()->initial_object_prototype(),
+                          Builtins::kIllegal, true, true);
+      native_context()->set_set_function(*set_fun);
     }
     {  // -- M a p
-      InstallFunction(global, "Map", JS_MAP_TYPE, JSMap::kSize,
-                      isolate()->initial_object_prototype(),
-                      Builtins::kIllegal, true, true);
+      Handle<JSFunction> map_fun =
+          InstallFunction(global, "Map", JS_MAP_TYPE, JSMap::kSize,
+                          isolate()->initial_object_prototype(),
+                          Builtins::kIllegal, true, true);
+      native_context()->set_map_function(*map_fun);
     }
     {  // -- W e a k M a p
       InstallFunction(global, "WeakMap", JS_WEAK_MAP_TYPE, JSWeakMap::kSize,
@@ -1520,6 +1524,7 @@ bool Genesis::CompileScriptCached(Isolate* isolate,
         top_context,
         extension,
         NULL,
+        NO_CACHED_DATA,
         use_runtime_context ? NATIVES_CODE : NOT_NATIVES_CODE);
     if (function_info.is_null()) return false;
     if (cache != NULL) cache->Add(name, function_info);
@@ -1587,16 +1592,17 @@ void Genesis::InstallNativeFunctions() {
 
 
 void Genesis::InstallExperimentalNativeFunctions() {
-  INSTALL_NATIVE(JSFunction, "RunMicrotasks", run_microtasks);
-  INSTALL_NATIVE(JSFunction, "EnqueueExternalMicrotask",
-                 enqueue_external_microtask);
-
   if (FLAG_harmony_proxies) {
     INSTALL_NATIVE(JSFunction, "DerivedHasTrap", derived_has_trap);
     INSTALL_NATIVE(JSFunction, "DerivedGetTrap", derived_get_trap);
     INSTALL_NATIVE(JSFunction, "DerivedSetTrap", derived_set_trap);
     INSTALL_NATIVE(JSFunction, "ProxyEnumerate", proxy_enumerate);
   }
+  if (FLAG_harmony_promises) {
+    INSTALL_NATIVE(JSFunction, "PromiseHandle", promise_handle);
+    INSTALL_NATIVE(JSFunction, "PromiseHandleResult", promise_handle_result);
+    INSTALL_NATIVE(JSFunction, "PromiseHandleError", promise_handle_error);
+  }
 }
 
 #undef INSTALL_NATIVE
@@ -2046,6 +2052,7 @@ bool Genesis::InstallExperimentalNatives() {
     INSTALL_EXPERIMENTAL_NATIVE(i, strings, "harmony-string.js")
     INSTALL_EXPERIMENTAL_NATIVE(i, arrays, "harmony-array.js")
     INSTALL_EXPERIMENTAL_NATIVE(i, maths, "harmony-math.js")
+    INSTALL_EXPERIMENTAL_NATIVE(i, atomics, "harmony-atomics.js")
   }
 
   InstallExperimentalNativeFunctions();
@@ -0,0 +1,99 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_BOUNDED_MPMC_QUEUE_INL_H_
+#define V8_BOUNDED_MPMC_QUEUE_INL_H_
+
+#include "bounded-mpmc-queue.h"
+
+#include "atomicops.h"
+
+namespace v8 {
+namespace internal {
+
+template<typename Record, unsigned Length>
+BoundedMPMCQueue<Record, Length>::BoundedMPMCQueue()
+    : enqueue_pos_(0), dequeue_pos_(0) {
+  for (unsigned i = 0; i < Length; i++) {
+    buffer_[i].sequence = static_cast<AtomicWord>(i);
+  }
+}
+
+
+template<typename Record, unsigned Length>
+bool BoundedMPMCQueue<Record, Length>::Enqueue(const Record& rec) {
+  Cell* cell;
+  AtomicWord pos = NoBarrier_Load(&enqueue_pos_);
+  for (;;) {
+    cell = &buffer_[pos & kMask];
+    AtomicWord diff = Acquire_Load(&cell->sequence) - pos;
+    if (diff == 0) {
+      // The cell is free for this lap; try to claim it.
+      AtomicWord old = NoBarrier_CompareAndSwap(&enqueue_pos_, pos, pos + 1);
+      if (old == pos) break;
+      pos = old;
+    } else if (diff < 0) {
+      // The cell still holds the record of the previous lap.
+      return false;
+    } else {
+      pos = NoBarrier_Load(&enqueue_pos_);
+    }
+  }
+  cell->value = rec;
+  Release_Store(&cell->sequence, pos + 1);
+  return true;
+}
+
+
+template<typename Record, unsigned Length>
+bool BoundedMPMCQueue<Record, Length>::Dequeue(Record* rec) {
+  Cell* cell;
+  AtomicWord pos = NoBarrier_Load(&dequeue_pos_);
+  for (;;) {
+    cell = &buffer_[pos & kMask];
+    AtomicWord diff = Acquire_Load(&cell->sequence) - (pos + 1);
+    if (diff == 0) {
+      // The cell holds a record for this lap; try to claim it.
+      AtomicWord old = NoBarrier_CompareAndSwap(&dequeue_pos_, pos, pos + 1);
+      if (old == pos) break;
+      pos = old;
+    } else if (diff < 0) {
+      // No producer has filled the cell yet.
+      return false;
+    } else {
+      pos = NoBarrier_Load(&dequeue_pos_);
+    }
+  }
+  *rec = cell->value;
+  // Free the cell for the producers of the next lap.
+  Release_Store(&cell->sequence, pos + kMask + 1);
+  return true;
+}
+
+} }  // namespace v8::internal
+
+#endif  // V8_BOUNDED_MPMC_QUEUE_INL_H_
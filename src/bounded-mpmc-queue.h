@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_BOUNDED_MPMC_QUEUE_H_
+#define V8_BOUNDED_MPMC_QUEUE_H_
+
+#include "allocation.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Lock-free bounded queue for small records, usable by any number of
+// producer and consumer threads. Each slot carries a sequence number that
+// tells producers and consumers whether it is free or holds a record for
+// the current lap, so neither side ever takes a lock; contended threads
+// retry a compare-and-swap on the shared position. Enqueue returns false
+// if the queue is full and Dequeue returns false if it is empty. Length
+// must be a power of two. Implemented after Dmitry Vyukov's bounded MPMC
+// queue.
+template<typename Record, unsigned Length>
+class BoundedMPMCQueue {
+ public:
+  BoundedMPMCQueue();
+
+  bool Enqueue(const Record& rec);
+  bool Dequeue(Record* rec);
+
+ private:
+  STATIC_ASSERT(Length > 1 && (Length & (Length - 1)) == 0);
+  static const AtomicWord kMask = Length - 1;
+
+  struct Cell {
+    AtomicWord sequence;
+    Record value;
+  };
+
+  Cell buffer_[Length];
+  V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) AtomicWord enqueue_pos_;
+  V8_ALIGNED(PROCESSOR_CACHE_LINE_SIZE) AtomicWord dequeue_pos_;
+
+  DISALLOW_COPY_AND_ASSIGN(BoundedMPMCQueue);
+};
+
+
+} }  // namespace v8::internal
+
+#endif  // V8_BOUNDED_MPMC_QUEUE_H_
@@ -129,8 +129,11 @@ BUILTIN_LIST_C(DEF_ARG_TYPE)
 #define BUILTIN(name)                                            \
   MUST_USE_RESULT static MaybeObject* Builtin_Impl_##name(       \
       name##ArgumentsType args, Isolate* isolate);               \
+  static RuntimeCallCounter Builtin_Counter_##name =             \
+      RUNTIME_CALL_COUNTER_INITIALIZER("Builtin_" #name);        \
   MUST_USE_RESULT static MaybeObject* Builtin_##name(            \
       int args_length, Object** args_object, Isolate* isolate) { \
+    RuntimeCallTimerScope timer(&Builtin_Counter_##name);        \
     name##ArgumentsType args(args_length, args_object);          \
     args.Verify();                                               \
     return Builtin_Impl_##name(args, isolate);                   \
@@ -143,8 +146,11 @@ BUILTIN_LIST_C(DEF_ARG_TYPE)
 #define BUILTIN(name)                                            \
   static MaybeObject* Builtin_impl##name(                        \
       name##ArgumentsType args, Isolate* isolate);               \
+  static RuntimeCallCounter Builtin_Counter_##name =             \
+      RUNTIME_CALL_COUNTER_INITIALIZER("Builtin_" #name);        \
   static MaybeObject* Builtin_##name(                            \
       int args_length, Object** args_object, Isolate* isolate) { \
+    RuntimeCallTimerScope timer(&Builtin_Counter_##name);        \
     name##ArgumentsType args(args_length, args_object);          \
     return Builtin_impl##name(args, isolate);                    \
   }                                                              \
@@ -656,6 +662,34 @@ BUILTIN(ArrayUnshift) {
 }
 
 
+// Arrays at least this long share their backing store with a copy made by
+// slice or concat instead of copying it.  The source pays for that with a
+// copy on its next write, which is only worth risking for large stores.
+static const int kMinCopyOnWriteShareLength = 64;
+
+
+// Returns a new JSArray of the given kind and length that shares the
+// elements of |source| copy-on-write, or NULL if the backing store cannot
+// be shared.  The first write to either array copies the store.
+MUST_USE_RESULT
+static MaybeObject* ShareElementsCopyOnWrite(Heap* heap,
+                                             JSArray* source,
+                                             ElementsKind kind,
+                                             int length) {
+  if (length < kMinCopyOnWriteShareLength) return NULL;
+  if (!IsFastSmiOrObjectElementsKind(kind)) return NULL;
+  if (!source->HasFastSmiOrObjectElements()) return NULL;
+  FixedArray* elms = FixedArray::cast(source->elements());
+  if (elms->map() == heap->fixed_array_map()) {
+    elms->set_map(heap->fixed_cow_array_map());
+  } else if (elms->map() != heap->fixed_cow_array_map()) {
+    return NULL;
+  }
+  heap->isolate()->counters()->cow_arrays_created_builtin()->Increment();
+  return heap->AllocateJSArrayWithElements(elms, kind, length);
+}
+
+
 BUILTIN(ArraySlice) {
   Heap* heap = isolate->heap();
   Object* receiver = *args.receiver();
@@ -770,6 +804,13 @@ BUILTIN(ArraySlice) {
     }
   }
 
+  // Slicing a whole array is a common way of copying it.
+  if (receiver->IsJSArray() && k == 0 && result_len == len) {
+    MaybeObject* maybe_shared = ShareElementsCopyOnWrite(
+        heap, JSArray::cast(receiver), kind, result_len);
+    if (maybe_shared != NULL) return maybe_shared;
+  }
+
   JSArray* result_array;
   MaybeObject* maybe_array = heap->AllocateJSArrayAndStorage(kind,
                                                              result_len,
@@ -1042,6 +1083,24 @@ BUILTIN(ArrayConcat) {
 
   if (is_holey) elements_kind = GetHoleyElementsKind(elements_kind);
 
+  // When all but one of the arrays are empty the result is a copy of that
+  // one, e.g. for [].concat(a) or a.concat().
+  if (result_len > 0) {
+    JSArray* only_non_empty = NULL;
+    for (int i = 0; i < n_arguments; i++) {
+      JSArray* array = JSArray::cast(args[i]);
+      if (Smi::cast(array->length())->value() == result_len) {
+        only_non_empty = array;
+        break;
+      }
+    }
+    if (only_non_empty != NULL) {
+      MaybeObject* maybe_shared = ShareElementsCopyOnWrite(
+          heap, only_non_empty, elements_kind, result_len);
+      if (maybe_shared != NULL) return maybe_shared;
+    }
+  }
+
   // If a double array is concatted into a fast elements array, the fast
   // elements array needs to be initialized to contain proper holes, since
   // boxing doubles may cause incremental marking.
@@ -1079,6 +1138,108 @@ BUILTIN(ArrayConcat) {
 }
 
 
+// Returns the index of the first element of a fast elements array that is
+// strictly equal to the search element.  Holes never match: with no
+// elements on the prototype chain they read as undefined but are not
+// present, and indexOf skips elements that are not present.
+template <typename Predicate>
+static int FastIndexOf(FixedArray* elements,
+                       int from,
+                       int to,
+                       Predicate matches) {
+  for (int i = from; i < to; i++) {
+    if (matches(elements->get(i))) return i;
+  }
+  return -1;
+}
+
+
+struct RawIdentityPredicate {
+  explicit RawIdentityPredicate(Object* element) : element_(element) { }
+  bool operator()(Object* value) const { return value == element_; }
+  Object* element_;
+};
+
+
+struct NumberEqualsPredicate {
+  explicit NumberEqualsPredicate(double element) : element_(element) { }
+  bool operator()(Object* value) const {
+    return value->IsNumber() && value->Number() == element_;
+  }
+  double element_;
+};
+
+
+struct StringEqualsPredicate {
+  explicit StringEqualsPredicate(String* element) : element_(element) { }
+  bool operator()(Object* value) const {
+    return value->IsString() && String::cast(value)->Equals(element_);
+  }
+  String* element_;
+};
+
+
+BUILTIN(ArrayIndexOf) {
+  Heap* heap = isolate->heap();
+  Object* receiver = *args.receiver();
+  if (!receiver->IsJSArray()) {
+    return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+  }
+  JSArray* array = JSArray::cast(receiver);
+  if (!array->HasFastSmiOrObjectElements() &&
+      !array->HasFastDoubleElements()) {
+    return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+  }
+  if (!IsJSArrayFastElementMovingAllowed(heap, array) ||
+      !array->length()->IsSmi()) {
+    return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+  }
+  int len = Smi::cast(array->length())->value();
+
+  Object* element = args.length() > 1 ? args[1] : heap->undefined_value();
+  int from = 0;
+  if (args.length() > 2) {
+    Object* arg = args[2];
+    if (arg->IsSmi()) {
+      from = Smi::cast(arg)->value();
+      if (from < 0) from = Max(0, len + from);
+    } else if (!arg->IsUndefined()) {
+      return CallJsBuiltin(isolate, "ArrayIndexOf", args);
+    }
+  }
+  if (from >= len) return Smi::FromInt(-1);
+
+  if (array->HasFastDoubleElements()) {
+    if (!element->IsNumber()) return Smi::FromInt(-1);
+    double search = element->Number();
+    FixedDoubleArray* elements = FixedDoubleArray::cast(array->elements());
+    for (int i = from; i < len; i++) {
+      if (!elements->is_the_hole(i) && elements->get_scalar(i) == search) {
+        return Smi::FromInt(i);
+      }
+    }
+    return Smi::FromInt(-1);
+  }
+
+  FixedArray* elements = FixedArray::cast(array->elements());
+  int index;
+  if (element->IsSmi() && array->HasFastSmiElements()) {
+    // Only smis (and holes) to compare with, so identity suffices.
+    index = FastIndexOf(elements, from, len, RawIdentityPredicate(element));
+  } else if (element->IsNumber()) {
+    index = FastIndexOf(
+        elements, from, len, NumberEqualsPredicate(element->Number()));
+  } else if (element->IsString()) {
+    index = FastIndexOf(
+        elements, from, len, StringEqualsPredicate(String::cast(element)));
+  } else {
+    // Holes are a distinct oddball, so they never match undefined here.
+    index = FastIndexOf(elements, from, len, RawIdentityPredicate(element));
+  }
+  return Smi::FromInt(index);
+}
+
+
 // -----------------------------------------------------------------------------
 // Strict mode poison pills
 
@@ -76,6 +76,7 @@ enum BuiltinExtraArguments {
   V(ArraySlice, NO_EXTRA_ARGUMENTS)                                 \
   V(ArraySplice, NO_EXTRA_ARGUMENTS)                                \
   V(ArrayConcat, NO_EXTRA_ARGUMENTS)                                \
+  V(ArrayIndexOf, NO_EXTRA_ARGUMENTS)                               \
                                                                     \
   V(HandleApiCall, NEEDS_CALLED_FUNCTION)                           \
   V(HandleApiCallConstruct, NEEDS_CALLED_FUNCTION)                  \
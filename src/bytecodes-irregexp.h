@@ -88,7 +88,11 @@ V(CHECK_AT_START,    43, 8)   /* bc8 pad24 addr32                           */ \
 V(CHECK_NOT_AT_START, 44, 8)  /* bc8 pad24 addr32                           */ \
 V(CHECK_GREEDY,      45, 8)   /* bc8 pad24 addr32                           */ \
 V(ADVANCE_CP_AND_GOTO, 46, 8) /* bc8 offset24 addr32                        */ \
-V(SET_CURRENT_POSITION_FROM_END, 47, 4) /* bc8 idx24                        */
+V(SET_CURRENT_POSITION_FROM_END, 47, 4) /* bc8 idx24                        */ \
+V(LOAD_CHAR_CHECK_CHAR, 48, 16) /* bc8 offset24 addr32 uint32 addr32        */ \
+V(LOAD_CHAR_CHECK_NOT_CHAR, 49, 16) /* bc8 offset24 addr32 uint32 addr32    */ \
+V(LOAD_CHAR_UNCHECKED_CHECK_CHAR, 50, 12) /* bc8 offset24 uint32 addr32     */ \
+V(LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR, 51, 12) /* bc8 offset24 uint32 addr32 */
 
 #define DECLARE_BYTECODES(name, code, length) \
   static const int BC_##name = code;
@@ -99,6 +103,11 @@ BYTECODE_ITERATOR(DECLARE_BYTECODES)
   static const int BC_##name##_LENGTH = length;
 BYTECODE_ITERATOR(DECLARE_BYTECODE_LENGTH)
 #undef DECLARE_BYTECODE_LENGTH
+
+// Bytecodes are numbered consecutively from 0 to BYTECODE_COUNT - 1.
+#define COUNT_BYTECODE(name, code, length) + 1
+static const int BYTECODE_COUNT = 0 BYTECODE_ITERATOR(COUNT_BYTECODE);
+#undef COUNT_BYTECODE
 } }
 
 #endif  // V8_BYTECODES_IRREGEXP_H_
@@ -83,6 +83,16 @@ inline bool IsBinaryDigit(uc32 c) {
 }
 
 
+inline bool IsAsciiIdentifierPart(uc32 c) {
+  // The one-byte subset of IdentifierPart, without the '\\' that starts a
+  // unicode escape sequence.
+  return IsInRange(AsciiAlphaToLower(c), 'a', 'z')
+      || IsDecimalDigit(c)
+      || (c == '$')
+      || (c == '_');
+}
+
+
 inline bool IsRegExpWord(uc16 c) {
   return IsInRange(AsciiAlphaToLower(c), 'a', 'z')
       || IsDecimalDigit(c)
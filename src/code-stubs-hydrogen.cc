@@ -81,6 +81,7 @@ class CodeStubGraphBuilderBase : public HGraphBuilder {
   HContext* context() { return context_; }
   Isolate* isolate() { return info_.isolate(); }
 
+  HValue* BuildLoadConstant(HValue* object, int descriptor);
   HLoadNamedField* BuildLoadNamedField(HValue* object,
                                        Representation representation,
                                        int offset,
@@ -98,6 +99,10 @@ class CodeStubGraphBuilderBase : public HGraphBuilder {
   HValue* BuildInternalArrayConstructor(ElementsKind kind,
                                         ArgumentClass argument_class);
 
+  HValue* BuildCloneShallowObject(HValue* boilerplate,
+                                  HValue* allocation_site,
+                                  int object_size);
+
   void BuildInstallOptimizedCode(HValue* js_function, HValue* native_context,
                                  HValue* code_object);
   void BuildInstallCode(HValue* js_function, HValue* shared_info);
@@ -422,18 +427,17 @@ HValue* CodeStubGraphBuilder<FastCloneShallowObjectStub>::BuildCodeStub() {
   IfBuilder checker(this);
   checker.IfNot<HCompareObjectEqAndBranch, HValue*>(allocation_site,
                                                     undefined);
-  checker.And();
+  checker.Then();
 
   HObjectAccess access = HObjectAccess::ForAllocationSiteOffset(
       AllocationSite::kTransitionInfoOffset);
   HInstruction* boilerplate = Add<HLoadNamedField>(
       allocation_site, static_cast<HValue*>(NULL), access);
 
-  int size = JSObject::kHeaderSize + casted_stub()->length() * kPointerSize;
-  int object_size = size;
-  if (FLAG_allocation_site_pretenuring) {
-    size += AllocationMemento::kSize;
-  }
+  int object_size =
+      JSObject::kHeaderSize + casted_stub()->length() * kPointerSize;
+  int slack_object_size =
+      object_size + JSObject::kLiteralSlackProperties * kPointerSize;
 
   HValue* boilerplate_map = Add<HLoadNamedField>(
       boilerplate, static_cast<HValue*>(NULL),
@@ -442,9 +446,42 @@ HValue* CodeStubGraphBuilder<FastCloneShallowObjectStub>::BuildCodeStub() {
       boilerplate_map, static_cast<HValue*>(NULL),
       HObjectAccess::ForMapInstanceSize());
   HValue* size_in_words = Add<HConstant>(object_size >> kPointerSizeLog2);
-  checker.If<HCompareNumericAndBranch>(boilerplate_size,
-                                       size_in_words, Token::EQ);
-  checker.Then();
+  IfBuilder size_checker(this);
+  size_checker.If<HCompareNumericAndBranch>(boilerplate_size,
+                                            size_in_words, Token::EQ);
+  size_checker.Then();
+  environment()->Push(
+      BuildCloneShallowObject(boilerplate, allocation_site, object_size));
+  size_checker.Else();
+
+  // Boilerplates created from a literal map that was given in-object slack
+  // (see Factory::ObjectLiteralMapFromCache) are larger by a fixed amount.
+  IfBuilder slack_checker(this);
+  HValue* slack_size_in_words =
+      Add<HConstant>(slack_object_size >> kPointerSizeLog2);
+  slack_checker.If<HCompareNumericAndBranch>(boilerplate_size,
+                                             slack_size_in_words, Token::EQ);
+  slack_checker.Then();
+  environment()->Push(
+      BuildCloneShallowObject(boilerplate, allocation_site, slack_object_size));
+  slack_checker.ElseDeopt("Unexpected boilerplate size in fast clone");
+  slack_checker.End();
+  size_checker.End();
+
+  checker.ElseDeopt("Uninitialized boilerplate in fast clone");
+  checker.End();
+  return environment()->Pop();
+}
+
+
+HValue* CodeStubGraphBuilderBase::BuildCloneShallowObject(
+    HValue* boilerplate,
+    HValue* allocation_site,
+    int object_size) {
+  int size = object_size;
+  if (FLAG_allocation_site_pretenuring) {
+    size += AllocationMemento::kSize;
+  }
 
   HValue* size_in_bytes = Add<HConstant>(size);
 
@@ -463,12 +500,7 @@ HValue* CodeStubGraphBuilder<FastCloneShallowObjectStub>::BuildCodeStub() {
     BuildCreateAllocationMemento(
         object, Add<HConstant>(object_size), allocation_site);
   }
-
-  environment()->Push(object);
-  checker.ElseDeopt("Uninitialized boilerplate in fast clone");
-  checker.End();
-
-  return environment()->Pop();
+  return object;
 }
 
 
@@ -512,6 +544,12 @@ HValue* CodeStubGraphBuilder<CreateAllocationSiteStub>::BuildCodeStub() {
                             AllocationSite::kPretenureCreateCountOffset),
                         graph()->GetConstant0());
 
+  // Pretenuring survived bytes field.
+  Add<HStoreNamedField>(object,
+                        HObjectAccess::ForAllocationSiteOffset(
+                            AllocationSite::kPretenureSurvivedBytesOffset),
+                        graph()->GetConstant0());
+
   // Store an empty fixed array for the code dependency.
   HConstant* empty_fixed_array =
     Add<HConstant>(isolate()->factory()->empty_fixed_array());
@@ -610,6 +648,40 @@ Handle<Code> KeyedLoadFieldStub::GenerateCode(Isolate* isolate) {
 }
 
 
+HValue* CodeStubGraphBuilderBase::BuildLoadConstant(HValue* object,
+                                                    int descriptor) {
+  HValue* map = Add<HLoadNamedField>(object, static_cast<HValue*>(NULL),
+                                     HObjectAccess::ForMap());
+  HValue* descriptors = Add<HLoadNamedField>(
+      map, static_cast<HValue*>(NULL), HObjectAccess::ForMapDescriptors());
+  HValue* index = Add<HConstant>(DescriptorArray::ToValueIndex(descriptor));
+  return Add<HLoadKeyed>(descriptors, index, static_cast<HValue*>(NULL),
+                         FAST_ELEMENTS);
+}
+
+
+template<>
+HValue* CodeStubGraphBuilder<LoadConstantStub>::BuildCodeStub() {
+  return BuildLoadConstant(GetParameter(0), casted_stub()->descriptor());
+}
+
+
+Handle<Code> LoadConstantStub::GenerateCode(Isolate* isolate) {
+  return DoGenerateCode(isolate, this);
+}
+
+
+template<>
+HValue* CodeStubGraphBuilder<KeyedLoadConstantStub>::BuildCodeStub() {
+  return BuildLoadConstant(GetParameter(0), casted_stub()->descriptor());
+}
+
+
+Handle<Code> KeyedLoadConstantStub::GenerateCode(Isolate* isolate) {
+  return DoGenerateCode(isolate, this);
+}
+
+
 template <>
 HValue* CodeStubGraphBuilder<KeyedStoreFastElementStub>::BuildCodeStub() {
   BuildUncheckedMonomorphicElementAccess(
@@ -1181,8 +1253,12 @@ void CodeStubGraphBuilderBase::BuildInstallFromOptimizedCodeMap(
   is_optimized.Else();
   {
     AddIncrementCounter(counters->fast_new_closure_try_optimized());
-    // optimized_map points to fixed array of 3-element entries
-    // (native context, optimized code, literals).
+    // The map is in use, so it starts aging again.
+    Add<HStoreNamedField>(optimized_map,
+                          HObjectAccess::ForOptimizedCodeMapAge(),
+                          graph()->GetConstant0());
+    // optimized_map points to fixed array of 4-element entries
+    // (native context, optimized code, literals, osr ast id).
     // Map must never be empty, so check the first elements.
     Label install_optimized;
     HValue* first_context_slot = Add<HLoadNamedField>(
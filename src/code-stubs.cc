@@ -542,6 +542,37 @@ void CreateAllocationSiteStub::GenerateAheadOfTime(Isolate* isolate) {
 }
 
 
+// static
+void KeyedLoadFastElementStub::GenerateAheadOfTime(Isolate* isolate) {
+  // Only pay for the fast element loads when building the snapshot, where
+  // they are serialized along with the rest of the code stubs.
+  if (!Serializer::enabled()) return;
+  for (int i = FIRST_FAST_ELEMENTS_KIND; i <= LAST_FAST_ELEMENTS_KIND; ++i) {
+    ElementsKind kind = static_cast<ElementsKind>(i);
+    KeyedLoadFastElementStub array_stub(true, kind);
+    array_stub.GetCode(isolate);
+    KeyedLoadFastElementStub object_stub(false, kind);
+    object_stub.GetCode(isolate);
+  }
+}
+
+
+// static
+void TransitionElementsKindStub::GenerateAheadOfTime(Isolate* isolate) {
+  if (!Serializer::enabled()) return;
+  for (int i = FIRST_FAST_ELEMENTS_KIND; i <= LAST_FAST_ELEMENTS_KIND; ++i) {
+    for (int j = FIRST_FAST_ELEMENTS_KIND; j <= LAST_FAST_ELEMENTS_KIND; ++j) {
+      ElementsKind from_kind = static_cast<ElementsKind>(i);
+      ElementsKind to_kind = static_cast<ElementsKind>(j);
+      if (IsMoreGeneralElementsKindTransition(from_kind, to_kind)) {
+        TransitionElementsKindStub stub(from_kind, to_kind);
+        stub.GetCode(isolate);
+      }
+    }
+  }
+}
+
+
 void KeyedStoreElementStub::Generate(MacroAssembler* masm) {
   switch (elements_kind_) {
     case FAST_ELEMENTS:
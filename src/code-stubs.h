@@ -98,7 +98,9 @@ namespace internal {
   V(CallApiGetter)                       \
   /* IC Handler stubs */                 \
   V(LoadField)                           \
-  V(KeyedLoadField)
+  V(KeyedLoadField)                      \
+  V(LoadConstant)                        \
+  V(KeyedLoadConstant)
 
 // List of code stubs only used on ARM platforms.
 #if defined(V8_TARGET_ARCH_ARM) || defined(V8_TARGET_ARCH_A64)
@@ -960,6 +962,45 @@ class LoadFieldStub: public HandlerStub {
 };
 
 
+// Loads a constant property of the receiver from the instance descriptors
+// of the receiver's map. The stub only depends on the descriptor index, so
+// one copy is shared by all maps that keep the constant at that index.
+class LoadConstantStub : public HandlerStub {
+ public:
+  explicit LoadConstantStub(int descriptor) {
+    Initialize(Code::LOAD_IC, descriptor);
+  }
+
+  virtual Handle<Code> GenerateCode(Isolate* isolate);
+
+  virtual void InitializeInterfaceDescriptor(
+      Isolate* isolate,
+      CodeStubInterfaceDescriptor* descriptor);
+
+  virtual Code::Kind kind() const {
+    return KindBits::decode(bit_field_);
+  }
+
+  int descriptor() {
+    return DescriptorBits::decode(bit_field_);
+  }
+
+  virtual Code::StubType GetStubType() { return Code::FAST; }
+
+ protected:
+  LoadConstantStub() : HandlerStub() { }
+
+  void Initialize(Code::Kind kind, int descriptor) {
+    bit_field_ = KindBits::encode(kind) | DescriptorBits::encode(descriptor);
+  }
+
+ private:
+  STATIC_ASSERT(KindBits::kSize == 4);
+  class DescriptorBits: public BitField<int, 4, kDescriptorIndexBitCount> {};
+  virtual CodeStub::Major MajorKey() { return LoadConstant; }
+};
+
+
 class StoreGlobalStub : public HandlerStub {
  public:
   explicit StoreGlobalStub(bool is_constant) {
@@ -1068,6 +1109,23 @@ class KeyedLoadFieldStub: public LoadFieldStub {
 };
 
 
+class KeyedLoadConstantStub: public LoadConstantStub {
+ public:
+  explicit KeyedLoadConstantStub(int descriptor) : LoadConstantStub() {
+    Initialize(Code::KEYED_LOAD_IC, descriptor);
+  }
+
+  virtual void InitializeInterfaceDescriptor(
+      Isolate* isolate,
+      CodeStubInterfaceDescriptor* descriptor);
+
+  virtual Handle<Code> GenerateCode(Isolate* isolate);
+
+ private:
+  virtual CodeStub::Major MajorKey() { return KeyedLoadConstant; }
+};
+
+
 class BinaryOpICStub : public HydrogenCodeStub {
  public:
   BinaryOpICStub(Token::Value op, OverwriteMode mode)
@@ -1605,8 +1663,8 @@ class CallFunctionStub: public PlatformCodeStub {
   virtual void PrintName(StringStream* stream);
 
   // Minor key encoding in 32 bits with Bitfield <Type, shift, size>.
-  class FlagBits: public BitField<CallFunctionFlags, 0, 2> {};
-  class ArgcBits: public BitField<unsigned, 2, 32 - 2> {};
+  class FlagBits: public BitField<CallFunctionFlags, 0, 3> {};
+  class ArgcBits: public BitField<unsigned, 3, 32 - 3> {};
 
   Major MajorKey() { return CallFunction; }
   int MinorKey() {
@@ -1615,11 +1673,13 @@ class CallFunctionStub: public PlatformCodeStub {
   }
 
   bool RecordCallTarget() {
-    return flags_ == RECORD_CALL_TARGET;
+    return flags_ == RECORD_CALL_TARGET ||
+        flags_ == RECORD_CALL_TARGET_AS_METHOD;
   }
 
   bool CallAsMethod() {
-    return flags_ == CALL_AS_METHOD || flags_ == WRAP_AND_CALL;
+    return flags_ == CALL_AS_METHOD || flags_ == WRAP_AND_CALL ||
+        flags_ == RECORD_CALL_TARGET_AS_METHOD;
   }
 
   bool NeedsChecks() {
@@ -1954,6 +2014,8 @@ class KeyedLoadFastElementStub : public HydrogenCodeStub {
       Isolate* isolate,
       CodeStubInterfaceDescriptor* descriptor);
 
+  static void GenerateAheadOfTime(Isolate* isolate);
+
  private:
   class ElementsKindBits: public BitField<ElementsKind, 0, 8> {};
   class IsJSArrayBits: public BitField<bool, 8, 1> {};
@@ -2029,6 +2091,8 @@ class TransitionElementsKindStub : public HydrogenCodeStub {
       Isolate* isolate,
       CodeStubInterfaceDescriptor* descriptor);
 
+  static void GenerateAheadOfTime(Isolate* isolate);
+
  private:
   class FromKindBits: public BitField<ElementsKind, 8, 8> {};
   class ToKindBits: public BitField<ElementsKind, 0, 8> {};
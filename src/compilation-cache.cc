@@ -134,7 +134,10 @@ CompilationCacheScript::CompilationCacheScript(Isolate* isolate,
                                                int generations)
     : CompilationSubCache(isolate, generations),
       script_histogram_(NULL),
-      script_histogram_initialized_(false) { }
+      script_histogram_initialized_(false),
+      retained_(NULL),
+      retained_count_(0),
+      retained_bytes_(0) { }
 
 
 // We only re-use a cached function for some script source code if the
@@ -200,6 +203,10 @@ Handle<SharedFunctionInfo> CompilationCacheScript::Lookup(
         }
       }
     }
+    if (result == NULL) {
+      result = LookupRetained(source, name, line_offset, column_offset,
+                              is_shared_cross_origin);
+    }
   }
 
   if (!script_histogram_initialized_) {
@@ -229,16 +236,55 @@ Handle<SharedFunctionInfo> CompilationCacheScript::Lookup(
                      is_shared_cross_origin));
     // If the script was found in a later generation, we promote it to
     // the first generation to let it survive longer in the cache.
-    if (generation != 0) Put(source, context, shared);
+    if (generation != 0) {
+      Put(source, context, shared);
+    } else {
+      Retain(source, shared);
+    }
     isolate()->counters()->compilation_cache_hits()->Increment();
+    isolate()->counters()->script_cache_hits()->Increment();
+    if (generation == generations()) {
+      isolate()->counters()->script_cache_retained_hits()->Increment();
+    }
     return shared;
   } else {
     isolate()->counters()->compilation_cache_misses()->Increment();
+    isolate()->counters()->script_cache_misses()->Increment();
     return Handle<SharedFunctionInfo>::null();
   }
 }
 
 
+static int SourceBytes(String* source) {
+  return source->IsOneByteRepresentation()
+      ? source->length()
+      : source->length() * kUC16Size;
+}
+
+
+SharedFunctionInfo* CompilationCacheScript::LookupRetained(
+    Handle<String> source,
+    Handle<Object> name,
+    int line_offset,
+    int column_offset,
+    bool is_shared_cross_origin) {
+  if (!retained_->IsFixedArray()) return NULL;
+  Handle<FixedArray> retained(FixedArray::cast(retained_), isolate());
+  uint32_t hash = source->Hash();
+  for (int i = retained_count_ - 1; i >= 0; i--) {
+    String* candidate = String::cast(retained->get(i * 2));
+    if (candidate->Hash() != hash || !candidate->Equals(*source)) continue;
+    Handle<SharedFunctionInfo> function_info(
+        SharedFunctionInfo::cast(retained->get(i * 2 + 1)), isolate());
+    if (HasOrigin(function_info, name, line_offset, column_offset,
+                  is_shared_cross_origin)) {
+      return *function_info;
+    }
+  }
+  return NULL;
+}
+
+
 MaybeObject* CompilationCacheScript::TryTablePut(
     Handle<String> source,
     Handle<Context> context,
@@ -263,6 +309,99 @@ void CompilationCacheScript::Put(Handle<String> source,
                                  Handle<SharedFunctionInfo> function_info) {
   HandleScope scope(isolate());
   SetFirstTable(TablePut(source, context, function_info));
+  Retain(source, function_info);
+}
+
+
+void CompilationCacheScript::Retain(Handle<String> source,
+                                    Handle<SharedFunctionInfo> function_info) {
+  int budget = FLAG_script_cache_budget * KB;
+  int bytes = SourceBytes(*source);
+  if (bytes > budget) return;
+  HandleScope scope(isolate());
+  if (!retained_->IsFixedArray()) {
+    retained_ = *isolate()->factory()->NewFixedArray(8, TENURED);
+    retained_count_ = 0;
+    retained_bytes_ = 0;
+  }
+
+  int index = retained_count_ - 1;
+  while (index >= 0 &&
+         FixedArray::cast(retained_)->get(index * 2 + 1) != *function_info) {
+    index--;
+  }
+  if (index < 0) {
+    while (retained_bytes_ + bytes > budget) {
+      RemoveRetainedEntry(0);
+      isolate()->counters()->script_cache_evictions()->Increment();
+    }
+    Handle<FixedArray> retained(FixedArray::cast(retained_), isolate());
+    if (retained_count_ * 2 == retained->length()) {
+      retained = isolate()->factory()->CopySizeFixedArray(
+          retained, retained->length() * 2, TENURED);
+      retained_ = *retained;
+    }
+    index = retained_count_++;
+    retained_bytes_ += bytes;
+  }
+  // Move the entry to the most recently used end.
+  FixedArray* retained = FixedArray::cast(retained_);
+  for (int i = index; i < retained_count_ - 1; i++) {
+    retained->set(i * 2, retained->get(i * 2 + 2));
+    retained->set(i * 2 + 1, retained->get(i * 2 + 3));
+  }
+  retained->set(retained_count_ * 2 - 2, *source);
+  retained->set(retained_count_ * 2 - 1, *function_info);
+}
+
+
+void CompilationCacheScript::RemoveRetainedEntry(int index) {
+  ASSERT(index < retained_count_);
+  FixedArray* retained = FixedArray::cast(retained_);
+  retained_bytes_ -= SourceBytes(String::cast(retained->get(index * 2)));
+  for (int i = index; i < retained_count_ - 1; i++) {
+    retained->set(i * 2, retained->get(i * 2 + 2));
+    retained->set(i * 2 + 1, retained->get(i * 2 + 3));
+  }
+  retained_count_--;
+  Object* undefined = isolate()->heap()->undefined_value();
+  retained->set(retained_count_ * 2, undefined);
+  retained->set(retained_count_ * 2 + 1, undefined);
+}
+
+
+void CompilationCacheScript::Remove(Handle<SharedFunctionInfo> function_info) {
+  CompilationSubCache::Remove(function_info);
+  if (!retained_->IsFixedArray()) return;
+  for (int i = retained_count_ - 1; i >= 0; i--) {
+    if (FixedArray::cast(retained_)->get(i * 2 + 1) == *function_info) {
+      RemoveRetainedEntry(i);
+    }
+  }
+}
+
+
+void CompilationCacheScript::Iterate(ObjectVisitor* v) {
+  CompilationSubCache::Iterate(v);
+  v->VisitPointer(&retained_);
+}
+
+
+void CompilationCacheScript::IterateFunctions(ObjectVisitor* v) {
+  CompilationSubCache::IterateFunctions(v);
+  if (!retained_->IsFixedArray()) return;
+  FixedArray* retained = FixedArray::cast(retained_);
+  for (int i = 0; i < retained_count_; i++) {
+    v->VisitPointer(retained->data_start() + i * 2 + 1);
+  }
+}
+
+
+void CompilationCacheScript::Clear() {
+  CompilationSubCache::Clear();
+  retained_ = isolate()->heap()->undefined_value();
+  retained_count_ = 0;
+  retained_bytes_ = 0;
 }
 
 
@@ -285,22 +424,64 @@ Handle<SharedFunctionInfo> CompilationCacheEval::Lookup(
         break;
       }
     }
+    if (!result->IsSharedFunctionInfo()) {
+      SharedFunctionInfo* retained =
+          LookupRetained(source, context, language_mode, scope_position);
+      if (retained != NULL) result = retained;
+    }
   }
+  bool global = context->IsNativeContext();
   if (result->IsSharedFunctionInfo()) {
     Handle<SharedFunctionInfo>
         function_info(SharedFunctionInfo::cast(result), isolate());
     if (generation != 0) {
       Put(source, context, function_info, scope_position);
+    } else {
+      Retain(source, context, language_mode, scope_position, function_info);
     }
     isolate()->counters()->compilation_cache_hits()->Increment();
+    if (global) {
+      isolate()->counters()->eval_cache_hits()->Increment();
+      if (generation == generations()) {
+        isolate()->counters()->eval_cache_retained_hits()->Increment();
+      }
+    }
     return function_info;
   } else {
     isolate()->counters()->compilation_cache_misses()->Increment();
+    if (global) isolate()->counters()->eval_cache_misses()->Increment();
     return Handle<SharedFunctionInfo>::null();
   }
 }
 
 
+SharedFunctionInfo* CompilationCacheEval::LookupRetained(
+    Handle<String> source,
+    Handle<Context> context,
+    LanguageMode language_mode,
+    int scope_position) {
+  if (!retained_->IsFixedArray()) return NULL;
+  FixedArray* retained = FixedArray::cast(retained_);
+  Object* outer_info = context->closure()->shared();
+  uint32_t hash = source->Hash();
+  for (int i = retained_count_ - 1; i >= 0; i--) {
+    int entry = i * kRetainedEntrySize;
+    if (retained->get(entry + kRetainedOuterInfoIndex) != outer_info ||
+        retained->get(entry + kRetainedLanguageModeIndex) !=
+            Smi::FromInt(language_mode) ||
+        retained->get(entry + kRetainedScopePositionIndex) !=
+            Smi::FromInt(scope_position)) {
+      continue;
+    }
+    String* candidate = String::cast(retained->get(entry));
+    if (candidate->Hash() != hash || !candidate->Equals(*source)) continue;
+    return SharedFunctionInfo::cast(
+        retained->get(entry + kRetainedFunctionInfoIndex));
+  }
+  return NULL;
+}
+
+
 MaybeObject* CompilationCacheEval::TryTablePut(
     Handle<String> source,
     Handle<Context> context,
@@ -329,6 +510,122 @@ void CompilationCacheEval::Put(Handle<String> source,
                                int scope_position) {
   HandleScope scope(isolate());
   SetFirstTable(TablePut(source, context, function_info, scope_position));
+  // Like the tables, key the retained entry on the language mode of the
+  // compiled code.
+  Retain(source, context, function_info->language_mode(), scope_position,
+         function_info);
+}
+
+
+void CompilationCacheEval::Retain(Handle<String> source,
+                                  Handle<Context> context,
+                                  LanguageMode language_mode,
+                                  int scope_position,
+                                  Handle<SharedFunctionInfo> function_info) {
+  if (!context->IsNativeContext()) return;
+  int budget = FLAG_eval_cache_budget * KB;
+  int bytes = SourceBytes(*source);
+  if (bytes > budget) return;
+  HandleScope scope(isolate());
+  if (!retained_->IsFixedArray()) {
+    retained_ = *isolate()->factory()->NewFixedArray(
+        8 * kRetainedEntrySize, TENURED);
+    retained_count_ = 0;
+    retained_bytes_ = 0;
+  }
+
+  int index = retained_count_ - 1;
+  while (index >= 0 &&
+         FixedArray::cast(retained_)->get(
+             index * kRetainedEntrySize + kRetainedFunctionInfoIndex) !=
+             *function_info) {
+    index--;
+  }
+  if (index < 0) {
+    while (retained_bytes_ + bytes > budget) {
+      RemoveRetainedEntry(0);
+      isolate()->counters()->eval_cache_evictions()->Increment();
+    }
+    Handle<FixedArray> retained(FixedArray::cast(retained_), isolate());
+    if (retained_count_ * kRetainedEntrySize == retained->length()) {
+      retained = isolate()->factory()->CopySizeFixedArray(
+          retained, retained->length() * 2, TENURED);
+      retained_ = *retained;
+    }
+    index = retained_count_++;
+    retained_bytes_ += bytes;
+  }
+  // Move the entry to the most recently used end.
+  FixedArray* retained = FixedArray::cast(retained_);
+  for (int i = index * kRetainedEntrySize;
+       i < (retained_count_ - 1) * kRetainedEntrySize;
+       i++) {
+    retained->set(i, retained->get(i + kRetainedEntrySize));
+  }
+  int entry = (retained_count_ - 1) * kRetainedEntrySize;
+  retained->set(entry + kRetainedSourceIndex, *source);
+  retained->set(entry + kRetainedOuterInfoIndex, context->closure()->shared());
+  retained->set(entry + kRetainedLanguageModeIndex,
+                Smi::FromInt(language_mode));
+  retained->set(entry + kRetainedScopePositionIndex,
+                Smi::FromInt(scope_position));
+  retained->set(entry + kRetainedFunctionInfoIndex, *function_info);
+}
+
+
+void CompilationCacheEval::RemoveRetainedEntry(int index) {
+  ASSERT(index < retained_count_);
+  FixedArray* retained = FixedArray::cast(retained_);
+  retained_bytes_ -= SourceBytes(
+      String::cast(retained->get(index * kRetainedEntrySize)));
+  for (int i = index * kRetainedEntrySize;
+       i < (retained_count_ - 1) * kRetainedEntrySize;
+       i++) {
+    retained->set(i, retained->get(i + kRetainedEntrySize));
+  }
+  retained_count_--;
+  Object* undefined = isolate()->heap()->undefined_value();
+  for (int i = 0; i < kRetainedEntrySize; i++) {
+    retained->set(retained_count_ * kRetainedEntrySize + i, undefined);
+  }
+}
+
+
+void CompilationCacheEval::Remove(Handle<SharedFunctionInfo> function_info) {
+  CompilationSubCache::Remove(function_info);
+  if (!retained_->IsFixedArray()) return;
+  for (int i = retained_count_ - 1; i >= 0; i--) {
+    if (FixedArray::cast(retained_)->get(
+            i * kRetainedEntrySize + kRetainedFunctionInfoIndex) ==
+        *function_info) {
+      RemoveRetainedEntry(i);
+    }
+  }
+}
+
+
+void CompilationCacheEval::Iterate(ObjectVisitor* v) {
+  CompilationSubCache::Iterate(v);
+  v->VisitPointer(&retained_);
+}
+
+
+void CompilationCacheEval::IterateFunctions(ObjectVisitor* v) {
+  CompilationSubCache::IterateFunctions(v);
+  if (!retained_->IsFixedArray()) return;
+  FixedArray* retained = FixedArray::cast(retained_);
+  for (int i = 0; i < retained_count_; i++) {
+    v->VisitPointer(retained->data_start() + i * kRetainedEntrySize +
+                    kRetainedFunctionInfoIndex);
+  }
+}
+
+
+void CompilationCacheEval::Clear() {
+  CompilationSubCache::Clear();
+  retained_ = isolate()->heap()->undefined_value();
+  retained_count_ = 0;
+  retained_bytes_ = 0;
 }
 
 
@@ -347,16 +644,27 @@ Handle<FixedArray> CompilationCacheRegExp::Lookup(Handle<String> source,
         break;
       }
     }
+    if (!result->IsFixedArray() && retained_table_->IsCompilationCacheTable()) {
+      result = CompilationCacheTable::cast(retained_table_)->LookupRegExp(
+          *source, flags);
+    }
   }
   if (result->IsFixedArray()) {
     Handle<FixedArray> data(FixedArray::cast(result), isolate());
     if (generation != 0) {
       Put(source, flags, data);
+    } else {
+      Retain(source, flags, data);
     }
     isolate()->counters()->compilation_cache_hits()->Increment();
+    isolate()->counters()->regexp_cache_hits()->Increment();
+    if (generation == generations()) {
+      isolate()->counters()->regexp_cache_retained_hits()->Increment();
+    }
     return data;
   } else {
     isolate()->counters()->compilation_cache_misses()->Increment();
+    isolate()->counters()->regexp_cache_misses()->Increment();
     return Handle<FixedArray>::null();
   }
 }
@@ -386,6 +694,92 @@ void CompilationCacheRegExp::Put(Handle<String> source,
                                  Handle<FixedArray> data) {
   HandleScope scope(isolate());
   SetFirstTable(TablePut(source, flags, data));
+  Retain(source, flags, data);
+}
+
+
+static Handle<CompilationCacheTable> PutRegExpInTable(
+    Handle<CompilationCacheTable> table,
+    Handle<String> source,
+    JSRegExp::Flags flags,
+    Handle<FixedArray> data) {
+  CALL_HEAP_FUNCTION(table->GetIsolate(),
+                     table->PutRegExp(*source, flags, *data),
+                     CompilationCacheTable);
+}
+
+
+void CompilationCacheRegExp::Retain(Handle<String> source,
+                                    JSRegExp::Flags flags,
+                                    Handle<FixedArray> data) {
+  if (FLAG_regexp_cache_size <= 0) return;
+  HandleScope scope(isolate());
+  if (!retained_->IsFixedArray()) {
+    retained_ = *isolate()->factory()->NewFixedArray(FLAG_regexp_cache_size,
+                                                     TENURED);
+    retained_table_ = *AllocateTable(isolate(), kInitialCacheSize);
+    retained_count_ = 0;
+  }
+  Handle<FixedArray> retained(FixedArray::cast(retained_), isolate());
+
+  int index = retained_count_ - 1;
+  while (index >= 0 && retained->get(index) != *data) index--;
+  if (index < 0) {
+    Handle<CompilationCacheTable> table(
+        CompilationCacheTable::cast(retained_table_), isolate());
+    if (retained_count_ == retained->length()) {
+      table->Remove(retained->get(0));
+      index = 0;
+    } else {
+      index = retained_count_++;
+    }
+    retained_table_ = *PutRegExpInTable(table, source, flags, data);
+  }
+  // Move the entry to the most recently used end.
+  for (int i = index; i < retained_count_ - 1; i++) {
+    retained->set(i, retained->get(i + 1));
+  }
+  retained->set(retained_count_ - 1, *data);
+}
+
+
+void CompilationCacheRegExp::Age() {
+  CompilationSubCache::Age();
+  if (!retained_->IsFixedArray()) return;
+  // The marker ages and eventually flushes the irregexp code of every
+  // regexp it visits.  Reinstating the saved code of the retained entries
+  // before each collection keeps their code alive.
+  FixedArray* retained = FixedArray::cast(retained_);
+  for (int i = 0; i < retained_count_; i++) {
+    FixedArray* data = FixedArray::cast(retained->get(i));
+    if (Smi::cast(data->get(JSRegExp::kTagIndex))->value() !=
+        JSRegExp::IRREGEXP) {
+      continue;
+    }
+    for (int j = 0; j < 2; j++) {
+      bool is_ascii = j == 0;
+      Object* saved = data->get(JSRegExp::saved_code_index(is_ascii));
+      if (data->get(JSRegExp::code_index(is_ascii))->IsSmi() &&
+          saved->IsCode()) {
+        data->set(JSRegExp::code_index(is_ascii), saved);
+      }
+    }
+  }
+}
+
+
+void CompilationCacheRegExp::Iterate(ObjectVisitor* v) {
+  CompilationSubCache::Iterate(v);
+  v->VisitPointer(&retained_table_);
+  v->VisitPointer(&retained_);
+}
+
+
+void CompilationCacheRegExp::Clear() {
+  CompilationSubCache::Clear();
+  retained_table_ = isolate()->heap()->undefined_value();
+  retained_ = isolate()->heap()->undefined_value();
+  retained_count_ = 0;
 }
 
 
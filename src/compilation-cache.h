@@ -44,7 +44,7 @@ class CompilationSubCache {
     tables_ = NewArray<Object*>(generations);
   }
 
-  ~CompilationSubCache() { DeleteArray(tables_); }
+  virtual ~CompilationSubCache() { DeleteArray(tables_); }
 
   // Index for the first generation in the cache.
   static const int kFirstGeneration = 0;
@@ -63,14 +63,14 @@ class CompilationSubCache {
 
   // Age the sub-cache by evicting the oldest generation and creating a new
   // young generation.
-  void Age();
+  virtual void Age();
 
   // GC support.
-  void Iterate(ObjectVisitor* v);
-  void IterateFunctions(ObjectVisitor* v);
+  virtual void Iterate(ObjectVisitor* v);
+  virtual void IterateFunctions(ObjectVisitor* v);
 
   // Clear this sub-cache evicting all its content.
-  void Clear();
+  virtual void Clear();
 
   // Remove given shared function info from sub-cache.
   void Remove(Handle<SharedFunctionInfo> function_info);
@@ -105,7 +105,31 @@ class CompilationCacheScript : public CompilationSubCache {
            Handle<Context> context,
            Handle<SharedFunctionInfo> function_info);
 
+  virtual void Iterate(ObjectVisitor* v);
+  virtual void IterateFunctions(ObjectVisitor* v);
+  virtual void Clear();
+
+  // Remove given shared function info from the generations and the
+  // retained entries.
+  void Remove(Handle<SharedFunctionInfo> function_info);
+
  private:
+  // Marks the entry as the most recently used retained entry, evicting
+  // least recently used ones until the retained sources fit in
+  // --script-cache-budget. Retained entries survive aging and are matched
+  // on source content and origin only, so they are shared by all contexts.
+  void Retain(Handle<String> source,
+              Handle<SharedFunctionInfo> function_info);
+
+  // Returns the retained entry for the source and origin, or NULL.
+  SharedFunctionInfo* LookupRetained(Handle<String> source,
+                                     Handle<Object> name,
+                                     int line_offset,
+                                     int column_offset,
+                                     bool is_shared_cross_origin);
+
+  void RemoveRetainedEntry(int index);
+
   MUST_USE_RESULT MaybeObject* TryTablePut(
       Handle<String> source,
       Handle<Context> context,
@@ -126,6 +150,13 @@ class CompilationCacheScript : public CompilationSubCache {
   void* script_histogram_;
   bool script_histogram_initialized_;
 
+  // Pairs of source and shared function info, least recently used first,
+  // or undefined.
+  Object* retained_;
+  int retained_count_;
+  // Total size of the retained sources in bytes.
+  int retained_bytes_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationCacheScript);
 };
 
@@ -146,7 +177,10 @@ class CompilationCacheScript : public CompilationSubCache {
 class CompilationCacheEval: public CompilationSubCache {
  public:
   CompilationCacheEval(Isolate* isolate, int generations)
-      : CompilationSubCache(isolate, generations) { }
+      : CompilationSubCache(isolate, generations),
+        retained_(NULL),
+        retained_count_(0),
+        retained_bytes_(0) { }
 
   Handle<SharedFunctionInfo> Lookup(Handle<String> source,
                                     Handle<Context> context,
@@ -158,7 +192,42 @@ class CompilationCacheEval: public CompilationSubCache {
            Handle<SharedFunctionInfo> function_info,
            int scope_position);
 
+  virtual void Iterate(ObjectVisitor* v);
+  virtual void IterateFunctions(ObjectVisitor* v);
+  virtual void Clear();
+
+  // Remove given shared function info from the generations and the
+  // retained entries.
+  void Remove(Handle<SharedFunctionInfo> function_info);
+
  private:
+  // Layout of a retained entry.
+  static const int kRetainedSourceIndex = 0;
+  static const int kRetainedOuterInfoIndex = 1;
+  static const int kRetainedLanguageModeIndex = 2;
+  static const int kRetainedScopePositionIndex = 3;
+  static const int kRetainedFunctionInfoIndex = 4;
+  static const int kRetainedEntrySize = 5;
+
+  // Marks the entry as the most recently used retained entry, evicting
+  // least recently used ones until the retained sources fit in
+  // --eval-cache-budget. Only code compiled in a native context, that is
+  // global eval and the Function constructor, is retained. Retained
+  // entries survive aging and are matched on the same key as the tables.
+  void Retain(Handle<String> source,
+              Handle<Context> context,
+              LanguageMode language_mode,
+              int scope_position,
+              Handle<SharedFunctionInfo> function_info);
+
+  // Returns the retained entry for the key, or NULL.
+  SharedFunctionInfo* LookupRetained(Handle<String> source,
+                                     Handle<Context> context,
+                                     LanguageMode language_mode,
+                                     int scope_position);
+
+  void RemoveRetainedEntry(int index);
+
   MUST_USE_RESULT MaybeObject* TryTablePut(
       Handle<String> source,
       Handle<Context> context,
@@ -172,22 +241,47 @@ class CompilationCacheEval: public CompilationSubCache {
       Handle<SharedFunctionInfo> function_info,
       int scope_position);
 
+  // Entries of kRetainedEntrySize elements, least recently used first, or
+  // undefined.
+  Object* retained_;
+  int retained_count_;
+  // Total size of the retained sources in bytes.
+  int retained_bytes_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationCacheEval);
 };
 
 
-// Sub-cache for regular expressions.
+// Sub-cache for regular expression data.  Besides the aged generations, up
+// to --regexp-cache-size of the most recently used regexps are retained
+// across garbage collections, and their irregexp code is kept from being
+// flushed.  Regexp data does not depend on the context, so all contexts of
+// an isolate share the cache.
 class CompilationCacheRegExp: public CompilationSubCache {
  public:
   CompilationCacheRegExp(Isolate* isolate, int generations)
-      : CompilationSubCache(isolate, generations) { }
+      : CompilationSubCache(isolate, generations),
+        retained_table_(NULL),
+        retained_(NULL),
+        retained_count_(0) { }
 
   Handle<FixedArray> Lookup(Handle<String> source, JSRegExp::Flags flags);
 
   void Put(Handle<String> source,
            JSRegExp::Flags flags,
            Handle<FixedArray> data);
+
+  virtual void Age();
+  virtual void Iterate(ObjectVisitor* v);
+  virtual void Clear();
+
  private:
+  // Marks data as the most recently used retained entry, evicting the least
+  // recently used one if the retained set is full.
+  void Retain(Handle<String> source,
+              JSRegExp::Flags flags,
+              Handle<FixedArray> data);
+
   MUST_USE_RESULT MaybeObject* TryTablePut(Handle<String> source,
                                       JSRegExp::Flags flags,
                                       Handle<FixedArray> data);
@@ -197,6 +291,12 @@ class CompilationCacheRegExp: public CompilationSubCache {
                                          JSRegExp::Flags flags,
                                          Handle<FixedArray> data);
 
+  // Lookup table for the retained entries, or undefined.
+  Object* retained_table_;
+  // The retained data arrays, least recently used first, or undefined.
+  Object* retained_;
+  int retained_count_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(CompilationCacheRegExp);
 };
 
@@ -48,6 +48,7 @@
 #include "scanner-character-streams.h"
 #include "scopeinfo.h"
 #include "scopes.h"
+#include "serialize.h"
 #include "vm-state-inl.h"
 
 namespace v8 {
@@ -319,11 +320,12 @@ class HOptimizedGraphBuilderWithPositions: public HOptimizedGraphBuilder {
 // crankshaft adaptive compiler debugging the optimized code is not possible at
 // all. However crankshaft support recompilation of functions, so in this case
 // the full compiler need not be be used if a debugger is attached, but only if
-// break points has actually been set.
-static bool IsDebuggerActive(Isolate* isolate) {
+// break points has actually been set, and unless all functions have been
+// deoptimized for the debugger, only in functions containing break points.
+static bool IsDebuggerActive(Isolate* isolate, SharedFunctionInfo* shared) {
 #ifdef ENABLE_DEBUGGER_SUPPORT
   return isolate->use_crankshaft() ?
-    isolate->debug()->has_break_points() :
+    isolate->debug()->PreventsOptimization(shared) :
     isolate->debugger()->IsDebuggerActive();
 #else
   return false;
@@ -348,7 +350,9 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
   // to use the Hydrogen-based optimizing compiler. We already have
   // generated code for this from the shared function object.
   if (FLAG_always_full_compiler) return AbortOptimization();
-  if (IsDebuggerActive(isolate())) return AbortOptimization(kDebuggerIsActive);
+  if (IsDebuggerActive(isolate(), *info()->shared_info())) {
+    return AbortOptimization(kDebuggerIsActive);
+  }
 
   // Limit the number of times we re-compile a functions with
   // the optimizing compiler.
@@ -403,6 +407,8 @@ OptimizedCompileJob::Status OptimizedCompileJob::CreateGraph() {
     if (should_recompile) {
       if (!succeeded) return SetLastStatus(FAILED);
       Handle<SharedFunctionInfo> shared = info()->shared_info();
+      // Keep measuring tier-up latency from the original unoptimized code.
+      unoptimized.code()->set_creation_time(shared->code()->creation_time());
       shared->EnableDeoptimizationSupport(*unoptimized.code());
       // The existing unoptimized code was replaced with the new one.
       Compiler::RecordFunctionCompilation(
@@ -520,6 +526,11 @@ void OptimizedCompileJob::RecordOptimizationStats() {
     // Concurrent recompilation and OSR may race.  Increment only once.
     int opt_count = function->shared()->opt_count();
     function->shared()->set_opt_count(opt_count + 1);
+    if (opt_count == 0) {
+      int created = function->shared()->code()->creation_time();
+      int now = static_cast<int>(isolate()->time_millis_since_init());
+      isolate()->counters()->time_to_optimization()->AddSample(now - created);
+    }
   }
   double ms_creategraph = time_taken_to_create_graph_.InMillisecondsF();
   double ms_optimize = time_taken_to_optimize_.InMillisecondsF();
@@ -607,6 +618,16 @@ static void UpdateSharedFunctionInfo(CompilationInfo* info) {
   shared->set_dont_inline(lit->flags()->Contains(kDontInline));
   shared->set_ast_node_count(lit->ast_node_count());
   shared->set_language_mode(lit->language_mode());
+
+  // A strict mode function without an arguments object and without eval
+  // cannot tell how many arguments were actually passed to it.
+  Scope* scope = info->scope();
+  shared->set_dont_need_arguments_adaptation(
+      !lit->is_generator() &&
+      !shared->native() &&
+      !scope->is_classic_mode() &&
+      scope->arguments() == NULL &&
+      !scope->calls_eval());
 }
 
 
@@ -670,6 +691,13 @@ static Handle<Code> GetUnoptimizedCodeCommon(CompilationInfo* info) {
       Logger::LAZY_COMPILE_TAG, info, info->shared_info());
   UpdateSharedFunctionInfo(info);
   ASSERT_EQ(Code::FUNCTION, info->code()->kind());
+  if (info->shared_info()->flush_count() > 0) {
+    // The function was compiled before and its code was flushed.
+    Counters* counters = info->isolate()->counters();
+    counters->code_flushing_functions_recompiled()->Increment();
+    counters->code_flushing_bytes_recompiled()->Increment(
+        info->code()->Size());
+  }
   return info->code();
 }
 
@@ -689,7 +717,7 @@ Handle<Code> Compiler::GetUnoptimizedCode(Handle<JSFunction> function) {
       !result.is_null() &&
       info.isolate()->use_crankshaft() &&
       !info.shared_info()->optimization_disabled() &&
-      !info.isolate()->DebuggerHasBreakPoints()) {
+      !info.isolate()->DebuggerPreventsOptimization(*info.shared_info())) {
     Handle<Code> opt_code = Compiler::GetOptimizedCode(
         function, result, Compiler::NOT_CONCURRENT);
     if (!opt_code.is_null()) result = opt_code;
@@ -945,15 +973,51 @@ Handle<JSFunction> Compiler::GetFunctionFromEval(Handle<String> source,
 }
 
 
-Handle<SharedFunctionInfo> Compiler::CompileScript(Handle<String> source,
-                                                   Handle<Object> script_name,
-                                                   int line_offset,
-                                                   int column_offset,
-                                                   bool is_shared_cross_origin,
-                                                   Handle<Context> context,
-                                                   v8::Extension* extension,
-                                                   ScriptDataImpl* pre_data,
-                                                   NativesFlag natives) {
+static Handle<SharedFunctionInfo> DeserializeToplevel(Isolate* isolate,
+                                                      Handle<Script> script,
+                                                      ScriptDataImpl* data) {
+  Handle<SharedFunctionInfo> result =
+      CodeSerializer::Deserialize(isolate, data, script);
+  if (result.is_null()) return result;
+
+  FixedArray* array = isolate->native_context()->embedder_data();
+  script->set_context_data(array->get(0));
+  script->set_compilation_state(Script::COMPILATION_STATE_COMPILED);
+
+  Handle<String> script_name = script->name()->IsString()
+      ? Handle<String>(String::cast(script->name()))
+      : isolate->factory()->empty_string();
+  PROFILE(isolate, CodeCreateEvent(
+              Logger::ToNativeByScript(Logger::SCRIPT_TAG, *script),
+              result->code(), *result, NULL, *script_name));
+
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  isolate->debugger()->OnAfterCompile(script, Debugger::NO_AFTER_COMPILE_FLAGS);
+#endif
+
+  return result;
+}
+
+
+Handle<SharedFunctionInfo> Compiler::CompileScript(
+    Handle<String> source,
+    Handle<Object> script_name,
+    int line_offset,
+    int column_offset,
+    bool is_shared_cross_origin,
+    Handle<Context> context,
+    v8::Extension* extension,
+    ScriptDataImpl** cached_data,
+    CachedDataMode cached_data_mode,
+    NativesFlag natives) {
+  if (cached_data_mode == NO_CACHED_DATA) {
+    cached_data = NULL;
+  } else if (cached_data_mode == PRODUCE_CACHED_DATA) {
+    ASSERT(cached_data != NULL && *cached_data == NULL);
+  } else {
+    ASSERT(cached_data_mode == CONSUME_CACHED_DATA);
+    ASSERT(cached_data != NULL && *cached_data != NULL);
+  }
   Isolate* isolate = source->GetIsolate();
   int source_length = source->length();
   isolate->counters()->total_load_size()->Increment(source_length);
@@ -961,9 +1025,11 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(Handle<String> source,
 
   CompilationCache* compilation_cache = isolate->compilation_cache();
 
-  // Do a lookup in the compilation cache but not for extensions.
+  // Do a lookup in the compilation cache but not for extensions.  When
+  // producing a code cache we need freshly compiled code, since cached code
+  // may already have been run and have context-specific ICs.
   Handle<SharedFunctionInfo> result;
-  if (extension == NULL) {
+  if (extension == NULL && cached_data_mode != PRODUCE_CACHED_DATA) {
     result = compilation_cache->LookupScript(source,
                                              script_name,
                                              line_offset,
@@ -994,16 +1060,35 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(Handle<String> source,
     }
     script->set_is_shared_cross_origin(is_shared_cross_origin);
 
-    // Compile the function and add it to the cache.
-    CompilationInfoWithZone info(script);
-    info.MarkAsGlobal();
-    info.SetExtension(extension);
-    info.SetPreParseData(pre_data);
-    info.SetContext(context);
-    if (FLAG_use_strict) {
-      info.SetLanguageMode(FLAG_harmony_scoping ? EXTENDED_MODE : STRICT_MODE);
+    ScriptDataImpl* pre_data = NULL;
+    if (cached_data_mode == CONSUME_CACHED_DATA) {
+      if (!CodeSerializer::IsCodeCache(*cached_data)) {
+        pre_data = *cached_data;
+      } else if (extension == NULL &&
+                 !LiveEditFunctionTracker::IsActive(isolate) &&
+                 !isolate->DebuggerHasBreakPoints()) {
+        // A code cache that does not fit this script or this build is
+        // silently ignored and we fall back to a regular compile.
+        result = DeserializeToplevel(isolate, script, *cached_data);
+      }
+    }
+
+    if (result.is_null()) {
+      // Compile the function and add it to the cache.
+      CompilationInfoWithZone info(script);
+      info.MarkAsGlobal();
+      info.SetExtension(extension);
+      info.SetPreParseData(pre_data);
+      info.SetContext(context);
+      if (FLAG_use_strict) {
+        info.SetLanguageMode(
+            FLAG_harmony_scoping ? EXTENDED_MODE : STRICT_MODE);
+      }
+      result = CompileToplevel(&info);
+      if (cached_data_mode == PRODUCE_CACHED_DATA && !result.is_null()) {
+        *cached_data = CodeSerializer::Serialize(result);
+      }
     }
-    result = CompileToplevel(&info);
     if (extension == NULL && !result.is_null() && !result->dont_cache()) {
       compilation_cache->PutScript(source, context, result);
     }
@@ -1036,9 +1121,14 @@ Handle<SharedFunctionInfo> Compiler::BuildFunctionInfo(FunctionLiteral* literal,
   // aggressive about lazy compilation, because it might trigger compilation
   // of functions without an outer context when setting a breakpoint through
   // Debug::FindSharedFunctionInfoInScript.
+  // A function whose body has been skipped by the parser (see
+  // --lazy-inner-functions) has no AST to compile and must stay lazy.
   bool allow_lazy_without_ctx = literal->AllowsLazyCompilationWithoutContext();
+  bool body_skipped = literal->body() == NULL;
+  ASSERT(!body_skipped || literal->AllowsLazyCompilation());
   bool allow_lazy = literal->AllowsLazyCompilation() &&
-      !DebuggerWantsEagerCompilation(&info, allow_lazy_without_ctx);
+      (body_skipped ||
+       !DebuggerWantsEagerCompilation(&info, allow_lazy_without_ctx));
 
   // Generate code
   Handle<ScopeInfo> scope_info;
@@ -1065,6 +1155,11 @@ Handle<SharedFunctionInfo> Compiler::BuildFunctionInfo(FunctionLiteral* literal,
   RecordFunctionCompilation(Logger::FUNCTION_TAG, &info, result);
   result->set_allows_lazy_compilation(allow_lazy);
   result->set_allows_lazy_compilation_without_context(allow_lazy_without_ctx);
+  if (FLAG_lazy_inner_functions && !result->is_compiled() &&
+      !info.is_native() && !literal->scope()->inside_with() &&
+      !DebuggerWantsEagerCompilation(&info)) {
+    result->set_lazy_inner_functions(true);
+  }
 
   // Set the expected number of properties for instances and return
   // the resulting function.
@@ -1248,7 +1343,7 @@ Handle<Code> Compiler::GetConcurrentlyOptimizedCode(OptimizedCompileJob* job) {
   if (job->last_status() != OptimizedCompileJob::SUCCEEDED ||
       shared->optimization_disabled() ||
       info->HasAbortedDueToDependencyChange() ||
-      isolate->DebuggerHasBreakPoints()) {
+      isolate->DebuggerPreventsOptimization(*shared)) {
     return Handle<Code>::null();
   }
 
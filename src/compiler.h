@@ -45,6 +45,15 @@ enum ParseRestriction {
   ONLY_SINGLE_FUNCTION_LITERAL  // Only a single FunctionLiteral expression.
 };
 
+// CachedDataMode is used to tell CompileScript what to do with the cached
+// data passed in.  Consumed data is either preparse data or a code cache
+// produced by the CodeSerializer.
+enum CachedDataMode {
+  NO_CACHED_DATA,
+  CONSUME_CACHED_DATA,
+  PRODUCE_CACHED_DATA
+};
+
 struct OffsetRange {
   OffsetRange(int from, int to) : from(from), to(to) {}
   int from;
@@ -563,6 +572,16 @@ class OptimizedCompileJob: public ZoneObject {
 
   bool IsWaitingForInstall() { return awaiting_install_; }
 
+  // Timestamps of the job's passage through the concurrent recompilation
+  // queues, for the optimization latency histograms.
+  void RecordQueued() { queued_ = TimeTicks::HighResolutionNow(); }
+  void RecordDequeued() { dequeued_ = TimeTicks::HighResolutionNow(); }
+  void RecordCompiled() { compiled_ = TimeTicks::HighResolutionNow(); }
+  TimeDelta time_in_queue() const { return dequeued_ - queued_; }
+  TimeDelta time_since_compiled() const {
+    return TimeTicks::HighResolutionNow() - compiled_;
+  }
+
  private:
   CompilationInfo* info_;
   HOptimizedGraphBuilder* graph_builder_;
@@ -571,6 +590,9 @@ class OptimizedCompileJob: public ZoneObject {
   TimeDelta time_taken_to_create_graph_;
   TimeDelta time_taken_to_optimize_;
   TimeDelta time_taken_to_codegen_;
+  TimeTicks queued_;
+  TimeTicks dequeued_;
+  TimeTicks compiled_;
   Status last_status_;
   bool awaiting_install_;
 
@@ -628,16 +650,20 @@ class Compiler : public AllStatic {
                                                 ParseRestriction restriction,
                                                 int scope_position);
 
-  // Compile a String source within a context.
-  static Handle<SharedFunctionInfo> CompileScript(Handle<String> source,
-                                                  Handle<Object> script_name,
-                                                  int line_offset,
-                                                  int column_offset,
-                                                  bool is_shared_cross_origin,
-                                                  Handle<Context> context,
-                                                  v8::Extension* extension,
-                                                  ScriptDataImpl* pre_data,
-                                                  NativesFlag is_natives_code);
+  // Compile a String source within a context.  When producing cached data,
+  // the compilation cache is bypassed and *cached_data receives a newly
+  // allocated code cache (or NULL if the code could not be serialized).
+  static Handle<SharedFunctionInfo> CompileScript(
+      Handle<String> source,
+      Handle<Object> script_name,
+      int line_offset,
+      int column_offset,
+      bool is_shared_cross_origin,
+      Handle<Context> context,
+      v8::Extension* extension,
+      ScriptDataImpl** cached_data,
+      CachedDataMode cached_data_mode,
+      NativesFlag is_natives_code);
 
   // Create a shared function info object (the code may be lazily compiled).
   static Handle<SharedFunctionInfo> BuildFunctionInfo(FunctionLiteral* node,
@@ -78,12 +78,137 @@ double StringToDouble(UnicodeCache* unicode_cache,
 }
 
 
+// The digit parsing below reads eight characters at a time as a little
+// endian 64 bit word, with the first character in the least significant byte.
+static inline bool AreEightDigits(uint64_t chars) {
+  // Checks that the high nibbles are all 3 and that adding 6 to the low
+  // nibbles does not carry, i.e. that every byte is in the range '0'..'9'.
+  const uint64_t kHighNibbles = V8_2PART_UINT64_C(0xF0F0F0F0, F0F0F0F0);
+  const uint64_t kSixes = V8_2PART_UINT64_C(0x06060606, 06060606);
+  const uint64_t kThrees = V8_2PART_UINT64_C(0x33333333, 33333333);
+  return ((chars & kHighNibbles) |
+          (((chars + kSixes) & kHighNibbles) >> 4)) == kThrees;
+}
+
+
+static inline uint32_t ParseEightDigits(uint64_t chars) {
+  // Combine adjacent digits into pairs, pairs into quadruples, and the two
+  // quadruples into the final value.
+  const uint64_t kZeros = V8_2PART_UINT64_C(0x30303030, 30303030);
+  const uint64_t kByteMask = V8_2PART_UINT64_C(0x000000FF, 000000FF);
+  const uint64_t kMul1 = V8_2PART_UINT64_C(0x000F4240, 00000064);  // 10^6, 100
+  const uint64_t kMul2 = V8_2PART_UINT64_C(0x00002710, 00000001);  // 10^4, 1
+  chars -= kZeros;
+  chars = (chars * 10) + (chars >> 8);
+  return static_cast<uint32_t>(
+      (((chars & kByteMask) * kMul1) +
+       (((chars >> 16) & kByteMask) * kMul2)) >> 32);
+}
+
+
+// Accumulates the decimal digits at *current into *significand, and advances
+// *current past them. Returns false if there are more than 19 significant
+// digits in total.
+static inline bool ParseDecimalDigits(const uint8_t** current,
+                                      const uint8_t* end,
+                                      uint64_t* significand,
+                                      int* digits) {
+  const int kMaxDigits = 19;
+  const uint8_t* p = *current;
+  while (end - p >= 8 && *digits <= kMaxDigits - 8) {
+    uint64_t chars;
+    memcpy(&chars, p, sizeof(chars));
+    if (!AreEightDigits(chars)) break;
+    *significand = *significand * 100000000 + ParseEightDigits(chars);
+    *digits += 8;
+    p += 8;
+  }
+  while (p < end && IsDecimalDigit(*p)) {
+    if (*digits == kMaxDigits) return false;
+    *significand = *significand * 10 + (*p - '0');
+    (*digits)++;
+    p++;
+  }
+  *current = p;
+  return true;
+}
+
+
+bool FastStringToDouble(Vector<const uint8_t> str, double* result) {
+  STATIC_ASSERT(V8_TARGET_LITTLE_ENDIAN);
+  const uint8_t* p = str.start();
+  const uint8_t* end = p + str.length();
+  bool negative = p < end && *p == '-';
+  if (negative) p++;
+
+  uint64_t significand = 0;
+  int digits = 0;
+  int exponent = 0;
+  const uint8_t* integer_start = p;
+  // Leading zeros are not significant.
+  while (p < end && *p == '0') p++;
+  if (!ParseDecimalDigits(&p, end, &significand, &digits)) return false;
+  bool has_digits = p > integer_start;
+  if (p < end && *p == '.') {
+    p++;
+    const uint8_t* fraction_start = p;
+    if (significand == 0) {
+      while (p < end && *p == '0') p++;
+    }
+    if (!ParseDecimalDigits(&p, end, &significand, &digits)) return false;
+    exponent -= static_cast<int>(p - fraction_start);
+    has_digits |= p > fraction_start;
+  }
+  if (!has_digits) return false;
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    p++;
+    bool negative_exponent = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) p++;
+    if (p == end || !IsDecimalDigit(*p)) return false;
+    const int kMaxExponent = 100000;
+    int value = 0;
+    do {
+      if (value < kMaxExponent) value = value * 10 + (*p - '0');
+      p++;
+    } while (p < end && IsDecimalDigit(*p));
+    exponent += negative_exponent ? -value : value;
+  }
+  if (p != end) return false;
+
+  if (!FastStrtod(significand, exponent, result)) return false;
+  if (negative) *result = -*result;
+  return true;
+}
+
+
 const char* DoubleToCString(double v, Vector<char> buffer) {
   switch (fpclassify(v)) {
     case FP_NAN: return "NaN";
     case FP_INFINITE: return (v < 0.0 ? "-Infinity" : "Infinity");
     case FP_ZERO: return "0";
     default: {
+      // Integral values below 2^53 are exact and their shortest
+      // representation is just their decimal digits (ECMA-262 section
+      // 9.8.1 step 6), so print them without going through dtoa.
+      const double kMaxExactInteger = 9007199254740992.0;  // 2^53
+      if (-kMaxExactInteger < v && v < kMaxExactInteger) {
+        int64_t integer = static_cast<int64_t>(v);
+        if (static_cast<double>(integer) == v) {
+          bool negative = integer < 0;
+          uint64_t n = negative ? -integer : integer;
+          // Build the string backwards from the least significant digit.
+          int i = buffer.length();
+          buffer[--i] = '\0';
+          do {
+            buffer[--i] = '0' + static_cast<char>(n % 10);
+            n /= 10;
+          } while (n != 0);
+          if (negative) buffer[--i] = '-';
+          return buffer.start() + i;
+        }
+      }
+
       SimpleStringBuilder builder(buffer.start(), buffer.length());
       int decimal_point;
       int sign;
@@ -135,6 +135,12 @@ double StringToDouble(UnicodeCache* unicode_cache,
                       int flags,
                       double empty_string_val = 0);
 
+// Converts a string of the form [-]digits[.digits][(e|E)[+|-]digits] with at
+// most 19 significant digits, which covers almost all numbers in JSON data,
+// without going through the general StringToDouble machinery. Returns false
+// if the string has any other form or the fast conversion is not possible.
+bool FastStringToDouble(Vector<const uint8_t> str, double* result);
+
 const int kDoubleToCStringMinBufferSize = 100;
 
 // Converts a double to a string value according to ECMA-262 9.8.1.
@@ -65,6 +65,10 @@ void HistogramTimer::Start() {
   if (FLAG_log_internal_timer_events) {
     LOG(isolate(), TimerEvent(Logger::START, name()));
   }
+  Logger* logger = isolate()->logger();
+  if (logger->is_tracing_events()) {
+    logger->TraceEvent(Logger::START, category(), name());
+  }
 }
 
 
@@ -78,6 +82,74 @@ void HistogramTimer::Stop() {
   if (FLAG_log_internal_timer_events) {
     LOG(isolate(), TimerEvent(Logger::END, name()));
   }
+  Logger* logger = isolate()->logger();
+  if (logger->is_tracing_events()) {
+    logger->TraceEvent(Logger::END, category(), name());
+  }
+}
+
+
+// Garbage collection timers are reported in their own trace category.
+const char* HistogramTimer::category() {
+  return strncmp(name(), "V8.GC", 5) == 0 ? "v8.gc" : "v8";
+}
+
+
+RuntimeCallCounter* RuntimeCallStats::first_ = NULL;
+static LazyMutex runtime_call_stats_mutex = LAZY_MUTEX_INITIALIZER;
+
+
+void RuntimeCallStats::Register(RuntimeCallCounter* counter) {
+  LockGuard<Mutex> lock_guard(runtime_call_stats_mutex.Pointer());
+  if (counter->registered) return;
+  counter->next = first_;
+  first_ = counter;
+  counter->registered = true;
+}
+
+
+static int CompareRuntimeCallCounters(RuntimeCallCounter* const* a,
+                                      RuntimeCallCounter* const* b) {
+  if ((*a)->time_in_us != (*b)->time_in_us) {
+    return (*a)->time_in_us > (*b)->time_in_us ? -1 : 1;
+  }
+  if ((*a)->count != (*b)->count) return (*a)->count > (*b)->count ? -1 : 1;
+  return 0;
+}
+
+
+void RuntimeCallStats::Print(FILE* out) {
+  LockGuard<Mutex> lock_guard(runtime_call_stats_mutex.Pointer());
+  List<RuntimeCallCounter*> counters;
+  int64_t total_count = 0;
+  int64_t total_time = 0;
+  for (RuntimeCallCounter* c = first_; c != NULL; c = c->next) {
+    if (c->count == 0) continue;
+    counters.Add(c);
+    total_count += c->count;
+    total_time += c->time_in_us;
+  }
+  counters.Sort(&CompareRuntimeCallCounters);
+  OS::FPrint(out, "%-50s %12s %12s\n", "Runtime function/builtin", "Calls",
+             "Time (us)");
+  for (int i = 0; i < counters.length(); i++) {
+    RuntimeCallCounter* c = counters[i];
+    OS::FPrint(out, "%-50s %12" V8_PTR_PREFIX "d %12" V8_PTR_PREFIX "d\n",
+               c->name, static_cast<intptr_t>(c->count),
+               static_cast<intptr_t>(c->time_in_us));
+  }
+  OS::FPrint(out, "%-50s %12" V8_PTR_PREFIX "d %12" V8_PTR_PREFIX "d\n",
+             "Total", static_cast<intptr_t>(total_count),
+             static_cast<intptr_t>(total_time));
+}
+
+
+void RuntimeCallStats::Reset() {
+  LockGuard<Mutex> lock_guard(runtime_call_stats_mutex.Pointer());
+  for (RuntimeCallCounter* c = first_; c != NULL; c = c->next) {
+    c->count = 0;
+    c->time_in_us = 0;
+  }
 }
 
 } }  // namespace v8::internal
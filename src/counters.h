@@ -265,6 +265,8 @@ class HistogramTimer : public Histogram {
 #endif
 
  private:
+  const char* category();
+
   ElapsedTimer timer_;
 };
 
@@ -307,6 +309,59 @@ class HistogramTimerScope BASE_EMBEDDED {
 };
 
 
+// Call count and cumulative time of one runtime function or builtin, kept
+// with --runtime-call-stats. The RUNTIME_FUNCTION and BUILTIN macros define
+// one statically initialized counter per function; it is registered with
+// RuntimeCallStats the first time it is used. Times are inclusive, so they
+// include any JavaScript and nested runtime calls made by the function.
+struct RuntimeCallCounter {
+  const char* name;
+  int64_t count;
+  int64_t time_in_us;
+  RuntimeCallCounter* next;
+  bool registered;
+};
+
+#define RUNTIME_CALL_COUNTER_INITIALIZER(name) { name, 0, 0, NULL, false }
+
+
+class RuntimeCallStats : public AllStatic {
+ public:
+  static void Register(RuntimeCallCounter* counter);
+
+  // Prints all counters that were hit, sorted by cumulative time.
+  static void Print(FILE* out);
+
+  // Clears all counters.
+  static void Reset();
+
+ private:
+  static RuntimeCallCounter* first_;
+};
+
+
+class RuntimeCallTimerScope BASE_EMBEDDED {
+ public:
+  explicit RuntimeCallTimerScope(RuntimeCallCounter* counter)
+      : counter_(NULL) {
+    if (!FLAG_runtime_call_stats) return;
+    if (!counter->registered) RuntimeCallStats::Register(counter);
+    counter_ = counter;
+    start_ = TimeTicks::HighResolutionNow();
+  }
+  ~RuntimeCallTimerScope() {
+    if (counter_ == NULL) return;
+    counter_->count++;
+    counter_->time_in_us +=
+        (TimeTicks::HighResolutionNow() - start_).InMicroseconds();
+  }
+
+ private:
+  RuntimeCallCounter* counter_;
+  TimeTicks start_;
+};
+
+
 } }  // namespace v8::internal
 
 #endif  // V8_COUNTERS_H_
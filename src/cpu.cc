@@ -57,7 +57,7 @@ namespace internal {
 // Define __cpuid() for non-MSVC libraries.
 #if !V8_LIBC_MSVCRT
 
-static V8_INLINE void __cpuid(int cpu_info[4], int info_type) {
+static V8_INLINE void __cpuidex(int cpu_info[4], int info_type, int subleaf) {
 #if defined(__i386__) && defined(__pic__)
   // Make sure to preserve ebx, which contains the pointer
   // to the GOT in case we're generating PIC.
@@ -66,19 +66,39 @@ static V8_INLINE void __cpuid(int cpu_info[4], int info_type) {
     "cpuid\n\t"
     "xchg %%edi, %%ebx\n\t"
     : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]), "=d"(cpu_info[3])
-    : "a"(info_type)
+    : "a"(info_type), "c"(subleaf)
   );
 #else
   __asm__ volatile (
     "cpuid \n\t"
     : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]), "=d"(cpu_info[3])
-    : "a"(info_type)
+    : "a"(info_type), "c"(subleaf)
   );
 #endif  // defined(__i386__) && defined(__pic__)
 }
 
+
+static V8_INLINE void __cpuid(int cpu_info[4], int info_type) {
+  __cpuidex(cpu_info, info_type, 0);
+}
+
 #endif  // !V8_LIBC_MSVCRT
 
+
+// Returns the low half of the extended control register XCR0, which tells
+// which register state the OS saves on context switches. Only valid if
+// CPUID reports OSXSAVE.
+static V8_INLINE uint32_t ReadXCR0() {
+#if V8_LIBC_MSVCRT
+  return static_cast<uint32_t>(_xgetbv(0));
+#else
+  uint32_t eax, edx;
+  // Encoded as bytes since older assemblers do not know xgetbv.
+  __asm__ volatile (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+  return eax;
+#endif  // V8_LIBC_MSVCRT
+}
+
 #elif V8_HOST_ARCH_ARM || V8_HOST_ARCH_MIPS
 
 #if V8_OS_LINUX
@@ -277,6 +297,13 @@ CPU::CPU() : stepping_(0),
              has_ssse3_(false),
              has_sse41_(false),
              has_sse42_(false),
+             has_popcnt_(false),
+             has_lzcnt_(false),
+             has_avx_(false),
+             has_avx2_(false),
+             has_bmi1_(false),
+             has_bmi2_(false),
+             has_non_stop_time_stamp_counter_(false),
              has_idiva_(false),
              has_neon_(false),
              has_thumbee_(false),
@@ -318,6 +345,20 @@ CPU::CPU() : stepping_(0),
     has_ssse3_ = (cpu_info[2] & 0x00000200) != 0;
     has_sse41_ = (cpu_info[2] & 0x00080000) != 0;
     has_sse42_ = (cpu_info[2] & 0x00100000) != 0;
+    has_popcnt_ = (cpu_info[2] & 0x00800000) != 0;
+    // VEX encoded instructions fault unless the OS has enabled both the XMM
+    // and the YMM state in XCR0.
+    bool os_saves_ymm_state = (cpu_info[2] & 0x08000000) != 0 &&
+                              (ReadXCR0() & 0x6) == 0x6;
+    has_avx_ = os_saves_ymm_state && (cpu_info[2] & 0x10000000) != 0;
+  }
+
+  // Interpret structured extended feature flags.
+  if (num_ids >= 7) {
+    __cpuidex(cpu_info, 7, 0);
+    has_bmi1_ = (cpu_info[1] & 0x00000008) != 0;
+    has_avx2_ = has_avx_ && (cpu_info[1] & 0x00000020) != 0;
+    has_bmi2_ = (cpu_info[1] & 0x00000100) != 0;
   }
 
   // Query extended IDs.
@@ -334,6 +375,14 @@ CPU::CPU() : stepping_(0),
 #else
     has_sahf_ = (cpu_info[2] & 0x00000001) != 0;
 #endif
+    has_lzcnt_ = (cpu_info[2] & 0x00000020) != 0;
+  }
+
+  // Check whether the time stamp counter runs at a constant rate in all
+  // ACPI P-, C- and T-states (a.k.a. invariant TSC).
+  if (num_ext_ids >= 0x80000007) {
+    __cpuid(cpu_info, 0x80000007);
+    has_non_stop_time_stamp_counter_ = (cpu_info[3] & 0x00000100) != 0;
   }
 
 #elif V8_HOST_ARCH_ARM
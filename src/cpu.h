@@ -90,6 +90,16 @@ class CPU V8_FINAL BASE_EMBEDDED {
   bool has_ssse3() const { return has_ssse3_; }
   bool has_sse41() const { return has_sse41_; }
   bool has_sse42() const { return has_sse42_; }
+  bool has_popcnt() const { return has_popcnt_; }
+  bool has_lzcnt() const { return has_lzcnt_; }
+  // AVX and AVX2 are only reported if the OS saves the YMM state.
+  bool has_avx() const { return has_avx_; }
+  bool has_avx2() const { return has_avx2_; }
+  bool has_bmi1() const { return has_bmi1_; }
+  bool has_bmi2() const { return has_bmi2_; }
+  bool has_non_stop_time_stamp_counter() const {
+    return has_non_stop_time_stamp_counter_;
+  }
 
   // arm features
   bool has_idiva() const { return has_idiva_; }
@@ -131,6 +141,13 @@ class CPU V8_FINAL BASE_EMBEDDED {
   bool has_ssse3_;
   bool has_sse41_;
   bool has_sse42_;
+  bool has_popcnt_;
+  bool has_lzcnt_;
+  bool has_avx_;
+  bool has_avx2_;
+  bool has_bmi1_;
+  bool has_bmi2_;
+  bool has_non_stop_time_stamp_counter_;
   bool has_idiva_;
   bool has_neon_;
   bool has_thumbee_;
@@ -40,6 +40,11 @@
 #include <string.h>
 #include <sys/stat.h>
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/mman.h>  // NOLINT
+#undef MAP_TYPE
+#endif
+
 #ifdef V8_SHARED
 #include <assert.h>
 #endif  // V8_SHARED
@@ -60,6 +65,7 @@
 
 #ifndef V8_SHARED
 #include "api.h"
+#include "atomicops.h"
 #include "checks.h"
 #include "cpu.h"
 #include "d8-debug.h"
@@ -161,6 +167,9 @@ i::OS::MemoryMappedFile* Shell::counters_file_ = NULL;
 CounterCollection Shell::local_counters_;
 CounterCollection* Shell::counters_ = &local_counters_;
 i::Mutex Shell::context_mutex_;
+i::Mutex Shell::workers_mutex_;
+bool Shell::allow_new_workers_ = true;
+i::List<Worker*> Shell::workers_;
 const i::TimeTicks Shell::kInitialTicks = i::TimeTicks::HighResolutionNow();
 Persistent<Context> Shell::utility_context_;
 #endif  // V8_SHARED
@@ -675,28 +684,65 @@ int32_t* Counter::Bind(const char* name, bool is_histogram) {
   for (i = 0; i < kMaxNameSize - 1 && name[i]; i++)
     name_[i] = static_cast<char>(name[i]);
   name_[i] = '\0';
-  is_histogram_ = is_histogram;
+  is_histogram_ = is_histogram ? 1 : 0;
+  min_ = 0;
+  max_ = 0;
+  bucket_count_ = 0;
   return ptr();
 }
 
 
+void Counter::BindHistogram(int32_t min, int32_t max, int32_t bucket_count) {
+  // Keep room for the underflow and overflow buckets.
+  bucket_count = i::Max(3, i::Min(bucket_count, kMaxBuckets));
+  min_ = min;
+  max_ = i::Max(max, min + 1);
+  bucket_count_ = bucket_count;
+  for (int i = 0; i < bucket_count; i++) buckets_[i] = 0;
+}
+
+
 void Counter::AddSample(int32_t sample) {
-  count_++;
-  sample_total_ += sample;
+  i::NoBarrier_AtomicIncrement(
+      reinterpret_cast<volatile i::Atomic32*>(&count_), 1);
+  i::NoBarrier_AtomicIncrement(
+      reinterpret_cast<volatile i::Atomic32*>(&sample_total_), sample);
+  if (bucket_count_ == 0) return;
+  int bucket;
+  if (sample < min_) {
+    bucket = 0;
+  } else if (sample >= max_) {
+    bucket = bucket_count_ - 1;
+  } else {
+    int64_t offset = static_cast<int64_t>(sample) - min_;
+    bucket = 1 + static_cast<int>(
+        offset * (bucket_count_ - 2) / (static_cast<int64_t>(max_) - min_));
+  }
+  i::NoBarrier_AtomicIncrement(
+      reinterpret_cast<volatile i::Atomic32*>(&buckets_[bucket]), 1);
 }
 
 
 CounterCollection::CounterCollection() {
   magic_number_ = 0xDEADFACE;
+  version_ = kVersion;
   max_counters_ = kMaxCounters;
   max_name_size_ = Counter::kMaxNameSize;
+  max_buckets_ = Counter::kMaxBuckets;
   counters_in_use_ = 0;
 }
 
 
 Counter* CounterCollection::GetNextCounter() {
   if (counters_in_use_ == kMaxCounters) return NULL;
-  return &counters_[counters_in_use_++];
+  return &counters_[counters_in_use_];
+}
+
+
+void CounterCollection::PublishCounter() {
+  ASSERT(counters_in_use_ < kMaxCounters);
+  i::Release_Store(reinterpret_cast<volatile i::Atomic32*>(&counters_in_use_),
+                   counters_in_use_ + 1);
 }
 
 
@@ -727,7 +773,11 @@ int CounterMap::Hash(const char* name) {
 }
 
 
-Counter* Shell::GetCounter(const char* name, bool is_histogram) {
+Counter* Shell::GetCounter(const char* name,
+                          bool is_histogram,
+                          int min,
+                          int max,
+                          size_t buckets) {
   Counter* counter = counter_map_->Lookup(name);
 
   if (counter == NULL) {
@@ -735,6 +785,10 @@ Counter* Shell::GetCounter(const char* name, bool is_histogram) {
     if (counter != NULL) {
       counter_map_->Set(name, counter);
       counter->Bind(name, is_histogram);
+      if (is_histogram) {
+        counter->BindHistogram(min, max, static_cast<int32_t>(buckets));
+      }
+      counters_->PublishCounter();
     }
   } else {
     ASSERT(counter->is_histogram() == is_histogram);
@@ -744,7 +798,7 @@ Counter* Shell::GetCounter(const char* name, bool is_histogram) {
 
 
 int* Shell::LookupCounter(const char* name) {
-  Counter* counter = GetCounter(name, false);
+  Counter* counter = GetCounter(name, false, 0, 0, 0);
 
   if (counter != NULL) {
     return counter->ptr();
@@ -758,7 +812,7 @@ void* Shell::CreateHistogram(const char* name,
                              int min,
                              int max,
                              size_t buckets) {
-  return GetCounter(name, true);
+  return GetCounter(name, true, min, max, buckets);
 }
 
 
@@ -901,6 +955,20 @@ Handle<ObjectTemplate> Shell::CreateGlobalTemplate(Isolate* isolate) {
                             FunctionTemplate::New(isolate, PerformanceNow));
   global_template->Set(String::NewFromUtf8(isolate, "performance"),
                        performance_template);
+
+  Handle<FunctionTemplate> worker_fun_template =
+      FunctionTemplate::New(isolate, WorkerNew);
+  Handle<ObjectTemplate> worker_prototype =
+      worker_fun_template->PrototypeTemplate();
+  worker_prototype->Set(String::NewFromUtf8(isolate, "postMessage"),
+                        FunctionTemplate::New(isolate, WorkerPostMessage));
+  worker_prototype->Set(String::NewFromUtf8(isolate, "getMessage"),
+                        FunctionTemplate::New(isolate, WorkerGetMessage));
+  worker_prototype->Set(String::NewFromUtf8(isolate, "terminate"),
+                        FunctionTemplate::New(isolate, WorkerTerminate));
+  worker_fun_template->InstanceTemplate()->SetInternalFieldCount(1);
+  global_template->Set(String::NewFromUtf8(isolate, "Worker"),
+                       worker_fun_template);
 #endif  // V8_SHARED
 
 #if !defined(V8_SHARED) && !defined(_WIN32) && !defined(_WIN64)
@@ -1096,8 +1164,101 @@ static char* ReadChars(Isolate* isolate, const char* name, int* size_out) {
 }
 
 
+// A private, copy-on-write mapping of a regular file. Writes through the
+// mapping are never written back to the file.
+class MappedFile {
+ public:
+  // Files smaller than this are read, since mapping them saves little.
+  static const size_t kMinSize = 1 << 20;
+
+  // Returns NULL if the file cannot be mapped or is smaller than kMinSize.
+  static MappedFile* Open(const char* name) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    FILE* file = FOpen(name, "rb");
+    if (file == NULL) return NULL;
+    struct stat file_stat;
+    if (fstat(fileno(file), &file_stat) != 0 ||
+        static_cast<size_t>(file_stat.st_size) < kMinSize) {
+      fclose(file);
+      return NULL;
+    }
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                        fileno(file), 0);
+    // The mapping stays valid after the file is closed.
+    fclose(file);
+    if (memory == MAP_FAILED) return NULL;
+    return new MappedFile(memory, size);
+#else
+    return NULL;
+#endif
+  }
+
+  ~MappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+    munmap(memory_, size_);
+#endif
+  }
+
+  char* data() const { return reinterpret_cast<char*>(memory_); }
+  size_t size() const { return size_; }
+
+ private:
+  MappedFile(void* memory, size_t size) : memory_(memory), size_(size) { }
+
+  void* memory_;
+  size_t size_;
+};
+
+
+// Keeps a file mapping alive for as long as an external string uses it.
+class MappedFileStringResource : public String::ExternalAsciiStringResource {
+ public:
+  explicit MappedFileStringResource(MappedFile* file) : file_(file) { }
+  virtual ~MappedFileStringResource() { delete file_; }
+
+  virtual const char* data() const { return file_->data(); }
+  virtual size_t length() const { return file_->size(); }
+
+ private:
+  MappedFile* file_;
+};
+
+
+// Reads a large file into a string without copying it into a heap buffer
+// first. ASCII files become external strings over the mapping. Returns an
+// empty handle if the file was not mapped.
+static Handle<String> ReadMappedFile(Isolate* isolate, const char* name) {
+  MappedFile* file;
+  bool is_ascii = true;
+  {
+    // Release the V8 lock while reading files.
+    v8::Unlocker unlocker(isolate);
+    file = MappedFile::Open(name);
+    if (file == NULL) return Handle<String>();
+    const char* data = file->data();
+    for (size_t i = 0; i < file->size(); i++) {
+      if (static_cast<unsigned char>(data[i]) > 0x7f) {
+        is_ascii = false;
+        break;
+      }
+    }
+  }
+  if (is_ascii) {
+    return String::NewExternal(isolate, new MappedFileStringResource(file));
+  }
+  Handle<String> result = String::NewFromUtf8(
+      isolate, file->data(), String::kNormalString,
+      static_cast<int>(file->size()));
+  delete file;
+  return result;
+}
+
+
 struct DataAndPersistent {
   uint8_t* data;
+  // Set instead of 'data' if the buffer is backed by a file mapping.
+  MappedFile* file;
   Persistent<ArrayBuffer> handle;
 };
 
@@ -1109,6 +1270,7 @@ static void ReadBufferWeakCallback(
       -static_cast<intptr_t>(byte_length));
 
   delete[] data.GetParameter()->data;
+  delete data.GetParameter()->file;
   data.GetParameter()->handle.Reset();
   delete data.GetParameter();
 }
@@ -1117,7 +1279,6 @@ static void ReadBufferWeakCallback(
 void Shell::ReadBuffer(const v8::FunctionCallbackInfo<v8::Value>& args) {
   ASSERT(sizeof(char) == sizeof(uint8_t));  // NOLINT
   String::Utf8Value filename(args[0]);
-  int length;
   if (*filename == NULL) {
     Throw(args.GetIsolate(), "Error loading file");
     return;
@@ -1125,19 +1286,35 @@ void Shell::ReadBuffer(const v8::FunctionCallbackInfo<v8::Value>& args) {
 
   Isolate* isolate = args.GetIsolate();
   DataAndPersistent* data = new DataAndPersistent;
-  data->data = reinterpret_cast<uint8_t*>(
-      ReadChars(args.GetIsolate(), *filename, &length));
-  if (data->data == NULL) {
-    delete data;
-    Throw(args.GetIsolate(), "Error reading file");
-    return;
+  data->data = NULL;
+  {
+    v8::Unlocker unlocker(isolate);
+    data->file = MappedFile::Open(*filename);
+  }
+  size_t length;
+  void* contents;
+  if (data->file != NULL) {
+    contents = data->file->data();
+    length = data->file->size();
+  } else {
+    int size;
+    data->data = reinterpret_cast<uint8_t*>(
+        ReadChars(args.GetIsolate(), *filename, &size));
+    if (data->data == NULL) {
+      delete data;
+      Throw(args.GetIsolate(), "Error reading file");
+      return;
+    }
+    contents = data->data;
+    length = static_cast<size_t>(size);
   }
   Handle<v8::ArrayBuffer> buffer =
-      ArrayBuffer::New(isolate, data->data, length);
+      ArrayBuffer::New(isolate, contents, length);
   data->handle.Reset(isolate, buffer);
   data->handle.SetWeak(data, ReadBufferWeakCallback);
   data->handle.MarkIndependent();
-  isolate->AdjustAmountOfExternalAllocatedMemory(length);
+  isolate->AdjustAmountOfExternalAllocatedMemory(
+      static_cast<int64_t>(length));
 
   args.GetReturnValue().Set(buffer);
 }
@@ -1168,6 +1345,8 @@ static char* ReadWord(char* data) {
 
 // Reads a file into a v8 string.
 Handle<String> Shell::ReadFile(Isolate* isolate, const char* name) {
+  Handle<String> mapped = ReadMappedFile(isolate, name);
+  if (!mapped.IsEmpty()) return mapped;
   int size = 0;
   char* chars = ReadChars(isolate, name, &size);
   if (chars == NULL) return Handle<String>();
@@ -1310,13 +1489,7 @@ void SourceGroup::Execute(Isolate* isolate) {
 
 
 Handle<String> SourceGroup::ReadFile(Isolate* isolate, const char* name) {
-  int size;
-  char* chars = ReadChars(isolate, name, &size);
-  if (chars == NULL) return Handle<String>();
-  Handle<String> result =
-      String::NewFromUtf8(isolate, chars, String::kNormalString, size);
-  delete[] chars;
-  return result;
+  return Shell::ReadFile(isolate, name);
 }
 
 
@@ -1376,6 +1549,598 @@ void SourceGroup::WaitForThread() {
     done_semaphore_.Wait();
   }
 }
+
+
+SerializationData::~SerializationData() {
+  // Backing stores that were transferred but never claimed by a receiver
+  // are still owned by the message.
+  for (int i = 0; i < contents_.length(); ++i) {
+    free(contents_[i].data);
+  }
+}
+
+
+void SerializationData::WriteMemory(const void* p, int length) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(p);
+  for (int i = 0; i < length; ++i) data_.Add(bytes[i]);
+}
+
+
+void SerializationData::WriteBufferContents(const BufferContents& contents) {
+  contents_.Add(contents);
+}
+
+
+SerializationTag SerializationData::ReadTag(int* offset) const {
+  return static_cast<SerializationTag>(data_[(*offset)++]);
+}
+
+
+int32_t SerializationData::ReadInt(int* offset) const {
+  int32_t value;
+  ReadMemory(&value, sizeof(value), offset);
+  return value;
+}
+
+
+double SerializationData::ReadDouble(int* offset) const {
+  double value;
+  ReadMemory(&value, sizeof(value), offset);
+  return value;
+}
+
+
+void SerializationData::ReadMemory(void* p, int length, int* offset) const {
+  if (length == 0) return;
+  ASSERT(*offset + length <= data_.length());
+  memcpy(p, &data_[*offset], length);
+  *offset += length;
+}
+
+
+SerializationData::BufferContents SerializationData::TakeBufferContents(
+    int index) {
+  BufferContents contents = contents_[index];
+  contents_[index].data = NULL;
+  return contents;
+}
+
+
+void SerializationDataQueue::Enqueue(SerializationData* data) {
+  i::LockGuard<i::Mutex> lock_guard(&mutex_);
+  data_.Add(data);
+}
+
+
+bool SerializationDataQueue::Dequeue(SerializationData** data) {
+  i::LockGuard<i::Mutex> lock_guard(&mutex_);
+  if (data_.is_empty()) return false;
+  *data = data_.Remove(0);
+  return true;
+}
+
+
+void SerializationDataQueue::Clear() {
+  i::LockGuard<i::Mutex> lock_guard(&mutex_);
+  while (!data_.is_empty()) delete data_.RemoveLast();
+}
+
+
+// Encodes a value graph into a SerializationData.  Only primitives,
+// arrays, plain objects and array buffers can be cloned; shared or cyclic
+// references are not preserved, and are bounded by kMaxDepth.
+class MessageWriter {
+ public:
+  MessageWriter(Isolate* isolate,
+                const i::List<Handle<ArrayBuffer> >& transfer,
+                SerializationData* data)
+      : isolate_(isolate), transfer_(transfer), data_(data) {}
+
+  bool WriteValue(Handle<Value> value, int depth);
+
+ private:
+  static const int kMaxDepth = 64;
+
+  bool WriteArrayBuffer(Handle<ArrayBuffer> buffer);
+
+  Isolate* isolate_;
+  const i::List<Handle<ArrayBuffer> >& transfer_;
+  SerializationData* data_;
+};
+
+
+bool MessageWriter::WriteValue(Handle<Value> value, int depth) {
+  if (depth > kMaxDepth) {
+    Throw(isolate_, "Message is nested too deeply or cyclic");
+    return false;
+  }
+  if (value->IsUndefined()) {
+    data_->WriteTag(kSerializationTagUndefined);
+  } else if (value->IsNull()) {
+    data_->WriteTag(kSerializationTagNull);
+  } else if (value->IsTrue()) {
+    data_->WriteTag(kSerializationTagTrue);
+  } else if (value->IsFalse()) {
+    data_->WriteTag(kSerializationTagFalse);
+  } else if (value->IsNumber()) {
+    data_->WriteTag(kSerializationTagNumber);
+    data_->WriteDouble(value->NumberValue());
+  } else if (value->IsString()) {
+    String::Utf8Value str(value);
+    data_->WriteTag(kSerializationTagString);
+    data_->WriteInt(str.length());
+    data_->WriteMemory(*str, str.length());
+  } else if (value->IsArrayBuffer()) {
+    return WriteArrayBuffer(Handle<ArrayBuffer>::Cast(value));
+  } else if (value->IsArray()) {
+    Handle<Array> array = Handle<Array>::Cast(value);
+    uint32_t length = array->Length();
+    data_->WriteTag(kSerializationTagArray);
+    data_->WriteInt(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      HandleScope scope(isolate_);
+      Local<Value> element = array->Get(i);
+      if (element.IsEmpty() || !WriteValue(element, depth + 1)) return false;
+    }
+  } else if (value->IsObject() && !value->IsFunction()) {
+    Handle<Object> object = Handle<Object>::Cast(value);
+    Local<Array> names = object->GetOwnPropertyNames();
+    if (names.IsEmpty()) return false;
+    uint32_t length = names->Length();
+    data_->WriteTag(kSerializationTagObject);
+    data_->WriteInt(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      HandleScope scope(isolate_);
+      Local<Value> name = names->Get(i);
+      if (name.IsEmpty()) return false;
+      Local<String> key = name->ToString();
+      if (key.IsEmpty() || !WriteValue(key, depth + 1)) return false;
+      Local<Value> property = object->Get(key);
+      if (property.IsEmpty() || !WriteValue(property, depth + 1)) {
+        return false;
+      }
+    }
+  } else {
+    Throw(isolate_, "Value cannot be cloned");
+    return false;
+  }
+  return true;
+}
+
+
+bool MessageWriter::WriteArrayBuffer(Handle<ArrayBuffer> buffer) {
+  for (int i = 0; i < transfer_.length(); ++i) {
+    if (transfer_[i] == buffer) {
+      // The backing store itself is attached once the whole message has
+      // been written, see Shell::SerializeMessage.
+      data_->WriteTag(kSerializationTagTransferredArrayBuffer);
+      data_->WriteInt(i);
+      return true;
+    }
+  }
+  i::Handle<i::JSArrayBuffer> object = Utils::OpenHandle(*buffer);
+  int length = static_cast<int>(buffer->ByteLength());
+  data_->WriteTag(kSerializationTagArrayBuffer);
+  data_->WriteInt(length);
+  data_->WriteMemory(object->backing_store(), length);
+  return true;
+}
+
+
+// Owns the backing store of a transferred array buffer until the receiving
+// ArrayBuffer dies.
+struct TransferredArrayBuffer {
+  Persistent<ArrayBuffer> handle;
+  void* data;
+  size_t byte_length;
+};
+
+
+static void TransferredArrayBufferWeakCallback(
+    const WeakCallbackData<ArrayBuffer, TransferredArrayBuffer>& data) {
+  TransferredArrayBuffer* buffer = data.GetParameter();
+  data.GetIsolate()->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(buffer->byte_length));
+  free(buffer->data);
+  buffer->handle.Reset();
+  delete buffer;
+}
+
+
+// Decodes a SerializationData in the receiving isolate.  Transferred backing
+// stores are adopted without copying.
+class MessageReader {
+ public:
+  MessageReader(Isolate* isolate, SerializationData* data)
+      : isolate_(isolate), data_(data), offset_(0), transferred_(0) {}
+
+  Handle<Value> ReadValue();
+
+ private:
+  Handle<Value> ReadTransferredArrayBuffer(int index);
+
+  Isolate* isolate_;
+  SerializationData* data_;
+  int offset_;
+  i::List<Handle<ArrayBuffer> > transferred_;
+};
+
+
+Handle<Value> MessageReader::ReadValue() {
+  switch (data_->ReadTag(&offset_)) {
+    case kSerializationTagUndefined:
+      return Undefined(isolate_);
+    case kSerializationTagNull:
+      return Null(isolate_);
+    case kSerializationTagTrue:
+      return True(isolate_);
+    case kSerializationTagFalse:
+      return False(isolate_);
+    case kSerializationTagNumber:
+      return Number::New(isolate_, data_->ReadDouble(&offset_));
+    case kSerializationTagString: {
+      int length = data_->ReadInt(&offset_);
+      i::ScopedVector<char> chars(length);
+      data_->ReadMemory(chars.start(), length, &offset_);
+      return String::NewFromUtf8(isolate_, chars.start(),
+                                 String::kNormalString, length);
+    }
+    case kSerializationTagArray: {
+      int length = data_->ReadInt(&offset_);
+      Handle<Array> array = Array::New(isolate_, length);
+      for (int i = 0; i < length; ++i) {
+        array->Set(i, ReadValue());
+      }
+      return array;
+    }
+    case kSerializationTagObject: {
+      int length = data_->ReadInt(&offset_);
+      Handle<Object> object = Object::New(isolate_);
+      for (int i = 0; i < length; ++i) {
+        Handle<Value> key = ReadValue();
+        object->Set(key, ReadValue());
+      }
+      return object;
+    }
+    case kSerializationTagArrayBuffer: {
+      int length = data_->ReadInt(&offset_);
+      Handle<ArrayBuffer> buffer = ArrayBuffer::New(isolate_, length);
+      i::Handle<i::JSArrayBuffer> object = Utils::OpenHandle(*buffer);
+      data_->ReadMemory(object->backing_store(), length, &offset_);
+      return buffer;
+    }
+    case kSerializationTagTransferredArrayBuffer:
+      return ReadTransferredArrayBuffer(data_->ReadInt(&offset_));
+  }
+  UNREACHABLE();
+  return Handle<Value>();
+}
+
+
+Handle<Value> MessageReader::ReadTransferredArrayBuffer(int index) {
+  // A buffer that is referenced more than once is only adopted once.
+  while (transferred_.length() <= index) {
+    transferred_.Add(Handle<ArrayBuffer>());
+  }
+  if (!transferred_[index].IsEmpty()) return transferred_[index];
+
+  SerializationData::BufferContents contents =
+      data_->TakeBufferContents(index);
+  Local<ArrayBuffer> buffer =
+      ArrayBuffer::New(isolate_, contents.data, contents.byte_length);
+  TransferredArrayBuffer* holder = new TransferredArrayBuffer();
+  holder->data = contents.data;
+  holder->byte_length = contents.byte_length;
+  holder->handle.Reset(isolate_, buffer);
+  holder->handle.SetWeak(holder, TransferredArrayBufferWeakCallback);
+  isolate_->AdjustAmountOfExternalAllocatedMemory(
+      static_cast<int64_t>(contents.byte_length));
+  transferred_[index] = buffer;
+  return buffer;
+}
+
+
+SerializationData* Shell::SerializeMessage(Isolate* isolate,
+                                           Handle<Value> value,
+                                           Handle<Value> transfer) {
+  i::List<Handle<v8::ArrayBuffer> > to_transfer;
+  if (!transfer->IsUndefined()) {
+    if (!transfer->IsArray()) {
+      Throw(isolate, "Transfer list must be an Array");
+      return NULL;
+    }
+    Handle<Array> array = Handle<Array>::Cast(transfer);
+    for (uint32_t i = 0; i < array->Length(); ++i) {
+      Local<Value> element = array->Get(i);
+      if (element.IsEmpty()) return NULL;
+      if (!element->IsArrayBuffer()) {
+        Throw(isolate, "Transfer list may only contain ArrayBuffers");
+        return NULL;
+      }
+      Handle<v8::ArrayBuffer> buffer = Handle<v8::ArrayBuffer>::Cast(element);
+      for (int j = 0; j < to_transfer.length(); ++j) {
+        if (to_transfer[j] == buffer) {
+          Throw(isolate, "ArrayBuffer occurs in the transfer list twice");
+          return NULL;
+        }
+      }
+      to_transfer.Add(buffer);
+    }
+  }
+
+  SerializationData* data = new SerializationData();
+  MessageWriter writer(isolate, to_transfer, data);
+  if (!writer.WriteValue(value, 0)) {
+    delete data;
+    return NULL;
+  }
+
+  // Only detach the transferred buffers once the message is known to be
+  // cloneable, so that a failed postMessage leaves them untouched.
+  for (int i = 0; i < to_transfer.length(); ++i) {
+    Handle<v8::ArrayBuffer> buffer = to_transfer[i];
+    SerializationData::BufferContents contents;
+    contents.byte_length = buffer->ByteLength();
+    if (buffer->IsExternal()) {
+      // The embedder owns this backing store, so it has to be copied.
+      i::Handle<i::JSArrayBuffer> object = Utils::OpenHandle(*buffer);
+      contents.data = malloc(contents.byte_length);
+      memcpy(contents.data, object->backing_store(), contents.byte_length);
+    } else {
+      contents.data = buffer->Externalize().Data();
+    }
+    buffer->Neuter();
+    data->WriteBufferContents(contents);
+  }
+  return data;
+}
+
+
+Handle<Value> Shell::DeserializeMessage(Isolate* isolate,
+                                        SerializationData* data) {
+  MessageReader reader(isolate, data);
+  return reader.ReadValue();
+}
+
+
+Worker::Worker()
+    : in_semaphore_(0),
+      out_semaphore_(0),
+      thread_(NULL),
+      script_(NULL),
+      running_(0),
+      isolate_(NULL) {}
+
+
+Worker::~Worker() {
+  WaitForThread();
+  i::DeleteArray(script_);
+}
+
+
+void Worker::StartExecuteInThread(const char* script) {
+  ASSERT(thread_ == NULL);
+  script_ = i::StrDup(script);
+  i::Release_Store(&running_, 1);
+  thread_ = new WorkerThread(this);
+  thread_->Start();
+}
+
+
+void Worker::PostMessage(SerializationData* data) {
+  in_queue_.Enqueue(data);
+  in_semaphore_.Signal();
+}
+
+
+SerializationData* Worker::GetMessage() {
+  while (true) {
+    // Everything the worker posted before it stopped is visible once the
+    // flag reads as cleared.
+    bool running = i::Acquire_Load(&running_) != 0;
+    SerializationData* data = NULL;
+    if (out_queue_.Dequeue(&data)) return data;
+    if (!running) return NULL;
+    out_semaphore_.Wait();
+  }
+}
+
+
+void Worker::Terminate() {
+  i::Release_Store(&running_, 0);
+  // Wake up a worker that is waiting for messages...
+  in_semaphore_.Signal();
+  // ...and stop one that is still running script.
+  i::LockGuard<i::Mutex> lock_guard(&isolate_mutex_);
+  if (isolate_ != NULL) V8::TerminateExecution(isolate_);
+}
+
+
+void Worker::WaitForThread() {
+  if (thread_ == NULL) return;
+  thread_->Join();
+  delete thread_;
+  thread_ = NULL;
+}
+
+
+void Worker::ExecuteInThread() {
+  Isolate* isolate = Isolate::New();
+  {
+    Isolate::Scope iscope(isolate);
+    Locker lock(isolate);
+    HandleScope scope(isolate);
+    PerIsolateData data(isolate);
+    Local<Context> context = Shell::CreateEvaluationContext(isolate);
+    Context::Scope cscope(context);
+    PerIsolateData::RealmScope realm_scope(PerIsolateData::Get(isolate));
+
+    Handle<Object> global = context->Global();
+    Handle<FunctionTemplate> post_message = FunctionTemplate::New(
+        isolate, PostMessageOut, External::New(isolate, this));
+    global->Set(String::NewFromUtf8(isolate, "postMessage"),
+                post_message->GetFunction());
+
+    // Only expose the isolate to Terminate once its context is set up.
+    {
+      i::LockGuard<i::Mutex> lock_guard(&isolate_mutex_);
+      isolate_ = isolate;
+    }
+    bool terminated = !i::Acquire_Load(&running_);
+    if (!terminated) {
+      TryCatch try_catch;
+      Handle<Script> script = Script::Compile(
+          String::NewFromUtf8(isolate, script_),
+          String::NewFromUtf8(isolate, "worker"));
+      if (!script.IsEmpty()) script->Run();
+      if (try_catch.HasCaught()) {
+        terminated = !try_catch.CanContinue();
+        if (!terminated) Shell::ReportException(isolate, &try_catch);
+      }
+    }
+
+    Handle<String> onmessage_name = String::NewFromUtf8(isolate, "onmessage");
+    while (!terminated) {
+      in_semaphore_.Wait();
+      if (!i::Acquire_Load(&running_)) break;
+      SerializationData* message = NULL;
+      if (!in_queue_.Dequeue(&message)) continue;
+      HandleScope message_scope(isolate);
+      Local<Value> onmessage = global->Get(onmessage_name);
+      if (onmessage->IsFunction()) {
+        TryCatch try_catch;
+        Handle<Value> argv[] = { Shell::DeserializeMessage(isolate, message) };
+        Handle<Function>::Cast(onmessage)->Call(global, 1, argv);
+        if (try_catch.HasCaught()) {
+          terminated = !try_catch.CanContinue();
+          if (!terminated) Shell::ReportException(isolate, &try_catch);
+        }
+      }
+      delete message;
+    }
+  }
+  {
+    i::LockGuard<i::Mutex> lock_guard(&isolate_mutex_);
+    isolate_ = NULL;
+  }
+  isolate->Dispose();
+  in_queue_.Clear();
+
+  // Unblock an owner waiting in GetMessage.
+  i::Release_Store(&running_, 0);
+  out_semaphore_.Signal();
+}
+
+
+void Worker::PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  if (args.Length() < 1) {
+    Throw(isolate, "Invalid argument");
+    return;
+  }
+  Worker* worker =
+      static_cast<Worker*>(Local<External>::Cast(args.Data())->Value());
+  SerializationData* data = Shell::SerializeMessage(isolate, args[0], args[1]);
+  if (data == NULL) return;
+  worker->out_queue_.Enqueue(data);
+  worker->out_semaphore_.Signal();
+}
+
+
+static Worker* GetWorkerFromThis(
+    const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Handle<Object> holder = args.Holder();
+  if (holder->InternalFieldCount() != 1 ||
+      holder->GetAlignedPointerFromInternalField(0) == NULL) {
+    Throw(args.GetIsolate(), "Receiver is not a Worker");
+    return NULL;
+  }
+  return static_cast<Worker*>(holder->GetAlignedPointerFromInternalField(0));
+}
+
+
+// new Worker(source) runs source in a new isolate on its own thread.
+void Shell::WorkerNew(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  if (!args.IsConstructCall()) {
+    Throw(isolate, "Worker must be constructed with new");
+    return;
+  }
+  if (args.Length() < 1 || !args[0]->IsString()) {
+    Throw(isolate, "1st argument must be a string");
+    return;
+  }
+  args.This()->SetAlignedPointerInInternalField(0, NULL);
+  Worker* worker = new Worker();
+  {
+    i::LockGuard<i::Mutex> lock_guard(&workers_mutex_);
+    if (!allow_new_workers_) {
+      delete worker;
+      Throw(isolate, "Cannot start new workers during shutdown");
+      return;
+    }
+    workers_.Add(worker);
+  }
+  args.This()->SetAlignedPointerInInternalField(0, worker);
+  String::Utf8Value script(args[0]);
+  worker->StartExecuteInThread(*script);
+}
+
+
+// worker.postMessage(message, transfer) sends a structured clone of message
+// to the worker's onmessage function.  The ArrayBuffers listed in transfer
+// are moved rather than copied and are neutered in the sender.
+void Shell::WorkerPostMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  Worker* worker = GetWorkerFromThis(args);
+  if (worker == NULL) return;
+  if (args.Length() < 1) {
+    Throw(isolate, "Invalid argument");
+    return;
+  }
+  SerializationData* data = SerializeMessage(isolate, args[0], args[1]);
+  if (data != NULL) worker->PostMessage(data);
+}
+
+
+// worker.getMessage() waits for the next message posted by the worker, or
+// returns undefined if the worker has stopped.
+void Shell::WorkerGetMessage(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  HandleScope handle_scope(isolate);
+  Worker* worker = GetWorkerFromThis(args);
+  if (worker == NULL) return;
+  SerializationData* data = worker->GetMessage();
+  if (data == NULL) return;
+  args.GetReturnValue().Set(DeserializeMessage(isolate, data));
+  delete data;
+}
+
+
+// worker.terminate() stops the worker, even if it is still running script.
+void Shell::WorkerTerminate(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Worker* worker = GetWorkerFromThis(args);
+  if (worker == NULL) return;
+  worker->Terminate();
+}
+
+
+void Shell::CleanupWorkers() {
+  i::List<Worker*> workers;
+  {
+    i::LockGuard<i::Mutex> lock_guard(&workers_mutex_);
+    allow_new_workers_ = false;
+    workers.AddAll(workers_);
+    workers_.Clear();
+  }
+  // Terminate all workers before joining any of them, since a worker may
+  // be blocked waiting for a message from another one.
+  for (int i = 0; i < workers.length(); ++i) workers[i]->Terminate();
+  for (int i = 0; i < workers.length(); ++i) delete workers[i];
+}
 #endif  // V8_SHARED
 
 
@@ -1754,6 +2519,9 @@ int Shell::Main(int argc, char* argv[]) {
 #endif  // !V8_SHARED && ENABLE_DEBUGGER_SUPPORT
       RunShell(isolate);
     }
+#ifndef V8_SHARED
+    CleanupWorkers();
+#endif  // V8_SHARED
   }
   V8::Dispose();
 
@@ -41,36 +41,57 @@ namespace v8 {
 
 
 #ifndef V8_SHARED
-// A single counter in a counter collection.
+// A single counter in a counter collection.  All fields are 32-bit words
+// so that the layout in the counters file is the same on every platform.
+// Histograms record the number of samples, their total and a linear
+// distribution over bucket_count buckets: bucket 0 holds samples below min,
+// the last bucket samples at or above max, and the buckets in between
+// split [min, max) evenly.  Histogram samples are added with atomic
+// increments, so readers of a mapped counters file can scrape it at any
+// time without coordinating with the writer.
 class Counter {
  public:
   static const int kMaxNameSize = 64;
+  static const int kMaxBuckets = 100;
   int32_t* Bind(const char* name, bool histogram);
+  void BindHistogram(int32_t min, int32_t max, int32_t bucket_count);
   int32_t* ptr() { return &count_; }
   int32_t count() { return count_; }
   int32_t sample_total() { return sample_total_; }
-  bool is_histogram() { return is_histogram_; }
+  bool is_histogram() { return is_histogram_ != 0; }
   void AddSample(int32_t sample);
  private:
   int32_t count_;
   int32_t sample_total_;
-  bool is_histogram_;
+  int32_t is_histogram_;
+  int32_t min_;
+  int32_t max_;
+  int32_t bucket_count_;
+  int32_t buckets_[kMaxBuckets];
   uint8_t name_[kMaxNameSize];
 };
 
 
 // A set of counters and associated information.  An instance of this
 // class is stored directly in the memory-mapped counters file if
-// the --map-counters options is used
+// the --map-counters options is used.  A counter is filled in before
+// counters_in_use_ is bumped past it, so readers never see a partially
+// bound counter.
 class CounterCollection {
  public:
   CounterCollection();
+  // Returns the next free counter, which becomes visible to readers of
+  // the counters file once it is published.
   Counter* GetNextCounter();
+  void PublishCounter();
  private:
+  static const uint32_t kVersion = 2;
   static const unsigned kMaxCounters = 512;
   uint32_t magic_number_;
+  uint32_t version_;
   uint32_t max_counters_;
   uint32_t max_name_size_;
+  uint32_t max_buckets_;
   uint32_t counters_in_use_;
   Counter counters_[kMaxCounters];
 };
@@ -194,6 +215,123 @@ class SourceGroup {
 };
 
 
+#ifndef V8_SHARED
+enum SerializationTag {
+  kSerializationTagUndefined,
+  kSerializationTagNull,
+  kSerializationTagTrue,
+  kSerializationTagFalse,
+  kSerializationTagNumber,
+  kSerializationTagString,
+  kSerializationTagArray,
+  kSerializationTagObject,
+  kSerializationTagArrayBuffer,
+  kSerializationTagTransferredArrayBuffer
+};
+
+
+// A message passed between a worker and its owner.  Messages are flat byte
+// streams so that no heap object is ever shared between two isolates.
+// Transferred array buffers travel out of line as raw malloc'ed backing
+// stores; a store that is never claimed by the receiver is freed together
+// with the message.
+class SerializationData {
+ public:
+  struct BufferContents {
+    void* data;
+    size_t byte_length;
+  };
+
+  SerializationData() : data_(16), contents_(0) {}
+  ~SerializationData();
+
+  void WriteTag(SerializationTag tag) { data_.Add(static_cast<uint8_t>(tag)); }
+  void WriteInt(int32_t value) { WriteMemory(&value, sizeof(value)); }
+  void WriteDouble(double value) { WriteMemory(&value, sizeof(value)); }
+  void WriteMemory(const void* p, int length);
+  void WriteBufferContents(const BufferContents& contents);
+
+  SerializationTag ReadTag(int* offset) const;
+  int32_t ReadInt(int* offset) const;
+  double ReadDouble(int* offset) const;
+  void ReadMemory(void* p, int length, int* offset) const;
+  // Hands ownership of the index'th transferred backing store to the caller.
+  BufferContents TakeBufferContents(int index);
+
+ private:
+  i::List<uint8_t> data_;
+  i::List<BufferContents> contents_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializationData);
+};
+
+
+class SerializationDataQueue {
+ public:
+  SerializationDataQueue() : data_(4) {}
+  ~SerializationDataQueue() { Clear(); }
+
+  void Enqueue(SerializationData* data);
+  bool Dequeue(SerializationData** data);
+  void Clear();
+
+ private:
+  i::Mutex mutex_;
+  i::List<SerializationData*> data_;
+};
+
+
+// A script running in its own isolate on its own thread.  The owner and
+// the worker only communicate through messages: the owner posts to the
+// worker's in-queue, where they are delivered to the global onmessage
+// function, and the worker's postMessage fills the out-queue that the owner
+// drains with getMessage.
+class Worker {
+ public:
+  Worker();
+  ~Worker();
+
+  void StartExecuteInThread(const char* script);
+  // Takes ownership of data.
+  void PostMessage(SerializationData* data);
+  // Blocks until a message from the worker is available.  Returns NULL
+  // once the worker has finished and its out-queue is empty.
+  SerializationData* GetMessage();
+  void Terminate();
+  void WaitForThread();
+
+ private:
+  class WorkerThread : public i::Thread {
+   public:
+    explicit WorkerThread(Worker* worker)
+        : i::Thread(i::Thread::Options("WorkerThread", 2 * i::MB)),
+          worker_(worker) {}
+
+    virtual void Run() { worker_->ExecuteInThread(); }
+
+   private:
+    Worker* worker_;
+  };
+
+  void ExecuteInThread();
+  static void PostMessageOut(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  i::Semaphore in_semaphore_;
+  i::Semaphore out_semaphore_;
+  SerializationDataQueue in_queue_;
+  SerializationDataQueue out_queue_;
+  i::Thread* thread_;
+  char* script_;
+  i::Atomic32 running_;
+  // Guards isolate_, which is only set while the worker thread is running.
+  i::Mutex isolate_mutex_;
+  Isolate* isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+#endif  // V8_SHARED
+
+
 class BinaryResource : public v8::String::ExternalAsciiStringResource {
  public:
   BinaryResource(const char* string, int length)
@@ -311,6 +449,22 @@ class Shell : public i::AllStatic {
   static void RealmDispose(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RealmSwitch(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RealmEval(const v8::FunctionCallbackInfo<v8::Value>& args);
+#ifndef V8_SHARED
+  static void WorkerNew(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerPostMessage(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerGetMessage(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WorkerTerminate(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Encodes value into a message, moving the array buffers in transfer
+  // (if not empty) into it.  Returns NULL with a pending exception if
+  // value cannot be cloned.
+  static SerializationData* SerializeMessage(Isolate* isolate,
+                                             Handle<Value> value,
+                                             Handle<Value> transfer);
+  static Handle<Value> DeserializeMessage(Isolate* isolate,
+                                         SerializationData* data);
+  static void CleanupWorkers();
+#endif  // V8_SHARED
   static void RealmSharedGet(Local<String> property,
                              const  PropertyCallbackInfo<Value>& info);
   static void RealmSharedSet(Local<String> property,
@@ -394,9 +548,16 @@ class Shell : public i::AllStatic {
   static CounterCollection* counters_;
   static i::OS::MemoryMappedFile* counters_file_;
   static i::Mutex context_mutex_;
+  static i::Mutex workers_mutex_;
+  static bool allow_new_workers_;
+  static i::List<Worker*> workers_;
   static const i::TimeTicks kInitialTicks;
 
-  static Counter* GetCounter(const char* name, bool is_histogram);
+  static Counter* GetCounter(const char* name,
+                             bool is_histogram,
+                             int min,
+                             int max,
+                             size_t buckets);
   static void InstallUtilityScript(Isolate* isolate);
 #endif  // V8_SHARED
   static void Initialize(Isolate* isolate);
@@ -39,12 +39,11 @@ namespace internal {
 static const int kDaysIn4Years = 4 * 365 + 1;
 static const int kDaysIn100Years = 25 * kDaysIn4Years - 1;
 static const int kDaysIn400Years = 4 * kDaysIn100Years + 1;
-static const int kDays1970to2000 = 30 * 365 + 7;
-static const int kDaysOffset = 1000 * kDaysIn400Years + 5 * kDaysIn400Years -
-                               kDays1970to2000;
+// Days from March 1, 0000 to January 1, 1970.
+static const int kDays0000to1970 = 719468;
+// Shift by 1000 cycles of 400 years to make all supported days positive.
+static const int kDaysOffset = 1000 * kDaysIn400Years + kDays0000to1970;
 static const int kYearsOffset = 400000;
-static const char kDaysInMonths[] =
-    {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
 
 void DateCache::ResetDateCache() {
@@ -54,6 +53,9 @@ void DateCache::ResetDateCache() {
     stamp_ = Smi::FromInt(0);
   }
   ASSERT(stamp_ != Smi::FromInt(kInvalidStamp));
+  for (int i = 0; i < kDSTBlockCount; ++i) {
+    dst_blocks_[i].state = kDSTBlockEmpty;
+  }
   for (int i = 0; i < kDSTSize; ++i) {
     ClearSegment(&dst_[i]);
   }
@@ -88,69 +90,38 @@ void DateCache::YearMonthDayFromDays(
       return;
     }
   }
-  int save_days = days;
-
-  days += kDaysOffset;
-  *year = 400 * (days / kDaysIn400Years) - kYearsOffset;
-  days %= kDaysIn400Years;
-
-  ASSERT(DaysFromYearMonth(*year, 0) + days == save_days);
-
-  days--;
-  int yd1 = days / kDaysIn100Years;
-  days %= kDaysIn100Years;
-  *year += 100 * yd1;
-
-  days++;
-  int yd2 = days / kDaysIn4Years;
-  days %= kDaysIn4Years;
-  *year += 4 * yd2;
-
-  days--;
-  int yd3 = days / 365;
-  days %= 365;
-  *year += yd3;
-
-
-  bool is_leap = (!yd1 || yd2) && !yd3;
-
-  ASSERT(days >= -1);
-  ASSERT(is_leap || (days >= 0));
-  ASSERT((days < 365) || (is_leap && (days < 366)));
-  ASSERT(is_leap == ((*year % 4 == 0) && (*year % 100 || (*year % 400 == 0))));
-  ASSERT(is_leap || ((DaysFromYearMonth(*year, 0) + days) == save_days));
-  ASSERT(!is_leap || ((DaysFromYearMonth(*year, 0) + days + 1) == save_days));
-
-  days += is_leap;
-
-  // Check if the date is after February.
-  if (days >= 31 + 28 + is_leap) {
-    days -= 31 + 28 + is_leap;
-    // Find the date starting from March.
-    for (int i = 2; i < 12; i++) {
-      if (days < kDaysInMonths[i]) {
-        *month = i;
-        *day = days + 1;
-        break;
-      }
-      days -= kDaysInMonths[i];
-    }
-  } else {
-    // Check January and February.
-    if (days < 31) {
-      *month = 0;
-      *day = days + 1;
-    } else {
-      *month = 1;
-      *day = days - 31 + 1;
-    }
-  }
-  ASSERT(DaysFromYearMonth(*year, *month) + *day - 1 == save_days);
+
+  // Branch-free computation due to Neri and Schneider ("Euclidean affine
+  // functions and their application to calendar algorithms", 2022).
+  // The days are counted from March 1 of a year far enough in the past
+  // to keep all intermediate values unsigned. Starting the year in March
+  // puts leap days at the end of the year, so that the month lengths
+  // follow a fixed pattern that is captured by a linear function.
+  ASSERT(days >= -kDaysOffset);
+  ASSERT(days <= static_cast<int>(kMaxUInt32 / 4) - kDaysOffset);
+  uint32_t n1 = 4 * static_cast<uint32_t>(days + kDaysOffset) + 3;
+  uint32_t centuries = n1 / kDaysIn400Years;
+  uint32_t n2 = (n1 % kDaysIn400Years) | 3;
+  // 2939745 / 2^32 approximates 4 / 1461 closely enough to divide n2 by the
+  // average length of a year, leaving the day of the year in the low bits.
+  uint64_t p2 = static_cast<uint64_t>(2939745) * n2;
+  uint32_t years = static_cast<uint32_t>(p2 >> 32);
+  uint32_t day_of_year = static_cast<uint32_t>(p2) / 2939745 / 4;
+  // 2141 / 2^16 approximates 5 / 153, the rate of months in March-based
+  // years.
+  uint32_t n3 = 2141 * day_of_year + 197913;
+  uint32_t is_january_or_february = day_of_year >= 306;
+  *year = static_cast<int>(100 * centuries + years + is_january_or_february) -
+          kYearsOffset;
+  *month = static_cast<int>((n3 >> 16) - 12 * is_january_or_february) - 1;
+  *day = static_cast<int>((n3 & 0xFFFF) / 2141) + 1;
+
+  ASSERT(DaysFromYearMonth(*year, *month) + *day - 1 == days);
   ymd_valid_ = true;
   ymd_year_ = *year;
   ymd_month_ = *month;
   ymd_day_ = *day;
-  ymd_days_ = save_days;
+  ymd_days_ = days;
 }
 
 
@@ -222,7 +193,78 @@ int DateCache::DaylightSavingsOffsetInMs(int64_t time_ms) {
   int time_sec = (time_ms >= 0 && time_ms <= kMaxEpochTimeInMs)
       ? static_cast<int>(time_ms / 1000)
       : static_cast<int>(EquivalentTime(time_ms) / 1000);
+  ASSERT(0 <= time_sec && time_sec <= kMaxEpochTimeInSec);
+
+  int index = time_sec >> kDSTBlockBits;
+  DSTBlock* block = &dst_blocks_[index];
+  if (block->state == kDSTBlockEmpty) FillDSTBlock(index);
+  if (block->state == kDSTBlockOverflowed) {
+    return CachedDaylightSavingsOffsetInMs(time_sec);
+  }
+
+  // Find the last transition that starts at or before time_sec.
+  ASSERT(block->transitions[0].start_sec <= time_sec);
+  int low = 0;
+  int high = block->transitions_count;
+  while (high - low > 1) {
+    int middle = low + (high - low) / 2;
+    if (block->transitions[middle].start_sec <= time_sec) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return block->transitions[low].offset_ms;
+}
+
+
+void DateCache::FillDSTBlock(int index) {
+  DSTBlock* block = &dst_blocks_[index];
+  int start_sec = index << kDSTBlockBits;
+  int last_sec = Min(start_sec + (kDSTBlockSizeInSec - 1), kMaxEpochTimeInSec);
+
+  int offset_ms = GetDaylightSavingsOffsetFromOS(start_sec);
+  block->transitions[0].start_sec = start_sec;
+  block->transitions[0].offset_ms = offset_ms;
+  block->transitions_count = 1;
+
+  // Sample the block at intervals that are short enough to contain at most
+  // one offset change (see kDefaultDSTDeltaInSec) and find each change by
+  // bisection.
+  int time_sec = start_sec;
+  while (time_sec < last_sec) {
+    int next_sec = last_sec - time_sec > kDefaultDSTDeltaInSec
+        ? time_sec + kDefaultDSTDeltaInSec
+        : last_sec;
+    int next_offset_ms = GetDaylightSavingsOffsetFromOS(next_sec);
+    if (next_offset_ms != offset_ms) {
+      int low = time_sec;
+      int high = next_sec;
+      while (high - low > 1) {
+        int middle = low + (high - low) / 2;
+        if (GetDaylightSavingsOffsetFromOS(middle) == offset_ms) {
+          low = middle;
+        } else {
+          high = middle;
+        }
+      }
+      if (block->transitions_count == kMaxDSTTransitionsPerBlock) {
+        block->state = kDSTBlockOverflowed;
+        return;
+      }
+      DSTTransition* transition =
+          &block->transitions[block->transitions_count++];
+      transition->start_sec = high;
+      transition->offset_ms = next_offset_ms;
+      offset_ms = next_offset_ms;
+    }
+    time_sec = next_sec;
+  }
+  block->state = kDSTBlockFilled;
+}
+
 
+int DateCache::CachedDaylightSavingsOffsetInMs(int time_sec) {
   // Invalidate cache if the usage counter is close to overflow.
   // Note that dst_usage_counter is incremented less than ten times
   // in this function.
@@ -209,6 +209,37 @@ class DateCache {
   // Size of the Daylight Savings Time cache.
   static const int kDSTSize = 32;
 
+  // The daylight savings offsets of the representable epoch times
+  // [0, kMaxEpochTimeInSec] are tabulated lazily in blocks of 2^25 seconds
+  // (about 388 days). Each block stores the sorted list of offset changes
+  // that occur in it, so that a lookup is a binary search in a short array.
+  static const int kDSTBlockBits = 25;
+  static const int kDSTBlockSizeInSec = 1 << kDSTBlockBits;
+  static const int kDSTBlockCount =
+      (kMaxEpochTimeInSec >> kDSTBlockBits) + 1;
+  // Blocks with more offset changes than this are served by the DST cache.
+  static const int kMaxDSTTransitionsPerBlock = 8;
+
+  // A point in time starting from which the daylight savings offset is
+  // offset_ms until the next transition.
+  struct DSTTransition {
+    int start_sec;
+    int offset_ms;
+  };
+
+  enum DSTBlockState {
+    kDSTBlockEmpty,
+    kDSTBlockFilled,
+    kDSTBlockOverflowed
+  };
+
+  struct DSTBlock {
+    DSTBlockState state;
+    int transitions_count;
+    // The first transition starts at the beginning of the block.
+    DSTTransition transitions[kMaxDSTTransitionsPerBlock];
+  };
+
   // Daylight Savings Time segment stores a segment of time where
   // daylight savings offset does not change.
   struct DST {
@@ -222,6 +253,14 @@ class DateCache {
   // ECMA 262 - 15.9.1.8
   int DaylightSavingsOffsetInMs(int64_t time_ms);
 
+  // Looks up the daylight savings offset in the segments of the DST cache,
+  // querying the OS and extending the segments on a miss.
+  int CachedDaylightSavingsOffsetInMs(int time_sec);
+
+  // Queries the OS for all daylight savings offset changes in the given
+  // block. The block overflows if it contains too many changes.
+  void FillDSTBlock(int index);
+
   // Sets the before_ and the after_ segments from the DST cache such that
   // the before_ segment starts earlier than the given time and
   // the after_ segment start later than the given time.
@@ -246,6 +285,9 @@ class DateCache {
 
   Smi* stamp_;
 
+  // Daylight Saving Time transition table.
+  DSTBlock dst_blocks_[kDSTBlockCount];
+
   // Daylight Saving Time cache.
   DST dst_[kDSTSize];
   int dst_usage_counter_;
@@ -58,6 +58,7 @@ namespace internal {
 
 Debug::Debug(Isolate* isolate)
     : has_break_points_(false),
+      all_functions_prepared_(false),
       script_cache_(NULL),
       debug_info_list_(NULL),
       disable_break_(false),
@@ -763,6 +764,7 @@ bool Debug::CompileDebuggerScript(Isolate* isolate, int index) {
                                           false,
                                           context,
                                           NULL, NULL,
+                                          NO_CACHED_DATA,
                                           NATIVES_CODE);
 
   // Silently ignore stack overflows during compilation.
@@ -1162,10 +1164,9 @@ void Debug::SetBreakPoint(Handle<JSFunction> function,
                           int* source_position) {
   HandleScope scope(isolate_);
 
-  PrepareForBreakPoints();
-
   // Make sure the function is compiled and has set up the debug info.
   Handle<SharedFunctionInfo> shared(function->shared());
+  if (!PrepareFunctionForBreakPoints(shared)) PrepareForBreakPoints();
   if (!EnsureDebugInfo(shared, function)) {
     // Return if retrieving debug info failed.
     return;
@@ -1193,11 +1194,20 @@ bool Debug::SetBreakPointForScript(Handle<Script> script,
                                    BreakPositionAlignment alignment) {
   HandleScope scope(isolate_);
 
-  PrepareForBreakPoints();
+  if (FLAG_break_points_deoptimize_all) PrepareForBreakPoints();
 
   // Obtain shared function info for the function.
   Object* result = FindSharedFunctionInfoInScript(script, *source_position);
   if (result->IsUndefined()) return false;
+  if (!FLAG_break_points_deoptimize_all &&
+      !PrepareFunctionForBreakPoints(
+          Handle<SharedFunctionInfo>(SharedFunctionInfo::cast(result)))) {
+    // Preparing all functions may have discarded the code of the function,
+    // so look it up again.
+    PrepareForBreakPoints();
+    result = FindSharedFunctionInfoInScript(script, *source_position);
+    if (result->IsUndefined()) return false;
+  }
 
   // Make sure the function has set up the debug info.
   Handle<SharedFunctionInfo> shared(SharedFunctionInfo::cast(result));
@@ -1997,7 +2007,7 @@ class ActiveFunctionsRedirector : public ThreadVisitor {
 void Debug::PrepareForBreakPoints() {
   // If preparing for the first break point make sure to deoptimize all
   // functions as debugging does not work with optimized code.
-  if (!has_break_points_) {
+  if (!all_functions_prepared_) {
     if (isolate_->concurrent_recompilation_enabled()) {
       isolate_->optimizing_compiler_thread()->Flush();
     }
@@ -2008,6 +2018,7 @@ void Debug::PrepareForBreakPoints() {
 
     // There will be at least one break point when we are done.
     has_break_points_ = true;
+    all_functions_prepared_ = true;
 
     // Keep the list of activated functions in a handlified list as it
     // is used both in GC and non-GC code.
@@ -2126,6 +2137,38 @@ void Debug::PrepareForBreakPoints() {
 }
 
 
+bool Debug::PrepareFunctionForBreakPoints(Handle<SharedFunctionInfo> shared) {
+  if (FLAG_break_points_deoptimize_all) return false;
+  if (all_functions_prepared_) return true;
+
+  // Break points can only be set precisely in unoptimized code with debug
+  // break slots. Code compiled while the debugger is active has them.
+  bool has_slots = shared->is_compiled()
+      ? shared->code()->has_debug_break_slots()
+      : isolate_->debugger()->IsDebuggerActive();
+  if (!has_slots) return false;
+
+  // Abort in-flight compilations, which may inline the function.
+  if (isolate_->concurrent_recompilation_enabled()) {
+    isolate_->optimizing_compiler_thread()->Flush();
+  }
+
+  // There will be at least one break point when we are done.
+  has_break_points_ = true;
+  Deoptimizer::DeoptimizeCodeContaining(*shared);
+  return true;
+}
+
+
+bool Debug::PreventsOptimization(SharedFunctionInfo* shared) {
+  if (!has_break_points_) return false;
+  if (FLAG_break_points_deoptimize_all || all_functions_prepared_) {
+    return true;
+  }
+  return shared->debug_info()->IsDebugInfo();
+}
+
+
 Object* Debug::FindSharedFunctionInfoInScript(Handle<Script> script,
                                               int position) {
   // Iterate the heap looking for SharedFunctionInfo generated from the
@@ -2285,6 +2328,7 @@ void Debug::RemoveDebugInfo(Handle<DebugInfo> debug_info) {
       // If there are no more debug info objects there are not more break
       // points.
       has_break_points_ = debug_info_list_ != NULL;
+      if (!has_break_points_) all_functions_prepared_ = false;
 
       return;
     }
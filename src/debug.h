@@ -273,6 +273,15 @@ class Debug {
 
   void PrepareForBreakPoints();
 
+  // Prepares only the given function for break points, deoptimizing the
+  // code it is part of. Returns false if all functions need to be prepared
+  // instead, e.g. because its unoptimized code lacks debug break slots.
+  bool PrepareFunctionForBreakPoints(Handle<SharedFunctionInfo> shared);
+
+  // Check whether break points keep the given function from being
+  // optimized or inlined.
+  bool PreventsOptimization(SharedFunctionInfo* shared);
+
   // This function is used in FunctionNameUsing* tests.
   Object* FindSharedFunctionInfoInScript(Handle<Script> script, int position);
 
@@ -556,6 +565,11 @@ class Debug {
   // Boolean state indicating whether any break points are set.
   bool has_break_points_;
 
+  // Boolean state indicating whether all functions have been deoptimized
+  // and prepared for break points, as opposed to only those functions that
+  // contain break points.
+  bool all_functions_prepared_;
+
   // Cache of all scripts in the heap.
   ScriptCache* script_cache_;
 
@@ -27,6 +27,7 @@
 
 #include "v8.h"
 
+#include "../include/v8-profiler.h"
 #include "accessors.h"
 #include "codegen.h"
 #include "deoptimizer.h"
@@ -59,7 +60,9 @@ DeoptimizerData::DeoptimizerData(MemoryAllocator* allocator)
 #ifdef ENABLE_DEBUGGER_SUPPORT
       deoptimized_frame_info_(NULL),
 #endif
-      current_(NULL) {
+      current_(NULL),
+      batch_depth_(0),
+      batch_has_marked_code_(false) {
   for (int i = 0; i < Deoptimizer::kBailoutTypesWithCodeEntry; ++i) {
     deopt_entry_code_entries_[i] = -1;
     deopt_entry_code_[i] = AllocateCodeChunk(allocator);
@@ -84,6 +87,75 @@ void DeoptimizerData::Iterate(ObjectVisitor* v) {
 #endif
 
 
+void DeoptimizerData::RecordDeoptimization(SharedFunctionInfo* shared,
+                                           BailoutId ast_id,
+                                           Deoptimizer::BailoutType type) {
+  int script_id = shared->script()->IsScript()
+      ? Smi::cast(Script::cast(shared->script())->id())->value()
+      : 0;
+  int position = shared->start_position();
+  DeoptimizationRecord* record = NULL;
+  for (int i = 0; i < deopt_stats_.length(); i++) {
+    DeoptimizationRecord* current = &deopt_stats_[i];
+    if (current->script_id == script_id &&
+        current->function_position == position &&
+        current->ast_id == ast_id.ToInt() &&
+        current->type == type) {
+      record = current;
+      break;
+    }
+  }
+  if (record == NULL) {
+    DeoptimizationRecord new_record;
+    new_record.script_id = script_id;
+    new_record.function_position = position;
+    new_record.ast_id = ast_id.ToInt();
+    new_record.type = type;
+    new_record.count = 0;
+    deopt_stats_.Add(new_record);
+    record = &deopt_stats_.last();
+  }
+  record->count++;
+  record->function_deopt_count = shared->deopt_count();
+  record->optimization_disabled = shared->optimization_disabled() ||
+      shared->opt_count() >= FLAG_max_opt_count;
+}
+
+
+int DeoptimizerData::CompareRecordCounts(const DeoptimizationRecord* a,
+                                         const DeoptimizationRecord* b) {
+  if (a->count != b->count) return a->count > b->count ? -1 : 1;
+  return 0;
+}
+
+
+int DeoptimizerData::GetTopDeoptimizations(v8::DeoptimizationStats* stats,
+                                           int max_entries) {
+  STATIC_ASSERT(static_cast<int>(v8::DeoptimizationStats::kEager) ==
+                static_cast<int>(Deoptimizer::EAGER));
+  STATIC_ASSERT(static_cast<int>(v8::DeoptimizationStats::kLazy) ==
+                static_cast<int>(Deoptimizer::LAZY));
+  STATIC_ASSERT(static_cast<int>(v8::DeoptimizationStats::kSoft) ==
+                static_cast<int>(Deoptimizer::SOFT));
+  STATIC_ASSERT(static_cast<int>(v8::DeoptimizationStats::kDebugger) ==
+                static_cast<int>(Deoptimizer::DEBUGGER));
+  deopt_stats_.Sort(CompareRecordCounts);
+  int count = Min(max_entries, deopt_stats_.length());
+  for (int i = 0; i < count; i++) {
+    const DeoptimizationRecord& record = deopt_stats_[i];
+    stats[i].script_id = record.script_id;
+    stats[i].function_position = record.function_position;
+    stats[i].bailout_id = record.ast_id;
+    stats[i].bailout_type =
+        static_cast<v8::DeoptimizationStats::BailoutType>(record.type);
+    stats[i].count = record.count;
+    stats[i].function_deopt_count = record.function_deopt_count;
+    stats[i].optimization_disabled = record.optimization_disabled;
+  }
+  return count;
+}
+
+
 Code* Deoptimizer::FindDeoptimizingCode(Address addr) {
   if (function_->IsHeapObject()) {
     // Search all deoptimizing code in the native context of the function.
@@ -442,6 +514,32 @@ void Deoptimizer::DeoptimizeMarkedCode(Isolate* isolate) {
 }
 
 
+void Deoptimizer::ScheduleDeoptimizeMarkedCode(Isolate* isolate) {
+  DeoptimizerData* data = isolate->deoptimizer_data();
+  if (data->batch_depth_ > 0) {
+    isolate->counters()->deopt_marked_code_batched()->Increment();
+    data->batch_has_marked_code_ = true;
+    return;
+  }
+  DeoptimizeMarkedCode(isolate);
+}
+
+
+DeoptimizationBatchScope::DeoptimizationBatchScope(Isolate* isolate)
+    : isolate_(isolate) {
+  isolate->deoptimizer_data()->batch_depth_++;
+}
+
+
+DeoptimizationBatchScope::~DeoptimizationBatchScope() {
+  DeoptimizerData* data = isolate_->deoptimizer_data();
+  ASSERT(data->batch_depth_ > 0);
+  if (--data->batch_depth_ > 0 || !data->batch_has_marked_code_) return;
+  data->batch_has_marked_code_ = false;
+  Deoptimizer::DeoptimizeMarkedCode(isolate_);
+}
+
+
 void Deoptimizer::DeoptimizeGlobalObject(JSObject* object) {
   if (FLAG_trace_deopt) {
     CodeTracer::Scope scope(object->GetHeap()->isolate()->GetCodeTracer());
@@ -485,6 +583,62 @@ void Deoptimizer::DeoptimizeFunction(JSFunction* function) {
 }
 
 
+static bool CodeContainsFunction(Code* code, SharedFunctionInfo* shared) {
+  FixedArray* raw_data = code->deoptimization_data();
+  // Without deoptimization data we cannot tell which functions were
+  // inlined, so be conservative.
+  if (raw_data->length() == 0) return true;
+  DeoptimizationInputData* data = DeoptimizationInputData::cast(raw_data);
+  if (data->SharedFunctionInfo() == shared) return true;
+  FixedArray* literals = data->LiteralArray();
+  int inlined_count = data->InlinedFunctionCount()->value();
+  for (int i = 0; i < inlined_count; i++) {
+    if (JSFunction::cast(literals->get(i))->shared() == shared) return true;
+  }
+  return false;
+}
+
+
+void Deoptimizer::DeoptimizeCodeContaining(SharedFunctionInfo* shared) {
+  Isolate* isolate = shared->GetIsolate();
+  if (FLAG_trace_deopt) {
+    CodeTracer::Scope scope(isolate->GetCodeTracer());
+    PrintF(scope.file(), "[deoptimize code containing ");
+    shared->ShortPrint(scope.file());
+    PrintF(scope.file(), "]\n");
+  }
+  DisallowHeapAllocation no_allocation;
+  Object* context = isolate->heap()->native_contexts_list();
+  while (!context->IsUndefined()) {
+    Context* native_context = Context::cast(context);
+    bool marked = false;
+    Object* element = native_context->OptimizedCodeListHead();
+    while (!element->IsUndefined()) {
+      Code* code = Code::cast(element);
+      if (CodeContainsFunction(code, shared)) {
+        code->set_marked_for_deoptimization(true);
+        // Keep the outer function from picking the code up again when
+        // new closures are created.
+        FixedArray* raw_data = code->deoptimization_data();
+        if (raw_data->length() != 0) {
+          Object* outer = DeoptimizationInputData::cast(
+              raw_data)->SharedFunctionInfo();
+          if (outer->IsSharedFunctionInfo()) {
+            SharedFunctionInfo::cast(outer)->EvictFromOptimizedCodeMap(
+                code, "deoptimize code containing function");
+          }
+        }
+        marked = true;
+      }
+      element = code->next_code_link();
+    }
+    if (marked) DeoptimizeMarkedCodeForContext(native_context);
+    context = native_context->get(Context::NEXT_CONTEXT_LINK);
+  }
+  shared->ClearOptimizedCodeMap();
+}
+
+
 void Deoptimizer::ComputeOutputFrames(Deoptimizer* deoptimizer) {
   deoptimizer->DoComputeOutputFrames();
 }
@@ -729,6 +883,14 @@ void Deoptimizer::DoComputeOutputFrames() {
       compiled_code_->kind() == Code::OPTIMIZED_FUNCTION) {
     LOG(isolate(), CodeDeoptEvent(compiled_code_));
   }
+  if (isolate()->logger()->is_tracing_events() &&
+      compiled_code_->kind() == Code::OPTIMIZED_FUNCTION) {
+    isolate()->logger()->TraceEvent(v8::Isolate::kTraceEventInstant,
+                                    "v8.compile",
+                                    "V8.Deoptimize",
+                                    "bailout_id",
+                                    bailout_id_);
+  }
   ElapsedTimer timer;
 
   // Determine basic deoptimization information.  The optimized frame is
@@ -754,6 +916,10 @@ void Deoptimizer::DoComputeOutputFrames() {
   }
 
   BailoutId node_id = input_data->AstId(bailout_id_);
+  if (compiled_code_->kind() == Code::OPTIMIZED_FUNCTION) {
+    isolate_->deoptimizer_data()->RecordDeoptimization(
+        function_->shared(), node_id, bailout_type_);
+  }
   ByteArray* translations = input_data->TranslationByteArray();
   unsigned translation_index =
       input_data->TranslationIndex(bailout_id_)->value();
@@ -814,6 +980,7 @@ void Deoptimizer::DoComputeOutputFrames() {
       case Translation::INT32_STACK_SLOT:
       case Translation::UINT32_STACK_SLOT:
       case Translation::DOUBLE_STACK_SLOT:
+      case Translation::STACK_HANDLER_SLOT:
       case Translation::LITERAL:
       case Translation::ARGUMENTS_OBJECT:
       default:
@@ -2035,6 +2202,7 @@ void Deoptimizer::DoTranslateObject(TranslationIterator* iterator,
     case Translation::GETTER_STUB_FRAME:
     case Translation::SETTER_STUB_FRAME:
     case Translation::COMPILED_STUB_FRAME:
+    case Translation::STACK_HANDLER_SLOT:
       UNREACHABLE();
       return;
 
@@ -2494,6 +2662,61 @@ void Deoptimizer::DoTranslateCommand(TranslationIterator* iterator,
       return;
     }
 
+    case Translation::STACK_HANDLER_SLOT: {
+      // Rebuild the try handler pushed by optimized code as the one the
+      // unoptimized code pushes.  The handler words are translated from the
+      // frame pointer down to the link to the next handler.
+      int slot = iterator->Next();
+      int handler_index = iterator->Next();
+      FrameDescription* output_frame = output_[frame_index];
+      intptr_t value = kPlaceholder;
+      if (bailout_type_ != DEBUGGER) {
+        switch (slot * kPointerSize) {
+          case StackHandlerConstants::kFPOffset:
+            value = output_frame->GetFp();
+            break;
+          case StackHandlerConstants::kContextOffset:
+            value = output_frame->GetContext();
+            break;
+          case StackHandlerConstants::kStateOffset:
+            value = StackHandler::IndexField::encode(handler_index) |
+                    StackHandler::KindField::encode(StackHandler::CATCH);
+            break;
+          case StackHandlerConstants::kCodeOffset:
+            value = reinterpret_cast<intptr_t>(function_->shared()->code());
+            break;
+          case StackHandlerConstants::kNextOffset: {
+            // Skip the handler of the optimized frame being replaced.
+            Address input_fp = reinterpret_cast<Address>(
+                input_->GetRegister(JavaScriptFrame::fp_register().code()));
+            StackHandler* next = StackHandler::FromAddress(
+                Isolate::handler(isolate_->thread_local_top()));
+            while (next != NULL && next->address() < input_fp) {
+              next = next->next();
+            }
+            value = reinterpret_cast<intptr_t>(next);
+            *isolate_->handler_address() = reinterpret_cast<Address>(
+                output_frame->GetTop() + output_offset);
+            break;
+          }
+          default:
+            UNREACHABLE();
+        }
+      }
+      if (trace_scope_ != NULL) {
+        PrintF(trace_scope_->file(),
+               "    0x%08" V8PRIxPTR ": [top + %d] <- 0x%08" V8PRIxPTR
+               " ; handler #%d [%d]\n",
+               output_frame->GetTop() + output_offset,
+               output_offset,
+               value,
+               handler_index,
+               slot);
+      }
+      output_frame->SetFrameSlot(output_offset, value);
+      return;
+    }
+
     case Translation::LITERAL: {
       Object* literal = ComputeLiteral(iterator->Next());
       if (trace_scope_ != NULL) {
@@ -2784,7 +3007,7 @@ void TranslationBuffer::Add(int32_t value, Zone* zone) {
 }
 
 
-int32_t TranslationIterator::Next() {
+int32_t TranslationIterator::NextMultiByte() {
   // Run through the bytes until we reach one with a least significant
   // bit of zero (marks the end).
   uint32_t bits = 0;
@@ -2917,6 +3140,13 @@ void Translation::StoreDoubleStackSlot(int index) {
 }
 
 
+void Translation::StoreStackHandlerSlot(int slot, int handler_index) {
+  buffer_->Add(STACK_HANDLER_SLOT, zone());
+  buffer_->Add(slot, zone());
+  buffer_->Add(handler_index, zone());
+}
+
+
 void Translation::StoreLiteral(int literal_id) {
   buffer_->Add(LITERAL, zone());
   buffer_->Add(literal_id, zone());
@@ -2954,6 +3184,7 @@ int Translation::NumberOfOperandsFor(Opcode opcode) {
     case BEGIN:
     case ARGUMENTS_ADAPTOR_FRAME:
     case CONSTRUCT_STUB_FRAME:
+    case STACK_HANDLER_SLOT:
       return 2;
     case JS_FRAME:
       return 3;
@@ -3040,6 +3271,11 @@ SlotRef SlotRefValueBuilder::ComputeSlotForNextArgument(
       return SlotRef(slot_addr, SlotRef::DOUBLE);
     }
 
+    case Translation::STACK_HANDLER_SLOT: {
+      iterator->Skip(Translation::NumberOfOperandsFor(opcode));
+      return SlotRef(data->GetIsolate(), Smi::FromInt(0));
+    }
+
     case Translation::LITERAL: {
       int literal_index = iterator->Next();
       return SlotRef(data->GetIsolate(),
@@ -34,6 +34,10 @@
 #include "macro-assembler.h"
 #include "zone-inl.h"
 
+namespace v8 {
+struct DeoptimizationStats;
+}
+
 
 namespace v8 {
 namespace internal {
@@ -191,6 +195,11 @@ class Deoptimizer : public Malloced {
   // execution returns.
   static void DeoptimizeFunction(JSFunction* function);
 
+  // Deoptimize all optimized code for the given function, including code
+  // that the function has been inlined into, and flush its optimized code
+  // cache.
+  static void DeoptimizeCodeContaining(SharedFunctionInfo* shared);
+
   // Deoptimize all code in the given isolate.
   static void DeoptimizeAll(Isolate* isolate);
 
@@ -202,6 +211,11 @@ class Deoptimizer : public Malloced {
   // refer to that code.
   static void DeoptimizeMarkedCode(Isolate* isolate);
 
+  // Like DeoptimizeMarkedCode, but while a DeoptimizationBatchScope is
+  // active the work is deferred and done once when the outermost scope
+  // is left.
+  static void ScheduleDeoptimizeMarkedCode(Isolate* isolate);
+
   // Visit all the known optimized functions in a given isolate.
   static void VisitAllOptimizedFunctions(
       Isolate* isolate, OptimizedFunctionVisitor* visitor);
@@ -646,7 +660,28 @@ class DeoptimizerData {
   void Iterate(ObjectVisitor* v);
 #endif
 
+  // Counts a deoptimization of the function at the given AST id.
+  void RecordDeoptimization(SharedFunctionInfo* shared,
+                            BailoutId ast_id,
+                            Deoptimizer::BailoutType type);
+  // See v8::CpuProfiler::GetTopDeoptimizations.
+  int GetTopDeoptimizations(v8::DeoptimizationStats* stats, int max_entries);
+  void ClearDeoptimizationStats() { deopt_stats_.Clear(); }
+
  private:
+  struct DeoptimizationRecord {
+    int script_id;
+    int function_position;
+    int ast_id;
+    Deoptimizer::BailoutType type;
+    int count;
+    int function_deopt_count;
+    bool optimization_disabled;
+  };
+
+  static int CompareRecordCounts(const DeoptimizationRecord* a,
+                                 const DeoptimizationRecord* b);
+
   MemoryAllocator* allocator_;
   int deopt_entry_code_entries_[Deoptimizer::kBailoutTypesWithCodeEntry];
   MemoryChunk* deopt_entry_code_[Deoptimizer::kBailoutTypesWithCodeEntry];
@@ -657,12 +692,38 @@ class DeoptimizerData {
 
   Deoptimizer* current_;
 
+  // Nesting depth of DeoptimizationBatchScopes and whether a deferred
+  // DeoptimizeMarkedCode is pending.
+  int batch_depth_;
+  bool batch_has_marked_code_;
+
+  // Deoptimization points seen so far.  Deoptimizations are rare enough
+  // for a linear search to be acceptable.
+  List<DeoptimizationRecord> deopt_stats_;
+
   friend class Deoptimizer;
+  friend class DeoptimizationBatchScope;
 
   DISALLOW_COPY_AND_ASSIGN(DeoptimizerData);
 };
 
 
+// Aggregates the invalidations of dependent code triggered by one runtime
+// operation, e.g. deprecating a whole map transition tree, so that the
+// optimized code lists are walked and patched once instead of once per
+// invalidated group. No JavaScript code may run while the scope is active.
+class DeoptimizationBatchScope BASE_EMBEDDED {
+ public:
+  explicit DeoptimizationBatchScope(Isolate* isolate);
+  ~DeoptimizationBatchScope();
+
+ private:
+  Isolate* isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptimizationBatchScope);
+};
+
+
 class TranslationBuffer BASE_EMBEDDED {
  public:
   explicit TranslationBuffer(Zone* zone) : contents_(256, zone) { }
@@ -684,15 +745,32 @@ class TranslationIterator BASE_EMBEDDED {
     ASSERT(index >= 0 && index < buffer->length());
   }
 
-  int32_t Next();
+  int32_t Next() {
+    // Most operands are register codes, slot indices or small literal ids
+    // that fit in a single byte; decode those without looping.
+    ASSERT(HasNext());
+    uint8_t first = buffer_->get(index_);
+    if ((first & 1) != 0) return NextMultiByte();
+    index_++;
+    int32_t result = first >> 2;
+    return (first & 2) != 0 ? -result : result;
+  }
 
   bool HasNext() const { return index_ < buffer_->length(); }
 
+  // Skips n values without decoding them.
   void Skip(int n) {
-    for (int i = 0; i < n; i++) Next();
+    for (int i = 0; i < n; i++) {
+      ASSERT(HasNext());
+      while ((buffer_->get(index_++) & 1) != 0) {
+        ASSERT(HasNext());
+      }
+    }
   }
 
  private:
+  int32_t NextMultiByte();
+
   ByteArray* buffer_;
   int index_;
 };
@@ -717,6 +795,7 @@ class TranslationIterator BASE_EMBEDDED {
   V(INT32_STACK_SLOT)                                                          \
   V(UINT32_STACK_SLOT)                                                         \
   V(DOUBLE_STACK_SLOT)                                                         \
+  V(STACK_HANDLER_SLOT)                                                        \
   V(LITERAL)
 
 
@@ -759,6 +838,7 @@ class Translation BASE_EMBEDDED {
   void StoreInt32StackSlot(int index);
   void StoreUint32StackSlot(int index);
   void StoreDoubleStackSlot(int index);
+  void StoreStackHandlerSlot(int slot, int handler_index);
   void StoreLiteral(int literal_id);
   void StoreArgumentsObject(bool args_known, int args_index, int args_length);
 
@@ -37,6 +37,7 @@
 #include "double.h"
 #include "fast-dtoa.h"
 #include "fixed-dtoa.h"
+#include "ryu-dtoa.h"
 
 namespace v8 {
 namespace internal {
@@ -82,8 +83,10 @@ void DoubleToAscii(double v, DtoaMode mode, int requested_digits,
   bool fast_worked;
   switch (mode) {
     case DTOA_SHORTEST:
-      fast_worked = FastDtoa(v, FAST_DTOA_SHORTEST, 0, buffer, length, point);
-      break;
+      // Ryu always computes the shortest representation, so there is no
+      // need for the bignum fallback.
+      RyuDtoa(v, buffer, length, point);
+      return;
     case DTOA_FIXED:
       fast_worked = FastFixedDtoa(v, requested_digits, buffer, length, point);
       break;
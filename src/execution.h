@@ -174,8 +174,6 @@ class Execution : public AllStatic {
                                                   Handle<Object> object,
                                                   bool* has_pending_exception);
 
-  static void RunMicrotasks(Isolate* isolate);
-  static void EnqueueMicrotask(Isolate* isolate, Handle<Object> microtask);
 };
 
 
@@ -144,6 +144,16 @@ Handle<ObjectHashTable> Factory::NewObjectHashTable(
 }
 
 
+Handle<OrderedHashSet> Factory::NewOrderedHashSet() {
+  return OrderedHashSet::Allocate(isolate(), OrderedHashSet::kMinCapacity);
+}
+
+
+Handle<OrderedHashMap> Factory::NewOrderedHashMap() {
+  return OrderedHashMap::Allocate(isolate(), OrderedHashMap::kMinCapacity);
+}
+
+
 Handle<WeakHashTable> Factory::NewWeakHashTable(int at_least_space_for) {
   ASSERT(0 <= at_least_space_for);
   CALL_HEAP_FUNCTION(
@@ -707,6 +717,7 @@ Handle<Script> Factory::NewScript(Handle<String> source) {
   script->set_eval_from_shared(heap->undefined_value());
   script->set_eval_from_instructions_offset(Smi::FromInt(0));
   script->set_flags(Smi::FromInt(0));
+  script->set_lazy_function_data(heap->undefined_value());
 
   return script;
 }
@@ -978,7 +989,7 @@ Handle<JSFunction> Factory::NewFunctionFromSharedFunctionInfo(
       !function_info->is_toplevel() &&
       function_info->allows_lazy_compilation() &&
       !function_info->optimization_disabled() &&
-      !isolate()->DebuggerHasBreakPoints()) {
+      !isolate()->DebuggerPreventsOptimization(*function_info)) {
     result->MarkForOptimization();
   }
   return result;
@@ -1402,6 +1413,68 @@ Handle<JSObject> Factory::NewJSObjectFromMap(Handle<Map> map,
 }
 
 
+// Returns the map reached from |map| by adding |key| as a plain in-object
+// field that can hold |value|, or NULL if there is no such transition yet.
+static Map* InobjectFieldTransition(Map* map, Name* key, Object* value) {
+  if (!map->HasTransitionArray()) return NULL;
+  TransitionArray* transitions = map->transitions();
+  int transition = transitions->Search(key);
+  if (transition == TransitionArray::kNotFound) return NULL;
+  Map* target = transitions->GetTarget(transition);
+  if (target->is_deprecated()) return NULL;
+  PropertyDetails details = target->GetLastDescriptorDetails();
+  if (details.type() != FIELD || details.attributes() != NONE) return NULL;
+  if (!value->FitsRepresentation(details.representation())) return NULL;
+  int field_index =
+      target->instance_descriptors()->GetFieldIndex(target->LastAdded());
+  if (field_index >= target->inobject_properties()) return NULL;
+  return target;
+}
+
+
+Handle<JSObject> Factory::NewJSObjectWithProperties(
+    Handle<FixedArray> keys,
+    Handle<FixedArray> values) {
+  ASSERT(keys->length() == values->length());
+  int length = keys->length();
+  Handle<Context> native_context(isolate()->context()->native_context());
+  Handle<Map> map = ObjectLiteralMapFromCache(native_context, keys);
+  ASSERT(map->NumberOfOwnDescriptors() == 0);
+
+  Map* target = *map;
+  for (int i = 0; i < length && target != NULL; i++) {
+    target = InobjectFieldTransition(
+        target, Name::cast(keys->get(i)), values->get(i));
+  }
+
+  if (target != NULL) {
+    Handle<JSObject> object = NewJSObjectFromMap(Handle<Map>(target));
+    for (int i = 0; i < length; i++) {
+      Handle<Object> value(values->get(i), isolate());
+      if (object->map()->instance_descriptors()->GetDetails(i).
+              representation().IsDouble()) {
+        value = NewHeapNumber(value->Number());
+      }
+      int field_index = object->map()->instance_descriptors()->GetFieldIndex(i);
+      object->FastPropertyAtPut(field_index, *value);
+    }
+    return object;
+  }
+
+  // Take the regular path, which also creates the missing transitions.
+  Handle<JSObject> object = NewJSObjectFromMap(map);
+  for (int i = 0; i < length; i++) {
+    Handle<Name> key(Name::cast(keys->get(i)), isolate());
+    Handle<Object> value(values->get(i), isolate());
+    RETURN_IF_EMPTY_HANDLE_VALUE(
+        isolate(),
+        JSObject::SetLocalPropertyIgnoreAttributes(object, key, value, NONE),
+        Handle<JSObject>());
+  }
+  return object;
+}
+
+
 Handle<JSArray> Factory::NewJSArray(int capacity,
                                     ElementsKind elements_kind,
                                     PretenureFlag pretenure) {
@@ -1909,6 +1982,26 @@ Handle<MapCache> Factory::AddToMapCache(Handle<Context> context,
 }
 
 
+// Bounds the walk over the transition tree of an object literal map.
+static const int kMaxLiteralTransitionsVisited = 32;
+
+
+// Returns true if some map reachable through the transition tree of |map|
+// stores fields outside of the object. At most |*budget| maps are visited.
+static bool HasOutOfObjectFieldTransition(Map* map, int* budget) {
+  if (--*budget < 0) return false;
+  if (map->NumberOfFields() > map->inobject_properties()) return true;
+  if (!map->HasTransitionArray()) return false;
+  TransitionArray* transitions = map->transitions();
+  for (int i = 0; i < transitions->number_of_transitions(); i++) {
+    if (HasOutOfObjectFieldTransition(transitions->GetTarget(i), budget)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
 Handle<Map> Factory::ObjectLiteralMapFromCache(Handle<Context> context,
                                                Handle<FixedArray> keys) {
   if (context->map_cache()->IsUndefined()) {
@@ -1920,7 +2013,23 @@ Handle<Map> Factory::ObjectLiteralMapFromCache(Handle<Context> context,
   Handle<MapCache> cache =
       Handle<MapCache>(MapCache::cast(context->map_cache()));
   Handle<Object> result = Handle<Object>(cache->Lookup(*keys), isolate());
-  if (result->IsMap()) return Handle<Map>::cast(result);
+  if (result->IsMap()) {
+    Handle<Map> cached = Handle<Map>::cast(result);
+    if (!FLAG_literal_slack_tracking ||
+        cached->inobject_properties() != keys->length()) {
+      return cached;
+    }
+    // Instances of literals sharing this map have been extended with fields
+    // that had to go to the out-of-object backing store. Give boilerplates
+    // created from now on some in-object slack instead.
+    int budget = kMaxLiteralTransitionsVisited;
+    if (!HasOutOfObjectFieldTransition(*cached, &budget)) return cached;
+    Handle<Map> map =
+        CopyMap(Handle<Map>(context->object_function()->initial_map()),
+                keys->length() + JSObject::kLiteralSlackProperties);
+    AddToMapCache(context, keys, map);
+    return map;
+  }
   // Create a new map and add it to the cache.
   Handle<Map> map =
       CopyMap(Handle<Map>(context->object_function()->initial_map()),
@@ -1965,6 +2074,21 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
 }
 
 
+void Factory::SetRegExpLinearData(Handle<JSRegExp> regexp,
+                                  Handle<String> source,
+                                  JSRegExp::Flags flags,
+                                  Handle<ByteArray> program,
+                                  int capture_count) {
+  Handle<FixedArray> store = NewFixedArray(JSRegExp::kLinearDataSize);
+  store->set(JSRegExp::kTagIndex, Smi::FromInt(JSRegExp::LINEAR));
+  store->set(JSRegExp::kSourceIndex, *source);
+  store->set(JSRegExp::kFlagsIndex, Smi::FromInt(flags.value()));
+  store->set(JSRegExp::kLinearProgramIndex, *program);
+  store->set(JSRegExp::kLinearCaptureCountIndex, Smi::FromInt(capture_count));
+  regexp->set_data(*store);
+}
+
+
 
 void Factory::ConfigureInstance(Handle<FunctionTemplateInfo> desc,
                                 Handle<JSObject> instance,
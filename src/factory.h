@@ -78,6 +78,9 @@ class Factory {
       int at_least_space_for,
       MinimumCapacity capacity_option = USE_DEFAULT_MINIMUM_CAPACITY);
 
+  Handle<OrderedHashSet> NewOrderedHashSet();
+  Handle<OrderedHashMap> NewOrderedHashMap();
+
   Handle<WeakHashTable> NewWeakHashTable(int at_least_space_for);
 
   Handle<DescriptorArray> NewDescriptorArray(int number_of_descriptors,
@@ -333,6 +336,14 @@ class Factory {
                                       PretenureFlag pretenure = NOT_TENURED,
                                       bool allocate_properties = true);
 
+  // Allocates a plain object with the given own properties, added in order.
+  // Keys must be internalized strings that are not array indices. Objects
+  // with the same sequence of keys share the map cache entry used by object
+  // literals, and when the transitions for the keys already exist the object
+  // is allocated with its final map directly.
+  Handle<JSObject> NewJSObjectWithProperties(Handle<FixedArray> keys,
+                                             Handle<FixedArray> values);
+
   Handle<JSObject> NewJSObjectFromMapForDeoptimizer(
       Handle<Map> map, PretenureFlag pretenure = NOT_TENURED);
 
@@ -563,6 +574,14 @@ class Factory {
                              JSRegExp::Flags flags,
                              int capture_count);
 
+  // Creates a new FixedArray that holds the data associated with the
+  // linear regexp and stores it in the regexp.
+  void SetRegExpLinearData(Handle<JSRegExp> regexp,
+                           Handle<String> source,
+                           JSRegExp::Flags flags,
+                           Handle<ByteArray> program,
+                           int capture_count);
+
   // Returns the value for a known global constant (a property of the global
   // object which is neither configurable nor writable) like 'undefined'.
   // Returns a null handle when the given name is unknown.
@@ -144,6 +144,13 @@ struct MaybeBoolFlag {
 # define ENABLE_32DREGS_DEFAULT false
 #endif
 
+// Only the x64 Lithium backend implements optimized try/catch.
+#if V8_TARGET_ARCH_X64
+# define OPTIMIZE_TRY_CATCH_DEFAULT true
+#else
+# define OPTIMIZE_TRY_CATCH_DEFAULT false
+#endif
+
 #define DEFINE_bool(nam, def, cmt)   FLAG(BOOL, bool, nam, def, cmt)
 #define DEFINE_maybe_bool(nam, cmt)  FLAG(MAYBE_BOOL, MaybeBoolFlag, nam,  \
                                           { false COMMA false }, cmt)
@@ -186,6 +193,8 @@ DEFINE_bool(harmony_numeric_literals, false,
 DEFINE_bool(harmony_strings, false, "enable harmony string")
 DEFINE_bool(harmony_arrays, false, "enable harmony arrays")
 DEFINE_bool(harmony_maths, false, "enable harmony math functions")
+DEFINE_bool(harmony_atomics, false,
+            "enable harmony atomics on shared typed arrays")
 DEFINE_bool(harmony, false, "enable all harmony features (except typeof)")
 DEFINE_implication(harmony, es_staging)
 DEFINE_implication(harmony, harmony_scoping)
@@ -200,6 +209,7 @@ DEFINE_implication(harmony, harmony_numeric_literals)
 DEFINE_implication(harmony, harmony_strings)
 DEFINE_implication(harmony, harmony_arrays)
 DEFINE_implication(harmony, harmony_maths)
+DEFINE_implication(harmony, harmony_atomics)
 DEFINE_implication(harmony_promises, harmony_collections)
 DEFINE_implication(harmony_modules, harmony_scoping)
 
@@ -216,6 +226,9 @@ DEFINE_bool(pretenuring, true, "allocate objects in old space")
 DEFINE_bool(pretenuring_call_new, false, "pretenure call new")
 DEFINE_bool(allocation_site_pretenuring, true,
             "pretenure with allocation sites")
+DEFINE_int(allocation_site_pretenuring_decay, 0,
+           "number of gcs after which tenured allocation sites are "
+           "re-sampled (0 means tenure decisions are never undone)")
 DEFINE_bool(trace_pretenuring, false,
             "trace pretenuring decisions of HAllocate instructions")
 DEFINE_bool(trace_pretenuring_statistics, false,
@@ -247,6 +260,11 @@ DEFINE_int(gvn_iterations, 3, "maximum number of GVN fix-point iterations")
 DEFINE_bool(use_canonicalizing, true, "use hydrogen instruction canonicalizing")
 DEFINE_bool(use_inlining, true, "use function inlining")
 DEFINE_bool(use_escape_analysis, true, "use hydrogen escape analysis")
+DEFINE_bool(hydrogen_loop_peeling, false,
+            "peel the first iteration of while and for loops")
+DEFINE_int(hydrogen_loop_peeling_max_size, 500,
+           "maximum number of hydrogen values created for peeled loop "
+           "iterations per function")
 DEFINE_bool(use_allocation_folding, true, "use allocation folding")
 DEFINE_bool(use_local_allocation_folding, false, "only fold in basic blocks")
 DEFINE_bool(use_write_barrier_elimination, true,
@@ -258,6 +276,9 @@ DEFINE_int(max_inlined_nodes, 196,
            "maximum number of AST nodes considered for a single inlining")
 DEFINE_int(max_inlined_nodes_cumulative, 400,
            "maximum cumulative number of AST nodes considered for inlining")
+DEFINE_int(inlining_loop_depth_bonus, 2,
+           "number of loop levels for which call sites get an additional "
+           "multiple of the inlining budgets")
 DEFINE_bool(loop_invariant_code_motion, true, "loop invariant code motion")
 DEFINE_bool(fast_math, true, "faster (but maybe less accurate) math functions")
 DEFINE_bool(collect_megamorphic_maps_from_stub_cache, true,
@@ -318,15 +339,23 @@ DEFINE_bool(lookup_sample_by_shared, true,
 DEFINE_bool(cache_optimized_code, true,
             "cache optimized code for closures")
 DEFINE_bool(flush_optimized_code_cache, true,
-            "flushes the cache of optimized code for closures on every GC")
+            "flushes the cache of optimized code for closures once it has "
+            "been unused for optimized_code_map_max_age GCs")
+DEFINE_int(optimized_code_map_max_age, 0,
+           "number of GCs an unused cache of optimized code for closures "
+           "survives (0 flushes it on every GC)")
 DEFINE_bool(inline_construct, true, "inline constructor calls")
 DEFINE_bool(inline_arguments, true, "inline functions with arguments object")
 DEFINE_bool(inline_accessors, true, "inline JavaScript accessors")
+DEFINE_bool(inline_typed_array_accessors, true,
+            "inline typed array length and DataView accessors")
 DEFINE_int(escape_analysis_iterations, 2,
            "maximum number of escape analysis fix-point iterations")
 
 DEFINE_bool(optimize_for_in, true,
             "optimize functions containing for-in loops")
+DEFINE_bool(optimize_try_catch, OPTIMIZE_TRY_CATCH_DEFAULT,
+            "optimize functions containing try/catch statements")
 DEFINE_bool(opt_safe_uint32_operations, true,
             "allow uint32 values on optimize frames if they are used only in "
             "safe operations")
@@ -337,11 +366,13 @@ DEFINE_bool(trace_concurrent_recompilation, false,
             "track concurrent recompilation")
 DEFINE_int(concurrent_recompilation_queue_length, 8,
            "the length of the concurrent compilation queue")
+DEFINE_int(concurrent_recompilation_threads, 1,
+           "the number of threads used for concurrent recompilation")
 DEFINE_int(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_bool(block_concurrent_recompilation, false,
             "block queued jobs until released")
-DEFINE_bool(concurrent_osr, false,
+DEFINE_bool(concurrent_osr, true,
             "concurrent on-stack replacement")
 DEFINE_implication(concurrent_osr, concurrent_recompilation)
 
@@ -354,6 +385,14 @@ DEFINE_int(frame_count, 1, "number of stack frames inspected by the profiler")
            // 0x1800 fits in the immediate field of an ARM instruction.
 DEFINE_int(interrupt_budget, 0x1800,
            "execution budget before interrupt is triggered")
+DEFINE_int(compile_budget_per_tick, 2000,
+           "AST nodes the profiler may send to the optimizer per tick "
+           "(0 for no limit)")
+DEFINE_int(compile_budget_max, 20000,
+           "maximum AST nodes the profiler's compile budget can accumulate")
+DEFINE_bool(optimize_if_optimized_in_other_context, true,
+            "optimize functions right away that already have optimized code "
+            "for another native context")
 DEFINE_int(type_info_threshold, 25,
            "percentage of ICs that must have type info to allow optimization")
 DEFINE_int(self_opt_count, 130, "call count before self-optimization")
@@ -371,6 +410,13 @@ DEFINE_bool(enable_sse3, true,
             "enable use of SSE3 instructions if available")
 DEFINE_bool(enable_sse4_1, true,
             "enable use of SSE4.1 instructions if available")
+DEFINE_bool(enable_avx, true,
+            "enable use of AVX instructions if available (X64 only)")
+DEFINE_bool(enable_popcnt, true,
+            "enable use of POPCNT and LZCNT instructions if available "
+            "(X64 only)")
+DEFINE_bool(enable_bmi, true,
+            "enable use of BMI1 and BMI2 instructions if available (X64 only)")
 DEFINE_bool(enable_cmov, true,
             "enable use of CMOV instruction if available")
 DEFINE_bool(enable_sahf, true,
@@ -390,6 +436,9 @@ DEFINE_bool(enable_unaligned_accesses, true,
             "enable unaligned accesses for ARMv7 (ARM only)")
 DEFINE_bool(enable_32dregs, ENABLE_32DREGS_DEFAULT,
             "enable use of d16-d31 registers on ARM - this requires VFP3")
+DEFINE_bool(enable_embedded_constant_pool, false,
+            "load embedded heap objects from a per-code constant pool "
+            "instead of 64-bit immediates (X64 only)")
 DEFINE_bool(enable_vldr_imm, false,
             "enable use of constant pools for double immediate (ARM only)")
 DEFINE_bool(force_long_branches, false,
@@ -423,6 +472,15 @@ DEFINE_bool(mask_constants_with_cookie, true,
 
 // codegen.cc
 DEFINE_bool(lazy, true, "use lazy compilation")
+DEFINE_bool(lazy_inner_functions, false,
+            "preparse inner functions when compiling a function lazily")
+DEFINE_bool(cache_lazy_function_data, false,
+            "keep the preparse results of skipped inner functions on the "
+            "script and reuse them when the outer function is reparsed")
+DEFINE_implication(cache_lazy_function_data, lazy_inner_functions)
+DEFINE_bool(compile_hot_functions_eagerly, true,
+            "eagerly compile top-level functions that preparse data "
+            "predicts to be called while the script is loaded")
 DEFINE_bool(trace_opt, false, "trace lazy optimization")
 DEFINE_bool(trace_opt_stats, false, "trace lazy optimization statistics")
 DEFINE_bool(opt, true, "use adaptive optimizations")
@@ -443,12 +501,32 @@ DEFINE_int(max_opt_count, 10,
 
 // compilation-cache.cc
 DEFINE_bool(compilation_cache, true, "enable compilation cache")
+DEFINE_int(regexp_cache_size, 0,
+           "number of recently used regexps kept compiled across "
+           "garbage collections")
+DEFINE_int(script_cache_budget, 0,
+           "total source size (in KB) of recently used scripts whose "
+           "compiled code is kept across garbage collections and shared "
+           "between contexts")
+DEFINE_int(eval_cache_budget, 0,
+           "total source size (in KB) of recently used global eval and "
+           "Function constructor sources whose compiled code is kept "
+           "across garbage collections")
 
 DEFINE_bool(cache_prototype_transitions, true, "cache prototype transitions")
 
 // cpu-profiler.cc
 DEFINE_int(cpu_profiler_sampling_interval, 1000,
            "CPU profiler sampling interval in microseconds")
+DEFINE_int(cpu_profiler_max_samples, 0,
+           "maximum number of samples a CPU profile keeps, older samples are "
+           "discarded (0 means unlimited)")
+
+// sampler.cc
+DEFINE_bool(perf_event_sampler, false,
+            "on Linux, let the kernel signal the profiled thread from a "
+            "perf_event task clock instead of sending signals from the "
+            "sampler thread")
 
 // debug.cc
 DEFINE_bool(trace_debug_json, false, "trace debugging JSON request/response")
@@ -464,6 +542,9 @@ DEFINE_bool(debugger_auto_break, true,
             "automatically set the debug break flag when debugger commands are "
             "in the queue")
 DEFINE_bool(enable_liveedit, true, "enable liveedit experimental feature")
+DEFINE_bool(break_points_deoptimize_all, true,
+            "deoptimize all functions when setting a break point, rather than "
+            "only the functions containing break points")
 DEFINE_bool(hard_abort, true, "abort by crashing")
 
 // execution.cc
@@ -482,6 +563,9 @@ DEFINE_bool(always_inline_smi_code, false,
 
 // heap.cc
 DEFINE_int(max_new_space_size, 0, "max size of the new generation (in kBytes)")
+DEFINE_int(scavenge_pause_target, 0,
+           "resize the new generation so that scavenges take about this "
+           "long (in ms, 0 means grow the new generation on survival only)")
 DEFINE_int(max_old_space_size, 0, "max size of the old generation (in Mbytes)")
 DEFINE_int(max_executable_size, 0, "max size of executable memory (in Mbytes)")
 DEFINE_bool(gc_global, false, "always perform global GCs")
@@ -491,6 +575,15 @@ DEFINE_bool(trace_gc, false,
 DEFINE_bool(trace_gc_nvp, false,
             "print one detailed trace line in name=value format "
             "after each garbage collection")
+DEFINE_bool(free_list_size_classes, true,
+            "segregate huge free list blocks into size classes")
+DEFINE_bool(store_buffer_card_marking, true,
+            "remember overflowing store buffer entries of large objects "
+            "in per-page card tables instead of rescanning the whole page")
+DEFINE_bool(sort_store_buffer_for_scavenge, true,
+            "visit store buffer entries in address order during scavenges")
+DEFINE_bool(memory_reducer, false,
+            "release unused memory at the end of an idle round")
 DEFINE_bool(trace_gc_ignore_scavenger, false,
             "do not print trace line after scavenger collection")
 DEFINE_bool(print_cumulative_gc_stat, false,
@@ -505,6 +598,16 @@ DEFINE_bool(trace_fragmentation, false,
 DEFINE_bool(trace_external_memory, false,
             "print amount of external allocated memory after each time "
             "it is adjusted.")
+DEFINE_bool(array_buffer_pool, false,
+            "recycle the backing stores of small array buffers")
+DEFINE_int(array_buffer_pool_size, 1024,
+           "maximum size of the array buffer backing stores kept for reuse "
+           "(in kBytes)")
+DEFINE_bool(trace_array_buffer_pool, false,
+            "print array buffer pool statistics on exit")
+DEFINE_int(large_object_chunk_pool_size, 8,
+           "maximum size of the freed large object chunks kept mapped for "
+           "reuse (in Mbytes)")
 DEFINE_bool(collect_maps, true,
             "garbage collect maps from which no objects can be reached")
 DEFINE_bool(weak_embedded_maps_in_optimized_code, true,
@@ -519,10 +622,28 @@ DEFINE_bool(trace_code_flushing, false, "trace code flushing progress")
 DEFINE_bool(age_code, true,
             "track un-executed functions to age code and flush only "
             "old code (required for code flushing)")
+DEFINE_bool(adaptive_code_flushing, false,
+            "flush code at an age that depends on the code space size and "
+            "on how often the function was flushed before")
+DEFINE_int(code_flushing_pressure_size, 16,
+           "code space size (in MB) from which code is flushed as soon as "
+           "it is old (adaptive code flushing)")
+DEFINE_int(code_flushing_pin_threshold, 4,
+           "number of flushes after which the code of a function is never "
+           "flushed again (adaptive code flushing, 0 = never pin)")
+DEFINE_bool(code_range_huge_pages, false,
+            "back the code range with transparent huge pages where the OS "
+            "supports them (code pages in the range lose their guard pages)")
 DEFINE_bool(incremental_marking, true, "use incremental marking")
 DEFINE_bool(incremental_marking_steps, true, "do incremental marking steps")
+DEFINE_bool(scavenge_promote_in_high_promotion_mode, true,
+            "promote all survivors of a scavenge while the new space is in "
+            "high promotion mode")
 DEFINE_bool(trace_incremental_marking, false,
             "trace progress of the incremental marking")
+DEFINE_int(max_incremental_marking_step_time, 0,
+           "upper bound in ms for the duration of an incremental marking "
+           "step triggered by allocation (0 means unbounded)")
 DEFINE_bool(track_gc_object_stats, false,
             "track object counts and memory usage")
 DEFINE_bool(parallel_sweeping, true, "enable parallel sweeping")
@@ -530,21 +651,49 @@ DEFINE_bool(concurrent_sweeping, false, "enable concurrent sweeping")
 DEFINE_int(sweeper_threads, 0,
            "number of parallel and concurrent sweeping threads")
 DEFINE_bool(job_based_sweeping, false, "enable job based sweeping")
+DEFINE_int(background_task_queue_depth, 0,
+           "maximum number of pending background tasks, 0 for no limit")
+DEFINE_bool(concurrent_external_string_disposal, false,
+            "dispose of the resources of dead external strings on a "
+            "background thread after garbage collection")
+DEFINE_bool(parallel_pointer_update, false,
+            "update roots and pointers to evacuated pages in parallel "
+            "using background tasks")
 #ifdef VERIFY_HEAP
 DEFINE_bool(verify_heap, false, "verify heap pointers before and after GC")
 #endif
+// Also defined without heap verification, so that test runners can pass it
+// to every build.
+DEFINE_int(verify_heap_sample, 0,
+           "with --verify-heap, verify the objects on only every n-th page "
+           "of the paged and large object spaces, rotating the sample with "
+           "every GC (0 verifies all pages)")
 
 
 // heap-snapshot-generator.cc
 DEFINE_bool(heap_profiler_trace_objects, false,
             "Dump heap object allocations/movements/size_updates")
 
+// allocation-tracker.cc
+DEFINE_int(heap_profiler_sampling_interval, 0,
+           "record the stack of one allocation per this many bytes on "
+           "average when tracking heap allocations (0 records all)")
+
 
 // v8.cc
 DEFINE_bool(use_idle_notification, true,
             "Use idle notification to reduce memory footprint.")
+DEFINE_bool(use_idle_tasks, true,
+            "Post pending gc work as idle tasks to the platform.")
 // ic.cc
 DEFINE_bool(use_ic, true, "use inline caching")
+DEFINE_int(stable_dictionary_load_misses, 8,
+           "turn objects in dictionary mode back into fast mode after this "
+           "many named load misses without a property being added or "
+           "deleted (0 disables)")
+DEFINE_bool(ic_stats, false,
+            "collect per-site inline cache transition statistics and print "
+            "them on exit")
 
 // macro-assembler-ia32.cc
 DEFINE_bool(native_code_counters, false,
@@ -560,6 +709,9 @@ DEFINE_bool(compact_code_space, true,
             "Compact code space on full non-incremental collections")
 DEFINE_bool(incremental_code_compaction, true,
             "Compact code space on full incremental collections")
+DEFINE_bool(segregate_optimized_code, false,
+            "allocate optimized code from its own allocation area in code "
+            "space and keep it together when compacting code space")
 DEFINE_bool(cleanup_code_caches_at_gc, true,
             "Flush inline caches prior to mark compact collection and "
             "flush code caches in maps during mark compact cycle.")
@@ -604,6 +756,11 @@ DEFINE_bool(ignore_asm_unimplemented_break, false,
 DEFINE_bool(trace_sim_messages, false,
             "Trace simulator debug messages. Implied by --trace-sim.")
 
+// factory.cc
+DEFINE_bool(literal_slack_tracking, true,
+            "give object literal maps in-object slack once their instances "
+            "have been seen to grow")
+
 // isolate.cc
 DEFINE_bool(stack_trace_on_illegal, false,
             "print stack trace when an illegal exception is thrown")
@@ -620,8 +777,23 @@ DEFINE_int(hash_seed, 0,
 DEFINE_bool(profile_deserialization, false,
             "Print the time it takes to deserialize the snapshot.")
 
+// zone.cc
+DEFINE_int(zone_segment_pool_size, 16,
+           "maximum size (in MB) of freed zone segments kept for reuse "
+           "by later zones (0 = disabled)")
+
 // Regexp
 DEFINE_bool(regexp_optimization, true, "generate optimized regexp code")
+DEFINE_int(regexp_backtrack_limit, 0,
+            "maximum number of backtracks per regexp match (0 = unlimited); "
+            "when exceeded the match is redone by the linear-time matcher "
+            "or throws")
+DEFINE_bool(regexp_profile, false,
+            "collect per-pattern regexp execution statistics and print "
+            "them on exit")
+DEFINE_bool(regexp_linear, false,
+            "match regexps without back references or lookaheads "
+            "in linear time")
 
 // Testing flags test/cctest/test-{flags,api,serialization}.cc
 DEFINE_bool(testing_bool_flag, true, "testing_bool_flag")
@@ -640,7 +812,8 @@ DEFINE_string(testing_serialization_file, "/tmp/serdes",
 
 // mksnapshot.cc
 DEFINE_string(extra_code, NULL, "A filename with extra code to be included in"
-                  " the snapshot (mksnapshot only)")
+                  " the snapshot, or a comma separated list of filenames"
+                  " run in order (mksnapshot only)")
 
 // code-stubs-hydrogen.cc
 DEFINE_bool(profile_hydrogen_code_stub_compilation, false,
@@ -694,6 +867,9 @@ DEFINE_string(gdbjit_dump_filter, "",
               "dump only objects containing this substring")
 
 // mark-compact.cc
+DEFINE_bool(grow_marking_deque, true,
+            "grow the marking deque of full collections on overflow instead "
+            "of repeatedly rescanning the heap")
 DEFINE_bool(force_marking_deque_overflows, false,
             "force overflows of marking deque by reducing it's size "
             "to 64 words")
@@ -798,13 +974,16 @@ DEFINE_bool(prof, false,
 DEFINE_bool(prof_browser_mode, true,
             "Used with --prof, turns on browser-compatible mode for profiling.")
 DEFINE_bool(log_regexp, false, "Log regular expression execution.")
+DEFINE_bool(runtime_call_stats, false,
+            "Report call counts and times of runtime functions and builtins "
+            "when the isolate is torn down.")
 DEFINE_string(logfile, "v8.log", "Specify the name of the log file.")
 DEFINE_bool(logfile_per_isolate, true, "Separate log files for each isolate.")
 DEFINE_bool(ll_prof, false, "Enable low-level linux profiler.")
 DEFINE_bool(perf_basic_prof, false,
             "Enable perf linux profiler (basic support).")
 DEFINE_bool(perf_jit_prof, false,
-            "Enable perf linux profiler (experimental annotate support).")
+            "Enable perf linux profiler (jitdump support for perf inject).")
 DEFINE_string(gc_fake_mmap, "/tmp/__v8_gc__",
               "Specify the name of the file for fake gc mmap used in ll_prof")
 DEFINE_bool(log_internal_timer_events, false, "Time internal events.")
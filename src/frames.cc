@@ -676,7 +676,16 @@ void StandardFrame::IterateCompiledFrame(ObjectVisitor* v) const {
   uint8_t* safepoint_bits = safepoint_entry.bits();
   safepoint_bits += kNumSafepointRegisters >> kBitsPerByteLog2;
 
-  // Visit the rest of the parameters.
+  // Visit the rest of the parameters, skipping the handlers pushed by
+  // optimized try blocks.
+  for (StackHandlerIterator it(this, top_handler()); !it.done(); it.Advance()) {
+    StackHandler* handler = it.handler();
+    const Address address = handler->address();
+    v->VisitPointers(parameters_base, reinterpret_cast<Object**>(address));
+    parameters_base =
+        reinterpret_cast<Object**>(address + StackHandlerConstants::kSize);
+    handler->Iterate(v, code);
+  }
   v->VisitPointers(parameters_base, parameters_limit);
 
   // Visit pointer spill slots and locals.
@@ -721,12 +730,6 @@ int StubFrame::GetNumberOfIncomingArguments() const {
 
 
 void OptimizedFrame::Iterate(ObjectVisitor* v) const {
-#ifdef DEBUG
-  // Make sure that optimized frames do not contain any stack handlers.
-  StackHandlerIterator it(this, top_handler());
-  ASSERT(it.done());
-#endif
-
   IterateCompiledFrame(v);
 }
 
@@ -352,6 +352,11 @@ bool FullCodeGenerator::MakeCode(CompilationInfo* info) {
 #endif  // ENABLE_DEBUGGER_SUPPORT
   code->set_allow_osr_at_loop_nesting_level(0);
   code->set_profiler_ticks(0);
+  // Code in the snapshot counts as created at isolate initialization.
+  if (!Serializer::enabled()) {
+    code->set_creation_time(
+        static_cast<int>(isolate->time_millis_since_init()));
+  }
   code->set_back_edge_table_offset(table_offset);
   code->set_back_edges_patched_for_osr(false);
   CodeGenerator::PrintCode(code, info);
@@ -1424,6 +1429,8 @@ void FullCodeGenerator::VisitTryCatchStatement(TryCatchStatement* stmt) {
   __ jmp(&try_entry);
   __ bind(&handler_entry);
   handler_table()->set(stmt->index(), Smi::FromInt(handler_entry.pos()));
+  // Optimized code that catches the exception deoptimizes to this point.
+  PrepareForBailoutForId(stmt->HandlerId(), TOS_REG);
   // Exception handler code, the exception is in the result register.
   // Extend the context before executing the catch block.
   { Comment cmnt(masm_, "[ Extend catch context");
@@ -1450,11 +1457,13 @@ void FullCodeGenerator::VisitTryCatchStatement(TryCatchStatement* stmt) {
   // Try block code. Sets up the exception handler chain.
   __ bind(&try_entry);
   __ PushTryHandler(StackHandler::CATCH, stmt->index());
+  PrepareForBailoutForId(stmt->BodyId(), NO_REGISTERS);
   { TryCatch try_body(this);
     Visit(stmt->try_block());
   }
   __ PopTryHandler();
   __ bind(&exit);
+  PrepareForBailoutForId(stmt->ExitId(), NO_REGISTERS);
 }
 
 
@@ -89,6 +89,7 @@ class GlobalHandles::Node {
     set_independent(false);
     set_partially_dependent(false);
     set_in_new_space_list(false);
+    set_phantom(false);
     parameter_or_next_free_.next_free = NULL;
     weak_callback_ = NULL;
   }
@@ -109,6 +110,7 @@ class GlobalHandles::Node {
     class_id_ = v8::HeapProfiler::kPersistentHandleNoClassId;
     set_independent(false);
     set_partially_dependent(false);
+    set_phantom(false);
     set_state(NORMAL);
     parameter_or_next_free_.parameter = NULL;
     weak_callback_ = NULL;
@@ -123,6 +125,7 @@ class GlobalHandles::Node {
     class_id_ = v8::HeapProfiler::kPersistentHandleNoClassId;
     set_independent(false);
     set_partially_dependent(false);
+    set_phantom(false);
     weak_callback_ = NULL;
     DecreaseBlockUses();
   }
@@ -169,6 +172,13 @@ class GlobalHandles::Node {
     flags_ = IsInNewSpaceList::update(flags_, v);
   }
 
+  bool is_phantom() {
+    return IsPhantom::decode(flags_);
+  }
+  void set_phantom(bool v) {
+    flags_ = IsPhantom::update(flags_, v);
+  }
+
   bool IsNearDeath() const {
     // Check for PENDING to ensure correct answer when processing callbacks.
     return state() == PENDING || state() == NEAR_DEATH;
@@ -187,6 +197,9 @@ class GlobalHandles::Node {
   void MarkPending() {
     ASSERT(state() == WEAK);
     set_state(PENDING);
+    // Phantom handles cannot resurrect their object, so clear the slot
+    // right away instead of keeping the object alive for the callback.
+    if (is_phantom()) object_ = Smi::FromInt(0);
   }
 
   // Independent flag accessors.
@@ -231,13 +244,24 @@ class GlobalHandles::Node {
     ASSERT(weak_callback != NULL);
     ASSERT(state() != FREE);
     set_state(WEAK);
+    set_phantom(false);
     set_parameter(parameter);
     weak_callback_ = weak_callback;
   }
 
+  void MakePhantom(void* parameter, PhantomCallback phantom_callback) {
+    ASSERT(phantom_callback != NULL);
+    ASSERT(state() != FREE);
+    set_state(WEAK);
+    set_phantom(true);
+    set_parameter(parameter);
+    weak_callback_ = reinterpret_cast<WeakCallback>(phantom_callback);
+  }
+
   void ClearWeakness() {
     ASSERT(state() != FREE);
     set_state(NORMAL);
+    set_phantom(false);
     set_parameter(NULL);
   }
 
@@ -247,6 +271,18 @@ class GlobalHandles::Node {
       Release();
       return false;
     }
+    if (is_phantom()) {
+      // The object is already gone. Queue the callback, which only gets
+      // the parameter, to run in a batch once all nodes are processed.
+      GetGlobalHandles()->pending_phantom_callbacks_.Add(
+          PendingPhantomCallback(
+              this,
+              reinterpret_cast<PhantomCallback>(weak_callback_),
+              parameter()));
+      set_state(NEAR_DEATH);
+      set_parameter(NULL);
+      return false;
+    }
     void* par = parameter();
     set_state(NEAR_DEATH);
     set_parameter(NULL);
@@ -295,12 +331,13 @@ class GlobalHandles::Node {
   // Index in the containing handle block.
   uint8_t index_;
 
-  // This stores three flags (independent, partially_dependent and
-  // in_new_space_list) and a State.
+  // This stores four flags (independent, partially_dependent,
+  // in_new_space_list and phantom) and a State.
   class NodeState:            public BitField<State, 0, 4> {};
   class IsIndependent:        public BitField<bool,  4, 1> {};
   class IsPartiallyDependent: public BitField<bool,  5, 1> {};
   class IsInNewSpaceList:     public BitField<bool,  6, 1> {};
+  class IsPhantom:            public BitField<bool,  7, 1> {};
 
   uint8_t flags_;
 
@@ -477,6 +514,13 @@ Handle<Object> GlobalHandles::Create(Object* value) {
   result->Acquire(value);
   if (isolate_->heap()->InNewSpace(value) &&
       !result->is_in_new_space_list()) {
+    // Before growing the list, drop the entries whose nodes were freed or
+    // reused for old space objects since the last GC. Weak callbacks create
+    // handles while the list is being walked, so leave it alone then.
+    if (new_space_nodes_.length() == new_space_nodes_.capacity() &&
+        !isolate_->heap()->IsInGCPostProcessing()) {
+      RemoveDeadNewSpaceNodes();
+    }
     new_space_nodes_.Add(result);
     result->set_in_new_space_list(true);
   }
@@ -484,6 +528,21 @@ Handle<Object> GlobalHandles::Create(Object* value) {
 }
 
 
+void GlobalHandles::RemoveDeadNewSpaceNodes() {
+  int last = 0;
+  for (int i = 0; i < new_space_nodes_.length(); ++i) {
+    Node* node = new_space_nodes_[i];
+    ASSERT(node->is_in_new_space_list());
+    if (node->IsRetainer() && isolate_->heap()->InNewSpace(node->object())) {
+      new_space_nodes_[last++] = node;
+    } else {
+      node->set_in_new_space_list(false);
+    }
+  }
+  new_space_nodes_.Rewind(last);
+}
+
+
 Handle<Object> GlobalHandles::CopyGlobal(Object** location) {
   ASSERT(location != NULL);
   return Node::FromLocation(location)->GetGlobalHandles()->Create(*location);
@@ -502,6 +561,13 @@ void GlobalHandles::MakeWeak(Object** location,
 }
 
 
+void GlobalHandles::MakePhantom(Object** location,
+                                void* parameter,
+                                PhantomCallback phantom_callback) {
+  Node::FromLocation(location)->MakePhantom(parameter, phantom_callback);
+}
+
+
 void GlobalHandles::ClearWeakness(Object** location) {
   Node::FromLocation(location)->ClearWeakness();
 }
@@ -706,10 +772,33 @@ bool GlobalHandles::PostGarbageCollectionProcessing(
     }
   }
   new_space_nodes_.Rewind(last);
+  if (DispatchPendingPhantomCallbacks()) {
+    next_gc_likely_to_collect_more = true;
+  }
   return next_gc_likely_to_collect_more;
 }
 
 
+bool GlobalHandles::DispatchPendingPhantomCallbacks() {
+  if (pending_phantom_callbacks_.is_empty()) return false;
+  // The callbacks may trigger another GC, which queues its own phantom
+  // callbacks, so detach the current batch first.
+  List<PendingPhantomCallback> callbacks(pending_phantom_callbacks_.length());
+  callbacks.AddAll(pending_phantom_callbacks_);
+  pending_phantom_callbacks_.Clear();
+  // Leaving V8.
+  VMState<EXTERNAL> state(isolate_);
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(isolate_);
+  for (int i = 0; i < callbacks.length(); i++) {
+    v8::PhantomCallbackData<void> data(isolate, callbacks[i].parameter);
+    callbacks[i].callback(data);
+    // As for weak handles, the callback has to reset the handle.
+    CHECK(callbacks[i].node->state() != Node::NEAR_DEATH);
+  }
+  return true;
+}
+
+
 void GlobalHandles::IterateStrongRoots(ObjectVisitor* v) {
   for (NodeIterator it(this); !it.done(); it.Advance()) {
     if (it.node()->IsStrongRetainer()) {
@@ -146,6 +146,18 @@ class GlobalHandles {
                        void* parameter,
                        WeakCallback weak_callback);
 
+  typedef PhantomCallbackData<void>::Callback PhantomCallback;
+
+  // Make the global handle a phantom handle. Unlike a weak handle, the
+  // object is not kept alive for the callback and cannot be resurrected:
+  // the handle is cleared by the garbage collector and the callback only
+  // receives the parameter. Phantom callbacks are run in one batch after
+  // all other weak handles have been processed, and each must destroy its
+  // handle.
+  static void MakePhantom(Object** location,
+                          void* parameter,
+                          PhantomCallback phantom_callback);
+
   void RecordStats(HeapStats* stats);
 
   // Returns the current number of weak handles.
@@ -160,6 +172,9 @@ class GlobalHandles {
     return number_of_global_handles_;
   }
 
+  // Returns the number of nodes on the list scanned by the scavenger.
+  int NumberOfNewSpaceNodes() { return new_space_nodes_.length(); }
+
   // Clear the weakness of a global handle.
   static void ClearWeakness(Object** location);
 
@@ -293,11 +308,30 @@ class GlobalHandles {
   // don't assign any initial capacity.
   static const int kObjectGroupConnectionsCapacity = 20;
 
+  // Removes nodes that are free or no longer point into new space from
+  // new_space_nodes_.
+  void RemoveDeadNewSpaceNodes();
+
+  // Runs the callbacks of phantom handles cleared by the last GC. Returns
+  // true if any callback was run.
+  bool DispatchPendingPhantomCallbacks();
+
   // Internal node structures.
   class Node;
   class NodeBlock;
   class NodeIterator;
 
+  struct PendingPhantomCallback {
+    PendingPhantomCallback() : node(NULL), callback(NULL), parameter(NULL) { }
+    PendingPhantomCallback(Node* node,
+                           PhantomCallback callback,
+                           void* parameter)
+        : node(node), callback(callback), parameter(parameter) { }
+    Node* node;
+    PhantomCallback callback;
+    void* parameter;
+  };
+
   Isolate* isolate_;
 
   // Field always containing the number of handles to global objects.
@@ -318,6 +352,9 @@ class GlobalHandles {
 
   int post_gc_processing_count_;
 
+  // Callbacks of phantom handles that died in the last GC.
+  List<PendingPhantomCallback> pending_phantom_callbacks_;
+
   // Object groups and implicit references, public and more efficient
   // representation.
   List<ObjectGroup*> object_groups_;
@@ -0,0 +1,88 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'use strict';
+
+// This file relies on the fact that the following declarations have been made
+// in runtime.js:
+// var $Object = global.Object;
+
+// Instance class name can only be set on functions. That is the only
+// purpose for AtomicsConstructor.
+function AtomicsConstructor() {}
+var $Atomics = new AtomicsConstructor();
+
+// -------------------------------------------------------------------
+
+// All operations take an Int32Array or Uint32Array and an element index,
+// and are sequentially consistent. They are meant for typed arrays over
+// ArrayBuffers that are shared with other isolates, but work on any
+// Int32Array or Uint32Array.
+
+function AtomicsLoad(array, index) {
+  return %AtomicsLoad(array, TO_INTEGER(index));
+}
+
+
+// Returns the stored value, converted to the element type.
+function AtomicsStore(array, index, value) {
+  return %AtomicsStore(array, TO_INTEGER(index), TO_NUMBER_INLINE(value));
+}
+
+
+// Returns the value the element had before the exchange was attempted.
+function AtomicsCompareExchange(array, index, expected, replacement) {
+  return %AtomicsCompareExchange(array, TO_INTEGER(index),
+                                 TO_NUMBER_INLINE(expected),
+                                 TO_NUMBER_INLINE(replacement));
+}
+
+
+// Returns the value the element had before the addition.
+function AtomicsAdd(array, index, value) {
+  return %AtomicsAdd(array, TO_INTEGER(index), TO_NUMBER_INLINE(value));
+}
+
+// -------------------------------------------------------------------
+
+function SetUpAtomics() {
+  %CheckIsBootstrapping();
+
+  %SetPrototype($Atomics, $Object.prototype);
+  %SetProperty(global, "Atomics", $Atomics, DONT_ENUM);
+  %FunctionSetInstanceClassName(AtomicsConstructor, 'Atomics');
+
+  InstallFunctions($Atomics, DONT_ENUM, $Array(
+    "load", AtomicsLoad,
+    "store", AtomicsStore,
+    "compareExchange", AtomicsCompareExchange,
+    "add", AtomicsAdd
+  ));
+}
+
+
+SetUpAtomics();
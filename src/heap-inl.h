@@ -298,7 +298,12 @@ void Heap::FinalizeExternalString(String* string) {
 
   // Dispose of the C++ object if it has not already been disposed.
   if (*resource_addr != NULL) {
-    (*resource_addr)->Dispose();
+    if (FLAG_concurrent_external_string_disposal && gc_state_ != NOT_IN_GC) {
+      // Keep the embedder's destructors out of the pause.
+      external_string_resources_to_dispose_.Add(*resource_addr);
+    } else {
+      (*resource_addr)->Dispose();
+    }
     *resource_addr = NULL;
   }
 }
@@ -357,7 +362,14 @@ bool Heap::OldGenerationAllocationLimitReached() {
 bool Heap::ShouldBePromoted(Address old_address, int object_size) {
   // An object should be promoted if:
   // - the object has survived a scavenge operation or
-  // - to space is already 25% full.
+  // - to space is already 25% full or
+  // - the heap is in high promotion mode, where almost all live objects
+  //   end up in old space anyway and copying them within new space first
+  //   only adds to the scavenge pause.
+  if (FLAG_scavenge_promote_in_high_promotion_mode &&
+      new_space_high_promotion_mode_active_) {
+    return true;
+  }
   NewSpacePage* page = NewSpacePage::FromAddress(old_address);
   Address age_mark = new_space_.age_mark();
   bool below_mark = page->IsFlagSet(MemoryChunk::NEW_SPACE_BELOW_AGE_MARK) &&
@@ -468,20 +480,9 @@ void Heap::CopyBlock(Address dst, Address src, int byte_size) {
 
 void Heap::MoveBlock(Address dst, Address src, int byte_size) {
   ASSERT(IsAligned(byte_size, kPointerSize));
-
-  int size_in_words = byte_size / kPointerSize;
-
-  if ((dst < src) || (dst >= (src + byte_size))) {
-    Object** src_slot = reinterpret_cast<Object**>(src);
-    Object** dst_slot = reinterpret_cast<Object**>(dst);
-    Object** end_slot = src_slot + size_in_words;
-
-    while (src_slot != end_slot) {
-      *dst_slot++ = *src_slot++;
-    }
-  } else {
-    OS::MemMove(dst, src, static_cast<size_t>(byte_size));
-  }
+  MoveWords(reinterpret_cast<Object**>(dst),
+            reinterpret_cast<Object**>(src),
+            static_cast<size_t>(byte_size / kPointerSize));
 }
 
 
@@ -518,6 +519,7 @@ void Heap::UpdateAllocationSiteFeedback(HeapObject* object,
   AllocationMemento* memento = AllocationMemento::cast(candidate);
   if (!memento->IsValid()) return;
 
+  memento->GetAllocationSite()->IncrementSurvivedBytes(object->Size());
   if (memento->GetAllocationSite()->IncrementMementoFoundCount()) {
     heap->AddAllocationSiteToScratchpad(memento->GetAllocationSite(), mode);
   }
@@ -716,10 +718,20 @@ void ExternalStringTable::AddString(String* string) {
 
 
 void ExternalStringTable::Iterate(ObjectVisitor* v) {
+  IterateNewSpaceStrings(v);
+  IterateOldSpaceStrings(v);
+}
+
+
+void ExternalStringTable::IterateNewSpaceStrings(ObjectVisitor* v) {
   if (!new_space_strings_.is_empty()) {
     Object** start = &new_space_strings_[0];
     v->VisitPointers(start, start + new_space_strings_.length());
   }
+}
+
+
+void ExternalStringTable::IterateOldSpaceStrings(ObjectVisitor* v) {
   if (!old_space_strings_.is_empty()) {
     Object** start = &old_space_strings_[0];
     v->VisitPointers(start, start + old_space_strings_.length());
@@ -215,6 +215,37 @@ Handle<HeapObject> HeapProfiler::FindHeapObjectById(SnapshotObjectId id) {
 }
 
 
+static int CompareSurvivedBytes(AllocationSite* const* a,
+                                AllocationSite* const* b) {
+  int a_bytes = (*a)->survived_bytes();
+  int b_bytes = (*b)->survived_bytes();
+  if (a_bytes != b_bytes) return a_bytes > b_bytes ? -1 : 1;
+  return 0;
+}
+
+
+int HeapProfiler::GetTopAllocationSites(v8::AllocationSiteStats* stats,
+                                        int max_sites) {
+  DisallowHeapAllocation no_allocation;
+  List<AllocationSite*> sites;
+  Object* list_element = heap()->allocation_sites_list();
+  while (list_element->IsAllocationSite()) {
+    AllocationSite* site = AllocationSite::cast(list_element);
+    if (!site->IsZombie() && site->survived_bytes() > 0) sites.Add(site);
+    list_element = site->weak_next();
+  }
+  sites.Sort(CompareSurvivedBytes);
+  int count = Min(max_sites, sites.length());
+  for (int i = 0; i < count; i++) {
+    AllocationSite* site = sites[i];
+    stats[i].id = ids_->FindOrAddEntry(site->address(), site->Size());
+    stats[i].survived_bytes = site->survived_bytes();
+    stats[i].tenured = site->GetPretenureMode() == TENURED;
+  }
+  return count;
+}
+
+
 void HeapProfiler::ClearHeapObjectMap() {
   ids_.Reset(new HeapObjectsMap(heap()));
   if (!is_tracking_allocations()) is_tracking_object_moves_ = false;
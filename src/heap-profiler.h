@@ -89,6 +89,8 @@ class HeapProfiler {
   Handle<HeapObject> FindHeapObjectById(SnapshotObjectId id);
   void ClearHeapObjectMap();
 
+  int GetTopAllocationSites(v8::AllocationSiteStats* stats, int max_sites);
+
  private:
   Heap* heap() const { return ids_->heap(); }
 
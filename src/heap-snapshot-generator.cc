@@ -290,6 +290,15 @@ HeapEntry* HeapSnapshot::AddEntry(HeapEntry::Type type,
 }
 
 
+void HeapSnapshot::ReserveEntries(int count) {
+  ASSERT(entries_.is_empty());
+  // Allocate the backing store and drop the length again, so that the
+  // entries are added without reallocating.
+  entries_.Allocate(count);
+  entries_.Rewind(0);
+}
+
+
 void HeapSnapshot::FillChildren() {
   ASSERT(children().is_empty());
   children().Allocate(edges().length());
@@ -1364,6 +1373,9 @@ void V8HeapExplorer::ExtractScriptReferences(int entry, Script* script) {
   SetInternalReference(obj, entry,
                        "line_ends", script->line_ends(),
                        Script::kLineEndsOffset);
+  SetInternalReference(obj, entry,
+                       "lazy_function_data", script->lazy_function_data(),
+                       Script::kLazyFunctionDataOffset);
 }
 
 
@@ -2512,6 +2524,8 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
   debug_heap->Verify();
 #endif
 
+  ReserveSnapshotEntries();
+
   if (!FillReferences()) return false;
 
   snapshot_->FillChildren();
@@ -2542,7 +2556,10 @@ bool HeapSnapshotGenerator::ProgressReport(bool force) {
 
 void HeapSnapshotGenerator::SetProgressTotal(int iterations_count) {
   if (control_ == NULL) return;
-  HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
+  // This is only an estimate, so avoid the extra marking pass over the
+  // whole heap that a filtering iterator needs. The heap has just been
+  // collected twice, so there are hardly any unreachable objects left.
+  HeapIterator iterator(heap_);
   progress_total_ = iterations_count * (
       v8_heap_explorer_.EstimateObjectsCount(&iterator) +
       dom_explorer_.EstimateObjectsCount());
@@ -2550,6 +2567,24 @@ void HeapSnapshotGenerator::SetProgressTotal(int iterations_count) {
 }
 
 
+void HeapSnapshotGenerator::ReserveSnapshotEntries() {
+  // Growing the entries list by doubling temporarily keeps both the old and
+  // the new backing store alive, which on large heaps is a significant part
+  // of the peak memory needed for a snapshot. There is one entry per heap
+  // object plus a few synthetic ones, so size the list up front.
+  int objects_count;
+  if (control_ != NULL) {
+    objects_count = progress_total_;
+  } else {
+    HeapIterator iterator(heap_);
+    objects_count = v8_heap_explorer_.EstimateObjectsCount(&iterator);
+  }
+  static const int kSyntheticEntries =
+      VisitorSynchronization::kNumberOfSyncTags + 3;
+  snapshot_->ReserveEntries(objects_count + kSyntheticEntries);
+}
+
+
 bool HeapSnapshotGenerator::FillReferences() {
   SnapshotFiller filler(snapshot_, &entries_);
   v8_heap_explorer_.AddRootEntries(&filler);
@@ -196,6 +196,7 @@ class HeapSnapshot {
   HeapEntry* AddGcRootsEntry();
   HeapEntry* AddGcSubrootEntry(int tag);
   HeapEntry* AddNativesRootEntry();
+  void ReserveEntries(int count);
   HeapEntry* GetEntryById(SnapshotObjectId id);
   List<HeapEntry*>* GetSortedEntriesList();
   void FillChildren();
@@ -580,6 +581,7 @@ class HeapSnapshotGenerator : public SnapshottingProgressReportingInterface {
   void ProgressStep();
   bool ProgressReport(bool force = false);
   void SetProgressTotal(int iterations_count);
+  void ReserveSnapshotEntries();
 
   HeapSnapshot* snapshot_;
   v8::ActivityControl* control_;
@@ -48,6 +48,7 @@
 #include "scopeinfo.h"
 #include "snapshot.h"
 #include "store-buffer.h"
+#include "stub-cache.h"
 #include "utils/random-number-generator.h"
 #include "v8conversions.h"
 #include "v8threads.h"
@@ -117,6 +118,7 @@ Heap::Heap()
       inline_allocation_disabled_(false),
       store_buffer_rebuilder_(store_buffer()),
       hidden_string_(NULL),
+      gc_statistics_callback_(NULL),
       gc_safe_size_of_old_object_(NULL),
       total_regexp_code_generated_(0),
       tracer_(NULL),
@@ -124,6 +126,7 @@ Heap::Heap()
       high_survival_rate_period_length_(0),
       low_survival_rate_period_length_(0),
       survival_rate_(0),
+      scavenge_speed_(0),
       previous_survival_rate_trend_(Heap::STABLE),
       survival_rate_trend_(Heap::STABLE),
       max_gc_pause_(0.0),
@@ -151,10 +154,13 @@ Heap::Heap()
       no_weak_object_verification_scope_depth_(0),
 #endif
       allocation_sites_scratchpad_length_(0),
+      gcs_since_pretenuring_decay_(0),
+      idle_task_(NULL),
       promotion_queue_(this),
       configured_(false),
       external_string_table_(this),
       chunks_queued_for_free_(NULL),
+      pending_roots_iterating_tasks_semaphore_(0),
       relocation_mutex_(NULL) {
   // Allow build-time customization of the max semispace size. Building
   // V8 with snapshots and a non-default max semispace size is much
@@ -545,6 +551,13 @@ void Heap::ProcessPretenuringFeedback() {
       }
     }
 
+    if (FLAG_allocation_site_pretenuring_decay > 0 &&
+        ++gcs_since_pretenuring_decay_ >=
+            FLAG_allocation_site_pretenuring_decay) {
+      gcs_since_pretenuring_decay_ = 0;
+      if (DecayPretenuringDecisions()) trigger_deoptimization = true;
+    }
+
     if (trigger_deoptimization) {
       isolate_->stack_guard()->DeoptMarkedAllocationSites();
     }
@@ -569,6 +582,20 @@ void Heap::ProcessPretenuringFeedback() {
 }
 
 
+bool Heap::DecayPretenuringDecisions() {
+  // Tenured sites do not create mementos any more, so they never show up in
+  // the scratchpad and the whole list has to be walked.
+  bool trigger_deoptimization = false;
+  Object* list_element = allocation_sites_list();
+  while (list_element->IsAllocationSite()) {
+    AllocationSite* site = AllocationSite::cast(list_element);
+    if (site->DecayPretenureDecision()) trigger_deoptimization = true;
+    list_element = site->weak_next();
+  }
+  return trigger_deoptimization;
+}
+
+
 void Heap::DeoptMarkedAllocationSites() {
   // TODO(hpayer): If iterating over the allocation sites list becomes a
   // performance issue, use a cache heap data structure instead (similar to the
@@ -590,6 +617,7 @@ void Heap::DeoptMarkedAllocationSites() {
 
 void Heap::GarbageCollectionEpilogue() {
   store_buffer()->GCEpilogue();
+  DisposeQueuedExternalStringResources();
 
   // In release mode, we only zap the from space under heap verification.
   if (Heap::ShouldZapGarbage()) {
@@ -767,9 +795,21 @@ void Heap::CollectAllAvailableGarbage(const char* gc_reason) {
     }
   }
   mark_compact_collector()->SetFlags(kNoGCFlags);
+  array_buffer_pool_.Flush();
+  isolate_->memory_allocator()->ReleasePooledChunks();
+  new_space_.Shrink();
+  UncommitFromSpace();
+  incremental_marking()->UncommitMarkingDeque();
+  mark_compact_collector()->UncommitMarkingDeque();
+}
+
+
+void Heap::ReduceMemoryFootprint(const char* gc_reason) {
+  CollectAllGarbage(kReduceMemoryFootprintMask, gc_reason);
   new_space_.Shrink();
   UncommitFromSpace();
   incremental_marking()->UncommitMarkingDeque();
+  mark_compact_collector()->UncommitMarkingDeque();
 }
 
 
@@ -1115,12 +1155,21 @@ bool Heap::PerformGarbageCollection(
         OldGenerationAllocationLimit(size_of_old_gen_at_last_old_space_gc_);
 
     old_gen_exhausted_ = false;
+
+    // Finish lazy sweeping in idle time rather than on allocation.
+    if (!IsSweepingComplete()) ScheduleIdleTask();
   } else {
     tracer_ = tracer;
+    double scavenge_start_time = OS::TimeCurrentMillis();
     Scavenge();
+    double scavenge_time = OS::TimeCurrentMillis() - scavenge_start_time;
     tracer_ = NULL;
 
     UpdateSurvivalRateTrend(start_new_space_size);
+
+    if (FLAG_scavenge_pause_target > 0) {
+      AdjustNewSpaceCapacityForPauseTarget(scavenge_time);
+    }
   }
 
   if (!new_space_high_promotion_mode_active_ &&
@@ -1281,6 +1330,8 @@ void Heap::MarkCompactPrologue() {
   isolate_->keyed_lookup_cache()->Clear();
   isolate_->context_slot_cache()->Clear();
   isolate_->descriptor_lookup_cache()->Clear();
+  isolate_->json_transition_cache()->Clear();
+  isolate_->for_in_cache()->Clear();
   RegExpResultsCache::Clear(string_split_cache());
   RegExpResultsCache::Clear(regexp_multiple_cache());
 
@@ -1288,7 +1339,11 @@ void Heap::MarkCompactPrologue() {
 
   CompletelyClearInstanceofCache();
 
-  FlushNumberStringCache();
+  // The number string cache only references tenured strings, so there is
+  // no need to drop it on every full GC; only do so when memory is tight.
+  if (mark_compact_collector()->reduce_memory_footprint()) {
+    FlushNumberStringCache();
+  }
   if (FLAG_cleanup_code_caches_at_gc) {
     polymorphic_code_cache()->set_cache(undefined_value());
   }
@@ -1362,6 +1417,8 @@ static void VerifyNonPointerSpacePointers(Heap* heap) {
 
 
 void Heap::CheckNewSpaceExpansionCriteria() {
+  // With a pause target the semispaces are resized after each scavenge.
+  if (FLAG_scavenge_pause_target > 0) return;
   if (new_space_.Capacity() < new_space_.MaximumCapacity() &&
       survived_since_last_expansion_ > new_space_.Capacity() &&
       !new_space_high_promotion_mode_active_) {
@@ -1374,6 +1431,42 @@ void Heap::CheckNewSpaceExpansionCriteria() {
 }
 
 
+void Heap::AdjustNewSpaceCapacityForPauseTarget(double scavenge_time_ms) {
+  if (young_survivors_after_last_gc_ > 0 && scavenge_time_ms > 0) {
+    double speed = young_survivors_after_last_gc_ / scavenge_time_ms;
+    scavenge_speed_ =
+        scavenge_speed_ == 0 ? speed : (scavenge_speed_ + speed) / 2;
+  }
+
+  // The cost of a scavenge is proportional to the amount of surviving
+  // objects, so with a stable survival rate the pause grows linearly with
+  // the capacity of the semispaces. Without a measurement yet, scavenges
+  // were too fast to time and there is no reason to limit new space.
+  double target_capacity = new_space_.MaximumCapacity();
+  if (scavenge_speed_ > 0 && survival_rate_ > 0) {
+    target_capacity = Min(target_capacity,
+        FLAG_scavenge_pause_target * scavenge_speed_ * 100 / survival_rate_);
+  }
+
+  int capacity = static_cast<int>(new_space_.Capacity());
+  if (target_capacity > capacity) {
+    if (capacity < new_space_.MaximumCapacity() &&
+        !new_space_high_promotion_mode_active_) {
+      new_space_.Grow();
+    }
+  } else if (target_capacity < capacity / 2) {
+    new_space_.Shrink(static_cast<int>(target_capacity));
+  }
+
+  if (FLAG_trace_gc_verbose && new_space_.Capacity() != capacity) {
+    PrintPID("Resized new space for a %d ms scavenge pause target: "
+             "%d KB -> %d KB\n", FLAG_scavenge_pause_target,
+             capacity / KB,
+             static_cast<int>(new_space_.Capacity() / KB));
+  }
+}
+
+
 static bool IsUnscavengedHeapObject(Heap* heap, Object** p) {
   return heap->InNewSpace(*p) &&
       !HeapObject::cast(*p)->map_word().IsForwardingAddress();
@@ -1509,6 +1602,8 @@ void Heap::Scavenge() {
 
   // Clear descriptor cache.
   isolate_->descriptor_lookup_cache()->Clear();
+  isolate_->json_transition_cache()->Clear();
+  isolate_->for_in_cache()->Clear();
 
   // Used for updating survived_since_last_expansion_ at function end.
   intptr_t survived_watermark = PromotedSpaceSizeOfObjects();
@@ -3287,15 +3382,6 @@ bool Heap::CreateInitialObjects() {
   }
   set_observation_state(JSObject::cast(obj));
 
-  // Allocate object to hold object microtask state.
-  { MaybeObject* maybe_obj = AllocateMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
-    if (!maybe_obj->ToObject(&obj)) return false;
-  }
-  { MaybeObject* maybe_obj = AllocateJSObjectFromMap(Map::cast(obj));
-    if (!maybe_obj->ToObject(&obj)) return false;
-  }
-  set_microtask_state(JSObject::cast(obj));
-
   { MaybeObject* maybe_obj = AllocateSymbol();
     if (!maybe_obj->ToObject(&obj)) return false;
   }
@@ -3361,6 +3447,12 @@ bool Heap::CreateInitialObjects() {
   // Initialize descriptor cache.
   isolate_->descriptor_lookup_cache()->Clear();
 
+  // Initialize JSON transition cache.
+  isolate_->json_transition_cache()->Clear();
+
+  // Initialize for-in cache.
+  isolate_->for_in_cache()->Clear();
+
   // Initialize compilation cache.
   isolate_->compilation_cache()->Clear();
 
@@ -3403,33 +3495,99 @@ bool Heap::RootCanBeTreatedAsConstant(RootListIndex root_index) {
 }
 
 
-Object* RegExpResultsCache::Lookup(Heap* heap,
-                                   String* key_string,
-                                   Object* key_pattern,
-                                   ResultsCacheType type) {
-  FixedArray* cache;
-  if (!key_string->IsInternalizedString()) return Smi::FromInt(0);
+FixedArray* RegExpResultsCache::CacheFor(Heap* heap,
+                                         String* key_string,
+                                         Object* key_pattern,
+                                         ResultsCacheType type) {
+  if (!key_string->IsInternalizedString() &&
+      key_string->length() < kMinUninternalizedSubjectLength) {
+    return NULL;
+  }
   if (type == STRING_SPLIT_SUBSTRINGS) {
     ASSERT(key_pattern->IsString());
-    if (!key_pattern->IsInternalizedString()) return Smi::FromInt(0);
-    cache = heap->string_split_cache();
+    if (!key_pattern->IsInternalizedString()) return NULL;
+    return heap->string_split_cache();
+  }
+  // Replace entries also hold a replacement string, which tells them apart
+  // from the exec entries sharing the cache.
+  ASSERT(type == REGEXP_MULTIPLE_INDICES || type == REGEXP_REPLACE_STRING);
+  ASSERT(key_pattern->IsFixedArray());
+  return heap->regexp_multiple_cache();
+}
+
+
+static bool StringKeyMatches(Object* cached, String* key) {
+  if (cached == key) return true;
+  if (!cached->IsString()) return false;
+  // This is a pointer comparison if both strings are internalized.
+  return String::cast(cached)->Equals(key);
+}
+
+
+bool RegExpResultsCache::EntryMatches(FixedArray* cache,
+                                      int index,
+                                      String* key_string,
+                                      Object* key_pattern,
+                                      Object* key_replacement) {
+  if (cache->get(index + kPatternOffset) != key_pattern) return false;
+  Object* replacement = cache->get(index + kReplacementOffset);
+  if (key_replacement->IsString()) {
+    if (!StringKeyMatches(replacement, String::cast(key_replacement))) {
+      return false;
+    }
+  } else if (replacement != key_replacement) {
+    return false;
+  }
+  return StringKeyMatches(cache->get(index + kStringOffset), key_string);
+}
+
+
+int RegExpResultsCache::FullSizeCacheLength(Heap* heap) {
+  // Scale with the new space like the number string cache does.
+  int length = RoundDownToPowerOf2(heap->MaxSemiSpaceSize() / 1024);
+  return Max(kRegExpResultsCacheSize * 4, Min(0x2000, length));
+}
+
+
+FixedArray* RegExpResultsCache::Grow(Heap* heap,
+                                     FixedArray* cache,
+                                     ResultsCacheType type) {
+  // Keep the caches in the snapshot small.
+  if (Serializer::enabled()) return cache;
+  Object* new_cache;
+  MaybeObject* maybe_cache =
+      heap->AllocateFixedArray(FullSizeCacheLength(heap), TENURED);
+  // It is only a cache, so keep the old one if allocation fails.
+  if (!maybe_cache->ToObject(&new_cache)) return cache;
+  Clear(FixedArray::cast(new_cache));
+  if (type == STRING_SPLIT_SUBSTRINGS) {
+    heap->set_string_split_cache(FixedArray::cast(new_cache));
   } else {
-    ASSERT(type == REGEXP_MULTIPLE_INDICES);
-    ASSERT(key_pattern->IsFixedArray());
-    cache = heap->regexp_multiple_cache();
+    heap->set_regexp_multiple_cache(FixedArray::cast(new_cache));
   }
+  return FixedArray::cast(new_cache);
+}
 
+
+Object* RegExpResultsCache::Lookup(Heap* heap,
+                                   String* key_string,
+                                   Object* key_pattern,
+                                   ResultsCacheType type,
+                                   String* key_replacement) {
+  ASSERT_EQ(type == REGEXP_REPLACE_STRING, key_replacement != NULL);
+  FixedArray* cache = CacheFor(heap, key_string, key_pattern, type);
+  if (cache == NULL) return Smi::FromInt(0);
+  Object* replacement = key_replacement == NULL
+      ? static_cast<Object*>(Smi::FromInt(0)) : key_replacement;
+
+  uint32_t mask = cache->length() - 1;
   uint32_t hash = key_string->Hash();
-  uint32_t index = ((hash & (kRegExpResultsCacheSize - 1)) &
-      ~(kArrayEntriesPerCacheEntry - 1));
-  if (cache->get(index + kStringOffset) == key_string &&
-      cache->get(index + kPatternOffset) == key_pattern) {
+  uint32_t index = ((hash & mask) & ~(kArrayEntriesPerCacheEntry - 1));
+  if (EntryMatches(cache, index, key_string, key_pattern, replacement)) {
     return cache->get(index + kArrayOffset);
   }
-  index =
-      ((index + kArrayEntriesPerCacheEntry) & (kRegExpResultsCacheSize - 1));
-  if (cache->get(index + kStringOffset) == key_string &&
-      cache->get(index + kPatternOffset) == key_pattern) {
+  index = ((index + kArrayEntriesPerCacheEntry) & mask);
+  if (EntryMatches(cache, index, key_string, key_pattern, replacement)) {
     return cache->get(index + kArrayOffset);
   }
   return Smi::FromInt(0);
@@ -3440,40 +3598,48 @@ void RegExpResultsCache::Enter(Heap* heap,
                                String* key_string,
                                Object* key_pattern,
                                FixedArray* value_array,
-                               ResultsCacheType type) {
-  FixedArray* cache;
-  if (!key_string->IsInternalizedString()) return;
-  if (type == STRING_SPLIT_SUBSTRINGS) {
-    ASSERT(key_pattern->IsString());
-    if (!key_pattern->IsInternalizedString()) return;
-    cache = heap->string_split_cache();
-  } else {
-    ASSERT(type == REGEXP_MULTIPLE_INDICES);
-    ASSERT(key_pattern->IsFixedArray());
-    cache = heap->regexp_multiple_cache();
-  }
-
+                               ResultsCacheType type,
+                               String* key_replacement) {
+  ASSERT_EQ(type == REGEXP_REPLACE_STRING, key_replacement != NULL);
+  FixedArray* cache = CacheFor(heap, key_string, key_pattern, type);
+  if (cache == NULL) return;
+  Object* replacement = key_replacement == NULL
+      ? static_cast<Object*>(Smi::FromInt(0)) : key_replacement;
+
+  uint32_t mask = cache->length() - 1;
   uint32_t hash = key_string->Hash();
-  uint32_t index = ((hash & (kRegExpResultsCacheSize - 1)) &
-      ~(kArrayEntriesPerCacheEntry - 1));
-  if (cache->get(index + kStringOffset) == Smi::FromInt(0)) {
+  uint32_t index = ((hash & mask) & ~(kArrayEntriesPerCacheEntry - 1));
+  uint32_t index2 = ((index + kArrayEntriesPerCacheEntry) & mask);
+  // Fresh caches are filled with undefined rather than 0.
+  if (cache->get(index + kStringOffset)->IsString() &&
+      cache->get(index2 + kStringOffset)->IsString() &&
+      cache->length() < FullSizeCacheLength(heap)) {
+    // The first time both entries are taken, move to the full size cache.
+    cache = Grow(heap, cache, type);
+    mask = cache->length() - 1;
+    index = ((hash & mask) & ~(kArrayEntriesPerCacheEntry - 1));
+    index2 = ((index + kArrayEntriesPerCacheEntry) & mask);
+  }
+  if (!cache->get(index + kStringOffset)->IsString()) {
     cache->set(index + kStringOffset, key_string);
     cache->set(index + kPatternOffset, key_pattern);
     cache->set(index + kArrayOffset, value_array);
+    cache->set(index + kReplacementOffset, replacement);
   } else {
-    uint32_t index2 =
-        ((index + kArrayEntriesPerCacheEntry) & (kRegExpResultsCacheSize - 1));
-    if (cache->get(index2 + kStringOffset) == Smi::FromInt(0)) {
+    if (!cache->get(index2 + kStringOffset)->IsString()) {
       cache->set(index2 + kStringOffset, key_string);
       cache->set(index2 + kPatternOffset, key_pattern);
       cache->set(index2 + kArrayOffset, value_array);
+      cache->set(index2 + kReplacementOffset, replacement);
     } else {
       cache->set(index2 + kStringOffset, Smi::FromInt(0));
       cache->set(index2 + kPatternOffset, Smi::FromInt(0));
       cache->set(index2 + kArrayOffset, Smi::FromInt(0));
+      cache->set(index2 + kReplacementOffset, Smi::FromInt(0));
       cache->set(index + kStringOffset, key_string);
       cache->set(index + kPatternOffset, key_pattern);
       cache->set(index + kArrayOffset, value_array);
+      cache->set(index + kReplacementOffset, replacement);
     }
   }
   // If the array is a reasonably short list of substrings, convert it into a
@@ -3494,7 +3660,8 @@ void RegExpResultsCache::Enter(Heap* heap,
 
 
 void RegExpResultsCache::Clear(FixedArray* cache) {
-  for (int i = 0; i < kRegExpResultsCacheSize; i++) {
+  int length = cache->length();
+  for (int i = 0; i < length; i++) {
     cache->set(i, Smi::FromInt(0));
   }
 }
@@ -4054,6 +4221,18 @@ MaybeObject* Heap::CreateCode(const CodeDesc& desc,
   bool force_lo_space = obj_size > code_space()->AreaSize();
   if (force_lo_space) {
     maybe_result = lo_space_->AllocateRaw(obj_size, EXECUTABLE);
+  } else if (FLAG_segregate_optimized_code && !immovable &&
+             Code::ExtractKindFromFlags(flags) == Code::OPTIMIZED_FUNCTION) {
+    // Optimized code is kept apart from the (mostly cold) baseline code and
+    // stubs for better instruction cache locality.
+    maybe_result = code_space_->AllocateRawHot(obj_size);
+    if (maybe_result->IsFailure()) {
+      old_gen_exhausted_ = true;
+    } else if (isolate_->heap_profiler()->is_tracking_allocations()) {
+      isolate_->heap_profiler()->AllocationEvent(
+          HeapObject::cast(maybe_result->ToObjectUnchecked())->address(),
+          obj_size);
+    }
   } else {
     maybe_result = AllocateRaw(obj_size, CODE_SPACE, CODE_SPACE);
   }
@@ -4086,6 +4265,7 @@ MaybeObject* Heap::CreateCode(const CodeDesc& desc,
   code->set_gc_metadata(Smi::FromInt(0));
   code->set_ic_age(global_ic_age_);
   code->set_prologue_offset(prologue_offset);
+  code->set_creation_time(0);
   if (code->kind() == Code::OPTIMIZED_FUNCTION) {
     code->set_marked_for_deoptimization(false);
   }
@@ -5536,6 +5716,61 @@ void Heap::AdvanceIdleIncrementalMarking(intptr_t step_size) {
 }
 
 
+class Heap::IdleTask : public v8::IdleTask {
+ public:
+  explicit IdleTask(Heap* heap) : heap_(heap) { }
+
+  virtual ~IdleTask() {
+    if (heap_ != NULL) heap_->idle_task_ = NULL;
+  }
+
+  // Called when the heap is torn down before the task ran.
+  void Cancel() { heap_ = NULL; }
+
+  virtual void Run(double idle_time_in_ms) V8_OVERRIDE {
+    if (heap_ == NULL) return;
+    Heap* heap = heap_;
+    heap->idle_task_ = NULL;
+    heap_ = NULL;
+    if (heap->IdleTimeStep(static_cast<int>(idle_time_in_ms))) {
+      // There is still work left, ask for the next idle period.
+      heap->ScheduleIdleTask();
+    }
+  }
+
+ private:
+  Heap* heap_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleTask);
+};
+
+
+void Heap::ScheduleIdleTask() {
+  if (!FLAG_use_idle_tasks || !FLAG_use_idle_notification) return;
+  if (idle_task_ != NULL) return;
+  v8::Isolate* isolate = reinterpret_cast<v8::Isolate*>(isolate_);
+  v8::Platform* platform = V8::GetCurrentPlatform();
+  if (!platform->IdleTasksEnabled(isolate)) return;
+  idle_task_ = new IdleTask(this);
+  platform->CallIdleOnForegroundThread(isolate, idle_task_);
+}
+
+
+bool Heap::IdleTimeStep(int idle_time_in_ms) {
+  // Uses the same work estimate as IdleNotification.
+  intptr_t step_size = Min(Max(idle_time_in_ms, 20), 1000) / 4 *
+      IncrementalMarking::kAllocatedThreshold;
+  bool lazy_sweeping = !mark_compact_collector()->AreSweeperThreadsActivated();
+  if (!incremental_marking()->IsStopped()) {
+    if (idle_time_in_ms > 0) AdvanceIdleIncrementalMarking(step_size);
+  } else if (lazy_sweeping && !IsSweepingComplete()) {
+    if (idle_time_in_ms > 0) AdvanceSweepers(static_cast<int>(step_size));
+  }
+  return !incremental_marking()->IsStopped() ||
+      (lazy_sweeping && !IsSweepingComplete());
+}
+
+
 bool Heap::IdleNotification(int hint) {
   // Hints greater than this value indicate that
   // the embedder is requesting a lot of GC work.
@@ -5621,6 +5856,12 @@ bool Heap::IdleNotification(int hint) {
   }
 
   if (mark_sweeps_since_idle_round_started_ >= kMaxMarkSweepsInIdleRound) {
+    if (FLAG_memory_reducer && hint >= kMinHintForFullGC &&
+        incremental_marking()->IsStopped()) {
+      // The mutator did not produce enough garbage during the whole idle
+      // round, so give back the memory it is not using.
+      ReduceMemoryFootprint("idle notification: reduce memory footprint");
+    }
     FinishIdleRound();
     return true;
   }
@@ -5629,6 +5870,35 @@ bool Heap::IdleNotification(int hint) {
 }
 
 
+void Heap::ClearCachesForMemoryPressure() {
+  isolate_->compilation_cache()->Clear();
+  isolate_->stub_cache()->Clear();
+  FlushNumberStringCache();
+  RegExpResultsCache::Clear(string_split_cache());
+  RegExpResultsCache::Clear(regexp_multiple_cache());
+}
+
+
+void Heap::MemoryPressureNotification(
+    v8::Isolate::MemoryPressureLevel level) {
+  if (level == v8::Isolate::kMemoryPressureNone) return;
+  if (gc_state() != NOT_IN_GC) return;
+  ClearCachesForMemoryPressure();
+  if (level == v8::Isolate::kMemoryPressureModerate) {
+    // Leave the actual collection to incremental marking so that the
+    // embedder is not blocked.  Unlike the allocation driven start this
+    // ignores the promoted size threshold.
+    if (FLAG_incremental_marking && FLAG_incremental_marking_steps &&
+        !Serializer::enabled() && incremental_marking()->IsStopped()) {
+      incremental_marking()->Start();
+    }
+    return;
+  }
+  ASSERT_EQ(v8::Isolate::kMemoryPressureCritical, level);
+  CollectAllAvailableGarbage("memory pressure notification: critical");
+}
+
+
 bool Heap::IdleGlobalGC() {
   static const int kIdlesBeforeScavenge = 4;
   static const int kIdlesBeforeMarkSweep = 7;
@@ -6116,7 +6386,98 @@ void Heap::IterateSmiRoots(ObjectVisitor* v) {
 }
 
 
+class Heap::RootsIteratingTask : public v8::Task {
+ public:
+  RootsIteratingTask(Heap* heap,
+                     ObjectVisitor* visitor,
+                     VisitMode mode,
+                     int first,
+                     int stride)
+    : heap_(heap),
+      visitor_(visitor),
+      mode_(mode),
+      first_(first),
+      stride_(stride) {}
+
+  virtual ~RootsIteratingTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() V8_OVERRIDE {
+    if (first_ == 0) heap_->IterateGlobalAndEternalHandles(visitor_, mode_);
+    heap_->isolate()->thread_manager()->IterateArchivedHandleScopes(
+        visitor_, first_, stride_);
+    heap_->pending_roots_iterating_tasks_semaphore_.Signal();
+  }
+
+  Heap* heap_;
+  ObjectVisitor* visitor_;
+  VisitMode mode_;
+  int first_;
+  int stride_;
+
+  DISALLOW_COPY_AND_ASSIGN(RootsIteratingTask);
+};
+
+
+void Heap::IterateRootsInParallel(ObjectVisitor* v, VisitMode mode) {
+  ThreadManager* thread_manager = isolate_->thread_manager();
+  int ntasks = Min(Max(thread_manager->CountArchivedThreads(), 1),
+                   Min(CPU::NumberOfProcessorsOnline(),
+                       kMaxRootsIteratingTasks));
+  // The first task also takes the global and eternal handles, the others
+  // only split the handle scopes of archived threads between them.
+  for (int i = 0; i < ntasks; i++) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new RootsIteratingTask(this, v, mode, i, ntasks),
+        v8::Platform::kShortRunningTask);
+  }
+  // Meanwhile the main thread visits everything else, including the stacks
+  // of archived threads: walking frames goes through the isolate's inner
+  // pointer to code cache, which is not thread safe.
+  IterateStrongRoots(v, mode, SKIP_HANDLE_ROOTS);
+  thread_manager->IterateArchivedStacks(v);
+  IterateWeakRoots(v, mode);
+  for (int i = 0; i < ntasks; i++) {
+    pending_roots_iterating_tasks_semaphore_.Wait();
+  }
+}
+
+
+void Heap::IterateGlobalAndEternalHandles(ObjectVisitor* v, VisitMode mode) {
+  // Iterate over global handles.
+  switch (mode) {
+    case VISIT_ONLY_STRONG:
+      isolate_->global_handles()->IterateStrongRoots(v);
+      break;
+    case VISIT_ALL_IN_SCAVENGE:
+      isolate_->global_handles()->IterateNewSpaceStrongAndDependentRoots(v);
+      break;
+    case VISIT_ALL_IN_SWEEP_NEWSPACE:
+    case VISIT_ALL:
+      isolate_->global_handles()->IterateAllRoots(v);
+      break;
+  }
+  v->Synchronize(VisitorSynchronization::kGlobalHandles);
+
+  // Iterate over eternal handles.
+  if (mode == VISIT_ALL_IN_SCAVENGE) {
+    isolate_->eternal_handles()->IterateNewSpaceRoots(v);
+  } else {
+    isolate_->eternal_handles()->IterateAllRoots(v);
+  }
+  v->Synchronize(VisitorSynchronization::kEternalHandles);
+}
+
+
 void Heap::IterateStrongRoots(ObjectVisitor* v, VisitMode mode) {
+  IterateStrongRoots(v, mode, ITERATE_HANDLE_ROOTS);
+}
+
+
+void Heap::IterateStrongRoots(ObjectVisitor* v,
+                              VisitMode mode,
+                              HandleRootsIteration handle_roots) {
   v->VisitPointers(&roots_[0], &roots_[kStrongRootListLength]);
   v->Synchronize(VisitorSynchronization::kStrongRootList);
 
@@ -6139,6 +6500,8 @@ void Heap::IterateStrongRoots(ObjectVisitor* v, VisitMode mode) {
   v->Synchronize(VisitorSynchronization::kDebug);
   isolate_->compilation_cache()->Iterate(v);
   v->Synchronize(VisitorSynchronization::kCompilationCache);
+  isolate_->microtask_queue()->Iterate(v);
+  v->Synchronize(VisitorSynchronization::kMicrotaskQueue);
 
   // Iterate over local handles in handle scopes.
   isolate_->handle_scope_implementer()->Iterate(v);
@@ -6153,32 +6516,15 @@ void Heap::IterateStrongRoots(ObjectVisitor* v, VisitMode mode) {
   }
   v->Synchronize(VisitorSynchronization::kBuiltins);
 
-  // Iterate over global handles.
-  switch (mode) {
-    case VISIT_ONLY_STRONG:
-      isolate_->global_handles()->IterateStrongRoots(v);
-      break;
-    case VISIT_ALL_IN_SCAVENGE:
-      isolate_->global_handles()->IterateNewSpaceStrongAndDependentRoots(v);
-      break;
-    case VISIT_ALL_IN_SWEEP_NEWSPACE:
-    case VISIT_ALL:
-      isolate_->global_handles()->IterateAllRoots(v);
-      break;
-  }
-  v->Synchronize(VisitorSynchronization::kGlobalHandles);
+  // The global and eternal handles and the pointers held by inactive
+  // threads are left to the caller when iterating in parallel.
+  if (handle_roots == ITERATE_HANDLE_ROOTS) {
+    IterateGlobalAndEternalHandles(v, mode);
 
-  // Iterate over eternal handles.
-  if (mode == VISIT_ALL_IN_SCAVENGE) {
-    isolate_->eternal_handles()->IterateNewSpaceRoots(v);
-  } else {
-    isolate_->eternal_handles()->IterateAllRoots(v);
+    // Iterate over pointers being held by inactive threads.
+    isolate_->thread_manager()->Iterate(v);
+    v->Synchronize(VisitorSynchronization::kThreadManager);
   }
-  v->Synchronize(VisitorSynchronization::kEternalHandles);
-
-  // Iterate over pointers being held by inactive threads.
-  isolate_->thread_manager()->Iterate(v);
-  v->Synchronize(VisitorSynchronization::kThreadManager);
 
   // Iterate over the pointers the Serialization/Deserialization code is
   // holding.
@@ -6580,6 +6926,13 @@ void Heap::TearDown() {
   }
 
   TearDownArrayBuffers();
+  if (FLAG_trace_array_buffer_pool) array_buffer_pool_.PrintStatistics();
+  array_buffer_pool_.Flush();
+
+  if (idle_task_ != NULL) {
+    idle_task_->Cancel();
+    idle_task_ = NULL;
+  }
 
   isolate_->global_handles()->TearDown();
 
@@ -7263,7 +7616,11 @@ GCTracer::GCTracer(Heap* heap,
       heap_(heap),
       gc_reason_(gc_reason),
       collector_reason_(collector_reason) {
-  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
+  report_statistics_ = heap->gc_statistics_callback() != NULL;
+  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat &&
+      !report_statistics_) {
+    return;
+  }
   start_time_ = OS::TimeCurrentMillis();
   start_object_size_ = heap_->SizeOfObjects();
   start_memory_size_ = heap_->isolate()->memory_allocator()->Size();
@@ -7288,12 +7645,25 @@ GCTracer::GCTracer(Heap* heap,
       heap_->incremental_marking()->steps_count_since_last_gc();
   steps_took_since_last_gc_ =
       heap_->incremental_marking()->steps_took_since_last_gc();
+
+  if (report_statistics_) {
+    AllSpaces spaces(heap_);
+    int i = FIRST_SPACE;
+    for (Space* space = spaces.next(); space != NULL; space = spaces.next()) {
+      start_space_size_[i++] = space->SizeOfObjects();
+    }
+    start_unswept_bytes_ =
+        heap_->old_pointer_space()->unswept_free_bytes() +
+        heap_->old_data_space()->unswept_free_bytes();
+  }
 }
 
 
 GCTracer::~GCTracer() {
-  // Printf ONE line iff flag is set.
-  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
+  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat &&
+      !report_statistics_) {
+    return;
+  }
 
   bool first_gc = (heap_->last_gc_end_timestamp_ == 0);
 
@@ -7302,6 +7672,11 @@ GCTracer::~GCTracer() {
 
   double time = heap_->last_gc_end_timestamp_ - start_time_;
 
+  if (report_statistics_) ReportStatistics(time);
+
+  // Printf ONE line iff flag is set.
+  if (!FLAG_trace_gc && !FLAG_print_cumulative_gc_stat) return;
+
   // Update cumulative GC statistics if required.
   if (FLAG_print_cumulative_gc_stat) {
     heap_->total_gc_time_ms_ += time;
@@ -7423,6 +7798,64 @@ GCTracer::~GCTracer() {
 }
 
 
+void GCTracer::ReportStatistics(double time) {
+  STATIC_ASSERT(v8::GCStatistics::kNumberOfSpaces == LAST_SPACE + 1);
+  STATIC_ASSERT(v8::GCStatistics::kNewSpace == NEW_SPACE);
+  STATIC_ASSERT(v8::GCStatistics::kLargeObjectSpace == LO_SPACE);
+  v8::GCStatistics stats;
+  stats.type = collector_ == SCAVENGER ? v8::kGCTypeScavenge
+                                       : v8::kGCTypeMarkSweepCompact;
+  stats.start_time = heap_->isolate()->time_millis_since_init() -
+      (OS::TimeCurrentMillis() - start_time_);
+  stats.pause = time;
+  stats.mutator_time = spent_in_mutator_;
+
+  stats.phase_times[v8::GCStatistics::kExternal] = scopes_[Scope::EXTERNAL];
+  stats.phase_times[v8::GCStatistics::kMark] = scopes_[Scope::MC_MARK];
+  stats.phase_times[v8::GCStatistics::kSweep] = scopes_[Scope::MC_SWEEP];
+  stats.phase_times[v8::GCStatistics::kSweepNewSpace] =
+      scopes_[Scope::MC_SWEEP_NEWSPACE];
+  stats.phase_times[v8::GCStatistics::kEvacuate] =
+      scopes_[Scope::MC_EVACUATE_PAGES];
+  stats.phase_times[v8::GCStatistics::kUpdatePointers] =
+      scopes_[Scope::MC_UPDATE_NEW_TO_NEW_POINTERS] +
+      scopes_[Scope::MC_UPDATE_ROOT_TO_NEW_POINTERS] +
+      scopes_[Scope::MC_UPDATE_OLD_TO_NEW_POINTERS] +
+      scopes_[Scope::MC_UPDATE_POINTERS_TO_EVACUATED] +
+      scopes_[Scope::MC_UPDATE_POINTERS_BETWEEN_EVACUATED] +
+      scopes_[Scope::MC_UPDATE_MISC_POINTERS];
+  stats.phase_times[v8::GCStatistics::kWeakCollections] =
+      scopes_[Scope::MC_WEAKCOLLECTION_PROCESS] +
+      scopes_[Scope::MC_WEAKCOLLECTION_CLEAR];
+
+  stats.size_before = static_cast<size_t>(start_object_size_);
+  stats.size_after = static_cast<size_t>(heap_->SizeOfObjects());
+  AllSpaces spaces(heap_);
+  int i = FIRST_SPACE;
+  for (Space* space = spaces.next(); space != NULL; space = spaces.next()) {
+    stats.space_size_before[i] = static_cast<size_t>(start_space_size_[i]);
+    stats.space_size_after[i] = static_cast<size_t>(space->SizeOfObjects());
+    i++;
+  }
+  stats.allocated_bytes = static_cast<size_t>(Max(allocated_since_last_gc_,
+                                                  static_cast<intptr_t>(0)));
+  stats.promoted_bytes = static_cast<size_t>(promoted_objects_size_);
+
+  if (collector_ == SCAVENGER) {
+    stats.incremental_marking_steps = steps_count_since_last_gc_;
+    stats.incremental_marking_time = steps_took_since_last_gc_;
+  } else {
+    stats.incremental_marking_steps = steps_count_;
+    stats.incremental_marking_time = steps_took_;
+  }
+  stats.incremental_marking_longest_step = longest_step_;
+  stats.unswept_bytes = static_cast<size_t>(start_unswept_bytes_);
+
+  heap_->gc_statistics_callback()(
+      reinterpret_cast<v8::Isolate*>(heap_->isolate()), &stats);
+}
+
+
 const char* GCTracer::CollectorString() {
   switch (collector_) {
     case SCAVENGER:
@@ -7470,8 +7903,8 @@ void KeyedLookupCache::Update(Map* map, Name* name, int field_offset) {
   int index = (Hash(map, name) & kHashMask);
   // After a GC there will be free slots, so we use them in order (this may
   // help to get the most frequently used one in position 0).
-  for (int i = 0; i< kEntriesPerBucket; i++) {
-    Key& key = keys_[index];
+  for (int i = 0; i < kEntriesPerBucket; i++) {
+    Key& key = keys_[index + i];
     Object* free_entry_indicator = NULL;
     if (key.map == free_entry_indicator) {
       key.map = map;
@@ -7507,6 +7940,75 @@ void DescriptorLookupCache::Clear() {
 }
 
 
+void JsonTransitionCache::Clear() {
+  for (int index = 0; index < kLength; index++) {
+    entries_[index].source = NULL;
+    entries_[index].name = NULL;
+    entries_[index].target = NULL;
+  }
+}
+
+
+int ForInCache::CollectMaps(JSObject* object, Map** maps) {
+  Heap* heap = object->GetHeap();
+  Object* current = object;
+  int length = 0;
+  while (current != heap->null_value()) {
+    if (length == kMaxChainLength || !current->IsJSObject()) return -1;
+    JSObject* holder = JSObject::cast(current);
+    Map* map = holder->map();
+    // Dictionary mode objects can gain or lose properties, and any object
+    // elements, without a map change.  String wrappers enumerate the
+    // characters of their value.
+    if (map->is_dictionary_map() ||
+        map->is_access_check_needed() ||
+        map->has_named_interceptor() ||
+        map->has_indexed_interceptor() ||
+        holder->IsJSValue() ||
+        holder->elements() != heap->empty_fixed_array()) {
+      return -1;
+    }
+    maps[length++] = map;
+    current = map->prototype();
+  }
+  return length;
+}
+
+
+FixedArray* ForInCache::Lookup(JSObject* object) {
+  Entry& entry = entries_[Hash(object->map())];
+  if (entry.keys == NULL) return NULL;
+  Map* maps[kMaxChainLength];
+  int length = CollectMaps(object, maps);
+  if (length <= 0) return NULL;
+  for (int i = 0; i < kMaxChainLength; i++) {
+    Map* map = i < length ? maps[i] : NULL;
+    if (entry.maps[i] != map) return NULL;
+  }
+  return entry.keys;
+}
+
+
+void ForInCache::Update(JSObject* object, FixedArray* keys) {
+  Map* maps[kMaxChainLength];
+  int length = CollectMaps(object, maps);
+  if (length <= 0) return;
+  Entry& entry = entries_[Hash(object->map())];
+  for (int i = 0; i < kMaxChainLength; i++) {
+    entry.maps[i] = i < length ? maps[i] : NULL;
+  }
+  entry.keys = keys;
+}
+
+
+void ForInCache::Clear() {
+  for (int index = 0; index < kLength; index++) {
+    for (int i = 0; i < kMaxChainLength; i++) entries_[index].maps[i] = NULL;
+    entries_[index].keys = NULL;
+  }
+}
+
+
 #ifdef DEBUG
 void Heap::GarbageCollectionGreedyCheck() {
   ASSERT(FLAG_gc_greedy);
@@ -7517,7 +8019,23 @@ void Heap::GarbageCollectionGreedyCheck() {
 #endif
 
 
-void ExternalStringTable::CleanUp() {
+void ExternalStringTable::CleanUp(bool old_space_strings_removed) {
+  // Compact the old space list first, so that strings promoted out of the
+  // new space list below are not visited a second time.
+  if (old_space_strings_removed) {
+    int last = 0;
+    for (int i = 0; i < old_space_strings_.length(); ++i) {
+      if (old_space_strings_[i] == heap_->the_hole_value()) {
+        continue;
+      }
+      ASSERT(old_space_strings_[i]->IsExternalString());
+      ASSERT(!heap_->InNewSpace(old_space_strings_[i]));
+      old_space_strings_[last++] = old_space_strings_[i];
+    }
+    old_space_strings_.Rewind(last);
+    old_space_strings_.Trim();
+  }
+
   int last = 0;
   for (int i = 0; i < new_space_strings_.length(); ++i) {
     if (new_space_strings_[i] == heap_->the_hole_value()) {
@@ -7532,18 +8050,6 @@ void ExternalStringTable::CleanUp() {
   }
   new_space_strings_.Rewind(last);
   new_space_strings_.Trim();
-
-  last = 0;
-  for (int i = 0; i < old_space_strings_.length(); ++i) {
-    if (old_space_strings_[i] == heap_->the_hole_value()) {
-      continue;
-    }
-    ASSERT(old_space_strings_[i]->IsExternalString());
-    ASSERT(!heap_->InNewSpace(old_space_strings_[i]));
-    old_space_strings_[last++] = old_space_strings_[i];
-  }
-  old_space_strings_.Rewind(last);
-  old_space_strings_.Trim();
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap) {
     Verify();
@@ -7564,6 +8070,49 @@ void ExternalStringTable::TearDown() {
 }
 
 
+class Heap::ExternalStringResourceDisposalTask : public v8::Task {
+ public:
+  explicit ExternalStringResourceDisposalTask(
+      const List<ExternalStringResource*>& resources) {
+    resources_.AddAll(resources);
+  }
+
+  virtual ~ExternalStringResourceDisposalTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() V8_OVERRIDE {
+    DisposeExternalStringResources(&resources_);
+  }
+
+  List<ExternalStringResource*> resources_;
+
+  DISALLOW_COPY_AND_ASSIGN(ExternalStringResourceDisposalTask);
+};
+
+
+void Heap::DisposeExternalStringResources(
+    List<ExternalStringResource*>* resources) {
+  for (int i = 0; i < resources->length(); i++) {
+    resources->at(i)->Dispose();
+  }
+  resources->Clear();
+}
+
+
+void Heap::DisposeQueuedExternalStringResources() {
+  if (external_string_resources_to_dispose_.is_empty()) return;
+  ASSERT(FLAG_concurrent_external_string_disposal);
+  // The resources are no longer reachable from the heap, so the task does
+  // not need to synchronize with the isolate.
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      new ExternalStringResourceDisposalTask(
+          external_string_resources_to_dispose_),
+      v8::Platform::kShortRunningTask);
+  external_string_resources_to_dispose_.Clear();
+}
+
+
 void Heap::QueueMemoryChunkForFree(MemoryChunk* chunk) {
   chunk->set_next_chunk(chunks_queued_for_free_);
   chunks_queued_for_free_ = chunk;
@@ -31,6 +31,7 @@
 #include <cmath>
 
 #include "allocation.h"
+#include "array-buffer-pool.h"
 #include "assert-scope.h"
 #include "globals.h"
 #include "incremental-marking.h"
@@ -199,8 +200,7 @@ namespace internal {
   V(Symbol, uninitialized_symbol, UninitializedSymbol)                         \
   V(Symbol, megamorphic_symbol, MegamorphicSymbol)                             \
   V(FixedArray, materialized_objects, MaterializedObjects)                     \
-  V(FixedArray, allocation_sites_scratchpad, AllocationSitesScratchpad)        \
-  V(JSObject, microtask_state, MicrotaskState)
+  V(FixedArray, allocation_sites_scratchpad, AllocationSitesScratchpad)
 
 // Entries in this list are limited to Smis and are not visited during GC.
 #define SMI_ROOT_LIST(V)                                                       \
@@ -324,6 +324,12 @@ namespace internal {
   V(illegal_execution_state_string, "illegal execution state")           \
   V(get_string, "get")                                                   \
   V(set_string, "set")                                                   \
+  V(has_string, "has")                                                   \
+  V(delete_string, "delete")                                             \
+  V(get_property_descriptor_string, "getPropertyDescriptor")             \
+  V(enumerable_string, "enumerable")                                     \
+  V(configurable_string, "configurable")                                 \
+  V(writable_string, "writable")                                         \
   V(map_field_string, "%map")                                            \
   V(elements_field_string, "%elements")                                  \
   V(length_field_string, "%length")                                      \
@@ -508,10 +514,13 @@ class ExternalStringTable {
   inline void AddString(String* string);
 
   inline void Iterate(ObjectVisitor* v);
+  inline void IterateNewSpaceStrings(ObjectVisitor* v);
+  inline void IterateOldSpaceStrings(ObjectVisitor* v);
 
   // Restores internal invariant and gets rid of collected strings.
-  // Must be called after each Iterate() that modified the strings.
-  void CleanUp();
+  // Must be called after each Iterate() that modified the strings. The old
+  // space list is only compacted if some of its entries were removed.
+  void CleanUp(bool old_space_strings_removed = true);
 
   // Destroys all allocated memory.
   void TearDown();
@@ -1154,7 +1163,8 @@ class Heap {
       const ExternalTwoByteString::Resource* resource);
 
   // Finalizes an external string by deleting the associated external
-  // data and clearing the resource pointer.
+  // data and clearing the resource pointer. During garbage collection the
+  // disposal can be deferred, see DisposeQueuedExternalStringResources.
   inline void FinalizeExternalString(String* string);
 
   // Allocates an uninitialized object.  The memory is non-executable if the
@@ -1251,6 +1261,10 @@ class Heap {
   // Last hope GC, should try to squeeze as much as possible.
   void CollectAllAvailableGarbage(const char* gc_reason = NULL);
 
+  // Performs a compacting full GC that releases all empty pages and
+  // uncommits as much of new space as possible.
+  void ReduceMemoryFootprint(const char* gc_reason = NULL);
+
   // Check whether the heap is currently iterable.
   bool IsHeapIterable();
 
@@ -1347,6 +1361,11 @@ class Heap {
 
   // Iterates over all roots in the heap.
   void IterateRoots(ObjectVisitor* v, VisitMode mode);
+  // Iterates over the same roots as IterateRoots, but leaves the global
+  // handles, the eternal handles and the handle scopes of archived threads
+  // to background tasks.  The visitor is shared by all of them, so it must
+  // tolerate concurrent calls on disjoint slots.
+  void IterateRootsInParallel(ObjectVisitor* v, VisitMode mode);
   // Iterates over all strong roots in the heap.
   void IterateStrongRoots(ObjectVisitor* v, VisitMode mode);
   // Iterates over entries in the smi roots list.  Only interesting to the
@@ -1439,6 +1458,15 @@ class Heap {
   // Verify the heap is in its normal state before or after a GC.
   void Verify();
 
+  // Returns whether the objects on the index-th page of a space are to be
+  // verified. With --verify-heap-sample=n only every n-th page is, and
+  // the sample moves on with every GC so that all pages are covered
+  // within n collections.
+  bool ShouldVerifyPage(int index) {
+    return FLAG_verify_heap_sample <= 1 ||
+        (index + gc_count_) % FLAG_verify_heap_sample == 0;
+  }
+
 
   bool weak_embedded_objects_verification_enabled() {
     return no_weak_object_verification_scope_depth_ == 0;
@@ -1474,6 +1502,14 @@ class Heap {
   // Print short heap statistics.
   void PrintShortHeapStatistics();
 
+  void SetGCStatisticsCallback(v8::Isolate::GCStatisticsCallback callback) {
+    gc_statistics_callback_ = callback;
+  }
+
+  v8::Isolate::GCStatisticsCallback gc_statistics_callback() {
+    return gc_statistics_callback_;
+  }
+
   // Write barrier support for address[offset] = o.
   INLINE(void RecordWrite(Address address, int offset));
 
@@ -1592,6 +1628,15 @@ class Heap {
 
   // Implements the corresponding V8 API function.
   bool IdleNotification(int hint);
+  void MemoryPressureNotification(v8::Isolate::MemoryPressureLevel level);
+
+  // Asks the platform for idle time to perform incremental marking and
+  // sweeping steps, unless an idle task is already pending.
+  void ScheduleIdleTask();
+
+  // Performs pending incremental marking or lazy sweeping work that fits
+  // into the given idle time. Returns true if work is left.
+  bool IdleTimeStep(int idle_time_in_ms);
 
   // Declare all the root indices.  This defines the root list order.
   enum RootListIndex {
@@ -1660,6 +1705,10 @@ class Heap {
   // Check new space expansion criteria and expand semispaces if it was hit.
   void CheckNewSpaceExpansionCriteria();
 
+  // Grows or shrinks the semispaces so that the expected scavenge pause
+  // approaches FLAG_scavenge_pause_target.
+  void AdjustNewSpaceCapacityForPauseTarget(double scavenge_time_ms);
+
   inline void IncrementYoungSurvivorsCounter(int survived) {
     ASSERT(survived >= 0);
     young_survivors_after_last_gc_ = survived;
@@ -1778,6 +1827,10 @@ class Heap {
     return &external_string_table_;
   }
 
+  ArrayBufferPool* array_buffer_pool() {
+    return &array_buffer_pool_;
+  }
+
   // Returns the current sweep generation.
   int sweep_generation() {
     return sweep_generation_;
@@ -1797,6 +1850,11 @@ class Heap {
   void QueueMemoryChunkForFree(MemoryChunk* chunk);
   void FreeQueuedChunks();
 
+  // Disposes of the external string resources whose strings died during the
+  // last garbage collection. With --concurrent_external_string_disposal the
+  // whole batch is handed to a background task.
+  void DisposeQueuedExternalStringResources();
+
   int gc_count() const { return gc_count_; }
 
   // Completely clear the Instanceof cache (to stop it keeping objects alive
@@ -1853,6 +1911,10 @@ class Heap {
 
   void DeoptMarkedAllocationSites();
 
+  // Resets the decision of every tenured allocation site so that it can be
+  // re-sampled. Returns true if dependent code has to be deoptimized.
+  bool DecayPretenuringDecisions();
+
   // ObjectStats are kept in two arrays, counts and sizes. Related stats are
   // stored in a contiguous linear buffer. Stats groups are stored one after
   // another.
@@ -2114,6 +2176,9 @@ class Heap {
   };
   List<GCEpilogueCallbackPair> gc_epilogue_callbacks_;
 
+  // Receives a v8::GCStatistics after every collection, or NULL.
+  v8::Isolate::GCStatisticsCallback gc_statistics_callback_;
+
   // Support for computing object sizes during GC.
   HeapObjectCallback gc_safe_size_of_old_object_;
   static int GcSafeSizeOfOldObject(HeapObject* object);
@@ -2310,6 +2375,10 @@ class Heap {
   // Flush the number to string cache.
   void FlushNumberStringCache();
 
+  // Drops the caches that only speed up execution and can be rebuilt on
+  // demand: compiled scripts, number strings, regexp results and stubs.
+  void ClearCachesForMemoryPressure();
+
   // Allocates a fixed-size allocation sites scratchpad.
   MUST_USE_RESULT MaybeObject* AllocateAllocationSitesScratchpad();
 
@@ -2337,6 +2406,8 @@ class Heap {
   int high_survival_rate_period_length_;
   int low_survival_rate_period_length_;
   double survival_rate_;
+  // Average scavenge throughput in bytes of survivors per ms.
+  double scavenge_speed_;
   SurvivalRateTrend previous_survival_rate_trend_;
   SurvivalRateTrend survival_rate_trend_;
 
@@ -2498,6 +2569,14 @@ class Heap {
   static const int kAllocationSiteScratchpadSize = 256;
   int allocation_sites_scratchpad_length_;
 
+  // The number of pretenuring feedback rounds since tenure decisions were
+  // last decayed, see FLAG_allocation_site_pretenuring_decay.
+  int gcs_since_pretenuring_decay_;
+
+  // The idle task posted to the platform, or NULL. The platform owns it.
+  class IdleTask;
+  IdleTask* idle_task_;
+
   static const int kMaxMarkSweepsInIdleRound = 7;
   static const int kIdleScavengeThreshold = 5;
 
@@ -2510,10 +2589,31 @@ class Heap {
 
   ExternalStringTable external_string_table_;
 
+  ArrayBufferPool array_buffer_pool_;
+
   VisitorDispatchTable<ScavengingCallback> scavenging_visitors_table_;
 
   MemoryChunk* chunks_queued_for_free_;
 
+  // Resources of external strings finalized during the current garbage
+  // collection, disposed of in one batch once it has finished.
+  typedef v8::String::ExternalStringResourceBase ExternalStringResource;
+  List<ExternalStringResource*> external_string_resources_to_dispose_;
+  class ExternalStringResourceDisposalTask;
+  static void DisposeExternalStringResources(
+      List<ExternalStringResource*>* resources);
+
+  // Maximal number of background tasks IterateRootsInParallel uses.
+  static const int kMaxRootsIteratingTasks = 8;
+  class RootsIteratingTask;
+  Semaphore pending_roots_iterating_tasks_semaphore_;
+
+  enum HandleRootsIteration { ITERATE_HANDLE_ROOTS, SKIP_HANDLE_ROOTS };
+  void IterateStrongRoots(ObjectVisitor* v,
+                          VisitMode mode,
+                          HandleRootsIteration handle_roots);
+  void IterateGlobalAndEternalHandles(ObjectVisitor* v, VisitMode mode);
+
   Mutex* relocation_mutex_;
 #ifdef DEBUG
   bool relocation_mutex_locked_by_optimizer_thread_;
@@ -2528,6 +2628,7 @@ class Heap {
   friend class MarkCompactCollector;
   friend class MarkCompactMarkingVisitor;
   friend class MapCompact;
+  friend class RegExpResultsCache;
 #ifdef VERIFY_HEAP
   friend class NoWeakObjectVerificationScope;
 #endif
@@ -2736,7 +2837,9 @@ class KeyedLookupCache {
   // Clear the cache.
   void Clear();
 
-  static const int kLength = 256;
+  // Keyed loads on tables with many string keys spread over only a few
+  // maps, so the cache needs considerably more buckets than there are maps.
+  static const int kLength = 1024;
   static const int kCapacityMask = kLength - 1;
   static const int kMapHashShift = 5;
   static const int kHashMask = -4;  // Zero the last two bits.
@@ -2849,6 +2952,112 @@ class DescriptorLookupCache {
 };
 
 
+// Cache for the field transition JSON.parse last followed from a map with
+// several transitions, such as the initial object map.  Lets the parser
+// match the key of the next document with the same shape against the raw
+// source characters instead of internalizing it first.
+// Cleared at startup and prior to any gc.
+class JsonTransitionCache {
+ public:
+  // Returns the cached key for transitions from |source| and stores the
+  // target in |target|, or returns NULL if absent.
+  Name* Lookup(Map* source, Map** target) {
+    Entry& entry = entries_[Hash(source)];
+    if (entry.source != source) return NULL;
+    *target = entry.target;
+    return entry.name;
+  }
+
+  // Update an element in the cache.
+  void Update(Map* source, Name* name, Map* target) {
+    ASSERT(name->IsUniqueName());
+    Entry& entry = entries_[Hash(source)];
+    entry.source = source;
+    entry.name = name;
+    entry.target = target;
+  }
+
+  // Clear the cache.
+  void Clear();
+
+ private:
+  JsonTransitionCache() {
+    Clear();
+  }
+
+  static int Hash(Map* source) {
+    // Uses only lower 32 bits if pointers are larger.
+    uint32_t source_hash =
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(source))
+            >> kPointerSizeLog2;
+    return source_hash % kLength;
+  }
+
+  static const int kLength = 64;
+  struct Entry {
+    Map* source;
+    Name* name;
+    Map* target;
+  };
+
+  Entry entries_[kLength];
+
+  friend class Isolate;
+  DISALLOW_COPY_AND_ASSIGN(JsonTransitionCache);
+};
+
+
+// Cache for the for-in key lists of fast mode objects whose prototypes
+// contribute enumerable properties, so that the map enum cache cannot be
+// used.  An entry is keyed by the maps of the receiver and of every object
+// on its prototype chain; a list is only cached when none of these objects
+// has elements, interceptors or access checks, so the maps determine it.
+// Cleared at startup and prior to any gc.
+class ForInCache {
+ public:
+  // Returns the cached key list for |object|, or NULL if absent.
+  FixedArray* Lookup(JSObject* object);
+
+  // Update an element in the cache.  Does nothing if the key list of
+  // |object| is not determined by the maps of its prototype chain.
+  void Update(JSObject* object, FixedArray* keys);
+
+  // Clear the cache.
+  void Clear();
+
+  static const int kMaxChainLength = 4;
+
+ private:
+  ForInCache() {
+    Clear();
+  }
+
+  // Collects the maps of the prototype chain starting at |object| into
+  // |maps| and returns how many there are, or -1 if the chain cannot
+  // be cached.
+  static int CollectMaps(JSObject* object, Map** maps);
+
+  static int Hash(Map* map) {
+    // Uses only lower 32 bits if pointers are larger.
+    uint32_t map_hash =
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(map))
+            >> kPointerSizeLog2;
+    return map_hash % kLength;
+  }
+
+  static const int kLength = 64;
+  struct Entry {
+    Map* maps[kMaxChainLength];
+    FixedArray* keys;
+  };
+
+  Entry entries_[kLength];
+
+  friend class Isolate;
+  DISALLOW_COPY_AND_ASSIGN(ForInCache);
+};
+
+
 // GCTracer collects and prints ONE line after each garbage collector
 // invocation IFF --trace_gc is used.
 
@@ -2928,6 +3137,20 @@ class GCTracer BASE_EMBEDDED {
   // Returns size of object in heap (in MB).
   inline double SizeOfHeapObjects();
 
+  // Passes the statistics of this collection to the embedder.
+  void ReportStatistics(double time);
+
+  // Whether the embedder installed a GCStatisticsCallback when the
+  // collection started.
+  bool report_statistics_;
+
+  // Size of objects in each space set in constructor, only recorded when
+  // statistics are reported to the embedder.
+  intptr_t start_space_size_[LAST_SPACE + 1];
+
+  // Free bytes on pages not yet swept when the collection started.
+  intptr_t start_unswept_bytes_;
+
   // Timestamp set in the constructor.
   double start_time_;
 
@@ -2988,31 +3211,61 @@ class GCTracer BASE_EMBEDDED {
 };
 
 
+// Caches the results of global regexp operations and string splits.  The
+// entries are flushed at mark-compact but survive scavenges.  Each cache
+// starts small and is replaced by a larger one on the first collision.
 class RegExpResultsCache {
  public:
-  enum ResultsCacheType { REGEXP_MULTIPLE_INDICES, STRING_SPLIT_SUBSTRINGS };
+  enum ResultsCacheType {
+    REGEXP_MULTIPLE_INDICES,
+    REGEXP_REPLACE_STRING,
+    STRING_SPLIT_SUBSTRINGS
+  };
 
   // Attempt to retrieve a cached result.  On failure, 0 is returned as a Smi.
-  // On success, the returned result is guaranteed to be a COW-array.
+  // On success, the returned result is guaranteed to be a COW-array.  The
+  // replacement string is part of the key for REGEXP_REPLACE_STRING only.
   static Object* Lookup(Heap* heap,
                         String* key_string,
                         Object* key_pattern,
-                        ResultsCacheType type);
+                        ResultsCacheType type,
+                        String* key_replacement = NULL);
   // Attempt to add value_array to the cache specified by type.  On success,
   // value_array is turned into a COW-array.
   static void Enter(Heap* heap,
                     String* key_string,
                     Object* key_pattern,
                     FixedArray* value_array,
-                    ResultsCacheType type);
+                    ResultsCacheType type,
+                    String* key_replacement = NULL);
   static void Clear(FixedArray* cache);
   static const int kRegExpResultsCacheSize = 0x100;
 
+  // Subjects that are not internalized are compared by content, and only
+  // cached if they are at least this long.
+  static const int kMinUninternalizedSubjectLength = 0x40;
+
  private:
+  // Returns the cache to use for the key, or NULL if it cannot be cached.
+  static FixedArray* CacheFor(Heap* heap,
+                              String* key_string,
+                              Object* key_pattern,
+                              ResultsCacheType type);
+  static bool EntryMatches(FixedArray* cache,
+                           int index,
+                           String* key_string,
+                           Object* key_pattern,
+                           Object* key_replacement);
+  static int FullSizeCacheLength(Heap* heap);
+  // Replaces the cache of the given type with an empty full size cache and
+  // returns it, or returns the old cache if that fails.
+  static FixedArray* Grow(Heap* heap, FixedArray* cache, ResultsCacheType type);
+
   static const int kArrayEntriesPerCacheEntry = 4;
   static const int kStringOffset = 0;
   static const int kPatternOffset = 1;
   static const int kArrayOffset = 2;
+  static const int kReplacementOffset = 3;
 };
 
 
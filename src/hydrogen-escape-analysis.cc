@@ -61,10 +61,92 @@ bool HEscapeAnalysisPhase::HasNoEscapingUses(HValue* value, int size) {
 }
 
 
+// Like HasNoEscapingUses, but the allocation may also flow into the given
+// phi. All other uses have to be in the block of the allocation.
+bool HEscapeAnalysisPhase::HasNoEscapingUsesBesidesPhi(HAllocate* allocate,
+                                                       HPhi* phi,
+                                                       int size) {
+  for (HUseIterator it(allocate->uses()); !it.Done(); it.Advance()) {
+    HValue* use = it.value();
+    if (use == phi) continue;
+    if (use->block() != allocate->block() ||
+        use->HasEscapingOperandAt(it.index()) ||
+        use->HasOutOfBoundsAccess(size) ||
+        use->RedefinedOperandIndex() == it.index()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+// A phi merging several allocations can be replaced as a whole when the
+// state of each allocation can stand in for the phi on all paths leaving
+// the allocation.  This holds when every input is an allocation of the same
+// constant size that is otherwise only used in its own block, and no use of
+// the phi can be reached from an allocation without passing the phi.
+bool HEscapeAnalysisPhase::IsCapturablePhi(HPhi* phi, int* size) {
+  HBasicBlock* phi_block = phi->block();
+  int size_in_bytes = -1;
+  for (int i = 0; i < phi->OperandCount(); i++) {
+    HValue* input = phi->OperandAt(i);
+    if (!input->IsAllocate()) return false;
+    HAllocate* allocate = HAllocate::cast(input);
+    if (!allocate->size()->IsInteger32Constant()) return false;
+    int input_size = allocate->size()->GetInteger32Constant();
+    if (size_in_bytes >= 0 && input_size != size_in_bytes) return false;
+    size_in_bytes = input_size;
+    if (!HasNoEscapingUsesBesidesPhi(allocate, phi, size_in_bytes)) {
+      return false;
+    }
+
+    // Uses of the phi after the allocation in the same block would see the
+    // state of the new object.
+    for (HInstruction* instr = allocate->next();
+         instr != NULL;
+         instr = instr->next()) {
+      for (int j = 0; j < instr->OperandCount(); j++) {
+        if (instr->OperandAt(j) == phi) return false;
+      }
+    }
+
+    // The same holds for uses of the phi in blocks reachable from the
+    // allocation without going through the phi's block.
+    BitVector visited(graph()->blocks()->length(), zone());
+    ZoneList<HBasicBlock*> worklist(4, zone());
+    worklist.Add(allocate->block(), zone());
+    while (!worklist.is_empty()) {
+      HBasicBlock* block = worklist.RemoveLast();
+      for (int j = 0; j < block->end()->SuccessorCount(); j++) {
+        HBasicBlock* succ = block->end()->SuccessorAt(j);
+        if (succ == phi_block || visited.Contains(succ->block_id())) continue;
+        if (phi_block->Dominates(succ)) return false;
+        visited.Add(succ->block_id());
+        worklist.Add(succ, zone());
+      }
+    }
+  }
+  if (size_in_bytes < 0) return false;
+  *size = size_in_bytes;
+  return true;
+}
+
+
 void HEscapeAnalysisPhase::CollectCapturedValues() {
   int block_count = graph()->blocks()->length();
   for (int i = 0; i < block_count; ++i) {
     HBasicBlock* block = graph()->blocks()->at(i);
+    for (int j = 0; j < block->phis()->length(); j++) {
+      HPhi* phi = block->phis()->at(j);
+      int size_in_bytes;
+      if (IsCapturablePhi(phi, &size_in_bytes) &&
+          HasNoEscapingUses(phi, size_in_bytes)) {
+        if (FLAG_trace_escape_analysis) {
+          PrintF("#%d (%s) is being captured\n", phi->id(), phi->Mnemonic());
+        }
+        captured_.Add(phi, zone());
+      }
+    }
     for (HInstructionIterator it(block); !it.Done(); it.Advance()) {
       HInstruction* instr = it.Current();
       if (!instr->IsAllocate()) continue;
@@ -161,14 +243,56 @@ HValue* HEscapeAnalysisPhase::NewMapCheckAndInsert(HCapturedObject* state,
 }
 
 
+// Whether the value is the captured object currently being replaced, or one
+// of the allocations merged by it.
+bool HEscapeAnalysisPhase::IsCaptured(HValue* value) {
+  if (value == current_) return true;
+  if (!current_->IsPhi() || !value->IsAllocate()) return false;
+  for (int i = 0; i < current_->OperandCount(); i++) {
+    if (current_->OperandAt(i) == value) return true;
+  }
+  return false;
+}
+
+
+int HEscapeAnalysisPhase::CapturedSize(HValue* value) {
+  if (value->IsPhi()) value = value->OperandAt(0);
+  return HAllocate::cast(value)->size()->GetInteger32Constant();
+}
+
+
+static HBasicBlock* CommonDominator(HBasicBlock* first, HBasicBlock* second) {
+  while (first != second) {
+    if (first->block_id() > second->block_id()) {
+      first = first->dominator();
+    } else {
+      second = second->dominator();
+    }
+  }
+  return first;
+}
+
+
 // Performs a forward data-flow analysis of all loads and stores on the
-// given captured allocation. This uses a reverse post-order iteration
-// over affected basic blocks. All non-escaping instructions are handled
-// and replaced during the analysis.
-void HEscapeAnalysisPhase::AnalyzeDataFlow(HInstruction* allocate) {
-  HBasicBlock* allocate_block = allocate->block();
+// given captured allocation or phi of allocations. This uses a reverse
+// post-order iteration over affected basic blocks. All non-escaping
+// instructions are handled and replaced during the analysis.
+void HEscapeAnalysisPhase::AnalyzeDataFlow(HValue* captured) {
+  current_ = captured;
   block_states_.AddBlock(NULL, graph()->blocks()->length(), zone());
 
+  // For a phi start at the block dominating all merged allocations, with a
+  // placeholder state for the paths on which no object exists yet.
+  HBasicBlock* allocate_block = captured->block();
+  if (captured->IsPhi()) {
+    for (int i = 0; i < captured->OperandCount(); i++) {
+      allocate_block = CommonDominator(allocate_block,
+                                       captured->OperandAt(i)->block());
+    }
+    SetStateAt(allocate_block,
+               NewStateForAllocation(allocate_block->first()));
+  }
+
   // Iterate all blocks starting with the allocation block, since the
   // allocation cannot dominate blocks that come before.
   int start = allocate_block->block_id();
@@ -187,14 +311,14 @@ void HEscapeAnalysisPhase::AnalyzeDataFlow(HInstruction* allocate) {
       HInstruction* instr = it.Current();
       switch (instr->opcode()) {
         case HValue::kAllocate: {
-          if (instr != allocate) continue;
-          state = NewStateForAllocation(allocate);
+          if (!IsCaptured(instr)) continue;
+          state = NewStateForAllocation(instr);
           break;
         }
         case HValue::kLoadNamedField: {
           HLoadNamedField* load = HLoadNamedField::cast(instr);
           int index = load->access().offset() / kPointerSize;
-          if (load->object() != allocate) continue;
+          if (!IsCaptured(load->object())) continue;
           ASSERT(load->access().IsInobject());
           HValue* replacement = state->OperandAt(index);
           load->DeleteAndReplaceWith(replacement);
@@ -207,7 +331,7 @@ void HEscapeAnalysisPhase::AnalyzeDataFlow(HInstruction* allocate) {
         case HValue::kStoreNamedField: {
           HStoreNamedField* store = HStoreNamedField::cast(instr);
           int index = store->access().offset() / kPointerSize;
-          if (store->object() != allocate) continue;
+          if (!IsCaptured(store->object())) continue;
           ASSERT(store->access().IsInobject());
           state = NewStateCopy(store->previous(), state);
           state->SetOperandAt(index, store->value());
@@ -228,20 +352,20 @@ void HEscapeAnalysisPhase::AnalyzeDataFlow(HInstruction* allocate) {
         case HValue::kCapturedObject:
         case HValue::kSimulate: {
           for (int i = 0; i < instr->OperandCount(); i++) {
-            if (instr->OperandAt(i) != allocate) continue;
+            if (!IsCaptured(instr->OperandAt(i))) continue;
             instr->SetOperandAt(i, state);
           }
           break;
         }
         case HValue::kCheckHeapObject: {
           HCheckHeapObject* check = HCheckHeapObject::cast(instr);
-          if (check->value() != allocate) continue;
+          if (!IsCaptured(check->value())) continue;
           check->DeleteAndReplaceWith(check->ActualValue());
           break;
         }
         case HValue::kCheckMaps: {
           HCheckMaps* mapcheck = HCheckMaps::cast(instr);
-          if (mapcheck->value() != allocate) continue;
+          if (!IsCaptured(mapcheck->value())) continue;
           NewMapCheckAndInsert(state, mapcheck);
           mapcheck->DeleteAndReplaceWith(mapcheck->ActualValue());
           break;
@@ -291,27 +415,42 @@ void HEscapeAnalysisPhase::AnalyzeDataFlow(HInstruction* allocate) {
   }
 
   // All uses have been handled.
-  ASSERT(allocate->HasNoUses());
-  allocate->DeleteAndReplaceWith(NULL);
+  ASSERT(captured->HasNoUses());
+  if (captured->IsPhi()) {
+    HPhi* phi = HPhi::cast(captured);
+    ZoneList<HValue*> inputs(phi->OperandCount(), zone());
+    for (int i = 0; i < phi->OperandCount(); i++) {
+      if (!inputs.Contains(phi->OperandAt(i))) {
+        inputs.Add(phi->OperandAt(i), zone());
+      }
+    }
+    phi->block()->RemovePhi(phi);
+    for (int i = 0; i < inputs.length(); i++) {
+      ASSERT(inputs[i]->HasNoUses());
+      inputs[i]->DeleteAndReplaceWith(NULL);
+    }
+  } else {
+    captured->DeleteAndReplaceWith(NULL);
+  }
+  current_ = NULL;
 }
 
 
 void HEscapeAnalysisPhase::PerformScalarReplacement() {
   for (int i = 0; i < captured_.length(); i++) {
-    HAllocate* allocate = HAllocate::cast(captured_.at(i));
+    HValue* captured = captured_.at(i);
 
     // Compute number of scalar values and start with clean slate.
-    int size_in_bytes = allocate->size()->GetInteger32Constant();
+    int size_in_bytes = CapturedSize(captured);
     number_of_values_ = size_in_bytes / kPointerSize;
     number_of_objects_++;
     block_states_.Clear();
 
     // Perform actual analysis step.
-    AnalyzeDataFlow(allocate);
+    AnalyzeDataFlow(captured);
 
     cumulative_values_ += number_of_values_;
-    ASSERT(allocate->HasNoUses());
-    ASSERT(!allocate->IsLinked());
+    ASSERT(captured->HasNoUses());
   }
 }
 
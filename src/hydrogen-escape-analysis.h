@@ -40,6 +40,7 @@ class HEscapeAnalysisPhase : public HPhase {
   explicit HEscapeAnalysisPhase(HGraph* graph)
       : HPhase("H_Escape analysis", graph),
         captured_(0, zone()),
+        current_(NULL),
         number_of_objects_(0),
         number_of_values_(0),
         cumulative_values_(0),
@@ -50,8 +51,12 @@ class HEscapeAnalysisPhase : public HPhase {
  private:
   void CollectCapturedValues();
   bool HasNoEscapingUses(HValue* value, int size);
+  bool HasNoEscapingUsesBesidesPhi(HAllocate* allocate, HPhi* phi, int size);
+  bool IsCapturablePhi(HPhi* phi, int* size);
+  bool IsCaptured(HValue* value);
+  int CapturedSize(HValue* value);
   void PerformScalarReplacement();
-  void AnalyzeDataFlow(HInstruction* instr);
+  void AnalyzeDataFlow(HValue* captured);
 
   HCapturedObject* NewState(HInstruction* prev);
   HCapturedObject* NewStateForAllocation(HInstruction* prev);
@@ -70,8 +75,12 @@ class HEscapeAnalysisPhase : public HPhase {
     block_states_.Set(block->block_id(), state);
   }
 
-  // List of allocations captured during collection phase.
-  ZoneList<HInstruction*> captured_;
+  // List of allocations and phis of allocations captured during collection
+  // phase.
+  ZoneList<HValue*> captured_;
+
+  // The allocation or phi currently being replaced by scalar values.
+  HValue* current_;
 
   // Number of captured objects on which scalar replacement was done.
   int number_of_objects_;
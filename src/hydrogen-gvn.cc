@@ -59,6 +59,10 @@ class HInstructionMap V8_FINAL : public ZoneObject {
     return new(zone) HInstructionMap(zone, this);
   }
 
+  // Overwrite this map with the contents of the other map, reusing the
+  // backing stores of this map where their sizes agree.
+  void CopyFrom(const HInstructionMap* other, Zone* zone);
+
   bool IsEmpty() const { return count_ == 0; }
 
  private:
@@ -170,6 +174,26 @@ HInstructionMap::HInstructionMap(Zone* zone, const HInstructionMap* other)
 }
 
 
+void HInstructionMap::CopyFrom(const HInstructionMap* other, Zone* zone) {
+  ASSERT(side_effects_tracker_ == other->side_effects_tracker_);
+  if (array_size_ != other->array_size_) {
+    array_size_ = other->array_size_;
+    array_ = zone->NewArray<HInstructionMapListElement>(array_size_);
+  }
+  if (lists_size_ != other->lists_size_) {
+    lists_size_ = other->lists_size_;
+    lists_ = zone->NewArray<HInstructionMapListElement>(lists_size_);
+  }
+  count_ = other->count_;
+  present_depends_on_ = other->present_depends_on_;
+  free_list_head_ = other->free_list_head_;
+  OS::MemCopy(
+      array_, other->array_, array_size_ * sizeof(HInstructionMapListElement));
+  OS::MemCopy(
+      lists_, other->lists_, lists_size_ * sizeof(HInstructionMapListElement));
+}
+
+
 void HInstructionMap::Kill(SideEffects changes) {
   if (!present_depends_on_.ContainsAnyOf(changes)) return;
   present_depends_on_.RemoveAll();
@@ -757,7 +781,16 @@ class GvnBasicBlockState: public ZoneObject {
                   bool copy_map,
                   Zone* zone) {
     block_ = block;
-    map_ = copy_map ? map->Copy(zone) : map;
+    if (!copy_map) {
+      map_ = map;
+    } else if (map_ != NULL) {
+      // A reused frame owns its map, whose subtree has been fully analyzed,
+      // so its backing store can be overwritten instead of reallocated.
+      ASSERT(map_ != map);
+      map_->CopyFrom(map, zone);
+    } else {
+      map_ = map->Copy(zone);
+    }
     dominated_index_ = -1;
     length_ = block->dominated_blocks()->length();
     if (dominators != NULL) {
@@ -771,7 +804,7 @@ class GvnBasicBlockState: public ZoneObject {
                      HInstructionMap* map,
                      HSideEffectMap* dominators,
                      Zone* zone)
-      : previous_(previous), next_(NULL) {
+      : previous_(previous), next_(NULL), map_(NULL) {
     Initialize(block, map, dominators, true, zone);
   }
 
@@ -2485,6 +2485,11 @@ void HEnterInlined::PrintDataTo(StringStream* stream) {
 }
 
 
+void HEnterTry::PrintDataTo(StringStream* stream) {
+  stream->Add("handler=%d", index());
+}
+
+
 static bool IsInteger32(double value) {
   double roundtrip_value = static_cast<double>(static_cast<int32_t>(value));
   return BitCast<int64_t>(roundtrip_value) == BitCast<int64_t>(value);
@@ -3703,7 +3708,18 @@ void HAllocate::PrintDataTo(StringStream* stream) {
 }
 
 
-bool HStoreKeyed::NeedsCanonicalization() {
+// Classifies a double value that is about to be stored into a
+// FixedDoubleArray: either it is known not to carry an arbitrary NaN bit
+// pattern (in particular the hole NaN), or it may, or that depends on the
+// operands it was computed from.
+enum DoubleNaNState {
+  CANONICAL_NAN,
+  ARBITRARY_NAN,
+  NAN_FROM_OPERANDS
+};
+
+
+static DoubleNaNState ClassifyStoredDouble(HValue* value, bool is_operand) {
   // If value is an integer or smi or comes from the result of a keyed load or
   // constant then it is either be a non-hole value or in the case of a constant
   // the hole is only being stored explicitly: no need for canonicalization.
@@ -3711,24 +3727,85 @@ bool HStoreKeyed::NeedsCanonicalization() {
   // The exception to that is keyed loads from external float or double arrays:
   // these can load arbitrary representation of NaN.
 
-  if (value()->IsConstant()) {
-    return false;
+  if (value->IsConstant()) {
+    return CANONICAL_NAN;
   }
 
-  if (value()->IsLoadKeyed()) {
-    return IsExternalFloatOrDoubleElementsKind(
-        HLoadKeyed::cast(value())->elements_kind());
+  if (value->IsLoadKeyed()) {
+    HLoadKeyed* load = HLoadKeyed::cast(value);
+    if (IsExternalFloatOrDoubleElementsKind(load->elements_kind())) {
+      return ARBITRARY_NAN;
+    }
+    // A hole loaded without a hole check may be copied as is, but must not
+    // leak into arithmetic whose result is stored.
+    if (is_operand && IsFastHoleyElementsKind(load->elements_kind()) &&
+        !load->RequiresHoleCheck()) {
+      return ARBITRARY_NAN;
+    }
+    return CANONICAL_NAN;
   }
 
-  if (value()->IsChange()) {
-    if (HChange::cast(value())->from().IsSmiOrInteger32()) {
-      return false;
+  if (value->IsChange()) {
+    if (HChange::cast(value)->from().IsSmiOrInteger32()) {
+      return CANONICAL_NAN;
     }
-    if (HChange::cast(value())->value()->type().IsSmi()) {
-      return false;
+    if (HChange::cast(value)->value()->type().IsSmi()) {
+      return CANONICAL_NAN;
     }
+    return ARBITRARY_NAN;
   }
-  return true;
+
+  // Double arithmetic either produces the default NaN or propagates the NaN
+  // of one of its inputs, so its result can only be the hole NaN if one of
+  // the inputs can. The same holds for phis.
+  if (value->representation().IsDouble() &&
+      (value->IsAdd() || value->IsSub() || value->IsMul() || value->IsDiv() ||
+       value->IsPhi())) {
+    return NAN_FROM_OPERANDS;
+  }
+  return ARBITRARY_NAN;
+}
+
+
+bool HStoreKeyed::NeedsCanonicalization() {
+  // Walk the double arithmetic feeding the stored value. Cycles through loop
+  // phis are fine: if every leaf is canonical, so is every value computed
+  // from those leaves.
+  const int kMaxVisitedValues = 16;
+  HValue* visited[kMaxVisitedValues];
+  int visited_count = 0;
+  visited[visited_count++] = value();
+  for (int i = 0; i < visited_count; i++) {
+    HValue* current = visited[i];
+    DoubleNaNState state = ClassifyStoredDouble(current, i > 0);
+    if (state == CANONICAL_NAN) continue;
+    if (state == ARBITRARY_NAN) return true;
+
+    HValue* inputs[2];
+    int input_count = 0;
+    if (current->IsPhi()) {
+      input_count = current->OperandCount();
+    } else {
+      HBinaryOperation* operation = HBinaryOperation::cast(current);
+      inputs[0] = operation->left();
+      inputs[1] = operation->right();
+      input_count = 2;
+    }
+    for (int j = 0; j < input_count; j++) {
+      HValue* input = current->IsPhi() ? current->OperandAt(j) : inputs[j];
+      bool seen = false;
+      for (int k = 0; k < visited_count; k++) {
+        if (visited[k] == input) {
+          seen = true;
+          break;
+        }
+      }
+      if (seen) continue;
+      if (visited_count == kMaxVisitedValues) return true;
+      visited[visited_count++] = input;
+    }
+  }
+  return false;
 }
 
 
@@ -4253,6 +4330,8 @@ HObjectAccess HObjectAccess::ForAllocationSiteOffset(int offset) {
       return HObjectAccess(kInobject, offset, Representation::Smi());
     case AllocationSite::kPretenureCreateCountOffset:
       return HObjectAccess(kInobject, offset, Representation::Smi());
+    case AllocationSite::kPretenureSurvivedBytesOffset:
+      return HObjectAccess(kInobject, offset, Representation::Smi());
     case AllocationSite::kDependentCodeOffset:
       return HObjectAccess(kInobject, offset, Representation::Tagged());
     case AllocationSite::kWeakNextOffset:
@@ -53,6 +53,7 @@ class HInstruction;
 class HLoopInformation;
 class HStoreNamedField;
 class HValue;
+class LEnvironment;
 class LInstruction;
 class LChunkBuilder;
 
@@ -112,6 +113,7 @@ class LChunkBuilder;
   V(DoubleBits)                                \
   V(DummyUse)                                  \
   V(EnterInlined)                              \
+  V(EnterTry)                                  \
   V(EnvironmentMarker)                         \
   V(ForceRepresentation)                       \
   V(ForInCacheArray)                           \
@@ -131,6 +133,7 @@ class LChunkBuilder;
   V(IsSmiAndBranch)                            \
   V(IsUndetectableAndBranch)                   \
   V(LeaveInlined)                              \
+  V(LeaveTry)                                  \
   V(LoadContextSlot)                           \
   V(LoadFieldByIndex)                          \
   V(LoadFunctionPrototype)                     \
@@ -2150,6 +2153,64 @@ class HLeaveInlined V8_FINAL : public HTemplateInstruction<0> {
 };
 
 
+// Pushes a try handler for the try block of the full-code try/catch
+// statement with the given handler index.  The instruction itself takes the
+// place of the handler on the environment's expression stack, and an
+// exception thrown inside the try block deoptimizes to the full-code catch
+// block using the environment captured here.
+class HEnterTry V8_FINAL : public HTemplateInstruction<0> {
+ public:
+  DECLARE_INSTRUCTION_FACTORY_P1(HEnterTry, int);
+
+  int index() const { return index_; }
+
+  LEnvironment* catch_environment() const { return catch_environment_; }
+  void set_catch_environment(LEnvironment* environment) {
+    catch_environment_ = environment;
+  }
+
+  virtual Representation RequiredInputRepresentation(int index) V8_OVERRIDE {
+    return Representation::None();
+  }
+
+  virtual int argument_delta() const V8_OVERRIDE {
+    return StackHandlerConstants::kSlotCount;
+  }
+
+  virtual void PrintDataTo(StringStream* stream) V8_OVERRIDE;
+
+  DECLARE_CONCRETE_INSTRUCTION(EnterTry)
+
+ private:
+  explicit HEnterTry(int index)
+      : index_(index), catch_environment_(NULL) {
+    set_representation(Representation::Tagged());
+  }
+
+  int index_;
+  LEnvironment* catch_environment_;
+};
+
+
+class HLeaveTry V8_FINAL : public HTemplateInstruction<0> {
+ public:
+  DECLARE_INSTRUCTION_FACTORY_P0(HLeaveTry);
+
+  virtual Representation RequiredInputRepresentation(int index) V8_OVERRIDE {
+    return Representation::None();
+  }
+
+  virtual int argument_delta() const V8_OVERRIDE {
+    return -StackHandlerConstants::kSlotCount;
+  }
+
+  DECLARE_CONCRETE_INSTRUCTION(LeaveTry)
+
+ private:
+  HLeaveTry() { }
+};
+
+
 class HPushArgument V8_FINAL : public HUnaryOperation {
  public:
   DECLARE_INSTRUCTION_FACTORY_P1(HPushArgument, HValue*);
@@ -5922,6 +5983,10 @@ class HObjectAccess V8_FINAL {
     return HObjectAccess(kInobject, SharedFunctionInfo::kFirstOsrAstIdSlot);
   }
 
+  static HObjectAccess ForOptimizedCodeMapAge() {
+    return HObjectAccess(kInobject, SharedFunctionInfo::kAgeSlot);
+  }
+
   static HObjectAccess ForOptimizedCodeMap() {
     return HObjectAccess(kInobject,
                          SharedFunctionInfo::kOptimizedCodeMapOffset);
@@ -5935,6 +6000,10 @@ class HObjectAccess V8_FINAL {
     return HObjectAccess(kMaps, JSObject::kMapOffset);
   }
 
+  static HObjectAccess ForMapDescriptors() {
+    return HObjectAccess(kInobject, Map::kDescriptorsOffset);
+  }
+
   static HObjectAccess ForMapInstanceSize() {
     return HObjectAccess(kInobject,
                          Map::kInstanceSizeOffset,
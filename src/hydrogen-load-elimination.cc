@@ -100,6 +100,32 @@ class HLoadEliminationTable : public ZoneObject {
         }
         break;
       }
+      case HValue::kLoadContextSlot: {
+        HLoadContextSlot* l = HLoadContextSlot::cast(instr);
+        TRACE((" process LC%d slot %d (c%d)\n",
+               instr->id(),
+               l->slot_index(),
+               l->value()->ActualValue()->id()));
+        HValue* result = load(l);
+        if (result != instr &&
+            result->type().Equals(instr->type()) &&
+            result->representation().Equals(instr->representation())) {
+          // The load can be replaced with a previous load or a value.
+          TRACE(("  replace LC%d -> v%d\n", instr->id(), result->id()));
+          instr->DeleteAndReplaceWith(result);
+        }
+        break;
+      }
+      case HValue::kStoreContextSlot: {
+        HStoreContextSlot* s = HStoreContextSlot::cast(instr);
+        TRACE((" process SC%d slot %d (c%d) = v%d\n",
+               instr->id(),
+               s->slot_index(),
+               s->context()->ActualValue()->id(),
+               s->value()->id()));
+        store(s);
+        break;
+      }
       case HValue::kTransitionElementsKind: {
         HTransitionElementsKind* t = HTransitionElementsKind::cast(instr);
         HValue* object = t->object()->ActualValue();
@@ -113,6 +139,11 @@ class HLoadEliminationTable : public ZoneObject {
           Kill();
           break;
         }
+        if (instr->CheckChangesFlag(kContextSlots)) {
+          TRACE((" kill-context-slots i%d\n", instr->id()));
+          Kill();
+          break;
+        }
         if (instr->CheckChangesFlag(kMaps)) {
           TRACE((" kill-maps i%d\n", instr->id()));
           KillOffset(JSObject::kMapOffset);
@@ -286,6 +317,46 @@ class HLoadEliminationTable : public ZoneObject {
     }
   }
 
+  // Process a context slot load. Context slots are tracked like the
+  // in-object fields of the context, so that stores to a slot can be
+  // forwarded to subsequent loads from the same context. Loads that check
+  // for the hole are never replaced.
+  HValue* load(HLoadContextSlot* instr) {
+    if (instr->mode() != HLoadContextSlot::kNoCheck) return instr;
+
+    int field = FieldOf(HObjectAccess::ForContextSlot(instr->slot_index()));
+    if (field < 0) return instr;
+
+    HValue* context = instr->value()->ActualValue();
+    HFieldApproximation* approx = FindOrCreate(context, field);
+
+    if (approx->last_value_ == NULL) {
+      approx->last_value_ = instr;
+      return instr;
+    } else if (approx->last_value_->block()->EqualToOrDominates(
+        instr->block())) {
+      return approx->last_value_;
+    } else {
+      return instr;
+    }
+  }
+
+  // Process a context slot store. Checked stores may leave the slot
+  // unchanged, so they only kill the aliasing entries.
+  void store(HStoreContextSlot* instr) {
+    int field = FieldOf(HObjectAccess::ForContextSlot(instr->slot_index()));
+    HValue* context = instr->context()->ActualValue();
+    if (field < 0) {
+      Kill();
+    } else if (instr->mode() != HStoreContextSlot::kNoCheck) {
+      KillFieldInternal(context, field, NULL);
+    } else {
+      HValue* value = instr->value();
+      KillFieldInternal(context, field, value);
+      FindOrCreate(context, field)->last_value_ = value;
+    }
+  }
+
   // Kill everything in this table.
   void Kill() {
     fields_.Rewind(0);
@@ -481,7 +552,8 @@ class HLoadEliminationEffects : public ZoneObject {
   void Apply(HLoadEliminationTable* table) {
     // Loads must not be hoisted past the OSR entry, therefore we kill
     // everything if we see an OSR entry.
-    if (flags_.Contains(kInobjectFields) || flags_.Contains(kOsrEntries)) {
+    if (flags_.Contains(kInobjectFields) || flags_.Contains(kOsrEntries) ||
+        flags_.Contains(kContextSlots)) {
       table->Kill();
       return;
     }
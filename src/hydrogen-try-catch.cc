@@ -0,0 +1,392 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "hydrogen-try-catch.h"
+
+namespace v8 {
+namespace internal {
+
+HTryCatchAnalysis::HTryCatchAnalysis(CompilationInfo* info,
+                                     TryCatchStatement* target)
+    : info_(info),
+      target_(target),
+      supported_(true),
+      in_try_block_(false),
+      after_try_block_(false),
+      target_in_loop_(false),
+      loop_depth_(0),
+      assigned_(4, info->zone()),
+      used_after_(4, info->zone()),
+      inner_targets_(4, info->zone()) {
+  InitializeAstVisitor(info->zone());
+}
+
+
+bool HTryCatchAnalysis::IsSupported() {
+  VisitStatements(info_->function()->body());
+  if (HasStackOverflow() || !supported_) return false;
+  if (assigned_.is_empty()) return true;
+  // A loop around the try statement re-enters the try block with the
+  // values assigned in an earlier iteration.
+  if (target_in_loop_) return false;
+  for (int i = 0; i < assigned_.length(); ++i) {
+    if (used_after_.Contains(assigned_[i])) return false;
+  }
+  return true;
+}
+
+
+void HTryCatchAnalysis::RecordTarget(BreakableStatement* stmt) {
+  if (in_try_block_) inner_targets_.Add(stmt, zone());
+}
+
+
+void HTryCatchAnalysis::RecordJump(BreakableStatement* target) {
+  if (in_try_block_ && !inner_targets_.Contains(target)) supported_ = false;
+}
+
+
+void HTryCatchAnalysis::RecordAssignment(Expression* target) {
+  VariableProxy* proxy = target->AsVariableProxy();
+  if (!in_try_block_ || proxy == NULL) return;
+  Variable* var = proxy->var();
+  if (var != NULL && var->IsStackAllocated() && !assigned_.Contains(var)) {
+    assigned_.Add(var, zone());
+  }
+}
+
+
+void HTryCatchAnalysis::VisitIterationBody(IterationStatement* stmt,
+                                           Statement* body) {
+  if (in_try_block_ && stmt->OsrEntryId() == info_->osr_ast_id()) {
+    supported_ = false;
+  }
+  loop_depth_++;
+  Visit(body);
+  loop_depth_--;
+}
+
+
+void HTryCatchAnalysis::VisitVariableDeclaration(VariableDeclaration* decl) {
+}
+
+
+void HTryCatchAnalysis::VisitFunctionDeclaration(FunctionDeclaration* decl) {
+}
+
+
+void HTryCatchAnalysis::VisitModuleDeclaration(ModuleDeclaration* decl) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitImportDeclaration(ImportDeclaration* decl) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitExportDeclaration(ExportDeclaration* decl) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitModuleLiteral(ModuleLiteral* module) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitModuleVariable(ModuleVariable* module) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitModulePath(ModulePath* module) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitModuleUrl(ModuleUrl* module) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitModuleStatement(ModuleStatement* stmt) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitBlock(Block* stmt) {
+  RecordTarget(stmt);
+  VisitStatements(stmt->statements());
+}
+
+
+void HTryCatchAnalysis::VisitExpressionStatement(ExpressionStatement* stmt) {
+  Visit(stmt->expression());
+}
+
+
+void HTryCatchAnalysis::VisitEmptyStatement(EmptyStatement* stmt) {
+}
+
+
+void HTryCatchAnalysis::VisitIfStatement(IfStatement* stmt) {
+  Visit(stmt->condition());
+  Visit(stmt->then_statement());
+  Visit(stmt->else_statement());
+}
+
+
+void HTryCatchAnalysis::VisitContinueStatement(ContinueStatement* stmt) {
+  RecordJump(stmt->target());
+}
+
+
+void HTryCatchAnalysis::VisitBreakStatement(BreakStatement* stmt) {
+  RecordJump(stmt->target());
+}
+
+
+void HTryCatchAnalysis::VisitReturnStatement(ReturnStatement* stmt) {
+  Visit(stmt->expression());
+}
+
+
+void HTryCatchAnalysis::VisitWithStatement(WithStatement* stmt) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitSwitchStatement(SwitchStatement* stmt) {
+  RecordTarget(stmt);
+  Visit(stmt->tag());
+  ZoneList<CaseClause*>* cases = stmt->cases();
+  for (int i = 0; i < cases->length(); ++i) {
+    Visit(cases->at(i));
+  }
+}
+
+
+void HTryCatchAnalysis::VisitCaseClause(CaseClause* clause) {
+  if (!clause->is_default()) Visit(clause->label());
+  VisitStatements(clause->statements());
+}
+
+
+void HTryCatchAnalysis::VisitDoWhileStatement(DoWhileStatement* stmt) {
+  RecordTarget(stmt);
+  VisitIterationBody(stmt, stmt->body());
+  loop_depth_++;
+  Visit(stmt->cond());
+  loop_depth_--;
+}
+
+
+void HTryCatchAnalysis::VisitWhileStatement(WhileStatement* stmt) {
+  RecordTarget(stmt);
+  loop_depth_++;
+  Visit(stmt->cond());
+  loop_depth_--;
+  VisitIterationBody(stmt, stmt->body());
+}
+
+
+void HTryCatchAnalysis::VisitForStatement(ForStatement* stmt) {
+  RecordTarget(stmt);
+  if (stmt->init() != NULL) Visit(stmt->init());
+  loop_depth_++;
+  if (stmt->cond() != NULL) Visit(stmt->cond());
+  if (stmt->next() != NULL) Visit(stmt->next());
+  loop_depth_--;
+  VisitIterationBody(stmt, stmt->body());
+}
+
+
+void HTryCatchAnalysis::VisitForInStatement(ForInStatement* stmt) {
+  RecordTarget(stmt);
+  Visit(stmt->enumerable());
+  RecordAssignment(stmt->each());
+  loop_depth_++;
+  Visit(stmt->each());
+  loop_depth_--;
+  VisitIterationBody(stmt, stmt->body());
+}
+
+
+void HTryCatchAnalysis::VisitForOfStatement(ForOfStatement* stmt) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitTryCatchStatement(TryCatchStatement* stmt) {
+  if (in_try_block_) {
+    supported_ = false;
+    return;
+  }
+  if (stmt != target_) {
+    Visit(stmt->try_block());
+    Visit(stmt->catch_block());
+    return;
+  }
+  target_in_loop_ = loop_depth_ > 0;
+  in_try_block_ = true;
+  Visit(stmt->try_block());
+  in_try_block_ = false;
+  after_try_block_ = true;
+  Visit(stmt->catch_block());
+}
+
+
+void HTryCatchAnalysis::VisitTryFinallyStatement(TryFinallyStatement* stmt) {
+  if (in_try_block_) {
+    supported_ = false;
+    return;
+  }
+  Visit(stmt->try_block());
+  Visit(stmt->finally_block());
+}
+
+
+void HTryCatchAnalysis::VisitDebuggerStatement(DebuggerStatement* stmt) {
+}
+
+
+void HTryCatchAnalysis::VisitFunctionLiteral(FunctionLiteral* expr) {
+  // Variables used by inner functions are context allocated.
+}
+
+
+void HTryCatchAnalysis::VisitNativeFunctionLiteral(
+    NativeFunctionLiteral* expr) {
+}
+
+
+void HTryCatchAnalysis::VisitConditional(Conditional* expr) {
+  Visit(expr->condition());
+  Visit(expr->then_expression());
+  Visit(expr->else_expression());
+}
+
+
+void HTryCatchAnalysis::VisitVariableProxy(VariableProxy* expr) {
+  if (!after_try_block_ || in_try_block_) return;
+  Variable* var = expr->var();
+  if (var != NULL && var->IsStackAllocated() && !used_after_.Contains(var)) {
+    used_after_.Add(var, zone());
+  }
+}
+
+
+void HTryCatchAnalysis::VisitLiteral(Literal* expr) {
+}
+
+
+void HTryCatchAnalysis::VisitRegExpLiteral(RegExpLiteral* expr) {
+}
+
+
+void HTryCatchAnalysis::VisitObjectLiteral(ObjectLiteral* expr) {
+  ZoneList<ObjectLiteral::Property*>* properties = expr->properties();
+  for (int i = 0; i < properties->length(); ++i) {
+    Visit(properties->at(i)->value());
+  }
+}
+
+
+void HTryCatchAnalysis::VisitArrayLiteral(ArrayLiteral* expr) {
+  VisitExpressions(expr->values());
+}
+
+
+void HTryCatchAnalysis::VisitAssignment(Assignment* expr) {
+  RecordAssignment(expr->target());
+  Visit(expr->target());
+  Visit(expr->value());
+}
+
+
+void HTryCatchAnalysis::VisitYield(Yield* expr) {
+  supported_ = false;
+}
+
+
+void HTryCatchAnalysis::VisitThrow(Throw* expr) {
+  Visit(expr->exception());
+}
+
+
+void HTryCatchAnalysis::VisitProperty(Property* expr) {
+  Visit(expr->obj());
+  Visit(expr->key());
+}
+
+
+void HTryCatchAnalysis::VisitCall(Call* expr) {
+  Visit(expr->expression());
+  VisitExpressions(expr->arguments());
+}
+
+
+void HTryCatchAnalysis::VisitCallNew(CallNew* expr) {
+  Visit(expr->expression());
+  VisitExpressions(expr->arguments());
+}
+
+
+void HTryCatchAnalysis::VisitCallRuntime(CallRuntime* expr) {
+  VisitExpressions(expr->arguments());
+}
+
+
+void HTryCatchAnalysis::VisitUnaryOperation(UnaryOperation* expr) {
+  Visit(expr->expression());
+}
+
+
+void HTryCatchAnalysis::VisitCountOperation(CountOperation* expr) {
+  RecordAssignment(expr->expression());
+  Visit(expr->expression());
+}
+
+
+void HTryCatchAnalysis::VisitBinaryOperation(BinaryOperation* expr) {
+  Visit(expr->left());
+  Visit(expr->right());
+}
+
+
+void HTryCatchAnalysis::VisitCompareOperation(CompareOperation* expr) {
+  Visit(expr->left());
+  Visit(expr->right());
+}
+
+
+void HTryCatchAnalysis::VisitThisFunction(ThisFunction* expr) {
+}
+
+} }  // namespace v8::internal
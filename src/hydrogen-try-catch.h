@@ -0,0 +1,77 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef V8_HYDROGEN_TRY_CATCH_H_
+#define V8_HYDROGEN_TRY_CATCH_H_
+
+#include "ast.h"
+#include "compiler.h"
+#include "zone.h"
+
+namespace v8 {
+namespace internal {
+
+// Decides whether the try block of a try/catch statement can be compiled
+// with a single handler whose catch environment is the environment at entry
+// to the try block.  That is the case when no stack-allocated variable that
+// is assigned inside the try block can be observed after an exception, and
+// control only leaves the try block by falling off its end, by returning or
+// by throwing.
+class HTryCatchAnalysis V8_FINAL : public AstVisitor {
+ public:
+  HTryCatchAnalysis(CompilationInfo* info, TryCatchStatement* target);
+
+  bool IsSupported();
+
+  DEFINE_AST_VISITOR_SUBCLASS_MEMBERS();
+
+ private:
+  void RecordTarget(BreakableStatement* stmt);
+  void RecordJump(BreakableStatement* target);
+  void RecordAssignment(Expression* target);
+  void VisitIterationBody(IterationStatement* stmt, Statement* body);
+
+#define DECLARE_VISIT(type) virtual void Visit##type(type* node) V8_OVERRIDE;
+  AST_NODE_LIST(DECLARE_VISIT)
+#undef DECLARE_VISIT
+
+  CompilationInfo* info_;
+  TryCatchStatement* target_;
+  bool supported_;
+  bool in_try_block_;
+  bool after_try_block_;
+  bool target_in_loop_;
+  int loop_depth_;
+  ZoneList<Variable*> assigned_;
+  ZoneList<Variable*> used_after_;
+  ZoneList<BreakableStatement*> inner_targets_;
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_HYDROGEN_TRY_CATCH_H_
@@ -55,6 +55,7 @@
 #include "hydrogen-removable-simulates.h"
 #include "hydrogen-representation-changes.h"
 #include "hydrogen-sce.h"
+#include "hydrogen-try-catch.h"
 #include "hydrogen-uint32-analysis.h"
 #include "lithium-allocator.h"
 #include "parser.h"
@@ -99,6 +100,7 @@ HBasicBlock::HBasicBlock(HGraph* graph)
       deleted_phis_(4, graph->zone()),
       parent_loop_header_(NULL),
       inlined_entry_block_(NULL),
+      try_entry_(NULL),
       is_inline_return_target_(false),
       is_reachable_(true),
       dominates_loop_successors_(false),
@@ -2096,10 +2098,47 @@ HValue* HGraphBuilder::BuildStringAdd(
     HAllocationMode allocation_mode) {
   NoObservableSideEffectsScope no_effects(this);
 
+  // Emptiness checks are only needed for strings not known to be
+  // non-empty.  Without any, the addition is straight-line code, so the
+  // allocations of consecutive additions stay in one block and get folded.
+  bool left_is_nonempty_constant = left->IsConstant() &&
+      HConstant::cast(left)->HasStringValue() &&
+      HConstant::cast(left)->StringValue()->length() > 0;
+  bool right_is_nonempty_constant = right->IsConstant() &&
+      HConstant::cast(right)->HasStringValue() &&
+      HConstant::cast(right)->StringValue()->length() > 0;
+  if (left_is_nonempty_constant && right_is_nonempty_constant) {
+    return BuildUncheckedStringAdd(left, right, allocation_mode);
+  }
+
   // Determine string lengths.
   HValue* left_length = AddLoadStringLength(left);
   HValue* right_length = AddLoadStringLength(right);
 
+  if (left_is_nonempty_constant || right_is_nonempty_constant) {
+    // Only the other string needs to be checked.
+    HValue* other_length =
+        left_is_nonempty_constant ? right_length : left_length;
+    HValue* constant = left_is_nonempty_constant ? left : right;
+    IfBuilder if_otherempty(this);
+    if_otherempty.If<HCompareNumericAndBranch>(
+        other_length, graph()->GetConstant0(), Token::EQ);
+    if_otherempty.Then();
+    {
+      // Count the native string addition.
+      AddIncrementCounter(isolate()->counters()->string_add_native());
+
+      // Just return the constant string.
+      Push(constant);
+    }
+    if_otherempty.Else();
+    {
+      Push(BuildUncheckedStringAdd(left, right, allocation_mode));
+    }
+    if_otherempty.End();
+    return Pop();
+  }
+
   // Check if left string is empty.
   IfBuilder if_leftempty(this);
   if_leftempty.If<HCompareNumericAndBranch>(
@@ -2985,8 +3024,12 @@ HOptimizedGraphBuilder::HOptimizedGraphBuilder(CompilationInfo* info)
       ast_context_(NULL),
       break_scope_(NULL),
       inlined_count_(0),
+      loop_nesting_depth_(0),
       globals_(10, info->zone()),
+      try_entry_(NULL),
       inline_bailout_(false),
+      in_peeled_loop_iteration_(false),
+      peeled_loop_size_(0),
       osr_(new(info->zone()) HOsrBuilder(this)) {
   // This is not initialized in the initializer list because the
   // constructor for the initial state relies on function_state_ == NULL
@@ -3081,6 +3124,7 @@ HGraph::HGraph(CompilationInfo* info)
       info_(info),
       zone_(info->zone()),
       is_recursive_(false),
+      has_try_catch_(false),
       use_optimistic_licm_(false),
       depends_on_empty_array_proto_elements_(false),
       type_change_checksum_(0),
@@ -3999,7 +4043,10 @@ bool HGraph::Optimize(BailoutReason* bailout_reason) {
   Verify(true);
 #endif
 
-  if (FLAG_analyze_environment_liveness && maximum_environment_size() != 0) {
+  // The catch environment of an optimized try block is not visible to the
+  // liveness analysis, so keep every environment value intact.
+  if (FLAG_analyze_environment_liveness && maximum_environment_size() != 0 &&
+      !has_try_catch()) {
     Run<HEnvironmentLivenessAnalysisPhase>();
   }
 
@@ -4018,7 +4065,9 @@ bool HGraph::Optimize(BailoutReason* bailout_reason) {
   Run<HMarkUnreachableBlocksPhase>();
 
   if (FLAG_dead_code_elimination) Run<HDeadCodeEliminationPhase>();
-  if (FLAG_use_escape_analysis) Run<HEscapeAnalysisPhase>();
+  if (FLAG_use_escape_analysis && !has_try_catch()) {
+    Run<HEscapeAnalysisPhase>();
+  }
 
   if (FLAG_load_elimination) Run<HLoadEliminationPhase>();
 
@@ -4324,6 +4373,7 @@ void HOptimizedGraphBuilder::VisitReturnStatement(ReturnStatement* stmt) {
     // Not an inlined return, so an actual one.
     CHECK_ALIVE(VisitForValue(stmt->expression()));
     HValue* result = environment()->Pop();
+    if (try_entry_ != NULL) Add<HLeaveTry>();
     Add<HReturn>(result);
   } else if (state->inlining_kind() == CONSTRUCT_CALL_RETURN) {
     // Return from an inlined construct call. In a test context the return value
@@ -4513,7 +4563,71 @@ void HOptimizedGraphBuilder::VisitLoopBody(IterationStatement* stmt,
       HStackCheck::cast(Add<HStackCheck>(HStackCheck::kBackwardsBranch));
   ASSERT(loop_entry->IsLoopHeader());
   loop_entry->loop_information()->set_stack_check(stack_check);
-  CHECK_BAILOUT(Visit(stmt->body()));
+  loop_nesting_depth_++;
+  Visit(stmt->body());
+  loop_nesting_depth_--;
+}
+
+
+bool HOptimizedGraphBuilder::ShouldPeelLoop(IterationStatement* stmt) {
+  return FLAG_hydrogen_loop_peeling &&
+      !in_peeled_loop_iteration_ &&
+      !osr()->HasOsrEntryAt(stmt) &&
+      peeled_loop_size_ < FLAG_hydrogen_loop_peeling_max_size;
+}
+
+
+void HOptimizedGraphBuilder::BuildPeeledLoopIteration(
+    IterationStatement* stmt,
+    Expression* cond,
+    BailoutId body_id,
+    Statement* next,
+    HBasicBlock** exit_block) {
+  int first_value_id = graph()->GetMaximumValueID();
+  HBasicBlock* loop_successor = NULL;
+  if (cond != NULL && !cond->ToBooleanIsTrue()) {
+    HBasicBlock* body_entry = graph()->CreateBasicBlock();
+    loop_successor = graph()->CreateBasicBlock();
+    CHECK_BAILOUT(VisitForControl(cond, body_entry, loop_successor));
+    if (body_entry->HasPredecessor()) {
+      body_entry->SetJoinId(body_id);
+      set_current_block(body_entry);
+    }
+    if (loop_successor->HasPredecessor()) {
+      loop_successor->SetJoinId(stmt->ExitId());
+    } else {
+      loop_successor = NULL;
+    }
+  }
+
+  // Breaks and continues in the first iteration get their own targets, the
+  // loop built afterwards uses a fresh BreakAndContinueInfo for stmt.
+  BreakAndContinueInfo break_info(stmt);
+  if (current_block() != NULL) {
+    BreakAndContinueScope push(&break_info, this);
+    bool outer_in_peeled_loop_iteration = in_peeled_loop_iteration_;
+    in_peeled_loop_iteration_ = true;
+    Visit(stmt->body());
+    in_peeled_loop_iteration_ = outer_in_peeled_loop_iteration;
+    if (HasStackOverflow()) return;
+  }
+  HBasicBlock* body_exit =
+      JoinContinue(stmt, current_block(), break_info.continue_block());
+  if (next != NULL && body_exit != NULL) {
+    set_current_block(body_exit);
+    CHECK_BAILOUT(Visit(next));
+    body_exit = current_block();
+  }
+
+  HBasicBlock* break_block = break_info.break_block();
+  if (break_block != NULL) {
+    if (loop_successor != NULL) Goto(loop_successor, break_block);
+    break_block->SetJoinId(stmt->ExitId());
+    loop_successor = break_block;
+  }
+  *exit_block = loop_successor;
+  set_current_block(body_exit);
+  peeled_loop_size_ += graph()->GetMaximumValueID() - first_value_id;
 }
 
 
@@ -4566,6 +4680,12 @@ void HOptimizedGraphBuilder::VisitWhileStatement(WhileStatement* stmt) {
   ASSERT(current_block() != NULL);
   ASSERT(current_block()->HasPredecessor());
   ASSERT(current_block() != NULL);
+  HBasicBlock* peeled_exit = NULL;
+  if (ShouldPeelLoop(stmt)) {
+    CHECK_BAILOUT(BuildPeeledLoopIteration(
+        stmt, stmt->cond(), stmt->BodyId(), NULL, &peeled_exit));
+    if (current_block() == NULL) return set_current_block(peeled_exit);
+  }
   HBasicBlock* loop_entry = BuildLoopEntry(stmt);
 
   // If the condition is constant true, do not generate a branch.
@@ -4596,7 +4716,7 @@ void HOptimizedGraphBuilder::VisitWhileStatement(WhileStatement* stmt) {
                                       body_exit,
                                       loop_successor,
                                       break_info.break_block());
-  set_current_block(loop_exit);
+  set_current_block(CreateJoin(peeled_exit, loop_exit, stmt->ExitId()));
 }
 
 
@@ -4608,6 +4728,12 @@ void HOptimizedGraphBuilder::VisitForStatement(ForStatement* stmt) {
     CHECK_ALIVE(Visit(stmt->init()));
   }
   ASSERT(current_block() != NULL);
+  HBasicBlock* peeled_exit = NULL;
+  if (ShouldPeelLoop(stmt)) {
+    CHECK_BAILOUT(BuildPeeledLoopIteration(
+        stmt, stmt->cond(), stmt->BodyId(), stmt->next(), &peeled_exit));
+    if (current_block() == NULL) return set_current_block(peeled_exit);
+  }
   HBasicBlock* loop_entry = BuildLoopEntry(stmt);
 
   HBasicBlock* loop_successor = NULL;
@@ -4644,7 +4770,7 @@ void HOptimizedGraphBuilder::VisitForStatement(ForStatement* stmt) {
                                       body_exit,
                                       loop_successor,
                                       break_info.break_block());
-  set_current_block(loop_exit);
+  set_current_block(CreateJoin(peeled_exit, loop_exit, stmt->ExitId()));
 }
 
 
@@ -4763,7 +4889,44 @@ void HOptimizedGraphBuilder::VisitTryCatchStatement(TryCatchStatement* stmt) {
   ASSERT(!HasStackOverflow());
   ASSERT(current_block() != NULL);
   ASSERT(current_block()->HasPredecessor());
-  return Bailout(kTryCatchStatement);
+  // Only the try block is compiled.  An exception thrown inside it lands in
+  // optimized code, which deoptimizes to the full-code catch block.
+  if (!FLAG_optimize_try_catch ||
+      function_state()->outer() != NULL ||
+      try_entry_ != NULL) {
+    return Bailout(kTryCatchStatement);
+  }
+  HTryCatchAnalysis analysis(current_info(), stmt);
+  if (!analysis.IsSupported()) return Bailout(kTryCatchStatement);
+
+  // The catch environment expects the exception on top of the stack.
+  environment()->Push(graph()->GetConstantHole());
+  Add<HSimulate>(stmt->HandlerId(), FIXED_SIMULATE);
+  HEnterTry* entry = Add<HEnterTry>(stmt->index());
+  Drop(1);
+  for (int i = 0; i < StackHandlerConstants::kSlotCount; ++i) {
+    environment()->Push(entry);
+  }
+  Add<HSimulate>(stmt->BodyId(), FIXED_SIMULATE);
+
+  int first_block = graph()->blocks()->length();
+  HBasicBlock* body_entry = graph()->CreateBasicBlock();
+  Goto(body_entry);
+  set_current_block(body_entry);
+  try_entry_ = entry;
+  Visit(stmt->try_block());
+  try_entry_ = NULL;
+  if (HasStackOverflow()) return;
+  for (int i = first_block; i < graph()->blocks()->length(); ++i) {
+    graph()->blocks()->at(i)->set_try_entry(entry);
+  }
+  graph()->MarkHasTryCatch();
+
+  if (current_block() != NULL) {
+    Add<HLeaveTry>();
+    Drop(StackHandlerConstants::kSlotCount);
+    Add<HSimulate>(stmt->ExitId(), FIXED_SIMULATE);
+  }
 }
 
 
@@ -6832,6 +6995,21 @@ HInstruction* HOptimizedGraphBuilder::BuildCallConstantFunction(
       (formal_parameter_count ==
        SharedFunctionInfo::kDontAdaptArgumentsSentinel);
   int arity = argument_count - 1;
+  // A callee that cannot observe its actual argument count is given the
+  // missing arguments right here.  The arguments already pushed by the
+  // caller are the receiver and the first |arity| parameters, so padding
+  // with undefined yields exactly the frame the adaptor would have built.
+  if (!dont_adapt_arguments &&
+      arity < formal_parameter_count &&
+      jsfun->shared()->is_compiled() &&
+      jsfun->shared()->dont_need_arguments_adaptation()) {
+    HValue* undefined = graph()->GetConstantUndefined();
+    for (int i = arity; i < formal_parameter_count; ++i) {
+      Add<HPushArgument>(undefined);
+    }
+    argument_count = formal_parameter_count + 1;
+    arity = formal_parameter_count;
+  }
   bool can_invoke_directly =
       dont_adapt_arguments || formal_parameter_count == arity;
   if (can_invoke_directly) {
@@ -6964,11 +7142,11 @@ void HOptimizedGraphBuilder::HandlePolymorphicCallNamed(
       // use the regular CallFunctionStub for method calls to wrap the receiver.
       // TODO(verwaest): Support creation of value wrappers directly in
       // HWrapReceiver.
+      PushArgumentsFromEnvironment(argument_count);
       HInstruction* call = needs_wrapping
           ? NewUncasted<HCallFunction>(
               function, argument_count, WRAP_AND_CALL)
           : BuildCallConstantFunction(target, argument_count);
-      PushArgumentsFromEnvironment(argument_count);
       AddInstruction(call);
       Drop(1);  // Drop the function.
       if (!ast_context()->IsEffect()) Push(call);
@@ -7036,8 +7214,10 @@ void HOptimizedGraphBuilder::TraceInline(Handle<JSFunction> target,
     SmartArrayPointer<char> caller_name =
         caller->shared()->DebugName()->ToCString();
     if (reason == NULL) {
-      PrintF("Inlined %s called from %s.\n", target_name.get(),
-             caller_name.get());
+      PrintF("Inlined %s called from %s (loop depth %d, %d cumulative AST "
+             "nodes, budget %d).\n", target_name.get(), caller_name.get(),
+             loop_nesting_depth_, inlined_count_,
+             FLAG_max_inlined_nodes_cumulative * InliningBudgetFactor());
     } else {
       PrintF("Did not inline %s called from %s (%s).\n",
              target_name.get(), caller_name.get(), reason);
@@ -7049,6 +7229,11 @@ void HOptimizedGraphBuilder::TraceInline(Handle<JSFunction> target,
 static const int kNotInlinable = 1000000000;
 
 
+int HOptimizedGraphBuilder::InliningBudgetFactor() const {
+  return 1 + Min(loop_nesting_depth_, Max(FLAG_inlining_loop_depth_bonus, 0));
+}
+
+
 int HOptimizedGraphBuilder::InliningAstSize(Handle<JSFunction> target) {
   if (!FLAG_use_inlining) return kNotInlinable;
 
@@ -7065,7 +7250,8 @@ int HOptimizedGraphBuilder::InliningAstSize(Handle<JSFunction> target) {
   // Do a quick check on source code length to avoid parsing large
   // inlining candidates.
   if (target_shared->SourceSize() >
-      Min(FLAG_max_inlined_source_size, kUnlimitedMaxInlinedSourceSize)) {
+      Min(FLAG_max_inlined_source_size * InliningBudgetFactor(),
+          kUnlimitedMaxInlinedSourceSize)) {
     TraceInline(target, caller, "target text too big");
     return kNotInlinable;
   }
@@ -7075,6 +7261,10 @@ int HOptimizedGraphBuilder::InliningAstSize(Handle<JSFunction> target) {
     TraceInline(target, caller, "target not inlineable");
     return kNotInlinable;
   }
+  if (isolate()->DebuggerPreventsOptimization(*target_shared)) {
+    TraceInline(target, caller, "target has break points");
+    return kNotInlinable;
+  }
   if (target_shared->dont_inline() || target_shared->dont_optimize()) {
     TraceInline(target, caller, "target contains unsupported syntax [early]");
     return kNotInlinable;
@@ -7096,8 +7286,11 @@ bool HOptimizedGraphBuilder::TryInline(Handle<JSFunction> target,
   if (nodes_added == kNotInlinable) return false;
 
   Handle<JSFunction> caller = current_info()->closure();
+  int budget_factor = InliningBudgetFactor();
+  int max_inlined_nodes =
+      Min(FLAG_max_inlined_nodes * budget_factor, kUnlimitedMaxInlinedNodes);
 
-  if (nodes_added > Min(FLAG_max_inlined_nodes, kUnlimitedMaxInlinedNodes)) {
+  if (nodes_added > max_inlined_nodes) {
     TraceInline(target, caller, "target AST is too large [early]");
     return false;
   }
@@ -7127,7 +7320,7 @@ bool HOptimizedGraphBuilder::TryInline(Handle<JSFunction> target,
   }
 
   // We don't want to add more than a certain number of nodes from inlining.
-  if (inlined_count_ > Min(FLAG_max_inlined_nodes_cumulative,
+  if (inlined_count_ > Min(FLAG_max_inlined_nodes_cumulative * budget_factor,
                            kUnlimitedMaxInlinedNodesCumulative)) {
     TraceInline(target, caller, "cumulative AST node limit reached");
     return false;
@@ -7155,7 +7348,7 @@ bool HOptimizedGraphBuilder::TryInline(Handle<JSFunction> target,
   // The following conditions must be checked again after re-parsing, because
   // earlier the information might not have been complete due to lazy parsing.
   nodes_added = function->ast_node_count();
-  if (nodes_added > Min(FLAG_max_inlined_nodes, kUnlimitedMaxInlinedNodes)) {
+  if (nodes_added > max_inlined_nodes) {
     TraceInline(target, caller, "target AST is too large [late]");
     return false;
   }
@@ -7844,6 +8037,12 @@ bool HOptimizedGraphBuilder::TryInlineApiCall(Handle<JSFunction> function,
     context()
   };
 
+  // All inlined API calls go through CallApiFunctionStub, which builds the
+  // implicit FunctionCallbackInfo arguments and an exit frame. Calling a
+  // callback with a plain C signature directly would additionally need a
+  // Lithium C call with per-port argument marshalling (and simulator
+  // redirection for mixed int/double signatures), plus a guarantee from the
+  // embedder that the callback neither allocates nor re-enters JavaScript.
   CallInterfaceDescriptor* descriptor =
       isolate()->call_descriptor(Isolate::ApiFunctionCall);
 
@@ -8019,21 +8218,34 @@ void HOptimizedGraphBuilder::VisitCall(Call* expr) {
         // the receiver.
         // TODO(verwaest): Support creation of value wrappers directly in
         // HWrapReceiver.
+        PushArgumentsFromEnvironment(argument_count);
         call = New<HCallFunction>(
             function, argument_count, WRAP_AND_CALL);
       } else if (TryInlineCall(expr)) {
         return;
       } else {
+        PushArgumentsFromEnvironment(argument_count);
         call = BuildCallConstantFunction(known_function, argument_count);
       }
 
+    } else if (!expr->target().is_null() &&
+               (receiver->type().IsJSObject() ||
+                !expr->target()->shared()->is_classic_mode() ||
+                expr->target()->shared()->native())) {
+      // The load did not yield a constant function, but the call site
+      // only ever saw one target and that target takes the receiver as is.
+      Add<HCheckValue>(function, expr->target());
+      CHECK_ALIVE(VisitExpressions(expr->arguments()));
+      if (TryInlineCall(expr)) return;
+      PushArgumentsFromEnvironment(argument_count);
+      call = New<HInvokeFunction>(function, expr->target(), argument_count);
     } else {
       CHECK_ALIVE(VisitExpressions(expr->arguments()));
+      PushArgumentsFromEnvironment(argument_count);
       CallFunctionFlags flags = receiver->type().IsJSObject()
           ? NO_CALL_FUNCTION_FLAGS : CALL_AS_METHOD;
       call = New<HCallFunction>(function, argument_count, flags);
     }
-    PushArgumentsFromEnvironment(argument_count);
 
   } else {
     VariableProxy* proxy = expr->expression()->AsVariableProxy();
@@ -8572,6 +8784,257 @@ void HOptimizedGraphBuilder::VisitTypedArrayInitialize(
 }
 
 
+void HOptimizedGraphBuilder::VisitTypedArrayGetLength(CallRuntime* expr) {
+  ASSERT(expr->arguments()->length() == 1);
+  CHECK_ALIVE(VisitForValue(expr->arguments()->at(0)));
+  HValue* object = Pop();
+
+  IfBuilder if_typed_array(this);
+  if_typed_array.If<HHasInstanceTypeAndBranch>(object, JS_TYPED_ARRAY_TYPE);
+  if_typed_array.Then();
+  {
+    HValue* length = Add<HLoadNamedField>(
+        object, static_cast<HValue*>(NULL),
+        HObjectAccess::ForJSTypedArrayLength());
+    if (!ast_context()->IsEffect()) Push(length);
+  }
+  if_typed_array.Else();
+  {
+    // Let the runtime throw for receivers that are not typed arrays.
+    Add<HPushArgument>(object);
+    HValue* result = Add<HCallRuntime>(expr->name(), expr->function(), 1);
+    if (!ast_context()->IsEffect()) Push(result);
+    Add<HSimulate>(expr->id(), FIXED_SIMULATE);
+  }
+  if_typed_array.End();
+
+  if (ast_context()->IsEffect()) {
+    return ast_context()->ReturnValue(graph()->GetConstantUndefined());
+  }
+  return ast_context()->ReturnValue(Pop());
+}
+
+
+// Returns the backing store index of the first byte of a |size| byte
+// DataView access at |offset|. The bounds checks deoptimize where the
+// runtime function would throw a RangeError and are visible to bounds
+// check elimination, so accesses at constant distances from the same
+// offset share a single check.
+HValue* HOptimizedGraphBuilder::BuildDataViewByteIndex(
+    HValue* view,
+    HValue* offset,
+    int size,
+    HValue** backing_store) {
+  offset = AddUncasted<HForceRepresentation>(offset,
+                                             Representation::Integer32());
+  HValue* byte_length = AddUncasted<HForceRepresentation>(
+      Add<HLoadNamedField>(view, static_cast<HValue*>(NULL),
+                           HObjectAccess::ForJSArrayBufferViewByteLength()),
+      Representation::Integer32());
+  HValue* checked_offset = Add<HBoundsCheck>(offset, byte_length);
+  if (size > 1) {
+    HValue* last = AddUncasted<HAdd>(checked_offset,
+                                     Add<HConstant>(size - 1));
+    Add<HBoundsCheck>(last, byte_length);
+  }
+
+  HValue* byte_offset = AddUncasted<HForceRepresentation>(
+      Add<HLoadNamedField>(view, static_cast<HValue*>(NULL),
+                           HObjectAccess::ForJSArrayBufferViewByteOffset()),
+      Representation::Integer32());
+  HValue* buffer = Add<HLoadNamedField>(
+      view, static_cast<HValue*>(NULL),
+      HObjectAccess::ForJSArrayBufferViewBuffer());
+  *backing_store = Add<HLoadNamedField>(
+      buffer, static_cast<HValue*>(NULL),
+      HObjectAccess::ForJSArrayBufferBackingStore());
+  return AddUncasted<HAdd>(byte_offset, checked_offset);
+}
+
+
+// Assembles |size| bytes starting at |index| into an int32. Loading byte
+// by byte keeps the access independent of alignment and host endianness.
+HValue* HOptimizedGraphBuilder::BuildDataViewLoadWord(HValue* backing_store,
+                                                      HValue* index,
+                                                      int size,
+                                                      bool little_endian) {
+  HValue* result = NULL;
+  for (int i = 0; i < size; ++i) {
+    HValue* key = i == 0
+        ? index : AddUncasted<HAdd>(index, Add<HConstant>(i));
+    HValue* byte = Add<HLoadKeyed>(backing_store, key,
+                                   static_cast<HValue*>(NULL),
+                                   EXTERNAL_UINT8_ELEMENTS);
+    int shift = (little_endian ? i : size - 1 - i) * kBitsPerByte;
+    if (shift != 0) byte = AddUncasted<HShl>(byte, Add<HConstant>(shift));
+    result = result == NULL
+        ? byte : AddUncasted<HBitwise>(Token::BIT_OR, result, byte);
+  }
+  return result;
+}
+
+
+HValue* HOptimizedGraphBuilder::BuildDataViewLoad(ExternalArrayType type,
+                                                  HValue* backing_store,
+                                                  HValue* index,
+                                                  bool little_endian) {
+  switch (type) {
+    case kExternalInt8Array:
+    case kExternalInt16Array: {
+      int size = type == kExternalInt8Array ? 1 : 2;
+      HValue* shift = Add<HConstant>((kInt32Size - size) * kBitsPerByte);
+      HValue* word = BuildDataViewLoadWord(
+          backing_store, index, size, little_endian);
+      return AddUncasted<HSar>(AddUncasted<HShl>(word, shift), shift);
+    }
+    case kExternalUint8Array:
+      return BuildDataViewLoadWord(backing_store, index, 1, little_endian);
+    case kExternalUint16Array:
+      return BuildDataViewLoadWord(backing_store, index, 2, little_endian);
+    case kExternalInt32Array:
+      return BuildDataViewLoadWord(backing_store, index, 4, little_endian);
+    case kExternalUint32Array: {
+      // Build the double 2^52 + word and subtract 2^52 again, which is
+      // exact for all uint32 values.
+      HValue* word = BuildDataViewLoadWord(
+          backing_store, index, 4, little_endian);
+      HValue* biased = AddUncasted<HConstructDouble>(
+          Add<HConstant>(0x43300000), word);
+      return AddUncasted<HSub>(biased, Add<HConstant>(4503599627370496.0));
+    }
+    case kExternalFloat64Array: {
+      HValue* first = BuildDataViewLoadWord(
+          backing_store, index, 4, little_endian);
+      HValue* second = BuildDataViewLoadWord(
+          backing_store, AddUncasted<HAdd>(index, Add<HConstant>(4)), 4,
+          little_endian);
+      return little_endian
+          ? AddUncasted<HConstructDouble>(second, first)
+          : AddUncasted<HConstructDouble>(first, second);
+    }
+    default:
+      UNREACHABLE();
+      return NULL;
+  }
+}
+
+
+void HOptimizedGraphBuilder::VisitDataViewGet(CallRuntime* expr,
+                                              ExternalArrayType type,
+                                              int size) {
+  // The DataView builtins check the receiver and convert the arguments
+  // before calling the runtime function.
+  ASSERT(expr->arguments()->length() == 3);
+  CHECK_ALIVE(VisitExpressions(expr->arguments()));
+  HValue* little_endian = Pop();
+  HValue* offset = Pop();
+  HValue* view = Pop();
+
+  HValue* backing_store;
+  HValue* index = BuildDataViewByteIndex(view, offset, size, &backing_store);
+  if (size == 1 || little_endian->IsConstant()) {
+    bool is_little_endian =
+        size == 1 || HConstant::cast(little_endian)->BooleanValue();
+    return ast_context()->ReturnValue(
+        BuildDataViewLoad(type, backing_store, index, is_little_endian));
+  }
+
+  IfBuilder if_little_endian(this);
+  if_little_endian.If<HCompareObjectEqAndBranch>(
+      little_endian, graph()->GetConstantTrue());
+  if_little_endian.Then();
+  Push(BuildDataViewLoad(type, backing_store, index, true));
+  if_little_endian.Else();
+  Push(BuildDataViewLoad(type, backing_store, index, false));
+  if_little_endian.End();
+  return ast_context()->ReturnValue(Pop());
+}
+
+
+void HOptimizedGraphBuilder::BuildDataViewStoreWord(HValue* backing_store,
+                                                    HValue* index,
+                                                    HValue* word,
+                                                    int size,
+                                                    bool little_endian) {
+  // Compute all bytes before the first store so that nothing between the
+  // stores can deoptimize.
+  HValue* bytes[kInt32Size];
+  for (int i = 0; i < size; ++i) {
+    int shift = (little_endian ? i : size - 1 - i) * kBitsPerByte;
+    bytes[i] = shift == 0
+        ? word : AddUncasted<HShr>(word, Add<HConstant>(shift));
+  }
+  for (int i = 0; i < size; ++i) {
+    HValue* key = i == 0
+        ? index : AddUncasted<HAdd>(index, Add<HConstant>(i));
+    Add<HStoreKeyed>(backing_store, key, bytes[i], EXTERNAL_UINT8_ELEMENTS);
+  }
+}
+
+
+void HOptimizedGraphBuilder::BuildDataViewStore(ExternalArrayType type,
+                                                HValue* backing_store,
+                                                HValue* index,
+                                                HValue* value,
+                                                bool little_endian) {
+  if (type == kExternalFloat64Array) {
+    HValue* hi = AddUncasted<HDoubleBits>(value, HDoubleBits::HIGH);
+    HValue* lo = AddUncasted<HDoubleBits>(value, HDoubleBits::LOW);
+    HValue* second_index = AddUncasted<HAdd>(index, Add<HConstant>(4));
+    BuildDataViewStoreWord(backing_store, index, little_endian ? lo : hi, 4,
+                           little_endian);
+    BuildDataViewStoreWord(backing_store, second_index,
+                           little_endian ? hi : lo, 4, little_endian);
+    return;
+  }
+
+  // Integer stores keep the low bits of ToInt32(value), like the runtime.
+  HInstruction* word = AddUncasted<HBitwise>(
+      Token::BIT_OR, value, graph()->GetConstant0());
+  if (word->IsBitwise()) {
+    HBitwise::cast(word)->set_observed_input_representation(
+        1, Representation::Integer32());
+    HBitwise::cast(word)->set_observed_input_representation(
+        2, Representation::Integer32());
+  }
+  int size = (type == kExternalInt8Array || type == kExternalUint8Array)
+      ? 1 : (type == kExternalInt16Array || type == kExternalUint16Array)
+      ? 2 : 4;
+  BuildDataViewStoreWord(backing_store, index, word, size, little_endian);
+}
+
+
+void HOptimizedGraphBuilder::VisitDataViewSet(CallRuntime* expr,
+                                              ExternalArrayType type,
+                                              int size) {
+  ASSERT(expr->arguments()->length() == 4);
+  CHECK_ALIVE(VisitExpressions(expr->arguments()));
+  HValue* little_endian = Pop();
+  HValue* value = Pop();
+  HValue* offset = Pop();
+  HValue* view = Pop();
+
+  HValue* backing_store;
+  HValue* index = BuildDataViewByteIndex(view, offset, size, &backing_store);
+  if (size == 1 || little_endian->IsConstant()) {
+    bool is_little_endian =
+        size == 1 || HConstant::cast(little_endian)->BooleanValue();
+    BuildDataViewStore(type, backing_store, index, value, is_little_endian);
+  } else {
+    IfBuilder if_little_endian(this);
+    if_little_endian.If<HCompareObjectEqAndBranch>(
+        little_endian, graph()->GetConstantTrue());
+    if_little_endian.Then();
+    BuildDataViewStore(type, backing_store, index, value, true);
+    if_little_endian.Else();
+    BuildDataViewStore(type, backing_store, index, value, false);
+    if_little_endian.End();
+  }
+  Add<HSimulate>(expr->id(), FIXED_SIMULATE);
+  return ast_context()->ReturnValue(graph()->GetConstantUndefined());
+}
+
+
 void HOptimizedGraphBuilder::VisitCallRuntime(CallRuntime* expr) {
   ASSERT(!HasStackOverflow());
   ASSERT(current_block() != NULL);
@@ -8591,6 +9054,30 @@ void HOptimizedGraphBuilder::VisitCallRuntime(CallRuntime* expr) {
     return VisitTypedArrayInitialize(expr);
   }
 
+  if (FLAG_inline_typed_array_accessors) {
+    switch (function->function_id) {
+      case Runtime::kTypedArrayGetLength:
+        return VisitTypedArrayGetLength(expr);
+#define DATA_VIEW_ACCESSOR_CASE(Type, size)                                   \
+      case Runtime::kDataViewGet##Type:                                       \
+        return VisitDataViewGet(expr, kExternal##Type##Array, size);          \
+      case Runtime::kDataViewSet##Type:                                       \
+        return VisitDataViewSet(expr, kExternal##Type##Array, size);
+      // Float32 accesses stay runtime calls, there is no instruction to
+      // reinterpret 32 bits as a single precision float.
+      DATA_VIEW_ACCESSOR_CASE(Int8, 1)
+      DATA_VIEW_ACCESSOR_CASE(Uint8, 1)
+      DATA_VIEW_ACCESSOR_CASE(Int16, 2)
+      DATA_VIEW_ACCESSOR_CASE(Uint16, 2)
+      DATA_VIEW_ACCESSOR_CASE(Int32, 4)
+      DATA_VIEW_ACCESSOR_CASE(Uint32, 4)
+      DATA_VIEW_ACCESSOR_CASE(Float64, 8)
+#undef DATA_VIEW_ACCESSOR_CASE
+      default:
+        break;
+    }
+  }
+
   if (function->function_id == Runtime::kMaxSmi) {
     ASSERT(expr->arguments()->length() == 0);
     HConstant* max_smi = New<HConstant>(static_cast<int32_t>(Smi::kMaxValue));
@@ -159,6 +159,10 @@ class HBasicBlock V8_FINAL : public ZoneObject {
   }
   HBasicBlock* inlined_entry_block() { return inlined_entry_block_; }
 
+  // For blocks inside an optimized try block: the handler they run under.
+  HEnterTry* try_entry() const { return try_entry_; }
+  void set_try_entry(HEnterTry* entry) { try_entry_ = entry; }
+
   bool IsDeoptimizing() const {
     return end() != NULL && end()->IsDeoptimize();
   }
@@ -226,6 +230,7 @@ class HBasicBlock V8_FINAL : public ZoneObject {
   HBasicBlock* parent_loop_header_;
   // For blocks marked as inline return target: the block with HEnterInlined.
   HBasicBlock* inlined_entry_block_;
+  HEnterTry* try_entry_;
   bool is_inline_return_target_ : 1;
   bool is_reachable_ : 1;
   bool dominates_loop_successors_ : 1;
@@ -435,6 +440,14 @@ class HGraph V8_FINAL : public ZoneObject {
     return is_recursive_;
   }
 
+  void MarkHasTryCatch() {
+    has_try_catch_ = true;
+  }
+
+  bool has_try_catch() const {
+    return has_try_catch_;
+  }
+
   void MarkDependsOnEmptyArrayProtoElements() {
     // Add map dependency if not already added.
     if (depends_on_empty_array_proto_elements_) return;
@@ -519,6 +532,7 @@ class HGraph V8_FINAL : public ZoneObject {
   Zone* zone_;
 
   bool is_recursive_;
+  bool has_try_catch_;
   bool use_optimistic_licm_;
   bool depends_on_empty_array_proto_elements_;
   int type_change_checksum_;
@@ -2135,6 +2149,20 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
                      HBasicBlock* loop_entry,
                      BreakAndContinueInfo* break_info);
 
+  // Loop peeling emits the first iteration of a while or for loop in front
+  // of the loop, so that checks it performs dominate the loop body and can
+  // be eliminated there by GVN and check elimination.
+  bool ShouldPeelLoop(IterationStatement* stmt);
+  // Builds the condition, body and next statement of the first iteration.
+  // Leaves the current block at the entry of the remaining loop, or NULL.
+  // The blocks leaving the loop during the first iteration are joined into
+  // *exit_block.
+  void BuildPeeledLoopIteration(IterationStatement* stmt,
+                                Expression* cond,
+                                BailoutId body_id,
+                                Statement* next,
+                                HBasicBlock** exit_block);
+
   // Create a back edge in the flow graph.  body_exit is the predecessor
   // block and loop_entry is the successor block.  loop_successor is the
   // block where control flow exits the loop normally (e.g., via failure of
@@ -2250,6 +2278,9 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
                               Handle<JSFunction> target);
 
   int InliningAstSize(Handle<JSFunction> target);
+  // Multiplier for the inlining budgets of the current call site. Call sites
+  // nested in loops are likely hot and get a larger share of the budget.
+  int InliningBudgetFactor() const;
   bool TryInline(Handle<JSFunction> target,
                  int arguments_count,
                  HValue* implicit_return_value,
@@ -2327,6 +2358,32 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
 
   void VisitDataViewInitialize(CallRuntime* expr);
 
+  void VisitTypedArrayGetLength(CallRuntime* expr);
+  void VisitDataViewGet(CallRuntime* expr, ExternalArrayType type, int size);
+  void VisitDataViewSet(CallRuntime* expr, ExternalArrayType type, int size);
+  HValue* BuildDataViewByteIndex(HValue* view,
+                                 HValue* offset,
+                                 int size,
+                                 HValue** backing_store);
+  HValue* BuildDataViewLoadWord(HValue* backing_store,
+                                HValue* index,
+                                int size,
+                                bool little_endian);
+  HValue* BuildDataViewLoad(ExternalArrayType type,
+                            HValue* backing_store,
+                            HValue* index,
+                            bool little_endian);
+  void BuildDataViewStoreWord(HValue* backing_store,
+                              HValue* index,
+                              HValue* word,
+                              int size,
+                              bool little_endian);
+  void BuildDataViewStore(ExternalArrayType type,
+                          HValue* backing_store,
+                          HValue* index,
+                          HValue* value,
+                          bool little_endian);
+
   class PropertyAccessInfo {
    public:
     PropertyAccessInfo(HOptimizedGraphBuilder* builder,
@@ -2617,10 +2674,22 @@ class HOptimizedGraphBuilder : public HGraphBuilder, public AstVisitor {
   BreakAndContinueScope* break_scope_;
 
   int inlined_count_;
+  // Number of loop bodies enclosing the code being built, including loops
+  // in the functions this one is inlined into.
+  int loop_nesting_depth_;
   ZoneList<Handle<Object> > globals_;
 
+  // The handler of the optimized try block being built, if any.
+  HEnterTry* try_entry_;
+
   bool inline_bailout_;
 
+  // Set while the first iteration of a loop is built. Loops nested in a
+  // peeled iteration are not peeled again.
+  bool in_peeled_loop_iteration_;
+  // Number of values created for peeled iterations of this graph.
+  int peeled_loop_size_;
+
   HOsrBuilder* osr_;
 
   friend class FunctionState;  // Pushes and pops the state stack.
@@ -45,12 +45,26 @@
 #include "unicode/uchar.h"
 #include "unicode/ucol.h"
 #include "unicode/ucurr.h"
+#include "unicode/uniset.h"
 #include "unicode/unum.h"
+#include "unicode/usetiter.h"
 #include "unicode/uversion.h"
 
 namespace v8 {
 namespace internal {
 
+// The weights of the ASCII characters on the first three collation levels,
+// as they appear in ICU sort keys. Comparing the concatenated weights level
+// by level gives the same result as comparing the sort keys.
+struct ASCIICollationWeights {
+  static const int kLevels = 3;
+  static const int kMaxWeightLength = 4;
+
+  uint8_t length[kLevels][128];
+  uint8_t bytes[kLevels][128][kMaxWeightLength];
+};
+
+
 namespace {
 
 bool ExtractStringSetting(Isolate* isolate,
@@ -797,6 +811,289 @@ void SetResolvedBreakIteratorSettings(Isolate* isolate,
   }
 }
 
+// Appends a string setting to the key of the ICU object cache. The value
+// is prefixed with its length so that keys cannot collide.
+void AppendStringSettingToKey(Isolate* isolate,
+                              Handle<JSObject> options,
+                              const char* key,
+                              icu::UnicodeString* cache_key) {
+  icu::UnicodeString value;
+  if (ExtractStringSetting(isolate, options, key, &value)) {
+    cache_key->append(icu::UnicodeString(key, -1, US_INV));
+    cache_key->append(static_cast<UChar>('='));
+    cache_key->append(static_cast<UChar>(value.length()));
+    cache_key->append(value);
+  }
+}
+
+
+void AppendIntegerSettingToKey(Isolate* isolate,
+                               Handle<JSObject> options,
+                               const char* key,
+                               icu::UnicodeString* cache_key) {
+  int32_t value;
+  if (ExtractIntegerSetting(isolate, options, key, &value)) {
+    char buffer[16];
+    OS::SNPrintF(Vector<char>(buffer, sizeof(buffer)), "%d;", value);
+    cache_key->append(icu::UnicodeString(key, -1, US_INV));
+    cache_key->append(static_cast<UChar>('='));
+    cache_key->append(icu::UnicodeString(buffer, -1, US_INV));
+  }
+}
+
+
+void AppendBooleanSettingToKey(Isolate* isolate,
+                               Handle<JSObject> options,
+                               const char* key,
+                               icu::UnicodeString* cache_key) {
+  bool value;
+  if (ExtractBooleanSetting(isolate, options, key, &value)) {
+    cache_key->append(icu::UnicodeString(key, -1, US_INV));
+    cache_key->append(static_cast<UChar>('='));
+    cache_key->append(static_cast<UChar>(value ? '1' : '0'));
+  }
+}
+
+
+// Starts the cache key with the ICU locale. Locale names never contain a
+// NUL character, so it can be used as the terminator.
+icu::UnicodeString CacheKeyForLocale(const icu::Locale& icu_locale) {
+  icu::UnicodeString cache_key(icu_locale.getName(), -1, US_INV);
+  cache_key.append(static_cast<UChar>(0));
+  return cache_key;
+}
+
+
+icu::UnicodeString DateFormatCacheKey(Isolate* isolate,
+                                      const icu::Locale& icu_locale,
+                                      Handle<JSObject> options) {
+  icu::UnicodeString cache_key = CacheKeyForLocale(icu_locale);
+  AppendStringSettingToKey(isolate, options, "timeZone", &cache_key);
+  AppendStringSettingToKey(isolate, options, "skeleton", &cache_key);
+  return cache_key;
+}
+
+
+icu::UnicodeString NumberFormatCacheKey(Isolate* isolate,
+                                        const icu::Locale& icu_locale,
+                                        Handle<JSObject> options) {
+  icu::UnicodeString cache_key = CacheKeyForLocale(icu_locale);
+  AppendStringSettingToKey(isolate, options, "style", &cache_key);
+  AppendStringSettingToKey(isolate, options, "currency", &cache_key);
+  AppendStringSettingToKey(isolate, options, "currencyDisplay", &cache_key);
+  AppendIntegerSettingToKey(
+      isolate, options, "minimumIntegerDigits", &cache_key);
+  AppendIntegerSettingToKey(
+      isolate, options, "minimumFractionDigits", &cache_key);
+  AppendIntegerSettingToKey(
+      isolate, options, "maximumFractionDigits", &cache_key);
+  AppendIntegerSettingToKey(
+      isolate, options, "minimumSignificantDigits", &cache_key);
+  AppendIntegerSettingToKey(
+      isolate, options, "maximumSignificantDigits", &cache_key);
+  AppendBooleanSettingToKey(isolate, options, "useGrouping", &cache_key);
+  return cache_key;
+}
+
+
+icu::UnicodeString CollatorCacheKey(Isolate* isolate,
+                                    const icu::Locale& icu_locale,
+                                    Handle<JSObject> options) {
+  icu::UnicodeString cache_key = CacheKeyForLocale(icu_locale);
+  AppendBooleanSettingToKey(isolate, options, "numeric", &cache_key);
+  AppendStringSettingToKey(isolate, options, "caseFirst", &cache_key);
+  AppendStringSettingToKey(isolate, options, "sensitivity", &cache_key);
+  AppendBooleanSettingToKey(isolate, options, "ignorePunctuation", &cache_key);
+  return cache_key;
+}
+
+
+// Splits the sort key of a single character into its primary, secondary
+// and tertiary weights. Returns false if a weight is too long.
+bool ParseASCIISortKey(const uint8_t* sort_key,
+                       int length,
+                       ASCIICollationWeights* weights,
+                       int c) {
+  int level = 0;
+  int weight_length = 0;
+  for (int i = 0; i < length; i++) {
+    uint8_t b = sort_key[i];
+    if (b == 0x00) break;
+    if (b == 0x01) {
+      if (++level == ASCIICollationWeights::kLevels) return false;
+      weight_length = 0;
+      continue;
+    }
+    if (weight_length == ASCIICollationWeights::kMaxWeightLength) {
+      return false;
+    }
+    weights->bytes[level][c][weight_length++] = b;
+    weights->length[level][c] = weight_length;
+  }
+  return level == ASCIICollationWeights::kLevels - 1;
+}
+
+
+// The attributes that the ASCII weights were computed with.
+bool HasDefaultCollationAttributes(const icu::Collator* collator) {
+  UErrorCode status = U_ZERO_ERROR;
+  bool result =
+      collator->getAttribute(UCOL_STRENGTH, status) == UCOL_TERTIARY &&
+      collator->getAttribute(UCOL_ALTERNATE_HANDLING, status) ==
+          UCOL_NON_IGNORABLE &&
+      collator->getAttribute(UCOL_CASE_FIRST, status) == UCOL_OFF &&
+      collator->getAttribute(UCOL_CASE_LEVEL, status) == UCOL_OFF &&
+      collator->getAttribute(UCOL_NUMERIC_COLLATION, status) == UCOL_OFF &&
+      collator->getAttribute(UCOL_FRENCH_COLLATION, status) == UCOL_OFF;
+  return U_SUCCESS(status) && result;
+}
+
+
+// Returns true if the collator sorts every ASCII string exactly like the
+// root collator which the weights were taken from.
+bool UsesRootASCIIWeights(const icu::Collator* collator,
+                          const ASCIICollationWeights* weights) {
+  if (!HasDefaultCollationAttributes(collator)) return false;
+
+  // A tailoring of an ASCII character or of a contraction made of ASCII
+  // characters changes the order of ASCII strings.
+  UErrorCode status = U_ZERO_ERROR;
+  icu::UnicodeSet* tailored = collator->getTailoredSet(status);
+  if (U_FAILURE(status) || tailored == NULL) {
+    delete tailored;
+    return false;
+  }
+  bool tailors_ascii = tailored->containsSome(0, 0x7f);
+  icu::UnicodeSetIterator it(*tailored);
+  while (!tailors_ascii && it.next()) {
+    if (!it.isString()) continue;
+    const icu::UnicodeString& string = it.getString();
+    bool is_ascii = true;
+    for (int i = 0; i < string.length(); i++) {
+      if (string.charAt(i) > 0x7f) is_ascii = false;
+    }
+    tailors_ascii = is_ascii;
+  }
+  delete tailored;
+  if (tailors_ascii) return false;
+
+  // Reordering of scripts does not show up in the tailored set, so check
+  // the weights of each character as well.
+  for (int c = 0; c < 128; c++) {
+    UChar u = static_cast<UChar>(c);
+    uint8_t sort_key[16];
+    int length = collator->getSortKey(&u, 1, sort_key, sizeof(sort_key));
+    if (length > static_cast<int>(sizeof(sort_key))) return false;
+    ASCIICollationWeights char_weights;
+    memset(&char_weights, 0, sizeof(char_weights));
+    if (!ParseASCIISortKey(sort_key, length, &char_weights, c)) return false;
+    for (int level = 0; level < ASCIICollationWeights::kLevels; level++) {
+      int weight_length = weights->length[level][c];
+      if (char_weights.length[level][c] != weight_length ||
+          memcmp(char_weights.bytes[level][c],
+                 weights->bytes[level][c],
+                 weight_length) != 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+// Streams the weight bytes of one level of an ASCII string.
+class ASCIIWeightIterator {
+ public:
+  ASCIIWeightIterator(const ASCIICollationWeights* weights,
+                      int level,
+                      Vector<const uint8_t> chars)
+      : weights_(weights), level_(level), chars_(chars), index_(0),
+        offset_(0) {}
+
+  // Returns the next weight byte, or -1 at the end of the string.
+  int Next() {
+    while (index_ < chars_.length()) {
+      int c = chars_[index_];
+      if (offset_ < weights_->length[level_][c]) {
+        return weights_->bytes[level_][c][offset_++];
+      }
+      index_++;
+      offset_ = 0;
+    }
+    return -1;
+  }
+
+ private:
+  const ASCIICollationWeights* weights_;
+  int level_;
+  Vector<const uint8_t> chars_;
+  int index_;
+  int offset_;
+};
+
+
+int CompareASCIIWithWeights(const ASCIICollationWeights* weights,
+                            Vector<const uint8_t> chars1,
+                            Vector<const uint8_t> chars2) {
+  for (int level = 0; level < ASCIICollationWeights::kLevels; level++) {
+    ASCIIWeightIterator it1(weights, level, chars1);
+    ASCIIWeightIterator it2(weights, level, chars2);
+    while (true) {
+      int b1 = it1.Next();
+      int b2 = it2.Next();
+      if (b1 != b2) return b1 < b2 ? UCOL_LESS : UCOL_GREATER;
+      if (b1 == -1) break;
+    }
+  }
+  return UCOL_EQUAL;
+}
+
+
+// Compares the fast path with ICU on all pairs of single characters and on
+// a fixed set of pseudo-random strings.
+bool VerifyASCIIWeights(const icu::Collator* collator,
+                        const ASCIICollationWeights* weights) {
+  static const int kRandomPairs = 2000;
+  static const int kMaxRandomLength = 8;
+  uint8_t chars1[kMaxRandomLength];
+  uint8_t chars2[kMaxRandomLength];
+  UChar uchars1[kMaxRandomLength];
+  UChar uchars2[kMaxRandomLength];
+  uint32_t seed = 0x2545F491;
+  for (int i = 0; i < 128 * 128 + kRandomPairs; i++) {
+    int length1 = 1;
+    int length2 = 1;
+    if (i < 128 * 128) {
+      chars1[0] = i >> 7;
+      chars2[0] = i & 0x7f;
+    } else {
+      seed = seed * 1103515245 + 12345;
+      length1 = 1 + (seed >> 8) % kMaxRandomLength;
+      length2 = 1 + (seed >> 16) % kMaxRandomLength;
+      for (int j = 0; j < kMaxRandomLength; j++) {
+        seed = seed * 1103515245 + 12345;
+        // Mostly letters and digits to produce many ties on the primary
+        // level, with some punctuation and control characters.
+        chars1[j] = (seed >> 24) & 0x7f;
+        chars2[j] = ((seed >> 16) & 0x3) == 0
+            ? (seed >> 8) & 0x7f : chars1[j] ^ 0x20;
+      }
+    }
+    for (int j = 0; j < length1; j++) uchars1[j] = chars1[j];
+    for (int j = 0; j < length2; j++) uchars2[j] = chars2[j];
+    UErrorCode status = U_ZERO_ERROR;
+    int expected =
+        collator->compare(uchars1, length1, uchars2, length2, status);
+    if (U_FAILURE(status)) return false;
+    int actual = CompareASCIIWithWeights(
+        weights,
+        Vector<const uint8_t>(chars1, length1),
+        Vector<const uint8_t>(chars2, length2));
+    if (actual != expected) return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 
@@ -812,6 +1109,102 @@ Handle<ObjectTemplateInfo> I18N::GetTemplate2(Isolate* isolate) {
 }
 
 
+ICUObjectCache::ICUObjectCache()
+    : next_(0),
+      root_ascii_weights_initialized_(false),
+      root_ascii_weights_(NULL) {
+}
+
+
+ICUObjectCache::~ICUObjectCache() {
+  Clear();
+  delete root_ascii_weights_;
+}
+
+
+ICUObjectCache::Entry* ICUObjectCache::Lookup(
+    Type type, const icu::UnicodeString& key) {
+  for (int i = 0; i < kSize; i++) {
+    Entry* entry = &entries_[i];
+    if (entry->object_ != NULL && entry->type_ == type &&
+        *entry->key_ == key) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+
+ICUObjectCache::Entry* ICUObjectCache::Insert(
+    Type type,
+    const icu::UnicodeString& key,
+    const icu::Locale& locale,
+    icu::UObject* object,
+    const ASCIICollationWeights* ascii_weights) {
+  Entry* entry = &entries_[next_];
+  next_ = (next_ + 1) % kSize;
+  delete entry->key_;
+  delete entry->locale_;
+  delete entry->object_;
+  entry->type_ = type;
+  entry->key_ = new icu::UnicodeString(key);
+  entry->locale_ = new icu::Locale(locale);
+  entry->object_ = object;
+  entry->ascii_weights_ = ascii_weights;
+  return entry;
+}
+
+
+void ICUObjectCache::Clear() {
+  for (int i = 0; i < kSize; i++) {
+    Entry* entry = &entries_[i];
+    delete entry->key_;
+    delete entry->locale_;
+    delete entry->object_;
+    entry->key_ = NULL;
+    entry->locale_ = NULL;
+    entry->object_ = NULL;
+    entry->ascii_weights_ = NULL;
+  }
+  next_ = 0;
+}
+
+
+const ASCIICollationWeights* ICUObjectCache::RootASCIIWeights() {
+  if (root_ascii_weights_initialized_) return root_ascii_weights_;
+  root_ascii_weights_initialized_ = true;
+
+  UErrorCode status = U_ZERO_ERROR;
+  icu::Collator* root =
+      icu::Collator::createInstance(icu::Locale::getRoot(), status);
+  if (U_FAILURE(status)) {
+    delete root;
+    return NULL;
+  }
+  root->setAttribute(UCOL_NORMALIZATION_MODE, UCOL_ON, status);
+
+  ASCIICollationWeights* weights = new ASCIICollationWeights();
+  memset(weights, 0, sizeof(*weights));
+  bool valid = U_SUCCESS(status) && HasDefaultCollationAttributes(root);
+  for (int c = 0; valid && c < 128; c++) {
+    UChar u = static_cast<UChar>(c);
+    uint8_t sort_key[16];
+    int length = root->getSortKey(&u, 1, sort_key, sizeof(sort_key));
+    valid = length <= static_cast<int>(sizeof(sort_key)) &&
+        ParseASCIISortKey(sort_key, length, weights, c);
+  }
+  if (valid) valid = VerifyASCIIWeights(root, weights);
+  delete root;
+
+  if (!valid) {
+    delete weights;
+    return NULL;
+  }
+  root_ascii_weights_ = weights;
+  return root_ascii_weights_;
+}
+
+
 // static
 icu::SimpleDateFormat* DateFormat::InitializeDateTimeFormat(
     Isolate* isolate,
@@ -833,6 +1226,21 @@ icu::SimpleDateFormat* DateFormat::InitializeDateTimeFormat(
     icu_locale = icu::Locale(icu_result);
   }
 
+  ICUObjectCache* cache = isolate->icu_object_cache();
+  icu::UnicodeString cache_key =
+      DateFormatCacheKey(isolate, icu_locale, options);
+  ICUObjectCache::Entry* entry =
+      cache->Lookup(ICUObjectCache::DATE_FORMAT, cache_key);
+  if (entry != NULL) {
+    icu::SimpleDateFormat* date_format = static_cast<icu::SimpleDateFormat*>(
+        static_cast<icu::SimpleDateFormat*>(entry->object())->clone());
+    if (date_format) {
+      SetResolvedDateSettings(
+          isolate, entry->locale(), date_format, resolved);
+      return date_format;
+    }
+  }
+
   icu::SimpleDateFormat* date_format = CreateICUDateFormat(
       isolate, icu_locale, options);
   if (!date_format) {
@@ -843,8 +1251,14 @@ icu::SimpleDateFormat* DateFormat::InitializeDateTimeFormat(
     // Set resolved settings (pattern, numbering system, calendar).
     SetResolvedDateSettings(
         isolate, no_extension_locale, date_format, resolved);
+    if (date_format) {
+      cache->Insert(ICUObjectCache::DATE_FORMAT, cache_key,
+                    no_extension_locale, date_format->clone(), NULL);
+    }
   } else {
     SetResolvedDateSettings(isolate, icu_locale, date_format, resolved);
+    cache->Insert(ICUObjectCache::DATE_FORMAT, cache_key,
+                  icu_locale, date_format->clone(), NULL);
   }
 
   return date_format;
@@ -906,6 +1320,21 @@ icu::DecimalFormat* NumberFormat::InitializeNumberFormat(
     icu_locale = icu::Locale(icu_result);
   }
 
+  ICUObjectCache* cache = isolate->icu_object_cache();
+  icu::UnicodeString cache_key =
+      NumberFormatCacheKey(isolate, icu_locale, options);
+  ICUObjectCache::Entry* entry =
+      cache->Lookup(ICUObjectCache::NUMBER_FORMAT, cache_key);
+  if (entry != NULL) {
+    icu::DecimalFormat* number_format = static_cast<icu::DecimalFormat*>(
+        static_cast<icu::DecimalFormat*>(entry->object())->clone());
+    if (number_format) {
+      SetResolvedNumberSettings(
+          isolate, entry->locale(), number_format, resolved);
+      return number_format;
+    }
+  }
+
   icu::DecimalFormat* number_format =
       CreateICUNumberFormat(isolate, icu_locale, options);
   if (!number_format) {
@@ -917,8 +1346,14 @@ icu::DecimalFormat* NumberFormat::InitializeNumberFormat(
     // Set resolved settings (pattern, numbering system).
     SetResolvedNumberSettings(
         isolate, no_extension_locale, number_format, resolved);
+    if (number_format) {
+      cache->Insert(ICUObjectCache::NUMBER_FORMAT, cache_key,
+                    no_extension_locale, number_format->clone(), NULL);
+    }
   } else {
     SetResolvedNumberSettings(isolate, icu_locale, number_format, resolved);
+    cache->Insert(ICUObjectCache::NUMBER_FORMAT, cache_key,
+                  icu_locale, number_format->clone(), NULL);
   }
 
   return number_format;
@@ -949,7 +1384,10 @@ icu::Collator* Collator::InitializeCollator(
     Isolate* isolate,
     Handle<String> locale,
     Handle<JSObject> options,
-    Handle<JSObject> resolved) {
+    Handle<JSObject> resolved,
+    const ASCIICollationWeights** ascii_weights) {
+  *ascii_weights = NULL;
+
   // Convert BCP47 into ICU locale format.
   UErrorCode status = U_ZERO_ERROR;
   icu::Locale icu_locale;
@@ -965,17 +1403,40 @@ icu::Collator* Collator::InitializeCollator(
     icu_locale = icu::Locale(icu_result);
   }
 
+  ICUObjectCache* cache = isolate->icu_object_cache();
+  icu::UnicodeString cache_key =
+      CollatorCacheKey(isolate, icu_locale, options);
+  ICUObjectCache::Entry* entry =
+      cache->Lookup(ICUObjectCache::COLLATOR, cache_key);
+  if (entry != NULL) {
+    icu::Collator* collator =
+        static_cast<icu::Collator*>(entry->object())->clone();
+    if (collator) {
+      SetResolvedCollatorSettings(
+          isolate, entry->locale(), collator, resolved);
+      *ascii_weights = entry->ascii_weights();
+      return collator;
+    }
+  }
+
   icu::Collator* collator = CreateICUCollator(isolate, icu_locale, options);
+  icu::Locale resolved_locale(icu_locale);
   if (!collator) {
     // Remove extensions and try again.
-    icu::Locale no_extension_locale(icu_locale.getBaseName());
-    collator = CreateICUCollator(isolate, no_extension_locale, options);
+    resolved_locale = icu::Locale(icu_locale.getBaseName());
+    collator = CreateICUCollator(isolate, resolved_locale, options);
+  }
 
-    // Set resolved settings (pattern, numbering system).
-    SetResolvedCollatorSettings(
-        isolate, no_extension_locale, collator, resolved);
-  } else {
-    SetResolvedCollatorSettings(isolate, icu_locale, collator, resolved);
+  // Set resolved settings (pattern, numbering system).
+  SetResolvedCollatorSettings(isolate, resolved_locale, collator, resolved);
+
+  if (collator) {
+    const ASCIICollationWeights* weights = cache->RootASCIIWeights();
+    if (weights != NULL && UsesRootASCIIWeights(collator, weights)) {
+      *ascii_weights = weights;
+    }
+    cache->Insert(ICUObjectCache::COLLATOR, cache_key, resolved_locale,
+                  collator->clone(), *ascii_weights);
   }
 
   return collator;
@@ -994,6 +1455,32 @@ icu::Collator* Collator::UnpackCollator(Isolate* isolate,
 }
 
 
+const ASCIICollationWeights* Collator::UnpackASCIIWeights(
+    Handle<JSObject> obj) {
+  return reinterpret_cast<const ASCIICollationWeights*>(
+      obj->GetInternalField(1));
+}
+
+
+bool Collator::CompareASCII(const ASCIICollationWeights* weights,
+                            String* string1,
+                            String* string2,
+                            int* result) {
+  DisallowHeapAllocation no_gc;
+  String::FlatContent content1 = string1->GetFlatContent();
+  String::FlatContent content2 = string2->GetFlatContent();
+  if (!content1.IsAscii() || !content2.IsAscii()) return false;
+  Vector<const uint8_t> chars1 = content1.ToOneByteVector();
+  Vector<const uint8_t> chars2 = content2.ToOneByteVector();
+  if (!String::IsAscii(chars1.start(), chars1.length()) ||
+      !String::IsAscii(chars2.start(), chars2.length())) {
+    return false;
+  }
+  *result = CompareASCIIWithWeights(weights, chars1, chars2);
+  return true;
+}
+
+
 void Collator::DeleteCollator(
     const v8::WeakCallbackData<v8::Value, void>& data) {
   DeleteNativeObjectAt<icu::Collator>(data, 0);
@@ -36,7 +36,10 @@ namespace U_ICU_NAMESPACE {
 class BreakIterator;
 class Collator;
 class DecimalFormat;
+class Locale;
 class SimpleDateFormat;
+class UObject;
+class UnicodeString;
 }
 
 namespace v8 {
@@ -55,6 +58,76 @@ class I18N {
 };
 
 
+struct ASCIICollationWeights;
+
+
+// Keeps the ICU objects created for recently used combinations of locale
+// and options. Creating a collator or formatter makes ICU load and process
+// locale data, which is much slower than cloning an existing instance with
+// the same settings.
+class ICUObjectCache {
+ public:
+  enum Type {
+    COLLATOR,
+    DATE_FORMAT,
+    NUMBER_FORMAT
+  };
+
+  class Entry {
+   public:
+    Entry() : key_(NULL), locale_(NULL), object_(NULL),
+              ascii_weights_(NULL) {}
+
+    // The prototype that new objects are cloned from.
+    icu::UObject* object() { return object_; }
+    // The locale the prototype was created for, after fallbacks.
+    const icu::Locale& locale() { return *locale_; }
+    // The weights for the ASCII fast path of a collator, or NULL.
+    const ASCIICollationWeights* ascii_weights() { return ascii_weights_; }
+
+   private:
+    Type type_;
+    icu::UnicodeString* key_;
+    icu::Locale* locale_;
+    icu::UObject* object_;
+    const ASCIICollationWeights* ascii_weights_;
+
+    friend class ICUObjectCache;
+  };
+
+  ICUObjectCache();
+  ~ICUObjectCache();
+
+  // Returns the entry for the given key, or NULL.
+  Entry* Lookup(Type type, const icu::UnicodeString& key);
+
+  // Adds an entry, replacing an older one if the cache is full. The cache
+  // takes ownership of the object.
+  Entry* Insert(Type type,
+                const icu::UnicodeString& key,
+                const icu::Locale& locale,
+                icu::UObject* object,
+                const ASCIICollationWeights* ascii_weights);
+
+  // Drops all entries, e.g. after the default time zone changed.
+  void Clear();
+
+  // Returns the collation weights of ASCII characters in the root locale,
+  // or NULL if they cannot be represented in an ASCIICollationWeights.
+  const ASCIICollationWeights* RootASCIIWeights();
+
+ private:
+  static const int kSize = 32;
+
+  Entry entries_[kSize];
+  int next_;
+  bool root_ascii_weights_initialized_;
+  ASCIICollationWeights* root_ascii_weights_;
+
+  DISALLOW_COPY_AND_ASSIGN(ICUObjectCache);
+};
+
+
 class DateFormat {
  public:
   // Create a formatter for the specificied locale and options. Returns the
@@ -106,16 +179,30 @@ class NumberFormat {
 class Collator {
  public:
   // Create a collator for the specificied locale and options. Returns the
-  // resolved settings for the locale / options.
+  // resolved settings for the locale / options, and the weights for the
+  // ASCII fast path if the collator orders ASCII strings like the root
+  // locale with default attributes.
   static icu::Collator* InitializeCollator(
       Isolate* isolate,
       Handle<String> locale,
       Handle<JSObject> options,
-      Handle<JSObject> resolved);
+      Handle<JSObject> resolved,
+      const ASCIICollationWeights** ascii_weights);
 
   // Unpacks collator object from corresponding JavaScript object.
   static icu::Collator* UnpackCollator(Isolate* isolate, Handle<JSObject> obj);
 
+  // Unpacks the ASCII fast path weights from the JavaScript object, or
+  // returns NULL if the collator has none.
+  static const ASCIICollationWeights* UnpackASCIIWeights(Handle<JSObject> obj);
+
+  // Compares two flat strings with the ASCII fast path. Returns false if
+  // one of the strings contains non-ASCII characters.
+  static bool CompareASCII(const ASCIICollationWeights* weights,
+                           String* string1,
+                           String* string2,
+                           int* result);
+
   // Release memory we allocated for the Collator once the JS object that holds
   // the pointer gets garbage collected.
   static void DeleteCollator(
@@ -1947,9 +1947,31 @@ var defaultObjects = {
 };
 
 
+// Instances created with a single locale string and no options, per service
+// and locale. A service's cache is dropped once it holds too many locales.
+var localeObjects = {
+  'collator': undefined,
+  'numberformat': undefined,
+  'dateformatall': undefined,
+  'dateformatdate': undefined,
+  'dateformattime': undefined,
+};
+
+var localeObjectsCount = {
+  'collator': 0,
+  'numberformat': 0,
+  'dateformatall': 0,
+  'dateformatdate': 0,
+  'dateformattime': 0,
+};
+
+var MAX_LOCALE_OBJECTS_PER_SERVICE = 32;
+
+
 /**
  * Returns cached or newly created instance of a given service.
- * We cache only default instances (where no locales or options are provided).
+ * We cache default instances (where no locales or options are provided) and
+ * instances for a single locale string without options.
  */
 function cachedOrNewService(service, locales, options, defaults) {
   var useOptions = (defaults === undefined) ? options : defaults;
@@ -1959,6 +1981,21 @@ function cachedOrNewService(service, locales, options, defaults) {
     }
     return defaultObjects[service];
   }
+  if (typeof locales === 'string' && options === undefined) {
+    var cache = localeObjects[service];
+    if (cache === undefined ||
+        localeObjectsCount[service] >= MAX_LOCALE_OBJECTS_PER_SERVICE) {
+      cache = localeObjects[service] = {};
+      localeObjectsCount[service] = 0;
+    }
+    // Prefix the key so that it cannot clash with Object.prototype.
+    var key = '#' + locales;
+    if (!cache.hasOwnProperty(key)) {
+      cache[key] = new savedObjects[service](locales, useOptions);
+      localeObjectsCount[service]++;
+    }
+    return cache[key];
+  }
   return new savedObjects[service](locales, useOptions);
 }
 
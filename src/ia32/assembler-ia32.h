@@ -625,7 +625,10 @@ class Assembler : public AssemblerBase {
 
   // Read/Modify the code target in the branch/call instruction at pc.
   inline static Address target_address_at(Address pc);
-  inline static void set_target_address_at(Address pc, Address target);
+  inline static void set_target_address_at(
+      Address pc,
+      Address target,
+      ICacheFlushMode icache_flush_mode = FLUSH_ICACHE_IF_NEEDED);
 
   // Return the code target address at a call site from the return address
   // of that call in the instruction stream.
@@ -170,6 +170,26 @@ void KeyedLoadFieldStub::InitializeInterfaceDescriptor(
 }
 
 
+void LoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { edx };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
+void KeyedLoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { edx };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
 void KeyedStoreFastElementStub::InitializeInterfaceDescriptor(
     Isolate* isolate,
     CodeStubInterfaceDescriptor* descriptor) {
@@ -2594,6 +2614,8 @@ void CodeStub::GenerateStubsAheadOfTime(Isolate* isolate) {
     BinaryOpICStub::GenerateAheadOfTime(isolate);
     BinaryOpICWithAllocationSiteStub::GenerateAheadOfTime(isolate);
   }
+  KeyedLoadFastElementStub::GenerateAheadOfTime(isolate);
+  TransitionElementsKindStub::GenerateAheadOfTime(isolate);
 }
 
 
@@ -3457,6 +3479,15 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ cmp(ecx, Immediate(Smi::FromInt(1)));
   __ j(equal, &single_char);
 
+  // Empty substrings need no allocation.
+  Label not_empty;
+  __ test(ecx, ecx);
+  __ j(not_zero, &not_empty);
+  __ mov(eax, masm->isolate()->factory()->empty_string());
+  __ IncrementCounter(counters->sub_string_native(), 1);
+  __ ret(3 * kPointerSize);
+  __ bind(&not_empty);
+
   // eax: string
   // ebx: instance type
   // ecx: sub string length (smi)
@@ -2580,7 +2580,7 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
     // Push the target function under the receiver.
     __ push(Operand(esp, 0));
     __ mov(Operand(esp, kPointerSize), eax);
-    flags = CALL_AS_METHOD;
+    flags = RECORD_CALL_TARGET_AS_METHOD;
   }
 
   // Load the arguments.
@@ -2592,6 +2592,10 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
 
   // Record source position of the IC call.
   SetSourcePosition(expr->position());
+  if (flags == RECORD_CALL_TARGET_AS_METHOD) {
+    __ LoadHeapObject(ebx, FeedbackVector());
+    __ mov(edx, Immediate(Smi::FromInt(expr->CallFeedbackSlot())));
+  }
   CallFunctionStub stub(arg_count, flags);
   __ mov(edi, Operand(esp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
@@ -2635,7 +2639,9 @@ void FullCodeGenerator::EmitKeyedCallWithIC(Call* expr,
 
   // Record source position of the IC call.
   SetSourcePosition(expr->position());
-  CallFunctionStub stub(arg_count, CALL_AS_METHOD);
+  __ LoadHeapObject(ebx, FeedbackVector());
+  __ mov(edx, Immediate(Smi::FromInt(expr->CallFeedbackSlot())));
+  CallFunctionStub stub(arg_count, RECORD_CALL_TARGET_AS_METHOD);
   __ mov(edi, Operand(esp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
   RecordJSReturnSite(expr);
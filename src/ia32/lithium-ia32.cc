@@ -2577,6 +2577,19 @@ LInstruction* LChunkBuilder::DoEnterInlined(HEnterInlined* instr) {
 }
 
 
+LInstruction* LChunkBuilder::DoEnterTry(HEnterTry* instr) {
+  // Optimized try/catch is only implemented by the x64 backend.
+  Abort(kTryCatchStatement);
+  return NULL;
+}
+
+
+LInstruction* LChunkBuilder::DoLeaveTry(HLeaveTry* instr) {
+  Abort(kTryCatchStatement);
+  return NULL;
+}
+
+
 LInstruction* LChunkBuilder::DoLeaveInlined(HLeaveInlined* instr) {
   LInstruction* pop = NULL;
 
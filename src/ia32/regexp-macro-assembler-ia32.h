@@ -139,8 +139,9 @@ class RegExpMacroAssemblerIA32: public NativeRegExpMacroAssembler {
   static const int kBackup_ebx = kBackup_edi - kPointerSize;
   static const int kSuccessfulCaptures = kBackup_ebx - kPointerSize;
   static const int kInputStartMinusOne = kSuccessfulCaptures - kPointerSize;
+  static const int kBacktrackCount = kInputStartMinusOne - kPointerSize;
   // First register address. Following registers are below it on the stack.
-  static const int kRegisterZero = kInputStartMinusOne - kPointerSize;
+  static const int kRegisterZero = kBacktrackCount - kPointerSize;
 
   // Initial size of code buffer.
   static const size_t kRegExpCodeSize = 1024;
@@ -215,6 +216,7 @@ class RegExpMacroAssemblerIA32: public NativeRegExpMacroAssembler {
   Label exit_label_;
   Label check_preempt_label_;
   Label stack_overflow_label_;
+  Label backtrack_limit_label_;
 };
 #endif  // V8_INTERPRETED_REGEXP
 
@@ -90,7 +90,12 @@ void IC::SetTargetAtAddress(Address address, Code* target) {
            StoreIC::GetStrictMode(target->extra_ic_state()));
   }
 #endif
-  Assembler::set_target_address_at(address, target->instruction_start());
+  // During a full GC the collector flushes patched code once per page.
+  ICacheFlushMode icache_flush_mode = heap->gc_state() == Heap::MARK_COMPACT
+      ? SKIP_ICACHE_FLUSH
+      : FLUSH_ICACHE_IF_NEEDED;
+  Assembler::set_target_address_at(
+      address, target->instruction_start(), icache_flush_mode);
   if (heap->gc_state() == Heap::MARK_COMPACT) {
     heap->mark_compact_collector()->RecordCodeTargetPatch(address, target);
   } else {
@@ -0,0 +1,136 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "ic-stats.h"
+
+namespace v8 {
+namespace internal {
+
+
+ICStats::ICStats() : map_(EntriesMatch), entries_(16) {
+}
+
+
+ICStats::~ICStats() {
+  for (int i = 0; i < entries_.length(); i++) {
+    DeleteArray(entries_[i]->function_name);
+    DeleteArray(entries_[i]->script_name);
+    delete entries_[i];
+  }
+}
+
+
+bool ICStats::EntriesMatch(void* key1, void* key2) {
+  Entry* a = reinterpret_cast<Entry*>(key1);
+  Entry* b = reinterpret_cast<Entry*>(key2);
+  return a->position == b->position && a->keyed == b->keyed &&
+         strcmp(a->type, b->type) == 0 &&
+         strcmp(a->function_name, b->function_name) == 0 &&
+         strcmp(a->script_name, b->script_name) == 0;
+}
+
+
+int ICStats::CompareByMegamorphic(Entry* const* a, Entry* const* b) {
+  // Most megamorphic sites first, then most polymorphic.
+  static const InlineCacheState kOrder[] = { MEGAMORPHIC, POLYMORPHIC };
+  for (size_t i = 0; i < ARRAY_SIZE(kOrder); i++) {
+    int delta = (*b)->transitions[kOrder[i]] - (*a)->transitions[kOrder[i]];
+    if (delta != 0) return delta;
+  }
+  return (*b)->max_map_count - (*a)->max_map_count;
+}
+
+
+void ICStats::Record(const char* type,
+                     bool keyed,
+                     JSFunction* function,
+                     int position,
+                     InlineCacheState new_state,
+                     int map_count) {
+  SharedFunctionInfo* shared = function->shared();
+  SmartArrayPointer<char> function_name = shared->DebugName()->ToCString();
+  SmartArrayPointer<char> script_name;
+  Object* script = shared->script();
+  if (script->IsScript() && Script::cast(script)->name()->IsString()) {
+    script_name = String::cast(Script::cast(script)->name())->ToCString();
+  } else {
+    script_name = SmartArrayPointer<char>(StrDup("<unknown>"));
+  }
+  Entry probe;
+  probe.type = type;
+  probe.keyed = keyed;
+  probe.function_name = function_name.get();
+  probe.script_name = script_name.get();
+  probe.position = position;
+  uint32_t hash = ComputeIntegerHash(position, 0) ^
+                  shared->DebugName()->Hash();
+  HashMap::Entry* map_entry = map_.Lookup(&probe, hash, true);
+  if (map_entry->value == NULL) {
+    Entry* entry = new Entry();
+    entry->type = type;
+    entry->keyed = keyed;
+    entry->function_name = function_name.Detach();
+    entry->script_name = script_name.Detach();
+    entry->position = position;
+    for (int i = 0; i < kStateCount; i++) entry->transitions[i] = 0;
+    entry->max_map_count = 0;
+    map_entry->key = entry;
+    map_entry->value = entry;
+    entries_.Add(entry);
+  }
+  Entry* entry = reinterpret_cast<Entry*>(map_entry->value);
+  entry->transitions[new_state]++;
+  if (map_count > entry->max_map_count) entry->max_map_count = map_count;
+}
+
+
+void ICStats::Print() {
+  entries_.Sort(CompareByMegamorphic);
+  PrintF("IC stats:\n");
+  PrintF("%6s %6s %6s %7s %6s %5s  %s\n",
+         "mono", "poly", "mega", "generic", "pre", "maps", "site");
+  for (int i = 0; i < entries_.length(); i++) {
+    Entry* entry = entries_[i];
+    PrintF("%6d %6d %6d %7d %6d %5d  %s%s in %s at %s:%d\n",
+           entry->transitions[MONOMORPHIC] +
+               entry->transitions[MONOMORPHIC_PROTOTYPE_FAILURE],
+           entry->transitions[POLYMORPHIC],
+           entry->transitions[MEGAMORPHIC],
+           entry->transitions[GENERIC],
+           entry->transitions[PREMONOMORPHIC],
+           entry->max_map_count,
+           entry->keyed ? "Keyed" : "",
+           entry->type,
+           entry->function_name,
+           entry->script_name,
+           entry->position);
+  }
+}
+
+} }  // namespace v8::internal
@@ -0,0 +1,83 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_IC_STATS_H_
+#define V8_IC_STATS_H_
+
+#include "hashmap.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Per-site inline cache transition statistics collected with --ic-stats.
+// A site is identified by the kind of IC, the enclosing function and
+// script names and the source position of the access, so all closures
+// of one function literal share an entry.  Unlike --trace-ic this works
+// in release builds; the summary is printed when the isolate is torn
+// down, most megamorphic sites first.
+class ICStats : public Malloced {
+ public:
+  static const int kStateCount = DEBUG_STUB + 1;
+
+  struct Entry {
+    const char* type;
+    bool keyed;
+    char* function_name;
+    char* script_name;
+    int position;
+    int transitions[kStateCount];
+    int max_map_count;
+  };
+
+  ICStats();
+  ~ICStats();
+
+  void Record(const char* type,
+              bool keyed,
+              JSFunction* function,
+              int position,
+              InlineCacheState new_state,
+              int map_count);
+  void Print();
+
+  int length() const { return entries_.length(); }
+  const Entry* at(int index) const { return entries_[index]; }
+
+ private:
+  static bool EntriesMatch(void* key1, void* key2);
+  static int CompareByMegamorphic(Entry* const* a, Entry* const* b);
+
+  HashMap map_;
+  List<Entry*> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(ICStats);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_IC_STATS_H_
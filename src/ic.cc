@@ -33,6 +33,7 @@
 #include "codegen.h"
 #include "execution.h"
 #include "ic-inl.h"
+#include "ic-stats.h"
 #include "runtime.h"
 #include "stub-cache.h"
 #include "v8conversions.h"
@@ -116,8 +117,35 @@ void IC::TraceIC(const char* type,
 #define TRACE_GENERIC_IC(isolate, type, reason)
 #endif  // DEBUG
 
-#define TRACE_IC(type, name)             \
-  ASSERT((TraceIC(type, name), true))
+#define TRACE_IC(type, name)                  \
+  do {                                        \
+    if (FLAG_ic_stats) RecordICStats(type);   \
+    ASSERT((TraceIC(type, name), true));      \
+  } while (false)
+
+
+void IC::RecordICStats(const char* type) {
+  JavaScriptFrameIterator it(isolate());
+  if (it.done()) return;
+  HandleScope scope(isolate());
+  JavaScriptFrame* frame = it.frame();
+  Address pc = frame->pc();
+  Code* code = Code::cast(isolate()->FindCodeObject(pc));
+  Code* new_target = raw_target();
+  State new_state = new_target->ic_state();
+  int map_count = 0;
+  if (new_state == MONOMORPHIC || new_state == POLYMORPHIC) {
+    MapHandleList maps;
+    new_target->FindAllMaps(&maps);
+    map_count = maps.length();
+  }
+  isolate()->GetICStats()->Record(type,
+                                  new_target->is_keyed_stub(),
+                                  frame->function(),
+                                  code->SourcePosition(pc),
+                                  new_state,
+                                  map_count);
+}
 
 IC::IC(FrameDepth depth, Isolate* isolate)
     : isolate_(isolate),
@@ -489,6 +517,30 @@ static bool MigrateDeprecated(Handle<Object> object) {
 }
 
 
+// Counts the named load misses on an object in dictionary mode and turns
+// it back into fast mode once it has seen
+// --stable-dictionary-load-misses of them without a property being added
+// or deleted, so that loads from it can be cached by map again.  Objects
+// with many properties are left alone, as they are likely used as hash
+// tables.
+static void UpdateStableDictionaryLoadCount(Handle<JSObject> object) {
+  if (FLAG_stable_dictionary_load_misses <= 0) return;
+  if (object->HasFastProperties() ||
+      object->IsGlobalObject() ||
+      object->IsAccessCheckNeeded()) {
+    return;
+  }
+  NameDictionary* dictionary = object->property_dictionary();
+  if (dictionary->NumberOfElements() > JSObject::kMaxFastProperties) return;
+  int count = dictionary->StableLoadCount() + 1;
+  if (count < FLAG_stable_dictionary_load_misses) {
+    dictionary->SetStableLoadCount(count);
+    return;
+  }
+  JSObject::TransformToFastProperties(object, 0);
+}
+
+
 MaybeObject* LoadIC::Load(Handle<Object> object,
                           Handle<String> name) {
   // If the object is undefined or null it's illegal to try to get any
@@ -556,6 +608,10 @@ MaybeObject* LoadIC::Load(Handle<Object> object,
 
   bool use_ic = MigrateDeprecated(object) ? false : FLAG_use_ic;
 
+  if (use_ic && kind() == Code::LOAD_IC && object->IsJSObject()) {
+    UpdateStableDictionaryLoadCount(Handle<JSObject>::cast(object));
+  }
+
   // Named lookup in the object.
   LookupResult lookup(isolate());
   LookupForRead(object, name, &lookup);
@@ -796,6 +852,17 @@ Handle<Code> LoadIC::SimpleFieldLoad(int offset,
 }
 
 
+Handle<Code> LoadIC::SimpleConstantLoad(int descriptor) {
+  if (kind() == Code::LOAD_IC) {
+    LoadConstantStub stub(descriptor);
+    return stub.GetCode(isolate());
+  } else {
+    KeyedLoadConstantStub stub(descriptor);
+    return stub.GetCode(isolate());
+  }
+}
+
+
 void LoadIC::UpdateCaches(LookupResult* lookup,
                           Handle<Object> object,
                           Handle<String> name) {
@@ -888,6 +955,9 @@ Handle<Code> LoadIC::CompileHandler(LookupResult* lookup,
           type, holder, name, field, lookup->representation());
     }
     case CONSTANT: {
+      if (object.is_identical_to(holder)) {
+        return SimpleConstantLoad(lookup->GetDescriptorIndex());
+      }
       Handle<Object> constant(lookup->GetConstant(), isolate());
       // TODO(2803): Don't compute a stub for cons strings because they cannot
       // be embedded into code.
@@ -174,6 +174,10 @@ class IC {
   void TraceIC(const char* type, Handle<Object> name);
 #endif
 
+  // Records the transition to the current target in the isolate's
+  // ICStats (--ic-stats).
+  void RecordICStats(const char* type);
+
   Failure* TypeError(const char* type,
                      Handle<Object> object,
                      Handle<Object> key);
@@ -372,6 +376,7 @@ class LoadIC: public IC {
                                bool inobject = true,
                                Representation representation =
                                     Representation::Tagged());
+  Handle<Code> SimpleConstantLoad(int descriptor);
 
   static void Clear(Isolate* isolate, Address address, Code* target);
 
@@ -575,6 +575,9 @@ void IncrementalMarking::Start(CompactionFlag flag) {
   }
 
   heap_->new_space()->LowerInlineAllocationLimit(kAllocatedThreshold);
+
+  // Marking steps are also performed in idle time if the platform has some.
+  heap_->ScheduleIdleTask();
 }
 
 
@@ -715,9 +718,15 @@ void IncrementalMarking::VisitObject(Map* map, HeapObject* obj, int size) {
 }
 
 
-void IncrementalMarking::ProcessMarkingDeque(intptr_t bytes_to_process) {
+intptr_t IncrementalMarking::ProcessMarkingDeque(intptr_t bytes_to_process,
+                                                 double deadline_in_ms) {
   Map* filler_map = heap_->one_pointer_filler_map();
+  int objects_until_deadline_check = kDeadlineCheckInterval;
   while (!marking_deque_.IsEmpty() && bytes_to_process > 0) {
+    if (deadline_in_ms > 0 && --objects_until_deadline_check == 0) {
+      if (OS::TimeCurrentMillis() >= deadline_in_ms) break;
+      objects_until_deadline_check = kDeadlineCheckInterval;
+    }
     HeapObject* obj = marking_deque_.Pop();
 
     // Explicitly skip one word fillers. Incremental markbit patterns are
@@ -730,6 +739,7 @@ void IncrementalMarking::ProcessMarkingDeque(intptr_t bytes_to_process) {
     VisitObject(map, obj, size);
     bytes_to_process -= (size - unscanned_bytes_of_large_object_);
   }
+  return Max(bytes_to_process, static_cast<intptr_t>(0));
 }
 
 
@@ -902,11 +912,20 @@ void IncrementalMarking::Step(intptr_t allocated_bytes,
   bytes_scanned_ += bytes_to_process;
 
   double start = 0;
+  double deadline = 0;
 
   if (FLAG_trace_incremental_marking || FLAG_trace_gc ||
-      FLAG_print_cumulative_gc_stat) {
+      FLAG_print_cumulative_gc_stat ||
+      FLAG_max_incremental_marking_step_time > 0) {
     start = OS::TimeCurrentMillis();
   }
+  // Steps taken on behalf of the embedder (e.g. on idle notifications) are
+  // already sized by the caller, so only steps taken while the mutator is
+  // allocating are bounded in time.
+  if (FLAG_max_incremental_marking_step_time > 0 &&
+      action == GC_VIA_STACK_GUARD) {
+    deadline = start + FLAG_max_incremental_marking_step_time;
+  }
 
   if (state_ == SWEEPING) {
     if (heap_->EnsureSweepersProgressed(static_cast<int>(bytes_to_process))) {
@@ -914,7 +933,10 @@ void IncrementalMarking::Step(intptr_t allocated_bytes,
       StartMarking(PREVENT_COMPACTION);
     }
   } else if (state_ == MARKING) {
-    ProcessMarkingDeque(bytes_to_process);
+    intptr_t unprocessed = ProcessMarkingDeque(bytes_to_process, deadline);
+    // Work that did not fit into this step is not accounted as scanned, so
+    // that the marker speeds up if it is not keeping up.
+    if (!marking_deque_.IsEmpty()) bytes_scanned_ -= unprocessed;
     if (marking_deque_.IsEmpty()) MarkingComplete(action);
   }
 
@@ -111,6 +111,9 @@ class IncrementalMarking {
   // This is how much we increase the marking/allocating factor by.
   static const intptr_t kMarkingSpeedAccelleration = 2;
   static const intptr_t kMaxMarkingSpeed = 1000;
+  // When steps are bounded in time, the clock is only read after this many
+  // objects have been visited.
+  static const int kDeadlineCheckInterval = 256;
 
   void OldSpaceStep(intptr_t allocated);
 
@@ -245,7 +248,11 @@ class IncrementalMarking {
 
   INLINE(void ProcessMarkingDeque());
 
-  INLINE(void ProcessMarkingDeque(intptr_t bytes_to_process));
+  // Processes up to bytes_to_process bytes of the marking deque, or less if
+  // the deadline is reached first.  A deadline of zero means no deadline.
+  // Returns the number of bytes that were left unprocessed.
+  INLINE(intptr_t ProcessMarkingDeque(intptr_t bytes_to_process,
+                                      double deadline_in_ms));
 
   INLINE(void VisitObject(Map* map, HeapObject* obj, int size));
 
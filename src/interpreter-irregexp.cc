@@ -36,6 +36,7 @@
 #include "interpreter-irregexp.h"
 #include "jsregexp.h"
 #include "regexp-macro-assembler.h"
+#include "regexp-stack.h"
 
 namespace v8 {
 namespace internal {
@@ -125,8 +126,7 @@ static void TraceInterpreter(const byte* code_base,
 }
 
 
-#define BYTECODE(name)                                                      \
-  case BC_##name:                                                           \
+#define TRACE_BYTECODE(name)                                                \
     TraceInterpreter(code_base,                                             \
                      pc,                                                    \
                      static_cast<int>(backtrack_sp - backtrack_stack_base), \
@@ -135,8 +135,35 @@ static void TraceInterpreter(const byte* code_base,
                      BC_##name##_LENGTH,                                    \
                      #name);
 #else
+#define TRACE_BYTECODE(name)
+#endif
+
+
+// Where the compiler supports computed gotos, and lets us silence -pedantic
+// about them, each bytecode handler jumps straight to the handler of the next
+// bytecode through a table of label addresses instead of going back to a
+// single switch.
+#if defined(__clang__) || \
+    (defined(__GNUC__) && \
+     (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8)))
+#define IRREGEXP_THREADED_DISPATCH 1
+#endif
+
+#ifdef IRREGEXP_THREADED_DISPATCH
 #define BYTECODE(name)                                                      \
-  case BC_##name:
+  HANDLE_##name:                                                            \
+    TRACE_BYTECODE(name)
+#define DISPATCH()                                                          \
+  do {                                                                      \
+    insn = Load32Aligned(pc);                                               \
+    ASSERT((insn & BYTECODE_MASK) < BYTECODE_COUNT);                        \
+    goto *dispatch_table[insn & BYTECODE_MASK];                             \
+  } while (false)
+#else
+#define BYTECODE(name)                                                      \
+  case BC_##name:                                                           \
+    TRACE_BYTECODE(name)
+#define DISPATCH() break
 #endif
 
 
@@ -193,6 +220,29 @@ class BacktrackStack {
 };
 
 
+// Adds the backtracks taken by one interpreter run to the isolate-wide
+// count on every exit from the interpreter loop.
+class BacktrackCountScope {
+ public:
+  BacktrackCountScope(Isolate* isolate, intptr_t* backtracks)
+      : count_(isolate->regexp_stack()->backtrack_count_address()),
+        backtracks_(backtracks) { }
+
+  ~BacktrackCountScope() { *count_ += *backtracks_; }
+
+ private:
+  intptr_t* count_;
+  intptr_t* backtracks_;
+
+  DISALLOW_COPY_AND_ASSIGN(BacktrackCountScope);
+};
+
+
+#ifdef IRREGEXP_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
 template <typename Char>
 static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
                                            const byte* code_base,
@@ -208,14 +258,30 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
   int* backtrack_stack_base = backtrack_stack.data();
   int* backtrack_sp = backtrack_stack_base;
   int backtrack_stack_space = backtrack_stack.max_size();
+  int backtrack_limit = FLAG_regexp_backtrack_limit;
+  intptr_t backtracks = 0;
+  BacktrackCountScope backtrack_count_scope(isolate, &backtracks);
 #ifdef DEBUG
   if (FLAG_trace_regexp_bytecodes) {
     PrintF("\n\nStart bytecode interpreter\n\n");
   }
 #endif
+  int32_t insn;
+#ifdef IRREGEXP_THREADED_DISPATCH
+#define DECLARE_DISPATCH_TABLE_ENTRY(name, code, length)                   \
+  &&HANDLE_##name,
+  static const void* const dispatch_table[BYTECODE_COUNT] = {
+    BYTECODE_ITERATOR(DECLARE_DISPATCH_TABLE_ENTRY)
+  };
+#undef DECLARE_DISPATCH_TABLE_ENTRY
+  DISPATCH();
+  {
+    {
+#else
   while (true) {
-    int32_t insn = Load32Aligned(pc);
+    insn = Load32Aligned(pc);
     switch (insn & BYTECODE_MASK) {
+#endif
       BYTECODE(BREAK)
         UNREACHABLE();
         return RegExpImpl::RE_FAILURE;
@@ -225,65 +291,69 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         }
         *backtrack_sp++ = current;
         pc += BC_PUSH_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(PUSH_BT)
         if (--backtrack_stack_space < 0) {
           return RegExpImpl::RE_EXCEPTION;
         }
         *backtrack_sp++ = Load32Aligned(pc + 4);
         pc += BC_PUSH_BT_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(PUSH_REGISTER)
         if (--backtrack_stack_space < 0) {
           return RegExpImpl::RE_EXCEPTION;
         }
         *backtrack_sp++ = registers[insn >> BYTECODE_SHIFT];
         pc += BC_PUSH_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER)
         registers[insn >> BYTECODE_SHIFT] = Load32Aligned(pc + 4);
         pc += BC_SET_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(ADVANCE_REGISTER)
         registers[insn >> BYTECODE_SHIFT] += Load32Aligned(pc + 4);
         pc += BC_ADVANCE_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER_TO_CP)
         registers[insn >> BYTECODE_SHIFT] = current + Load32Aligned(pc + 4);
         pc += BC_SET_REGISTER_TO_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_CP_TO_REGISTER)
         current = registers[insn >> BYTECODE_SHIFT];
         pc += BC_SET_CP_TO_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_REGISTER_TO_SP)
         registers[insn >> BYTECODE_SHIFT] =
             static_cast<int>(backtrack_sp - backtrack_stack_base);
         pc += BC_SET_REGISTER_TO_SP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(SET_SP_TO_REGISTER)
         backtrack_sp = backtrack_stack_base + registers[insn >> BYTECODE_SHIFT];
         backtrack_stack_space = backtrack_stack.max_size() -
             static_cast<int>(backtrack_sp - backtrack_stack_base);
         pc += BC_SET_SP_TO_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(POP_CP)
         backtrack_stack_space++;
         --backtrack_sp;
         current = *backtrack_sp;
         pc += BC_POP_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(POP_BT)
+        backtracks++;
+        if (backtrack_limit != 0 && backtracks == backtrack_limit) {
+          return RegExpImpl::RE_BACKTRACK_LIMIT;
+        }
         backtrack_stack_space++;
         --backtrack_sp;
         pc = code_base + *backtrack_sp;
-        break;
+        DISPATCH();
       BYTECODE(POP_REGISTER)
         backtrack_stack_space++;
         --backtrack_sp;
         registers[insn >> BYTECODE_SHIFT] = *backtrack_sp;
         pc += BC_POP_REGISTER_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(FAIL)
         return RegExpImpl::RE_FAILURE;
       BYTECODE(SUCCEED)
@@ -291,14 +361,14 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
       BYTECODE(ADVANCE_CP)
         current += insn >> BYTECODE_SHIFT;
         pc += BC_ADVANCE_CP_LENGTH;
-        break;
+        DISPATCH();
       BYTECODE(GOTO)
         pc = code_base + Load32Aligned(pc + 4);
-        break;
+        DISPATCH();
       BYTECODE(ADVANCE_CP_AND_GOTO)
         current += insn >> BYTECODE_SHIFT;
         pc = code_base + Load32Aligned(pc + 4);
-        break;
+        DISPATCH();
       BYTECODE(CHECK_GREEDY)
         if (current == backtrack_sp[-1]) {
           backtrack_sp--;
@@ -307,7 +377,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_GREEDY_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(LOAD_CURRENT_CHAR) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         if (pos >= subject.length()) {
@@ -316,13 +386,59 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
           current_char = subject[pos];
           pc += BC_LOAD_CURRENT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_CURRENT_CHAR_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         current_char = subject[pos];
         pc += BC_LOAD_CURRENT_CHAR_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CHAR_CHECK_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        if (pos >= subject.length()) {
+          pc = code_base + Load32Aligned(pc + 4);
+        } else {
+          current_char = subject[pos];
+          if (current_char == static_cast<uint32_t>(Load32Aligned(pc + 8))) {
+            pc = code_base + Load32Aligned(pc + 12);
+          } else {
+            pc += BC_LOAD_CHAR_CHECK_CHAR_LENGTH;
+          }
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CHAR_CHECK_NOT_CHAR) {
+        int pos = current + (insn >> BYTECODE_SHIFT);
+        if (pos >= subject.length()) {
+          pc = code_base + Load32Aligned(pc + 4);
+        } else {
+          current_char = subject[pos];
+          if (current_char != static_cast<uint32_t>(Load32Aligned(pc + 8))) {
+            pc = code_base + Load32Aligned(pc + 12);
+          } else {
+            pc += BC_LOAD_CHAR_CHECK_NOT_CHAR_LENGTH;
+          }
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CHAR_UNCHECKED_CHECK_CHAR) {
+        current_char = subject[current + (insn >> BYTECODE_SHIFT)];
+        if (current_char == static_cast<uint32_t>(Load32Aligned(pc + 4))) {
+          pc = code_base + Load32Aligned(pc + 8);
+        } else {
+          pc += BC_LOAD_CHAR_UNCHECKED_CHECK_CHAR_LENGTH;
+        }
+        DISPATCH();
+      }
+      BYTECODE(LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR) {
+        current_char = subject[current + (insn >> BYTECODE_SHIFT)];
+        if (current_char != static_cast<uint32_t>(Load32Aligned(pc + 4))) {
+          pc = code_base + Load32Aligned(pc + 8);
+        } else {
+          pc += BC_LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR_LENGTH;
+        }
+        DISPATCH();
       }
       BYTECODE(LOAD_2_CURRENT_CHARS) {
         int pos = current + (insn >> BYTECODE_SHIFT);
@@ -334,14 +450,14 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
               (subject[pos] | (next << (kBitsPerByte * sizeof(Char))));
           pc += BC_LOAD_2_CURRENT_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_2_CURRENT_CHARS_UNCHECKED) {
         int pos = current + (insn >> BYTECODE_SHIFT);
         Char next = subject[pos + 1];
         current_char = (subject[pos] | (next << (kBitsPerByte * sizeof(Char))));
         pc += BC_LOAD_2_CURRENT_CHARS_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_4_CURRENT_CHARS) {
         ASSERT(sizeof(Char) == 1);
@@ -358,7 +474,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
                           (next3 << 24));
           pc += BC_LOAD_4_CURRENT_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(LOAD_4_CURRENT_CHARS_UNCHECKED) {
         ASSERT(sizeof(Char) == 1);
@@ -371,7 +487,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
                         (next2 << 16) |
                         (next3 << 24));
         pc += BC_LOAD_4_CURRENT_CHARS_UNCHECKED_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -380,7 +496,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -389,7 +505,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -398,7 +514,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_NOT_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -407,7 +523,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -416,7 +532,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -425,7 +541,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_NOT_4_CHARS) {
         uint32_t c = Load32Aligned(pc + 4);
@@ -434,7 +550,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_NOT_4_CHARS_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(AND_CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -443,7 +559,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_AND_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(MINUS_AND_CHECK_NOT_CHAR) {
         uint32_t c = (insn >> BYTECODE_SHIFT);
@@ -454,7 +570,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_MINUS_AND_CHECK_NOT_CHAR_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_CHAR_IN_RANGE) {
         uint32_t from = Load16Aligned(pc + 4);
@@ -464,7 +580,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_CHAR_IN_RANGE_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_CHAR_NOT_IN_RANGE) {
         uint32_t from = Load16Aligned(pc + 4);
@@ -474,7 +590,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_CHAR_NOT_IN_RANGE_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_BIT_IN_TABLE) {
         int mask = RegExpMacroAssembler::kTableMask;
@@ -485,7 +601,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_BIT_IN_TABLE_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_LT) {
         uint32_t limit = (insn >> BYTECODE_SHIFT);
@@ -494,7 +610,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_LT_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_GT) {
         uint32_t limit = (insn >> BYTECODE_SHIFT);
@@ -503,7 +619,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_GT_LENGTH;
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_REGISTER_LT)
         if (registers[insn >> BYTECODE_SHIFT] < Load32Aligned(pc + 4)) {
@@ -511,21 +627,21 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_REGISTER_LT_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_REGISTER_GE)
         if (registers[insn >> BYTECODE_SHIFT] >= Load32Aligned(pc + 4)) {
           pc = code_base + Load32Aligned(pc + 8);
         } else {
           pc += BC_CHECK_REGISTER_GE_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_REGISTER_EQ_POS)
         if (registers[insn >> BYTECODE_SHIFT] == current) {
           pc = code_base + Load32Aligned(pc + 4);
         } else {
           pc += BC_CHECK_REGISTER_EQ_POS_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_NOT_REGS_EQUAL)
         if (registers[insn >> BYTECODE_SHIFT] ==
             registers[Load32Aligned(pc + 4)]) {
@@ -533,17 +649,17 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc = code_base + Load32Aligned(pc + 8);
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_NOT_BACK_REF) {
         int from = registers[insn >> BYTECODE_SHIFT];
         int len = registers[(insn >> BYTECODE_SHIFT) + 1] - from;
         if (from < 0 || len <= 0) {
           pc += BC_CHECK_NOT_BACK_REF_LENGTH;
-          break;
+          DISPATCH();
         }
         if (current + len > subject.length()) {
           pc = code_base + Load32Aligned(pc + 4);
-          break;
+          DISPATCH();
         } else {
           int i;
           for (i = 0; i < len; i++) {
@@ -552,22 +668,22 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
               break;
             }
           }
-          if (i < len) break;
+          if (i < len) DISPATCH();
           current += len;
         }
         pc += BC_CHECK_NOT_BACK_REF_LENGTH;
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_NOT_BACK_REF_NO_CASE) {
         int from = registers[insn >> BYTECODE_SHIFT];
         int len = registers[(insn >> BYTECODE_SHIFT) + 1] - from;
         if (from < 0 || len <= 0) {
           pc += BC_CHECK_NOT_BACK_REF_NO_CASE_LENGTH;
-          break;
+          DISPATCH();
         }
         if (current + len > subject.length()) {
           pc = code_base + Load32Aligned(pc + 4);
-          break;
+          DISPATCH();
         } else {
           if (BackRefMatchesNoCase(isolate->interp_canonicalize_mapping(),
                                    from, current, len, subject)) {
@@ -577,7 +693,7 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
             pc = code_base + Load32Aligned(pc + 4);
           }
         }
-        break;
+        DISPATCH();
       }
       BYTECODE(CHECK_AT_START)
         if (current == 0) {
@@ -585,14 +701,14 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
         } else {
           pc += BC_CHECK_AT_START_LENGTH;
         }
-        break;
+        DISPATCH();
       BYTECODE(CHECK_NOT_AT_START)
         if (current == 0) {
           pc += BC_CHECK_NOT_AT_START_LENGTH;
         } else {
           pc = code_base + Load32Aligned(pc + 4);
         }
-        break;
+        DISPATCH();
       BYTECODE(SET_CURRENT_POSITION_FROM_END) {
         int by = static_cast<uint32_t>(insn) >> BYTECODE_SHIFT;
         if (subject.length() - current > by) {
@@ -600,15 +716,27 @@ static RegExpImpl::IrregexpResult RawMatch(Isolate* isolate,
           current_char = subject[current - 1];
         }
         pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
-        break;
+        DISPATCH();
       }
+#ifndef IRREGEXP_THREADED_DISPATCH
       default:
         UNREACHABLE();
         break;
+#endif
     }
   }
+  UNREACHABLE();
+  return RegExpImpl::RE_FAILURE;
 }
 
+#ifdef IRREGEXP_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
+#undef DISPATCH
+#undef BYTECODE
+#undef TRACE_BYTECODE
+
 
 RegExpImpl::IrregexpResult IrregexpInterpreter::Match(
     Isolate* isolate,
@@ -72,6 +72,15 @@ bool Isolate::DebuggerHasBreakPoints() {
 }
 
 
+bool Isolate::DebuggerPreventsOptimization(SharedFunctionInfo* shared) {
+#ifdef ENABLE_DEBUGGER_SUPPORT
+  return debug()->PreventsOptimization(shared);
+#else
+  return false;
+#endif
+}
+
+
 RandomNumberGenerator* Isolate::random_number_generator() {
   if (random_number_generator_ == NULL) {
     random_number_generator_ = new RandomNumberGenerator;
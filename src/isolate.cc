@@ -38,11 +38,13 @@
 #include "deoptimizer.h"
 #include "heap-profiler.h"
 #include "hydrogen.h"
+#include "ic-stats.h"
 #include "isolate-inl.h"
 #include "lithium-allocator.h"
 #include "log.h"
 #include "messages.h"
 #include "platform.h"
+#include "regexp-profile.h"
 #include "regexp-stack.h"
 #include "runtime-profiler.h"
 #include "sampler.h"
@@ -56,6 +58,10 @@
 #include "version.h"
 #include "vm-state-inl.h"
 
+#ifdef V8_I18N_SUPPORT
+#include "i18n.h"
+#endif
+
 
 namespace v8 {
 namespace internal {
@@ -458,6 +464,10 @@ Handle<JSArray> Isolate::CaptureSimpleStackTrace(Handle<JSObject> error_object,
   int frames_seen = 0;
   int non_strict_frames = 0;
   bool encountered_strict_function = false;
+  // Set initial size to the maximum inlining level + 1 for the outermost
+  // function.  Only optimized frames need to be summarized, the others are
+  // read directly without creating handles.
+  List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
   for (StackFrameIterator iter(this);
        !iter.done() && frames_seen < limit;
        iter.Advance()) {
@@ -465,26 +475,42 @@ Handle<JSArray> Isolate::CaptureSimpleStackTrace(Handle<JSObject> error_object,
     if (IsVisibleInStackTrace(raw_frame, *caller, &seen_caller)) {
       frames_seen++;
       JavaScriptFrame* frame = JavaScriptFrame::cast(raw_frame);
-      // Set initial size to the maximum inlining level + 1 for the outermost
-      // function.
-      List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
-      frame->Summarize(&frames);
-      for (int i = frames.length() - 1; i >= 0; i--) {
-        if (cursor + 4 > elements->length()) {
-          int new_capacity = JSObject::NewElementsCapacity(elements->length());
-          Handle<FixedArray> new_elements =
-              factory()->NewFixedArrayWithHoles(new_capacity);
-          for (int i = 0; i < cursor; i++) {
-            new_elements->set(i, elements->get(i));
-          }
-          elements = new_elements;
+      int count = 1;
+      if (frame->is_optimized()) {
+        frames.Rewind(0);
+        frame->Summarize(&frames);
+        count = frames.length();
+      }
+      if (cursor + 4 * count > elements->length()) {
+        int new_capacity =
+            Max(JSObject::NewElementsCapacity(elements->length()),
+                cursor + 4 * count);
+        Handle<FixedArray> new_elements =
+            factory()->NewFixedArrayWithHoles(new_capacity);
+        for (int i = 0; i < cursor; i++) {
+          new_elements->set(i, elements->get(i));
+        }
+        elements = new_elements;
+      }
+      ASSERT(cursor + 4 * count <= elements->length());
+
+      DisallowHeapAllocation no_gc;
+      for (int i = count - 1; i >= 0; i--) {
+        Object* recv;
+        JSFunction* fun;
+        Code* code;
+        int offset;
+        if (frame->is_optimized()) {
+          recv = *frames[i].receiver();
+          fun = *frames[i].function();
+          code = *frames[i].code();
+          offset = frames[i].offset();
+        } else {
+          recv = frame->receiver();
+          fun = frame->function();
+          code = frame->LookupCode();
+          offset = static_cast<int>(frame->pc() - code->address());
         }
-        ASSERT(cursor + 4 <= elements->length());
-
-        Handle<Object> recv = frames[i].receiver();
-        Handle<JSFunction> fun = frames[i].function();
-        Handle<Code> code = frames[i].code();
-        Handle<Smi> offset(Smi::FromInt(frames[i].offset()), this);
         // The stack trace API should not expose receivers and function
         // objects on frames deeper than the top-most one with a strict
         // mode function.  The number of non-strict frames is stored as
@@ -496,10 +522,10 @@ Handle<JSArray> Isolate::CaptureSimpleStackTrace(Handle<JSObject> error_object,
             non_strict_frames++;
           }
         }
-        elements->set(cursor++, *recv);
-        elements->set(cursor++, *fun);
-        elements->set(cursor++, *code);
-        elements->set(cursor++, *offset);
+        elements->set(cursor++, recv);
+        elements->set(cursor++, fun);
+        elements->set(cursor++, code);
+        elements->set(cursor++, Smi::FromInt(offset));
       }
     }
   }
@@ -1542,6 +1568,8 @@ Isolate::Isolate()
       keyed_lookup_cache_(NULL),
       context_slot_cache_(NULL),
       descriptor_lookup_cache_(NULL),
+      json_transition_cache_(NULL),
+      for_in_cache_(NULL),
       handle_scope_implementer_(NULL),
       unicode_cache_(NULL),
       runtime_zone_(this),
@@ -1555,6 +1583,10 @@ Isolate::Isolate()
       string_tracker_(NULL),
       regexp_stack_(NULL),
       date_cache_(NULL),
+      microtask_queue_(NULL),
+#ifdef V8_I18N_SUPPORT
+      icu_object_cache_(NULL),
+#endif
       code_stub_interface_descriptors_(NULL),
       call_descriptors_(NULL),
       // TODO(bmeurer) Initialized lazily because it depends on flags; can
@@ -1685,6 +1717,17 @@ void Isolate::Deinit() {
     }
 
     if (FLAG_hydrogen_stats) GetHStatistics()->Print();
+    if (FLAG_runtime_call_stats) RuntimeCallStats::Print(stdout);
+    if (regexp_profile() != NULL) {
+      regexp_profile()->Print();
+      delete regexp_profile();
+      set_regexp_profile(NULL);
+    }
+    if (ic_stats() != NULL) {
+      ic_stats()->Print();
+      delete ic_stats();
+      set_ic_stats(NULL);
+    }
 
     if (FLAG_print_deopt_stress) {
       PrintF(stdout, "=== Stress deopt counter: %u\n", stress_deopt_count_);
@@ -1768,6 +1811,14 @@ Isolate::~Isolate() {
   delete date_cache_;
   date_cache_ = NULL;
 
+  delete microtask_queue_;
+  microtask_queue_ = NULL;
+
+#ifdef V8_I18N_SUPPORT
+  delete icu_object_cache_;
+  icu_object_cache_ = NULL;
+#endif
+
   delete[] code_stub_interface_descriptors_;
   code_stub_interface_descriptors_ = NULL;
 
@@ -1777,6 +1828,10 @@ Isolate::~Isolate() {
   delete regexp_stack_;
   regexp_stack_ = NULL;
 
+  delete for_in_cache_;
+  for_in_cache_ = NULL;
+  delete json_transition_cache_;
+  json_transition_cache_ = NULL;
   delete descriptor_lookup_cache_;
   descriptor_lookup_cache_ = NULL;
   delete context_slot_cache_;
@@ -1828,6 +1883,9 @@ Isolate::~Isolate() {
   delete string_stream_debug_object_cache_;
   string_stream_debug_object_cache_ = NULL;
 
+  delete external_reference_decoder_;
+  external_reference_decoder_ = NULL;
+
   delete external_reference_table_;
   external_reference_table_ = NULL;
 
@@ -1954,6 +2012,8 @@ bool Isolate::Init(Deserializer* des) {
   keyed_lookup_cache_ = new KeyedLookupCache();
   context_slot_cache_ = new ContextSlotCache();
   descriptor_lookup_cache_ = new DescriptorLookupCache();
+  json_transition_cache_ = new JsonTransitionCache();
+  for_in_cache_ = new ForInCache();
   unicode_cache_ = new UnicodeCache();
   inner_pointer_to_code_cache_ = new InnerPointerToCodeCache(this);
   write_iterator_ = new ConsStringIteratorOp();
@@ -1966,6 +2026,7 @@ bool Isolate::Init(Deserializer* des) {
   regexp_stack_ = new RegExpStack();
   regexp_stack_->isolate_ = this;
   date_cache_ = new DateCache();
+  microtask_queue_ = new MicrotaskQueue(this);
   code_stub_interface_descriptors_ =
       new CodeStubInterfaceDescriptor[CodeStub::NUMBER_OF_IDS];
   call_descriptors_ =
@@ -2032,15 +2093,16 @@ bool Isolate::Init(Deserializer* des) {
   if (FLAG_trace_hydrogen || FLAG_trace_hydrogen_stubs) {
     PrintF("Concurrent recompilation has been disabled for tracing.\n");
   } else if (OptimizingCompilerThread::Enabled(max_available_threads_)) {
-    optimizing_compiler_thread_ = new OptimizingCompilerThread(this);
-    optimizing_compiler_thread_->Start();
+    int num_threads =
+        OptimizingCompilerThread::NumberOfThreads(max_available_threads_);
+    optimizing_compiler_thread_ = new OptimizingCompilerThread(this,
+                                                               num_threads);
   }
 
   if (num_sweeper_threads_ > 0) {
     sweeper_thread_ = new SweeperThread*[num_sweeper_threads_];
     for (int i = 0; i < num_sweeper_threads_; i++) {
       sweeper_thread_[i] = new SweeperThread(this);
-      sweeper_thread_[i]->Start();
     }
   }
 
@@ -2081,9 +2143,10 @@ bool Isolate::Init(Deserializer* des) {
     LOG(this, LogCompiledFunctions());
   }
 
-  // If we are profiling with the Linux perf tool, we need to disable
-  // code relocation.
-  if (FLAG_perf_jit_prof || FLAG_perf_basic_prof) {
+  // The perf map written by --perf-basic-prof cannot describe moved code,
+  // so disable code relocation. The jitdump file written by --perf-jit-prof
+  // records code moves.
+  if (FLAG_perf_basic_prof) {
     FLAG_compact_code_space = false;
   }
 
@@ -2253,6 +2316,18 @@ HStatistics* Isolate::GetHStatistics() {
 }
 
 
+RegExpProfile* Isolate::GetRegExpProfile() {
+  if (regexp_profile() == NULL) set_regexp_profile(new RegExpProfile());
+  return regexp_profile();
+}
+
+
+ICStats* Isolate::GetICStats() {
+  if (ic_stats() == NULL) set_ic_stats(new ICStats());
+  return ic_stats();
+}
+
+
 HTracer* Isolate::GetHTracer() {
   if (htracer() == NULL) set_htracer(new HTracer(id()));
   return htracer();
@@ -2265,6 +2340,14 @@ CodeTracer* Isolate::GetCodeTracer() {
 }
 
 
+#ifdef V8_I18N_SUPPORT
+ICUObjectCache* Isolate::icu_object_cache() {
+  if (icu_object_cache_ == NULL) icu_object_cache_ = new ICUObjectCache();
+  return icu_object_cache_;
+}
+#endif
+
+
 Map* Isolate::get_initial_js_array_map(ElementsKind kind) {
   Context* native_context = context()->native_context();
   Object* maybe_map_array = native_context->js_array_maps();
@@ -41,6 +41,7 @@
 #include "handles.h"
 #include "hashmap.h"
 #include "heap.h"
+#include "microtask-queue.h"
 #include "optimizing-compiler-thread.h"
 #include "regexp-stack.h"
 #include "runtime-profiler.h"
@@ -66,12 +67,16 @@ class DeoptimizerData;
 class Deserializer;
 class EmptyStatement;
 class ExternalCallbackScope;
+class ExternalReferenceDecoder;
 class ExternalReferenceTable;
 class Factory;
 class FunctionInfoListener;
 class HandleScopeImplementer;
 class HeapProfiler;
 class HStatistics;
+class RegExpProfile;
+class ICStats;
+class ICUObjectCache;
 class HTracer;
 class InlineRuntimeFunctionsTable;
 class InnerPointerToCodeCache;
@@ -356,12 +361,14 @@ typedef List<HeapObject*> DebugObjectCache;
   V(int*, irregexp_interpreter_backtrack_stack_cache, NULL)                    \
   /* Serializer state. */                                                      \
   V(ExternalReferenceTable*, external_reference_table, NULL)                   \
+  V(ExternalReferenceDecoder*, external_reference_decoder, NULL)               \
   /* AstNode state. */                                                         \
   V(int, ast_node_id, 0)                                                       \
   V(unsigned, ast_node_count, 0)                                               \
-  V(bool, microtask_pending, false)                                            \
   V(bool, autorun_microtasks, true)                                            \
   V(HStatistics*, hstatistics, NULL)                                           \
+  V(RegExpProfile*, regexp_profile, NULL)                                      \
+  V(ICStats*, ic_stats, NULL)                                                  \
   V(HTracer*, htracer, NULL)                                                   \
   V(CodeTracer*, code_tracer, NULL)                                            \
   ISOLATE_DEBUGGER_INIT_LIST(V)
@@ -884,6 +891,14 @@ class Isolate {
     return descriptor_lookup_cache_;
   }
 
+  JsonTransitionCache* json_transition_cache() {
+    return json_transition_cache_;
+  }
+
+  ForInCache* for_in_cache() {
+    return for_in_cache_;
+  }
+
   HandleScopeData* handle_scope_data() { return &handle_scope_data_; }
 
   HandleScopeImplementer* handle_scope_implementer() {
@@ -969,6 +984,7 @@ class Isolate {
 
   inline bool IsDebuggerActive();
   inline bool DebuggerHasBreakPoints();
+  inline bool DebuggerPreventsOptimization(SharedFunctionInfo* shared);
 
   CpuProfiler* cpu_profiler() const { return cpu_profiler_; }
   HeapProfiler* heap_profiler() const { return heap_profiler_; }
@@ -1025,6 +1041,8 @@ class Isolate {
     return date_cache_;
   }
 
+  MicrotaskQueue* microtask_queue() { return microtask_queue_; }
+
   void set_date_cache(DateCache* date_cache) {
     if (date_cache != date_cache_) {
       delete date_cache_;
@@ -1032,6 +1050,11 @@ class Isolate {
     date_cache_ = date_cache;
   }
 
+#ifdef V8_I18N_SUPPORT
+  // Created on first use.
+  ICUObjectCache* icu_object_cache();
+#endif
+
   Map* get_initial_js_array_map(ElementsKind kind);
 
   bool IsFastArrayConstructorPrototypeChainIntact();
@@ -1094,6 +1117,8 @@ class Isolate {
   int id() const { return static_cast<int>(id_); }
 
   HStatistics* GetHStatistics();
+  RegExpProfile* GetRegExpProfile();
+  ICStats* GetICStats();
   HTracer* GetHTracer();
   CodeTracer* GetCodeTracer();
 
@@ -1253,6 +1278,8 @@ class Isolate {
   KeyedLookupCache* keyed_lookup_cache_;
   ContextSlotCache* context_slot_cache_;
   DescriptorLookupCache* descriptor_lookup_cache_;
+  JsonTransitionCache* json_transition_cache_;
+  ForInCache* for_in_cache_;
   HandleScopeData handle_scope_data_;
   HandleScopeImplementer* handle_scope_implementer_;
   UnicodeCache* unicode_cache_;
@@ -1276,6 +1303,10 @@ class Isolate {
       regexp_macro_assembler_canonicalize_;
   RegExpStack* regexp_stack_;
   DateCache* date_cache_;
+  MicrotaskQueue* microtask_queue_;
+#ifdef V8_I18N_SUPPORT
+  ICUObjectCache* icu_object_cache_;
+#endif
   unibrow::Mapping<unibrow::Ecma262Canonicalize> interp_canonicalize_mapping_;
   CodeStubInterfaceDescriptor* code_stub_interface_descriptors_;
   CallInterfaceDescriptor* call_descriptors_;
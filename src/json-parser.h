@@ -71,6 +71,39 @@ class JsonParser BASE_EMBEDDED {
   // Parse a string containing a single JSON value.
   Handle<Object> ParseJson();
 
+  // Returns the index of the first character at or after |start| that
+  // cannot be part of a plain JSON string literal, i.e. a quote, a
+  // backslash or a control character, or |end| if there is none.
+  static inline int FindStringLiteralEnd(const uint8_t* chars,
+                                         int start,
+                                         int end) {
+    const uint8_t* cursor = chars + start;
+    const uint8_t* limit = chars + end;
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+    // Test a word at a time: a byte is zero after xor-ing with the quote
+    // or backslash pattern, and borrows from subtracting 0x20 reach the
+    // high bit of bytes below 0x20.  Characters >= 0x80 are masked out.
+    const uintptr_t kOnes = kUintptrAllBitsSet / 0xFF;
+    const uintptr_t kHighBits = kOnes * 0x80;
+    while (cursor + sizeof(uintptr_t) <= limit) {
+      uintptr_t word = *reinterpret_cast<const uintptr_t*>(cursor);
+      uintptr_t quote = word ^ (kOnes * '"');
+      uintptr_t backslash = word ^ (kOnes * '\\');
+      uintptr_t special = ((quote - kOnes) & ~quote) |
+                          ((backslash - kOnes) & ~backslash) |
+                          ((word - kOnes * 0x20) & ~word);
+      if (special & kHighBits) break;
+      cursor += sizeof(uintptr_t);
+    }
+#endif
+    while (cursor < limit) {
+      uint8_t c = *cursor;
+      if (c == '"' || c == '\\' || c < 0x20) break;
+      ++cursor;
+    }
+    return static_cast<int>(cursor - chars);
+  }
+
   inline void Advance() {
     position_++;
     if (position_ >= source_length_) {
@@ -151,6 +184,31 @@ class JsonParser BASE_EMBEDDED {
     return ScanJsonString<true>();
   }
 
+  // Tries to match the key of the field transition last followed from the
+  // map against the source, for maps that have several transitions.
+  bool ParseCachedTransitionKey(Handle<Map> map, Handle<Map>* target) {
+    Map* cached_target;
+    Name* name =
+        isolate()->json_transition_cache()->Lookup(*map, &cached_target);
+    if (name == NULL || !name->IsString()) return false;
+    {
+      // The transition may have been replaced since it was cached.
+      DisallowHeapAllocation no_gc;
+      if (!map->HasTransitionArray()) return false;
+      TransitionArray* transitions = map->transitions();
+      int transition = transitions->Search(name);
+      if (transition == TransitionArray::kNotFound ||
+          transitions->GetTarget(transition) != cached_target) {
+        return false;
+      }
+    }
+    Handle<String> key(String::cast(name), isolate());
+    Handle<Map> cached(cached_target, isolate());
+    if (!ParseJsonString(key)) return false;
+    *target = cached;
+    return true;
+  }
+
   template <bool is_internalized>
   Handle<String> ScanJsonString();
   // Creates a new string and copies prefix[start..end] into the beginning
@@ -384,12 +442,19 @@ Handle<Object> JsonParser<seq_ascii>::ParseJsonObject() {
         Handle<Map> target;
         if (seq_ascii) {
           key = JSObject::ExpectedTransitionKey(map);
-          follow_expected = !key.is_null() && ParseJsonString(key);
+          if (!key.is_null()) {
+            follow_expected = ParseJsonString(key);
+            // If the expected transition hits, follow it.
+            if (follow_expected) {
+              target = JSObject::ExpectedTransitionTarget(map);
+            }
+          } else {
+            // Otherwise documents of the same shape likely take the same
+            // transition as the previous one.
+            follow_expected = ParseCachedTransitionKey(map, &target);
+          }
         }
-        // If the expected transition hits, follow it.
-        if (follow_expected) {
-          target = JSObject::ExpectedTransitionTarget(map);
-        } else {
+        if (!follow_expected) {
           // If the expected transition failed, parse an internalized string and
           // try to find a matching transition.
           key = ParseJsonInternalizedString();
@@ -398,6 +463,9 @@ Handle<Object> JsonParser<seq_ascii>::ParseJsonObject() {
           target = JSObject::FindTransitionToField(map, key);
           // If a transition was found, follow it and continue.
           transitioning = !target.is_null();
+          if (seq_ascii && transitioning) {
+            isolate()->json_transition_cache()->Update(*map, *key, *target);
+          }
         }
         if (c0_ != ':') return ReportUnexpectedCharacter();
 
@@ -540,20 +608,25 @@ Handle<Object> JsonParser<seq_ascii>::ParseJsonNumber() {
   double number;
   if (seq_ascii) {
     Vector<const uint8_t> chars(seq_source_->GetChars() +  beg_pos, length);
-    number = StringToDouble(isolate()->unicode_cache(),
-                             Vector<const char>::cast(chars),
-                             NO_FLAGS,  // Hex, octal or trailing junk.
-                             OS::nan_value());
+    if (!FastStringToDouble(chars, &number)) {
+      number = StringToDouble(isolate()->unicode_cache(),
+                              Vector<const char>::cast(chars),
+                              NO_FLAGS,  // Hex, octal or trailing junk.
+                              OS::nan_value());
+    }
   } else {
     Vector<uint8_t> buffer = Vector<uint8_t>::New(length);
     String::WriteToFlat(*source_, buffer.start(), beg_pos, position_);
     Vector<const uint8_t> result =
         Vector<const uint8_t>(buffer.start(), length);
-    number = StringToDouble(isolate()->unicode_cache(),
-                            // TODO(dcarney): Convert StringToDouble to uint_t.
-                            Vector<const char>::cast(result),
-                            NO_FLAGS,  // Hex, octal or trailing junk.
-                            0.0);
+    if (!FastStringToDouble(result, &number)) {
+      number = StringToDouble(isolate()->unicode_cache(),
+                              // TODO(dcarney): Convert StringToDouble to
+                              // uint_t.
+                              Vector<const char>::cast(result),
+                              NO_FLAGS,  // Hex, octal or trailing junk.
+                              0.0);
+    }
     buffer.Dispose();
   }
   SkipWhitespace();
@@ -707,7 +780,8 @@ Handle<String> JsonParser<seq_ascii>::ScanJsonString() {
     // Fast path for existing internalized strings.  If the the string being
     // parsed is not a known internalized string, contains backslashes or
     // unexpectedly reaches the end of string, return with an empty handle.
-    uint32_t running_hash = isolate()->heap()->HashSeed();
+    uint32_t seed = isolate()->heap()->HashSeed();
+    uint32_t running_hash = seed;
     int position = position_;
     uc32 c0 = c0_;
     do {
@@ -740,6 +814,12 @@ Handle<String> JsonParser<seq_ascii>::ScanJsonString() {
         ? StringHasher::GetHashCore(running_hash) : length;
     Vector<const uint8_t> string_vector(
         seq_source_->GetChars() + position_, length);
+    if (length >= StringHasher::kBlockHashMinLength &&
+        length <= String::kMaxHashCalcLength) {
+      // Long keys use the block hash instead.
+      hash = StringHasher::HashSequentialString(
+          string_vector.start(), length, seed) >> String::kHashShift;
+    }
     StringTable* string_table = isolate()->heap()->string_table();
     uint32_t capacity = string_table->Capacity();
     uint32_t entry = StringTable::FirstProbe(hash, capacity);
@@ -754,6 +834,7 @@ Handle<String> JsonParser<seq_ascii>::ScanJsonString() {
         break;
       }
       if (element != isolate()->heap()->the_hole_value() &&
+          String::cast(element)->Hash() == hash &&
           String::cast(element)->IsOneByteEqualTo(string_vector)) {
         result = Handle<String>(String::cast(element), isolate());
 #ifdef DEBUG
@@ -773,8 +854,23 @@ Handle<String> JsonParser<seq_ascii>::ScanJsonString() {
   }
 
   int beg_pos = position_;
+  if (seq_ascii) {
+    // Skip over the plain characters in bulk, no allocation happens before
+    // they are copied below.
+    position_ = FindStringLiteralEnd(seq_source_->GetChars(),
+                                     position_, source_length_);
+    c0_ = (position_ < source_length_)
+        ? seq_source_->SeqOneByteStringGet(position_)
+        : kEndOfString;
+    if (c0_ == '\\') {
+      return SlowScanJsonString<SeqOneByteString, uint8_t>(source_,
+                                                           beg_pos,
+                                                           position_);
+    }
+    if (c0_ != '"') return Handle<String>::null();
+  }
   // Fast case for ASCII only without escape characters.
-  do {
+  while (c0_ != '"') {
     // Check for control character (0x00-0x1f) or unterminated string (<0).
     if (c0_ < 0x20) return Handle<String>::null();
     if (c0_ != '\\') {
@@ -790,7 +886,7 @@ Handle<String> JsonParser<seq_ascii>::ScanJsonString() {
                                                            beg_pos,
                                                            position_);
     }
-  } while (c0_ != '"');
+  }
   int length = position_ - beg_pos;
   Handle<String> result = factory()->NewRawOneByteString(length, pretenure_);
   uint8_t* dest = SeqOneByteString::cast(*result)->GetChars();
@@ -35,12 +35,135 @@
 namespace v8 {
 namespace internal {
 
+// Collects serialized JSON into chunks of the size requested by an embedder
+// supplied v8::OutputStream.  Non-ASCII characters can only occur inside
+// string literals, so they are either encoded as UTF-8 or, for 7-bit
+// streams, escaped as \uXXXX without changing the meaning of the text.
+class JsonStreamWriter BASE_EMBEDDED {
+ public:
+  explicit JsonStreamWriter(v8::OutputStream* stream)
+      : stream_(stream),
+        chunk_size_(stream->GetChunkSize()),
+        chunk_(chunk_size_),
+        chunk_pos_(0),
+        utf8_(stream->GetOutputEncoding() == v8::OutputStream::kUtf8),
+        pending_lead_(unibrow::Utf16::kNoPreviousCharacter),
+        aborted_(false) {
+    ASSERT(chunk_size_ > 0);
+  }
+
+  bool aborted() { return aborted_; }
+
+  void AddOneByte(Vector<const uint8_t> chars) {
+    FlushPendingLead();
+    for (int i = 0; i < chars.length(); i++) {
+      uint8_t c = chars[i];
+      if (c <= unibrow::Utf8::kMaxOneByteChar) {
+        AddByte(c);
+      } else {
+        AddNonAscii(c);
+      }
+    }
+  }
+
+  void AddTwoByte(Vector<const uc16> chars) {
+    for (int i = 0; i < chars.length(); i++) {
+      uc16 c = chars[i];
+      if (pending_lead_ != unibrow::Utf16::kNoPreviousCharacter) {
+        // A surrogate pair may straddle two parts of the stringifier.
+        int lead = pending_lead_;
+        pending_lead_ = unibrow::Utf16::kNoPreviousCharacter;
+        if (unibrow::Utf16::IsTrailSurrogate(c)) {
+          AddUtf8(unibrow::Utf16::CombineSurrogatePair(lead, c));
+          continue;
+        }
+        AddUtf8(lead);
+      }
+      if (c <= unibrow::Utf8::kMaxOneByteChar) {
+        AddByte(c);
+      } else if (utf8_ && unibrow::Utf16::IsLeadSurrogate(c)) {
+        pending_lead_ = c;
+      } else {
+        AddNonAscii(c);
+      }
+    }
+  }
+
+  // Writes out what is buffered and signals the end of the stream, unless
+  // the stream aborted.  Returns whether the output is complete.
+  bool Finalize() {
+    FlushPendingLead();
+    if (chunk_pos_ > 0) WriteChunk();
+    if (aborted_) return false;
+    stream_->EndOfStream();
+    return true;
+  }
+
+ private:
+  void AddByte(uint8_t c) {
+    ASSERT(chunk_pos_ < chunk_size_);
+    chunk_[chunk_pos_++] = static_cast<char>(c);
+    if (chunk_pos_ == chunk_size_) WriteChunk();
+  }
+
+  void AddNonAscii(unibrow::uchar c) {
+    if (utf8_) {
+      AddUtf8(c);
+      return;
+    }
+    static const char kHexChars[] = "0123456789abcdef";
+    ASSERT(c <= unibrow::Utf8::kMaxThreeByteChar);
+    AddByte('\\');
+    AddByte('u');
+    for (int shift = 12; shift >= 0; shift -= 4) {
+      AddByte(kHexChars[(c >> shift) & 0xf]);
+    }
+  }
+
+  void AddUtf8(unibrow::uchar c) {
+    char buffer[unibrow::Utf8::kMaxEncodedSize];
+    int length = unibrow::Utf8::Encode(
+        buffer, c, unibrow::Utf16::kNoPreviousCharacter);
+    for (int i = 0; i < length; i++) AddByte(buffer[i]);
+  }
+
+  void FlushPendingLead() {
+    if (pending_lead_ == unibrow::Utf16::kNoPreviousCharacter) return;
+    AddUtf8(pending_lead_);
+    pending_lead_ = unibrow::Utf16::kNoPreviousCharacter;
+  }
+
+  void WriteChunk() {
+    if (!aborted_ && stream_->WriteAsciiChunk(chunk_.start(), chunk_pos_) ==
+        v8::OutputStream::kAbort) {
+      aborted_ = true;
+    }
+    chunk_pos_ = 0;
+  }
+
+  v8::OutputStream* stream_;
+  int chunk_size_;
+  ScopedVector<char> chunk_;
+  int chunk_pos_;
+  bool utf8_;
+  int pending_lead_;
+  bool aborted_;
+};
+
+
 class BasicJsonStringifier BASE_EMBEDDED {
  public:
   explicit BasicJsonStringifier(Isolate* isolate);
 
   MaybeObject* Stringify(Handle<Object> object);
 
+  // Like Stringify, but pushes the text into |stream| instead of returning
+  // a string.  Returns true if the stream received the complete text,
+  // false if the stream aborted and undefined if there was nothing to
+  // serialize.
+  MaybeObject* StringifyToStream(Handle<Object> object,
+                                 v8::OutputStream* stream);
+
   INLINE(static MaybeObject* StringifyString(Isolate* isolate,
                                              Handle<String> object));
 
@@ -49,7 +172,15 @@ class BasicJsonStringifier BASE_EMBEDDED {
   static const int kMaxPartLength = 16 * 1024;
   static const int kPartLengthGrowthFactor = 2;
 
-  enum Result { UNCHANGED, SUCCESS, EXCEPTION, CIRCULAR, STACK_OVERFLOW };
+  enum Result {
+    UNCHANGED, SUCCESS, EXCEPTION, CIRCULAR, STACK_OVERFLOW, ABORTED
+  };
+
+  MaybeObject* Fail(Result result);
+
+  // Attaches a finished string to the output, i.e. to the accumulator or,
+  // when streaming, to the stream.
+  void Attach(Handle<String> string);
 
   void Extend();
 
@@ -153,6 +284,12 @@ class BasicJsonStringifier BASE_EMBEDDED {
   template <typename Char>
   INLINE(static bool DoNotEscape(Char c));
 
+  // Returns the number of leading characters of |src| that are copied
+  // verbatim, i.e. that are neither a quote, a backslash nor a control
+  // character.
+  template <typename Char>
+  INLINE(static int PlainPrefixLength(const Char* src, int length));
+
   template <typename Char>
   INLINE(static Vector<const Char> GetCharVector(Handle<String> string));
 
@@ -175,6 +312,7 @@ class BasicJsonStringifier BASE_EMBEDDED {
   Handle<String> current_part_;
   Handle<String> tojson_string_;
   Handle<JSArray> stack_;
+  JsonStreamWriter* writer_;
   int current_index_;
   int part_length_;
   bool is_ascii_;
@@ -254,7 +392,7 @@ const char* const BasicJsonStringifier::JsonEscapeTable =
 
 
 BasicJsonStringifier::BasicJsonStringifier(Isolate* isolate)
-    : isolate_(isolate), current_index_(0), is_ascii_(true) {
+    : isolate_(isolate), writer_(NULL), current_index_(0), is_ascii_(true) {
   factory_ = isolate_->factory();
   accumulator_store_ = Handle<JSValue>::cast(
                            factory_->ToObject(factory_->empty_string()));
@@ -266,12 +404,41 @@ BasicJsonStringifier::BasicJsonStringifier(Isolate* isolate)
 
 
 MaybeObject* BasicJsonStringifier::Stringify(Handle<Object> object) {
-  switch (SerializeObject(object)) {
+  Result result = SerializeObject(object);
+  switch (result) {
     case UNCHANGED:
       return isolate_->heap()->undefined_value();
     case SUCCESS:
       ShrinkCurrentPart();
       return *factory_->NewConsString(accumulator(), current_part_);
+    default:
+      return Fail(result);
+  }
+}
+
+
+MaybeObject* BasicJsonStringifier::StringifyToStream(
+    Handle<Object> object, v8::OutputStream* stream) {
+  JsonStreamWriter writer(stream);
+  writer_ = &writer;
+  Result result = SerializeObject(object);
+  switch (result) {
+    case UNCHANGED:
+      return isolate_->heap()->undefined_value();
+    case SUCCESS:
+      ShrinkCurrentPart();
+      Attach(current_part_);
+      return isolate_->heap()->ToBoolean(writer.Finalize());
+    case ABORTED:
+      return isolate_->heap()->false_value();
+    default:
+      return Fail(result);
+  }
+}
+
+
+MaybeObject* BasicJsonStringifier::Fail(Result result) {
+  switch (result) {
     case CIRCULAR:
       return isolate_->Throw(*factory_->NewTypeError(
                  "circular_structure", HandleVector<Object>(NULL, 0)));
@@ -379,6 +546,8 @@ BasicJsonStringifier::Result BasicJsonStringifier::StackPush(
     Handle<Object> object) {
   StackLimitCheck check(isolate_);
   if (check.HasOverflowed()) return STACK_OVERFLOW;
+  // Stop serializing as soon as the embedder has lost interest.
+  if (writer_ != NULL && writer_->aborted()) return ABORTED;
 
   int length = Smi::cast(stack_->length())->value();
   FixedArray* elements = FixedArray::cast(stack_->elements());
@@ -485,8 +654,7 @@ BasicJsonStringifier::Result BasicJsonStringifier::SerializeGeneric(
   ShrinkCurrentPart();  // Shrink.
   part_length_ = kInitialPartLength;  // Allocate conservatively.
   Extend();             // Attach current part and allocate new part.
-  // Attach result string to the accumulator.
-  set_accumulator(factory_->NewConsString(accumulator(), result_string));
+  Attach(result_string);
   return SUCCESS;
 }
 
@@ -708,11 +876,32 @@ void BasicJsonStringifier::ShrinkCurrentPart() {
 }
 
 
+void BasicJsonStringifier::Attach(Handle<String> string) {
+  if (writer_ == NULL) {
+    set_accumulator(factory_->NewConsString(accumulator(), string));
+    return;
+  }
+  string = FlattenGetString(string);
+  DisallowHeapAllocation no_gc;
+  String::FlatContent flat = string->GetFlatContent();
+  if (flat.IsAscii()) {
+    writer_->AddOneByte(flat.ToOneByteVector());
+  } else {
+    writer_->AddTwoByte(flat.ToUC16Vector());
+  }
+}
+
+
 void BasicJsonStringifier::Extend() {
-  set_accumulator(factory_->NewConsString(accumulator(), current_part_));
+  Attach(current_part_);
   if (part_length_ <= kMaxPartLength / kPartLengthGrowthFactor) {
     part_length_ *= kPartLengthGrowthFactor;
   }
+  if (writer_ != NULL && current_part_->length() == part_length_) {
+    // The part has been written out already, fill it again.
+    current_index_ = 0;
+    return;
+  }
   if (is_ascii_) {
     current_part_ = factory_->NewRawOneByteString(part_length_);
   } else {
@@ -724,7 +913,7 @@ void BasicJsonStringifier::Extend() {
 
 void BasicJsonStringifier::ChangeEncoding() {
   ShrinkCurrentPart();
-  set_accumulator(factory_->NewConsString(accumulator(), current_part_));
+  Attach(current_part_);
   current_part_ = factory_->NewRawTwoByteString(part_length_);
   current_index_ = 0;
   is_ascii_ = false;
@@ -741,21 +930,56 @@ int BasicJsonStringifier::SerializeStringUnchecked_(const SrcChar* src,
   // The <uc16, char> version of this method must not be called.
   ASSERT(sizeof(*dest) >= sizeof(*src));
 
-  for (int i = 0; i < length; i++) {
-    SrcChar c = src[i];
-    if (DoNotEscape(c)) {
-      *(dest++) = static_cast<DestChar>(c);
-    } else {
-      const uint8_t* chars = reinterpret_cast<const uint8_t*>(
-          &JsonEscapeTable[c * kJsonEscapeTableEntrySize]);
-      while (*chars != '\0') *(dest++) = *(chars++);
-    }
+  int i = 0;
+  while (true) {
+    // Copy runs of characters that need no escaping in bulk.
+    int plain = PlainPrefixLength(src + i, length - i);
+    CopyChars(dest, src + i, plain);
+    dest += plain;
+    i += plain;
+    if (i == length) break;
+    const uint8_t* chars = reinterpret_cast<const uint8_t*>(
+        &JsonEscapeTable[src[i] * kJsonEscapeTableEntrySize]);
+    while (*chars != '\0') *(dest++) = *(chars++);
+    i++;
   }
 
   return static_cast<int>(dest - dest_start);
 }
 
 
+template <typename Char>
+int BasicJsonStringifier::PlainPrefixLength(const Char* src, int length) {
+  const Char* cursor = src;
+  const Char* limit = src + length;
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+  // Test a word at a time, see JsonParser::FindStringLiteralEnd.  The same
+  // bit trick works on 16-bit lanes for two-byte sources.
+  const int kCharBits = kBitsPerByte * sizeof(Char);
+  const uintptr_t kOnes =
+      kUintptrAllBitsSet / ((static_cast<uintptr_t>(1) << kCharBits) - 1);
+  const uintptr_t kHighBits = kOnes << (kCharBits - 1);
+  const int kCharsPerWord = sizeof(uintptr_t) / sizeof(Char);
+  while (cursor + kCharsPerWord <= limit) {
+    uintptr_t word = *reinterpret_cast<const uintptr_t*>(cursor);
+    uintptr_t quote = word ^ (kOnes * '"');
+    uintptr_t backslash = word ^ (kOnes * '\\');
+    uintptr_t special = ((quote - kOnes) & ~quote) |
+                        ((backslash - kOnes) & ~backslash) |
+                        ((word - kOnes * 0x20) & ~word);
+    if (special & kHighBits) break;
+    cursor += kCharsPerWord;
+  }
+#endif
+  while (cursor < limit) {
+    Char c = *cursor;
+    if (c == '"' || c == '\\' || c < 0x20) break;
+    ++cursor;
+  }
+  return static_cast<int>(cursor - src);
+}
+
+
 template <bool is_ascii, typename Char>
 void BasicJsonStringifier::SerializeString_(Handle<String> string) {
   int length = string->length();
@@ -75,11 +75,19 @@ int32_t* RegExpImpl::GlobalCache::FetchNext() {
         num_matches_ = 0;  // Signal failed match.
         return NULL;
       }
-      num_matches_ = RegExpImpl::IrregexpExecRaw(regexp_,
+      if (regexp_->TypeTag() == JSRegExp::LINEAR) {
+        num_matches_ = RegExpImpl::LinearExecRaw(regexp_,
                                                  subject_,
                                                  last_end_index,
                                                  register_array_,
                                                  register_array_size_);
+      } else {
+        num_matches_ = RegExpImpl::IrregexpExecRaw(regexp_,
+                                                   subject_,
+                                                   last_end_index,
+                                                   register_array_,
+                                                   register_array_size_);
+      }
     }
 
     if (num_matches_ <= 0) return NULL;
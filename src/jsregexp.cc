@@ -42,6 +42,7 @@
 #include "regexp-macro-assembler.h"
 #include "regexp-macro-assembler-tracer.h"
 #include "regexp-macro-assembler-irregexp.h"
+#include "regexp-profile.h"
 #include "regexp-stack.h"
 
 #ifndef V8_INTERPRETED_REGEXP
@@ -61,6 +62,7 @@
 #endif
 
 #include "interpreter-irregexp.h"
+#include "regexp-linear.h"
 
 
 namespace v8 {
@@ -218,6 +220,15 @@ Handle<Object> RegExpImpl::Compile(Handle<JSRegExp> re,
       has_been_compiled = true;
     }
   }
+  if (!has_been_compiled && FLAG_regexp_linear) {
+    Handle<ByteArray> program = RegExpLinear::Compile(
+        isolate, &parse_result, flags.is_ignore_case(), &zone);
+    if (!program.is_null()) {
+      isolate->factory()->SetRegExpLinearData(
+          re, pattern, flags, program, parse_result.capture_count);
+      has_been_compiled = true;
+    }
+  }
   if (!has_been_compiled) {
     IrregexpInitialize(re, pattern, flags, parse_result.capture_count);
   }
@@ -245,6 +256,8 @@ Handle<Object> RegExpImpl::Exec(Handle<JSRegExp> regexp,
              regexp->GetIsolate()->has_pending_exception());
       return result;
     }
+    case JSRegExp::LINEAR:
+      return LinearExec(regexp, subject, index, last_match_info);
     default:
       UNREACHABLE();
       return Handle<Object>::null();
@@ -361,6 +374,71 @@ Handle<Object> RegExpImpl::AtomExec(Handle<JSRegExp> re,
 }
 
 
+// Linear implementation: Non-backtracking matching, see regexp-linear.h.
+
+
+int RegExpImpl::LinearExecRaw(Handle<JSRegExp> regexp,
+                              Handle<String> subject,
+                              int index,
+                              int32_t* output,
+                              int output_size) {
+  ASSERT(0 <= index);
+  ASSERT(index <= subject->length());
+  int capture_count = regexp->CaptureCount();
+  int registers_per_match = (capture_count + 1) * 2;
+  ASSERT(output_size >= registers_per_match);
+#ifdef V8_INTERPRETED_REGEXP
+  // Global loops in interpreted mode fetch one match at a time.
+  output_size = registers_per_match;
+#endif
+
+  if (!subject->IsFlat()) FlattenString(subject);
+  ByteArray* program =
+      ByteArray::cast(regexp->DataAt(JSRegExp::kLinearProgramIndex));
+  int matches = 0;
+  while (output_size >= registers_per_match) {
+    int result = RegExpLinear::Match(
+        program, *subject, capture_count, output, index);
+    if (result == RE_FAILURE) break;
+    matches++;
+    // Continue after the match, skipping ahead after an empty one.
+    index = output[1];
+    if (output[0] == output[1]) index++;
+    if (index > subject->length()) break;
+    output += registers_per_match;
+    output_size -= registers_per_match;
+  }
+  return matches;
+}
+
+
+Handle<Object> RegExpImpl::LinearExec(Handle<JSRegExp> regexp,
+                                      Handle<String> subject,
+                                      int index,
+                                      Handle<JSArray> last_match_info) {
+  Isolate* isolate = regexp->GetIsolate();
+  int capture_count = regexp->CaptureCount();
+  int required_registers = (capture_count + 1) * 2;
+
+  int32_t* output_registers = NULL;
+  if (required_registers > Isolate::kJSRegexpStaticOffsetsVectorSize) {
+    output_registers = NewArray<int32_t>(required_registers);
+  }
+  SmartArrayPointer<int32_t> auto_release(output_registers);
+  if (output_registers == NULL) {
+    output_registers = isolate->jsregexp_static_offsets_vector();
+  }
+
+  int res = LinearExecRaw(
+      regexp, subject, index, output_registers, required_registers);
+  if (res == RE_FAILURE) return isolate->factory()->null_value();
+
+  ASSERT_EQ(res, RE_SUCCESS);
+  return SetLastMatchInfo(
+      last_match_info, subject, capture_count, output_registers);
+}
+
+
 // Irregexp implementation.
 
 // Ensures that the regexp object contains a compiled version of the
@@ -561,6 +639,7 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
   ASSERT(index <= subject->length());
   ASSERT(subject->IsFlat());
 
+  RegExpProfileScope profile_scope(isolate, regexp);
   bool is_ascii = subject->IsOneByteRepresentationUnderneath();
 
 #ifndef V8_INTERPRETED_REGEXP
@@ -579,6 +658,10 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
                                           output_size,
                                           index,
                                           isolate);
+    if (res == NativeRegExpMacroAssembler::BACKTRACK_LIMIT) {
+      return IrregexpBacktrackLimitExceeded(
+          regexp, subject, index, output, output_size);
+    }
     if (res != NativeRegExpMacroAssembler::RETRY) {
       ASSERT(res != NativeRegExpMacroAssembler::EXCEPTION ||
              isolate->has_pending_exception());
@@ -622,6 +705,10 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
                                                      subject,
                                                      raw_output,
                                                      index);
+  if (result == RE_BACKTRACK_LIMIT) {
+    return IrregexpBacktrackLimitExceeded(
+        regexp, subject, index, output, number_of_capture_registers);
+  }
   if (result == RE_SUCCESS) {
     // Copy capture results to the start of the registers array.
     OS::MemCopy(
@@ -636,6 +723,36 @@ int RegExpImpl::IrregexpExecRaw(Handle<JSRegExp> regexp,
 }
 
 
+int RegExpImpl::IrregexpBacktrackLimitExceeded(Handle<JSRegExp> regexp,
+                                               Handle<String> subject,
+                                               int index,
+                                               int32_t* output,
+                                               int output_size) {
+  Isolate* isolate = regexp->GetIsolate();
+  Zone zone(isolate);
+  JSRegExp::Flags flags = regexp->GetFlags();
+  Handle<String> pattern(regexp->Pattern());
+  int capture_count = regexp->CaptureCount();
+  RegExpCompileData compile_data;
+  FlatStringReader reader(isolate, pattern);
+  if (RegExpParser::ParseRegExp(&reader, flags.is_multiline(),
+                                &compile_data, &zone)) {
+    Handle<ByteArray> program = RegExpLinear::Compile(
+        isolate, &compile_data, flags.is_ignore_case(), &zone);
+    if (!program.is_null()) {
+      // Later executions of this regexp go straight to the linear matcher.
+      isolate->factory()->SetRegExpLinearData(
+          regexp, pattern, flags, program, capture_count);
+      return LinearExecRaw(regexp, subject, index, output, output_size);
+    }
+  }
+  Handle<Object> error = isolate->factory()->NewRangeError(
+      "regexp_backtrack_limit", HandleVector<Object>(NULL, 0));
+  isolate->Throw(*error);
+  return RE_EXCEPTION;
+}
+
+
 Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> regexp,
                                         Handle<String> subject,
                                         int previous_index,
@@ -670,8 +787,9 @@ Handle<Object> RegExpImpl::IrregexpExec(Handle<JSRegExp> regexp,
   int res = RegExpImpl::IrregexpExecRaw(
       regexp, subject, previous_index, output_registers, required_registers);
   if (res == RE_SUCCESS) {
-    int capture_count =
-        IrregexpNumberOfCaptures(FixedArray::cast(regexp->data()));
+    // Not IrregexpNumberOfCaptures: running out of backtracks may have
+    // switched the regexp over to the linear-time matcher.
+    int capture_count = regexp->CaptureCount();
     return SetLastMatchInfo(
         last_match_info, subject, capture_count, output_registers);
   }
@@ -725,6 +843,8 @@ RegExpImpl::GlobalCache::GlobalCache(Handle<JSRegExp> regexp,
     registers_per_match_ = kAtomRegistersPerMatch;
     // There is no distinction between interpreted and native for atom regexps.
     interpreted = false;
+  } else if (regexp_->TypeTag() == JSRegExp::LINEAR) {
+    registers_per_match_ = (regexp_->CaptureCount() + 1) * 2;
   } else {
     registers_per_match_ = RegExpImpl::IrregexpPrepare(regexp_, subject_);
     if (registers_per_match_ < 0) {
@@ -3811,6 +3931,11 @@ bool BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
   }
 
   if (found_single_character) {
+    const uc16 chars[] = { static_cast<uc16>(single_character) };
+    masm->SkipUntilCharacterAfterAnd(
+        max_lookahead,
+        Vector<const uc16>(chars, 1),
+        max_char_ > kSize ? RegExpMacroAssembler::kTableMask : 0xffff);
     Label cont, again;
     masm->Bind(&again);
     masm->LoadCurrentCharacter(max_lookahead, &cont, true);
@@ -3833,6 +3958,23 @@ bool BoyerMooreLookahead::EmitSkipInstructions(RegExpMacroAssembler* masm) {
       min_lookahead, max_lookahead, boolean_skip_table);
   ASSERT(skip_distance != 0);
 
+  // A vectorized scan for the character at max_lookahead beats striding
+  // the table when only a few characters can start a match.
+  static const int kMaxScanCharacters = 3;
+  uc16 scan_chars[kMaxScanCharacters];
+  int scan_count = 0;
+  for (int i = 0; i < kSize && scan_count <= kMaxScanCharacters; i++) {
+    if (boolean_skip_table->get(i) == 0) continue;
+    if (scan_count < kMaxScanCharacters) scan_chars[scan_count] = i;
+    scan_count++;
+  }
+  if (scan_count <= kMaxScanCharacters) {
+    masm->SkipUntilCharacterAfterAnd(
+        max_lookahead,
+        Vector<const uc16>(scan_chars, scan_count),
+        RegExpMacroAssembler::kTableMask);
+  }
+
   Label cont, again;
   masm->Bind(&again);
   masm->LoadCurrentCharacter(max_lookahead, &cont, true);
@@ -6115,6 +6257,9 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
     macro_assembler.SetCurrentPositionFromEnd(max_length);
   }
 
+  macro_assembler.set_backtrack_limit(FLAG_regexp_backtrack_limit);
+  macro_assembler.set_count_backtracks(FLAG_regexp_profile);
+
   if (is_global) {
     macro_assembler.set_global_mode(
         (data->tree->min_match() > 0)
@@ -105,7 +105,28 @@ class RegExpImpl {
                                  int index,
                                  Handle<JSArray> lastMatchInfo);
 
-  enum IrregexpResult { RE_FAILURE = 0, RE_SUCCESS = 1, RE_EXCEPTION = -1 };
+  // RE_BACKTRACK_LIMIT is only passed from the irregexp engines to
+  // IrregexpExecRaw, which handles it.
+  enum IrregexpResult {
+    RE_BACKTRACK_LIMIT = -3,
+    RE_FAILURE = 0,
+    RE_SUCCESS = 1,
+    RE_EXCEPTION = -1
+  };
+
+  // Executes a regexp compiled for the linear-time matcher.  Like irregexp
+  // native code, this stores as many consecutive matches as fit in the
+  // output and returns their number.
+  static int LinearExecRaw(Handle<JSRegExp> regexp,
+                           Handle<String> subject,
+                           int index,
+                           int32_t* output,
+                           int output_size);
+
+  static Handle<Object> LinearExec(Handle<JSRegExp> regexp,
+                                   Handle<String> subject,
+                                   int index,
+                                   Handle<JSArray> lastMatchInfo);
 
   // Prepare a RegExp for being executed one or more times (using
   // IrregexpExecOnce) on the subject.
@@ -236,6 +257,14 @@ class RegExpImpl {
   static const int kRegWxpCompiledLimit = 1 * MB;
 
  private:
+  // Redoes a match that ran out of backtracks with the linear-time matcher,
+  // or throws if the pattern needs backtracking.
+  static int IrregexpBacktrackLimitExceeded(Handle<JSRegExp> regexp,
+                                            Handle<String> subject,
+                                            int index,
+                                            int32_t* output,
+                                            int output_size);
+
   static bool CompileIrregexp(
       Handle<JSRegExp> re, Handle<String> sample_subject, bool is_ascii);
   static inline bool EnsureCompiledIrregexp(
@@ -33,6 +33,7 @@
 #include "../checks.h"
 // TODO(jochen): Why is cpu.h not in platform/?
 #include "../cpu.h"
+#include "../platform.h"
 #include "worker-thread.h"
 
 namespace v8 {
@@ -40,17 +41,29 @@ namespace internal {
 
 
 DefaultPlatform::DefaultPlatform()
-    : initialized_(false), thread_pool_size_(0) {}
+    : initialized_(false),
+      thread_pool_size_(0),
+      max_queue_depth_(0),
+      queue_(NULL) {}
 
 
 DefaultPlatform::~DefaultPlatform() {
   LockGuard<Mutex> guard(&lock_);
-  queue_.Terminate();
   if (initialized_) {
+    queue_->Terminate();
     for (std::vector<WorkerThread*>::iterator i = thread_pool_.begin();
          i != thread_pool_.end(); ++i) {
       delete *i;
     }
+    delete queue_;
+  }
+  for (std::map<v8::Isolate*, std::deque<IdleTask*> >::iterator i =
+           idle_task_queue_.begin();
+       i != idle_task_queue_.end(); ++i) {
+    while (!i->second.empty()) {
+      delete i->second.front();
+      i->second.pop_front();
+    }
   }
 }
 
@@ -64,19 +77,31 @@ void DefaultPlatform::SetThreadPoolSize(int thread_pool_size) {
 }
 
 
+void DefaultPlatform::SetMaxQueueDepth(int max_queue_depth) {
+  LockGuard<Mutex> guard(&lock_);
+  ASSERT(max_queue_depth >= 0);
+  max_queue_depth_ = max_queue_depth;
+}
+
+
 void DefaultPlatform::EnsureInitialized() {
   LockGuard<Mutex> guard(&lock_);
   if (initialized_) return;
   initialized_ = true;
 
+  queue_ = new TaskQueue(thread_pool_size_, max_queue_depth_);
   for (int i = 0; i < thread_pool_size_; ++i)
-    thread_pool_.push_back(new WorkerThread(&queue_));
+    thread_pool_.push_back(new WorkerThread(queue_, i));
 }
 
 void DefaultPlatform::CallOnBackgroundThread(Task *task,
                                              ExpectedRuntime expected_runtime) {
   EnsureInitialized();
-  queue_.Append(task);
+  if (!queue_->TryAppend(task, expected_runtime)) {
+    // The queue is full, so apply back pressure by running the task here.
+    task->Run();
+    delete task;
+  }
 }
 
 
@@ -86,4 +111,44 @@ void DefaultPlatform::CallOnForegroundThread(v8::Isolate* isolate, Task* task) {
   delete task;
 }
 
+
+void DefaultPlatform::CallIdleOnForegroundThread(v8::Isolate* isolate,
+                                                 IdleTask* task) {
+  LockGuard<Mutex> guard(&lock_);
+  idle_task_queue_[isolate].push_back(task);
+}
+
+
+bool DefaultPlatform::IdleTasksEnabled(v8::Isolate* isolate) {
+  return true;
+}
+
+
+void DefaultPlatform::RunIdleTasks(v8::Isolate* isolate,
+                                   double idle_time_in_ms) {
+  double deadline = OS::TimeCurrentMillis() + idle_time_in_ms;
+  // Tasks posted while running idle tasks wait for the next idle period.
+  std::deque<IdleTask*> tasks;
+  {
+    LockGuard<Mutex> guard(&lock_);
+    std::map<v8::Isolate*, std::deque<IdleTask*> >::iterator it =
+        idle_task_queue_.find(isolate);
+    if (it == idle_task_queue_.end()) return;
+    tasks.swap(it->second);
+  }
+  double remaining = idle_time_in_ms;
+  while (!tasks.empty() && remaining > 0) {
+    IdleTask* task = tasks.front();
+    tasks.pop_front();
+    task->Run(remaining);
+    delete task;
+    remaining = deadline - OS::TimeCurrentMillis();
+  }
+  if (tasks.empty()) return;
+  // Put the tasks that did not get to run back at the front of the queue.
+  LockGuard<Mutex> guard(&lock_);
+  std::deque<IdleTask*>& queue = idle_task_queue_[isolate];
+  queue.insert(queue.begin(), tasks.begin(), tasks.end());
+}
+
 } }  // namespace v8::internal
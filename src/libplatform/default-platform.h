@@ -28,6 +28,8 @@
 #ifndef V8_LIBPLATFORM_DEFAULT_PLATFORM_H_
 #define V8_LIBPLATFORM_DEFAULT_PLATFORM_H_
 
+#include <deque>
+#include <map>
 #include <vector>
 
 #include "../../include/v8-platform.h"
@@ -50,22 +52,39 @@ class DefaultPlatform : public Platform {
 
   void SetThreadPoolSize(int thread_pool_size);
 
+  // Limits the number of pending background tasks. Once the limit is
+  // reached, further background tasks are run on the posting thread.
+  // A |max_queue_depth| of 0 means no limit. Like the thread pool size, this
+  // only takes effect if set before the first task is posted.
+  void SetMaxQueueDepth(int max_queue_depth);
+
   void EnsureInitialized();
 
+  // Runs the idle tasks posted for |isolate| until |idle_time_in_ms| has
+  // passed or no idle task is left. Has to be called on the thread of the
+  // isolate.
+  void RunIdleTasks(v8::Isolate* isolate, double idle_time_in_ms);
+
   // v8::Platform implementation.
   virtual void CallOnBackgroundThread(
       Task *task, ExpectedRuntime expected_runtime) V8_OVERRIDE;
   virtual void CallOnForegroundThread(v8::Isolate *isolate,
                                       Task *task) V8_OVERRIDE;
+  virtual void CallIdleOnForegroundThread(v8::Isolate* isolate,
+                                          IdleTask* task) V8_OVERRIDE;
+  virtual bool IdleTasksEnabled(v8::Isolate* isolate) V8_OVERRIDE;
 
  private:
-  static const int kMaxThreadPoolSize = 4;
+  static const int kMaxThreadPoolSize = 16;
 
   Mutex lock_;
   bool initialized_;
   int thread_pool_size_;
+  int max_queue_depth_;
   std::vector<WorkerThread*> thread_pool_;
-  TaskQueue queue_;
+  // Has one lane per worker thread. Created by EnsureInitialized.
+  TaskQueue* queue_;
+  std::map<v8::Isolate*, std::deque<IdleTask*> > idle_task_queue_;
 
   DISALLOW_COPY_AND_ASSIGN(DefaultPlatform);
 };
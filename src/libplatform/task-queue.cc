@@ -27,53 +27,122 @@
 
 #include "task-queue.h"
 
-// TODO(jochen): We should have our own version of checks.h.
 #include "../checks.h"
+#include "../platform.h"
 
 namespace v8 {
 namespace internal {
 
-TaskQueue::TaskQueue() : process_queue_semaphore_(0), terminated_(false) {}
+TaskQueue::TaskQueue(int number_of_lanes, int max_depth)
+    : lanes_(new Lane[number_of_lanes]),
+      number_of_lanes_(number_of_lanes),
+      max_depth_(max_depth),
+      process_queue_semaphore_(0),
+      next_lane_(0),
+      size_(0),
+      terminated_(0) {
+  ASSERT(number_of_lanes > 0);
+  ASSERT(max_depth >= 0);
+}
 
 
 TaskQueue::~TaskQueue() {
-  LockGuard<Mutex> guard(&lock_);
-  ASSERT(terminated_);
-  ASSERT(task_queue_.empty());
+  ASSERT(IsTerminated());
+#ifdef DEBUG
+  for (int i = 0; i < number_of_lanes_; ++i) {
+    LockGuard<Mutex> guard(&lanes_[i].lock);
+    for (int priority = 0; priority < kNumberOfPriorities; ++priority) {
+      ASSERT(lanes_[i].tasks[priority].empty());
+    }
+  }
+#endif
+  delete[] lanes_;
+}
+
+
+void TaskQueue::Append(Task* task,
+                       Platform::ExpectedRuntime expected_runtime) {
+  ASSERT(!IsTerminated());
+  Barrier_AtomicIncrement(&size_, 1);
+  Push(task, expected_runtime);
+}
+
+
+bool TaskQueue::TryAppend(Task* task,
+                          Platform::ExpectedRuntime expected_runtime) {
+  ASSERT(!IsTerminated());
+  Atomic32 new_size = Barrier_AtomicIncrement(&size_, 1);
+  if (max_depth_ > 0 && new_size > max_depth_) {
+    Barrier_AtomicIncrement(&size_, -1);
+    return false;
+  }
+  Push(task, expected_runtime);
+  return true;
 }
 
 
-void TaskQueue::Append(Task* task) {
-  LockGuard<Mutex> guard(&lock_);
-  ASSERT(!terminated_);
-  task_queue_.push(task);
+void TaskQueue::Push(Task* task, Platform::ExpectedRuntime expected_runtime) {
+  uint32_t ticket =
+      static_cast<uint32_t>(NoBarrier_AtomicIncrement(&next_lane_, 1));
+  Lane* lane = &lanes_[ticket % number_of_lanes_];
+  Priority priority = expected_runtime == Platform::kShortRunningTask
+      ? kHighPriority : kLowPriority;
+  {
+    LockGuard<Mutex> guard(&lane->lock);
+    lane->tasks[priority].push_back(task);
+  }
   process_queue_semaphore_.Signal();
 }
 
 
-Task* TaskQueue::GetNext() {
+Task* TaskQueue::GetNext(int lane) {
+  ASSERT(0 <= lane && lane < number_of_lanes_);
+  // Every signal of the semaphore stands for either a pending task or the
+  // termination of the queue.
+  process_queue_semaphore_.Wait();
   for (;;) {
-    {
-      LockGuard<Mutex> guard(&lock_);
-      if (!task_queue_.empty()) {
-        Task* result = task_queue_.front();
-        task_queue_.pop();
-        return result;
-      }
-      if (terminated_) {
-        process_queue_semaphore_.Signal();
-        return NULL;
-      }
+    Task* result = TryTake(lane);
+    if (result != NULL) {
+      Barrier_AtomicIncrement(&size_, -1);
+      return result;
+    }
+    if (IsTerminated()) {
+      process_queue_semaphore_.Signal();
+      return NULL;
+    }
+    // The task we were signalled for was taken by a reader that had already
+    // scanned past the lane holding its own task. That task is still in the
+    // queue, so look again.
+    Thread::YieldCPU();
+  }
+}
+
+
+Task* TaskQueue::TryTake(int lane) {
+  for (int priority = 0; priority < kNumberOfPriorities; ++priority) {
+    for (int i = 0; i < number_of_lanes_; ++i) {
+      Task* result = TryTakeFrom((lane + i) % number_of_lanes_,
+                                 static_cast<Priority>(priority));
+      if (result != NULL) return result;
     }
-    process_queue_semaphore_.Wait();
   }
+  return NULL;
+}
+
+
+Task* TaskQueue::TryTakeFrom(int lane, Priority priority) {
+  LockGuard<Mutex> guard(&lanes_[lane].lock);
+  std::deque<Task*>* tasks = &lanes_[lane].tasks[priority];
+  if (tasks->empty()) return NULL;
+  Task* result = tasks->front();
+  tasks->pop_front();
+  return result;
 }
 
 
 void TaskQueue::Terminate() {
-  LockGuard<Mutex> guard(&lock_);
-  ASSERT(!terminated_);
-  terminated_ = true;
+  ASSERT(!IsTerminated());
+  Release_Store(&terminated_, 1);
   process_queue_semaphore_.Signal();
 }
 
@@ -28,39 +28,71 @@
 #ifndef V8_LIBPLATFORM_TASK_QUEUE_H_
 #define V8_LIBPLATFORM_TASK_QUEUE_H_
 
-#include <queue>
+#include <deque>
 
-// TODO(jochen): We should have our own version of globals.h.
+#include "../../include/v8-platform.h"
+#include "../atomicops.h"
 #include "../globals.h"
 #include "../platform/mutex.h"
 #include "../platform/semaphore.h"
 
 namespace v8 {
-
-class Task;
-
 namespace internal {
 
+// A queue of tasks shared by a number of worker threads. Tasks are spread
+// over several separately locked lanes, usually one per worker. A reader
+// takes tasks from its own lane first and steals from the other lanes when
+// its own lane is empty. Short running tasks are always handed out before
+// long running ones.
 class TaskQueue {
  public:
-  TaskQueue();
+  // If |max_depth| is positive, TryAppend refuses new tasks while that many
+  // tasks are pending.
+  explicit TaskQueue(int number_of_lanes = 1, int max_depth = 0);
   ~TaskQueue();
 
   // Appends a task to the queue. The queue takes ownership of |task|.
-  void Append(Task* task);
+  void Append(Task* task,
+              Platform::ExpectedRuntime expected_runtime =
+                  Platform::kShortRunningTask);
 
-  // Returns the next task to process. Blocks if no task is available. Returns
-  // NULL if the queue is terminated.
-  Task* GetNext();
+  // Like Append, but returns false without taking ownership of |task| if the
+  // queue already holds the maximal number of pending tasks.
+  bool TryAppend(Task* task, Platform::ExpectedRuntime expected_runtime);
+
+  // Returns the next task to process, preferring tasks from |lane|. Blocks if
+  // no task is available. Returns NULL if the queue is terminated.
+  Task* GetNext(int lane = 0);
 
   // Terminate the queue.
   void Terminate();
 
+  int number_of_lanes() const { return number_of_lanes_; }
+
  private:
-  Mutex lock_;
+  enum Priority {
+    kHighPriority,
+    kLowPriority,
+    kNumberOfPriorities
+  };
+
+  struct Lane {
+    Mutex lock;
+    std::deque<Task*> tasks[kNumberOfPriorities];
+  };
+
+  void Push(Task* task, Platform::ExpectedRuntime expected_runtime);
+  Task* TryTake(int lane);
+  Task* TryTakeFrom(int lane, Priority priority);
+  bool IsTerminated() { return Acquire_Load(&terminated_) != 0; }
+
+  Lane* lanes_;
+  int number_of_lanes_;
+  int max_depth_;
   Semaphore process_queue_semaphore_;
-  std::queue<Task*> task_queue_;
-  bool terminated_;
+  volatile Atomic32 next_lane_;
+  volatile Atomic32 size_;
+  volatile Atomic32 terminated_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskQueue);
 };
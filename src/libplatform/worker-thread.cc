@@ -35,8 +35,8 @@
 namespace v8 {
 namespace internal {
 
-WorkerThread::WorkerThread(TaskQueue* queue)
-    : Thread("V8 WorkerThread"), queue_(queue) {
+WorkerThread::WorkerThread(TaskQueue* queue, int lane)
+    : Thread("V8 WorkerThread"), queue_(queue), lane_(lane) {
   Start();
 }
 
@@ -47,7 +47,7 @@ WorkerThread::~WorkerThread() {
 
 
 void WorkerThread::Run() {
-  while (Task* task = queue_->GetNext()) {
+  while (Task* task = queue_->GetNext(lane_)) {
     task->Run();
     delete task;
   }
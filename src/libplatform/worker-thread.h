@@ -42,7 +42,8 @@ class TaskQueue;
 
 class WorkerThread : public Thread {
  public:
-  explicit WorkerThread(TaskQueue* queue);
+  // The thread prefers tasks from lane |lane| of |queue|.
+  explicit WorkerThread(TaskQueue* queue, int lane = 0);
   virtual ~WorkerThread();
 
   // Thread implementation.
@@ -52,6 +53,7 @@ class WorkerThread : public Thread {
   friend class QuitTask;
 
   TaskQueue* queue_;
+  int lane_;
 
   DISALLOW_COPY_AND_ASSIGN(WorkerThread);
 };
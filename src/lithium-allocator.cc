@@ -556,6 +556,7 @@ LAllocator::LAllocator(int num_values, HGraph* graph)
       active_live_ranges_(8, zone()),
       inactive_live_ranges_(8, zone()),
       reusable_slots_(8, zone()),
+      spilled_live_ranges_(8, zone()),
       next_virtual_register_(num_values),
       first_artificial_register_(num_values),
       mode_(UNALLOCATED_REGISTERS),
@@ -598,6 +599,21 @@ BitVector* LAllocator::ComputeLiveOut(HBasicBlock* block) {
     }
   }
 
+  // An exception thrown anywhere inside an optimized try block deoptimizes
+  // with the catch environment, so its values stay live (and keep their
+  // spill slots) throughout the try block.
+  HEnterTry* try_entry = block->try_entry();
+  if (try_entry != NULL && try_entry->catch_environment() != NULL) {
+    const ZoneList<LOperand*>* values =
+        try_entry->catch_environment()->values();
+    for (int i = 0; i < values->length(); ++i) {
+      LOperand* op = values->at(i);
+      if (op != NULL && op->IsUnallocated()) {
+        live_out->Add(LUnallocated::cast(op)->virtual_register());
+      }
+    }
+  }
+
   return live_out;
 }
 
@@ -1521,6 +1537,7 @@ void LAllocator::AllocateRegisters() {
   ASSERT(UnhandledIsSorted());
 
   ASSERT(reusable_slots_.is_empty());
+  ASSERT(spilled_live_ranges_.is_empty());
   ASSERT(active_live_ranges_.is_empty());
   ASSERT(inactive_live_ranges_.is_empty());
 
@@ -1598,6 +1615,8 @@ void LAllocator::AllocateRegisters() {
       }
     }
 
+    FreeExpiredSpillSlots(position);
+
     ASSERT(!current->HasRegisterAssigned() && !current->IsSpilled());
 
     bool result = TryAllocateFreeReg(current);
@@ -1612,6 +1631,7 @@ void LAllocator::AllocateRegisters() {
   }
 
   reusable_slots_.Rewind(0);
+  spilled_live_ranges_.Rewind(0);
   active_live_ranges_.Rewind(0);
   inactive_live_ranges_.Rewind(0);
 }
@@ -1739,15 +1759,35 @@ void LAllocator::FreeSpillSlot(LiveRange* range) {
 }
 
 
+// Live ranges that end in a spill slot never become active again, so their
+// slot is released here instead of on the transition to handled.
+void LAllocator::FreeExpiredSpillSlots(LifetimePosition position) {
+  for (int i = 0; i < spilled_live_ranges_.length(); ++i) {
+    LiveRange* range = spilled_live_ranges_.at(i);
+    if (range->End().Value() <= position.Value()) {
+      TraceAlloc("Releasing spill slot of live range %d\n", range->id());
+      spilled_live_ranges_.Remove(i);
+      FreeSpillSlot(range);
+      --i;  // The live range was removed from the list of spilled ranges.
+    }
+  }
+}
+
+
+// Picks the first released slot whose previous owner ended before the whole
+// range starts, so that non-interfering ranges share a single stack slot.
 LOperand* LAllocator::TryReuseSpillSlot(LiveRange* range) {
-  if (reusable_slots_.is_empty()) return NULL;
-  if (reusable_slots_.first()->End().Value() >
-      range->TopLevel()->Start().Value()) {
-    return NULL;
+  LifetimePosition start = range->TopLevel()->Start();
+  for (int i = 0; i < reusable_slots_.length(); ++i) {
+    LiveRange* previous = reusable_slots_.at(i);
+    if (previous->End().Value() > start.Value()) continue;
+    LOperand* result = previous->TopLevel()->GetSpillOperand();
+    reusable_slots_.Remove(i);
+    TraceAlloc("Reusing spill slot of live range %d for %d\n",
+               previous->TopLevel()->id(), range->TopLevel()->id());
+    return result;
   }
-  LOperand* result = reusable_slots_.first()->TopLevel()->GetSpillOperand();
-  reusable_slots_.Remove(0);
-  return result;
+  return NULL;
 }
 
 
@@ -2168,6 +2208,9 @@ void LAllocator::Spill(LiveRange* range) {
     first->SetSpillOperand(op);
   }
   range->MakeSpilled(chunk()->zone());
+  if (range->next() == NULL && mode_ != UNALLOCATED_REGISTERS) {
+    spilled_live_ranges_.Add(range, zone());
+  }
 }
 
 
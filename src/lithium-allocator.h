@@ -511,6 +511,7 @@ class LAllocator BASE_EMBEDDED {
   void InactiveToHandled(LiveRange* range);
   void InactiveToActive(LiveRange* range);
   void FreeSpillSlot(LiveRange* range);
+  void FreeExpiredSpillSlots(LifetimePosition position);
   LOperand* TryReuseSpillSlot(LiveRange* range);
 
   // Helper methods for allocating registers.
@@ -615,6 +616,9 @@ class LAllocator BASE_EMBEDDED {
   ZoneList<LiveRange*> active_live_ranges_;
   ZoneList<LiveRange*> inactive_live_ranges_;
   ZoneList<LiveRange*> reusable_slots_;
+  // Spilled last parts of live ranges whose spill slot becomes reusable
+  // once the allocation passes their end.
+  ZoneList<LiveRange*> spilled_live_ranges_;
 
   // Next virtual register number to be assigned to temporaries.
   int next_virtual_register_;
@@ -496,6 +496,11 @@ LEnvironment* LChunkBuilderBase::CreateEnvironment(
     LOperand* op;
     HValue* value = hydrogen_env->values()->at(i);
     CHECK(!value->IsPushArgument());  // Do not deopt outgoing arguments
+    if (value->IsEnterTry()) {
+      result->AddStackHandler(HEnterTry::cast(value)->index());
+      i += StackHandlerConstants::kSlotCount - 1;
+      continue;
+    }
     if (value->IsArgumentsObject() || value->IsCapturedObject()) {
       op = LEnvironment::materialization_marker();
     } else {
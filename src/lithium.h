@@ -514,6 +514,8 @@ class LEnvironment V8_FINAL : public ZoneObject {
         translation_size_(value_count),
         parameter_count_(parameter_count),
         pc_offset_(-1),
+        stack_handler_index_(-1),
+        handler_index_(-1),
         values_(value_count, zone),
         is_tagged_(value_count, zone),
         is_uint32_(value_count, zone),
@@ -550,6 +552,28 @@ class LEnvironment V8_FINAL : public ZoneObject {
     }
   }
 
+  // Reserves the expression stack slots holding the try handler pushed by
+  // optimized code.  The deoptimizer rebuilds the handler for the full-code
+  // handler with the given index in these slots.
+  void AddStackHandler(int handler_index) {
+    ASSERT(stack_handler_index_ == -1);
+    stack_handler_index_ = values_.length();
+    handler_index_ = handler_index;
+    for (int i = 0; i < StackHandlerConstants::kSlotCount; ++i) {
+      values_.Add(NULL, zone());
+    }
+  }
+
+  bool HasStackHandlerAt(int index) const {
+    return index == stack_handler_index_;
+  }
+
+  int handler_index() const { return handler_index_; }
+
+  void SetValueAt(int index, LOperand* operand) {
+    values_[index] = operand;
+  }
+
   bool HasTaggedValueAt(int index) const {
     return is_tagged_.Contains(index);
   }
@@ -622,6 +646,8 @@ class LEnvironment V8_FINAL : public ZoneObject {
   int translation_size_;
   int parameter_count_;
   int pc_offset_;
+  int stack_handler_index_;
+  int handler_index_;
 
   // Value array: [parameters] [locals] [expression stack] [de-materialized].
   //              |>--------- translation_size ---------<|
@@ -1591,6 +1591,9 @@ Object* LiveEdit::ChangeScriptSource(Handle<Script> original_script,
   // Drop line ends so that they will be recalculated.
   original_script->set_line_ends(isolate->heap()->undefined_value());
 
+  // Cached preparse results refer to positions in the old source.
+  original_script->set_lazy_function_data(isolate->heap()->undefined_value());
+
   return *old_script_object;
 }
 
@@ -29,6 +29,11 @@
 
 #include "v8.h"
 
+#if V8_OS_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "bootstrapper.h"
 #include "code-stubs.h"
 #include "cpu-profiler.h"
@@ -311,14 +316,17 @@ void PerfBasicLogger::LogRecordedBuffer(Code* code,
 }
 
 
-// Linux perf tool logging support
+// Linux perf tool logging support. Writes a jitdump file in the format
+// understood by "perf inject --jit": the file is mapped executable once so
+// that "perf record" notices it, code objects get a load record preceded by
+// a debug info record, and code moved by the GC gets a move record.
 class PerfJitLogger : public CodeEventLogger {
  public:
   PerfJitLogger();
   virtual ~PerfJitLogger();
 
-  virtual void CodeMoveEvent(Address from, Address to) { }
-  virtual void CodeDeleteEvent(Address from) { }
+  virtual void CodeMoveEvent(Address from, Address to);
+  virtual void CodeDeleteEvent(Address from);
 
  private:
   virtual void LogRecordedBuffer(Code* code,
@@ -326,7 +334,23 @@ class PerfJitLogger : public CodeEventLogger {
                                  const char* name,
                                  int length);
 
-  // Extension added to V8 log file name to get the low-level log name.
+  static bool CodeAddressesMatch(void* key1, void* key2) {
+    return key1 == key2;
+  }
+  static uint32_t CodeAddressHash(Address address) {
+    return ComputePointerHash(address);
+  }
+
+  void LogWriteBytes(const char* bytes, int size);
+  void LogWriteHeader();
+  void LogWriteDebugInfo(Code* code, SharedFunctionInfo* shared);
+  void OpenMarkerFile();
+  void CloseMarkerFile();
+
+  static uint64_t GetTimestamp();
+  static int GetLineFromPosition(Script* script, int position);
+
+  // perf requires the file to be named jit-<pid>.dump.
   static const char kFilenameFormatString[];
   static const int kFilenameBufferPadding;
 
@@ -334,11 +358,12 @@ class PerfJitLogger : public CodeEventLogger {
   // minimize the associated overhead.
   static const int kLogBufferSize = 2 * MB;
 
-  void LogWriteBytes(const char* bytes, int size);
-  void LogWriteHeader();
+  // perf subtracts the size of the ELF header it wraps around each code
+  // object from debug info addresses, so add it back.
+  static const int kElfHeaderSize = 0x40;
 
-  static const uint32_t kJitHeaderMagic = 0x4F74496A;
-  static const uint32_t kJitHeaderVersion = 0x2;
+  static const uint32_t kJitHeaderMagic = 0x4A695444;
+  static const uint32_t kJitHeaderVersion = 1;
   static const uint32_t kElfMachIA32 = 3;
   static const uint32_t kElfMachX64 = 62;
   static const uint32_t kElfMachARM = 40;
@@ -352,25 +377,52 @@ class PerfJitLogger : public CodeEventLogger {
     uint32_t pad1;
     uint32_t pid;
     uint64_t timestamp;
+    uint64_t flags;
   };
 
   enum jit_record_type {
-    JIT_CODE_LOAD = 0
-    // JIT_CODE_UNLOAD = 1,
-    // JIT_CODE_CLOSE = 2,
-    // JIT_CODE_DEBUG_INFO = 3,
-    // JIT_CODE_PAGE_MAP = 4,
-    // JIT_CODE_MAX = 5
+    JIT_CODE_LOAD = 0,
+    JIT_CODE_MOVE = 1,
+    JIT_CODE_DEBUG_INFO = 2
   };
 
-  struct jr_code_load {
+  struct jr_prefix {
     uint32_t id;
     uint32_t total_size;
     uint64_t timestamp;
+  };
+
+  struct jr_code_load {
+    jr_prefix prefix;
+    uint32_t pid;
+    uint32_t tid;
+    uint64_t vma;
+    uint64_t code_addr;
+    uint64_t code_size;
+    uint64_t code_index;
+  };
+
+  struct jr_code_move {
+    jr_prefix prefix;
+    uint32_t pid;
+    uint32_t tid;
     uint64_t vma;
+    uint64_t old_code_addr;
+    uint64_t new_code_addr;
+    uint64_t code_size;
+    uint64_t code_index;
+  };
+
+  struct jr_code_debug_info {
+    jr_prefix prefix;
     uint64_t code_addr;
-    uint32_t code_size;
-    uint32_t align;
+    uint64_t nr_entry;
+  };
+
+  struct debug_entry {
+    uint64_t addr;
+    int32_t lineno;
+    int32_t discrim;
   };
 
   uint32_t GetElfMach() {
@@ -389,6 +441,12 @@ class PerfJitLogger : public CodeEventLogger {
   }
 
   FILE* perf_output_handle_;
+  void* marker_address_;
+  uint64_t code_index_;
+  // Maps the instruction start of each logged code object to the index of
+  // its load record, which move records have to refer to. Indices start at
+  // 1 so that they cannot be mistaken for a missing entry.
+  HashMap code_indices_;
 };
 
 const char PerfJitLogger::kFilenameFormatString[] = "/tmp/jit-%d.dump";
@@ -397,7 +455,10 @@ const char PerfJitLogger::kFilenameFormatString[] = "/tmp/jit-%d.dump";
 const int PerfJitLogger::kFilenameBufferPadding = 16;
 
 PerfJitLogger::PerfJitLogger()
-    : perf_output_handle_(NULL) {
+    : perf_output_handle_(NULL),
+      marker_address_(NULL),
+      code_index_(1),
+      code_indices_(CodeAddressesMatch) {
   // Open the perf JIT dump file.
   int bufferSize = sizeof(kFilenameFormatString) + kFilenameBufferPadding;
   ScopedVector<char> perf_dump_name(bufferSize);
@@ -406,27 +467,79 @@ PerfJitLogger::PerfJitLogger()
       kFilenameFormatString,
       OS::GetCurrentProcessId());
   CHECK_NE(size, -1);
-  perf_output_handle_ = OS::FOpen(perf_dump_name.start(), OS::LogFileOpenMode);
+  perf_output_handle_ = OS::FOpen(perf_dump_name.start(), "w+");
   CHECK_NE(perf_output_handle_, NULL);
   setvbuf(perf_output_handle_, NULL, _IOFBF, kLogBufferSize);
 
+  OpenMarkerFile();
   LogWriteHeader();
 }
 
 
 PerfJitLogger::~PerfJitLogger() {
+  CloseMarkerFile();
   fclose(perf_output_handle_);
   perf_output_handle_ = NULL;
 }
 
 
+void PerfJitLogger::OpenMarkerFile() {
+#if V8_OS_LINUX
+  // perf only picks up the dump file if it sees an executable mapping of it
+  // in the process.
+  long page_size = sysconf(_SC_PAGESIZE);  // NOLINT(runtime/int)
+  if (page_size == -1) return;
+  void* address = mmap(NULL, page_size, PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                       fileno(perf_output_handle_), 0);
+  if (address != MAP_FAILED) marker_address_ = address;
+#endif
+}
+
+
+void PerfJitLogger::CloseMarkerFile() {
+#if V8_OS_LINUX
+  if (marker_address_ == NULL) return;
+  munmap(marker_address_, sysconf(_SC_PAGESIZE));
+  marker_address_ = NULL;
+#endif
+}
+
+
+uint64_t PerfJitLogger::GetTimestamp() {
+  // Use the monotonic clock, as "perf record -k mono" does.
+  return static_cast<uint64_t>(
+      TimeTicks::HighResolutionNow().ToInternalValue()) * 1000;
+}
+
+
+int PerfJitLogger::GetLineFromPosition(Script* script, int position) {
+  // Must not allocate, so only use line ends that have been computed
+  // already.
+  if (!script->line_ends()->IsFixedArray()) return 0;
+  FixedArray* line_ends = FixedArray::cast(script->line_ends());
+  int low = 0;
+  int high = line_ends->length();
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (Smi::cast(line_ends->get(mid))->value() < position) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low + 1;
+}
+
+
 void PerfJitLogger::LogRecordedBuffer(Code* code,
-                                      SharedFunctionInfo*,
+                                      SharedFunctionInfo* shared,
                                       const char* name,
                                       int length) {
   ASSERT(code->instruction_start() == code->address() + Code::kHeaderSize);
   ASSERT(perf_output_handle_ != NULL);
 
+  if (shared != NULL) LogWriteDebugInfo(code, shared);
+
   const char* code_name = name;
   uint8_t* code_pointer = reinterpret_cast<uint8_t*>(code->instruction_start());
   uint32_t code_size = code->instruction_size();
@@ -434,14 +547,22 @@ void PerfJitLogger::LogRecordedBuffer(Code* code,
   static const char string_terminator[] = "\0";
 
   jr_code_load code_load;
-  code_load.id = JIT_CODE_LOAD;
-  code_load.total_size = sizeof(code_load) + length + 1 + code_size;
-  code_load.timestamp =
-      static_cast<uint64_t>(OS::TimeCurrentMillis() * 1000.0);
+  code_load.prefix.id = JIT_CODE_LOAD;
+  code_load.prefix.total_size = sizeof(code_load) + length + 1 + code_size;
+  code_load.prefix.timestamp = GetTimestamp();
+  // There is no portable way to get the thread id, and perf only uses it
+  // to report the thread, so use the process id.
+  code_load.pid = OS::GetCurrentProcessId();
+  code_load.tid = code_load.pid;
   code_load.vma = 0x0;  //  Our addresses are absolute.
   code_load.code_addr = reinterpret_cast<uint64_t>(code->instruction_start());
   code_load.code_size = code_size;
-  code_load.align = 0;
+  code_load.code_index = code_index_++;
+  Address start = code->instruction_start();
+  HashMap::Entry* entry =
+      code_indices_.Lookup(start, CodeAddressHash(start), true);
+  entry->value =
+      reinterpret_cast<void*>(static_cast<uintptr_t>(code_load.code_index));
 
   LogWriteBytes(reinterpret_cast<const char*>(&code_load), sizeof(code_load));
   LogWriteBytes(code_name, length);
@@ -450,6 +571,80 @@ void PerfJitLogger::LogRecordedBuffer(Code* code,
 }
 
 
+void PerfJitLogger::LogWriteDebugInfo(Code* code, SharedFunctionInfo* shared) {
+  if (!shared->script()->IsScript()) return;
+  Script* script = Script::cast(shared->script());
+  if (!script->name()->IsString()) return;
+  if (!script->line_ends()->IsFixedArray()) return;
+
+  int entry_count = 0;
+  for (RelocIterator it(code, RelocInfo::kPositionMask); !it.done();
+       it.next()) {
+    entry_count++;
+  }
+  if (entry_count == 0) return;
+
+  SmartArrayPointer<char> script_name =
+      String::cast(script->name())->ToCString(DISALLOW_NULLS);
+  int name_length = StrLength(script_name.get());
+  static const char string_terminator[] = "\0";
+
+  jr_code_debug_info debug_info;
+  debug_info.prefix.id = JIT_CODE_DEBUG_INFO;
+  debug_info.prefix.total_size = sizeof(debug_info) +
+      entry_count * (sizeof(debug_entry) + name_length + 1);
+  debug_info.prefix.timestamp = GetTimestamp();
+  debug_info.code_addr = reinterpret_cast<uint64_t>(code->instruction_start());
+  debug_info.nr_entry = entry_count;
+  LogWriteBytes(reinterpret_cast<const char*>(&debug_info),
+                sizeof(debug_info));
+
+  for (RelocIterator it(code, RelocInfo::kPositionMask); !it.done();
+       it.next()) {
+    debug_entry entry;
+    entry.addr = reinterpret_cast<uint64_t>(it.rinfo()->pc()) + kElfHeaderSize;
+    entry.lineno = GetLineFromPosition(
+        script, static_cast<int>(it.rinfo()->data()));
+    entry.discrim = 0;
+    LogWriteBytes(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    LogWriteBytes(script_name.get(), name_length);
+    LogWriteBytes(string_terminator, 1);
+  }
+}
+
+
+void PerfJitLogger::CodeMoveEvent(Address from, Address to) {
+  Address old_start = from + Code::kHeaderSize;
+  Address new_start = to + Code::kHeaderSize;
+  void* index = code_indices_.Remove(old_start, CodeAddressHash(old_start));
+  if (index == NULL) return;
+  HashMap::Entry* entry =
+      code_indices_.Lookup(new_start, CodeAddressHash(new_start), true);
+  entry->value = index;
+
+  // Called before the code object is copied, so read it at the old address.
+  Code* code = Code::cast(HeapObject::FromAddress(from));
+  jr_code_move code_move;
+  code_move.prefix.id = JIT_CODE_MOVE;
+  code_move.prefix.total_size = sizeof(code_move);
+  code_move.prefix.timestamp = GetTimestamp();
+  code_move.pid = OS::GetCurrentProcessId();
+  code_move.tid = code_move.pid;
+  code_move.vma = 0x0;
+  code_move.old_code_addr = reinterpret_cast<uint64_t>(old_start);
+  code_move.new_code_addr = reinterpret_cast<uint64_t>(new_start);
+  code_move.code_size = code->instruction_size();
+  code_move.code_index = reinterpret_cast<uintptr_t>(index);
+  LogWriteBytes(reinterpret_cast<const char*>(&code_move), sizeof(code_move));
+}
+
+
+void PerfJitLogger::CodeDeleteEvent(Address from) {
+  Address start = from + Code::kHeaderSize;
+  code_indices_.Remove(start, CodeAddressHash(start));
+}
+
+
 void PerfJitLogger::LogWriteBytes(const char* bytes, int size) {
   size_t rv = fwrite(bytes, 1, size, perf_output_handle_);
   ASSERT(static_cast<size_t>(size) == rv);
@@ -463,10 +658,11 @@ void PerfJitLogger::LogWriteHeader() {
   header.magic = kJitHeaderMagic;
   header.version = kJitHeaderVersion;
   header.total_size = sizeof(jitheader);
-  header.pad1 = 0xdeadbeef;
+  header.pad1 = 0;
   header.elf_mach = GetElfMach();
   header.pid = OS::GetCurrentProcessId();
-  header.timestamp = static_cast<uint64_t>(OS::TimeCurrentMillis() * 1000.0);
+  header.timestamp = GetTimestamp();
+  header.flags = 0;
   LogWriteBytes(reinterpret_cast<const char*>(&header), sizeof(header));
 }
 
@@ -941,6 +1137,7 @@ Logger::Logger(Isolate* isolate)
     ll_logger_(NULL),
     jit_logger_(NULL),
     listeners_(5),
+    trace_event_callback_(NULL),
     is_initialized_(false) {
 }
 
@@ -1112,6 +1309,10 @@ void Logger::TimerEvent(StartEnd se, const char* name) {
 
 void Logger::EnterExternal(Isolate* isolate) {
   LOG(isolate, TimerEvent(START, TimerEventScope::v8_external));
+  Logger* logger = isolate->logger();
+  if (logger->is_tracing_events()) {
+    logger->TraceEvent(START, "v8", TimerEventScope::v8_external);
+  }
   ASSERT(isolate->current_vm_state() == JS);
   isolate->set_current_vm_state(EXTERNAL);
 }
@@ -1119,13 +1320,22 @@ void Logger::EnterExternal(Isolate* isolate) {
 
 void Logger::LeaveExternal(Isolate* isolate) {
   LOG(isolate, TimerEvent(END, TimerEventScope::v8_external));
+  Logger* logger = isolate->logger();
+  if (logger->is_tracing_events()) {
+    logger->TraceEvent(END, "v8", TimerEventScope::v8_external);
+  }
   ASSERT(isolate->current_vm_state() == EXTERNAL);
   isolate->set_current_vm_state(JS);
 }
 
 
 void Logger::TimerEventScope::LogTimerEvent(StartEnd se) {
-  LOG(isolate_, TimerEvent(se, name_));
+  if (FLAG_log_internal_timer_events) LOG(isolate_, TimerEvent(se, name_));
+  Logger* logger = isolate_->logger();
+  if (logger->is_tracing_events()) {
+    bool compile = name_ != v8_execute && name_ != v8_external;
+    logger->TraceEvent(se, compile ? "v8.compile" : "v8", name_);
+  }
 }
 
 
@@ -320,11 +320,11 @@ class Logger {
    public:
     TimerEventScope(Isolate* isolate, const char* name)
         : isolate_(isolate), name_(name) {
-      if (FLAG_log_internal_timer_events) LogTimerEvent(START);
+      LogTimerEvent(START);
     }
 
     ~TimerEventScope() {
-      if (FLAG_log_internal_timer_events) LogTimerEvent(END);
+      LogTimerEvent(END);
     }
 
     void LogTimerEvent(StartEnd se);
@@ -340,6 +340,30 @@ class Logger {
     const char* name_;
   };
 
+  // ==== Events delivered to the embedder's trace event callback. ====
+  void set_trace_event_callback(v8::Isolate::TraceEventCallback callback) {
+    trace_event_callback_ = callback;
+  }
+
+  bool is_tracing_events() {
+    return trace_event_callback_ != NULL;
+  }
+
+  void TraceEvent(v8::Isolate::TraceEventPhase phase,
+                  const char* category,
+                  const char* name,
+                  const char* arg_name = NULL,
+                  int arg_value = 0) {
+    trace_event_callback_(phase, category, name, arg_name, arg_value);
+  }
+
+  void TraceEvent(StartEnd se, const char* category, const char* name) {
+    TraceEvent(se == START ? v8::Isolate::kTraceEventBegin
+                           : v8::Isolate::kTraceEventEnd,
+               category,
+               name);
+  }
+
   // ==== Events logged by --log-regexp ====
   // Regexp compilation and execution events.
 
@@ -449,6 +473,7 @@ class Logger {
   LowLevelLogger* ll_logger_;
   JitLogger* jit_logger_;
   List<CodeEventListener*> listeners_;
+  v8::Isolate::TraceEventCallback trace_event_callback_;
 
   // Guards against multiple calls to TearDown() that can happen in some tests.
   // 'true' between SetUp() and TearDown().
@@ -0,0 +1,179 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "v8.h"
+
+#include "lz-codec.h"
+
+namespace v8 {
+namespace internal {
+
+
+static inline uint32_t Load32(const byte* p) {
+  return static_cast<uint32_t>(p[0]) |
+      (static_cast<uint32_t>(p[1]) << 8) |
+      (static_cast<uint32_t>(p[2]) << 16) |
+      (static_cast<uint32_t>(p[3]) << 24);
+}
+
+
+static inline byte* WriteLength(byte* out, int length) {
+  while (length >= 255) {
+    *out++ = 255;
+    length -= 255;
+  }
+  *out++ = static_cast<byte>(length);
+  return out;
+}
+
+
+static inline bool ReadLength(const byte** in, const byte* end,
+                              int limit, int* length) {
+  int b;
+  do {
+    if (*in == end) return false;
+    b = *(*in)++;
+    *length += b;
+    if (*length > limit) return false;
+  } while (b == 255);
+  return true;
+}
+
+
+int LZCodec::Compress(const byte* input, int length,
+                      byte* output, int capacity) {
+  const int kTableSize = 1 << kHashBits;
+  int* table = NewArray<int>(kTableSize);
+  for (int i = 0; i < kTableSize; i++) table[i] = -1;
+
+  byte* out = output;
+  byte* out_end = output + capacity;
+  int anchor = 0;
+  int pos = 0;
+  bool done = false;
+  while (!done) {
+    int match_length = 0;
+    int offset = 0;
+    while (pos + kMinMatch <= length) {
+      uint32_t value = Load32(input + pos);
+      int hash = static_cast<int>((value * 2654435761u) >> (32 - kHashBits));
+      int candidate = table[hash];
+      table[hash] = pos;
+      if (candidate >= 0 && pos - candidate <= kMaxOffset &&
+          Load32(input + candidate) == value) {
+        match_length = kMinMatch;
+        while (pos + match_length < length &&
+               input[candidate + match_length] == input[pos + match_length]) {
+          match_length++;
+        }
+        offset = pos - candidate;
+        break;
+      }
+      pos++;
+    }
+    if (match_length == 0) {
+      // No more matches, emit the trailing literals.
+      pos = length;
+      done = true;
+    }
+
+    int literal_length = pos - anchor;
+    int needed = 1 + literal_length + literal_length / 255 + 1 +
+        2 + match_length / 255 + 1;
+    if (out_end - out < needed) {
+      DeleteArray(table);
+      return -1;
+    }
+    int literal_code = Min(literal_length, kLengthMask);
+    int match_code =
+        done ? 0 : Min(match_length - kMinMatch, kLengthMask);
+    *out++ = static_cast<byte>((literal_code << 4) | match_code);
+    if (literal_code == kLengthMask) {
+      out = WriteLength(out, literal_length - kLengthMask);
+    }
+    OS::MemCopy(out, input + anchor, literal_length);
+    out += literal_length;
+    if (!done) {
+      *out++ = static_cast<byte>(offset & 0xff);
+      *out++ = static_cast<byte>(offset >> 8);
+      if (match_code == kLengthMask) {
+        out = WriteLength(out, match_length - kMinMatch - kLengthMask);
+      }
+      pos += match_length;
+      anchor = pos;
+    }
+  }
+  DeleteArray(table);
+  return static_cast<int>(out - output);
+}
+
+
+bool LZCodec::Decompress(const byte* input, int length,
+                         byte* output, int output_length) {
+  const byte* in = input;
+  const byte* in_end = input + length;
+  byte* out = output;
+  byte* out_end = output + output_length;
+  while (in < in_end) {
+    int token = *in++;
+    int literal_length = token >> 4;
+    if (literal_length == kLengthMask &&
+        !ReadLength(&in, in_end, output_length, &literal_length)) {
+      return false;
+    }
+    if (in_end - in < literal_length || out_end - out < literal_length) {
+      return false;
+    }
+    OS::MemCopy(out, in, literal_length);
+    in += literal_length;
+    out += literal_length;
+    // The final sequence has no match.
+    if (in == in_end) break;
+
+    if (in_end - in < 2) return false;
+    int offset = in[0] | (in[1] << 8);
+    in += 2;
+    int match_length = token & kLengthMask;
+    if (match_length == kLengthMask &&
+        !ReadLength(&in, in_end, output_length, &match_length)) {
+      return false;
+    }
+    match_length += kMinMatch;
+    if (offset == 0 || offset > out - output ||
+        out_end - out < match_length) {
+      return false;
+    }
+    // The match may overlap the output being written, so copy bytewise.
+    const byte* from = out - offset;
+    for (int i = 0; i < match_length; i++) out[i] = from[i];
+    out += match_length;
+  }
+  return out == out_end;
+}
+
+} }  // namespace v8::internal
@@ -0,0 +1,73 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef V8_LZ_CODEC_H_
+#define V8_LZ_CODEC_H_
+
+#include "globals.h"
+
+namespace v8 {
+namespace internal {
+
+// A byte oriented LZ77 codec in the style of LZ4, used for the startup
+// snapshot. Decompression is a simple copy loop without any entropy
+// decoding, so it is fast enough to run on every startup.
+//
+// The compressed data is a list of sequences. Each sequence starts with a
+// token byte holding the literal length in its upper and the match length
+// in its lower four bits, followed by the literals, a two byte little
+// endian match offset and the match. Lengths of 15 or more are continued in
+// additional bytes which are added up until a byte other than 255. The
+// final sequence consists of literals only.
+class LZCodec : public AllStatic {
+ public:
+  // Returns the maximal size of the compressed form of length bytes.
+  static int CompressBound(int length) {
+    return length + length / 255 + 16;
+  }
+
+  // Compresses the input into output and returns the compressed size, or
+  // -1 if the output capacity does not suffice.
+  static int Compress(const byte* input, int length,
+                      byte* output, int capacity);
+
+  // Decompresses the input into output. Returns false unless the input is
+  // well formed and decompresses to exactly output_length bytes.
+  static bool Decompress(const byte* input, int length,
+                         byte* output, int output_length);
+
+ private:
+  static const int kMinMatch = 4;
+  static const int kMaxOffset = 0xffff;
+  static const int kHashBits = 14;
+  static const int kLengthMask = 15;
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_LZ_CODEC_H_
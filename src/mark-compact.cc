@@ -68,12 +68,16 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap) :  // NOLINT
       was_marked_incrementally_(false),
       sweeping_pending_(false),
       pending_sweeper_jobs_semaphore_(0),
+      pending_slots_updating_jobs_semaphore_(0),
       sequential_sweeping_(false),
       tracer_(NULL),
       migration_slots_buffer_(NULL),
       heap_(heap),
+      marking_deque_memory_(NULL),
+      marking_deque_memory_committed_(0),
       code_flusher_(NULL),
       encountered_weak_collections_(NULL),
+      processed_weak_collections_(NULL),
       have_code_to_deoptimize_(false) { }
 
 #ifdef VERIFY_HEAP
@@ -356,6 +360,7 @@ void MarkCompactCollector::SetUp() {
 
 void MarkCompactCollector::TearDown() {
   AbortCompaction();
+  delete marking_deque_memory_;
 }
 
 
@@ -435,6 +440,8 @@ void MarkCompactCollector::CollectGarbage() {
 
   SweepSpaces();
 
+  FlushPatchedCode();
+
   if (!FLAG_collect_maps) ReattachInitialMaps();
 
 #ifdef DEBUG
@@ -590,6 +597,75 @@ class MarkCompactCollector::SweeperTask : public v8::Task {
 };
 
 
+class MarkCompactCollector::SlotsUpdatingTask : public v8::Task {
+ public:
+  SlotsUpdatingTask(Heap* heap,
+                    int first,
+                    int stride,
+                    bool code_slots_filtering_required)
+    : heap_(heap),
+      first_(first),
+      stride_(stride),
+      code_slots_filtering_required_(code_slots_filtering_required) {}
+
+  virtual ~SlotsUpdatingTask() {}
+
+ private:
+  // v8::Task overrides.
+  virtual void Run() V8_OVERRIDE {
+    MarkCompactCollector* collector = heap_->mark_compact_collector();
+    collector->UpdateSlotsOnEvacuationCandidates(
+        first_, stride_, code_slots_filtering_required_);
+    collector->pending_slots_updating_jobs_semaphore_.Signal();
+  }
+
+  Heap* heap_;
+  int first_;
+  int stride_;
+  bool code_slots_filtering_required_;
+
+  DISALLOW_COPY_AND_ASSIGN(SlotsUpdatingTask);
+};
+
+
+void MarkCompactCollector::UpdateSlotsOnEvacuationCandidates(
+    int first, int stride, bool code_slots_filtering_required) {
+  int npages = evacuation_candidates_.length();
+  for (int i = first; i < npages; i += stride) {
+    Page* p = evacuation_candidates_[i];
+    if (p->IsEvacuationCandidate()) {
+      SlotsBuffer::UpdateSlotsRecordedIn(heap_,
+                                         p->slots_buffer(),
+                                         code_slots_filtering_required);
+    }
+  }
+}
+
+
+void MarkCompactCollector::UpdateSlotsOnEvacuationCandidatesInParallel(
+    bool code_slots_filtering_required) {
+  int npages = evacuation_candidates_.length();
+  int ntasks = Min(npages,
+                   Min(CPU::NumberOfProcessorsOnline(),
+                       kMaxSlotsUpdatingTasks));
+  // A slot that was recorded for more than one page is updated to the same
+  // forwarding address by whichever task gets to it, so the tasks need no
+  // synchronization beyond waiting for all of them to finish.
+  for (int i = 1; i < ntasks; i++) {
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        new SlotsUpdatingTask(
+            heap(), i, ntasks, code_slots_filtering_required),
+        v8::Platform::kShortRunningTask);
+  }
+  // The main thread takes the first stripe of pages.
+  UpdateSlotsOnEvacuationCandidates(0, Max(ntasks, 1),
+                                    code_slots_filtering_required);
+  for (int i = 1; i < ntasks; i++) {
+    pending_slots_updating_jobs_semaphore_.Wait();
+  }
+}
+
+
 void MarkCompactCollector::StartSweeperThreads() {
   // TODO(hpayer): This check is just used for debugging purpose and
   // should be removed or turned into an assert after investigating the
@@ -1047,6 +1123,14 @@ void MarkCompactCollector::Finish() {
 // and continue with marking.  This process repeats until all reachable
 // objects have been marked.
 
+void CodeFlusher::RecordFlush(SharedFunctionInfo* shared, Code* code) {
+  shared->increment_flush_count();
+  Counters* counters = isolate_->counters();
+  counters->code_flushing_functions_flushed()->Increment();
+  counters->code_flushing_bytes_flushed()->Increment(code->Size());
+}
+
+
 void CodeFlusher::ProcessJSFunctionCandidates() {
   Code* lazy_compile =
       isolate_->builtins()->builtin(Builtins::kCompileUnoptimized);
@@ -1063,10 +1147,14 @@ void CodeFlusher::ProcessJSFunctionCandidates() {
     Code* code = shared->code();
     MarkBit code_mark = Marking::MarkBitFrom(code);
     if (!code_mark.Get()) {
-      if (FLAG_trace_code_flushing && shared->is_compiled()) {
-        PrintF("[code-flushing clears: ");
-        shared->ShortPrint();
-        PrintF(" - age: %d]\n", code->GetAge());
+      if (shared->is_compiled()) {
+        if (FLAG_trace_code_flushing) {
+          PrintF("[code-flushing clears: ");
+          shared->ShortPrint();
+          PrintF(" - age: %d, flushes: %d]\n",
+                 code->GetAge(), shared->flush_count());
+        }
+        RecordFlush(shared, code);
       }
       shared->set_code(lazy_compile);
       candidate->set_code(lazy_compile);
@@ -1106,10 +1194,14 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
     Code* code = candidate->code();
     MarkBit code_mark = Marking::MarkBitFrom(code);
     if (!code_mark.Get()) {
-      if (FLAG_trace_code_flushing && candidate->is_compiled()) {
-        PrintF("[code-flushing clears: ");
-        candidate->ShortPrint();
-        PrintF(" - age: %d]\n", code->GetAge());
+      if (candidate->is_compiled()) {
+        if (FLAG_trace_code_flushing) {
+          PrintF("[code-flushing clears: ");
+          candidate->ShortPrint();
+          PrintF(" - age: %d, flushes: %d]\n",
+                 code->GetAge(), candidate->flush_count());
+        }
+        RecordFlush(candidate, code);
       }
       candidate->set_code(lazy_compile);
     }
@@ -1903,9 +1995,8 @@ class StringTableCleaner : public ObjectVisitor {
         if (finalize_external_strings) {
           ASSERT(o->IsExternalString());
           heap_->FinalizeExternalString(String::cast(*p));
-        } else {
-          pointers_removed_++;
         }
+        pointers_removed_++;
         // Set the entry to the_hole_value (as deleted).
         *p = heap_->the_hole_value();
       }
@@ -1913,7 +2004,6 @@ class StringTableCleaner : public ObjectVisitor {
   }
 
   int PointersRemoved() {
-    ASSERT(!finalize_external_strings);
     return pointers_removed_;
   }
 
@@ -1986,12 +2076,12 @@ static void DiscoverGreyObjectsOnPage(MarkingDeque* marking_deque,
   ASSERT(strcmp(Marking::kGreyBitPattern, "11") == 0);
   ASSERT(strcmp(Marking::kImpossibleBitPattern, "01") == 0);
 
-  for (MarkBitCellIterator it(p); !it.Done(); it.Advance()) {
+  for (MarkBitCellIterator it(p); it.AdvanceToMarkedCell(); it.Advance()) {
     Address cell_base = it.CurrentCellBase();
     MarkBit::CellType* cell = it.CurrentCell();
 
     const MarkBit::CellType current_cell = *cell;
-    if (current_cell == 0) continue;
+    ASSERT(current_cell != 0);
 
     MarkBit::CellType grey_objects;
     if (it.HasNext()) {
@@ -2035,12 +2125,12 @@ int MarkCompactCollector::DiscoverAndPromoteBlackObjectsOnPage(
   MarkBit::CellType* cells = p->markbits()->cells();
   int survivors_size = 0;
 
-  for (MarkBitCellIterator it(p); !it.Done(); it.Advance()) {
+  for (MarkBitCellIterator it(p); it.AdvanceToMarkedCell(); it.Advance()) {
     Address cell_base = it.CurrentCellBase();
     MarkBit::CellType* cell = it.CurrentCell();
 
     MarkBit::CellType current_cell = *cell;
-    if (current_cell == 0) continue;
+    ASSERT(current_cell != 0);
 
     int offset = 0;
     while (current_cell != 0) {
@@ -2240,6 +2330,8 @@ void MarkCompactCollector::EmptyMarkingDeque() {
 void MarkCompactCollector::RefillMarkingDeque() {
   ASSERT(marking_deque_.overflowed());
 
+  if (marking_deque_.IsEmpty()) GrowMarkingDeque();
+
   DiscoverGreyObjectsInNewSpace(heap(), &marking_deque_);
   if (marking_deque_.IsFull()) return;
 
@@ -2283,6 +2375,77 @@ void MarkCompactCollector::RefillMarkingDeque() {
 }
 
 
+void MarkCompactCollector::InitializeMarkingDeque() {
+  Address marking_deque_start;
+  Address marking_deque_end;
+  if (marking_deque_memory_committed_ > 0) {
+    // The deque already overflowed a single page in an earlier collection.
+    marking_deque_start =
+        static_cast<Address>(marking_deque_memory_->address());
+    marking_deque_end = marking_deque_start + marking_deque_memory_committed_;
+  } else {
+    // The to space contains live objects, a page in from space is used as a
+    // marking stack.
+    marking_deque_start = heap()->new_space()->FromSpacePageLow();
+    marking_deque_end = heap()->new_space()->FromSpacePageHigh();
+  }
+  if (FLAG_force_marking_deque_overflows) {
+    marking_deque_end = marking_deque_start + 64 * kPointerSize;
+  }
+  marking_deque_.Initialize(marking_deque_start,
+                            marking_deque_end);
+}
+
+
+bool MarkCompactCollector::GrowMarkingDeque() {
+  ASSERT(marking_deque_.IsEmpty());
+  if (!FLAG_grow_marking_deque || FLAG_force_marking_deque_overflows) {
+    return false;
+  }
+  static const size_t kMaxMarkingDequeSize = 64 * MB;
+  if (marking_deque_memory_ == NULL) {
+    marking_deque_memory_ = new VirtualMemory(kMaxMarkingDequeSize);
+    if (!marking_deque_memory_->IsReserved()) {
+      delete marking_deque_memory_;
+      marking_deque_memory_ = NULL;
+      return false;
+    }
+  }
+  size_t current_size =
+      static_cast<size_t>(marking_deque_.mask() + 1) * kPointerSize;
+  size_t new_size = Max(marking_deque_memory_committed_, current_size) * 2;
+  if (new_size > marking_deque_memory_->size()) return false;
+
+  Address base = static_cast<Address>(marking_deque_memory_->address());
+  if (!marking_deque_memory_->Commit(
+          base + marking_deque_memory_committed_,
+          new_size - marking_deque_memory_committed_,
+          false)) {
+    return false;
+  }
+  marking_deque_memory_committed_ = new_size;
+  marking_deque_.Initialize(base, base + new_size);
+  // Objects that did not fit into the old deque are still grey in the heap.
+  marking_deque_.SetOverflowed();
+  if (FLAG_trace_gc_verbose) {
+    PrintF("Grew marking deque to %d KB\n",
+           static_cast<int>(new_size / KB));
+  }
+  return true;
+}
+
+
+void MarkCompactCollector::UncommitMarkingDeque() {
+  if (marking_deque_memory_committed_ == 0) return;
+  ASSERT(marking_deque_.IsEmpty());
+  bool success = marking_deque_memory_->Uncommit(
+      static_cast<Address>(marking_deque_memory_->address()),
+      marking_deque_memory_committed_);
+  CHECK(success);
+  marking_deque_memory_committed_ = 0;
+}
+
+
 // Mark all objects reachable (transitively) from objects on the marking
 // stack.  Before: the marking stack contains zero or more heap object
 // pointers.  After: the marking stack is empty and there are no overflowed
@@ -2359,15 +2522,7 @@ void MarkCompactCollector::MarkLiveObjects() {
   ASSERT(state_ == PREPARE_GC);
   state_ = MARK_LIVE_OBJECTS;
 #endif
-  // The to space contains live objects, a page in from space is used as a
-  // marking stack.
-  Address marking_deque_start = heap()->new_space()->FromSpacePageLow();
-  Address marking_deque_end = heap()->new_space()->FromSpacePageHigh();
-  if (FLAG_force_marking_deque_overflows) {
-    marking_deque_end = marking_deque_start + 64 * kPointerSize;
-  }
-  marking_deque_.Initialize(marking_deque_start,
-                            marking_deque_end);
+  InitializeMarkingDeque();
   ASSERT(!marking_deque_.overflowed());
 
   if (incremental_marking_overflowed) {
@@ -2454,9 +2609,14 @@ void MarkCompactCollector::AfterMarking() {
   string_table->IterateElements(&internalized_visitor);
   string_table->ElementsRemoved(internalized_visitor.PointersRemoved());
 
+  // Prune the external string table. Its old space part is only compacted
+  // if some of the old strings died.
   ExternalStringTableCleaner external_visitor(heap());
-  heap()->external_string_table_.Iterate(&external_visitor);
-  heap()->external_string_table_.CleanUp();
+  ExternalStringTable* external_table = &heap()->external_string_table_;
+  external_table->IterateOldSpaceStrings(&external_visitor);
+  bool old_space_strings_removed = external_visitor.PointersRemoved() > 0;
+  external_table->IterateNewSpaceStrings(&external_visitor);
+  external_table->CleanUp(old_space_strings_removed);
 
   // Process the weak references.
   MarkCompactWeakObjectRetainer mark_compact_object_retainer;
@@ -2682,6 +2842,8 @@ void MarkCompactCollector::ClearNonLivePrototypeTransitions(Map* map) {
        i++) {
     prototype_transitions->set_undefined(header + i);
   }
+
+  map->ShrinkPrototypeTransitions(heap());
 }
 
 
@@ -2758,29 +2920,54 @@ void MarkCompactCollector::ClearNonLiveDependentCode(DependentCode* entries) {
 }
 
 
+void MarkCompactCollector::MarkWeakCollectionValue(ObjectHashTable* table,
+                                                   int entry) {
+  Object** anchor = reinterpret_cast<Object**>(table->address());
+  Object** key_slot =
+      table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(entry));
+  RecordSlot(anchor, key_slot, *key_slot);
+  Object** value_slot =
+      table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(entry));
+  MarkCompactMarkingVisitor::MarkObjectByPointer(this, anchor, value_slot);
+}
+
+
 void MarkCompactCollector::ProcessWeakCollections() {
   GCTracer::Scope gc_scope(tracer_, GCTracer::Scope::MC_WEAKCOLLECTION_PROCESS);
+  // Newly encountered collections are prepended to the list, so the ones
+  // before the previous head have not been scanned yet.  Tables do not
+  // change during the marking pause, so each of them is scanned just once.
   Object* weak_collection_obj = encountered_weak_collections();
-  while (weak_collection_obj != Smi::FromInt(0)) {
+  while (weak_collection_obj != processed_weak_collections_) {
     ASSERT(MarkCompactCollector::IsMarked(
         HeapObject::cast(weak_collection_obj)));
     JSWeakCollection* weak_collection =
         reinterpret_cast<JSWeakCollection*>(weak_collection_obj);
     ObjectHashTable* table = ObjectHashTable::cast(weak_collection->table());
-    Object** anchor = reinterpret_cast<Object**>(table->address());
     for (int i = 0; i < table->Capacity(); i++) {
       if (MarkCompactCollector::IsMarked(HeapObject::cast(table->KeyAt(i)))) {
-        Object** key_slot =
-            table->RawFieldOfElementAt(ObjectHashTable::EntryToIndex(i));
-        RecordSlot(anchor, key_slot, *key_slot);
-        Object** value_slot =
-            table->RawFieldOfElementAt(ObjectHashTable::EntryToValueIndex(i));
-        MarkCompactMarkingVisitor::MarkObjectByPointer(
-            this, anchor, value_slot);
+        MarkWeakCollectionValue(table, i);
+      } else {
+        pending_ephemerons_.Add(PendingEphemeron(table, i));
       }
     }
     weak_collection_obj = weak_collection->next();
   }
+  processed_weak_collections_ = encountered_weak_collections();
+
+  // Revisit the entries whose key was unmarked and drop those whose key has
+  // been marked since.
+  int pending = 0;
+  for (int i = 0; i < pending_ephemerons_.length(); i++) {
+    PendingEphemeron ephemeron = pending_ephemerons_[i];
+    HeapObject* key = HeapObject::cast(ephemeron.table->KeyAt(ephemeron.entry));
+    if (MarkCompactCollector::IsMarked(key)) {
+      MarkWeakCollectionValue(ephemeron.table, ephemeron.entry);
+    } else {
+      pending_ephemerons_[pending++] = ephemeron;
+    }
+  }
+  pending_ephemerons_.Rewind(pending);
 }
 
 
@@ -2802,6 +2989,8 @@ void MarkCompactCollector::ClearWeakCollections() {
     weak_collection->set_next(Smi::FromInt(0));
   }
   set_encountered_weak_collections(Smi::FromInt(0));
+  processed_weak_collections_ = Smi::FromInt(0);
+  pending_ephemerons_.Clear();
 }
 
 
@@ -2872,7 +3061,9 @@ void MarkCompactCollector::MigrateObject(Address dst,
                        SlotsBuffer::RELOCATED_CODE_OBJECT,
                        dst,
                        SlotsBuffer::IGNORE_OVERFLOW);
-    Code::cast(HeapObject::FromAddress(dst))->Relocate(dst - src);
+    Code::cast(HeapObject::FromAddress(dst))->Relocate(dst - src,
+                                                       SKIP_ICACHE_FLUSH);
+    RecordCodePatch(dst);
   } else {
     ASSERT(dest == OLD_DATA_SPACE || dest == NEW_SPACE);
     heap()->MoveBlock(dst, src, size);
@@ -2903,7 +3094,8 @@ class PointersUpdatingVisitor: public ObjectVisitor {
     // Avoid unnecessary changes that might unnecessary flush the instruction
     // cache.
     if (target != old_target) {
-      rinfo->set_target_object(target);
+      rinfo->set_target_object(target, UPDATE_WRITE_BARRIER, SKIP_ICACHE_FLUSH);
+      heap_->mark_compact_collector()->RecordCodePatch(rinfo->pc());
     }
   }
 
@@ -2913,7 +3105,10 @@ class PointersUpdatingVisitor: public ObjectVisitor {
     Object* old_target = target;
     VisitPointer(&target);
     if (target != old_target) {
-      rinfo->set_target_address(Code::cast(target)->instruction_start());
+      rinfo->set_target_address(Code::cast(target)->instruction_start(),
+                                UPDATE_WRITE_BARRIER,
+                                SKIP_ICACHE_FLUSH);
+      heap_->mark_compact_collector()->RecordCodePatch(rinfo->pc());
     }
   }
 
@@ -3068,12 +3263,10 @@ void MarkCompactCollector::EvacuateLiveObjectsFromPage(Page* p) {
 
   int offsets[16];
 
-  for (MarkBitCellIterator it(p); !it.Done(); it.Advance()) {
+  for (MarkBitCellIterator it(p); it.AdvanceToMarkedCell(); it.Advance()) {
     Address cell_base = it.CurrentCellBase();
     MarkBit::CellType* cell = it.CurrentCell();
 
-    if (*cell == 0) continue;
-
     int live_objects = MarkWordToObjectStarts(*cell, offsets);
     for (int i = 0; i < live_objects; i++) {
       Address object_addr = cell_base + offsets[i] * kPointerSize;
@@ -3082,7 +3275,15 @@ void MarkCompactCollector::EvacuateLiveObjectsFromPage(Page* p) {
 
       int size = object->Size();
 
-      MaybeObject* target = space->AllocateRaw(size);
+      MaybeObject* target;
+      if (FLAG_segregate_optimized_code &&
+          space->identity() == CODE_SPACE &&
+          Code::cast(object)->kind() == Code::OPTIMIZED_FUNCTION) {
+        // Move surviving optimized code next to the other hot code.
+        target = space->AllocateRawHot(size);
+      } else {
+        target = space->AllocateRaw(size);
+      }
       if (target->IsFailure()) {
         // OS refused to give us memory.
         V8::FatalProcessOutOfMemory("Evacuation");
@@ -3245,7 +3446,7 @@ static void SweepPrecisely(PagedSpace* space,
     skip_list->Clear();
   }
 
-  for (MarkBitCellIterator it(p); !it.Done(); it.Advance()) {
+  for (MarkBitCellIterator it(p); it.AdvanceToMarkedCell(); it.Advance()) {
     Address cell_base = it.CurrentCellBase();
     MarkBit::CellType* cell = it.CurrentCell();
     int live_objects = MarkWordToObjectStarts(*cell, offsets);
@@ -3459,8 +3660,14 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
 
   { GCTracer::Scope gc_scope(tracer_,
                              GCTracer::Scope::MC_UPDATE_ROOT_TO_NEW_POINTERS);
-    // Update roots.
-    heap_->IterateRoots(&updating_visitor, VISIT_ALL_IN_SWEEP_NEWSPACE);
+    // Update roots.  Updating a slot only reads the forwarding address of
+    // its target, so the visitor can be shared by several threads.
+    if (FLAG_parallel_pointer_update) {
+      heap_->IterateRootsInParallel(&updating_visitor,
+                                    VISIT_ALL_IN_SWEEP_NEWSPACE);
+    } else {
+      heap_->IterateRoots(&updating_visitor, VISIT_ALL_IN_SWEEP_NEWSPACE);
+    }
   }
 
   { GCTracer::Scope gc_scope(tracer_,
@@ -3502,15 +3709,24 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
   int npages = evacuation_candidates_.length();
   { GCTracer::Scope gc_scope(
       tracer_, GCTracer::Scope::MC_UPDATE_POINTERS_BETWEEN_EVACUATED);
+    // Slots buffers of different pages can be processed independently.
+    bool slots_updated_in_parallel = FLAG_parallel_pointer_update &&
+                                     npages > 1;
+    if (slots_updated_in_parallel) {
+      UpdateSlotsOnEvacuationCandidatesInParallel(
+          code_slots_filtering_required);
+    }
     for (int i = 0; i < npages; i++) {
       Page* p = evacuation_candidates_[i];
       ASSERT(p->IsEvacuationCandidate() ||
              p->IsFlagSet(Page::RESCAN_ON_EVACUATION));
 
       if (p->IsEvacuationCandidate()) {
-        SlotsBuffer::UpdateSlotsRecordedIn(heap_,
-                                           p->slots_buffer(),
-                                           code_slots_filtering_required);
+        if (!slots_updated_in_parallel) {
+          SlotsBuffer::UpdateSlotsRecordedIn(heap_,
+                                             p->slots_buffer(),
+                                             code_slots_filtering_required);
+        }
         if (FLAG_trace_fragmentation) {
           PrintF("  page %p slots buffer: %d\n",
                  reinterpret_cast<void*>(p),
@@ -3982,22 +4198,16 @@ intptr_t MarkCompactCollector::SweepConservatively(PagedSpace* space,
   size_t size = 0;
 
   // Skip over all the dead objects at the start of the page and mark them free.
-  Address cell_base = 0;
-  MarkBit::CellType* cell = NULL;
   MarkBitCellIterator it(p);
-  for (; !it.Done(); it.Advance()) {
-    cell_base = it.CurrentCellBase();
-    cell = it.CurrentCell();
-    if (*cell != 0) break;
-  }
-
-  if (it.Done()) {
+  if (!it.AdvanceToMarkedCell()) {
     size = p->area_end() - p->area_start();
     freed_bytes += Free<mode>(space, free_list, p->area_start(),
                               static_cast<int>(size));
     ASSERT_EQ(0, p->LiveBytes());
     return freed_bytes;
   }
+  Address cell_base = it.CurrentCellBase();
+  MarkBit::CellType* cell = it.CurrentCell();
 
   // Grow the size of the start-of-page free space a little to get up to the
   // first live object.
@@ -4071,6 +4281,29 @@ void MarkCompactCollector::SweepInParallel(PagedSpace* space) {
 }
 
 
+intptr_t MarkCompactCollector::SweepOnMainThread(
+    PagedSpace* space, intptr_t required_freed_bytes) {
+  intptr_t freed_bytes = 0;
+  FreeList private_free_list(space);
+  PageIterator it(space);
+  while (it.has_next() && freed_bytes < required_freed_bytes) {
+    Page* p = it.next();
+    // Pages are claimed atomically, so this never waits for a sweeper.
+    if (p->TryParallelSweeping()) {
+      SweepConservatively<SWEEP_IN_PARALLEL>(space, &private_free_list, p);
+      // Only the main thread uses the free list of the space, so this
+      // bypasses the free list that is shared with the sweepers.
+      intptr_t page_freed_bytes =
+          space->free_list()->Concatenate(&private_free_list);
+      space->AddToAccountingStats(page_freed_bytes);
+      space->DecrementUnsweptFreeBytes(page_freed_bytes);
+      freed_bytes += page_freed_bytes;
+    }
+  }
+  return freed_bytes;
+}
+
+
 void MarkCompactCollector::SweepSpace(PagedSpace* space, SweeperType sweeper) {
   space->set_was_swept_conservatively(sweeper == CONSERVATIVE ||
                                       sweeper == LAZY_CONSERVATIVE ||
@@ -4102,8 +4335,10 @@ void MarkCompactCollector::SweepSpace(PagedSpace* space, SweeperType sweeper) {
     }
 
     // One unused page is kept, all further are released before sweeping them.
+    // When reducing the memory footprint only the first page is kept.
     if (p->LiveBytes() == 0) {
-      if (unused_page_present) {
+      if (unused_page_present ||
+          (reduce_memory_footprint_ && p != space->FirstPage())) {
         if (FLAG_gc_verbose) {
           PrintF("Sweeping 0x%" V8PRIxPTR " released page.\n",
                  reinterpret_cast<intptr_t>(p));
@@ -4401,6 +4636,7 @@ void MarkCompactCollector::RecordCodeEntrySlot(Address slot, Code* target) {
 
 void MarkCompactCollector::RecordCodeTargetPatch(Address pc, Code* target) {
   ASSERT(heap()->gc_state() == Heap::MARK_COMPACT);
+  RecordCodePatch(pc);
   if (is_compacting()) {
     Code* host = isolate()->inner_pointer_to_code_cache()->
         GcSafeFindCodeForInnerPointer(pc);
@@ -4413,6 +4649,34 @@ void MarkCompactCollector::RecordCodeTargetPatch(Address pc, Code* target) {
 }
 
 
+void MarkCompactCollector::RecordCodePatch(Address pc) {
+  // May be called from the parallel pointer updating tasks.  They only ever
+  // set this flag, so no synchronization is needed.
+  MemoryChunk::FromAnyPointerAddress(heap(), pc)->SetFlag(
+      MemoryChunk::NEEDS_ICACHE_FLUSH);
+}
+
+
+void MarkCompactCollector::FlushPatchedCode() {
+  // Chunks released during the collection are no longer iterated over, which
+  // is fine since they hold no code that can run.
+  PageIterator it(heap()->code_space());
+  while (it.has_next()) {
+    Page* p = it.next();
+    if (!p->IsFlagSet(MemoryChunk::NEEDS_ICACHE_FLUSH)) continue;
+    CPU::FlushICache(p->area_start(), p->area_size());
+    p->ClearFlag(MemoryChunk::NEEDS_ICACHE_FLUSH);
+  }
+  LargeObjectIterator lo_it(heap()->lo_space());
+  for (HeapObject* obj = lo_it.Next(); obj != NULL; obj = lo_it.Next()) {
+    MemoryChunk* chunk = MemoryChunk::FromAddress(obj->address());
+    if (!chunk->IsFlagSet(MemoryChunk::NEEDS_ICACHE_FLUSH)) continue;
+    CPU::FlushICache(obj->address(), obj->Size());
+    chunk->ClearFlag(MemoryChunk::NEEDS_ICACHE_FLUSH);
+  }
+}
+
+
 static inline SlotsBuffer::SlotType DecodeSlotType(
     SlotsBuffer::ObjectSlot slot) {
   return static_cast<SlotsBuffer::SlotType>(reinterpret_cast<intptr_t>(slot));
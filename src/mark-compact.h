@@ -462,6 +462,9 @@ class CodeFlusher {
   void IteratePointersToFromSpace(ObjectVisitor* v);
 
  private:
+  // Counts the flush for the function and for the flushing statistics.
+  void RecordFlush(SharedFunctionInfo* shared, Code* code);
+
   void ProcessOptimizedCodeMaps();
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
@@ -690,6 +693,11 @@ class MarkCompactCollector {
   void RecordCodeEntrySlot(Address slot, Code* target);
   void RecordCodeTargetPatch(Address pc, Code* target);
 
+  // Code patched during the collection skips the instruction cache flush.
+  // The chunks containing it are flushed once, by FlushPatchedCode, before
+  // the collection returns to the mutator.
+  void RecordCodePatch(Address pc);
+
   INLINE(void RecordSlot(Object** anchor_slot,
                          Object** slot,
                          Object* object,
@@ -718,11 +726,18 @@ class MarkCompactCollector {
 
   bool is_compacting() const { return compacting_; }
 
+  bool reduce_memory_footprint() const { return reduce_memory_footprint_; }
+
   MarkingParity marking_parity() { return marking_parity_; }
 
   // Concurrent and parallel sweeping support.
   void SweepInParallel(PagedSpace* space);
 
+  // Lets the main thread sweep pages that no sweeper has claimed yet, until
+  // at least |required_freed_bytes| are freed. The freed memory goes
+  // straight to the free list of |space|. Returns the number of freed bytes.
+  intptr_t SweepOnMainThread(PagedSpace* space, intptr_t required_freed_bytes);
+
   void WaitUntilSweepingCompleted();
 
   intptr_t RefillFreeLists(PagedSpace* space);
@@ -747,8 +762,21 @@ class MarkCompactCollector {
   // to artifically keep AllocationSites alive for a time.
   void MarkAllocationSite(AllocationSite* site);
 
+  // Releases the memory a grown marking deque occupies. The next full
+  // collection starts out with a single from-space page again.
+  void UncommitMarkingDeque();
+
+  size_t marking_deque_committed_size() const {
+    return marking_deque_memory_committed_;
+  }
+
  private:
   class SweeperTask;
+  class SlotsUpdatingTask;
+
+  // Maximal number of threads, including the main thread, that update slots
+  // recorded for evacuation candidates in parallel.
+  static const int kMaxSlotsUpdatingTasks = 8;
 
   explicit MarkCompactCollector(Heap* heap);
   ~MarkCompactCollector();
@@ -761,8 +789,19 @@ class MarkCompactCollector {
   void UnlinkEvacuationCandidates();
   void ReleaseEvacuationCandidates();
 
+  // Flushes the instruction cache of the chunks recorded by RecordCodePatch.
+  void FlushPatchedCode();
+
   void StartSweeperThreads();
 
+  // Updates the slots recorded for every stride-th evacuation candidate,
+  // starting with the first one.
+  void UpdateSlotsOnEvacuationCandidates(int first,
+                                         int stride,
+                                         bool code_slots_filtering_required);
+  void UpdateSlotsOnEvacuationCandidatesInParallel(
+      bool code_slots_filtering_required);
+
 #ifdef DEBUG
   enum CollectorState {
     IDLE,
@@ -799,6 +838,8 @@ class MarkCompactCollector {
 
   Semaphore pending_sweeper_jobs_semaphore_;
 
+  Semaphore pending_slots_updating_jobs_semaphore_;
+
   bool sequential_sweeping_;
 
   // A pointer to the current stack-allocated GC tracer object during a full
@@ -885,6 +926,14 @@ class MarkCompactCollector {
   // flag on the marking stack.
   void RefillMarkingDeque();
 
+  // Replace the empty marking stack with one twice as large, so that heaps
+  // with many live objects do not repeatedly fall back to rescanning the
+  // heap for overflowed objects.  Returns false if it cannot grow further.
+  bool GrowMarkingDeque();
+
+  // Set up the marking stack at the beginning of a full collection.
+  void InitializeMarkingDeque();
+
   // After reachable maps have been marked process per context object
   // literal map caches removing unmarked entries.
   void ProcessMapCaches();
@@ -911,9 +960,13 @@ class MarkCompactCollector {
 
   // Mark all values associated with reachable keys in weak collections
   // encountered so far.  This might push new object or even new weak maps onto
-  // the marking stack.
+  // the marking stack.  Only collections encountered since the last call are
+  // scanned in full, entries with unmarked keys are remembered and revisited.
   void ProcessWeakCollections();
 
+  // Record the key slot of the given weak collection entry and mark its value.
+  void MarkWeakCollectionValue(ObjectHashTable* table, int entry);
+
   // After all reachable objects have been marked those weak map entries
   // with an unreachable key are removed from all encountered weak maps.
   // The linked list of all encountered weak maps is destroyed.
@@ -964,8 +1017,26 @@ class MarkCompactCollector {
 
   Heap* heap_;
   MarkingDeque marking_deque_;
+  // Backing store of the marking deque once it outgrew its from-space page.
+  VirtualMemory* marking_deque_memory_;
+  size_t marking_deque_memory_committed_;
   CodeFlusher* code_flusher_;
   Object* encountered_weak_collections_;
+  // Head of the encountered weak collections list at the last call to
+  // ProcessWeakCollections; it and all collections after it were scanned.
+  Object* processed_weak_collections_;
+
+  // An entry of a weak collection whose key was not marked yet when the
+  // collection was scanned.
+  struct PendingEphemeron {
+    PendingEphemeron(ObjectHashTable* table, int entry)
+        : table(table), entry(entry) { }
+    PendingEphemeron() : table(NULL), entry(0) { }
+    ObjectHashTable* table;
+    int entry;
+  };
+  List<PendingEphemeron> pending_ephemerons_;
+
   bool have_code_to_deoptimize_;
 
   List<Page*> evacuation_candidates_;
@@ -1013,6 +1084,19 @@ class MarkBitCellIterator BASE_EMBEDDED {
     cell_base_ += 32 * kPointerSize;
   }
 
+  // Skips cells without mark bits, testing two cells per step since the
+  // bitmap is mostly empty between live objects.  Returns false if there
+  // are no marked cells left.
+  inline bool AdvanceToMarkedCell() {
+    while (cell_index_ + 1 < last_cell_index_ &&
+           (cells_[cell_index_] | cells_[cell_index_ + 1]) == 0) {
+      cell_index_ += 2;
+      cell_base_ += 64 * kPointerSize;
+    }
+    if (!Done() && cells_[cell_index_] == 0) Advance();
+    return !Done();
+  }
+
  private:
   MemoryChunk* chunk_;
   MarkBit::CellType* cells_;
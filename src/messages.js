@@ -120,6 +120,8 @@ var kMessages = {
   invalid_string_length:         ["Invalid string length"],
   invalid_typed_array_offset:    ["Start offset is too large:"],
   invalid_typed_array_length:    ["Invalid typed array length"],
+  invalid_atomic_access:         ["Atomics operations require an Int32Array or Uint32Array"],
+  invalid_atomic_access_index:   ["Invalid atomic access index"],
   invalid_typed_array_alignment: ["%0", " of ", "%1", " should be a multiple of ", "%2"],
   typed_array_set_source_too_large:
                                  ["Source is too large"],
@@ -131,6 +133,7 @@ var kMessages = {
                                  ["Offset is outside the bounds of the DataView"],
 
   stack_overflow:                ["Maximum call stack size exceeded"],
+  regexp_backtrack_limit:        ["Maximum regular expression backtracking exceeded"],
   invalid_time_value:            ["Invalid time value"],
   invalid_count_value:           ["Invalid count value"],
   // SyntaxError
@@ -147,6 +150,8 @@ var kMessages = {
   no_input_to_regexp:            ["No input to ", "%0"],
   invalid_json:                  ["String '", "%0", "' is not valid JSON"],
   circular_structure:            ["Converting circular structure to JSON"],
+  data_clone_error:              ["%0", " could not be cloned."],
+  data_clone_deserialization_error: ["Unable to deserialize cloned data."],
   called_on_non_object:          ["%0", " called on non-object"],
   called_on_null_or_undefined:   ["%0", " called on null or undefined"],
   array_indexof_not_defined:     ["Array.getIndexOf: Argument undefined"],
@@ -0,0 +1,198 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "microtask-queue.h"
+
+#include "execution.h"
+
+namespace v8 {
+namespace internal {
+
+MicrotaskQueue::MicrotaskQueue(Isolate* isolate)
+    : isolate_(isolate),
+      ring_(NULL),
+      capacity_(0),
+      start_(0),
+      size_(0) {
+}
+
+
+MicrotaskQueue::~MicrotaskQueue() {
+  DeleteArray(ring_);
+}
+
+
+void MicrotaskQueue::Enqueue(Handle<Object> microtask) {
+  Microtask* task = Push(JS_MICROTASK);
+  task->objects[0] = *microtask;
+}
+
+
+void MicrotaskQueue::Enqueue(v8::MicrotaskCallback callback, void* data) {
+  ASSERT(callback != NULL);
+  Microtask* task = Push(CALLBACK_MICROTASK);
+  task->callback = callback;
+  task->data = data;
+}
+
+
+void MicrotaskQueue::EnqueuePromiseReactionJob(Handle<Context> native_context,
+                                               Handle<Object> value,
+                                               Handle<JSArray> tasks) {
+  ASSERT(native_context->IsNativeContext());
+  Microtask* task = Push(PROMISE_REACTION_JOB);
+  task->objects[0] = *native_context;
+  task->objects[1] = *value;
+  task->objects[2] = *tasks;
+}
+
+
+void MicrotaskQueue::RunMicrotasks() {
+  Handle<Object> receiver = isolate_->factory()->undefined_value();
+  while (size_ > 0) {
+    HandleScope scope(isolate_);
+    Microtask task = ring_[start_];
+    start_ = (start_ + 1) & (capacity_ - 1);
+    size_--;
+
+    switch (task.kind) {
+      case JS_MICROTASK: {
+        bool threw = false;
+        Handle<Object> callable(task.objects[0], isolate_);
+        Execution::Call(isolate_, callable, receiver, 0, NULL, &threw);
+        if (threw) return;
+        break;
+      }
+      case CALLBACK_MICROTASK:
+        task.callback(task.data);
+        break;
+      case PROMISE_REACTION_JOB: {
+        Handle<Context> native_context(Context::cast(task.objects[0]));
+        Handle<Object> value(task.objects[1], isolate_);
+        Handle<JSArray> tasks(JSArray::cast(task.objects[2]));
+        if (!RunPromiseReactionJob(native_context, value, tasks)) return;
+        break;
+      }
+    }
+  }
+}
+
+
+bool MicrotaskQueue::RunPromiseReactionJob(Handle<Context> native_context,
+                                           Handle<Object> value,
+                                           Handle<JSArray> tasks) {
+  Handle<Object> receiver = isolate_->factory()->undefined_value();
+  Handle<JSFunction> handle(native_context->promise_handle());
+  Handle<JSFunction> handle_result(native_context->promise_handle_result());
+  Handle<JSFunction> handle_error(native_context->promise_handle_error());
+  Object* termination = isolate_->heap()->termination_exception();
+
+  int length = Smi::cast(tasks->length())->value();
+  for (int i = 0; i + 1 < length; i += 2) {
+    HandleScope scope(isolate_);
+    Handle<Object> handler(
+        tasks->GetElementNoExceptionThrown(isolate_, i), isolate_);
+    Handle<Object> deferred(
+        tasks->GetElementNoExceptionThrown(isolate_, i + 1), isolate_);
+    bool caught = false;
+
+    if (!handler->IsJSFunction()) {
+      // Leave the TypeError for a non-callable handler to PromiseHandle.
+      Handle<Object> argv[] = { value, handler, deferred };
+      Handle<Object> result = Execution::TryCall(
+          handle, receiver, ARRAY_SIZE(argv), argv, &caught);
+      if (caught && *result == termination) return false;
+      continue;
+    }
+
+    Handle<Object> argv[] = { value };
+    Handle<Object> result = Execution::TryCall(
+        Handle<JSFunction>::cast(handler), receiver, 1, argv, &caught);
+    if (!caught) {
+      Handle<Object> result_argv[] = { result, deferred };
+      result = Execution::TryCall(
+          handle_result, receiver, ARRAY_SIZE(result_argv), result_argv,
+          &caught);
+    }
+    if (caught) {
+      if (*result == termination) return false;
+      // Exceptions thrown by the reject function are ignored.
+      Handle<Object> error_argv[] = { result, deferred };
+      result = Execution::TryCall(
+          handle_error, receiver, ARRAY_SIZE(error_argv), error_argv,
+          &caught);
+      if (caught && *result == termination) return false;
+    }
+  }
+  return true;
+}
+
+
+void MicrotaskQueue::Iterate(ObjectVisitor* v) {
+  for (int i = 0; i < size_; i++) {
+    Microtask* task = &ring_[(start_ + i) & (capacity_ - 1)];
+    switch (task->kind) {
+      case JS_MICROTASK:
+        v->VisitPointer(&task->objects[0]);
+        break;
+      case CALLBACK_MICROTASK:
+        break;
+      case PROMISE_REACTION_JOB:
+        v->VisitPointers(&task->objects[0], &task->objects[kMaxObjects]);
+        break;
+    }
+  }
+}
+
+
+MicrotaskQueue::Microtask* MicrotaskQueue::Push(Kind kind) {
+  if (size_ == capacity_) Grow();
+  Microtask* task = &ring_[(start_ + size_) & (capacity_ - 1)];
+  size_++;
+  task->kind = kind;
+  task->callback = NULL;
+  task->data = NULL;
+  for (int i = 0; i < kMaxObjects; i++) task->objects[i] = Smi::FromInt(0);
+  return task;
+}
+
+
+void MicrotaskQueue::Grow() {
+  int new_capacity = capacity_ == 0 ? kInitialCapacity : capacity_ * 2;
+  Microtask* new_ring = NewArray<Microtask>(new_capacity);
+  for (int i = 0; i < size_; i++) {
+    new_ring[i] = ring_[(start_ + i) & (capacity_ - 1)];
+  }
+  DeleteArray(ring_);
+  ring_ = new_ring;
+  capacity_ = new_capacity;
+  start_ = 0;
+}
+
+} }  // namespace v8::internal
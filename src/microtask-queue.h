@@ -0,0 +1,107 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_MICROTASK_QUEUE_H_
+#define V8_MICROTASK_QUEUE_H_
+
+namespace v8 {
+namespace internal {
+
+// The per-isolate queue of microtasks, e.g. promise reactions, change
+// records of Object.observe and tasks enqueued through the API. A task is
+// a callable JS object, a C++ callback with a data pointer, or the reaction
+// job of a settled promise. The tasks are kept in a ring buffer that grows
+// as needed and are run in FIFO order by a C++ loop until the queue is
+// empty.
+class MicrotaskQueue {
+ public:
+  explicit MicrotaskQueue(Isolate* isolate);
+  ~MicrotaskQueue();
+
+  void Enqueue(Handle<Object> microtask);
+  void Enqueue(v8::MicrotaskCallback callback, void* data);
+
+  // Enqueues the calls of the handlers of a promise that was resolved or
+  // rejected with the given value. The tasks are (handler, deferred) pairs,
+  // see promise.js.
+  void EnqueuePromiseReactionJob(Handle<Context> native_context,
+                                 Handle<Object> value,
+                                 Handle<JSArray> tasks);
+
+  bool HasPendingMicrotasks() const { return size_ > 0; }
+
+  // Runs the queued microtasks, including the ones they enqueue, until the
+  // queue is empty. Stops early and keeps the remaining tasks if a task
+  // throws.
+  void RunMicrotasks();
+
+  // Visits the JS microtasks as strong roots.
+  void Iterate(ObjectVisitor* v);
+
+ private:
+  enum Kind {
+    JS_MICROTASK,
+    CALLBACK_MICROTASK,
+    PROMISE_REACTION_JOB
+  };
+
+  // A JS microtask keeps the callable in objects[0]. A promise reaction job
+  // keeps the native context, the value and the tasks.
+  static const int kMaxObjects = 3;
+
+  struct Microtask {
+    Kind kind;
+    Object* objects[kMaxObjects];
+    v8::MicrotaskCallback callback;
+    void* data;
+  };
+
+  static const int kInitialCapacity = 8;
+
+  Microtask* Push(Kind kind);
+  void Grow();
+
+  // Calls each handler with the value and settles its deferred with the
+  // result. This does what PromiseHandle in promise.js does, but keeps the
+  // try/catch out of JS code. Returns false if execution was terminated.
+  bool RunPromiseReactionJob(Handle<Context> native_context,
+                             Handle<Object> value,
+                             Handle<JSArray> tasks);
+
+  Isolate* isolate_;
+  // The capacity is always a power of two so that indices can be masked.
+  Microtask* ring_;
+  int capacity_;
+  int start_;
+  int size_;
+
+  DISALLOW_COPY_AND_ASSIGN(MicrotaskQueue);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_MICROTASK_QUEUE_H_
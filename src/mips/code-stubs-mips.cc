@@ -166,6 +166,26 @@ void KeyedLoadFieldStub::InitializeInterfaceDescriptor(
 }
 
 
+void LoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { a0 };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
+void KeyedLoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { a1 };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
 void KeyedStoreFastElementStub::InitializeInterfaceDescriptor(
     Isolate* isolate,
     CodeStubInterfaceDescriptor* descriptor) {
@@ -1538,6 +1558,8 @@ void CodeStub::GenerateStubsAheadOfTime(Isolate* isolate) {
   StoreRegistersStateStub::GenerateAheadOfTime(isolate);
   RestoreRegistersStateStub::GenerateAheadOfTime(isolate);
   BinaryOpICWithAllocationSiteStub::GenerateAheadOfTime(isolate);
+  KeyedLoadFastElementStub::GenerateAheadOfTime(isolate);
+  TransitionElementsKindStub::GenerateAheadOfTime(isolate);
 }
 
 
@@ -3772,6 +3794,13 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ Branch(&runtime, hi, a2, Operand(t0));
   // Shorter than original string's length: an actual substring.
 
+  // Empty substrings need no allocation.
+  Label not_empty;
+  __ Branch(&not_empty, ne, a2, Operand(zero_reg));
+  __ LoadRoot(v0, Heap::kempty_stringRootIndex);
+  __ jmp(&return_v0);
+  __ bind(&not_empty);
+
   // Deal with different string types: update the index if necessary
   // and put the underlying string into t1.
   // v0: original string
@@ -2654,7 +2654,7 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
     __ lw(at, MemOperand(sp, 0));
     __ push(at);
     __ sw(v0, MemOperand(sp, kPointerSize));
-    flags = CALL_AS_METHOD;
+    flags = RECORD_CALL_TARGET_AS_METHOD;
   }
 
   // Load the arguments.
@@ -2665,6 +2665,10 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
   }
   // Record source position for debugger.
   SetSourcePosition(expr->position());
+  if (flags == RECORD_CALL_TARGET_AS_METHOD) {
+    __ li(a2, FeedbackVector());
+    __ li(a3, Operand(Smi::FromInt(expr->CallFeedbackSlot())));
+  }
   CallFunctionStub stub(arg_count, flags);
   __ lw(a1, MemOperand(sp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
@@ -2707,7 +2711,9 @@ void FullCodeGenerator::EmitKeyedCallWithIC(Call* expr,
 
   // Record source position for debugger.
   SetSourcePosition(expr->position());
-  CallFunctionStub stub(arg_count, CALL_AS_METHOD);
+  __ li(a2, FeedbackVector());
+  __ li(a3, Operand(Smi::FromInt(expr->CallFeedbackSlot())));
+  CallFunctionStub stub(arg_count, RECORD_CALL_TARGET_AS_METHOD);
   __ lw(a1, MemOperand(sp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
 
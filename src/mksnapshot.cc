@@ -27,6 +27,7 @@
 
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
 #ifdef COMPRESS_STARTUP_DATA_BZ2
 #include <bzlib.h>
 #endif
@@ -40,6 +41,8 @@
 #include "platform.h"
 #include "serialize.h"
 #include "list.h"
+#include "lz-codec.h"
+#include "smart-pointers.h"
 
 using namespace v8;
 
@@ -59,6 +62,12 @@ class PartialSnapshotSink : public i::SnapshotByteSink {
   virtual void Put(int byte, const char* description) {
     data_.Add(byte);
   }
+  virtual void PutRaw(const i::byte* data,
+                      int number_of_bytes,
+                      const char* description) {
+    data_.AddAll(i::Vector<char>(
+        reinterpret_cast<char*>(const_cast<i::byte*>(data)), number_of_bytes));
+  }
   virtual int Position() { return data_.length(); }
   void Print(FILE* fp) {
     int length = Position();
@@ -107,7 +116,7 @@ class CppByteSink : public PartialSnapshotSink {
 
   virtual ~CppByteSink() {
     fprintf(fp_, "const int Snapshot::size_ = %d;\n", Position());
-#ifdef COMPRESS_STARTUP_DATA_BZ2
+#if defined(COMPRESS_STARTUP_DATA_BZ2) || defined(COMPRESS_STARTUP_DATA_LZ)
     fprintf(fp_, "const byte* Snapshot::raw_data_ = NULL;\n");
     fprintf(fp_,
             "const int Snapshot::raw_size_ = %d;\n\n",
@@ -165,7 +174,7 @@ class CppByteSink : public PartialSnapshotSink {
     int length = partial_sink_.Position();
     fprintf(fp_, "};\n\n");
     fprintf(fp_, "const int Snapshot::context_size_ = %d;\n",  length);
-#ifdef COMPRESS_STARTUP_DATA_BZ2
+#if defined(COMPRESS_STARTUP_DATA_BZ2) || defined(COMPRESS_STARTUP_DATA_LZ)
     fprintf(fp_,
             "const int Snapshot::context_raw_size_ = %d;\n",
             partial_sink_.raw_size());
@@ -177,7 +186,7 @@ class CppByteSink : public PartialSnapshotSink {
     fprintf(fp_, "const byte Snapshot::context_data_[] = {\n");
     partial_sink_.Print(fp_);
     fprintf(fp_, "};\n\n");
-#ifdef COMPRESS_STARTUP_DATA_BZ2
+#if defined(COMPRESS_STARTUP_DATA_BZ2) || defined(COMPRESS_STARTUP_DATA_LZ)
     fprintf(fp_, "const byte* Snapshot::context_raw_data_ = NULL;\n");
 #else
     fprintf(fp_, "const byte* Snapshot::context_raw_data_ ="
@@ -253,6 +262,35 @@ class BZip2Decompressor : public StartupDataDecompressor {
 #endif
 
 
+#ifdef COMPRESS_STARTUP_DATA_LZ
+class LZCompressor : public Compressor {
+ public:
+  LZCompressor() : output_(NULL) {}
+  virtual ~LZCompressor() {
+    delete output_;
+  }
+  virtual bool Compress(i::Vector<char> input) {
+    delete output_;
+    output_ = new i::ScopedVector<char>(
+        i::LZCodec::CompressBound(input.length()));
+    int output_length = i::LZCodec::Compress(
+        reinterpret_cast<const i::byte*>(input.start()), input.length(),
+        reinterpret_cast<i::byte*>(output_->start()), output_->length());
+    if (output_length < 0) {
+      fprintf(stderr, "lz compression failed\n");
+      return false;
+    }
+    output_->Truncate(output_length);
+    return true;
+  }
+  virtual i::Vector<char>* output() { return output_; }
+
+ private:
+  i::ScopedVector<char>* output_;
+};
+#endif
+
+
 void DumpException(Handle<Message> message) {
   String::Utf8Value message_string(message->Get());
   String::Utf8Value message_line(message->GetSourceLine());
@@ -265,6 +303,46 @@ void DumpException(Handle<Message> message) {
 }
 
 
+static void RunExtraCode(Isolate* isolate, const char* name) {
+  FILE* file = i::OS::FOpen(name, "rb");
+  if (file == NULL) {
+    fprintf(stderr, "Failed to open '%s': errno %d\n", name, errno);
+    exit(1);
+  }
+
+  fseek(file, 0, SEEK_END);
+  int size = ftell(file);
+  rewind(file);
+
+  char* chars = new char[size + 1];
+  chars[size] = '\0';
+  for (int i = 0; i < size;) {
+    int read = static_cast<int>(fread(&chars[i], 1, size - i, file));
+    if (read < 0) {
+      fprintf(stderr, "Failed to read '%s': errno %d\n", name, errno);
+      exit(1);
+    }
+    i += read;
+  }
+  fclose(file);
+  Local<String> source = String::NewFromUtf8(isolate, chars);
+  delete[] chars;
+  TryCatch try_catch;
+  Local<Script> script = Script::Compile(source);
+  if (try_catch.HasCaught()) {
+    fprintf(stderr, "Failure compiling '%s'\n", name);
+    DumpException(try_catch.Message());
+    exit(1);
+  }
+  script->Run();
+  if (try_catch.HasCaught()) {
+    fprintf(stderr, "Failure running '%s'\n", name);
+    DumpException(try_catch.Message());
+    exit(1);
+  }
+}
+
+
 int main(int argc, char** argv) {
   V8::InitializeICU();
   i::Isolate::SetCrashIfDefaultIsolateInitialized();
@@ -310,41 +388,16 @@ int main(int argc, char** argv) {
     V8::SetCaptureStackTraceForUncaughtExceptions(true, 100);
     HandleScope scope(isolate);
     v8::Context::Scope cscope(v8::Local<v8::Context>::New(isolate, context));
-    const char* name = i::FLAG_extra_code;
-    FILE* file = i::OS::FOpen(name, "rb");
-    if (file == NULL) {
-      fprintf(stderr, "Failed to open '%s': errno %d\n", name, errno);
-      exit(1);
-    }
-
-    fseek(file, 0, SEEK_END);
-    int size = ftell(file);
-    rewind(file);
-
-    char* chars = new char[size + 1];
-    chars[size] = '\0';
-    for (int i = 0; i < size;) {
-      int read = static_cast<int>(fread(&chars[i], 1, size - i, file));
-      if (read < 0) {
-        fprintf(stderr, "Failed to read '%s': errno %d\n", name, errno);
-        exit(1);
-      }
-      i += read;
-    }
-    fclose(file);
-    Local<String> source = String::NewFromUtf8(isolate, chars);
-    TryCatch try_catch;
-    Local<Script> script = Script::Compile(source);
-    if (try_catch.HasCaught()) {
-      fprintf(stderr, "Failure compiling '%s'\n", name);
-      DumpException(try_catch.Message());
-      exit(1);
-    }
-    script->Run();
-    if (try_catch.HasCaught()) {
-      fprintf(stderr, "Failure running '%s'\n", name);
-      DumpException(try_catch.Message());
-      exit(1);
+    // Several scripts can be given as a comma separated list. They are run
+    // in order in the same context, so later ones can build on the global
+    // state set up by earlier ones.
+    i::SmartArrayPointer<char> names(i::StrDup(i::FLAG_extra_code));
+    char* name = names.get();
+    while (name != NULL) {
+      char* next = strchr(name, ',');
+      if (next != NULL) *next++ = '\0';
+      if (*name != '\0') RunExtraCode(isolate, name);
+      name = next;
     }
   }
   // Make sure all builtin scripts are cached.
@@ -377,6 +430,12 @@ int main(int argc, char** argv) {
     return 1;
   if (!sink.partial_sink()->Compress(&compressor))
     return 1;
+#elif defined(COMPRESS_STARTUP_DATA_LZ)
+  LZCompressor compressor;
+  if (!sink.Compress(&compressor))
+    return 1;
+  if (!sink.partial_sink()->Compress(&compressor))
+    return 1;
 #endif
   sink.WriteSnapshot();
   sink.WritePartialSnapshot();
@@ -0,0 +1,94 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_MPSC_QUEUE_INL_H_
+#define V8_MPSC_QUEUE_INL_H_
+
+#include "mpsc-queue.h"
+
+#include "atomicops.h"
+
+namespace v8 {
+namespace internal {
+
+template<typename Record>
+struct MPSCQueue<Record>::Node: public Malloced {
+  explicit Node(const Record& value)
+      : value(value), next(0) {
+  }
+
+  Record value;
+  AtomicWord next;  // Node*
+};
+
+
+template<typename Record>
+MPSCQueue<Record>::MPSCQueue() {
+  tail_ = new Node(Record());
+  head_ = reinterpret_cast<AtomicWord>(tail_);
+}
+
+
+template<typename Record>
+MPSCQueue<Record>::~MPSCQueue() {
+  Record rec;
+  while (Dequeue(&rec)) { }
+  delete tail_;
+}
+
+
+template<typename Record>
+void MPSCQueue<Record>::Enqueue(const Record& rec) {
+  Node* node = new Node(rec);
+  // Make the initialized node visible before another producer can link
+  // its own node behind it.
+  MemoryBarrier();
+  Node* prev = reinterpret_cast<Node*>(
+      NoBarrier_AtomicExchange(&head_, reinterpret_cast<AtomicWord>(node)));
+  Release_Store(&prev->next, reinterpret_cast<AtomicWord>(node));
+}
+
+
+template<typename Record>
+bool MPSCQueue<Record>::Dequeue(Record* rec) {
+  Node* next = reinterpret_cast<Node*>(Acquire_Load(&tail_->next));
+  if (next == NULL) return false;
+  *rec = next->value;
+  delete tail_;
+  tail_ = next;
+  return true;
+}
+
+
+template<typename Record>
+bool MPSCQueue<Record>::IsEmpty() const {
+  return Acquire_Load(&tail_->next) == 0;
+}
+
+} }  // namespace v8::internal
+
+#endif  // V8_MPSC_QUEUE_INL_H_
@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_MPSC_QUEUE_H_
+#define V8_MPSC_QUEUE_H_
+
+#include "allocation.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Lock-free unbound queue for small records. Any number of threads may
+// enqueue concurrently; a single consumer thread dequeues. Producers never
+// block and never wait for each other: an enqueue is one atomic exchange
+// followed by a store. A record becomes visible to the consumer once its
+// producer has linked it, so the consumer may briefly see an empty queue
+// while an enqueue is in flight. Implemented after Dmitry Vyukov's
+// node-based MPSC queue.
+template<typename Record>
+class MPSCQueue BASE_EMBEDDED {
+ public:
+  inline MPSCQueue();
+  inline ~MPSCQueue();
+
+  // Executed on any thread.
+  INLINE(void Enqueue(const Record& rec));
+
+  // Executed on the consumer thread only.
+  INLINE(bool Dequeue(Record* rec));
+  INLINE(bool IsEmpty() const);
+
+ private:
+  struct Node;
+
+  // The most recently enqueued node, updated by producers.
+  AtomicWord head_;  // Node*
+  // The last dequeued node, owned by the consumer. Its successor is the
+  // next record to dequeue.
+  Node* tail_;
+
+  DISALLOW_COPY_AND_ASSIGN(MPSCQueue);
+};
+
+
+} }  // namespace v8::internal
+
+#endif  // V8_MPSC_QUEUE_H_
@@ -435,14 +435,44 @@ function ObserverEnqueueIfActive(observer, objectInfo, changeRecord,
     return;
   }
 
+  ObserverGetPendingCallbackInfo(callback).push(changeRecord);
+}
+
+function ObserverGetPendingCallbackInfo(callback) {
   var callbackInfo = CallbackInfoNormalize(callback);
   if (IS_NULL(GetPendingObservers())) {
     SetPendingObservers(nullProtoObject())
-    GetMicrotaskQueue().push(ObserveMicrotaskRunner);
-    %SetMicrotaskPending(true);
+    %EnqueueMicrotask(ObserveMicrotaskRunner);
   }
   GetPendingObservers()[callbackInfo.priority] = callback;
-  callbackInfo.push(changeRecord);
+  return callbackInfo;
+}
+
+// Change records of internal mutations of objects with a single observer are
+// queued in a compact form: the argument count of NotifyChange followed by
+// its four arguments. They are only turned into record objects on delivery.
+function CallbackInfoTakeRecords(callbackInfo) {
+  var records = [];
+  %MoveArrayContents(callbackInfo, records);
+  if (!callbackInfo.hasCompactRecords)
+    return records;
+
+  var length = records.length;
+  var count = 0;
+  for (var i = 0; i < length; count++) {
+    var entry = records[i];
+    if (IS_NUMBER(entry)) {
+      records[count] = ChangeRecordCreate(entry, records[i + 1],
+                                          records[i + 2], records[i + 3],
+                                          records[i + 4]);
+      i += 5;
+    } else {
+      records[count] = entry;
+      i++;
+    }
+  }
+  records.length = count;
+  return records;
 }
 
 function ObjectInfoEnqueueExternalChangeRecord(objectInfo, changeRecord, type) {
@@ -519,15 +549,11 @@ function EnqueueSpliceRecord(array, index, removed, addedCount) {
   ObjectInfoEnqueueInternalChangeRecord(objectInfo, changeRecord);
 }
 
-function NotifyChange(type, object, name, oldValue) {
-  var objectInfo = ObjectInfoGet(object);
-  if (!ObjectInfoHasActiveObservers(objectInfo))
-    return;
-
+function ChangeRecordCreate(argumentCount, type, object, name, oldValue) {
   var changeRecord;
-  if (arguments.length == 2) {
+  if (argumentCount == 2) {
     changeRecord = { type: type, object: object };
-  } else if (arguments.length == 3) {
+  } else if (argumentCount == 3) {
     changeRecord = { type: type, object: object, name: name };
   } else {
     changeRecord = {
@@ -539,6 +565,34 @@ function NotifyChange(type, object, name, oldValue) {
   }
 
   ObjectFreeze(changeRecord);
+  return changeRecord;
+}
+
+function NotifyChange(type, object, name, oldValue) {
+  var objectInfo = ObjectInfoGet(object);
+  if (!ObjectInfoHasActiveObservers(objectInfo))
+    return;
+
+  var argumentCount = arguments.length;
+  var observer = objectInfo.changeObservers;
+  if (ChangeObserversIsOptimized(observer) &&
+      !%IsAccessCheckNeeded(object)) {
+    // The only observer is known to be active. Defer creating the record
+    // until it is delivered.
+    // TODO(rossberg): adjust once there is a story for symbols vs proxies.
+    if (IS_SYMBOL(name) ||
+        !TypeMapHasType(ObserverGetAcceptTypes(observer), type)) {
+      return;
+    }
+    var callbackInfo =
+        ObserverGetPendingCallbackInfo(ObserverGetCallback(observer));
+    callbackInfo.hasCompactRecords = true;
+    callbackInfo.push(argumentCount, type, object, name, oldValue);
+    return;
+  }
+
+  var changeRecord =
+      ChangeRecordCreate(argumentCount, type, object, name, oldValue);
   ObjectInfoEnqueueInternalChangeRecord(objectInfo, changeRecord);
 }
 
@@ -606,8 +660,7 @@ function CallbackDeliverPending(callback) {
   if (GetPendingObservers())
     delete GetPendingObservers()[priority];
 
-  var delivered = [];
-  %MoveArrayContents(callbackInfo, delivered);
+  var delivered = CallbackInfoTakeRecords(callbackInfo);
 
   try {
     %_CallFunction(UNDEFINED, delivered, callback);
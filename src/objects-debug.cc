@@ -669,7 +669,7 @@ void JSSet::JSSetVerify() {
   CHECK(IsJSSet());
   JSObjectVerify();
   VerifyHeapPointer(table());
-  CHECK(table()->IsHashTable() || table()->IsUndefined());
+  CHECK(table()->IsFixedArray() || table()->IsUndefined());
 }
 
 
@@ -677,7 +677,7 @@ void JSMap::JSMapVerify() {
   CHECK(IsJSMap());
   JSObjectVerify();
   VerifyHeapPointer(table());
-  CHECK(table()->IsHashTable() || table()->IsUndefined());
+  CHECK(table()->IsFixedArray() || table()->IsUndefined());
 }
 
 
@@ -731,6 +731,12 @@ void JSRegExp::JSRegExpVerify() {
       CHECK(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)->IsSmi());
       break;
     }
+    case JSRegExp::LINEAR: {
+      FixedArray* arr = FixedArray::cast(data());
+      CHECK(arr->get(JSRegExp::kLinearProgramIndex)->IsByteArray());
+      CHECK(arr->get(JSRegExp::kLinearCaptureCountIndex)->IsSmi());
+      break;
+    }
     default:
       CHECK_EQ(JSRegExp::NOT_COMPILED, TypeTag());
       CHECK(data()->IsUndefined());
@@ -935,6 +941,9 @@ void Script::ScriptVerify() {
   type()->SmiVerify();
   VerifyPointer(line_ends());
   VerifyPointer(id());
+  VerifyPointer(lazy_function_data());
+  CHECK(lazy_function_data()->IsUndefined() ||
+        lazy_function_data()->IsByteArray());
 }
 
 
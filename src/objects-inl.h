@@ -458,6 +458,16 @@ uc32 FlatStringReader::Get(int index) {
 }
 
 
+// Entries of the string table are internalized and so always have their hash
+// computed.  Comparing it against the hash field of a key rejects most probe
+// collisions without looking at the characters.
+inline bool StringHashMayMatch(Object* string, uint32_t hash_field) {
+  String* entry = String::cast(string);
+  return hash_field == 0 || !entry->HasHashCode() ||
+      entry->Hash() == (hash_field >> String::kHashShift);
+}
+
+
 template <typename Char>
 class SequentialStringKey : public HashTableKey {
  public:
@@ -491,7 +501,8 @@ class OneByteStringKey : public SequentialStringKey<uint8_t> {
       : SequentialStringKey<uint8_t>(str, seed) { }
 
   virtual bool IsMatch(Object* string) {
-    return String::cast(string)->IsOneByteEqualTo(string_);
+    return StringHashMayMatch(string, hash_field_) &&
+        String::cast(string)->IsOneByteEqualTo(string_);
   }
 
   virtual MaybeObject* AsObject(Heap* heap);
@@ -502,7 +513,7 @@ template<class Char>
 class SubStringKey : public HashTableKey {
  public:
   SubStringKey(Handle<String> string, int from, int length)
-      : string_(string), from_(from), length_(length) {
+      : string_(string), from_(from), length_(length), hash_field_(0) {
     if (string_->IsSlicedString()) {
       string_ = Handle<String>(Unslice(*string_, &from_));
     }
@@ -551,7 +562,8 @@ class TwoByteStringKey : public SequentialStringKey<uc16> {
       : SequentialStringKey<uc16>(str, seed) { }
 
   virtual bool IsMatch(Object* string) {
-    return String::cast(string)->IsTwoByteEqualTo(string_);
+    return StringHashMayMatch(string, hash_field_) &&
+        String::cast(string)->IsTwoByteEqualTo(string_);
   }
 
   virtual MaybeObject* AsObject(Heap* heap);
@@ -565,7 +577,8 @@ class Utf8StringKey : public HashTableKey {
       : string_(string), hash_field_(0), seed_(seed) { }
 
   virtual bool IsMatch(Object* string) {
-    return String::cast(string)->IsUtf8EqualTo(string_);
+    return StringHashMayMatch(string, hash_field_) &&
+        String::cast(string)->IsUtf8EqualTo(string_);
   }
 
   virtual uint32_t Hash() {
@@ -1447,6 +1460,7 @@ void AllocationSite::Initialize() {
   set_nested_site(Smi::FromInt(0));
   set_pretenure_data(Smi::FromInt(0));
   set_pretenure_create_count(Smi::FromInt(0));
+  set_pretenure_survived_bytes(Smi::FromInt(0));
   set_dependent_code(DependentCode::cast(GetHeap()->empty_fixed_array()),
                      SKIP_WRITE_BARRIER);
 }
@@ -1536,6 +1550,26 @@ inline void AllocationSite::IncrementMementoCreateCount() {
 }
 
 
+inline void AllocationSite::IncrementSurvivedBytes(int bytes) {
+  ASSERT(bytes >= 0);
+  int value = survived_bytes();
+  value = value > Smi::kMaxValue - bytes ? Smi::kMaxValue : value + bytes;
+  set_pretenure_survived_bytes(Smi::FromInt(value), SKIP_WRITE_BARRIER);
+}
+
+
+inline bool AllocationSite::DecayPretenureDecision() {
+  if (pretenure_decision() != kTenure) return false;
+  ResetPretenureDecision();
+  set_deopt_dependent_code(true);
+  if (FLAG_trace_pretenuring_statistics) {
+    PrintF("AllocationSite(%p): tenure decision decayed\n",
+           static_cast<void*>(this));
+  }
+  return true;
+}
+
+
 inline bool AllocationSite::DigestPretenuringFeedback() {
   bool decision_changed = false;
   int create_count = memento_create_count();
@@ -3378,6 +3412,57 @@ void StringCharacterStream::VisitTwoByteString(
 }
 
 
+StringSegmentIterator::StringSegmentIterator(String* string,
+                                             ConsStringIteratorOp* op)
+  : string_(string),
+    op_(op),
+    started_(false),
+    is_one_byte_(false),
+    buffer8_(NULL),
+    offset_(0),
+    length_(0) {
+  op_->Reset();
+}
+
+
+bool StringSegmentIterator::Next() {
+  offset_ += length_;
+  length_ = 0;
+  if (!started_) {
+    started_ = true;
+    if (string_->length() == 0) return false;
+    String::Visit(string_, 0, *this, *op_, string_->map()->instance_type(),
+                  static_cast<unsigned>(string_->length()));
+    return true;
+  }
+  if (!op_->HasMore()) return false;
+  unsigned length;
+  int32_t type;
+  String* string = op_->ContinueOperation(&type, &length);
+  if (string == NULL) return false;
+  ASSERT(!string->IsConsString());
+  ConsStringNullOp null_op;
+  String::Visit(string, 0, *this, null_op, type, length);
+  return true;
+}
+
+
+void StringSegmentIterator::VisitOneByteString(
+    const uint8_t* chars, unsigned length) {
+  is_one_byte_ = true;
+  buffer8_ = chars;
+  length_ = static_cast<int>(length);
+}
+
+
+void StringSegmentIterator::VisitTwoByteString(
+    const uint16_t* chars, unsigned length) {
+  is_one_byte_ = false;
+  buffer16_ = chars;
+  length_ = static_cast<int>(length);
+}
+
+
 void JSFunctionResultCache::MakeZeroSize() {
   set_finger_index(kEntriesIndex);
   set_size(kEntriesIndex);
@@ -4891,6 +4976,8 @@ ACCESSORS(AllocationSite, nested_site, Object, kNestedSiteOffset)
 ACCESSORS_TO_SMI(AllocationSite, pretenure_data, kPretenureDataOffset)
 ACCESSORS_TO_SMI(AllocationSite, pretenure_create_count,
                  kPretenureCreateCountOffset)
+ACCESSORS_TO_SMI(AllocationSite, pretenure_survived_bytes,
+                 kPretenureSurvivedBytesOffset)
 ACCESSORS(AllocationSite, dependent_code, DependentCode,
           kDependentCodeOffset)
 ACCESSORS(AllocationSite, weak_next, Object, kWeakNextOffset)
@@ -4909,6 +4996,7 @@ ACCESSORS(Script, eval_from_shared, Object, kEvalFromSharedOffset)
 ACCESSORS_TO_SMI(Script, eval_from_instructions_offset,
                  kEvalFrominstructionsOffsetOffset)
 ACCESSORS_TO_SMI(Script, flags, kFlagsOffset)
+ACCESSORS(Script, lazy_function_data, Object, kLazyFunctionDataOffset)
 BOOL_ACCESSORS(Script, flags, is_shared_cross_origin, kIsSharedCrossOriginBit)
 
 Script::CompilationType Script::compilation_type() {
@@ -5159,6 +5247,11 @@ BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_inline, kDontInline)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_cache, kDontCache)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, dont_flush, kDontFlush)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_generator, kIsGenerator)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, lazy_inner_functions,
+               kLazyInnerFunctions)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints,
+               dont_need_arguments_adaptation,
+               kDontNeedArgumentsAdaptation)
 
 void SharedFunctionInfo::BeforeVisitingPointers() {
   if (IsInobjectSlackTrackingInProgress()) DetachInitialMap();
@@ -5248,6 +5341,14 @@ bool SharedFunctionInfo::is_compiled() {
 }
 
 
+int SharedFunctionInfo::AgeOptimizedCodeMap() {
+  FixedArray* code_map = FixedArray::cast(optimized_code_map());
+  int age = Smi::cast(code_map->get(kAgeIndex))->value();
+  code_map->set(kAgeIndex, Smi::FromInt(age + 1));
+  return age;
+}
+
+
 bool SharedFunctionInfo::IsApiFunction() {
   return function_data()->IsFunctionTemplateInfo();
 }
@@ -5308,6 +5409,20 @@ void SharedFunctionInfo::set_opt_reenable_tries(int tries) {
 }
 
 
+int SharedFunctionInfo::flush_count() {
+  return FlushCountBits::decode(counters());
+}
+
+
+void SharedFunctionInfo::increment_flush_count() {
+  int value = counters();
+  int flush_count = FlushCountBits::decode(value);
+  if (flush_count < FlushCountBits::kMax) {
+    set_counters(FlushCountBits::update(value, flush_count + 1));
+  }
+}
+
+
 int SharedFunctionInfo::opt_count() {
   return OptCountBits::decode(opt_count_and_bailout_reason());
 }
@@ -5659,6 +5774,7 @@ JSMessageObject* JSMessageObject::cast(Object* obj) {
 
 INT_ACCESSORS(Code, instruction_size, kInstructionSizeOffset)
 INT_ACCESSORS(Code, prologue_offset, kPrologueOffset)
+INT_ACCESSORS(Code, creation_time, kCreationTimeOffset)
 ACCESSORS(Code, relocation_info, ByteArray, kRelocationInfoOffset)
 ACCESSORS(Code, handler_table, FixedArray, kHandlerTableOffset)
 ACCESSORS(Code, deoptimization_data, FixedArray, kDeoptimizationDataOffset)
@@ -5807,6 +5923,16 @@ void JSArrayBuffer::set_should_be_freed(bool value) {
 }
 
 
+bool JSArrayBuffer::is_shared() {
+  return BooleanBit::get(flag(), kIsSharedBit);
+}
+
+
+void JSArrayBuffer::set_is_shared(bool value) {
+  set_flag(BooleanBit::set(flag(), kIsSharedBit, value));
+}
+
+
 ACCESSORS(JSArrayBuffer, weak_next, Object, kWeakNextOffset)
 ACCESSORS(JSArrayBuffer, weak_first_view, Object, kWeakFirstViewOffset)
 
@@ -5834,6 +5960,8 @@ int JSRegExp::CaptureCount() {
       return 0;
     case IRREGEXP:
       return Smi::cast(DataAt(kIrregexpCaptureCountIndex))->value();
+    case LINEAR:
+      return Smi::cast(DataAt(kLinearCaptureCountIndex))->value();
     default:
       UNREACHABLE();
       return -1;
@@ -6035,8 +6163,11 @@ StringHasher::StringHasher(int length, uint32_t seed)
     raw_running_hash_(seed),
     array_index_(0),
     is_array_index_(0 < length_ && length_ <= String::kMaxArrayIndexSize),
-    is_first_char_(true) {
+    is_first_char_(true),
+    has_pending_char_(false),
+    pending_char_(0) {
   ASSERT(FLAG_randomize_hashes || raw_running_hash_ == 0);
+  STATIC_ASSERT(kBlockHashMinLength > String::kMaxArrayIndexSize);
 }
 
 
@@ -6045,6 +6176,11 @@ bool StringHasher::has_trivial_hash() {
 }
 
 
+bool StringHasher::has_block_hash() {
+  return length_ >= kBlockHashMinLength;
+}
+
+
 uint32_t StringHasher::AddCharacterCore(uint32_t running_hash, uint16_t c) {
   running_hash += c;
   running_hash += (running_hash << 10);
@@ -6064,7 +6200,35 @@ uint32_t StringHasher::GetHashCore(uint32_t running_hash) {
 }
 
 
+uint32_t StringHasher::AddBlockCore(uint32_t running_hash, uint32_t block) {
+  block *= 0xcc9e2d51;
+  block = (block << 15) | (block >> 17);
+  block *= 0x1b873593;
+  running_hash ^= block;
+  running_hash = (running_hash << 13) | (running_hash >> 19);
+  return running_hash * 5 + 0xe6546b64;
+}
+
+
+uint32_t StringHasher::GetBlockHashCore(uint32_t running_hash, int length) {
+  running_hash ^= static_cast<uint32_t>(length);
+  running_hash ^= running_hash >> 16;
+  running_hash *= 0x85ebca6b;
+  running_hash ^= running_hash >> 13;
+  running_hash *= 0xc2b2ae35;
+  running_hash ^= running_hash >> 16;
+  if ((running_hash & String::kHashBitMask) == 0) {
+    return kZeroHash;
+  }
+  return running_hash;
+}
+
+
 void StringHasher::AddCharacter(uint16_t c) {
+  if (has_block_hash()) {
+    AddBlockCharacters(&c, 1);
+    return;
+  }
   // Use the Jenkins one-at-a-time hash function to update the hash
   // for the given character.
   raw_running_hash_ = AddCharacterCore(raw_running_hash_, c);
@@ -6097,10 +6261,14 @@ bool StringHasher::UpdateIndex(uint16_t c) {
 template<typename Char>
 inline void StringHasher::AddCharacters(const Char* chars, int length) {
   ASSERT(sizeof(Char) == 1 || sizeof(Char) == 2);
+  if (has_block_hash()) {
+    AddBlockCharacters(chars, length);
+    return;
+  }
   int i = 0;
   if (is_array_index_) {
     for (; i < length; i++) {
-      AddCharacter(chars[i]);
+      raw_running_hash_ = AddCharacterCore(raw_running_hash_, chars[i]);
       if (!UpdateIndex(chars[i])) {
         i++;
         break;
@@ -6109,7 +6277,32 @@ inline void StringHasher::AddCharacters(const Char* chars, int length) {
   }
   for (; i < length; i++) {
     ASSERT(!is_array_index_);
-    AddCharacter(chars[i]);
+    raw_running_hash_ = AddCharacterCore(raw_running_hash_, chars[i]);
+  }
+}
+
+
+template<typename Char>
+inline void StringHasher::AddBlockCharacters(const Char* chars, int length) {
+  ASSERT(has_block_hash() && !is_array_index_);
+  // A block holds two UTF-16 code units, whatever the representation of
+  // the string, so that equal strings hash equally.
+  int i = 0;
+  uint32_t running_hash = raw_running_hash_;
+  if (has_pending_char_ && length > 0) {
+    running_hash = AddBlockCore(
+        running_hash, pending_char_ | (static_cast<uint32_t>(chars[0]) << 16));
+    has_pending_char_ = false;
+    i = 1;
+  }
+  for (; i + 1 < length; i += 2) {
+    running_hash = AddBlockCore(
+        running_hash, chars[i] | (static_cast<uint32_t>(chars[i + 1]) << 16));
+  }
+  raw_running_hash_ = running_hash;
+  if (i < length) {
+    pending_char_ = chars[i];
+    has_pending_char_ = true;
   }
 }
 
@@ -1100,6 +1100,8 @@ void AllocationSite::AllocationSitePrint(FILE* out) {
   Smi::FromInt(memento_found_count())->ShortPrint(out);
   PrintF(out, "\n - memento create count: ");
   Smi::FromInt(memento_create_count())->ShortPrint(out);
+  PrintF(out, "\n - survived bytes: ");
+  Smi::FromInt(survived_bytes())->ShortPrint(out);
   PrintF(out, "\n - pretenure decision: ");
   Smi::FromInt(pretenure_decision())->ShortPrint(out);
   PrintF(out, "\n - transition_info: ");
@@ -1158,6 +1160,8 @@ void Script::ScriptPrint(FILE* out) {
   eval_from_shared()->ShortPrint(out);
   PrintF(out, "\n - eval from instructions offset: ");
   eval_from_instructions_offset()->ShortPrint(out);
+  PrintF(out, "\n - lazy function data: ");
+  lazy_function_data()->ShortPrint(out);
   PrintF(out, "\n");
 }
 
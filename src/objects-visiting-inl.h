@@ -446,13 +446,18 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfo(
   }
   if (FLAG_cache_optimized_code &&
       FLAG_flush_optimized_code_cache &&
-      !shared->optimized_code_map()->IsSmi()) {
-    // Always flush the optimized code map if requested by flag.
+      !shared->optimized_code_map()->IsSmi() &&
+      shared->AgeOptimizedCodeMap() >= FLAG_optimized_code_map_max_age) {
+    // Flush the optimized code map once it has gone unused for long enough.
     shared->ClearOptimizedCodeMap();
   }
   MarkCompactCollector* collector = heap->mark_compact_collector();
   if (collector->is_code_flushing_enabled()) {
-    if (FLAG_cache_optimized_code && !shared->optimized_code_map()->IsSmi()) {
+    // A code map that survived aging is young and is kept alive entirely
+    // by visiting it as a strong field below.
+    if (FLAG_cache_optimized_code &&
+        !FLAG_flush_optimized_code_cache &&
+        !shared->optimized_code_map()->IsSmi()) {
       // Add the shared function info holding an optimized code map to
       // the code flusher for processing of code maps after marking.
       collector->code_flusher()->AddOptimizedCodeMap(shared);
@@ -714,6 +719,30 @@ inline static bool HasSourceCode(Heap* heap, SharedFunctionInfo* info) {
 }
 
 
+// With --adaptive-code-flushing code has to be older before it is flushed
+// while the code space is small, and older again for every time the code
+// of the function was flushed before. Functions that keep being flushed
+// and recompiled are eventually pinned.
+inline static bool IsOldEnoughToFlush(Heap* heap,
+                                      SharedFunctionInfo* info,
+                                      Code* code) {
+  if (!FLAG_adaptive_code_flushing) return code->IsOld();
+  int flush_count = info->flush_count();
+  if (FLAG_code_flushing_pin_threshold > 0 &&
+      flush_count >= FLAG_code_flushing_pin_threshold) {
+    return false;
+  }
+  intptr_t pressure_size =
+      static_cast<intptr_t>(FLAG_code_flushing_pressure_size) * MB;
+  int threshold = heap->code_space()->SizeOfObjects() >= pressure_size
+      ? Code::kIsOldCodeAge
+      : Code::kLastCodeAge;
+  threshold = Min(threshold + flush_count,
+                  static_cast<int>(Code::kLastCodeAge));
+  return code->GetAge() >= threshold;
+}
+
+
 template<typename StaticVisitor>
 bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
     Heap* heap, JSFunction* function) {
@@ -737,7 +766,8 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
   }
 
   // Check age of optimized code.
-  if (FLAG_age_code && !function->code()->IsOld()) {
+  if (FLAG_age_code &&
+      !IsOldEnoughToFlush(heap, shared_info, function->code())) {
     return false;
   }
 
@@ -795,7 +825,8 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
   }
 
   // Check age of code. If code aging is disabled we never flush.
-  if (!FLAG_age_code || !shared_info->code()->IsOld()) {
+  if (!FLAG_age_code ||
+      !IsOldEnoughToFlush(heap, shared_info, shared_info->code())) {
     return false;
   }
 
@@ -479,8 +479,9 @@ MaybeObject* JSProxy::GetPropertyWithHandler(Object* receiver_raw,
   if (name->IsSymbol()) return isolate->heap()->undefined_value();
 
   Handle<Object> args[] = { receiver, name };
-  Handle<Object> result = CallTrap(
-    "get", isolate->derived_get_trap(), ARRAY_SIZE(args), args);
+  Handle<Object> result = CallTrap(isolate->factory()->get_string(),
+                                   isolate->derived_get_trap(),
+                                   ARRAY_SIZE(args), args);
   if (isolate->has_pending_exception()) return Failure::Exception();
 
   return *result;
@@ -720,6 +721,7 @@ static Handle<NameDictionary> NameDictionaryAdd(Handle<NameDictionary> dict,
                                                 Handle<Name> name,
                                                 Handle<Object> value,
                                                 PropertyDetails details) {
+  dict->SetStableLoadCount(0);
   CALL_HEAP_FUNCTION(dict->GetIsolate(),
                      dict->Add(*name, *value, details),
                      NameDictionary);
@@ -810,6 +812,7 @@ Handle<Object> JSObject::DeleteNormalizedProperty(Handle<JSObject> object,
       PropertyCell::SetValueInferType(cell, value);
       dictionary->DetailsAtPut(entry, details.AsDeleted());
     } else {
+      dictionary->SetStableLoadCount(0);
       Handle<Object> deleted(dictionary->DeleteProperty(entry, mode), isolate);
       if (*deleted == isolate->heap()->true_value()) {
         Handle<NameDictionary> new_properties =
@@ -2564,6 +2567,8 @@ void Map::DeprecateTransitionTree() {
 // the current instance_descriptors to ensure proper sharing of descriptor
 // arrays.
 void Map::DeprecateTarget(Name* key, DescriptorArray* new_descriptors) {
+  // Deprecating the tree invalidates two dependent code groups per map.
+  DeoptimizationBatchScope batch(GetIsolate());
   if (HasTransitionArray()) {
     TransitionArray* transitions = this->transitions();
     int transition = transitions->Search(key);
@@ -3546,8 +3551,9 @@ bool JSProxy::HasPropertyWithHandler(Handle<JSProxy> proxy, Handle<Name> name) {
   if (name->IsSymbol()) return false;
 
   Handle<Object> args[] = { name };
-  Handle<Object> result = proxy->CallTrap(
-    "has", isolate->derived_has_trap(), ARRAY_SIZE(args), args);
+  Handle<Object> result = proxy->CallTrap(isolate->factory()->has_string(),
+                                          isolate->derived_has_trap(),
+                                          ARRAY_SIZE(args), args);
   if (isolate->has_pending_exception()) return false;
 
   return result->BooleanValue();
@@ -3566,7 +3572,9 @@ Handle<Object> JSProxy::SetPropertyWithHandler(Handle<JSProxy> proxy,
   if (name->IsSymbol()) return value;
 
   Handle<Object> args[] = { receiver, name, value };
-  proxy->CallTrap("set", isolate->derived_set_trap(), ARRAY_SIZE(args), args);
+  proxy->CallTrap(isolate->factory()->set_string(),
+                  isolate->derived_set_trap(),
+                  ARRAY_SIZE(args), args);
   if (isolate->has_pending_exception()) return Handle<Object>();
 
   return value;
@@ -3593,7 +3601,8 @@ Handle<Object> JSProxy::SetPropertyViaPrototypesWithHandler(
   *done = true;  // except where redefined...
   Handle<Object> args[] = { name };
   Handle<Object> result = proxy->CallTrap(
-      "getPropertyDescriptor", Handle<Object>(), ARRAY_SIZE(args), args);
+      isolate->factory()->get_property_descriptor_string(), Handle<Object>(),
+      ARRAY_SIZE(args), args);
   if (isolate->has_pending_exception()) return Handle<Object>();
 
   if (result->IsUndefined()) {
@@ -3684,7 +3693,8 @@ Handle<Object> JSProxy::DeletePropertyWithHandler(
 
   Handle<Object> args[] = { name };
   Handle<Object> result = proxy->CallTrap(
-      "delete", Handle<Object>(), ARRAY_SIZE(args), args);
+      isolate->factory()->delete_string(), Handle<Object>(),
+      ARRAY_SIZE(args), args);
   if (isolate->has_pending_exception()) return Handle<Object>();
 
   bool result_bool = result->BooleanValue();
@@ -3725,7 +3735,8 @@ MUST_USE_RESULT PropertyAttributes JSProxy::GetPropertyAttributeWithHandler(
 
   Handle<Object> args[] = { name };
   Handle<Object> result = CallTrap(
-    "getPropertyDescriptor", Handle<Object>(), ARRAY_SIZE(args), args);
+    isolate->factory()->get_property_descriptor_string(), Handle<Object>(),
+    ARRAY_SIZE(args), args);
   if (isolate->has_pending_exception()) return NONE;
 
   if (result->IsUndefined()) return ABSENT;
@@ -3810,15 +3821,32 @@ void JSProxy::Fix(Handle<JSProxy> proxy) {
 }
 
 
-MUST_USE_RESULT Handle<Object> JSProxy::CallTrap(const char* name,
+// Looks up a trap on a proxy handler.  Handlers are usually plain objects
+// that keep their traps as constant functions in their map, which can be
+// read directly through the descriptor lookup cache of the handler's map.
+static Handle<Object> LookupTrap(Isolate* isolate,
+                                 Handle<Object> handler,
+                                 Handle<String> trap_name) {
+  if (handler->IsJSObject() && !handler->IsJSGlobalProxy()) {
+    JSObject* object = JSObject::cast(*handler);
+    if (object->HasFastProperties() && !object->IsAccessCheckNeeded()) {
+      LookupResult lookup(isolate);
+      object->LocalLookupRealNamedProperty(*trap_name, &lookup);
+      if (lookup.IsConstant()) return handle(lookup.GetConstant(), isolate);
+    }
+  }
+  return v8::internal::GetProperty(isolate, handler, trap_name);
+}
+
+
+MUST_USE_RESULT Handle<Object> JSProxy::CallTrap(Handle<String> trap_name,
                                                  Handle<Object> derived,
                                                  int argc,
                                                  Handle<Object> argv[]) {
   Isolate* isolate = GetIsolate();
   Handle<Object> handler(this->handler(), isolate);
 
-  Handle<String> trap_name = isolate->factory()->InternalizeUtf8String(name);
-  Handle<Object> trap(v8::internal::GetProperty(isolate, handler, trap_name));
+  Handle<Object> trap = LookupTrap(isolate, handler, trap_name);
   if (isolate->has_pending_exception()) return trap;
 
   if (trap->IsUndefined()) {
@@ -6423,18 +6451,21 @@ static bool TryAccessorTransition(JSObject* self,
 static MaybeObject* CopyInsertDescriptor(Map* map,
                                          Name* name,
                                          AccessorPair* accessors,
-                                         PropertyAttributes attributes) {
+                                         PropertyAttributes attributes,
+                                         TransitionFlag flag) {
   CallbacksDescriptor new_accessors_desc(name, accessors, attributes);
-  return map->CopyInsertDescriptor(&new_accessors_desc, INSERT_TRANSITION);
+  return map->CopyInsertDescriptor(&new_accessors_desc, flag);
 }
 
 
 static Handle<Map> CopyInsertDescriptor(Handle<Map> map,
                                         Handle<Name> name,
                                         Handle<AccessorPair> accessors,
-                                        PropertyAttributes attributes) {
+                                        PropertyAttributes attributes,
+                                        TransitionFlag flag) {
   CALL_HEAP_FUNCTION(map->GetIsolate(),
-                     CopyInsertDescriptor(*map, *name, *accessors, attributes),
+                     CopyInsertDescriptor(*map, *name, *accessors, attributes,
+                                          flag),
                      Map);
 }
 
@@ -6453,6 +6484,7 @@ bool JSObject::DefineFastAccessor(Handle<JSObject> object,
     return false;
   }
 
+  TransitionFlag flag = INSERT_TRANSITION;
   // Return success if the same accessor with the same attributes already exist.
   AccessorPair* source_accessors = NULL;
   if (result.IsPropertyCallbacks()) {
@@ -6478,8 +6510,11 @@ bool JSObject::DefineFastAccessor(Handle<JSObject> object,
       // This works since descriptors are sorted in order of addition.
       ASSERT(object->map()->instance_descriptors()->
              GetKey(descriptor_number) == *name);
-      return TryAccessorTransition(*object, target, descriptor_number,
-                                   component, *accessor, attributes);
+      if (TryAccessorTransition(*object, target, descriptor_number,
+                                component, *accessor, attributes)) {
+        return true;
+      }
+      flag = OMIT_TRANSITION;
     }
   } else {
     // If not, lookup a transition.
@@ -6491,20 +6526,27 @@ bool JSObject::DefineFastAccessor(Handle<JSObject> object,
       int descriptor_number = target->LastAdded();
       ASSERT(target->instance_descriptors()->GetKey(descriptor_number)
              ->Equals(*name));
-      return TryAccessorTransition(*object, target, descriptor_number,
-                                   component, *accessor, attributes);
+      if (TryAccessorTransition(*object, target, descriptor_number,
+                                component, *accessor, attributes)) {
+        return true;
+      }
+      flag = OMIT_TRANSITION;
     }
   }
 
   // If there is no transition yet, add a transition to the a new accessor pair
   // containing the accessor.  Allocate a new pair if there were no source
-  // accessors.  Otherwise, copy the pair and modify the accessor.
+  // accessors.  Otherwise, copy the pair and modify the accessor. If the
+  // existing transition holds a different accessor, copy the map without a
+  // transition: the object keeps fast properties instead of being
+  // normalized.
   Handle<AccessorPair> accessors = source_accessors != NULL
       ? AccessorPair::Copy(Handle<AccessorPair>(source_accessors))
       : isolate->factory()->NewAccessorPair();
   accessors->set(component, *accessor);
   Handle<Map> new_map = CopyInsertDescriptor(Handle<Map>(object->map()),
-                                             name, accessors, attributes);
+                                             name, accessors, attributes,
+                                             flag);
   object->set_map(*new_map);
   return true;
 }
@@ -8961,8 +9003,10 @@ bool String::SlowEquals(String* other) {
   // before we try to flatten the strings.
   if (this->Get(0) != other->Get(0)) return false;
 
-  String* lhs = this->TryFlattenGetString();
-  String* rhs = other->TryFlattenGetString();
+  // Ropes are compared leaf by leaf below, flattening them would copy both
+  // strings only to read them once.
+  String* lhs = this->IsFlat() ? this->TryFlattenGetString() : this;
+  String* rhs = other->IsFlat() ? other->TryFlattenGetString() : other;
 
   // TODO(dcarney): Compare all types of flat strings with a Visitor.
   if (StringShape(lhs).IsSequentialAscii() &&
@@ -9234,6 +9278,14 @@ uint32_t StringHasher::GetHashField() {
     if (is_array_index_) {
       return MakeArrayIndexHash(array_index_, length_);
     }
+    if (has_block_hash()) {
+      uint32_t running_hash = raw_running_hash_;
+      if (has_pending_char_) {
+        running_hash = AddBlockCore(running_hash, pending_char_);
+      }
+      return (GetBlockHashCore(running_hash, length_) << String::kHashShift) |
+             String::kIsNotArrayIndexMask;
+    }
     return (GetHashCore(raw_running_hash_) << String::kHashShift) |
            String::kIsNotArrayIndexMask;
   } else {
@@ -9254,12 +9306,46 @@ uint32_t StringHasher::ComputeUtf8Hash(Vector<const char> chars,
     *utf16_length_out = vector_length;
     return HashSequentialString(chars.start(), vector_length, seed);
   }
+  const uint8_t* stream = reinterpret_cast<const uint8_t*>(chars.start());
+  int utf16_length = 0;
+  if (vector_length >= kBlockHashMinLength) {
+    // Which hash applies depends on the utf16 length, count it up front.
+    unsigned remaining = static_cast<unsigned>(vector_length);
+    const uint8_t* cursor = stream;
+    while (remaining > 0) {
+      unsigned consumed = 0;
+      uint32_t c = unibrow::Utf8::ValueOf(cursor, remaining, &consumed);
+      cursor += consumed;
+      remaining -= consumed;
+      utf16_length +=
+          (c > unibrow::Utf16::kMaxNonSurrogateCharCode) ? 2 : 1;
+    }
+    *utf16_length_out = utf16_length;
+    StringHasher hasher(utf16_length, seed);
+    if (!hasher.has_block_hash() || hasher.has_trivial_hash()) {
+      // Fall through to the one-at-a-time hash below.
+      utf16_length = 0;
+    } else {
+      remaining = static_cast<unsigned>(vector_length);
+      while (remaining > 0) {
+        unsigned consumed = 0;
+        uint32_t c = unibrow::Utf8::ValueOf(stream, remaining, &consumed);
+        stream += consumed;
+        remaining -= consumed;
+        if (c > unibrow::Utf16::kMaxNonSurrogateCharCode) {
+          hasher.AddCharacter(unibrow::Utf16::LeadSurrogate(c));
+          hasher.AddCharacter(unibrow::Utf16::TrailSurrogate(c));
+        } else {
+          hasher.AddCharacter(c);
+        }
+      }
+      return hasher.GetHashField();
+    }
+  }
   // Start with a fake length which won't affect computation.
   // It will be updated later.
   StringHasher hasher(String::kMaxArrayIndexSize, seed);
   unsigned remaining = static_cast<unsigned>(vector_length);
-  const uint8_t* stream = reinterpret_cast<const uint8_t*>(chars.start());
-  int utf16_length = 0;
   bool is_index = true;
   ASSERT(hasher.is_array_index_);
   while (remaining > 0) {
@@ -9406,6 +9492,23 @@ void Map::ClearNonLiveTransitions(Heap* heap) {
 }
 
 
+void Map::ShrinkPrototypeTransitions(Heap* heap) {
+  static const int kMinCapacityToShrink = 8;
+  FixedArray* cache = GetPrototypeTransitions();
+  const int header = kProtoTransitionHeaderSize;
+  const int step = kProtoTransitionElementsPerEntry;
+  int capacity = (cache->length() - header) / step;
+  int number_of_transitions = NumberOfProtoTransitions();
+  if (capacity < kMinCapacityToShrink ||
+      number_of_transitions * 4 > capacity) {
+    return;
+  }
+  // Leave as much room as PutPrototypeTransition would after growing.
+  int new_length = header + number_of_transitions * 2 * step;
+  RightTrimFixedArray<FROM_GC>(heap, cache, cache->length() - new_length);
+}
+
+
 int Map::Hash() {
   // For performance reasons we only hash the 3 most variable fields of a map:
   // constructor, prototype and bit_field2.
@@ -9544,13 +9647,14 @@ MaybeObject* SharedFunctionInfo::AddToOptimizedCodeMap(Context* native_context,
   if (value->IsSmi()) {
     // No optimized code map.
     ASSERT_EQ(0, Smi::cast(value)->value());
-    // Create 3 entries per context {context, code, literals}.
+    // Create 4 entries per context {context, code, literals, osr ast id}.
     MaybeObject* maybe = heap->AllocateFixedArray(kInitialLength);
     if (!maybe->To(&new_code_map)) return maybe;
     new_code_map->set(kEntriesStart + kContextOffset, native_context);
     new_code_map->set(kEntriesStart + kCachedCodeOffset, code);
     new_code_map->set(kEntriesStart + kLiteralsOffset, literals);
     new_code_map->set(kEntriesStart + kOsrAstIdOffset, osr_ast_id_smi);
+    new_code_map->set(kAgeIndex, Smi::FromInt(0));
   } else {
     // Copy old map and append one new entry.
     FixedArray* old_code_map = FixedArray::cast(value);
@@ -9563,6 +9667,7 @@ MaybeObject* SharedFunctionInfo::AddToOptimizedCodeMap(Context* native_context,
     new_code_map->set(old_length + kCachedCodeOffset, code);
     new_code_map->set(old_length + kLiteralsOffset, literals);
     new_code_map->set(old_length + kOsrAstIdOffset, osr_ast_id_smi);
+    new_code_map->set(kAgeIndex, Smi::FromInt(0));
     // Zap the old map for the sake of the heap verifier.
     if (Heap::ShouldZapGarbage()) {
       Object** data = old_code_map->data_start();
@@ -10232,6 +10337,7 @@ int SharedFunctionInfo::SearchOptimizedCodeMap(Context* native_context,
     for (int i = kEntriesStart; i < length; i += kEntryLength) {
       if (optimized_code_map->get(i + kContextOffset) == native_context &&
           optimized_code_map->get(i + kOsrAstIdOffset) == osr_ast_id_smi) {
+        optimized_code_map->set(kAgeIndex, Smi::FromInt(0));
         return i + kCachedCodeOffset;
       }
     }
@@ -10346,11 +10452,13 @@ void Code::InvalidateEmbeddedObjects() {
 }
 
 
-void Code::Relocate(intptr_t delta) {
+void Code::Relocate(intptr_t delta, ICacheFlushMode icache_flush_mode) {
   for (RelocIterator it(this, RelocInfo::kApplyMask); !it.done(); it.next()) {
-    it.rinfo()->apply(delta);
+    it.rinfo()->apply(delta, SKIP_ICACHE_FLUSH);
+  }
+  if (icache_flush_mode != SKIP_ICACHE_FLUSH) {
+    CPU::FlushICache(instruction_start(), instruction_size());
   }
-  CPU::FlushICache(instruction_start(), instruction_size());
 }
 
 
@@ -10997,6 +11105,13 @@ void DeoptimizationInputData::DeoptimizationInputDataPrint(FILE* out) {
           break;
         }
 
+        case Translation::STACK_HANDLER_SLOT: {
+          int slot = iterator.Next();
+          int handler_index = iterator.Next();
+          PrintF(out, "{slot=%d, handler=%d}", slot, handler_index);
+          break;
+        }
+
         case Translation::LITERAL: {
           unsigned literal_index = iterator.Next();
           PrintF(out, "{literal_id=%u}", literal_index);
@@ -11530,9 +11645,20 @@ Handle<Map> Map::PutPrototypeTransition(Handle<Map> map,
   int capacity = (cache->length() - header) / step;
   int transitions = map->NumberOfProtoTransitions() + 1;
 
-  if (transitions > capacity) {
-    if (capacity > kMaxCachedPrototypeTransitions) return map;
-
+  if (transitions > capacity && capacity > kMaxCachedPrototypeTransitions) {
+    // Entries are appended, so the first half of a full cache holds the
+    // oldest ones.  Evict those rather than refusing to cache any more.
+    int number_of_transitions = map->NumberOfProtoTransitions();
+    int evicted = number_of_transitions - number_of_transitions / 2;
+    int kept_end = header + (number_of_transitions - evicted) * step;
+    for (int i = header; i < kept_end; i++) {
+      cache->set(i, cache->get(i + evicted * step));
+    }
+    for (int i = kept_end; i < header + number_of_transitions * step; i++) {
+      cache->set_undefined(i);
+    }
+    map->SetNumberOfProtoTransitions(number_of_transitions - evicted);
+  } else if (transitions > capacity) {
     // Grow array by factor 2 over and above what we need.
     Factory* factory = map->GetIsolate()->factory();
     cache = factory->CopySizeFixedArray(cache, transitions * 2 * step + header);
@@ -11780,7 +11906,7 @@ void DependentCode::DeoptimizeDependentCodeGroup(
   DisallowHeapAllocation no_allocation_scope;
   bool marked = MarkCodeForDeoptimization(isolate, group);
 
-  if (marked) Deoptimizer::DeoptimizeMarkedCode(isolate);
+  if (marked) Deoptimizer::ScheduleDeoptimizeMarkedCode(isolate);
 }
 
 
@@ -13903,6 +14029,7 @@ MaybeObject* SubStringKey<uint16_t>::AsObject(
 
 template<>
 bool SubStringKey<uint8_t>::IsMatch(Object* string) {
+  if (!StringHashMayMatch(string, hash_field_)) return false;
   Vector<const uint8_t> chars(GetChars() + from_, length_);
   return String::cast(string)->IsOneByteEqualTo(chars);
 }
@@ -13910,6 +14037,7 @@ bool SubStringKey<uint8_t>::IsMatch(Object* string) {
 
 template<>
 bool SubStringKey<uint16_t>::IsMatch(Object* string) {
+  if (!StringHashMayMatch(string, hash_field_)) return false;
   Vector<const uint16_t> chars(GetChars() + from_, length_);
   return String::cast(string)->IsTwoByteEqualTo(chars);
 }
@@ -15936,6 +16064,231 @@ void ObjectHashTable::RemoveEntry(int entry) {
 }
 
 
+template<class Derived, int entrysize>
+Handle<Derived> OrderedHashTable<Derived, entrysize>::Allocate(
+    Isolate* isolate, int capacity, PretenureFlag pretenure) {
+  // Capacity must be a power of two, since we depend on being able
+  // to divide and multiply by 2 (kLoadFactor) to derive capacity
+  // from number of buckets. If we decide to change kLoadFactor
+  // to something other than 2, capacity should be stored as another
+  // field of this object.
+  capacity = RoundUpToPowerOf2(Max(kMinCapacity, capacity));
+  if (capacity > kMaxCapacity) {
+    v8::internal::Heap::FatalProcessOutOfMemory("invalid table size", true);
+  }
+  int num_buckets = capacity / kLoadFactor;
+  Handle<FixedArray> backing_store = isolate->factory()->NewFixedArray(
+      kHashTableStartIndex + num_buckets + (capacity * kEntrySize),
+      pretenure);
+  Handle<Derived> table = Handle<Derived>::cast(backing_store);
+  for (int i = 0; i < num_buckets; ++i) {
+    table->set(table->BucketToIndex(i), Smi::FromInt(kNotFound));
+  }
+  table->SetNumberOfBuckets(num_buckets);
+  table->SetNumberOfElements(0);
+  table->SetNumberOfDeletedElements(0);
+  return table;
+}
+
+
+template<class Derived, int entrysize>
+Handle<Derived> OrderedHashTable<Derived, entrysize>::EnsureGrowable(
+    Handle<Derived> table) {
+  int capacity = table->Capacity();
+  if (table->UsedCapacity() < capacity) return table;
+  // Compact a table that is at least half holes, grow it otherwise.
+  if (table->NumberOfDeletedElements() >= capacity / 2) {
+    table->RehashInPlace();
+    return table;
+  }
+  return Rehash(table, capacity * 2);
+}
+
+
+template<class Derived, int entrysize>
+Handle<Derived> OrderedHashTable<Derived, entrysize>::Shrink(
+    Handle<Derived> table) {
+  int capacity = table->Capacity();
+  if (capacity <= kMinCapacity) return table;
+  if (table->NumberOfElements() >= capacity / 4) return table;
+  return Rehash(table, capacity / 2);
+}
+
+
+template<class Derived, int entrysize>
+Handle<Derived> OrderedHashTable<Derived, entrysize>::Rehash(
+    Handle<Derived> table, int new_capacity) {
+  Isolate* isolate = table->GetIsolate();
+  Handle<Derived> new_table = Allocate(
+      isolate,
+      new_capacity,
+      isolate->heap()->InNewSpace(*table) ? NOT_TENURED : TENURED);
+
+  DisallowHeapAllocation no_gc;
+  int used = table->UsedCapacity();
+  int new_entry = 0;
+  for (int old_entry = 0; old_entry < used; ++old_entry) {
+    Object* key = table->KeyAt(old_entry);
+    if (key->IsTheHole()) continue;
+    int bucket = new_table->HashToBucket(Smi::cast(key->GetHash())->value());
+    int old_index = table->EntryToIndex(old_entry);
+    int new_index = new_table->EntryToIndex(new_entry);
+    for (int i = 0; i < entrysize; ++i) {
+      new_table->set(new_index + i, table->get(old_index + i));
+    }
+    new_table->set(new_index + kChainOffset,
+                   new_table->get(new_table->BucketToIndex(bucket)));
+    new_table->set(new_table->BucketToIndex(bucket), Smi::FromInt(new_entry));
+    ++new_entry;
+  }
+  new_table->SetNumberOfElements(table->NumberOfElements());
+  return new_table;
+}
+
+
+template<class Derived, int entrysize>
+void OrderedHashTable<Derived, entrysize>::RehashInPlace() {
+  DisallowHeapAllocation no_gc;
+  int num_buckets = NumberOfBuckets();
+  for (int bucket = 0; bucket < num_buckets; ++bucket) {
+    set(BucketToIndex(bucket), Smi::FromInt(kNotFound));
+  }
+  // Live entries only ever move towards the front, so they can be copied
+  // in order over the holes in front of them.
+  int used = UsedCapacity();
+  int new_entry = 0;
+  for (int old_entry = 0; old_entry < used; ++old_entry) {
+    Object* key = KeyAt(old_entry);
+    if (key->IsTheHole()) continue;
+    int bucket = HashToBucket(Smi::cast(key->GetHash())->value());
+    int old_index = EntryToIndex(old_entry);
+    int new_index = EntryToIndex(new_entry);
+    if (new_index != old_index) {
+      for (int i = 0; i < entrysize; ++i) {
+        set(new_index + i, get(old_index + i));
+      }
+    }
+    set(new_index + kChainOffset, get(BucketToIndex(bucket)));
+    set(BucketToIndex(bucket), Smi::FromInt(new_entry));
+    ++new_entry;
+  }
+  for (int index = EntryToIndex(new_entry); index < EntryToIndex(used);
+       ++index) {
+    set_the_hole(index);
+  }
+  SetNumberOfDeletedElements(0);
+}
+
+
+template<class Derived, int entrysize>
+int OrderedHashTable<Derived, entrysize>::FindEntry(Object* key) {
+  ASSERT(!key->IsTheHole());
+  // If the object does not have an identity hash, it was never used as a key.
+  Object* hash = key->GetHash();
+  if (hash->IsUndefined()) return kNotFound;
+  int bucket = HashToBucket(Smi::cast(hash)->value());
+  for (int entry = Smi::cast(get(BucketToIndex(bucket)))->value();
+       entry != kNotFound;
+       entry = ChainAt(entry)) {
+    if (KeyAt(entry)->SameValue(key)) return entry;
+  }
+  return kNotFound;
+}
+
+
+template<class Derived, int entrysize>
+int OrderedHashTable<Derived, entrysize>::AddEntry(int hash) {
+  ASSERT(UsedCapacity() < Capacity());
+  int entry = UsedCapacity();
+  int bucket = HashToBucket(hash);
+  int index = EntryToIndex(entry);
+  set(index + kChainOffset, get(BucketToIndex(bucket)));
+  set(BucketToIndex(bucket), Smi::FromInt(entry));
+  SetNumberOfElements(NumberOfElements() + 1);
+  return index;
+}
+
+
+template<class Derived, int entrysize>
+void OrderedHashTable<Derived, entrysize>::RemoveEntry(int entry) {
+  int index = EntryToIndex(entry);
+  for (int i = 0; i < entrysize; ++i) {
+    set_the_hole(index + i);
+  }
+  SetNumberOfElements(NumberOfElements() - 1);
+  SetNumberOfDeletedElements(NumberOfDeletedElements() + 1);
+}
+
+
+template class OrderedHashTable<OrderedHashSet, 1>;
+template class OrderedHashTable<OrderedHashMap, 2>;
+
+
+bool OrderedHashSet::Contains(Object* key) {
+  return FindEntry(key) != kNotFound;
+}
+
+
+Handle<OrderedHashSet> OrderedHashSet::Add(Handle<OrderedHashSet> table,
+                                           Handle<Object> key) {
+  // Make sure the key object has an identity hash code.
+  Handle<Object> hash = Object::GetOrCreateHash(key, table->GetIsolate());
+
+  // Check whether key is already present.
+  if (table->FindEntry(*key) != kNotFound) return table;
+
+  table = EnsureGrowable(table);
+  int index = table->AddEntry(Handle<Smi>::cast(hash)->value());
+  table->set(index, *key);
+  return table;
+}
+
+
+Handle<OrderedHashSet> OrderedHashSet::Remove(Handle<OrderedHashSet> table,
+                                              Handle<Object> key) {
+  int entry = table->FindEntry(*key);
+  if (entry == kNotFound) return table;
+  table->RemoveEntry(entry);
+  return Shrink(table);
+}
+
+
+Object* OrderedHashMap::Lookup(Object* key) {
+  int entry = FindEntry(key);
+  if (entry == kNotFound) return GetHeap()->the_hole_value();
+  return ValueAt(entry);
+}
+
+
+Handle<OrderedHashMap> OrderedHashMap::Put(Handle<OrderedHashMap> table,
+                                           Handle<Object> key,
+                                           Handle<Object> value) {
+  // Check whether to perform removal operation.
+  if (value->IsTheHole()) {
+    int entry = table->FindEntry(*key);
+    if (entry == kNotFound) return table;
+    table->RemoveEntry(entry);
+    return Shrink(table);
+  }
+
+  // Make sure the key object has an identity hash code.
+  Handle<Object> hash = Object::GetOrCreateHash(key, table->GetIsolate());
+
+  // Key is already in table, just overwrite value.
+  int entry = table->FindEntry(*key);
+  if (entry != kNotFound) {
+    table->set(table->EntryToIndex(entry) + kValueOffset, *value);
+    return table;
+  }
+
+  table = EnsureGrowable(table);
+  int index = table->AddEntry(Handle<Smi>::cast(hash)->value());
+  table->set(index, *key);
+  table->set(index + kValueOffset, *value);
+  return table;
+}
+
+
 Object* WeakHashTable::Lookup(Object* key) {
   ASSERT(IsKey(key));
   int entry = FindEntry(key);
@@ -92,6 +92,9 @@
 //             - CompilationCacheTable
 //             - CodeCacheHashTable
 //             - MapCache
+//           - OrderedHashTable
+//             - OrderedHashSet
+//             - OrderedHashMap
 //           - Context
 //           - JSFunctionResultCache
 //           - ScopeInfo
@@ -240,6 +243,11 @@ static inline bool IsGrowStoreMode(KeyedAccessStoreMode store_mode) {
 enum WriteBarrierMode { SKIP_WRITE_BARRIER, UPDATE_WRITE_BARRIER };
 
 
+// Code patching that skips the instruction cache flush if mode is
+// SKIP_ICACHE_FLUSH.  The caller is then responsible for flushing.
+enum ICacheFlushMode { FLUSH_ICACHE_IF_NEEDED, SKIP_ICACHE_FLUSH };
+
+
 // Indicates whether a value can be loaded as a constant.
 enum StoreMode {
   ALLOW_AS_CONSTANT,
@@ -2721,6 +2729,10 @@ class JSObject: public JSReceiver {
   // its size by more than the 1 entry necessary, so sequentially adding fields
   // to the same object requires fewer allocations and copies.
   static const int kFieldsAdded = 3;
+  // Object literal maps whose instances were observed to grow beyond their
+  // in-object capacity are replaced by maps with this many extra in-object
+  // fields (see Factory::ObjectLiteralMapFromCache).
+  static const int kLiteralSlackProperties = 4;
 
   // Layout description.
   static const int kPropertiesOffset = HeapObject::kHeaderSize;
@@ -3484,6 +3496,13 @@ class DescriptorArray: public FixedArray {
     return ToKeyIndex(number_of_descriptors);
   }
 
+  // Returns the fixed array index of the value of a descriptor.
+  static int ToValueIndex(int descriptor_number) {
+    return kFirstIndex +
+           (descriptor_number * kDescriptorSize) +
+           kDescriptorValue;
+  }
+
  private:
   // An entry in a DescriptorArray, represented as an (array, index) pair.
   class Entry {
@@ -3512,12 +3531,6 @@ class DescriptorArray: public FixedArray {
            kDescriptorDetails;
   }
 
-  static int ToValueIndex(int descriptor_number) {
-    return kFirstIndex +
-           (descriptor_number * kDescriptorSize) +
-           kDescriptorValue;
-  }
-
   // Swap first and second descriptor.
   inline void SwapSortedKeys(int first, int second);
 
@@ -4018,6 +4031,22 @@ class NameDictionary: public Dictionary<NameDictionaryShape, Name*> {
   // Find entry for key, otherwise return kNotFound. Optimized version of
   // HashTable::FindEntry.
   int FindEntry(Name* key);
+
+  // Number of named load misses on the owner of this dictionary since a
+  // property was last added or deleted.  Used to turn objects that no
+  // longer change shape back into fast mode.
+  int StableLoadCount() {
+    Object* count = get(kStableLoadCountIndex);
+    return count->IsSmi() ? Smi::cast(count)->value() : 0;
+  }
+  void SetStableLoadCount(int count) {
+    set(kStableLoadCountIndex, Smi::FromInt(count));
+  }
+
+ private:
+  // Name dictionaries do not track a maximum number key, so they reuse
+  // that prefix slot.
+  static const int kStableLoadCountIndex = kMaxNumberKeyIndex;
 };
 
 
@@ -4215,6 +4244,178 @@ class ObjectHashTable: public HashTable<ObjectHashTableShape<2>, Object*> {
 };
 
 
+// OrderedHashTable is a hash table with Object keys that preserves
+// insertion order.  It is the backing store of JSMap and JSSet, through the
+// OrderedHashMap and OrderedHashSet interfaces below.  Keys are compared
+// with Object::SameValue() and hashed with the identity hash of the key.
+//
+// This is a deterministic hash table: entries are stored in insertion
+// order in a data table and every bucket of the hash table holds the index
+// of the first entry of a chain through the data table, so lookups never
+// probe through unrelated entries.  Removed entries leave a hole in the
+// data table until the table is rehashed; a table that runs out of room
+// and is at least half holes is compacted in place instead of grown.
+//
+// Memory layout:
+//   [0]: number of buckets
+//   [1]: number of elements
+//   [2]: number of deleted elements
+//   [3..(3 + NumberOfBuckets() - 1)]: the buckets, each the entry index of
+//       the first entry in its chain or kNotFound
+//   [3 + NumberOfBuckets()..length]: the data table, Capacity() entries of
+//       kEntrySize slots each.  The first entrysize slots of an entry are
+//       managed by the derived class and the slot at kChainOffset holds the
+//       index of the next entry in the same bucket.
+template<class Derived, int entrysize>
+class OrderedHashTable: public FixedArray {
+ public:
+  // Returns an OrderedHashTable with a capacity of at least |capacity|.
+  static Handle<Derived> Allocate(Isolate* isolate,
+                                  int capacity,
+                                  PretenureFlag pretenure = NOT_TENURED);
+
+  // Returns a table with room for at least one more entry, either this one
+  // compacted or a new, larger one.
+  static Handle<Derived> EnsureGrowable(Handle<Derived> table);
+
+  // Returns a smaller table if this one has become sparse.
+  static Handle<Derived> Shrink(Handle<Derived> table);
+
+  int NumberOfElements() {
+    return Smi::cast(get(kNumberOfElementsIndex))->value();
+  }
+
+  int NumberOfDeletedElements() {
+    return Smi::cast(get(kNumberOfDeletedElementsIndex))->value();
+  }
+
+  int NumberOfBuckets() {
+    return Smi::cast(get(kNumberOfBucketsIndex))->value();
+  }
+
+  int Capacity() {
+    return NumberOfBuckets() * kLoadFactor;
+  }
+
+  // Entries below UsedCapacity() are live or, if their key is the hole,
+  // deleted.
+  int UsedCapacity() {
+    return NumberOfElements() + NumberOfDeletedElements();
+  }
+
+  // Returns the entry for |key| or kNotFound.
+  int FindEntry(Object* key);
+
+  // Appends an entry for a key with the given hash and returns the index
+  // of its first slot.  The table must have room for it.
+  int AddEntry(int hash);
+
+  void RemoveEntry(int entry);
+
+  int EntryToIndex(int entry) {
+    return kHashTableStartIndex + NumberOfBuckets() + (entry * kEntrySize);
+  }
+
+  Object* KeyAt(int entry) {
+    return get(EntryToIndex(entry));
+  }
+
+  static const int kNotFound = -1;
+  static const int kMinCapacity = 4;
+
+ private:
+  static const int kNumberOfBucketsIndex = 0;
+  static const int kNumberOfElementsIndex = kNumberOfBucketsIndex + 1;
+  static const int kNumberOfDeletedElementsIndex = kNumberOfElementsIndex + 1;
+  static const int kHashTableStartIndex = kNumberOfDeletedElementsIndex + 1;
+
+  static const int kEntrySize = entrysize + 1;
+  static const int kChainOffset = entrysize;
+
+  static const int kLoadFactor = 2;
+  static const int kMaxCapacity =
+      (FixedArray::kMaxLength - kHashTableStartIndex) /
+      (1 + (kEntrySize * kLoadFactor));
+
+  static Handle<Derived> Rehash(Handle<Derived> table, int new_capacity);
+
+  // Removes the holes left by deleted entries without reallocating.
+  void RehashInPlace();
+
+  void SetNumberOfBuckets(int num) {
+    set(kNumberOfBucketsIndex, Smi::FromInt(num));
+  }
+
+  void SetNumberOfElements(int num) {
+    set(kNumberOfElementsIndex, Smi::FromInt(num));
+  }
+
+  void SetNumberOfDeletedElements(int num) {
+    set(kNumberOfDeletedElementsIndex, Smi::FromInt(num));
+  }
+
+  int HashToBucket(int hash) {
+    return hash & (NumberOfBuckets() - 1);
+  }
+
+  int BucketToIndex(int bucket) {
+    return kHashTableStartIndex + bucket;
+  }
+
+  int ChainAt(int entry) {
+    return Smi::cast(get(EntryToIndex(entry) + kChainOffset))->value();
+  }
+};
+
+
+// OrderedHashSet holds keys that are arbitrary objects in insertion order.
+class OrderedHashSet: public OrderedHashTable<OrderedHashSet, 1> {
+ public:
+  static OrderedHashSet* cast(Object* obj) {
+    ASSERT(obj->IsFixedArray());
+    return reinterpret_cast<OrderedHashSet*>(obj);
+  }
+
+  bool Contains(Object* key);
+
+  // Adds the given key to this hash set.
+  static Handle<OrderedHashSet> Add(Handle<OrderedHashSet> table,
+                                    Handle<Object> key);
+
+  // Removes the given key from this hash set.
+  static Handle<OrderedHashSet> Remove(Handle<OrderedHashSet> table,
+                                       Handle<Object> key);
+};
+
+
+// OrderedHashMap maps keys that are arbitrary objects to object values and
+// remembers the insertion order of the keys.
+class OrderedHashMap: public OrderedHashTable<OrderedHashMap, 2> {
+ public:
+  static OrderedHashMap* cast(Object* obj) {
+    ASSERT(obj->IsFixedArray());
+    return reinterpret_cast<OrderedHashMap*>(obj);
+  }
+
+  // Looks up the value associated with the given key. The hole value is
+  // returned in case the key is not present.
+  Object* Lookup(Object* key);
+
+  // Adds (or overwrites) the value associated with the given key. Mapping a
+  // key to the hole value causes removal of the whole entry.
+  static Handle<OrderedHashMap> Put(Handle<OrderedHashMap> table,
+                                    Handle<Object> key,
+                                    Handle<Object> value);
+
+  Object* ValueAt(int entry) {
+    return get(EntryToIndex(entry) + kValueOffset);
+  }
+
+ private:
+  static const int kValueOffset = 1;
+};
+
+
 template <int entrysize>
 class WeakHashTableShape : public BaseShape<Object*> {
  public:
@@ -5228,6 +5429,12 @@ class Code: public HeapObject {
   inline int prologue_offset();
   inline void set_prologue_offset(int offset);
 
+  // [creation_time]: For FUNCTION kind, milliseconds since isolate
+  // initialization at which the unoptimized code was generated.  Used for
+  // the tier-up latency histograms.
+  inline int creation_time();
+  inline void set_creation_time(int time);
+
   // Unchecked accessors to be used during GC.
   inline ByteArray* unchecked_relocation_info();
 
@@ -5429,7 +5636,8 @@ class Code: public HeapObject {
 
   // Relocate the code by delta bytes. Called to signal that this code
   // object has been moved by delta bytes.
-  void Relocate(intptr_t delta);
+  void Relocate(intptr_t delta,
+                ICacheFlushMode icache_flush_mode = FLUSH_ICACHE_IF_NEEDED);
 
   // Migrate code described by desc.
   void CopyFrom(const CodeDesc& desc);
@@ -5540,8 +5748,9 @@ class Code: public HeapObject {
   // Note: We might be able to squeeze this into the flags above.
   static const int kPrologueOffset = kKindSpecificFlags2Offset + kIntSize;
   static const int kConstantPoolOffset = kPrologueOffset + kPointerSize;
+  static const int kCreationTimeOffset = kConstantPoolOffset + kPointerSize;
 
-  static const int kHeaderPaddingStart = kConstantPoolOffset + kIntSize;
+  static const int kHeaderPaddingStart = kCreationTimeOffset + kIntSize;
 
   // Add padding to align the instruction start following right after
   // the Code object header.
@@ -6263,6 +6472,10 @@ class Map: public HeapObject {
   // again while following back pointers.
   void ClearNonLiveTransitions(Heap* heap);
 
+  // Releases the unused tail of the prototype transitions cache when most
+  // of its entries were cleared by the GC.
+  void ShrinkPrototypeTransitions(Heap* heap);
+
   // Computes a hash value for this map, to be used in HashTables and such.
   int Hash();
 
@@ -6538,6 +6751,11 @@ class Script: public Struct {
   // [flags]: Holds an exciting bitfield.
   DECL_ACCESSORS(flags, Smi)
 
+  // [lazy_function_data]: undefined or a ByteArray holding the preparse
+  // results of inner functions that were skipped while a function of this
+  // script was compiled lazily (see --cache-lazy-function-data).
+  DECL_ACCESSORS(lazy_function_data, Object)
+
   // [compilation_type]: how the the script was compiled. Encoded in the
   // 'flags' field.
   inline CompilationType compilation_type();
@@ -6578,7 +6796,8 @@ class Script: public Struct {
       kEvalFromSharedOffset + kPointerSize;
   static const int kFlagsOffset =
       kEvalFrominstructionsOffsetOffset + kPointerSize;
-  static const int kSize = kFlagsOffset + kPointerSize;
+  static const int kLazyFunctionDataOffset = kFlagsOffset + kPointerSize;
+  static const int kSize = kLazyFunctionDataOffset + kPointerSize;
 
  private:
   // Bit positions in the flags field.
@@ -6680,9 +6899,14 @@ class SharedFunctionInfo: public HeapObject {
                                     Handle<FixedArray> literals,
                                     BailoutId osr_ast_id);
 
+  // Returns the number of major GCs the optimized code map has survived
+  // since it was last used, and counts the current one.
+  inline int AgeOptimizedCodeMap();
+
   // Layout description of the optimized code map.
   static const int kNextMapIndex = 0;
-  static const int kEntriesStart = 1;
+  static const int kAgeIndex = 1;
+  static const int kEntriesStart = 2;
   static const int kContextOffset = 0;
   static const int kCachedCodeOffset = 1;
   static const int kLiteralsOffset = 2;
@@ -6694,6 +6918,8 @@ class SharedFunctionInfo: public HeapObject {
       (kEntriesStart + kCachedCodeOffset) * kPointerSize;
   static const int kFirstOsrAstIdSlot = FixedArray::kHeaderSize +
       (kEntriesStart + kOsrAstIdOffset) * kPointerSize;
+  static const int kAgeSlot = FixedArray::kHeaderSize +
+      kAgeIndex * kPointerSize;
   static const int kSecondEntryIndex = kEntryLength + kEntriesStart;
   static const int kInitialLength = kEntriesStart + kEntryLength;
 
@@ -6981,6 +7207,18 @@ class SharedFunctionInfo: public HeapObject {
   // Indicates that this function is a generator.
   DECL_BOOLEAN_ACCESSORS(is_generator)
 
+  // Indicates that the inner functions of this function are preparsed
+  // rather than fully parsed whenever the function itself is parsed. Set
+  // once when the shared function info is created, so that every parse of
+  // the function agrees on the allocation of its variables.
+  DECL_BOOLEAN_ACCESSORS(lazy_inner_functions)
+
+  // Indicates that the function cannot observe the actual number of
+  // arguments it was called with, so callers that pass too few arguments
+  // may pad them with undefined themselves instead of going through the
+  // arguments adaptor. Only meaningful once the function is compiled.
+  DECL_BOOLEAN_ACCESSORS(dont_need_arguments_adaptation)
+
   // Indicates whether or not the code in the shared function support
   // deoptimization.
   inline bool has_deoptimization_support();
@@ -7017,9 +7255,14 @@ class SharedFunctionInfo: public HeapObject {
   inline void set_opt_reenable_tries(int value);
   inline int opt_reenable_tries();
 
+  // Number of times the code of the function was flushed, saturating.
+  inline int flush_count();
+  inline void increment_flush_count();
+
   inline void TryReenableOptimization();
 
-  // Stores deopt_count, opt_reenable_tries and ic_age as bit-fields.
+  // Stores deopt_count, opt_reenable_tries, flush_count and ic_age as
+  // bit-fields.
   inline void set_counters(int value);
   inline int counters();
 
@@ -7197,11 +7440,14 @@ class SharedFunctionInfo: public HeapObject {
     kDontCache,
     kDontFlush,
     kIsGenerator,
+    kLazyInnerFunctions,
+    kDontNeedArgumentsAdaptation,
     kCompilerHintsCount  // Pseudo entry
   };
 
   class DeoptCountBits: public BitField<int, 0, 4> {};
-  class OptReenableTriesBits: public BitField<int, 4, 18> {};
+  class OptReenableTriesBits: public BitField<int, 4, 14> {};
+  class FlushCountBits: public BitField<int, 18, 4> {};
   class ICAgeBits: public BitField<int, 22, 8> {};
 
   class OptCountBits: public BitField<int, 0, 22> {};
@@ -7832,7 +8078,8 @@ class JSMessageObject: public JSObject {
 // The regular expression holds a single reference to a FixedArray in
 // the kDataOffset field.
 // The FixedArray contains the following data:
-// - tag : type of regexp implementation (not compiled yet, atom or irregexp)
+// - tag : type of regexp implementation (not compiled yet, atom, irregexp or
+// linear)
 // - reference to the original source string
 // - reference to the original flag string
 // If it is an atom regexp
@@ -7844,6 +8091,9 @@ class JSMessageObject: public JSObject {
 // used for tracking the last usage (used for code flushing)..
 // - max number of registers used by irregexp implementations.
 // - number of capture registers (output values) of the regexp.
+// If it is a linear regexp:
+// - a byte array holding the program for the linear-time matcher.
+// - number of capture registers (output values) of the regexp.
 class JSRegExp: public JSObject {
  public:
   // Meaning of Type:
@@ -7851,7 +8101,8 @@ class JSRegExp: public JSObject {
   // ATOM: A simple string to match against using an indexOf operation.
   // IRREGEXP: Compiled with Irregexp.
   // IRREGEXP_NATIVE: Compiled to native code with Irregexp.
-  enum Type { NOT_COMPILED, ATOM, IRREGEXP };
+  // LINEAR: Compiled for the non-backtracking matcher in regexp-linear.h.
+  enum Type { NOT_COMPILED, ATOM, IRREGEXP, LINEAR };
   enum Flag { NONE = 0, GLOBAL = 1, IGNORE_CASE = 2, MULTILINE = 4 };
 
   class Flags {
@@ -7935,6 +8186,12 @@ class JSRegExp: public JSObject {
 
   static const int kIrregexpDataSize = kIrregexpCaptureCountIndex + 1;
 
+  // Linear regexps.
+  static const int kLinearProgramIndex = kDataIndex;
+  static const int kLinearCaptureCountIndex = kDataIndex + 1;
+
+  static const int kLinearDataSize = kLinearCaptureCountIndex + 1;
+
   // Offsets directly into the data fixed array.
   static const int kDataTagOffset =
       FixedArray::kHeaderSize + kTagIndex * kPointerSize;
@@ -8249,6 +8506,9 @@ class AllocationSite: public Struct {
   DECL_ACCESSORS(nested_site, Object)
   DECL_ACCESSORS(pretenure_data, Smi)
   DECL_ACCESSORS(pretenure_create_count, Smi)
+  // Accumulated size in bytes of the objects created at this site that
+  // survived a scavenge, saturating at Smi::kMaxValue.
+  DECL_ACCESSORS(pretenure_survived_bytes, Smi)
   DECL_ACCESSORS(dependent_code, DependentCode)
   DECL_ACCESSORS(weak_next, Object)
 
@@ -8274,6 +8534,12 @@ class AllocationSite: public Struct {
 
   inline void IncrementMementoCreateCount();
 
+  inline void IncrementSurvivedBytes(int bytes);
+
+  int survived_bytes() {
+    return pretenure_survived_bytes()->value();
+  }
+
   PretenureFlag GetPretenureMode();
 
   void ResetPretenureDecision();
@@ -8329,6 +8595,10 @@ class AllocationSite: public Struct {
 
   inline bool DigestPretenuringFeedback();
 
+  // Drops a tenure decision so that the site starts gathering feedback
+  // again. Returns true if dependent code has to be deoptimized.
+  inline bool DecayPretenureDecision();
+
   ElementsKind GetElementsKind() {
     ASSERT(!SitePointsToLiteral());
     int value = Smi::cast(transition_info())->value();
@@ -8384,8 +8654,10 @@ class AllocationSite: public Struct {
   static const int kPretenureDataOffset = kNestedSiteOffset + kPointerSize;
   static const int kPretenureCreateCountOffset =
       kPretenureDataOffset + kPointerSize;
-  static const int kDependentCodeOffset =
+  static const int kPretenureSurvivedBytesOffset =
       kPretenureCreateCountOffset + kPointerSize;
+  static const int kDependentCodeOffset =
+      kPretenureSurvivedBytesOffset + kPointerSize;
   static const int kWeakNextOffset = kDependentCodeOffset + kPointerSize;
   static const int kSize = kWeakNextOffset + kPointerSize;
 
@@ -8490,9 +8762,17 @@ class StringHasher {
   // use 27 instead.
   static const int kZeroHash = 27;
 
+  // Strings of at least this length are hashed two characters at a time
+  // using the MurmurHash3 mixing steps, which has a much shorter
+  // dependency chain per character than the one-at-a-time hash used for
+  // short strings.  Both are seeded with the per-isolate hash seed.
+  static const int kBlockHashMinLength = 32;
+
   // Reusable parts of the hashing algorithm.
   INLINE(static uint32_t AddCharacterCore(uint32_t running_hash, uint16_t c));
   INLINE(static uint32_t GetHashCore(uint32_t running_hash));
+  INLINE(static uint32_t AddBlockCore(uint32_t running_hash, uint32_t block));
+  INLINE(static uint32_t GetBlockHashCore(uint32_t running_hash, int length));
 
  protected:
   // Returns the value to store in the hash field of a string with
@@ -8506,6 +8786,12 @@ class StringHasher {
   inline void AddCharacters(const Char* chars, int len);
 
  private:
+  // Returns true if the string is hashed a block at a time.
+  inline bool has_block_hash();
+  // Adds characters to the block hash, carrying an odd one over to the
+  // next call.
+  template<typename Char>
+  inline void AddBlockCharacters(const Char* chars, int len);
   // Add a character to the hash.
   inline void AddCharacter(uint16_t c);
   // Update index. Returns true if string is still an index.
@@ -8516,6 +8802,8 @@ class StringHasher {
   uint32_t array_index_;
   bool is_array_index_;
   bool is_first_char_;
+  bool has_pending_char_;
+  uint16_t pending_char_;
   DISALLOW_COPY_AND_ASSIGN(StringHasher);
 };
 
@@ -9429,6 +9717,44 @@ class StringCharacterStream {
 };
 
 
+// Visits the flat segments of a string in order, leaf by leaf for cons
+// strings, so that they can be read without flattening the string.
+// Note: this class is not GC-safe.
+class StringSegmentIterator {
+ public:
+  inline StringSegmentIterator(String* string, ConsStringIteratorOp* op);
+  // Advances to the next segment, returns false once there is none left.
+  inline bool Next();
+  bool is_one_byte() { return is_one_byte_; }
+  // Position of the current segment within the whole string.
+  int offset() { return offset_; }
+  int length() { return length_; }
+  Vector<const uint8_t> ToOneByteVector() {
+    ASSERT(is_one_byte_);
+    return Vector<const uint8_t>(buffer8_, length_);
+  }
+  Vector<const uc16> ToUC16Vector() {
+    ASSERT(!is_one_byte_);
+    return Vector<const uc16>(buffer16_, length_);
+  }
+  inline void VisitOneByteString(const uint8_t* chars, unsigned length);
+  inline void VisitTwoByteString(const uint16_t* chars, unsigned length);
+
+ private:
+  String* string_;
+  ConsStringIteratorOp* op_;
+  bool started_;
+  bool is_one_byte_;
+  union {
+    const uint8_t* buffer8_;
+    const uint16_t* buffer16_;
+  };
+  int offset_;
+  int length_;
+  DISALLOW_COPY_AND_ASSIGN(StringSegmentIterator);
+};
+
+
 template <typename T>
 class VectorIterator {
  public:
@@ -9632,7 +9958,7 @@ class JSProxy: public JSReceiver {
 
   // Invoke a trap by name. If the trap does not exist on this's handler,
   // but derived_trap is non-NULL, invoke that instead.  May cause GC.
-  Handle<Object> CallTrap(const char* name,
+  Handle<Object> CallTrap(Handle<String> trap_name,
                           Handle<Object> derived_trap,
                           int argc,
                           Handle<Object> args[]);
@@ -9726,7 +10052,7 @@ class JSFunctionProxy: public JSProxy {
 // The JSSet describes EcmaScript Harmony sets
 class JSSet: public JSObject {
  public:
-  // [set]: the backing hash set containing keys.
+  // [set]: the backing ordered hash set containing keys.
   DECL_ACCESSORS(table, Object)
 
   // Casting.
@@ -9747,7 +10073,7 @@ class JSSet: public JSObject {
 // The JSMap describes EcmaScript Harmony maps
 class JSMap: public JSObject {
  public:
-  // [table]: the backing hash table mapping keys to values.
+  // [table]: the backing ordered hash table mapping keys to values.
   DECL_ACCESSORS(table, Object)
 
   // Casting.
@@ -9830,6 +10156,11 @@ class JSArrayBuffer: public JSObject {
   inline bool should_be_freed();
   inline void set_should_be_freed(bool value);
 
+  // Shared buffers wrap embedder-owned memory that may be visible to
+  // several isolates at once. They are always external.
+  inline bool is_shared();
+  inline void set_is_shared(bool value);
+
   // [weak_next]: linked list of array buffers.
   DECL_ACCESSORS(weak_next, Object)
 
@@ -9860,6 +10191,7 @@ class JSArrayBuffer: public JSObject {
   // Bit position in a flag
   static const int kIsExternalBit = 0;
   static const int kShouldBeFreed = 1;
+  static const int kIsSharedBit = 2;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(JSArrayBuffer);
 };
@@ -10667,6 +10999,7 @@ class BreakPointInfo: public Struct {
   V(kRelocatable, "relocatable", "(Relocatable)")                       \
   V(kDebug, "debug", "(Debugger)")                                      \
   V(kCompilationCache, "compilationcache", "(Compilation cache)")       \
+  V(kMicrotaskQueue, "microtaskqueue", "(Microtask queue)")             \
   V(kHandleScope, "handlescope", "(Handle scope)")                      \
   V(kBuiltins, "builtins", "(Builtins)")                                \
   V(kGlobalHandles, "globalhandles", "(Global handles)")                \
@@ -29,6 +29,7 @@
 
 #include "v8.h"
 
+#include "compiler.h"
 #include "full-codegen.h"
 #include "hydrogen.h"
 #include "isolate.h"
@@ -37,9 +38,30 @@
 namespace v8 {
 namespace internal {
 
+class OptimizingCompilerThread::HelperThread : public Thread {
+ public:
+  explicit HelperThread(OptimizingCompilerThread* compiler_thread)
+      : Thread("OptimizingCompilerHelperThread"),
+        compiler_thread_(compiler_thread) {}
+
+  virtual void Run() V8_OVERRIDE {
+    compiler_thread_->CompileLoop();
+  }
+
+ private:
+  OptimizingCompilerThread* compiler_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(HelperThread);
+};
+
+
 OptimizingCompilerThread::~OptimizingCompilerThread() {
   ASSERT_EQ(0, input_queue_length_);
   DeleteArray(input_queue_);
+  if (helper_threads_ != NULL) {
+    for (int i = 0; i < num_threads_ - 1; i++) delete helper_threads_[i];
+    DeleteArray(helper_threads_);
+  }
   if (FLAG_concurrent_osr) {
 #ifdef DEBUG
     for (int i = 0; i < osr_buffer_capacity_; i++) {
@@ -51,10 +73,29 @@ OptimizingCompilerThread::~OptimizingCompilerThread() {
 }
 
 
+void OptimizingCompilerThread::StartThreads() {
+  ASSERT(!threads_started_);
+  threads_started_ = true;
+  Start();
+  if (num_threads_ > 1) {
+    helper_threads_ = NewArray<HelperThread*>(num_threads_ - 1);
+    for (int i = 0; i < num_threads_ - 1; i++) {
+      helper_threads_[i] = new HelperThread(this);
+      helper_threads_[i]->Start();
+    }
+  }
+}
+
+
 void OptimizingCompilerThread::Run() {
+  CompileLoop();
+}
+
+
+void OptimizingCompilerThread::CompileLoop() {
 #ifdef DEBUG
   { LockGuard<Mutex> lock_guard(&thread_id_mutex_);
-    thread_id_ = ThreadId::Current().ToInteger();
+    thread_ids_.Add(ThreadId::Current().ToInteger());
   }
 #endif
   Isolate::SetIsolateThreadLocals(isolate_, NULL);
@@ -64,6 +105,7 @@ void OptimizingCompilerThread::Run() {
 
   ElapsedTimer total_timer;
   if (FLAG_trace_concurrent_recompilation) total_timer.Start();
+  TimeDelta time_spent_compiling;
 
   while (true) {
     input_queue_semaphore_.Wait();
@@ -79,17 +121,17 @@ void OptimizingCompilerThread::Run() {
         break;
       case STOP:
         if (FLAG_trace_concurrent_recompilation) {
-          time_spent_total_ = total_timer.Elapsed();
+          LockGuard<Mutex> access_time_spent(&time_spent_mutex_);
+          time_spent_total_ += total_timer.Elapsed();
+          time_spent_compiling_ += time_spent_compiling;
         }
         stop_semaphore_.Signal();
         return;
       case FLUSH:
-        // The main thread is blocked, waiting for the stop semaphore.
-        { AllowHandleDereference allow_handle_dereference;
-          FlushInputQueue(true);
-        }
-        Release_Store(&stop_thread_, static_cast<AtomicWord>(CONTINUE));
+        // Park until the main thread has flushed the input queue, so that no
+        // compiler thread picks up a job while the queue is being flushed.
         stop_semaphore_.Signal();
+        resume_semaphore_.Wait();
         // Return to start of consumer loop.
         continue;
     }
@@ -100,7 +142,7 @@ void OptimizingCompilerThread::Run() {
     CompileNext();
 
     if (FLAG_trace_concurrent_recompilation) {
-      time_spent_compiling_ += compiling_timer.Elapsed();
+      time_spent_compiling += compiling_timer.Elapsed();
     }
   }
 }
@@ -120,15 +162,17 @@ OptimizedCompileJob* OptimizingCompilerThread::NextInput() {
 void OptimizingCompilerThread::CompileNext() {
   OptimizedCompileJob* job = NextInput();
   ASSERT_NE(NULL, job);
+  job->RecordDequeued();
 
   // The function may have already been optimized by OSR.  Simply continue.
   OptimizedCompileJob::Status status = job->OptimizeGraph();
   USE(status);   // Prevent an unused-variable error in release mode.
   ASSERT(status != OptimizedCompileJob::FAILED);
+  job->RecordCompiled();
 
   // The function may have already been optimized by OSR.  Simply continue.
-  // Use a mutex to make sure that functions marked for install
-  // are always also queued.
+  // The job is linked into the output queue before the install request is
+  // made, so the main thread always finds it.
   output_queue_.Enqueue(job);
   isolate_->stack_guard()->RequestInstallCode();
 }
@@ -192,10 +236,18 @@ void OptimizingCompilerThread::FlushOsrBuffer(bool restore_function_code) {
 
 void OptimizingCompilerThread::Flush() {
   ASSERT(!IsOptimizerThread());
+  // Without any compiler threads, no job has been queued yet.
+  if (!threads_started_) return;
   Release_Store(&stop_thread_, static_cast<AtomicWord>(FLUSH));
   if (FLAG_block_concurrent_recompilation) Unblock();
-  input_queue_semaphore_.Signal();
-  stop_semaphore_.Wait();
+  for (int i = 0; i < num_threads_; i++) input_queue_semaphore_.Signal();
+  for (int i = 0; i < num_threads_; i++) stop_semaphore_.Wait();
+  // Every compiler thread has consumed one signal of the input queue
+  // semaphore in addition to those for the jobs it took, so the remaining
+  // signals match the jobs left in the input queue.
+  FlushInputQueue(true);
+  Release_Store(&stop_thread_, static_cast<AtomicWord>(CONTINUE));
+  for (int i = 0; i < num_threads_; i++) resume_semaphore_.Signal();
   FlushOutputQueue(true);
   if (FLAG_concurrent_osr) FlushOsrBuffer(true);
   if (FLAG_trace_concurrent_recompilation) {
@@ -206,10 +258,12 @@ void OptimizingCompilerThread::Flush() {
 
 void OptimizingCompilerThread::Stop() {
   ASSERT(!IsOptimizerThread());
-  Release_Store(&stop_thread_, static_cast<AtomicWord>(STOP));
-  if (FLAG_block_concurrent_recompilation) Unblock();
-  input_queue_semaphore_.Signal();
-  stop_semaphore_.Wait();
+  if (threads_started_) {
+    Release_Store(&stop_thread_, static_cast<AtomicWord>(STOP));
+    if (FLAG_block_concurrent_recompilation) Unblock();
+    for (int i = 0; i < num_threads_; i++) input_queue_semaphore_.Signal();
+    for (int i = 0; i < num_threads_; i++) stop_semaphore_.Wait();
+  }
 
   if (FLAG_concurrent_recompilation_delay != 0) {
     // At this point the optimizing compiler thread's event loop has stopped.
@@ -226,14 +280,25 @@ void OptimizingCompilerThread::Stop() {
   if (FLAG_trace_concurrent_recompilation) {
     double percentage = time_spent_compiling_.PercentOf(time_spent_total_);
     PrintF("  ** Compiler thread did %.2f%% useful work\n", percentage);
+    { LockGuard<Mutex> access_input_queue(&input_queue_mutex_);
+      PrintF("  ** Input queue lock contended %d times, %.3f ms waiting\n",
+             input_queue_mutex_.contention_count(),
+             input_queue_mutex_.contention_time().InMillisecondsF());
+    }
   }
 
   if ((FLAG_trace_osr || FLAG_trace_concurrent_recompilation) &&
       FLAG_concurrent_osr) {
-    PrintF("[COSR hit rate %d / %d]\n", osr_hits_, osr_attempts_);
+    PrintF("[COSR hit rate %d / %d, %d cached, %d discarded]\n",
+           osr_hits_, osr_attempts_, osr_cached_, osr_evictions_);
   }
 
-  Join();
+  if (threads_started_) {
+    Join();
+    if (helper_threads_ != NULL) {
+      for (int i = 0; i < num_threads_ - 1; i++) helper_threads_[i]->Join();
+    }
+  }
 }
 
 
@@ -245,6 +310,11 @@ void OptimizingCompilerThread::InstallOptimizedFunctions() {
   while (output_queue_.Dequeue(&job)) {
     CompilationInfo* info = job->info();
     Handle<JSFunction> function(*info->closure());
+    Counters* counters = isolate_->counters();
+    counters->optimization_queue_wait()->AddSample(
+        static_cast<int>(job->time_in_queue().InMilliseconds()));
+    counters->optimization_install_delay()->AddSample(
+        static_cast<int>(job->time_since_compiled().InMilliseconds()));
     if (info->is_osr()) {
       if (FLAG_trace_osr) {
         PrintF("[COSR - ");
@@ -266,9 +336,17 @@ void OptimizingCompilerThread::InstallOptimizedFunctions() {
 }
 
 
+// Only called on the main thread, which is allowed to dereference handles.
+static int ProfilerTicks(OptimizedCompileJob* job) {
+  return job->info()->shared_info()->code()->profiler_ticks();
+}
+
+
 void OptimizingCompilerThread::QueueForOptimization(OptimizedCompileJob* job) {
   ASSERT(IsQueueAvailable());
   ASSERT(!IsOptimizerThread());
+  if (!threads_started_) StartThreads();
+  job->RecordQueued();
   CompilationInfo* info = job->info();
   if (info->is_osr()) {
     osr_attempts_++;
@@ -281,10 +359,19 @@ void OptimizingCompilerThread::QueueForOptimization(OptimizedCompileJob* job) {
     input_queue_[InputQueueIndex(0)] = job;
     input_queue_length_++;
   } else {
-    // Add job to the back of the input queue.
+    // Add job to the input queue ahead of all regular jobs for colder
+    // functions, so that the hottest functions get optimized first.
+    int ticks = ProfilerTicks(job);
     LockGuard<Mutex> access_input_queue(&input_queue_mutex_);
     ASSERT_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
+    int position = input_queue_length_;
+    while (position > 0) {
+      OptimizedCompileJob* other = input_queue_[InputQueueIndex(position - 1)];
+      if (other->info()->is_osr() || ProfilerTicks(other) >= ticks) break;
+      input_queue_[InputQueueIndex(position)] = other;
+      position--;
+    }
+    input_queue_[InputQueueIndex(position)] = job;
     input_queue_length_++;
   }
   if (FLAG_block_concurrent_recompilation) {
@@ -357,19 +444,45 @@ void OptimizingCompilerThread::AddToOsrBuffer(OptimizedCompileJob* job) {
     osr_buffer_cursor_ = (osr_buffer_cursor_ + 1) % osr_buffer_capacity_;
   }
 
-  // Add to found slot and dispose the evicted job.
+  // Free the found slot first, generating code for the evicted job below
+  // may cause a GC that ages the buffer again.
+  int slot = osr_buffer_cursor_;
+  osr_buffer_[slot] = NULL;
+
+  // Dispose the evicted job.  The code of a job evicted in favor of a new
+  // one is kept in the optimized code map instead, keyed by its OSR entry,
+  // so that the next OSR attempt at the same loop finds it there.  Being
+  // called during GC rules this out for aged jobs.
   if (stale != NULL) {
     ASSERT(stale->IsWaitingForInstall());
     CompilationInfo* info = stale->info();
-    if (FLAG_trace_osr) {
-      PrintF("[COSR - Discarded ");
-      info->closure()->PrintName();
-      PrintF(", AST id %d]\n", info->osr_ast_id().ToInt());
+    bool cached = false;
+    if (job != NULL && FLAG_cache_optimized_code) {
+      HandleScope handle_scope(isolate_);
+      if (FLAG_trace_osr) {
+        PrintF("[COSR - Caching ");
+        info->closure()->PrintName();
+        PrintF(", AST id %d]\n", info->osr_ast_id().ToInt());
+      }
+      // Takes ownership of the compilation info.
+      cached = !Compiler::GetConcurrentlyOptimizedCode(stale).is_null();
+    } else {
+      if (FLAG_trace_osr) {
+        PrintF("[COSR - Discarded ");
+        info->closure()->PrintName();
+        PrintF(", AST id %d]\n", info->osr_ast_id().ToInt());
+      }
+      DisposeOptimizedCompileJob(stale, false);
+    }
+    if (cached) {
+      osr_cached_++;
+    } else {
+      osr_evictions_++;
     }
-    DisposeOptimizedCompileJob(stale, false);
   }
-  osr_buffer_[osr_buffer_cursor_] = job;
-  osr_buffer_cursor_ = (osr_buffer_cursor_ + 1) % osr_buffer_capacity_;
+  ASSERT(osr_buffer_[slot] == NULL);
+  osr_buffer_[slot] = job;
+  osr_buffer_cursor_ = (slot + 1) % osr_buffer_capacity_;
 }
 
 
@@ -382,7 +495,7 @@ bool OptimizingCompilerThread::IsOptimizerThread(Isolate* isolate) {
 
 bool OptimizingCompilerThread::IsOptimizerThread() {
   LockGuard<Mutex> lock_guard(&thread_id_mutex_);
-  return ThreadId::Current().ToInteger() == thread_id_;
+  return thread_ids_.Contains(ThreadId::Current().ToInteger());
 }
 #endif
 
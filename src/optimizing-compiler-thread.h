@@ -34,7 +34,7 @@
 #include "platform.h"
 #include "platform/mutex.h"
 #include "platform/time.h"
-#include "unbound-queue-inl.h"
+#include "mpsc-queue-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -43,15 +43,20 @@ class HOptimizedGraphBuilder;
 class OptimizedCompileJob;
 class SharedFunctionInfo;
 
+// Drives concurrent recompilation. The thread itself compiles jobs from the
+// input queue and can be assisted by further helper threads that share the
+// same input and output queues. The threads are only started when the first
+// job is queued, so that isolates that never optimize do not pay for them.
 class OptimizingCompilerThread : public Thread {
  public:
-  explicit OptimizingCompilerThread(Isolate *isolate) :
+  OptimizingCompilerThread(Isolate *isolate, int num_threads) :
       Thread("OptimizingCompilerThread"),
-#ifdef DEBUG
-      thread_id_(0),
-#endif
       isolate_(isolate),
+      num_threads_(num_threads),
+      helper_threads_(NULL),
+      threads_started_(false),
       stop_semaphore_(0),
+      resume_semaphore_(0),
       input_queue_semaphore_(0),
       input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
       input_queue_length_(0),
@@ -60,6 +65,8 @@ class OptimizingCompilerThread : public Thread {
       osr_buffer_cursor_(0),
       osr_hits_(0),
       osr_attempts_(0),
+      osr_cached_(0),
+      osr_evictions_(0),
       blocked_jobs_(0) {
     NoBarrier_Store(&stop_thread_, static_cast<AtomicWord>(CONTINUE));
     input_queue_ = NewArray<OptimizedCompileJob*>(input_queue_capacity_);
@@ -100,14 +107,26 @@ class OptimizingCompilerThread : public Thread {
     return (FLAG_concurrent_recompilation && max_available > 1);
   }
 
+  // Number of threads, including this one, that compile jobs concurrently.
+  static int NumberOfThreads(int max_available) {
+    int threads = Min(FLAG_concurrent_recompilation_threads, max_available - 1);
+    return Max(threads, 1);
+  }
+
 #ifdef DEBUG
   static bool IsOptimizerThread(Isolate* isolate);
   bool IsOptimizerThread();
 #endif
 
  private:
+  class HelperThread;
+
   enum StopFlag { CONTINUE, STOP, FLUSH };
 
+  // Starts this thread and all helper threads.
+  void StartThreads();
+  // The loop run by this thread and all helper threads.
+  void CompileLoop();
   void FlushInputQueue(bool restore_function_code);
   void FlushOutputQueue(bool restore_function_code);
   void FlushOsrBuffer(bool restore_function_code);
@@ -115,7 +134,8 @@ class OptimizingCompilerThread : public Thread {
   OptimizedCompileJob* NextInput();
 
   // Add a recompilation task for OSR to the cyclic buffer, awaiting OSR entry.
-  // Tasks evicted from the cyclic buffer are discarded.
+  // Tasks evicted from the cyclic buffer are moved into the optimized code
+  // map of their function if possible, and discarded otherwise.
   void AddToOsrBuffer(OptimizedCompileJob* compiler);
 
   inline int InputQueueIndex(int i) {
@@ -126,12 +146,17 @@ class OptimizingCompilerThread : public Thread {
   }
 
 #ifdef DEBUG
-  int thread_id_;
+  List<int> thread_ids_;
   Mutex thread_id_mutex_;
 #endif
 
   Isolate* isolate_;
+  int num_threads_;
+  HelperThread** helper_threads_;
+  bool threads_started_;
   Semaphore stop_semaphore_;
+  // Releases threads that parked themselves while the main thread flushes.
+  Semaphore resume_semaphore_;
   Semaphore input_queue_semaphore_;
 
   // Circular queue of incoming recompilation tasks (including OSR).
@@ -142,7 +167,8 @@ class OptimizingCompilerThread : public Thread {
   Mutex input_queue_mutex_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
-  UnboundQueue<OptimizedCompileJob*> output_queue_;
+  // Filled by all compiler threads, drained by the main thread.
+  MPSCQueue<OptimizedCompileJob*> output_queue_;
 
   // Cyclic buffer of recompilation tasks for OSR.
   OptimizedCompileJob** osr_buffer_;
@@ -152,9 +178,12 @@ class OptimizingCompilerThread : public Thread {
   volatile AtomicWord stop_thread_;
   TimeDelta time_spent_compiling_;
   TimeDelta time_spent_total_;
+  Mutex time_spent_mutex_;
 
   int osr_hits_;
   int osr_attempts_;
+  int osr_cached_;
+  int osr_evictions_;
 
   int blocked_jobs_;
 };
@@ -263,6 +263,23 @@ FunctionEntry ScriptDataImpl::GetFunctionEntry(int start) {
 }
 
 
+bool ScriptDataImpl::IsHotFunction(int name_position) {
+  if (name_position < 0) return false;
+  unsigned key = static_cast<unsigned>(name_position);
+  int low = 0;
+  int high = hot_functions_.length();
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    if (hot_functions_[mid] < key) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low < hot_functions_.length() && hot_functions_[low] == key;
+}
+
+
 int ScriptDataImpl::GetSymbolIdentifier() {
   return ReadNumber(&symbol_data_);
 }
@@ -304,13 +321,17 @@ bool ScriptDataImpl::SanityCheck() {
       static_cast<int>(store_[PreparseDataConstants::kFunctionsSizeOffset]);
   if (functions_size < 0) return false;
   if (functions_size % FunctionEntry::kSize != 0) return false;
+  int hot_functions_size =
+      static_cast<int>(store_[PreparseDataConstants::kHotFunctionsSizeOffset]);
+  if (hot_functions_size < 0) return false;
   // Check that the count of symbols is non-negative.
   int symbol_count =
       static_cast<int>(store_[PreparseDataConstants::kSymbolCountOffset]);
   if (symbol_count < 0) return false;
-  // Check that the total size has room for header and function entries.
+  // Check that the total size has room for header, function entries and
+  // hot functions.
   int minimum_size =
-      PreparseDataConstants::kHeaderSize + functions_size;
+      PreparseDataConstants::kHeaderSize + functions_size + hot_functions_size;
   if (store_.length() < minimum_size) return false;
   return true;
 }
@@ -607,6 +628,10 @@ Parser::Parser(CompilationInfo* info)
       target_stack_(NULL),
       pre_parse_data_(NULL),
       fni_(NULL),
+      lazy_inner_functions_(false),
+      cached_lazy_function_data_(0, info->zone()),
+      cached_lazy_function_cursor_(0),
+      lazy_function_log_(0, info->zone()),
       info_(info) {
   ASSERT(!script_.is_null());
   isolate_->set_ast_node_id(0);
@@ -803,6 +828,11 @@ FunctionLiteral* Parser::ParseLazy(Utf16CharacterStream* source) {
   fni_->PushEnclosingName(name);
 
   ParsingModeScope parsing_mode(this, PARSE_EAGERLY);
+  lazy_inner_functions_ = shared_info->lazy_inner_functions();
+  if (lazy_inner_functions_ && FLAG_cache_lazy_function_data) {
+    LoadLazyFunctionData(shared_info->start_position(),
+                         shared_info->end_position());
+  }
 
   // Place holder for the result.
   FunctionLiteral* result = NULL;
@@ -847,6 +877,7 @@ FunctionLiteral* Parser::ParseLazy(Utf16CharacterStream* source) {
   } else {
     Handle<String> inferred_name(shared_info->inferred_name());
     result->set_inferred_name(inferred_name);
+    if (!lazy_function_log_.is_empty()) StoreLazyFunctionData();
   }
   return result;
 }
@@ -3773,6 +3804,74 @@ class SingletonLogger : public ParserRecorder {
 };
 
 
+// A SingletonLogger that also records the distinct identifier names that
+// occur in the preparsed function body. When an inner function is skipped
+// (see --lazy-inner-functions) the names are a conservative approximation
+// of the variables it refers to in the enclosing function.
+class SymbolCollectingLogger : public SingletonLogger {
+ public:
+  struct Symbol {
+    bool is_ascii;
+    Vector<const byte> literal_bytes;
+  };
+
+  explicit SymbolCollectingLogger(Zone* zone)
+      : zone_(zone),
+        symbols_(4, zone),
+        symbol_table_(SymbolMatch,
+                      ZoneHashMap::kDefaultHashMapCapacity,
+                      ZoneAllocationPolicy(zone)) { }
+  virtual ~SymbolCollectingLogger() { }
+
+  virtual void LogAsciiSymbol(int start, Vector<const char> literal) {
+    AddSymbol(true, Vector<const byte>::cast(literal));
+  }
+
+  virtual void LogUtf16Symbol(int start, Vector<const uc16> literal) {
+    AddSymbol(false, Vector<const byte>::cast(literal));
+  }
+
+  const ZoneList<Symbol*>* symbols() const { return &symbols_; }
+
+ private:
+  void AddSymbol(bool is_ascii, Vector<const byte> literal) {
+    Symbol key = { is_ascii, literal };
+    uint32_t hash = is_ascii ? 1 : 0;
+    for (int i = 0; i < literal.length(); i++) {
+      hash += literal[i];
+      hash += (hash << 10);
+      hash ^= (hash >> 6);
+    }
+    ZoneHashMap::Entry* entry =
+        symbol_table_.Lookup(&key, hash, true, ZoneAllocationPolicy(zone_));
+    if (entry->value != NULL) return;
+    // The literal lives in the scanner's buffer; keep a copy of it.
+    byte* bytes = zone_->NewArray<byte>(literal.length());
+    OS::MemCopy(bytes, literal.start(), literal.length());
+    Symbol* symbol = reinterpret_cast<Symbol*>(zone_->New(sizeof(Symbol)));
+    symbol->is_ascii = is_ascii;
+    symbol->literal_bytes = Vector<const byte>(bytes, literal.length());
+    entry->key = symbol;
+    entry->value = symbol;
+    symbols_.Add(symbol, zone_);
+  }
+
+  static bool SymbolMatch(void* a, void* b) {
+    Symbol* symbol1 = reinterpret_cast<Symbol*>(a);
+    Symbol* symbol2 = reinterpret_cast<Symbol*>(b);
+    if (symbol1->is_ascii != symbol2->is_ascii) return false;
+    int length = symbol1->literal_bytes.length();
+    if (symbol2->literal_bytes.length() != length) return false;
+    return memcmp(symbol1->literal_bytes.start(),
+                  symbol2->literal_bytes.start(), length) == 0;
+  }
+
+  Zone* zone_;
+  ZoneList<Symbol*> symbols_;
+  ZoneHashMap symbol_table_;
+};
+
+
 FunctionLiteral* Parser::ParseFunctionLiteral(
     Handle<String> function_name,
     Scanner::Location function_name_location,
@@ -3968,6 +4067,17 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
                              !parenthesized_function_);
     parenthesized_function_ = false;  // The bit was set for this function only.
 
+    // With --lazy-inner-functions the parser also runs in lazy mode inside
+    // the function that is being compiled lazily (see below). Functions
+    // nested in a with statement are still parsed eagerly there.
+    bool is_inner_function = scope_->DeclarationScope()->is_function_scope();
+    if (is_inner_function && scope_->inside_with()) is_lazily_parsed = false;
+
+    // Set when the preparser predicted that the function is called while the
+    // script is loaded. Its body is then parsed without the preparse data,
+    // which has no symbols for it.
+    bool is_hot = false;
+
     if (is_lazily_parsed) {
       int function_block_pos = position();
       FunctionEntry entry;
@@ -3976,7 +4086,14 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
         // body.  The preparser data contains the information we need to
         // construct the lazy function.
         entry = pre_parse_data()->GetFunctionEntry(function_block_pos);
-        if (entry.is_valid()) {
+        if (entry.is_valid() && FLAG_compile_hot_functions_eagerly &&
+            pre_parse_data()->IsHotFunction(function_name_location.beg_pos)) {
+          // Compile the function with the script rather than on its first
+          // call, like a parenthesized function.
+          is_hot = true;
+          is_lazily_parsed = false;
+          parenthesized = FunctionLiteral::kIsParenthesized;
+        } else if (entry.is_valid()) {
           if (entry.end_pos() <= function_block_pos) {
             // End position greater than end of stream is safe, and hard
             // to check.
@@ -4007,45 +4124,73 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
           // parsed eagerly).
           is_lazily_parsed = false;
         }
+      } else if (is_inner_function &&
+                 SkipCachedLazyFunction(function_block_pos,
+                                        &materialized_literal_count,
+                                        &expected_property_count)) {
+        Expect(Token::RBRACE, CHECK_OK);
       } else {
         // With no preparser data, we partially parse the function, without
         // building an AST. This gathers the data needed to build a lazy
         // function.
-        SingletonLogger logger;
-        PreParser::PreParseResult result = LazyParseFunctionLiteral(&logger);
+        SingletonLogger function_logger;
+        SymbolCollectingLogger inner_function_logger(zone());
+        SingletonLogger* logger =
+            is_inner_function ? &inner_function_logger : &function_logger;
+        PreParser::PreParseResult result = LazyParseFunctionLiteral(logger);
         if (result == PreParser::kPreParseStackOverflow) {
           // Propagate stack overflow.
           set_stack_overflow();
           *ok = false;
           return NULL;
         }
-        if (logger.has_error()) {
-          const char* arg = logger.argument_opt();
+        if (logger->has_error()) {
+          const char* arg = logger->argument_opt();
           Vector<const char*> args;
           if (arg != NULL) {
             args = Vector<const char*>(&arg, 1);
           }
           ParserTraits::ReportMessageAt(
-              Scanner::Location(logger.start(), logger.end()),
-              logger.message(),
+              Scanner::Location(logger->start(), logger->end()),
+              logger->message(),
               args);
           *ok = false;
           return NULL;
         }
-        scope->set_end_position(logger.end());
+        scope->set_end_position(logger->end());
         Expect(Token::RBRACE, CHECK_OK);
         isolate()->counters()->total_preparse_skipped()->Increment(
             scope->end_position() - function_block_pos);
-        materialized_literal_count = logger.literals();
-        expected_property_count = logger.properties();
-        scope_->SetLanguageMode(logger.language_mode());
+        materialized_literal_count = logger->literals();
+        expected_property_count = logger->properties();
+        scope_->SetLanguageMode(logger->language_mode());
+        if (is_inner_function) {
+          // The skipped body may refer to any variable of the enclosing
+          // function whose name occurs in it. Record an unresolved reference
+          // for each name, so that scope analysis context allocates those
+          // variables exactly as if the body had been parsed.
+          const ZoneList<SymbolCollectingLogger::Symbol*>* symbols =
+              inner_function_logger.symbols();
+          for (int i = 0; i < symbols->length(); i++) {
+            SymbolCollectingLogger::Symbol* symbol = symbols->at(i);
+            DeclareSkippedFunctionSymbol(symbol->is_ascii,
+                                         symbol->literal_bytes);
+          }
+          if (FLAG_cache_lazy_function_data) {
+            LogLazyFunction(function_block_pos, &inner_function_logger);
+          }
+        }
       }
     }
 
     if (!is_lazily_parsed) {
       // Everything inside an eagerly parsed function will be parsed eagerly
-      // (see comment above).
-      ParsingModeScope parsing_mode(this, PARSE_EAGERLY);
+      // (see comment above). The one exception is the function compiled by
+      // ParseLazy when its shared function info asks for its inner functions
+      // to be preparsed.
+      Mode body_mode = lazy_inner_functions_ ? PARSE_LAZILY : PARSE_EAGERLY;
+      lazy_inner_functions_ = false;
+      ParsingModeScope parsing_mode(this, body_mode);
       body = new(zone()) ZoneList<Statement*>(8, zone());
       if (fvar != NULL) {
         VariableProxy* fproxy = scope_->NewUnresolved(
@@ -4079,7 +4224,10 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
             yield, RelocInfo::kNoPosition), zone());
       }
 
+      ScriptDataImpl* pre_parse_data = pre_parse_data_;
+      if (is_hot) pre_parse_data_ = NULL;
       ParseSourceElements(body, Token::RBRACE, false, false, CHECK_OK);
+      pre_parse_data_ = pre_parse_data;
 
       if (is_generator) {
         VariableProxy* get_proxy = factory()->NewVariableProxy(
@@ -4190,6 +4338,160 @@ PreParser::PreParseResult Parser::LazyParseFunctionLiteral(
 }
 
 
+void Parser::DeclareSkippedFunctionSymbol(bool is_ascii,
+                                          Vector<const byte> literal) {
+  Handle<String> name = is_ascii
+      ? isolate()->factory()->InternalizeOneByteString(
+            Vector<const uint8_t>::cast(literal))
+      : isolate()->factory()->InternalizeTwoByteString(
+            Vector<const uc16>::cast(literal));
+  if (name.is_identical_to(isolate()->factory()->eval_string())) {
+    // A direct eval can reach every variable of the enclosing function.
+    scope_->RecordEvalCall();
+  }
+  scope_->NewUnresolved(factory(), name, Interface::NewUnknown(zone()));
+}
+
+
+// A lazy function record is a FunctionEntry followed by the number of
+// symbols and the symbols themselves. Each symbol is a word holding its
+// length in bytes and whether it is ASCII, followed by its characters
+// packed into words.
+static const int kLazyFunctionSymbolCountIndex = FunctionEntry::kSize;
+static const int kLazyFunctionHeaderSize = FunctionEntry::kSize + 1;
+
+
+static int LazyFunctionSymbolSize(unsigned symbol_header) {
+  int byte_length = static_cast<int>(symbol_header >> 1);
+  return 1 + (byte_length + kIntSize - 1) / kIntSize;
+}
+
+
+static int LazyFunctionRecordSize(const unsigned* record) {
+  int size = kLazyFunctionHeaderSize;
+  int symbol_count = static_cast<int>(record[kLazyFunctionSymbolCountIndex]);
+  for (int i = 0; i < symbol_count; i++) {
+    size += LazyFunctionSymbolSize(record[size]);
+  }
+  return size;
+}
+
+
+void Parser::LoadLazyFunctionData(int start_position, int end_position) {
+  ASSERT(cached_lazy_function_data_.is_empty());
+  if (!script_->lazy_function_data()->IsByteArray()) return;
+  DisallowHeapAllocation no_allocation;
+  ByteArray* data = ByteArray::cast(script_->lazy_function_data());
+  const unsigned* words =
+      reinterpret_cast<const unsigned*>(data->GetDataStartAddress());
+  int length = data->length() / kIntSize;
+  int index = 0;
+  while (index < length) {
+    const unsigned* record = words + index;
+    int size = LazyFunctionRecordSize(record);
+    ASSERT(index + size <= length);
+    // Only inner functions of the function being parsed can be skipped.
+    int start = record[FunctionEntry::kStartPositionIndex];
+    int end = record[FunctionEntry::kEndPositionIndex];
+    if (start > start_position && end <= end_position) {
+      cached_lazy_function_data_.AddAll(Vector<unsigned>(
+          const_cast<unsigned*>(record), size), zone());
+    }
+    index += size;
+  }
+  cached_lazy_function_cursor_ = 0;
+}
+
+
+bool Parser::SkipCachedLazyFunction(int function_block_pos,
+                                    int* literal_count,
+                                    int* property_count) {
+  int length = cached_lazy_function_data_.length();
+  if (length == 0) return false;
+  // Inner functions are mostly looked up in source order, so the search
+  // starts after the record that was found last.
+  int index = cached_lazy_function_cursor_;
+  for (int searched = 0; searched < length;) {
+    if (index == length) index = 0;
+    unsigned* record = &cached_lazy_function_data_[index];
+    int size = LazyFunctionRecordSize(record);
+    if (static_cast<int>(record[FunctionEntry::kStartPositionIndex]) ==
+        function_block_pos) {
+      FunctionEntry entry(Vector<unsigned>(record, FunctionEntry::kSize));
+      scanner()->SeekForward(entry.end_pos() - 1);
+      scope_->set_end_position(entry.end_pos());
+      isolate()->counters()->total_preparse_skipped()->Increment(
+          entry.end_pos() - function_block_pos);
+      *literal_count = entry.literal_count();
+      *property_count = entry.property_count();
+      scope_->SetLanguageMode(entry.language_mode());
+      int symbol_count =
+          static_cast<int>(record[kLazyFunctionSymbolCountIndex]);
+      int offset = kLazyFunctionHeaderSize;
+      for (int i = 0; i < symbol_count; i++) {
+        unsigned symbol_header = record[offset];
+        Vector<const byte> literal(
+            reinterpret_cast<const byte*>(record + offset + 1),
+            static_cast<int>(symbol_header >> 1));
+        DeclareSkippedFunctionSymbol((symbol_header & 1) != 0, literal);
+        offset += LazyFunctionSymbolSize(symbol_header);
+      }
+      cached_lazy_function_cursor_ = index + size;
+      return true;
+    }
+    index += size;
+    searched += size;
+  }
+  return false;
+}
+
+
+void Parser::LogLazyFunction(int function_block_pos,
+                             SymbolCollectingLogger* logger) {
+  lazy_function_log_.Add(function_block_pos, zone());
+  lazy_function_log_.Add(logger->end(), zone());
+  lazy_function_log_.Add(logger->literals(), zone());
+  lazy_function_log_.Add(logger->properties(), zone());
+  lazy_function_log_.Add(logger->language_mode(), zone());
+  const ZoneList<SymbolCollectingLogger::Symbol*>* symbols =
+      logger->symbols();
+  lazy_function_log_.Add(symbols->length(), zone());
+  for (int i = 0; i < symbols->length(); i++) {
+    SymbolCollectingLogger::Symbol* symbol = symbols->at(i);
+    int byte_length = symbol->literal_bytes.length();
+    unsigned symbol_header = (byte_length << 1) | (symbol->is_ascii ? 1 : 0);
+    lazy_function_log_.Add(symbol_header, zone());
+    int offset = lazy_function_log_.length();
+    int size = LazyFunctionSymbolSize(symbol_header) - 1;
+    lazy_function_log_.AddBlock(0, size, zone());
+    OS::MemCopy(&lazy_function_log_[offset],
+                symbol->literal_bytes.start(),
+                byte_length);
+  }
+}
+
+
+void Parser::StoreLazyFunctionData() {
+  Handle<Object> old_data(script_->lazy_function_data(), isolate());
+  int old_size = old_data->IsByteArray()
+      ? ByteArray::cast(*old_data)->length()
+      : 0;
+  int new_size = lazy_function_log_.length() * kIntSize;
+  Handle<ByteArray> data =
+      isolate()->factory()->NewByteArray(old_size + new_size, TENURED);
+  if (old_size > 0) {
+    OS::MemCopy(data->GetDataStartAddress(),
+                ByteArray::cast(*old_data)->GetDataStartAddress(),
+                old_size);
+  }
+  OS::MemCopy(data->GetDataStartAddress() + old_size,
+              lazy_function_log_.ToVector().start(),
+              new_size);
+  script_->set_lazy_function_data(*data);
+  lazy_function_log_.Rewind(0);
+}
+
+
 Expression* Parser::ParseV8Intrinsic(bool* ok) {
   // CallRuntime ::
   //   '%' Identifier Arguments
@@ -5237,8 +5539,14 @@ void ScriptDataImpl::Initialize() {
   // Prepares state for use.
   if (store_.length() >= PreparseDataConstants::kHeaderSize) {
     function_index_ = PreparseDataConstants::kHeaderSize;
-    int symbol_data_offset = PreparseDataConstants::kHeaderSize
+    int hot_functions_offset = PreparseDataConstants::kHeaderSize
         + store_[PreparseDataConstants::kFunctionsSizeOffset];
+    int symbol_data_offset = hot_functions_offset
+        + store_[PreparseDataConstants::kHotFunctionsSizeOffset];
+    if (!has_error() && store_.length() >= symbol_data_offset) {
+      hot_functions_ =
+          store_.SubVector(hot_functions_offset, symbol_data_offset);
+    }
     if (store_.length() > symbol_data_offset) {
       symbol_data_ = reinterpret_cast<byte*>(&store_[symbol_data_offset]);
     } else {
@@ -5280,10 +5588,20 @@ int ScriptDataImpl::ReadNumber(byte** source) {
 // Create a Scanner for the preparser to use as input, and preparse the source.
 ScriptDataImpl* PreParserApi::PreParse(Isolate* isolate,
                                        Utf16CharacterStream* source) {
-  CompleteParserRecorder recorder;
   HistogramTimerScope timer(isolate->counters()->pre_parse());
-  Scanner scanner(isolate->unicode_cache());
-  intptr_t stack_limit = isolate->stack_guard()->real_climit();
+  ScriptDataImpl* result = PreParse(isolate->unicode_cache(),
+                                    source,
+                                    isolate->stack_guard()->real_climit());
+  if (result == NULL) isolate->StackOverflow();
+  return result;
+}
+
+
+ScriptDataImpl* PreParserApi::PreParse(UnicodeCache* unicode_cache,
+                                       Utf16CharacterStream* source,
+                                       uintptr_t stack_limit) {
+  CompleteParserRecorder recorder;
+  Scanner scanner(unicode_cache);
   PreParser preparser(&scanner, &recorder, stack_limit);
   preparser.set_allow_lazy(true);
   preparser.set_allow_generators(FLAG_harmony_generators);
@@ -5292,10 +5610,7 @@ ScriptDataImpl* PreParserApi::PreParse(Isolate* isolate,
   preparser.set_allow_harmony_numeric_literals(FLAG_harmony_numeric_literals);
   scanner.Initialize(source);
   PreParser::PreParseResult result = preparser.PreParseProgram();
-  if (result == PreParser::kPreParseStackOverflow) {
-    isolate->StackOverflow();
-    return NULL;
-  }
+  if (result == PreParser::kPreParseStackOverflow) return NULL;
 
   // Extract the accumulated data from the recorder as a single
   // contiguous vector that we are responsible for disposing.
@@ -42,6 +42,7 @@ class CompilationInfo;
 class FuncNameInferrer;
 class ParserLog;
 class PositionStack;
+class SymbolCollectingLogger;
 class Target;
 
 template <typename T> class ZoneListWrapper;
@@ -100,6 +101,9 @@ class ScriptDataImpl : public ScriptData {
   void ReadNextSymbolPosition();
 
   FunctionEntry GetFunctionEntry(int start);
+  // Whether the preparser predicted that the function declared with its
+  // name at |name_position| is called while the script is loaded.
+  bool IsHotFunction(int name_position);
   int GetSymbolIdentifier();
   bool SanityCheck();
 
@@ -120,6 +124,7 @@ class ScriptDataImpl : public ScriptData {
 
  private:
   Vector<unsigned> store_;
+  Vector<unsigned> hot_functions_;
   unsigned char* symbol_data_;
   unsigned char* symbol_data_end_;
   int function_index_;
@@ -154,6 +159,13 @@ class PreParserApi {
   // the preparser doesn't know about ScriptDataImpl.
   static ScriptDataImpl* PreParse(Isolate* isolate,
                                   Utf16CharacterStream* source);
+
+  // Pre-parse a character stream without accessing any isolate, so that this
+  // can run on a thread other than the one owning the isolate.  Returns NULL
+  // if the preparser runs into |stack_limit|.
+  static ScriptDataImpl* PreParse(UnicodeCache* unicode_cache,
+                                  Utf16CharacterStream* source,
+                                  uintptr_t stack_limit);
 };
 
 
@@ -745,6 +757,22 @@ class Parser : public ParserBase<ParserTraits> {
   PreParser::PreParseResult LazyParseFunctionLiteral(
        SingletonLogger* logger);
 
+  // Declares an unresolved reference for a name that occurs in the body of
+  // a skipped inner function.
+  void DeclareSkippedFunctionSymbol(bool is_ascii, Vector<const byte> literal);
+
+  // Preparse results of skipped inner functions are kept on the script as
+  // records of a FunctionEntry followed by the symbols of the body (see
+  // --cache-lazy-function-data). Reparsing the outer function then skips
+  // the inner functions without scanning them again.
+  void LoadLazyFunctionData(int start_position, int end_position);
+  bool SkipCachedLazyFunction(int function_block_pos,
+                              int* literal_count,
+                              int* property_count);
+  void LogLazyFunction(int function_block_pos,
+                       SymbolCollectingLogger* logger);
+  void StoreLazyFunctionData();
+
   Isolate* isolate_;
   ZoneList<Handle<String> > symbol_cache_;
 
@@ -758,6 +786,16 @@ class Parser : public ParserBase<ParserTraits> {
 
   Mode mode_;
 
+  // Set by ParseLazy when the inner functions of the function being
+  // compiled are to be preparsed, see SharedFunctionInfo.
+  bool lazy_inner_functions_;
+
+  // Records loaded from the script, and records of the inner functions
+  // preparsed by this parser.
+  ZoneList<unsigned> cached_lazy_function_data_;
+  int cached_lazy_function_cursor_;
+  ZoneList<unsigned> lazy_function_log_;
+
   CompilationInfo* info_;
 };
 
@@ -455,4 +455,13 @@ bool VirtualMemory::HasLazyCommits() {
   return true;
 }
 
+
+bool VirtualMemory::AdviseHugePages(void* base, size_t size) {
+#if defined(MADV_HUGEPAGE)
+  return madvise(base, size, MADV_HUGEPAGE) == 0;
+#else
+  return false;
+#endif
+}
+
 } }  // namespace v8::internal
@@ -361,4 +361,9 @@ bool VirtualMemory::HasLazyCommits() {
   return false;
 }
 
+
+bool VirtualMemory::AdviseHugePages(void* base, size_t size) {
+  return false;
+}
+
 } }  // namespace v8::internal
@@ -398,4 +398,9 @@ bool VirtualMemory::HasLazyCommits() {
   return false;
 }
 
+
+bool VirtualMemory::AdviseHugePages(void* base, size_t size) {
+  return false;
+}
+
 } }  // namespace v8::internal
@@ -1408,6 +1408,11 @@ bool VirtualMemory::HasLazyCommits() {
 }
 
 
+bool VirtualMemory::AdviseHugePages(void* base, size_t size) {
+  return false;
+}
+
+
 // ----------------------------------------------------------------------------
 // Win32 thread support.
 
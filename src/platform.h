@@ -493,6 +493,10 @@ class VirtualMemory {
   // Otherwise returns false.
   static bool HasLazyCommits();
 
+  // Asks the OS to back the committed region with transparent huge pages.
+  // Returns false if the OS does not support it.
+  static bool AdviseHugePages(void* base, size_t size);
+
  private:
   void* address_;  // Start address of the virtual memory.
   size_t size_;  // Size of the virtual memory.
@@ -46,6 +46,17 @@ static V8_INLINE void InitializeNativeHandle(pthread_mutex_t* mutex) {
   result = pthread_mutex_init(mutex, &attr);
   ASSERT_EQ(0, result);
   result = pthread_mutexattr_destroy(&attr);
+#elif defined(__GLIBC__)
+  // Use an adaptive mutex, which spins for a short while in user space
+  // before parking the thread on its futex.
+  pthread_mutexattr_t attr;
+  result = pthread_mutexattr_init(&attr);
+  ASSERT_EQ(0, result);
+  result = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+  ASSERT_EQ(0, result);
+  result = pthread_mutex_init(mutex, &attr);
+  ASSERT_EQ(0, result);
+  result = pthread_mutexattr_destroy(&attr);
 #else
   // Use a fast mutex (default attributes).
   result = pthread_mutex_init(mutex, NULL);
@@ -133,7 +144,7 @@ static V8_INLINE bool TryLockNativeHandle(PCRITICAL_SECTION cs) {
 #endif  // V8_OS_POSIX
 
 
-Mutex::Mutex() {
+Mutex::Mutex() : contention_count_(0) {
   InitializeNativeHandle(&native_handle_);
 #ifdef DEBUG
   level_ = 0;
@@ -148,7 +159,14 @@ Mutex::~Mutex() {
 
 
 void Mutex::Lock() {
-  LockNativeHandle(&native_handle_);
+  // The uncontended case is a single atomic operation; only measure the
+  // wait when the mutex is already owned.
+  if (!TryLockNativeHandle(&native_handle_)) {
+    TimeTicks start = TimeTicks::Now();
+    LockNativeHandle(&native_handle_);
+    contention_count_++;
+    contention_time_ += TimeTicks::Now() - start;
+  }
   AssertUnheldAndMark();
 }
 
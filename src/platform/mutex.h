@@ -29,6 +29,7 @@
 #define V8_PLATFORM_MUTEX_H_
 
 #include "../lazy-instance.h"
+#include "time.h"
 #if V8_OS_WIN
 #include "../win32-headers.h"
 #endif
@@ -74,6 +75,13 @@ class Mutex V8_FINAL {
   // successfully locked.
   bool TryLock() V8_WARN_UNUSED_RESULT;
 
+  // Number of |Lock()| calls that found the mutex owned by another thread,
+  // and the total time they spent waiting for it. Both are only updated
+  // while the mutex is held, so read them with the mutex locked to get a
+  // consistent snapshot.
+  int contention_count() const { return contention_count_; }
+  TimeDelta contention_time() const { return contention_time_; }
+
   // The implementation-defined native handle type.
 #if V8_OS_POSIX
   typedef pthread_mutex_t NativeHandle;
@@ -90,6 +98,8 @@ class Mutex V8_FINAL {
 
  private:
   NativeHandle native_handle_;
+  int contention_count_;
+  TimeDelta contention_time_;
 #ifdef DEBUG
   int level_;
 #endif
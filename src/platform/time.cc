@@ -34,8 +34,10 @@
 #include <mach/mach_time.h>
 #endif
 
+#include <stdio.h>
 #include <string.h>
 
+#include "atomicops.h"
 #include "checks.h"
 #include "cpu.h"
 #include "platform.h"
@@ -541,6 +543,131 @@ bool TimeTicks::IsHighResolutionClockWorking() {
 
 #else  // V8_OS_WIN
 
+#if V8_OS_LINUX && (V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64) && \
+    !V8_LIBRT_NOT_AVAILABLE
+
+// On Linux/x86 the monotonic clock can be derived from the time stamp counter
+// much cheaper than through clock_gettime(), but only if the TSC is invariant
+// and the kernel itself trusts it as its clocksource (otherwise the kernel
+// has found the TSC to be unsynchronized or unstable on this machine). The
+// TSC frequency is calibrated against CLOCK_MONOTONIC during a short window
+// following the first call; until calibration is complete, and whenever the
+// TSC is not usable, the ticks come from clock_gettime().
+enum TscClockState {
+  kTscClockUninitialized,
+  kTscClockInitializing,
+  kTscClockCalibrating,
+  kTscClockFinishing,
+  kTscClockCalibrated,
+  kTscClockUnavailable
+};
+
+static const int64_t kTscCalibrationMicroseconds =
+    250 * Time::kMicrosecondsPerMillisecond;
+
+static Atomic32 tsc_clock_state = kTscClockUninitialized;
+static int64_t tsc_base_microseconds = 0;
+static uint64_t tsc_base = 0;
+static double tsc_microseconds_per_tick = 0.0;
+
+
+static inline uint64_t ReadTimeStampCounter() {
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+
+
+static int64_t ClockMonotonicNow() {
+  struct timespec ts;
+  int result = clock_gettime(CLOCK_MONOTONIC, &ts);
+  ASSERT_EQ(0, result);
+  USE(result);
+  return (ts.tv_sec * Time::kMicrosecondsPerSecond +
+          ts.tv_nsec / Time::kNanosecondsPerMicrosecond);
+}
+
+
+// Samples the monotonic clock together with the TSC. The TSC is read on both
+// sides of clock_gettime() to keep the pair as tight as possible.
+static void SampleClocks(int64_t* microseconds, uint64_t* tsc) {
+  uint64_t before = ReadTimeStampCounter();
+  *microseconds = ClockMonotonicNow();
+  uint64_t after = ReadTimeStampCounter();
+  *tsc = before + (after - before) / 2;
+}
+
+
+static bool KernelUsesTscClockSource() {
+  FILE* file = fopen(
+      "/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+  if (file == NULL) return false;
+  char name[16];
+  bool result = fgets(name, sizeof(name), file) != NULL &&
+                strcmp(name, "tsc\n") == 0;
+  fclose(file);
+  return result;
+}
+
+
+// Returns the current ticks in microseconds, or false if the caller has to
+// fall back to clock_gettime().
+static bool TscClockNow(int64_t* ticks) {
+  Atomic32 state = Acquire_Load(&tsc_clock_state);
+  if (state == kTscClockCalibrated) {
+    int64_t delta = static_cast<int64_t>(ReadTimeStampCounter() - tsc_base);
+    *ticks = tsc_base_microseconds +
+        static_cast<int64_t>(delta * tsc_microseconds_per_tick);
+    return true;
+  }
+  if (state == kTscClockUninitialized) {
+    if (NoBarrier_CompareAndSwap(&tsc_clock_state,
+                                 kTscClockUninitialized,
+                                 kTscClockInitializing) !=
+        kTscClockUninitialized) {
+      return false;
+    }
+    CPU cpu;
+    if (!cpu.has_non_stop_time_stamp_counter() ||
+        !KernelUsesTscClockSource()) {
+      Release_Store(&tsc_clock_state, kTscClockUnavailable);
+      return false;
+    }
+    SampleClocks(&tsc_base_microseconds, &tsc_base);
+    Release_Store(&tsc_clock_state, kTscClockCalibrating);
+    *ticks = tsc_base_microseconds;
+    return true;
+  }
+  if (state == kTscClockCalibrating) {
+    int64_t now;
+    uint64_t tsc;
+    SampleClocks(&now, &tsc);
+    if (now - tsc_base_microseconds >= kTscCalibrationMicroseconds &&
+        NoBarrier_CompareAndSwap(&tsc_clock_state,
+                                 kTscClockCalibrating,
+                                 kTscClockFinishing) == kTscClockCalibrating) {
+      if (tsc <= tsc_base) {
+        Release_Store(&tsc_clock_state, kTscClockUnavailable);
+      } else {
+        // The rate is derived from the base sample, so the first TSC based
+        // reading continues seamlessly from this clock_gettime() sample.
+        tsc_microseconds_per_tick =
+            static_cast<double>(now - tsc_base_microseconds) /
+            static_cast<double>(tsc - tsc_base);
+        Release_Store(&tsc_clock_state, kTscClockCalibrated);
+      }
+    }
+    *ticks = now;
+    return true;
+  }
+  // Either the TSC is unavailable, or another thread is currently
+  // initializing or finishing the calibration.
+  return false;
+}
+
+#endif
+
+
 TimeTicks TimeTicks::Now() {
   return HighResolutionNow();
 }
@@ -568,6 +695,8 @@ TimeTicks TimeTicks::HighResolutionNow() {
   ASSERT_EQ(0, result);
   USE(result);
   ticks = (tv.tv_sec * Time::kMicrosecondsPerSecond + tv.tv_usec);
+#elif V8_OS_LINUX && (V8_HOST_ARCH_IA32 || V8_HOST_ARCH_X64)
+  if (!TscClockNow(&ticks)) ticks = ClockMonotonicNow();
 #elif V8_OS_POSIX
   struct timespec ts;
   int result = clock_gettime(CLOCK_MONOTONIC, &ts);
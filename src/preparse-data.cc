@@ -42,6 +42,7 @@ namespace internal {
 
 FunctionLoggingParserRecorder::FunctionLoggingParserRecorder()
     : function_store_(0),
+      hot_function_store_(0),
       is_recording_(true),
       pause_count_(0) {
   preamble_[PreparseDataConstants::kMagicOffset] =
@@ -52,7 +53,8 @@ FunctionLoggingParserRecorder::FunctionLoggingParserRecorder()
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = 0;
   preamble_[PreparseDataConstants::kSymbolCountOffset] = 0;
   preamble_[PreparseDataConstants::kSizeOffset] = 0;
-  ASSERT_EQ(6, PreparseDataConstants::kHeaderSize);
+  preamble_[PreparseDataConstants::kHotFunctionsSizeOffset] = 0;
+  ASSERT_EQ(7, PreparseDataConstants::kHeaderSize);
 #ifdef DEBUG
   prev_start_ = -1;
 #endif
@@ -66,6 +68,7 @@ void FunctionLoggingParserRecorder::LogMessage(int start_pos,
   if (has_error()) return;
   preamble_[PreparseDataConstants::kHasErrorOffset] = true;
   function_store_.Reset();
+  hot_function_store_.Reset();
   STATIC_ASSERT(PreparseDataConstants::kMessageStartPos == 0);
   function_store_.Add(start_pos);
   STATIC_ASSERT(PreparseDataConstants::kMessageEndPos == 1);
@@ -87,21 +90,35 @@ void FunctionLoggingParserRecorder::WriteString(Vector<const char> str) {
 }
 
 
+void FunctionLoggingParserRecorder::WriteHotFunctions(Vector<unsigned> data) {
+  ASSERT_EQ(hot_function_store_.size(), data.length());
+  if (data.is_empty()) return;
+  hot_function_store_.WriteTo(data);
+  // The parser looks positions up with a binary search.
+  data.Sort();
+}
+
+
 // ----------------------------------------------------------------------------
 // PartialParserRecorder -  Record both function entries and symbols.
 
 Vector<unsigned> PartialParserRecorder::ExtractData() {
   int function_size = function_store_.size();
-  int total_size = PreparseDataConstants::kHeaderSize + function_size;
+  int hot_function_size = hot_function_store_.size();
+  int total_size = PreparseDataConstants::kHeaderSize + function_size
+      + hot_function_size;
   Vector<unsigned> data = Vector<unsigned>::New(total_size);
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = function_size;
+  preamble_[PreparseDataConstants::kHotFunctionsSizeOffset] =
+      hot_function_size;
   preamble_[PreparseDataConstants::kSymbolCountOffset] = 0;
   OS::MemCopy(data.start(), preamble_, sizeof(preamble_));
-  int symbol_start = PreparseDataConstants::kHeaderSize + function_size;
+  int hot_function_start = PreparseDataConstants::kHeaderSize + function_size;
   if (function_size > 0) {
     function_store_.WriteTo(data.SubVector(PreparseDataConstants::kHeaderSize,
-                                           symbol_start));
+                                           hot_function_start));
   }
+  WriteHotFunctions(data.SubVector(hot_function_start, total_size));
   return data;
 }
 
@@ -147,17 +164,22 @@ Vector<unsigned> CompleteParserRecorder::ExtractData() {
   int padding = sizeof(unsigned) - (symbol_size % sizeof(unsigned));
   symbol_store_.AddBlock(padding, PreparseDataConstants::kNumberTerminator);
   symbol_size += padding;
+  int hot_function_size = hot_function_store_.size();
   int total_size = PreparseDataConstants::kHeaderSize + function_size
-      + (symbol_size / sizeof(unsigned));
+      + hot_function_size + (symbol_size / sizeof(unsigned));
   Vector<unsigned> data = Vector<unsigned>::New(total_size);
   preamble_[PreparseDataConstants::kFunctionsSizeOffset] = function_size;
+  preamble_[PreparseDataConstants::kHotFunctionsSizeOffset] =
+      hot_function_size;
   preamble_[PreparseDataConstants::kSymbolCountOffset] = symbol_id_;
   OS::MemCopy(data.start(), preamble_, sizeof(preamble_));
-  int symbol_start = PreparseDataConstants::kHeaderSize + function_size;
+  int hot_function_start = PreparseDataConstants::kHeaderSize + function_size;
+  int symbol_start = hot_function_start + hot_function_size;
   if (function_size > 0) {
     function_store_.WriteTo(data.SubVector(PreparseDataConstants::kHeaderSize,
-                                           symbol_start));
+                                           hot_function_start));
   }
+  WriteHotFunctions(data.SubVector(hot_function_start, symbol_start));
   if (!has_error()) {
     symbol_store_.WriteTo(
         Vector<byte>::cast(data.SubVector(symbol_start, total_size)));
@@ -51,6 +51,10 @@ class ParserRecorder {
                            int properties,
                            LanguageMode language_mode) = 0;
 
+  // Logs that the function declared with its name at |name_position| is
+  // likely to be called while the script is loaded.
+  virtual void LogHotFunction(int name_position) { }
+
   // Logs a symbol creation of a literal or identifier.
   virtual void LogAsciiSymbol(int start, Vector<const char> literal) { }
   virtual void LogUtf16Symbol(int start, Vector<const uc16> literal) { }
@@ -97,6 +101,10 @@ class FunctionLoggingParserRecorder : public ParserRecorder {
     function_store_.Add(language_mode);
   }
 
+  virtual void LogHotFunction(int name_position) {
+    if (!has_error()) hot_function_store_.Add(name_position);
+  }
+
   // Logs an error message and marks the log as containing an error.
   // Further logging will be ignored, and ExtractData will return a vector
   // representing the error only.
@@ -131,7 +139,12 @@ class FunctionLoggingParserRecorder : public ParserRecorder {
 
   void WriteString(Vector<const char> str);
 
+  // Writes the sorted hot function positions into |data|, which must have
+  // room for hot_function_store_.size() entries.
+  void WriteHotFunctions(Vector<unsigned> data);
+
   Collector<unsigned> function_store_;
+  Collector<unsigned> hot_function_store_;
   unsigned preamble_[PreparseDataConstants::kHeaderSize];
   bool is_recording_;
   int pause_count_;
@@ -352,6 +352,9 @@ PreParser::Statement PreParser::ParseFunctionDeclaration(bool* ok) {
   bool is_strict_reserved = false;
   Identifier name = ParseIdentifierOrStrictReservedWord(
       &is_strict_reserved, CHECK_OK);
+  if (scope_->type() == GLOBAL_SCOPE && allow_lazy()) {
+    RecordTopLevelFunction(scanner()->location().beg_pos);
+  }
   ParseFunctionLiteral(name,
                        scanner()->location(),
                        is_strict_reserved,
@@ -1004,6 +1007,11 @@ PreParser::Expression PreParser::ParseLeftHandSideExpression(bool* ok) {
       }
 
       case Token::LPAREN: {
+        if (result.IsIdentifier() &&
+            scanner()->current_token() == Token::IDENTIFIER &&
+            !inside_lazy_body_) {
+          RecordCall();
+        }
         ParseArguments(CHECK_OK);
         result = Expression::Default();
         break;
@@ -1341,7 +1349,10 @@ PreParser::Expression PreParser::ParseFunctionLiteral(
 void PreParser::ParseLazyFunctionLiteralBody(bool* ok) {
   int body_start = position();
   log_->PauseRecording();
+  bool was_inside_lazy_body = inside_lazy_body_;
+  inside_lazy_body_ = true;
   ParseSourceElements(Token::RBRACE, ok);
+  inside_lazy_body_ = was_inside_lazy_body;
   log_->ResumeRecording();
   if (!*ok) return;
 
@@ -1373,6 +1384,35 @@ PreParser::Expression PreParser::ParseV8Intrinsic(bool* ok) {
 #undef CHECK_OK
 
 
+void PreParser::RecordTopLevelFunction(int name_position) {
+  int previous =
+      AddCurrentSymbol(&top_level_functions_, (name_position + 1) << 1);
+  if ((previous >> 1) != 0) {
+    // Do not guess which of several declarations a call refers to.
+    AddCurrentSymbol(&redeclared_functions_, 1);
+  } else if ((previous & 1) != 0) {
+    log_->LogHotFunction(name_position);
+  }
+}
+
+
+void PreParser::RecordCall() {
+  int previous = AddCurrentSymbol(&top_level_functions_, 1);
+  if ((previous & 1) == 0 && (previous >> 1) != 0 &&
+      AddCurrentSymbol(&redeclared_functions_, 0) == 0) {
+    log_->LogHotFunction((previous >> 1) - 1);
+  }
+}
+
+
+int PreParser::AddCurrentSymbol(DuplicateFinder* finder, int value) {
+  if (scanner()->is_literal_ascii()) {
+    return finder->AddAsciiSymbol(scanner()->literal_ascii_string(), value);
+  }
+  return finder->AddUtf16Symbol(scanner()->literal_utf16_string(), value);
+}
+
+
 void PreParser::LogSymbol() {
   int identifier_pos = position();
   if (scanner()->is_literal_ascii()) {
@@ -748,7 +748,10 @@ class PreParser : public ParserBase<PreParserTraits> {
             ParserRecorder* log,
             uintptr_t stack_limit)
       : ParserBase<PreParserTraits>(scanner, stack_limit, NULL, NULL, this),
-        log_(log) {}
+        log_(log),
+        top_level_functions_(scanner->unicode_cache()),
+        redeclared_functions_(scanner->unicode_cache()),
+        inside_lazy_body_(false) {}
 
   // Pre-parse the program from the character stream; returns true on
   // success (even if parsing failed, the pre-parse data successfully
@@ -911,9 +914,22 @@ class PreParser : public ParserBase<PreParserTraits> {
   // Log the currently parsed string literal.
   Expression GetStringSymbol();
 
+  // Hot function prediction. A top-level function declaration that is
+  // called directly by its name outside of lazily parsed function bodies,
+  // before or after the declaration, is logged as hot, so that the parser
+  // compiles it together with the script instead of on the first call.
+  // Both take the name from the current identifier token.
+  void RecordTopLevelFunction(int name_position);
+  void RecordCall();
+  int AddCurrentSymbol(DuplicateFinder* finder, int value);
+
   bool CheckInOrOf(bool accept_OF);
 
   ParserRecorder* log_;
+  // Maps names to (name position + 1) << 1, or'ed with 1 once called.
+  DuplicateFinder top_level_functions_;
+  DuplicateFinder redeclared_functions_;
+  bool inside_lazy_body_;
 };
 
 
@@ -355,6 +355,8 @@ void ProfileTree::TraverseDepthFirst(Callback* callback) {
 CpuProfile::CpuProfile(const char* title, bool record_samples)
     : title_(title),
       record_samples_(record_samples),
+      max_samples_(FLAG_cpu_profiler_max_samples),
+      first_sample_(0),
       start_time_(Time::NowFromSystemTime()) {
   timer_.Start();
 }
@@ -362,7 +364,18 @@ CpuProfile::CpuProfile(const char* title, bool record_samples)
 
 void CpuProfile::AddPath(const Vector<CodeEntry*>& path) {
   ProfileNode* top_frame_node = top_down_.AddPathFromEnd(path);
-  if (record_samples_) samples_.Add(top_frame_node);
+  if (!record_samples_) return;
+  TimeDelta timestamp = timer_.Elapsed();
+  if (max_samples_ > 0 && samples_.length() == max_samples_) {
+    // Overwrite the oldest sample, so that a long running profile only
+    // holds on to the most recent ones.
+    samples_[first_sample_] = top_frame_node;
+    timestamps_[first_sample_] = timestamp;
+    first_sample_ = (first_sample_ + 1) % max_samples_;
+  } else {
+    samples_.Add(top_frame_node);
+    timestamps_.Add(timestamp);
+  }
 }
 
 
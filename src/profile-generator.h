@@ -206,7 +206,12 @@ class CpuProfile {
   const ProfileTree* top_down() const { return &top_down_; }
 
   int samples_count() const { return samples_.length(); }
-  ProfileNode* sample(int index) const { return samples_.at(index); }
+  ProfileNode* sample(int index) const {
+    return samples_.at(SampleSlot(index));
+  }
+  Time sample_timestamp(int index) const {
+    return start_time_ + timestamps_.at(SampleSlot(index));
+  }
 
   Time start_time() const { return start_time_; }
   Time end_time() const { return end_time_; }
@@ -216,12 +221,21 @@ class CpuProfile {
   void Print();
 
  private:
+  // Once max_samples_ is reached the samples are kept in a ring buffer
+  // and first_sample_ is the slot of the oldest one.
+  int SampleSlot(int index) const {
+    return (first_sample_ + index) % samples_.length();
+  }
+
   const char* title_;
   bool record_samples_;
+  int max_samples_;
+  int first_sample_;
   Time start_time_;
   Time end_time_;
   ElapsedTimer timer_;
   List<ProfileNode*> samples_;
+  List<TimeDelta> timestamps_;
   ProfileTree top_down_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfile);
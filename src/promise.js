@@ -172,28 +172,35 @@ function PromiseCatch(onReject) {
   return this.chain(UNDEFINED, onReject);
 }
 
+// The microtask queue calls each handler and passes the result to
+// PromiseHandleResult, or the exception to PromiseHandleError. Catching the
+// exceptions in C++ keeps these functions free of try/catch, so that they
+// can be optimized.
 function PromiseEnqueue(value, tasks) {
-  GetMicrotaskQueue().push(function() {
-    for (var i = 0; i < tasks.length; i += 2) {
-      PromiseHandle(value, tasks[i], tasks[i + 1])
-    }
-  });
+  %EnqueuePromiseReactionJob(value, tasks);
+}
+
+function PromiseHandleResult(result, deferred) {
+  if (result === deferred.promise)
+    throw MakeTypeError('promise_cyclic', [result]);
+  else if (IsPromise(result))
+    result.chain(deferred.resolve, deferred.reject);
+  else
+    deferred.resolve(result);
+}
 
-  %SetMicrotaskPending(true);
+function PromiseHandleError(e, deferred) {
+  // TODO(rossberg): perhaps log uncaught exceptions here. Exceptions thrown
+  // by reject are ignored by the caller.
+  deferred.reject(e);
 }
 
+// Used by the microtask queue for handlers that are not functions.
 function PromiseHandle(value, handler, deferred) {
   try {
-    var result = handler(value);
-    if (result === deferred.promise)
-      throw MakeTypeError('promise_cyclic', [result]);
-    else if (IsPromise(result))
-      result.chain(deferred.resolve, deferred.reject);
-    else
-      deferred.resolve(result);
+    PromiseHandleResult(handler(value), deferred);
   } catch(e) {
-    // TODO(rossberg): perhaps log uncaught exceptions below.
-    try { deferred.reject(e) } catch(e) {}
+    try { PromiseHandleError(e, deferred) } catch(e) {}
   }
 }
 
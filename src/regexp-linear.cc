@@ -0,0 +1,598 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "ast.h"
+#include "char-predicates-inl.h"
+#include "jsregexp.h"
+#include "regexp-linear.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Instructions of the linear matcher.  Operands follow the opcode.
+enum LinearOpcode {
+  LINEAR_CHAR,    // char: consume a character equal to char.
+  LINEAR_CLASS,   // count, from_0, to_0, ...: consume a character in a range.
+  LINEAR_SPLIT,   // first, second: continue at both, preferring first.
+  LINEAR_JMP,     // target: continue at target.
+  LINEAR_SAVE,    // register: store the current position in register.
+  LINEAR_CLEAR,   // from, to: reset the registers in [from, to].
+  LINEAR_ASSERT,  // type: check a RegExpAssertion::AssertionType.
+  LINEAR_MATCH    // the pattern has matched.
+};
+
+
+class RegExpLinearCompiler : public RegExpVisitor {
+ public:
+  RegExpLinearCompiler(bool ignore_case, Zone* zone)
+      : code_(64, zone),
+        ignore_case_(ignore_case),
+        max_threads_(0),
+        failed_(false),
+        zone_(zone) { }
+
+  // Returns false if the tree cannot be compiled for the linear matcher.
+  bool Compile(RegExpTree* tree) {
+    Emit(tree->IsAnchoredAtStart() ? 1 : 0);
+    Emit(0);
+    ASSERT_EQ(RegExpLinear::kCodeStartIndex, pc());
+    EmitSave(RegExpCapture::StartRegister(0));
+    tree->Accept(this, NULL);
+    EmitSave(RegExpCapture::EndRegister(0));
+    Emit(LINEAR_MATCH);
+    max_threads_++;
+    code_[RegExpLinear::kMaxThreadsIndex] = max_threads_;
+    return !HasFailed();
+  }
+
+  ZoneList<int>* code() { return &code_; }
+
+#define MAKE_CASE(Name) virtual void* Visit##Name(RegExp##Name*,          \
+                                                  void* data) V8_OVERRIDE;
+  FOR_EACH_REG_EXP_TREE_TYPE(MAKE_CASE)
+#undef MAKE_CASE
+
+ private:
+  int pc() { return code_.length(); }
+  void Emit(int word) { code_.Add(word, zone_); }
+
+  bool HasFailed() {
+    if (pc() > RegExpLinear::kMaxProgramLength) failed_ = true;
+    return failed_;
+  }
+
+  void EmitSave(int reg) {
+    Emit(LINEAR_SAVE);
+    Emit(reg);
+  }
+
+  void EmitClear(Interval registers) {
+    if (registers.is_empty()) return;
+    Emit(LINEAR_CLEAR);
+    Emit(registers.from());
+    Emit(registers.to());
+  }
+
+  int EmitSplit() {
+    int at = pc();
+    Emit(LINEAR_SPLIT);
+    Emit(0);
+    Emit(0);
+    return at;
+  }
+
+  void PatchSplit(int at, int first, int second) {
+    ASSERT_EQ(LINEAR_SPLIT, code_[at]);
+    code_[at + 1] = first;
+    code_[at + 2] = second;
+  }
+
+  int EmitJmp() {
+    int at = pc();
+    Emit(LINEAR_JMP);
+    Emit(0);
+    return at;
+  }
+
+  void PatchJmp(int at, int target) {
+    ASSERT_EQ(LINEAR_JMP, code_[at]);
+    code_[at + 1] = target;
+  }
+
+  // Emits a test for a character in the given canonical ranges.
+  void EmitRanges(ZoneList<CharacterRange>* ranges) {
+    max_threads_++;
+    if (ranges->length() == 1 && ranges->at(0).IsSingleton()) {
+      Emit(LINEAR_CHAR);
+      Emit(ranges->at(0).from());
+      return;
+    }
+    Emit(LINEAR_CLASS);
+    Emit(ranges->length());
+    for (int i = 0; i < ranges->length(); i++) {
+      Emit(ranges->at(i).from());
+      Emit(ranges->at(i).to());
+    }
+  }
+
+  void EmitCharacter(uc16 c) {
+    if (!ignore_case_) {
+      max_threads_++;
+      Emit(LINEAR_CHAR);
+      Emit(c);
+      return;
+    }
+    ZoneList<CharacterRange>* ranges =
+        new(zone_) ZoneList<CharacterRange>(2, zone_);
+    ranges->Add(CharacterRange::Singleton(c), zone_);
+    CharacterRange::Singleton(c).AddCaseEquivalents(ranges, false, zone_);
+    CharacterRange::Canonicalize(ranges);
+    EmitRanges(ranges);
+  }
+
+  ZoneList<int> code_;
+  bool ignore_case_;
+  int max_threads_;
+  bool failed_;
+  Zone* zone_;
+};
+
+
+void* RegExpLinearCompiler::VisitDisjunction(RegExpDisjunction* that,
+                                             void* data) {
+  ZoneList<RegExpTree*>* alternatives = that->alternatives();
+  ZoneList<int> jumps(alternatives->length(), zone_);
+  for (int i = 0; i < alternatives->length() - 1; i++) {
+    int split = EmitSplit();
+    int first = pc();
+    alternatives->at(i)->Accept(this, data);
+    jumps.Add(EmitJmp(), zone_);
+    PatchSplit(split, first, pc());
+    if (HasFailed()) return NULL;
+  }
+  alternatives->last()->Accept(this, data);
+  for (int i = 0; i < jumps.length(); i++) PatchJmp(jumps[i], pc());
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitAlternative(RegExpAlternative* that,
+                                             void* data) {
+  ZoneList<RegExpTree*>* nodes = that->nodes();
+  for (int i = 0; i < nodes->length() && !HasFailed(); i++) {
+    nodes->at(i)->Accept(this, data);
+  }
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitAssertion(RegExpAssertion* that,
+                                           void* data) {
+  Emit(LINEAR_ASSERT);
+  Emit(that->assertion_type());
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitCharacterClass(RegExpCharacterClass* that,
+                                                void* data) {
+  ZoneList<CharacterRange>* source = that->ranges(zone_);
+  ZoneList<CharacterRange>* ranges =
+      new(zone_) ZoneList<CharacterRange>(source->length(), zone_);
+  ranges->AddAll(*source, zone_);
+  if (ignore_case_) {
+    for (int i = 0; i < source->length(); i++) {
+      source->at(i).AddCaseEquivalents(ranges, false, zone_);
+    }
+  }
+  CharacterRange::Canonicalize(ranges);
+  if (that->is_negated()) {
+    ZoneList<CharacterRange>* negated =
+        new(zone_) ZoneList<CharacterRange>(ranges->length() + 1, zone_);
+    CharacterRange::Negate(ranges, negated, zone_);
+    ranges = negated;
+  }
+  EmitRanges(ranges);
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitAtom(RegExpAtom* that, void* data) {
+  Vector<const uc16> chars = that->data();
+  for (int i = 0; i < chars.length() && !HasFailed(); i++) {
+    EmitCharacter(chars[i]);
+  }
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitText(RegExpText* that, void* data) {
+  ZoneList<TextElement>* elements = that->elements();
+  for (int i = 0; i < elements->length() && !HasFailed(); i++) {
+    TextElement element = elements->at(i);
+    if (element.text_type() == TextElement::ATOM) {
+      VisitAtom(element.atom(), data);
+    } else {
+      VisitCharacterClass(element.char_class(), data);
+    }
+  }
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitQuantifier(RegExpQuantifier* that,
+                                            void* data) {
+  if (that->is_possessive()) {
+    failed_ = true;
+    return NULL;
+  }
+  // Captures inside the body are reset on each iteration, as required by
+  // ECMA-262 15.10.2.5.
+  Interval captures = that->body()->CaptureRegisters();
+  for (int i = 0; i < that->min() && !HasFailed(); i++) {
+    EmitClear(captures);
+    that->body()->Accept(this, data);
+  }
+  if (that->max() == RegExpTree::kInfinity) {
+    int loop = EmitSplit();
+    int body = pc();
+    EmitClear(captures);
+    that->body()->Accept(this, data);
+    PatchJmp(EmitJmp(), loop);
+    if (that->is_greedy()) {
+      PatchSplit(loop, body, pc());
+    } else {
+      PatchSplit(loop, pc(), body);
+    }
+    return NULL;
+  }
+  ZoneList<int> splits(2, zone_);
+  for (int i = that->min(); i < that->max() && !HasFailed(); i++) {
+    splits.Add(EmitSplit(), zone_);
+    EmitClear(captures);
+    that->body()->Accept(this, data);
+  }
+  // Each optional copy is entered from the previous one, and leaving any
+  // of them skips all the remaining copies.
+  for (int i = 0; i < splits.length(); i++) {
+    int body = splits[i] + 3;
+    if (that->is_greedy()) {
+      PatchSplit(splits[i], body, pc());
+    } else {
+      PatchSplit(splits[i], pc(), body);
+    }
+  }
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitCapture(RegExpCapture* that, void* data) {
+  EmitSave(RegExpCapture::StartRegister(that->index()));
+  that->body()->Accept(this, data);
+  EmitSave(RegExpCapture::EndRegister(that->index()));
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitLookahead(RegExpLookahead* that,
+                                           void* data) {
+  failed_ = true;
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitBackReference(RegExpBackReference* that,
+                                               void* data) {
+  failed_ = true;
+  return NULL;
+}
+
+
+void* RegExpLinearCompiler::VisitEmpty(RegExpEmpty* that, void* data) {
+  return NULL;
+}
+
+
+Handle<ByteArray> RegExpLinear::Compile(Isolate* isolate,
+                                        RegExpCompileData* data,
+                                        bool ignore_case,
+                                        Zone* zone) {
+  RegExpLinearCompiler compiler(ignore_case, zone);
+  if (!compiler.Compile(data->tree)) return Handle<ByteArray>::null();
+  Vector<int> code = compiler.code()->ToVector();
+  Handle<ByteArray> program =
+      isolate->factory()->NewByteArray(code.length() * kIntSize, TENURED);
+  OS::MemCopy(program->GetDataStartAddress(),
+              code.start(),
+              code.length() * kIntSize);
+  return program;
+}
+
+
+// The threads alive at one subject position, in priority order.  Each
+// thread is waiting at a consuming instruction and owns a copy of the
+// capture registers.
+class LinearThreadList {
+ public:
+  LinearThreadList(int capacity, int register_count)
+      : pcs_(NewArray<int>(capacity)),
+        registers_(NewArray<int>(capacity * register_count)),
+        register_count_(register_count),
+        length_(0) { }
+
+  ~LinearThreadList() {
+    DeleteArray(pcs_);
+    DeleteArray(registers_);
+  }
+
+  int length() { return length_; }
+  int pc(int i) { return pcs_[i]; }
+  int* registers(int i) { return &registers_[i * register_count_]; }
+  void Clear() { length_ = 0; }
+
+  void Add(int pc, const int* registers) {
+    pcs_[length_] = pc;
+    int* copy = this->registers(length_);
+    for (int i = 0; i < register_count_; i++) copy[i] = registers[i];
+    length_++;
+  }
+
+ private:
+  int* pcs_;
+  int* registers_;
+  int register_count_;
+  int length_;
+};
+
+
+template <typename Char>
+class LinearMatcher {
+ public:
+  LinearMatcher(const int* code,
+                int code_length,
+                Vector<const Char> subject,
+                int register_count)
+      : code_(code),
+        code_length_(code_length),
+        subject_(subject),
+        register_count_(register_count),
+        visited_(NewArray<int>(code_length)),
+        generation_(0),
+        stack_(16) {
+    for (int i = 0; i < code_length; i++) visited_[i] = generation_;
+  }
+
+  ~LinearMatcher() { DeleteArray(visited_); }
+
+  bool Match(int start_position, int* output);
+
+ private:
+  bool IsWordAt(int position) {
+    return position >= 0 && position < subject_.length() &&
+        IsRegExpWord(subject_[position]);
+  }
+
+  bool IsLineTerminatorAt(int position) {
+    uc16 c = subject_[position];
+    return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+  }
+
+  bool Holds(int assertion, int position);
+  bool InClass(int pc, uc16 c);
+  int Next(int pc);
+  void AddThread(LinearThreadList* list, int pc, int* registers, int position);
+
+  const int* code_;
+  int code_length_;
+  Vector<const Char> subject_;
+  int register_count_;
+  // visited_[pc] == generation_ iff pc has been reached at this position.
+  int* visited_;
+  int generation_;
+  // Pending program counters, and register values to restore, encoded as
+  // a value followed by -(register + 1).
+  List<int> stack_;
+};
+
+
+template <typename Char>
+bool LinearMatcher<Char>::Holds(int assertion, int position) {
+  switch (static_cast<RegExpAssertion::AssertionType>(assertion)) {
+    case RegExpAssertion::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::END_OF_INPUT:
+      return position == subject_.length();
+    case RegExpAssertion::START_OF_LINE:
+      return position == 0 || IsLineTerminatorAt(position - 1);
+    case RegExpAssertion::END_OF_LINE:
+      return position == subject_.length() || IsLineTerminatorAt(position);
+    case RegExpAssertion::BOUNDARY:
+      return IsWordAt(position - 1) != IsWordAt(position);
+    case RegExpAssertion::NON_BOUNDARY:
+      return IsWordAt(position - 1) == IsWordAt(position);
+  }
+  UNREACHABLE();
+  return false;
+}
+
+
+template <typename Char>
+bool LinearMatcher<Char>::InClass(int pc, uc16 c) {
+  ASSERT_EQ(LINEAR_CLASS, code_[pc]);
+  const int* ranges = &code_[pc + 2];
+  for (int i = 0; i < code_[pc + 1]; i++) {
+    if (c < ranges[2 * i]) return false;
+    if (c <= ranges[2 * i + 1]) return true;
+  }
+  return false;
+}
+
+
+template <typename Char>
+int LinearMatcher<Char>::Next(int pc) {
+  if (code_[pc] == LINEAR_CHAR) return pc + 2;
+  ASSERT_EQ(LINEAR_CLASS, code_[pc]);
+  return pc + 2 + 2 * code_[pc + 1];
+}
+
+
+// Follows all non-consuming instructions from pc in priority order and adds
+// the consuming instructions reached to the list.  The registers are
+// modified along the way but restored before returning.
+template <typename Char>
+void LinearMatcher<Char>::AddThread(LinearThreadList* list,
+                                    int pc,
+                                    int* registers,
+                                    int position) {
+  ASSERT(stack_.is_empty());
+  stack_.Add(pc);
+  while (!stack_.is_empty()) {
+    int top = stack_.RemoveLast();
+    if (top < 0) {
+      registers[-top - 1] = stack_.RemoveLast();
+      continue;
+    }
+    ASSERT(top < code_length_);
+    if (visited_[top] == generation_) continue;
+    visited_[top] = generation_;
+    switch (code_[top]) {
+      case LINEAR_JMP:
+        stack_.Add(code_[top + 1]);
+        break;
+      case LINEAR_SPLIT:
+        stack_.Add(code_[top + 2]);
+        stack_.Add(code_[top + 1]);
+        break;
+      case LINEAR_SAVE: {
+        int reg = code_[top + 1];
+        stack_.Add(registers[reg]);
+        stack_.Add(-reg - 1);
+        registers[reg] = position;
+        stack_.Add(top + 2);
+        break;
+      }
+      case LINEAR_CLEAR:
+        for (int reg = code_[top + 1]; reg <= code_[top + 2]; reg++) {
+          stack_.Add(registers[reg]);
+          stack_.Add(-reg - 1);
+          registers[reg] = -1;
+        }
+        stack_.Add(top + 3);
+        break;
+      case LINEAR_ASSERT:
+        if (Holds(code_[top + 1], position)) stack_.Add(top + 2);
+        break;
+      default:
+        list->Add(top, registers);
+        break;
+    }
+  }
+}
+
+
+template <typename Char>
+bool LinearMatcher<Char>::Match(int start_position, int* output) {
+  int max_threads = code_[RegExpLinear::kMaxThreadsIndex];
+  bool anchored = code_[RegExpLinear::kAnchoredIndex] != 0;
+  LinearThreadList first(max_threads, register_count_);
+  LinearThreadList second(max_threads, register_count_);
+  LinearThreadList* current = &first;
+  LinearThreadList* next = &second;
+  int* initial = NewArray<int>(register_count_);
+  for (int i = 0; i < register_count_; i++) initial[i] = -1;
+
+  bool matched = false;
+  int position = start_position;
+  generation_++;
+  if (!anchored || position == 0) {
+    AddThread(current, RegExpLinear::kCodeStartIndex, initial, position);
+  }
+  while (true) {
+    generation_++;
+    for (int i = 0; i < current->length(); i++) {
+      int pc = current->pc(i);
+      int* registers = current->registers(i);
+      int op = code_[pc];
+      if (op == LINEAR_MATCH) {
+        // Lower priority threads can no longer produce the result.
+        for (int j = 0; j < register_count_; j++) output[j] = registers[j];
+        matched = true;
+        break;
+      }
+      if (position == subject_.length()) continue;
+      uc16 c = subject_[position];
+      if (op == LINEAR_CHAR ? c == code_[pc + 1] : InClass(pc, c)) {
+        AddThread(next, Next(pc), registers, position + 1);
+      }
+    }
+    if (position == subject_.length()) break;
+    position++;
+    // Start a new attempt at this position, with the lowest priority.
+    if (!matched && !anchored) {
+      AddThread(next, RegExpLinear::kCodeStartIndex, initial, position);
+    }
+    LinearThreadList* swap = current;
+    current = next;
+    next = swap;
+    next->Clear();
+    if (current->length() == 0 && (matched || anchored)) break;
+  }
+  DeleteArray(initial);
+  return matched;
+}
+
+
+RegExpImpl::IrregexpResult RegExpLinear::Match(ByteArray* program,
+                                               String* subject,
+                                               int capture_count,
+                                               int* output,
+                                               int start_position) {
+  DisallowHeapAllocation no_gc;
+  const int* code = reinterpret_cast<const int*>(
+      program->GetDataStartAddress());
+  int code_length = program->length() / kIntSize;
+  int register_count = (capture_count + 1) * 2;
+  String::FlatContent content = subject->GetFlatContent();
+  ASSERT(content.IsFlat());
+  bool matched;
+  if (content.IsAscii()) {
+    LinearMatcher<uint8_t> matcher(
+        code, code_length, content.ToOneByteVector(), register_count);
+    matched = matcher.Match(start_position, output);
+  } else {
+    LinearMatcher<uc16> matcher(
+        code, code_length, content.ToUC16Vector(), register_count);
+    matched = matcher.Match(start_position, output);
+  }
+  return matched ? RegExpImpl::RE_SUCCESS : RegExpImpl::RE_FAILURE;
+}
+
+
+} }  // namespace v8::internal
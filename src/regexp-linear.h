@@ -0,0 +1,75 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// A linear-time matcher for regular expressions that need no backtracking.
+
+#ifndef V8_REGEXP_LINEAR_H_
+#define V8_REGEXP_LINEAR_H_
+
+#include "jsregexp.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Regular expressions without back references or lookaheads are compiled
+// to a small automaton program that is run as a Pike VM: all alternatives
+// are simulated in lock step, so matching takes time proportional to the
+// product of the subject and program lengths no matter how ambiguous the
+// pattern is.  Threads are kept in priority order, which yields the same
+// match and captures as the backtracking engine would.
+class RegExpLinear : public AllStatic {
+ public:
+  // Program header, followed by the instructions.
+  static const int kAnchoredIndex = 0;
+  static const int kMaxThreadsIndex = 1;
+  static const int kCodeStartIndex = 2;
+
+  // Upper bound on the program length in words.  Patterns with large
+  // bounded repetitions that exceed it are left to irregexp.
+  static const int kMaxProgramLength = 1 << 14;
+
+  // Returns a program for the parsed pattern, or a null handle if the
+  // pattern uses features that cannot be matched without backtracking.
+  static Handle<ByteArray> Compile(Isolate* isolate,
+                                   RegExpCompileData* data,
+                                   bool ignore_case,
+                                   Zone* zone);
+
+  // Searches the flat subject from start_position.  On success the
+  // (capture_count + 1) * 2 capture registers are stored in output.
+  static RegExpImpl::IrregexpResult Match(ByteArray* program,
+                                          String* subject,
+                                          int capture_count,
+                                          int* output,
+                                          int start_position);
+};
+
+
+} }  // namespace v8::internal
+
+#endif  // V8_REGEXP_LINEAR_H_
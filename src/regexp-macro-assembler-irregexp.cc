@@ -45,6 +45,7 @@ RegExpMacroAssemblerIrregexp::RegExpMacroAssemblerIrregexp(Vector<byte> buffer,
       pc_(0),
       own_buffer_(false),
       advance_current_end_(kInvalidPC),
+      load_current_end_(kInvalidPC),
       isolate_(zone->isolate()) { }
 
 
@@ -62,6 +63,7 @@ RegExpMacroAssemblerIrregexp::Implementation() {
 
 void RegExpMacroAssemblerIrregexp::Bind(Label* l) {
   advance_current_end_ = kInvalidPC;
+  load_current_end_ = kInvalidPC;
   ASSERT(!l->is_bound());
   if (l->is_linked()) {
     int pos = l->pos();
@@ -259,8 +261,31 @@ void RegExpMacroAssemblerIrregexp::LoadCurrentCharacter(int cp_offset,
       bytecode = BC_LOAD_CURRENT_CHAR_UNCHECKED;
     }
   }
+  load_current_start_ = pc_;
   Emit(bytecode, cp_offset);
   if (check_bounds) EmitOrLink(on_failure);
+  load_current_end_ = (characters == 1) ? pc_ : kInvalidPC;
+}
+
+
+bool RegExpMacroAssemblerIrregexp::FuseWithLoad(int checked_bytecode,
+                                                int unchecked_bytecode,
+                                                uint32_t c,
+                                                Label* on_match) {
+  if (load_current_end_ != pc_) return false;
+  load_current_end_ = kInvalidPC;
+  // Only the bytecode changes, so the cp offset and any label link in the
+  // load stay where they are.
+  uint32_t* load =
+      reinterpret_cast<uint32_t*>(buffer_.start() + load_current_start_);
+  int bytecode = (*load & BYTECODE_MASK) == BC_LOAD_CURRENT_CHAR
+      ? checked_bytecode : unchecked_bytecode;
+  ASSERT((*load & BYTECODE_MASK) == BC_LOAD_CURRENT_CHAR ||
+         (*load & BYTECODE_MASK) == BC_LOAD_CURRENT_CHAR_UNCHECKED);
+  *load = (*load & ~BYTECODE_MASK) | bytecode;
+  Emit32(c);
+  EmitOrLink(on_match);
+  return true;
 }
 
 
@@ -279,6 +304,12 @@ void RegExpMacroAssemblerIrregexp::CheckCharacterGT(uc16 limit,
 
 
 void RegExpMacroAssemblerIrregexp::CheckCharacter(uint32_t c, Label* on_equal) {
+  if (FuseWithLoad(BC_LOAD_CHAR_CHECK_CHAR,
+                   BC_LOAD_CHAR_UNCHECKED_CHECK_CHAR,
+                   c,
+                   on_equal)) {
+    return;
+  }
   if (c > MAX_FIRST_ARG) {
     Emit(BC_CHECK_4_CHARS, 0);
     Emit32(c);
@@ -303,6 +334,12 @@ void RegExpMacroAssemblerIrregexp::CheckNotAtStart(Label* on_not_at_start) {
 
 void RegExpMacroAssemblerIrregexp::CheckNotCharacter(uint32_t c,
                                                      Label* on_not_equal) {
+  if (FuseWithLoad(BC_LOAD_CHAR_CHECK_NOT_CHAR,
+                   BC_LOAD_CHAR_UNCHECKED_CHECK_NOT_CHAR,
+                   c,
+                   on_not_equal)) {
+    return;
+  }
   if (c > MAX_FIRST_ARG) {
     Emit(BC_CHECK_NOT_4_CHARS, 0);
     Emit32(c);
@@ -118,6 +118,12 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
   inline void Emit16(uint32_t x);
   inline void Emit8(uint32_t x);
   inline void Emit(uint32_t bc, uint32_t arg);
+  // Turns the character load that was just emitted into a load followed by
+  // a check, if possible, and returns whether it did.
+  bool FuseWithLoad(int checked_bytecode,
+                    int unchecked_bytecode,
+                    uint32_t c,
+                    Label* on_match);
   // Bytecode buffer.
   int length();
   void Copy(Address a);
@@ -134,6 +140,11 @@ class RegExpMacroAssemblerIrregexp: public RegExpMacroAssembler {
   int advance_current_offset_;
   int advance_current_end_;
 
+  // Start and end of the last single character load, for fusing it with a
+  // following character check.
+  int load_current_start_;
+  int load_current_end_;
+
   Isolate* isolate_;
 
   static const int kInvalidPC = -1;
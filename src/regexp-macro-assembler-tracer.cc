@@ -396,6 +396,22 @@ bool RegExpMacroAssemblerTracer::CheckSpecialCharacterClass(
 }
 
 
+bool RegExpMacroAssemblerTracer::SkipUntilCharacterAfterAnd(
+    int cp_offset,
+    Vector<const uc16> chars,
+    uc16 and_with) {
+  bool supported =
+      assembler_->SkipUntilCharacterAfterAnd(cp_offset, chars, and_with);
+  PrintF(" SkipUntilCharacterAfterAnd(cp_offset=%d, chars=%d, and=0x%04x):"
+         " %s;\n",
+         cp_offset,
+         chars.length(),
+         and_with,
+         supported ? "true" : "false");
+  return supported;
+}
+
+
 void RegExpMacroAssemblerTracer::IfRegisterLT(int register_index,
                                               int comparand, Label* if_lt) {
   PrintF(" IfRegisterLT(register=%d, number=%d, label[%08x]);\n",
@@ -38,6 +38,8 @@ namespace internal {
 RegExpMacroAssembler::RegExpMacroAssembler(Zone* zone)
   : slow_safe_compiler_(false),
     global_mode_(NOT_GLOBAL),
+    backtrack_limit_(0),
+    count_backtracks_(false),
     zone_(zone) {
 }
 
@@ -178,7 +180,7 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Execute(
                                           stack_base,
                                           direct_call,
                                           isolate);
-  ASSERT(result >= RETRY);
+  ASSERT(result >= BACKTRACK_LIMIT);
 
   if (result == EXCEPTION && !isolate->has_pending_exception()) {
     // We detected a stack overflow (on the backtrack stack) in RegExp code,
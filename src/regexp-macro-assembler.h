@@ -131,6 +131,17 @@ class RegExpMacroAssembler {
                                           Label* on_no_match) {
     return false;
   }
+  // Advance the current position to the first position from which the
+  // character at cp_offset, anded with and_with, is one of chars, or to the
+  // first position from which cp_offset is outside the input.  Returns false
+  // if there is no fast implementation for the given characters, in which
+  // case nothing is emitted.
+  // May clobber the current loaded character.
+  virtual bool SkipUntilCharacterAfterAnd(int cp_offset,
+                                          Vector<const uc16> chars,
+                                          uc16 and_with) {
+    return false;
+  }
   virtual void Fail() = 0;
   virtual Handle<HeapObject> GetCode(Handle<String> source) = 0;
   virtual void GoTo(Label* label) = 0;
@@ -179,11 +190,24 @@ class RegExpMacroAssembler {
     return global_mode_ == GLOBAL;
   }
 
+  // Bounds the number of backtracks a single match may take.  Zero means
+  // no limit.  Only honored by some of the native assemblers.
+  void set_backtrack_limit(int limit) { backtrack_limit_ = limit; }
+  int backtrack_limit() { return backtrack_limit_; }
+  bool has_backtrack_limit() { return backtrack_limit_ != 0; }
+
+  // Whether the generated code adds its backtracks to the isolate-wide
+  // count in RegExpStack.  Only honored by some of the native assemblers.
+  void set_count_backtracks(bool count) { count_backtracks_ = count; }
+  bool count_backtracks() { return count_backtracks_; }
+
   Zone* zone() const { return zone_; }
 
  private:
   bool slow_safe_compiler_;
   bool global_mode_;
+  int backtrack_limit_;
+  bool count_backtracks_;
   Zone* zone_;
 };
 
@@ -204,7 +228,15 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   // FAILURE: Matching failed.
   // SUCCESS: Matching succeeded, and the output array has been filled with
   //        capture positions.
-  enum Result { RETRY = -2, EXCEPTION = -1, FAILURE = 0, SUCCESS = 1 };
+  // BACKTRACK_LIMIT: The backtrack limit was exceeded before matching
+  //        finished.
+  enum Result {
+    BACKTRACK_LIMIT = -3,
+    RETRY = -2,
+    EXCEPTION = -1,
+    FAILURE = 0,
+    SUCCESS = 1
+  };
 
   explicit NativeRegExpMacroAssembler(Zone* zone);
   virtual ~NativeRegExpMacroAssembler();
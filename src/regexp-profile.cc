@@ -0,0 +1,133 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "regexp-profile.h"
+#include "regexp-stack.h"
+
+namespace v8 {
+namespace internal {
+
+
+RegExpProfile::RegExpProfile() : map_(EntriesMatch), entries_(16) {
+}
+
+
+RegExpProfile::~RegExpProfile() {
+  for (int i = 0; i < entries_.length(); i++) {
+    DeleteArray(entries_[i]->source);
+    delete entries_[i];
+  }
+}
+
+
+bool RegExpProfile::EntriesMatch(void* key1, void* key2) {
+  Entry* a = reinterpret_cast<Entry*>(key1);
+  Entry* b = reinterpret_cast<Entry*>(key2);
+  return a->flags == b->flags && strcmp(a->source, b->source) == 0;
+}
+
+
+int RegExpProfile::CompareByTime(Entry* const* a, Entry* const* b) {
+  // Slowest patterns first.
+  if ((*a)->time > (*b)->time) return -1;
+  if ((*a)->time < (*b)->time) return 1;
+  return 0;
+}
+
+
+void RegExpProfile::Record(JSRegExp* regexp,
+                           TimeDelta time,
+                           intptr_t backtracks,
+                           int stack_growths) {
+  String* source = String::cast(regexp->DataAt(JSRegExp::kSourceIndex));
+  SmartArrayPointer<char> source_chars = source->ToCString();
+  Entry probe;
+  probe.source = source_chars.get();
+  probe.flags = regexp->GetFlags().value();
+  HashMap::Entry* map_entry = map_.Lookup(&probe, source->Hash(), true);
+  if (map_entry->value == NULL) {
+    Entry* entry = new Entry();
+    entry->source = source_chars.Detach();
+    entry->flags = probe.flags;
+    entry->executions = 0;
+    entry->backtracks = 0;
+    entry->stack_growths = 0;
+    map_entry->key = entry;
+    map_entry->value = entry;
+    entries_.Add(entry);
+  }
+  Entry* entry = reinterpret_cast<Entry*>(map_entry->value);
+  entry->executions++;
+  entry->time += time;
+  entry->backtracks += backtracks;
+  entry->stack_growths += stack_growths;
+}
+
+
+void RegExpProfile::Print() {
+  entries_.Sort(CompareByTime);
+  PrintF("RegExp profile:\n");
+  PrintF("%12s %10s %14s %6s  %s\n",
+         "time (ms)", "executions", "backtracks", "grows", "pattern");
+  for (int i = 0; i < entries_.length(); i++) {
+    Entry* entry = entries_[i];
+    JSRegExp::Flags flags(entry->flags);
+    PrintF("%12.3f %10d %14" V8_PTR_PREFIX "d %6d  /%s/%s%s%s\n",
+           entry->time.InMillisecondsF(),
+           entry->executions,
+           entry->backtracks,
+           entry->stack_growths,
+           entry->source,
+           flags.is_global() ? "g" : "",
+           flags.is_ignore_case() ? "i" : "",
+           flags.is_multiline() ? "m" : "");
+  }
+}
+
+
+void RegExpProfileScope::Start(Isolate* isolate, Handle<JSRegExp> regexp) {
+  isolate_ = isolate;
+  regexp_ = regexp;
+  RegExpStack* stack = isolate->regexp_stack();
+  backtracks_ = stack->backtrack_count();
+  stack_growths_ = stack->grow_count();
+  timer_.Start();
+}
+
+
+void RegExpProfileScope::Stop() {
+  TimeDelta time = timer_.Elapsed();
+  RegExpStack* stack = isolate_->regexp_stack();
+  isolate_->GetRegExpProfile()->Record(*regexp_,
+                                       time,
+                                       stack->backtrack_count() - backtracks_,
+                                       stack->grow_count() - stack_growths_);
+}
+
+} }  // namespace v8::internal
@@ -0,0 +1,101 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_REGEXP_PROFILE_H_
+#define V8_REGEXP_PROFILE_H_
+
+#include "hashmap.h"
+#include "platform/elapsed-timer.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Per-pattern execution statistics collected with --regexp-profile.
+// Regular expressions are identified by their source and flags, so all
+// JSRegExp objects created from the same literal share one entry.  The
+// statistics are printed when the isolate is torn down.
+class RegExpProfile : public Malloced {
+ public:
+  RegExpProfile();
+  ~RegExpProfile();
+
+  void Record(JSRegExp* regexp,
+              TimeDelta time,
+              intptr_t backtracks,
+              int stack_growths);
+  void Print();
+
+ private:
+  struct Entry {
+    char* source;
+    uint32_t flags;
+    int executions;
+    TimeDelta time;
+    intptr_t backtracks;
+    int stack_growths;
+  };
+
+  static bool EntriesMatch(void* key1, void* key2);
+  static int CompareByTime(Entry* const* a, Entry* const* b);
+
+  HashMap map_;
+  List<Entry*> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegExpProfile);
+};
+
+
+// Attributes the time, backtracks and backtrack stack growths of one
+// irregexp execution to the pattern being executed.  Does nothing unless
+// --regexp-profile is on.
+class RegExpProfileScope {
+ public:
+  RegExpProfileScope(Isolate* isolate, Handle<JSRegExp> regexp)
+      : isolate_(NULL) {
+    if (FLAG_regexp_profile) Start(isolate, regexp);
+  }
+  ~RegExpProfileScope() {
+    if (isolate_ != NULL) Stop();
+  }
+
+ private:
+  void Start(Isolate* isolate, Handle<JSRegExp> regexp);
+  void Stop();
+
+  Isolate* isolate_;
+  Handle<JSRegExp> regexp_;
+  ElapsedTimer timer_;
+  intptr_t backtracks_;
+  int stack_growths_;
+
+  DISALLOW_COPY_AND_ASSIGN(RegExpProfileScope);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_REGEXP_PROFILE_H_
@@ -45,7 +45,9 @@ RegExpStackScope::~RegExpStackScope() {
 
 
 RegExpStack::RegExpStack()
-    : isolate_(NULL) {
+    : isolate_(NULL),
+      backtrack_count_(0),
+      grow_count_(0) {
 }
 
 
@@ -98,6 +100,7 @@ Address RegExpStack::EnsureCapacity(size_t size) {
           reinterpret_cast<void*>(thread_local_.memory_),
           thread_local_.memory_size_);
       DeleteArray(thread_local_.memory_);
+      grow_count_++;
     }
     thread_local_.memory_ = new_memory;
     thread_local_.memory_size_ = size;
@@ -82,6 +82,13 @@ class RegExpStack {
   // If passing zero, the default/minimum size buffer is allocated.
   Address EnsureCapacity(size_t size);
 
+  // Total number of backtracks taken by regexp executions that count them,
+  // and the number of times the stack memory had to be grown.  Used by
+  // --regexp-profile.
+  intptr_t backtrack_count() { return backtrack_count_; }
+  intptr_t* backtrack_count_address() { return &backtrack_count_; }
+  int grow_count() { return grow_count_; }
+
   // Thread local archiving.
   static int ArchiveSpacePerThread() {
     return static_cast<int>(sizeof(ThreadLocal));
@@ -135,6 +142,8 @@ class RegExpStack {
 
   ThreadLocal thread_local_;
   Isolate* isolate_;
+  intptr_t backtrack_count_;
+  int grow_count_;
 
   friend class ExternalReference;
   friend class Isolate;
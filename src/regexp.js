@@ -133,16 +133,23 @@ function DoRegExpExec(regexp, string, index) {
 
 function BuildResultFromMatchInfo(lastMatchInfo, s) {
   var numResults = NUMBER_OF_CAPTURES(lastMatchInfo) >> 1;
-  var start = lastMatchInfo[CAPTURE0];
-  var end = lastMatchInfo[CAPTURE1];
-  var result = %_RegExpConstructResult(numResults, start, s);
-  result[0] = %_SubString(s, start, end);
+  var matchStart = lastMatchInfo[CAPTURE0];
+  var matchEnd = lastMatchInfo[CAPTURE1];
+  var result = %_RegExpConstructResult(numResults, matchStart, s);
+  var match = %_SubString(s, matchStart, matchEnd);
+  result[0] = match;
   var j = REGEXP_FIRST_CAPTURE + 2;
   for (var i = 1; i < numResults; i++) {
-    start = lastMatchInfo[j++];
+    var start = lastMatchInfo[j++];
     if (start != -1) {
-      end = lastMatchInfo[j];
-      result[i] = %_SubString(s, start, end);
+      var end = lastMatchInfo[j];
+      // Captures spanning the whole match share its string instead of
+      // allocating a copy of it.
+      if (start == matchStart && end == matchEnd) {
+        result[i] = match;
+      } else {
+        result[i] = %_SubString(s, start, end);
+      }
     }
     j++;
   }
@@ -76,7 +76,8 @@ static const int kMaxSizeEarlyOpt =
 
 RuntimeProfiler::RuntimeProfiler(Isolate* isolate)
     : isolate_(isolate),
-      any_ic_changed_(false) {
+      any_ic_changed_(false),
+      compile_budget_(FLAG_compile_budget_max) {
 }
 
 
@@ -98,9 +99,59 @@ static void GetICCounts(Code* shared_code,
 }
 
 
+int RuntimeProfiler::CompileCost(JSFunction* function) {
+  SharedFunctionInfo* shared = function->shared();
+  // Functions that keep deoptimizing pay off less than their compile time
+  // suggests, charge them for every earlier attempt that failed.
+  int failed = Min(shared->deopt_count(), FLAG_max_opt_count);
+  return Max(shared->ast_node_count(), 1) * (1 + failed);
+}
+
+
+bool RuntimeProfiler::ChargeCompileBudget(JSFunction* function) {
+  if (isolate_->concurrent_recompilation_enabled() &&
+      !isolate_->optimizing_compiler_thread()->IsQueueAvailable()) {
+    isolate_->counters()->compile_budget_queue_full()->Increment();
+    if (FLAG_trace_opt_verbose) {
+      PrintF("[not yet optimizing ");
+      function->PrintName();
+      PrintF(", recompilation queue is full]\n");
+    }
+    return false;
+  }
+  if (FLAG_compile_budget_per_tick <= 0) return true;
+
+  // A function costlier than the whole budget is let through once the
+  // budget is full, so that large functions are delayed but not starved.
+  int cost = CompileCost(function);
+  if (cost > compile_budget_ && compile_budget_ < FLAG_compile_budget_max) {
+    isolate_->counters()->compile_budget_deferred()->Increment();
+    if (FLAG_trace_opt_verbose) {
+      PrintF("[not yet optimizing ");
+      function->PrintName();
+      PrintF(", compile cost %d exceeds budget %d]\n", cost, compile_budget_);
+    }
+    return false;
+  }
+  compile_budget_ = Max(compile_budget_ - cost, 0);
+  isolate_->counters()->compile_budget_spent()->Increment(cost);
+  return true;
+}
+
+
 void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
   ASSERT(function->IsOptimizable());
 
+  // Leave the function to a later tick, it stays hot until then.
+  if (!ChargeCompileBudget(function)) return;
+
+  if (function->shared()->opt_count() == 0) {
+    int created = function->shared()->code()->creation_time();
+    int now = static_cast<int>(isolate_->time_millis_since_init());
+    isolate_->counters()->optimization_decision_latency()->AddSample(
+        now - created);
+  }
+
   if (FLAG_trace_opt && function->PassesFilter(FLAG_hydrogen_filter)) {
     PrintF("[marking ");
     function->ShortPrint();
@@ -137,7 +188,7 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function) {
   // See AlwaysFullCompiler (in compiler.cc) comment on why we need
   // Debug::has_break_points().
   if (!FLAG_use_osr ||
-      isolate_->DebuggerHasBreakPoints() ||
+      isolate_->DebuggerPreventsOptimization(function->shared()) ||
       function->IsBuiltin()) {
     return;
   }
@@ -167,10 +218,11 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function) {
 void RuntimeProfiler::OptimizeNow() {
   HandleScope scope(isolate_);
 
-  if (isolate_->DebuggerHasBreakPoints()) return;
-
   DisallowHeapAllocation no_gc;
 
+  compile_budget_ = Min(compile_budget_ + FLAG_compile_budget_per_tick,
+                        Max(FLAG_compile_budget_max, 0));
+
   // Run through the JavaScript frames and collect them. If we already
   // have a sample of the function, we mark it for optimizations
   // (eagerly or lazily).
@@ -187,6 +239,7 @@ void RuntimeProfiler::OptimizeNow() {
 
     if (shared_code->kind() != Code::FUNCTION) continue;
     if (function->IsInOptimizationQueue()) continue;
+    if (isolate_->DebuggerPreventsOptimization(shared)) continue;
 
     if (FLAG_always_osr &&
         shared_code->allow_osr_at_loop_nesting_level() == 0) {
@@ -245,6 +298,15 @@ void RuntimeProfiler::OptimizeNow() {
     }
     if (!function->IsOptimizable()) continue;
 
+    // Optimized code is specific to a native context, but the function has
+    // already proven hot under another one.  Its type feedback lives in the
+    // shared unoptimized code, so there is no need to wait for it again.
+    if (FLAG_optimize_if_optimized_in_other_context &&
+        !shared->optimized_code_map()->IsSmi()) {
+      Optimize(function, "optimized in another context");
+      continue;
+    }
+
     int ticks = shared_code->profiler_ticks();
 
     if (ticks >= kProfilerTicksBeforeOptimization) {
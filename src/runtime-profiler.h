@@ -52,11 +52,21 @@ class RuntimeProfiler {
  private:
   void Optimize(JSFunction* function, const char* reason);
 
+  // Estimated cost of optimizing the function, in AST nodes.
+  int CompileCost(JSFunction* function);
+  // Whether the compile budget and the recompilation queue leave room for
+  // optimizing the function now.  Consumes the budget if so.
+  bool ChargeCompileBudget(JSFunction* function);
+
   bool CodeSizeOKForOSR(Code* shared_code);
 
   Isolate* isolate_;
 
   bool any_ic_changed_;
+
+  // AST nodes that may still be sent to the optimizer.  Refilled on every
+  // tick, so bursts of hot functions are spread over several ticks.
+  int compile_budget_;
 };
 
 } }  // namespace v8::internal
@@ -62,6 +62,7 @@
 #include "smart-pointers.h"
 #include "string-search.h"
 #include "stub-cache.h"
+#include "timsort.h"
 #include "uri.h"
 #include "v8conversions.h"
 #include "v8threads.h"
@@ -744,8 +745,7 @@ void Runtime::FreeArrayBuffer(Isolate* isolate,
 
   isolate->heap()->AdjustAmountOfExternalAllocatedMemory(
       -static_cast<int64_t>(allocated_length));
-  CHECK(V8::ArrayBufferAllocator() != NULL);
-  V8::ArrayBufferAllocator()->Free(
+  isolate->heap()->array_buffer_pool()->Free(
       phantom_array_buffer->backing_store(),
       allocated_length);
 }
@@ -782,14 +782,9 @@ bool Runtime::SetupArrayBufferAllocatingData(
     size_t allocated_length,
     bool initialize) {
   void* data;
-  CHECK(V8::ArrayBufferAllocator() != NULL);
   if (allocated_length != 0) {
-    if (initialize) {
-      data = V8::ArrayBufferAllocator()->Allocate(allocated_length);
-    } else {
-      data =
-        V8::ArrayBufferAllocator()->AllocateUninitialized(allocated_length);
-    }
+    data = isolate->heap()->array_buffer_pool()->Allocate(allocated_length,
+                                                          initialize);
     if (data == NULL) return false;
   } else {
     data = NULL;
@@ -940,9 +935,188 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_TypedArrayInitialize) {
 }
 
 
+// Converts a number to the element type of a typed array the same way
+// storing it through the corresponding ExternalArray::SetValue does.
+template <typename T>
+static inline T TypedArrayElementFromDouble(double value) {
+  return static_cast<T>(DoubleToInt32(value));
+}
+
+
+template <>
+inline uint32_t TypedArrayElementFromDouble<uint32_t>(double value) {
+  return DoubleToUint32(value);
+}
+
+
+template <>
+inline float TypedArrayElementFromDouble<float>(double value) {
+  return static_cast<float>(value);
+}
+
+
+template <>
+inline double TypedArrayElementFromDouble<double>(double value) {
+  return value;
+}
+
+
+template <ExternalArrayType array_type, typename T>
+struct TypedArrayElement {
+  typedef T Type;
+  static inline T FromDouble(double value) {
+    return TypedArrayElementFromDouble<T>(value);
+  }
+};
+
+
+template <>
+struct TypedArrayElement<kExternalUint8ClampedArray, uint8_t> {
+  typedef uint8_t Type;
+  static inline uint8_t FromDouble(double value) {
+    // NaN and less than zero clamp to zero.
+    if (!(value > 0)) return 0;
+    if (value > 255) return 255;
+    return static_cast<uint8_t>(lrint(value));
+  }
+};
+
+
+// Converts |length| elements of one typed array type into another.  Every
+// element type converts exactly into a double, so going through doubles
+// gives the same result as an element-by-element copy in JavaScript.
+template <typename Target, typename Source>
+static void ConvertTypedArrayElements(void* target,
+                                      const void* source,
+                                      size_t length) {
+  typename Target::Type* dst = static_cast<typename Target::Type*>(target);
+  const typename Source::Type* src =
+      static_cast<const typename Source::Type*>(source);
+  for (size_t i = 0; i < length; i++) {
+    dst[i] = Target::FromDouble(static_cast<double>(src[i]));
+  }
+}
+
+
+template <typename Target>
+static void ConvertTypedArrayElementsFrom(void* target,
+                                          ExternalArrayType source_type,
+                                          const void* source,
+                                          size_t length) {
+  switch (source_type) {
+#define TYPED_ARRAY_CONVERT_CASE(Type, type, TYPE, ctype, size)                \
+    case kExternal##Type##Array:                                               \
+      ConvertTypedArrayElements<                                               \
+          Target, TypedArrayElement<kExternal##Type##Array, ctype> >(          \
+              target, source, length);                                         \
+      break;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CONVERT_CASE)
+#undef TYPED_ARRAY_CONVERT_CASE
+
+    default:
+      UNREACHABLE();
+  }
+}
+
+
+static void ConvertTypedArrayElements(ExternalArrayType target_type,
+                                      void* target,
+                                      ExternalArrayType source_type,
+                                      const void* source,
+                                      size_t length) {
+  switch (target_type) {
+#define TYPED_ARRAY_CONVERT_CASE(Type, type, TYPE, ctype, size)                \
+    case kExternal##Type##Array:                                               \
+      ConvertTypedArrayElementsFrom<                                           \
+          TypedArrayElement<kExternal##Type##Array, ctype> >(                  \
+              target, source_type, source, length);                            \
+      break;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CONVERT_CASE)
+#undef TYPED_ARRAY_CONVERT_CASE
+
+    default:
+      UNREACHABLE();
+  }
+}
+
+
+template <typename Target>
+static void ConvertNumberElements(void* target,
+                                  FixedArrayBase* elements,
+                                  size_t length) {
+  typename Target::Type* dst = static_cast<typename Target::Type*>(target);
+  if (elements->IsFixedDoubleArray()) {
+    FixedDoubleArray* doubles = FixedDoubleArray::cast(elements);
+    for (size_t i = 0; i < length; i++) {
+      dst[i] = Target::FromDouble(doubles->get_scalar(static_cast<int>(i)));
+    }
+  } else {
+    FixedArray* numbers = FixedArray::cast(elements);
+    for (size_t i = 0; i < length; i++) {
+      dst[i] = Target::FromDouble(numbers->get(static_cast<int>(i))->Number());
+    }
+  }
+}
+
+
+// Copies the first |length| elements of a JSArray into the backing store of
+// a typed array.  Returns false without touching the target if the array
+// has holes or elements that are not numbers, since converting those has
+// to go through the prototype chain or call back into JavaScript.
+static bool CopyNumberElementsToTypedArray(ExternalArrayType target_type,
+                                           void* target,
+                                           JSArray* source,
+                                           size_t length) {
+  if (length == 0) return true;
+  ElementsKind kind = source->GetElementsKind();
+  FixedArrayBase* elements = source->elements();
+  if (length > static_cast<size_t>(elements->length())) return false;
+  int int_length = static_cast<int>(length);
+  if (kind == FAST_HOLEY_DOUBLE_ELEMENTS) {
+    FixedDoubleArray* doubles = FixedDoubleArray::cast(elements);
+    for (int i = 0; i < int_length; i++) {
+      if (doubles->is_the_hole(i)) return false;
+    }
+  } else if (kind != FAST_SMI_ELEMENTS && kind != FAST_DOUBLE_ELEMENTS) {
+    if (!IsFastSmiOrObjectElementsKind(kind)) return false;
+    FixedArray* objects = FixedArray::cast(elements);
+    for (int i = 0; i < int_length; i++) {
+      if (!objects->get(i)->IsNumber()) return false;
+    }
+  }
+
+  DisallowHeapAllocation no_gc;
+  switch (target_type) {
+#define TYPED_ARRAY_CONVERT_CASE(Type, type, TYPE, ctype, size)                \
+    case kExternal##Type##Array:                                               \
+      ConvertNumberElements<TypedArrayElement<kExternal##Type##Array, ctype> >(\
+          target, elements, length);                                           \
+      break;
+
+    TYPED_ARRAYS(TYPED_ARRAY_CONVERT_CASE)
+#undef TYPED_ARRAY_CONVERT_CASE
+
+    default:
+      UNREACHABLE();
+  }
+  return true;
+}
+
+
+static inline uint8_t* TypedArrayBackingStore(JSTypedArray* typed_array) {
+  Isolate* isolate = typed_array->GetIsolate();
+  return static_cast<uint8_t*>(
+      JSArrayBuffer::cast(typed_array->buffer())->backing_store()) +
+      NumberToSize(isolate, typed_array->byte_offset());
+}
+
+
 // Initializes a typed array from an array-like object.
-// If an array-like object happens to be a typed array of the same type,
-// initializes backing store using memove.
+// If an array-like object happens to be a typed array or a JSArray of
+// numbers, initializes backing store natively: using memcpy for typed
+// arrays of the same type and converting the elements otherwise.
 //
 // Returns true if backing store was initialized or false otherwise.
 RUNTIME_FUNCTION(MaybeObject*, Runtime_TypedArrayInitializeFromArrayLike) {
@@ -1014,21 +1188,21 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_TypedArrayInitializeFromArrayLike) {
 
   if (source->IsJSTypedArray()) {
     Handle<JSTypedArray> typed_array(JSTypedArray::cast(*source));
+    uint8_t* source_base = TypedArrayBackingStore(*typed_array);
 
     if (typed_array->type() == holder->type()) {
-      uint8_t* backing_store =
-        static_cast<uint8_t*>(
-          JSArrayBuffer::cast(typed_array->buffer())->backing_store());
-      size_t source_byte_offset =
-          NumberToSize(isolate, typed_array->byte_offset());
-      memcpy(
-          buffer->backing_store(),
-          backing_store + source_byte_offset,
-          byte_length);
-      return *isolate->factory()->true_value();
+      memcpy(buffer->backing_store(), source_base, byte_length);
     } else {
-      return *isolate->factory()->false_value();
+      ConvertTypedArrayElements(holder->type(), buffer->backing_store(),
+                                typed_array->type(), source_base, length);
     }
+    return *isolate->factory()->true_value();
+  }
+
+  if (source->IsJSArray() &&
+      CopyNumberElementsToTypedArray(holder->type(), buffer->backing_store(),
+                                     JSArray::cast(*source), length)) {
+    return *isolate->factory()->true_value();
   }
 
   return *isolate->factory()->false_value();
@@ -1057,15 +1231,11 @@ TYPED_ARRAY_GETTER(Length, length)
 // Return codes for Runtime_TypedArraySetFastCases.
 // Should be synchronized with typedarray.js natives.
 enum TypedArraySetResultCodes {
-  // Set from typed array of the same type.
+  // Set from a typed array or from a JSArray of numbers.
   // This is processed by TypedArraySetFastCases
-  TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE = 0,
-  // Set from typed array of the different type, overlapping in memory.
-  TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING = 1,
-  // Set from typed array of the different type, non-overlapping.
-  TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING = 2,
-  // Set from non-typed array.
-  TYPED_ARRAY_SET_NON_TYPED_ARRAY = 3
+  TYPED_ARRAY_SET_DONE = 0,
+  // Set from any other array-like object.
+  TYPED_ARRAY_SET_ARRAY_LIKE = 1
 };
 
 
@@ -1079,51 +1249,173 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_TypedArraySetFastCases) {
     return isolate->Throw(*isolate->factory()->NewTypeError(
         "not_typed_array", HandleVector<Object>(NULL, 0)));
 
-  if (!source_obj->IsJSTypedArray())
-    return Smi::FromInt(TYPED_ARRAY_SET_NON_TYPED_ARRAY);
+  if (!source_obj->IsJSTypedArray() && !source_obj->IsJSArray())
+    return Smi::FromInt(TYPED_ARRAY_SET_ARRAY_LIKE);
 
   Handle<JSTypedArray> target(JSTypedArray::cast(*target_obj));
-  Handle<JSTypedArray> source(JSTypedArray::cast(*source_obj));
   size_t offset = NumberToSize(isolate, *offset_obj);
   size_t target_length = NumberToSize(isolate, target->length());
-  size_t source_length = NumberToSize(isolate, source->length());
-  size_t target_byte_length = NumberToSize(isolate, target->byte_length());
-  size_t source_byte_length = NumberToSize(isolate, source->byte_length());
+  size_t source_length = source_obj->IsJSTypedArray()
+      ? NumberToSize(isolate, JSTypedArray::cast(*source_obj)->length())
+      : NumberToSize(isolate, JSArray::cast(*source_obj)->length());
   if (offset > target_length ||
       offset + source_length > target_length ||
       offset + source_length < offset)  // overflow
     return isolate->Throw(*isolate->factory()->NewRangeError(
           "typed_array_set_source_too_large", HandleVector<Object>(NULL, 0)));
 
-  size_t target_offset = NumberToSize(isolate, target->byte_offset());
-  size_t source_offset = NumberToSize(isolate, source->byte_offset());
   uint8_t* target_base =
-      static_cast<uint8_t*>(
-        JSArrayBuffer::cast(target->buffer())->backing_store()) + target_offset;
-  uint8_t* source_base =
-      static_cast<uint8_t*>(
-        JSArrayBuffer::cast(source->buffer())->backing_store()) + source_offset;
+      TypedArrayBackingStore(*target) + offset * target->element_size();
+
+  if (source_obj->IsJSArray()) {
+    if (CopyNumberElementsToTypedArray(target->type(), target_base,
+                                       JSArray::cast(*source_obj),
+                                       source_length)) {
+      return Smi::FromInt(TYPED_ARRAY_SET_DONE);
+    }
+    return Smi::FromInt(TYPED_ARRAY_SET_ARRAY_LIKE);
+  }
+
+  Handle<JSTypedArray> source(JSTypedArray::cast(*source_obj));
+  size_t source_byte_length = NumberToSize(isolate, source->byte_length());
+  uint8_t* source_base = TypedArrayBackingStore(*source);
 
   // Typed arrays of the same type: use memmove.
   if (target->type() == source->type()) {
-    memmove(target_base + offset * target->element_size(),
-        source_base, source_byte_length);
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_SAME_TYPE);
+    memmove(target_base, source_base, source_byte_length);
+    return Smi::FromInt(TYPED_ARRAY_SET_DONE);
   }
 
-  // Typed arrays of different types over the same backing store
+  size_t target_byte_length = source_length * target->element_size();
   if ((source_base <= target_base &&
         source_base + source_byte_length > target_base) ||
       (target_base <= source_base &&
         target_base + target_byte_length > source_base)) {
-    // We do not support overlapping ArrayBuffers
+    // Typed arrays of different types over the same backing store: convert
+    // from a copy of the source so that no element is overwritten before
+    // it has been read.
     ASSERT(
       JSArrayBuffer::cast(target->buffer())->backing_store() ==
       JSArrayBuffer::cast(source->buffer())->backing_store());
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_OVERLAPPING);
-  } else {  // Non-overlapping typed arrays
-    return Smi::FromInt(TYPED_ARRAY_SET_TYPED_ARRAY_NONOVERLAPPING);
+    ScopedVector<uint8_t> copy(static_cast<int>(source_byte_length));
+    OS::MemCopy(copy.start(), source_base, source_byte_length);
+    ConvertTypedArrayElements(target->type(), target_base,
+                              source->type(), copy.start(), source_length);
+  } else {
+    ConvertTypedArrayElements(target->type(), target_base,
+                              source->type(), source_base, source_length);
+  }
+  return Smi::FromInt(TYPED_ARRAY_SET_DONE);
+}
+
+
+// Atomics operate on the elements of Int32Array and Uint32Array views.
+// Every access is bracketed by full memory barriers, which makes the
+// operations sequentially consistent with respect to other threads that
+// access the same (shared) backing store through Atomics.
+static volatile Atomic32* AtomicsElementAddress(Isolate* isolate,
+                                                Object* array_obj,
+                                                double index) {
+  if (!array_obj->IsJSTypedArray()) return NULL;
+  JSTypedArray* array = JSTypedArray::cast(array_obj);
+  if (array->type() != kExternalInt32Array &&
+      array->type() != kExternalUint32Array) {
+    return NULL;
+  }
+  if (!(index >= 0) || index >= NumberToSize(isolate, array->length())) {
+    return NULL;
+  }
+  return reinterpret_cast<volatile Atomic32*>(TypedArrayBackingStore(array)) +
+      static_cast<size_t>(index);
+}
+
+
+static MaybeObject* ThrowInvalidAtomicAccess(Isolate* isolate,
+                                             Object* array_obj) {
+  HandleScope scope(isolate);
+  bool is_int32_array = array_obj->IsJSTypedArray() &&
+      (JSTypedArray::cast(array_obj)->type() == kExternalInt32Array ||
+       JSTypedArray::cast(array_obj)->type() == kExternalUint32Array);
+  if (!is_int32_array) {
+    return isolate->Throw(*isolate->factory()->NewTypeError(
+        "invalid_atomic_access", HandleVector<Object>(NULL, 0)));
+  }
+  return isolate->Throw(*isolate->factory()->NewRangeError(
+      "invalid_atomic_access_index", HandleVector<Object>(NULL, 0)));
+}
+
+
+static MaybeObject* AtomicsResult(Isolate* isolate,
+                                  Object* array_obj,
+                                  Atomic32 value) {
+  if (JSTypedArray::cast(array_obj)->type() == kExternalUint32Array) {
+    return isolate->heap()->NumberFromUint32(static_cast<uint32_t>(value));
   }
+  return isolate->heap()->NumberFromInt32(value);
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_AtomicsLoad) {
+  SealHandleScope shs(isolate);
+  ASSERT(args.length() == 2);
+  CONVERT_DOUBLE_ARG_CHECKED(index, 1);
+  volatile Atomic32* address =
+      AtomicsElementAddress(isolate, args[0], index);
+  if (address == NULL) return ThrowInvalidAtomicAccess(isolate, args[0]);
+  MemoryBarrier();
+  Atomic32 value = NoBarrier_Load(address);
+  MemoryBarrier();
+  return AtomicsResult(isolate, args[0], value);
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_AtomicsStore) {
+  SealHandleScope shs(isolate);
+  ASSERT(args.length() == 3);
+  CONVERT_DOUBLE_ARG_CHECKED(index, 1);
+  CONVERT_DOUBLE_ARG_CHECKED(value, 2);
+  volatile Atomic32* address =
+      AtomicsElementAddress(isolate, args[0], index);
+  if (address == NULL) return ThrowInvalidAtomicAccess(isolate, args[0]);
+  Atomic32 new_value = DoubleToInt32(value);
+  MemoryBarrier();
+  NoBarrier_Store(address, new_value);
+  MemoryBarrier();
+  return AtomicsResult(isolate, args[0], new_value);
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_AtomicsCompareExchange) {
+  SealHandleScope shs(isolate);
+  ASSERT(args.length() == 4);
+  CONVERT_DOUBLE_ARG_CHECKED(index, 1);
+  CONVERT_DOUBLE_ARG_CHECKED(expected, 2);
+  CONVERT_DOUBLE_ARG_CHECKED(replacement, 3);
+  volatile Atomic32* address =
+      AtomicsElementAddress(isolate, args[0], index);
+  if (address == NULL) return ThrowInvalidAtomicAccess(isolate, args[0]);
+  MemoryBarrier();
+  Atomic32 old_value = NoBarrier_CompareAndSwap(
+      address, DoubleToInt32(expected), DoubleToInt32(replacement));
+  MemoryBarrier();
+  return AtomicsResult(isolate, args[0], old_value);
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_AtomicsAdd) {
+  SealHandleScope shs(isolate);
+  ASSERT(args.length() == 3);
+  CONVERT_DOUBLE_ARG_CHECKED(index, 1);
+  CONVERT_DOUBLE_ARG_CHECKED(value, 2);
+  volatile Atomic32* address =
+      AtomicsElementAddress(isolate, args[0], index);
+  if (address == NULL) return ThrowInvalidAtomicAccess(isolate, args[0]);
+  Atomic32 increment = DoubleToInt32(value);
+  // Barrier_AtomicIncrement returns the new value; Atomics.add returns the
+  // value the element had before the addition.
+  Atomic32 new_value = Barrier_AtomicIncrement(address, increment);
+  MemoryBarrier();
+  return AtomicsResult(isolate, args[0], new_value - increment);
 }
 
 
@@ -1413,7 +1705,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<ObjectHashSet> table = isolate->factory()->NewObjectHashSet(0);
+  Handle<OrderedHashSet> table = isolate->factory()->NewOrderedHashSet();
   holder->set_table(*table);
   return *holder;
 }
@@ -1424,8 +1716,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetAdd) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
   Handle<Object> key(args[1], isolate);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  table = ObjectHashSet::Add(table, key);
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
+  table = OrderedHashSet::Add(table, key);
   holder->set_table(*table);
   return isolate->heap()->undefined_value();
 }
@@ -1436,7 +1728,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetHas) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
   Handle<Object> key(args[1], isolate);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
   return isolate->heap()->ToBoolean(table->Contains(*key));
 }
 
@@ -1446,8 +1738,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetDelete) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
   Handle<Object> key(args[1], isolate);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
-  table = ObjectHashSet::Remove(table, key);
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
+  table = OrderedHashSet::Remove(table, key);
   holder->set_table(*table);
   return isolate->heap()->undefined_value();
 }
@@ -1457,7 +1749,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetGetSize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSSet, holder, 0);
-  Handle<ObjectHashSet> table(ObjectHashSet::cast(holder->table()));
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(holder->table()));
   return Smi::FromInt(table->NumberOfElements());
 }
 
@@ -1466,7 +1758,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapInitialize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  Handle<ObjectHashTable> table = isolate->factory()->NewObjectHashTable(0);
+  Handle<OrderedHashMap> table = isolate->factory()->NewOrderedHashMap();
   holder->set_table(*table);
   return *holder;
 }
@@ -1477,7 +1769,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapGet) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
   CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
   Handle<Object> lookup(table->Lookup(*key), isolate);
   return lookup->IsTheHole() ? isolate->heap()->undefined_value() : *lookup;
 }
@@ -1488,7 +1780,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapHas) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
   CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
   Handle<Object> lookup(table->Lookup(*key), isolate);
   return isolate->heap()->ToBoolean(!lookup->IsTheHole());
 }
@@ -1499,10 +1791,10 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapDelete) {
   ASSERT(args.length() == 2);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
   CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
   Handle<Object> lookup(table->Lookup(*key), isolate);
-  Handle<ObjectHashTable> new_table =
-      ObjectHashTable::Put(table, key, isolate->factory()->the_hole_value());
+  Handle<OrderedHashMap> new_table =
+      OrderedHashMap::Put(table, key, isolate->factory()->the_hole_value());
   holder->set_table(*new_table);
   return isolate->heap()->ToBoolean(!lookup->IsTheHole());
 }
@@ -1514,8 +1806,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapSet) {
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
   CONVERT_ARG_HANDLE_CHECKED(Object, key, 1);
   CONVERT_ARG_HANDLE_CHECKED(Object, value, 2);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
-  Handle<ObjectHashTable> new_table = ObjectHashTable::Put(table, key, value);
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
+  Handle<OrderedHashMap> new_table = OrderedHashMap::Put(table, key, value);
   holder->set_table(*new_table);
   return isolate->heap()->undefined_value();
 }
@@ -1525,7 +1817,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_MapGetSize) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 1);
   CONVERT_ARG_HANDLE_CHECKED(JSMap, holder, 0);
-  Handle<ObjectHashTable> table(ObjectHashTable::cast(holder->table()));
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(holder->table()));
   return Smi::FromInt(table->NumberOfElements());
 }
 
@@ -2637,6 +2929,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SpecialArrayFunctions) {
   InstallBuiltin(isolate, holder, "slice", Builtins::kArraySlice);
   InstallBuiltin(isolate, holder, "splice", Builtins::kArraySplice);
   InstallBuiltin(isolate, holder, "concat", Builtins::kArrayConcat);
+  InstallBuiltin(isolate, holder, "indexOf", Builtins::kArrayIndexOf);
 
   return *holder;
 }
@@ -4106,6 +4399,48 @@ MUST_USE_RESULT static MaybeObject* StringReplaceGlobalRegExpWithEmptyString(
 }
 
 
+// Replays a cached global replace.  The cache entry holds the result
+// followed by the registers of the last match.
+static Object* ApplyCachedReplaceResult(Handle<String> subject,
+                                        Handle<JSArray> last_match_info,
+                                        Handle<FixedArray> entry) {
+  int register_count = entry->length() - 1;
+  RegExpImpl::SetLastMatchInfo(
+      last_match_info, subject, register_count / 2 - 1, NULL);
+  FixedArray* array = FixedArray::cast(last_match_info->elements());
+  for (int i = 0; i < register_count; i++) {
+    RegExpImpl::SetCapture(array, i, Smi::cast(entry->get(i + 1))->value());
+  }
+  return entry->get(0);
+}
+
+
+static void EnterReplaceResult(Isolate* isolate,
+                               Handle<String> subject,
+                               Handle<JSRegExp> regexp,
+                               Handle<String> replacement,
+                               Handle<JSArray> last_match_info,
+                               Handle<Object> result) {
+  // Without a match the last match info is left untouched.
+  if (*result == *subject) return;
+  FixedArray* info = FixedArray::cast(last_match_info->elements());
+  int register_count = RegExpImpl::GetLastCaptureCount(info);
+  Handle<FixedArray> entry =
+      isolate->factory()->NewFixedArray(register_count + 1);
+  info = FixedArray::cast(last_match_info->elements());
+  entry->set(0, *result);
+  for (int i = 0; i < register_count; i++) {
+    entry->set(i + 1, Smi::FromInt(RegExpImpl::GetCapture(info, i)));
+  }
+  RegExpResultsCache::Enter(isolate->heap(),
+                            *subject,
+                            regexp->data(),
+                            *entry,
+                            RegExpResultsCache::REGEXP_REPLACE_STRING,
+                            *replacement);
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_StringReplaceGlobalRegExpWithString) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 4);
@@ -4118,21 +4453,46 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringReplaceGlobalRegExpWithString) {
   ASSERT(regexp->GetFlags().is_global());
 
   if (!subject->IsFlat()) subject = FlattenGetString(subject);
+  if (!replacement->IsFlat()) replacement = FlattenGetString(replacement);
+
+  static const int kMinLengthToCache = 0x400;
+  bool use_cache = subject->length() >= kMinLengthToCache;
+  if (use_cache) {
+    Object* cached_answer = RegExpResultsCache::Lookup(
+        isolate->heap(),
+        *subject,
+        regexp->data(),
+        RegExpResultsCache::REGEXP_REPLACE_STRING,
+        *replacement);
+    if (cached_answer != Smi::FromInt(0)) {
+      return ApplyCachedReplaceResult(
+          subject, last_match_info,
+          Handle<FixedArray>(FixedArray::cast(cached_answer), isolate));
+    }
+  }
 
+  MaybeObject* maybe_result;
   if (replacement->length() == 0) {
     if (subject->HasOnlyOneByteChars()) {
-      return StringReplaceGlobalRegExpWithEmptyString<SeqOneByteString>(
-          isolate, subject, regexp, last_match_info);
+      maybe_result =
+          StringReplaceGlobalRegExpWithEmptyString<SeqOneByteString>(
+              isolate, subject, regexp, last_match_info);
     } else {
-      return StringReplaceGlobalRegExpWithEmptyString<SeqTwoByteString>(
-          isolate, subject, regexp, last_match_info);
+      maybe_result =
+          StringReplaceGlobalRegExpWithEmptyString<SeqTwoByteString>(
+              isolate, subject, regexp, last_match_info);
     }
+  } else {
+    maybe_result = StringReplaceGlobalRegExpWithString(
+        isolate, subject, regexp, replacement, last_match_info);
   }
 
-  if (!replacement->IsFlat()) replacement = FlattenGetString(replacement);
-
-  return StringReplaceGlobalRegExpWithString(
-      isolate, subject, regexp, replacement, last_match_info);
+  Object* result;
+  if (!use_cache || !maybe_result->ToObject(&result)) return maybe_result;
+  Handle<Object> result_handle(result, isolate);
+  EnterReplaceResult(isolate, subject, regexp, replacement, last_match_info,
+                     result_handle);
+  return *result_handle;
 }
 
 
@@ -4208,9 +4568,70 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringReplaceOneCharWithString) {
 }
 
 
+// Replaces the first occurrence of search in subject with a replacement that
+// needs no $-expansion. The result is a cons string of the replacement and
+// substrings of the subject, which are sliced strings for longer parts.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_StringReplaceFirstWithString) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 3);
+  CONVERT_ARG_HANDLE_CHECKED(String, subject, 0);
+  CONVERT_ARG_HANDLE_CHECKED(String, search, 1);
+  CONVERT_ARG_HANDLE_CHECKED(String, replace, 2);
+
+  int index = Runtime::StringMatch(isolate, subject, search, 0);
+  if (index == -1) return *subject;
+
+  Factory* factory = isolate->factory();
+  Handle<String> first = factory->NewSubString(subject, 0, index);
+  Handle<String> cons = factory->NewConsString(first, replace);
+  Handle<String> second = factory->NewSubString(
+      subject, index + search->length(), subject->length());
+  return *factory->NewConsString(cons, second);
+}
+
+
 // Perform string match of pattern on subject, starting at start index.
 // Caller must ensure that 0 <= start_index <= sub->length(),
 // and should check that pat->length() + start_index <= sub->length().
+// Searches a cons string leaf by leaf instead of flattening it.  Matches
+// within a leaf are found with a StringSearch per subject encoding, those
+// that straddle leaves are checked with a character stream.
+template <typename PatternChar>
+static int SearchConsString(Isolate* isolate,
+                            String* subject,
+                            Vector<const PatternChar> pattern,
+                            int start_index) {
+  StringSearch<PatternChar, uint8_t> one_byte_search(isolate, pattern);
+  StringSearch<PatternChar, uc16> two_byte_search(isolate, pattern);
+  int pattern_length = pattern.length();
+  int last_position = subject->length() - pattern_length;
+  ConsStringIteratorOp segment_op;
+  ConsStringIteratorOp stream_op;
+  StringSegmentIterator segments(subject, &segment_op);
+  while (segments.Next()) {
+    int segment_end = segments.offset() + segments.length();
+    if (segment_end <= start_index) continue;
+    int from = Max(start_index, segments.offset());
+    if (segment_end - from >= pattern_length) {
+      int index = from - segments.offset();
+      int found = segments.is_one_byte()
+          ? one_byte_search.Search(segments.ToOneByteVector(), index)
+          : two_byte_search.Search(segments.ToUC16Vector(), index);
+      if (found >= 0) return segments.offset() + found;
+    }
+    for (int i = Max(from, segment_end - pattern_length + 1);
+         i < segment_end && i <= last_position;
+         i++) {
+      StringCharacterStream stream(subject, &stream_op, i);
+      int j = 0;
+      while (j < pattern_length && stream.GetNext() == pattern[j]) j++;
+      if (j == pattern_length) return i;
+    }
+  }
+  return -1;
+}
+
+
 int Runtime::StringMatch(Isolate* isolate,
                          Handle<String> sub,
                          Handle<String> pat,
@@ -4224,9 +4645,25 @@ int Runtime::StringMatch(Isolate* isolate,
   int subject_length = sub->length();
   if (start_index + pattern_length > subject_length) return -1;
 
-  if (!sub->IsFlat()) FlattenString(sub);
   if (!pat->IsFlat()) FlattenString(pat);
 
+  // A search from the start of a rope is typically a one-off test, read
+  // the rope in place rather than copying all of it.  Searches resuming
+  // from an index tend to be repeated and are better served by flattening
+  // once.
+  if (!sub->IsFlat() && start_index == 0) {
+    DisallowHeapAllocation no_gc;
+    String::FlatContent seq_pat = pat->GetFlatContent();
+    if (seq_pat.IsAscii()) {
+      return SearchConsString(isolate, *sub, seq_pat.ToOneByteVector(),
+                              start_index);
+    }
+    return SearchConsString(isolate, *sub, seq_pat.ToUC16Vector(),
+                            start_index);
+  }
+
+  if (!sub->IsFlat()) FlattenString(sub);
+
   DisallowHeapAllocation no_gc;  // ensure vectors stay valid
   // Extract flattened substrings of cons strings before determining asciiness.
   String::FlatContent seq_sub = sub->GetFlatContent();
@@ -4602,6 +5039,11 @@ static MaybeObject* SearchRegExpMultiple(
           if (start >= 0) {
             int end = current_match[i * 2 + 1];
             ASSERT(start <= end);
+            if (start == match_start && end == match_end) {
+              // A capture spanning the whole match shares its string.
+              elements->set(i, *match);
+              continue;
+            }
             Handle<String> substring =
                 isolate->factory()->NewSubString(subject, start, end);
             elements->set(i, *substring);
@@ -5119,6 +5561,110 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_DefineOrRedefineDataProperty) {
 }
 
 
+// Reads a field of a property descriptor object like ToPropertyDescriptor
+// in v8natives.js. Leaves |value| empty if the field is absent. Returns
+// false if reading the field could be observed, i.e. if it is found as
+// anything but a plain data property.
+static bool GetPropertyDescriptorField(Isolate* isolate,
+                                       Handle<JSObject> descriptor,
+                                       Handle<Name> key,
+                                       Handle<Object>* value) {
+  LookupResult lookup(isolate);
+  descriptor->Lookup(*key, &lookup);
+  if (!lookup.IsFound()) return true;
+  if (!lookup.IsDataProperty() || lookup.holder()->IsAccessCheckNeeded()) {
+    return false;
+  }
+  *value = Object::GetProperty(descriptor, key);
+  return !value->is_null();
+}
+
+
+// Fast case of Object.defineProperty. Defines a property that does not exist
+// yet on an ordinary extensible object directly from the attributes object,
+// without allocating a PropertyDescriptor. Returns false without side effects
+// when the generic code in v8natives.js has to handle the call, which is also
+// the case whenever the generic code would throw.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_DefineOwnPropertyFastCase) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 3);
+  CONVERT_ARG_HANDLE_CHECKED(JSReceiver, receiver, 0);
+  CONVERT_ARG_HANDLE_CHECKED(Name, name, 1);
+  CONVERT_ARG_HANDLE_CHECKED(Object, attributes, 2);
+  Heap* heap = isolate->heap();
+
+  uint32_t index;
+  if (!receiver->IsJSObject() ||
+      !attributes->IsJSObject() ||
+      name->AsArrayIndex(&index)) {
+    return heap->false_value();
+  }
+  Handle<JSObject> object = Handle<JSObject>::cast(receiver);
+  Handle<JSObject> descriptor = Handle<JSObject>::cast(attributes);
+  if (object->IsAccessCheckNeeded() ||
+      object->IsJSGlobalProxy() ||
+      object->IsGlobalObject() ||
+      object->HasNamedInterceptor() ||
+      object->map()->is_observed() ||
+      !object->map()->is_extensible() ||
+      descriptor->IsAccessCheckNeeded()) {
+    return heap->false_value();
+  }
+  LookupResult lookup(isolate);
+  object->LocalLookupRealNamedProperty(*name, &lookup);
+  if (lookup.IsFound()) return heap->false_value();
+
+  Handle<Object> enumerable, configurable, value, writable, getter, setter;
+  if (!GetPropertyDescriptorField(isolate, descriptor,
+          isolate->factory()->enumerable_string(), &enumerable) ||
+      !GetPropertyDescriptorField(isolate, descriptor,
+          isolate->factory()->configurable_string(), &configurable) ||
+      !GetPropertyDescriptorField(isolate, descriptor,
+          isolate->factory()->value_string(), &value) ||
+      !GetPropertyDescriptorField(isolate, descriptor,
+          isolate->factory()->writable_string(), &writable) ||
+      !GetPropertyDescriptorField(isolate, descriptor,
+          isolate->factory()->get_string(), &getter) ||
+      !GetPropertyDescriptorField(isolate, descriptor,
+          isolate->factory()->set_string(), &setter)) {
+    return heap->false_value();
+  }
+  bool is_accessor = !getter.is_null() || !setter.is_null();
+  if ((!getter.is_null() && !getter->IsUndefined() &&
+       !getter->IsSpecFunction()) ||
+      (!setter.is_null() && !setter->IsUndefined() &&
+       !setter->IsSpecFunction()) ||
+      (is_accessor && (!value.is_null() || !writable.is_null()))) {
+    return heap->false_value();
+  }
+
+  // Absent fields default to false for a new property.
+  int attr = NONE;
+  if (enumerable.is_null() || !enumerable->BooleanValue()) attr |= DONT_ENUM;
+  if (configurable.is_null() || !configurable->BooleanValue()) {
+    attr |= DONT_DELETE;
+  }
+
+  if (is_accessor) {
+    Handle<Object> null = isolate->factory()->null_value();
+    bool fast = object->HasFastProperties();
+    JSObject::DefineAccessor(object, name,
+                             getter.is_null() ? null : getter,
+                             setter.is_null() ? null : setter,
+                             static_cast<PropertyAttributes>(attr));
+    RETURN_IF_SCHEDULED_EXCEPTION(isolate);
+    if (fast) JSObject::TransformToFastProperties(object, 0);
+  } else {
+    if (writable.is_null() || !writable->BooleanValue()) attr |= READ_ONLY;
+    if (value.is_null()) value = isolate->factory()->undefined_value();
+    Handle<Object> result = Runtime::ForceSetObjectProperty(
+        isolate, object, name, value, static_cast<PropertyAttributes>(attr));
+    RETURN_IF_EMPTY_HANDLE(isolate, result);
+  }
+  return heap->true_value();
+}
+
+
 // Return property without being observable by accessors or interceptors.
 RUNTIME_FUNCTION(MaybeObject*, Runtime_GetDataProperty) {
   SealHandleScope shs(isolate);
@@ -5696,6 +6242,14 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_GetPropertyNamesFast) {
 
   if (raw_object->IsSimpleEnum()) return raw_object->map();
 
+  // The key list is only read by the for-in loop, so it can be shared
+  // between loops over objects with the same prototype chain maps.
+  ForInCache* cache = isolate->for_in_cache();
+  if (raw_object->IsJSObject()) {
+    FixedArray* keys = cache->Lookup(JSObject::cast(raw_object));
+    if (keys != NULL) return keys;
+  }
+
   HandleScope scope(isolate);
   Handle<JSReceiver> object(raw_object);
   bool threw = false;
@@ -5706,6 +6260,9 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_GetPropertyNamesFast) {
   // Test again, since cache may have been built by preceding call.
   if (object->IsSimpleEnum()) return object->map();
 
+  if (object->IsJSObject()) {
+    cache->Update(JSObject::cast(*object), *content);
+  }
   return *content;
 }
 
@@ -6144,6 +6701,12 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringToNumber) {
       }
       return Smi::FromInt(d);
     }
+
+    // Plain decimal numbers do not need the full StringToDouble machinery.
+    double value;
+    if (FastStringToDouble(Vector<const uint8_t>(data, len), &value)) {
+      return isolate->heap()->NumberFromDouble(value);
+    }
   }
 
   // Slower case.
@@ -6205,6 +6768,38 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_URIUnescape) {
 }
 
 
+// Returns undefined if the string has to be handled by uri.js.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_URIEncode) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(String, source, 0);
+  CONVERT_BOOLEAN_ARG_CHECKED(component, 1);
+  Handle<String> string = FlattenGetString(source);
+  if (!string->IsOneByteRepresentationUnderneath()) {
+    return isolate->heap()->undefined_value();
+  }
+  Handle<String> result = URICodec::EncodeOneByte(isolate, string, component);
+  if (result.is_null()) return isolate->heap()->undefined_value();
+  return *result;
+}
+
+
+// Returns undefined if the string has to be handled by uri.js.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_URIDecode) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(String, source, 0);
+  CONVERT_BOOLEAN_ARG_CHECKED(component, 1);
+  Handle<String> string = FlattenGetString(source);
+  if (!string->IsOneByteRepresentationUnderneath()) {
+    return isolate->heap()->undefined_value();
+  }
+  Handle<String> result = URICodec::DecodeOneByte(isolate, string, component);
+  if (result.is_null()) return isolate->heap()->undefined_value();
+  return *result;
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_QuoteJSONString) {
   HandleScope scope(isolate);
   CONVERT_ARG_HANDLE_CHECKED(String, string, 0);
@@ -6221,6 +6816,14 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_BasicJSONStringify) {
 }
 
 
+MaybeObject* Runtime::StringifyJSONToStream(Isolate* isolate,
+                                            Handle<Object> object,
+                                            v8::OutputStream* stream) {
+  BasicJsonStringifier stringifier(isolate);
+  return stringifier.StringifyToStream(object, stream);
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_StringParseInt) {
   SealHandleScope shs(isolate);
 
@@ -6470,6 +7073,32 @@ static bool FastAsciiConvert(char* dst,
   return true;
 }
 
+
+// Returns the length of the prefix of |src| that is ASCII and needs no
+// conversion.
+template<class Converter>
+static int UnchangedAsciiPrefixLength(const char* src, int length) {
+  DisallowHeapAllocation no_gc;
+  static const char lo = Converter::kIsToLower ? 'A' - 1 : 'a' - 1;
+  static const char hi = Converter::kIsToLower ? 'Z' + 1 : 'z' + 1;
+  const char* const start = src;
+  const char* const limit = src + length;
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+  while (src <= limit - sizeof(uintptr_t)) {
+    const uintptr_t w = *reinterpret_cast<const uintptr_t*>(src);
+    // AsciiRangeMask requires ASCII input, test that first.
+    if ((w & kAsciiMask) != 0 || AsciiRangeMask(w, lo, hi) != 0) break;
+    src += sizeof(uintptr_t);
+  }
+#endif
+  while (src < limit) {
+    char c = *src;
+    if ((c & 0x80) != 0 || (lo < c && c < hi)) break;
+    ++src;
+  }
+  return static_cast<int>(src - start);
+}
+
 }  // namespace
 
 
@@ -6492,20 +7121,41 @@ MUST_USE_RESULT static MaybeObject* ConvertCase(
   // might break in the future if we implement more context and locale
   // dependent upper/lower conversions.
   if (s->IsOneByteRepresentationUnderneath()) {
-    Handle<SeqOneByteString> result =
-        isolate->factory()->NewRawOneByteString(length);
+    // Keys and header names often are in the requested case already, find
+    // out before allocating a result.
+    int prefix_length;
+    bool prefix_ends_in_ascii;
+    { DisallowHeapAllocation no_gc;
+      const char* chars = reinterpret_cast<const char*>(
+          s->GetFlatContent().ToOneByteVector().start());
+      prefix_length = UnchangedAsciiPrefixLength<Converter>(chars, length);
+      if (prefix_length == length) return *s;
+      prefix_ends_in_ascii = (chars[prefix_length] & 0x80) == 0;
+    }
+
+    if (prefix_ends_in_ascii) {
+      Handle<SeqOneByteString> result =
+          isolate->factory()->NewRawOneByteString(length);
 
-    DisallowHeapAllocation no_gc;
-    String::FlatContent flat_content = s->GetFlatContent();
-    ASSERT(flat_content.IsFlat());
-    bool has_changed_character = false;
-    bool is_ascii = FastAsciiConvert<Converter>(
-        reinterpret_cast<char*>(result->GetChars()),
-        reinterpret_cast<const char*>(flat_content.ToOneByteVector().start()),
-        length,
-        &has_changed_character);
-    // If not ASCII, we discard the result and take the 2 byte path.
-    if (is_ascii)  return has_changed_character ? *result : *s;
+      DisallowHeapAllocation no_gc;
+      String::FlatContent flat_content = s->GetFlatContent();
+      ASSERT(flat_content.IsFlat());
+      char* dst = reinterpret_cast<char*>(result->GetChars());
+      const char* src =
+          reinterpret_cast<const char*>(flat_content.ToOneByteVector().start());
+      CopyChars(dst, src, prefix_length);
+      bool has_changed_character = false;
+      bool is_ascii = FastAsciiConvert<Converter>(
+          dst + prefix_length,
+          src + prefix_length,
+          length - prefix_length,
+          &has_changed_character);
+      // If not ASCII, we discard the result and take the 2 byte path.
+      if (is_ascii) {
+        ASSERT(has_changed_character);
+        return *result;
+      }
+    }
   }
 
   Handle<SeqString> result;
@@ -6543,6 +7193,13 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringToUpperCase) {
 }
 
 
+// The whitespace and line terminator characters of the one-byte range:
+// TAB, LF, VT, FF, CR, SP and NBSP.
+static inline bool IsOneByteWhiteSpaceOrLineTerminator(uint8_t c) {
+  return c == 0x20 || (0x09 <= c && c <= 0x0D) || c == 0xA0;
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_StringTrim) {
   HandleScope scope(isolate);
   ASSERT(args.length() == 3);
@@ -6555,6 +7212,28 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringTrim) {
   int length = string->length();
 
   int left = 0;
+  int right = length;
+  if (string->IsOneByteRepresentationUnderneath()) {
+    // Read the characters directly, and check for the common case of a
+    // string that has nothing to trim without any further dispatch.
+    DisallowHeapAllocation no_gc;
+    Vector<const uint8_t> chars = string->GetFlatContent().ToOneByteVector();
+    if (trimLeft) {
+      while (left < length &&
+             IsOneByteWhiteSpaceOrLineTerminator(chars[left])) {
+        left++;
+      }
+    }
+    if (trimRight) {
+      while (right > left &&
+             IsOneByteWhiteSpaceOrLineTerminator(chars[right - 1])) {
+        right--;
+      }
+    }
+    if (left == 0 && right == length) return *string;
+    return *isolate->factory()->NewSubString(string, left, right);
+  }
+
   UnicodeCache* unicode_cache = isolate->unicode_cache();
   if (trimLeft) {
     while (left < length &&
@@ -6563,7 +7242,6 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringTrim) {
     }
   }
 
-  int right = length;
   if (trimRight) {
     while (right > left &&
            unicode_cache->IsWhiteSpaceOrLineTerminator(
@@ -6666,6 +7344,100 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringSplit) {
 }
 
 
+// Splits a non-empty subject around the matches of a regexp.  The matcher
+// is run over the subject through a GlobalCache, so native code can find
+// many matches per entry instead of being entered once per part.  An empty
+// match at the start of the current part is skipped, and a match at the end
+// of the subject ends the split.  Returns null if the regexp does not match
+// at all, in which case the last match info is untouched.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_StringSplitRegExp) {
+  HandleScope handle_scope(isolate);
+  ASSERT(args.length() == 4);
+  CONVERT_ARG_HANDLE_CHECKED(String, subject, 0);
+  CONVERT_ARG_HANDLE_CHECKED(JSRegExp, regexp, 1);
+  CONVERT_NUMBER_CHECKED(uint32_t, limit, Uint32, args[2]);
+  CONVERT_ARG_HANDLE_CHECKED(JSArray, last_match_info, 3);
+  RUNTIME_ASSERT(limit > 0);
+
+  subject = FlattenGetString(subject);
+  int length = subject->length();
+  RUNTIME_ASSERT(length > 0);
+
+  RegExpImpl::GlobalCache global_cache(regexp, subject, true, isolate);
+  if (global_cache.HasException()) return Failure::Exception();
+
+  int capture_count = regexp->CaptureCount();
+  int registers_per_match = (capture_count + 1) * 2;
+
+  ZoneScope zone_scope(isolate->runtime_zone());
+  // Start and end offsets of the parts; undefined captures are -1, -1.
+  ZoneList<int> offsets(16, zone_scope.zone());
+  // Copy of the last match a search from JavaScript would have seen.
+  ZoneList<int> last_match(registers_per_match, zone_scope.zone());
+  last_match.AddBlock(-1, registers_per_match, zone_scope.zone());
+
+  bool matched = false;
+  bool limit_reached = false;
+  uint32_t part_count = 0;
+  int part_start = 0;
+  int search_start = 0;
+  while (!limit_reached) {
+    int32_t* match = global_cache.FetchNext();
+    if (match == NULL) break;
+    // A search from the end of the subject cannot produce a part, so it
+    // must not update the last match info either.
+    if (search_start == length) break;
+    int match_start = match[0];
+    int match_end = match[1];
+    matched = true;
+    for (int i = 0; i < registers_per_match; i++) last_match[i] = match[i];
+    search_start = (match_start == match_end) ? match_end + 1 : match_end;
+
+    if (match_start == length) break;
+    if (match_start == match_end && match_end == part_start) continue;
+
+    offsets.Add(part_start, zone_scope.zone());
+    offsets.Add(match_start, zone_scope.zone());
+    limit_reached = (++part_count == limit);
+    for (int i = 1; i <= capture_count && !limit_reached; i++) {
+      offsets.Add(match[i * 2], zone_scope.zone());
+      offsets.Add(match[i * 2 + 1], zone_scope.zone());
+      limit_reached = (++part_count == limit);
+    }
+    part_start = match_end;
+  }
+
+  if (global_cache.HasException()) return Failure::Exception();
+  if (!matched) return isolate->heap()->null_value();
+
+  RegExpImpl::SetLastMatchInfo(
+      last_match_info, subject, capture_count, last_match.ToVector().start());
+
+  if (!limit_reached) {
+    offsets.Add(part_start, zone_scope.zone());
+    offsets.Add(length, zone_scope.zone());
+    part_count++;
+  }
+
+  Handle<FixedArray> elements =
+      isolate->factory()->NewFixedArray(static_cast<int>(part_count));
+  for (int i = 0; i < static_cast<int>(part_count); i++) {
+    HandleScope local_loop_handle(isolate);
+    int from = offsets.at(i * 2);
+    int to = offsets.at(i * 2 + 1);
+    if (from < 0) {
+      ASSERT(to < 0);
+      elements->set(i, isolate->heap()->undefined_value());
+    } else {
+      Handle<String> substring =
+          isolate->factory()->NewSubString(subject, from, to);
+      elements->set(i, *substring);
+    }
+  }
+  return *isolate->factory()->NewJSArrayWithElements(elements);
+}
+
+
 // Copies ASCII characters to the given fixed array looking up
 // one-char strings in the cache. Gives up on the first char that is
 // not in the cache and fills the remainder with smi zeros. Returns
@@ -7138,6 +7910,37 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringBuilderConcat) {
 }
 
 
+template <typename sinkchar>
+static void StringBuilderJoinHelper(String* separator,
+                                    sinkchar* sink,
+                                    FixedArray* fixed_array,
+                                    int array_length,
+                                    int length) {
+#ifdef DEBUG
+  sinkchar* end = sink + length;
+#endif
+  int separator_length = separator->length();
+
+  String* first = String::cast(fixed_array->get(0));
+  int first_length = first->length();
+  String::WriteToFlat(first, sink, 0, first_length);
+  sink += first_length;
+
+  for (int i = 1; i < array_length; i++) {
+    ASSERT(sink + separator_length <= end);
+    String::WriteToFlat(separator, sink, 0, separator_length);
+    sink += separator_length;
+
+    String* element = String::cast(fixed_array->get(i));
+    int element_length = element->length();
+    ASSERT(sink + element_length <= end);
+    String::WriteToFlat(element, sink, 0, element_length);
+    sink += element_length;
+  }
+  ASSERT(sink == end);
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_StringBuilderJoin) {
   SealHandleScope shs(isolate);
   ASSERT(args.length() == 3);
@@ -7172,6 +7975,10 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringBuilderJoin) {
       return Failure::OutOfMemoryException(0x17);
   }
   int length = (array_length - 1) * separator_length;
+  // %_FastAsciiArrayJoin only handles sequential one-byte strings, joins
+  // of cons, sliced or external one-byte strings end up here and should
+  // not produce a two-byte result.
+  bool one_byte = separator->HasOnlyOneByteChars();
   for (int i = 0; i < array_length; i++) {
     Object* element_obj = fixed_array->get(i);
     if (!element_obj->IsString()) {
@@ -7185,40 +7992,27 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_StringBuilderJoin) {
       return Failure::OutOfMemoryException(0x18);
     }
     length += increment;
+    if (one_byte && !element->HasOnlyOneByteChars()) one_byte = false;
   }
 
   Object* object;
+  if (one_byte) {
+    { MaybeObject* maybe_object =
+          isolate->heap()->AllocateRawOneByteString(length);
+      if (!maybe_object->ToObject(&object)) return maybe_object;
+    }
+    SeqOneByteString* answer = SeqOneByteString::cast(object);
+    StringBuilderJoinHelper(separator, answer->GetChars(), fixed_array,
+                            array_length, length);
+    return answer;
+  }
   { MaybeObject* maybe_object =
         isolate->heap()->AllocateRawTwoByteString(length);
     if (!maybe_object->ToObject(&object)) return maybe_object;
   }
   SeqTwoByteString* answer = SeqTwoByteString::cast(object);
-
-  uc16* sink = answer->GetChars();
-#ifdef DEBUG
-  uc16* end = sink + length;
-#endif
-
-  String* first = String::cast(fixed_array->get(0));
-  int first_length = first->length();
-  String::WriteToFlat(first, sink, 0, first_length);
-  sink += first_length;
-
-  for (int i = 1; i < array_length; i++) {
-    ASSERT(sink + separator_length <= end);
-    String::WriteToFlat(separator, sink, 0, separator_length);
-    sink += separator_length;
-
-    String* element = String::cast(fixed_array->get(i));
-    int element_length = element->length();
-    ASSERT(sink + element_length <= end);
-    String::WriteToFlat(element, sink, 0, element_length);
-    sink += element_length;
-  }
-  ASSERT(sink == end);
-
-  // Use %_FastAsciiArrayJoin instead.
-  ASSERT(!answer->IsOneByteRepresentation());
+  StringBuilderJoinHelper(separator, answer->GetChars(), fixed_array,
+                          array_length, length);
   return answer;
 }
 
@@ -7475,19 +8269,15 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_NumberCompare) {
 
 // Compare two Smis as if they were converted to strings and then
 // compared lexicographically.
-RUNTIME_FUNCTION(MaybeObject*, Runtime_SmiLexicographicCompare) {
-  SealHandleScope shs(isolate);
-  ASSERT(args.length() == 2);
-  CONVERT_SMI_ARG_CHECKED(x_value, 0);
-  CONVERT_SMI_ARG_CHECKED(y_value, 1);
-
+// Compares the decimal string representations of two small integers.
+static int SmiLexicographicCompare(int x_value, int y_value) {
   // If the integers are equal so are the string representations.
-  if (x_value == y_value) return Smi::FromInt(EQUAL);
+  if (x_value == y_value) return EQUAL;
 
   // If one of the integers is zero the normal integer order is the
   // same as the lexicographic order of the string representations.
   if (x_value == 0 || y_value == 0)
-    return Smi::FromInt(x_value < y_value ? LESS : GREATER);
+    return x_value < y_value ? LESS : GREATER;
 
   // If only one of the integers is negative the negative number is
   // smallest because the char code of '-' is less than the char code
@@ -7498,8 +8288,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SmiLexicographicCompare) {
   uint32_t x_scaled = x_value;
   uint32_t y_scaled = y_value;
   if (x_value < 0 || y_value < 0) {
-    if (y_value >= 0) return Smi::FromInt(LESS);
-    if (x_value >= 0) return Smi::FromInt(GREATER);
+    if (y_value >= 0) return LESS;
+    if (x_value >= 0) return GREATER;
     x_scaled = -x_value;
     y_scaled = -y_value;
   }
@@ -7544,9 +8334,103 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SmiLexicographicCompare) {
     tie = GREATER;
   }
 
-  if (x_scaled < y_scaled) return Smi::FromInt(LESS);
-  if (x_scaled > y_scaled) return Smi::FromInt(GREATER);
-  return Smi::FromInt(tie);
+  if (x_scaled < y_scaled) return LESS;
+  if (x_scaled > y_scaled) return GREATER;
+  return tie;
+}
+
+
+RUNTIME_FUNCTION(MaybeObject*, Runtime_SmiLexicographicCompare) {
+  SealHandleScope shs(isolate);
+  ASSERT(args.length() == 2);
+  CONVERT_SMI_ARG_CHECKED(x_value, 0);
+  CONVERT_SMI_ARG_CHECKED(y_value, 1);
+  return Smi::FromInt(SmiLexicographicCompare(x_value, y_value));
+}
+
+
+struct SmiLexicographicLess {
+  bool operator()(Object* x, Object* y) const {
+    return SmiLexicographicCompare(Smi::cast(x)->value(),
+                                   Smi::cast(y)->value()) == LESS;
+  }
+};
+
+
+// A double to sort together with the offset of its string representation.
+struct DoubleSortEntry {
+  double value;
+  int key;
+};
+
+
+struct DoubleSortEntryLess {
+  explicit DoubleSortEntryLess(const char* keys) : keys_(keys) { }
+  bool operator()(const DoubleSortEntry& x, const DoubleSortEntry& y) const {
+    return strcmp(keys_ + x.key, keys_ + y.key) < 0;
+  }
+  const char* keys_;
+};
+
+
+// Sorts the first length elements of an array with fast smi or double
+// elements in the default sort order, i.e. by their string representations,
+// without calling into JavaScript.  The sort is stable.  Returns false and
+// leaves the array alone if the array does not qualify, e.g. because there
+// are holes in the range.
+RUNTIME_FUNCTION(MaybeObject*, Runtime_SortNumberElements) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(JSObject, object, 0);
+  CONVERT_NUMBER_CHECKED(uint32_t, limit, Uint32, args[1]);
+
+  if (!object->IsJSArray() ||
+      !(object->HasFastSmiElements() || object->HasFastDoubleElements()) ||
+      limit > static_cast<uint32_t>(object->elements()->length())) {
+    return isolate->heap()->false_value();
+  }
+  int length = static_cast<int>(limit);
+
+  if (object->HasFastSmiElements()) {
+    Handle<FixedArray> elements = JSObject::EnsureWritableFastElements(object);
+    DisallowHeapAllocation no_gc;
+    Object** data = elements->data_start();
+    for (int i = 0; i < length; i++) {
+      if (data[i]->IsTheHole()) return isolate->heap()->false_value();
+    }
+    // Smis can be moved around without write barriers.
+    TimSort<Object*, SmiLexicographicLess>::Sort(
+        data, length, SmiLexicographicLess());
+    return isolate->heap()->true_value();
+  }
+
+  DisallowHeapAllocation no_gc;
+  FixedDoubleArray* elements = FixedDoubleArray::cast(object->elements());
+  for (int i = 0; i < length; i++) {
+    if (elements->is_the_hole(i)) return isolate->heap()->false_value();
+  }
+  // Convert every element to a string once up front instead of on every
+  // comparison.
+  ScopedVector<DoubleSortEntry> entries(length);
+  List<char> keys(length * 8);
+  char buffer[kDoubleToCStringMinBufferSize];
+  Vector<char> buffer_vector(buffer, ARRAY_SIZE(buffer));
+  for (int i = 0; i < length; i++) {
+    double value = elements->get_scalar(i);
+    const char* key = DoubleToCString(value, buffer_vector);
+    entries[i].value = value;
+    entries[i].key = keys.length();
+    do {
+      keys.Add(*key);
+    } while (*key++ != '\0');
+  }
+  DoubleSortEntryLess less(keys.ToConstVector().start());
+  TimSort<DoubleSortEntry, DoubleSortEntryLess>::Sort(
+      entries.start(), length, less);
+  for (int i = 0; i < length; i++) {
+    elements->set(i, entries[i].value);
+  }
+  return isolate->heap()->true_value();
 }
 
 
@@ -8385,7 +9269,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CompileOptimized) {
     function->ReplaceCode(function->shared()->code());
   } else if (!isolate->use_crankshaft() ||
              function->shared()->optimization_disabled() ||
-             isolate->DebuggerHasBreakPoints()) {
+             isolate->DebuggerPreventsOptimization(function->shared())) {
     // If the function is not optimizable or debugger is active continue
     // using the code from the full compiler.
     if (FLAG_trace_opt) {
@@ -8393,7 +9277,8 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CompileOptimized) {
       function->PrintName();
       PrintF(": is code optimizable: %s, is debugger enabled: %s]\n",
           function->shared()->optimization_disabled() ? "F" : "T",
-          isolate->DebuggerHasBreakPoints() ? "T" : "F");
+          isolate->DebuggerPreventsOptimization(function->shared())
+              ? "T" : "F");
     }
     function->ReplaceCode(*unoptimized);
   } else {
@@ -8588,6 +9473,15 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_NeverOptimizeFunction) {
 }
 
 
+RUNTIME_FUNCTION(MaybeObject*, Runtime_NeverFlushFunction) {
+  HandleScope scope(isolate);
+  ASSERT(args.length() == 1);
+  CONVERT_ARG_CHECKED(JSFunction, function, 0);
+  function->shared()->set_dont_flush(true);
+  return isolate->heap()->undefined_value();
+}
+
+
 RUNTIME_FUNCTION(MaybeObject*, Runtime_GetOptimizationStatus) {
   HandleScope scope(isolate);
   RUNTIME_ASSERT(args.length() == 1 || args.length() == 2);
@@ -14016,7 +14910,7 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CreateCollator) {
   CONVERT_ARG_HANDLE_CHECKED(JSObject, options, 1);
   CONVERT_ARG_HANDLE_CHECKED(JSObject, resolved, 2);
 
-  Handle<ObjectTemplateInfo> collator_template = I18N::GetTemplate(isolate);
+  Handle<ObjectTemplateInfo> collator_template = I18N::GetTemplate2(isolate);
 
   // Create an empty object wrapper.
   bool has_pending_exception = false;
@@ -14027,13 +14921,17 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_CreateCollator) {
     return Failure::Exception();
   }
 
-  // Set collator as internal field of the resulting JS object.
+  // Set collator and the weights for its ASCII fast path as internal
+  // fields of the resulting JS object.
+  const ASCIICollationWeights* ascii_weights = NULL;
   icu::Collator* collator = Collator::InitializeCollator(
-      isolate, locale, options, resolved);
+      isolate, locale, options, resolved, &ascii_weights);
 
   if (!collator) return isolate->ThrowIllegalOperation();
 
   local_object->SetInternalField(0, reinterpret_cast<Smi*>(collator));
+  local_object->SetInternalField(1, reinterpret_cast<Smi*>(
+      const_cast<ASCIICollationWeights*>(ascii_weights)));
 
   RETURN_IF_EMPTY_HANDLE(isolate,
       JSObject::SetLocalPropertyIgnoreAttributes(
@@ -14062,6 +14960,17 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_InternalCompare) {
   icu::Collator* collator = Collator::UnpackCollator(isolate, collator_holder);
   if (!collator) return isolate->ThrowIllegalOperation();
 
+  const ASCIICollationWeights* ascii_weights =
+      Collator::UnpackASCIIWeights(collator_holder);
+  if (ascii_weights != NULL) {
+    string1 = FlattenGetString(string1);
+    string2 = FlattenGetString(string2);
+    int result;
+    if (Collator::CompareASCII(ascii_weights, *string1, *string2, &result)) {
+      return Smi::FromInt(result);
+    }
+  }
+
   v8::String::Value string_value1(v8::Utils::ToLocal(string1));
   v8::String::Value string_value2(v8::Utils::ToLocal(string2));
   const UChar* u_string1 = reinterpret_cast<const UChar*>(*string_value1);
@@ -14680,29 +15589,32 @@ RUNTIME_FUNCTION(MaybeObject*, Runtime_SetIsObserved) {
 }
 
 
-RUNTIME_FUNCTION(MaybeObject*, Runtime_SetMicrotaskPending) {
-  SealHandleScope shs(isolate);
+RUNTIME_FUNCTION(MaybeObject*, Runtime_EnqueueMicrotask) {
+  HandleScope scope(isolate);
   ASSERT(args.length() == 1);
-  CONVERT_BOOLEAN_ARG_CHECKED(new_state, 0);
-  bool old_state = isolate->microtask_pending();
-  isolate->set_microtask_pending(new_state);
-  return isolate->heap()->ToBoolean(old_state);
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, microtask, 0);
+  isolate->microtask_queue()->Enqueue(microtask);
+  return isolate->heap()->undefined_value();
 }
 
 
-RUNTIME_FUNCTION(MaybeObject*, Runtime_RunMicrotasks) {
+RUNTIME_FUNCTION(MaybeObject*, Runtime_EnqueuePromiseReactionJob) {
   HandleScope scope(isolate);
-  ASSERT(args.length() == 0);
-  if (isolate->microtask_pending())
-    Execution::RunMicrotasks(isolate);
+  ASSERT(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(Object, value, 0);
+  CONVERT_ARG_HANDLE_CHECKED(JSArray, tasks, 1);
+  Handle<Context> native_context(isolate->context()->native_context());
+  isolate->microtask_queue()->EnqueuePromiseReactionJob(
+      native_context, value, tasks);
   return isolate->heap()->undefined_value();
 }
 
 
-RUNTIME_FUNCTION(MaybeObject*, Runtime_GetMicrotaskState) {
-  SealHandleScope shs(isolate);
+RUNTIME_FUNCTION(MaybeObject*, Runtime_RunMicrotasks) {
+  HandleScope scope(isolate);
   ASSERT(args.length() == 0);
-  return isolate->heap()->microtask_state();
+  isolate->microtask_queue()->RunMicrotasks();
+  return isolate->heap()->undefined_value();
 }
 
 
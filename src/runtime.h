@@ -96,6 +96,7 @@ namespace internal {
   F(IsConcurrentRecompilationSupported, 0, 1) \
   F(OptimizeFunctionOnNextCall, -1, 1) \
   F(NeverOptimizeFunction, 1, 1) \
+  F(NeverFlushFunction, 1, 1) \
   F(GetOptimizationStatus, -1, 1) \
   F(GetOptimizationCount, 1, 1) \
   F(UnblockConcurrentRecompilation, 0, 1) \
@@ -127,9 +128,12 @@ namespace internal {
   F(StringToLowerCase, 1, 1) \
   F(StringToUpperCase, 1, 1) \
   F(StringSplit, 3, 1) \
+  F(StringSplitRegExp, 4, 1) \
   F(CharFromCode, 1, 1) \
   F(URIEscape, 1, 1) \
   F(URIUnescape, 1, 1) \
+  F(URIEncode, 2, 1) \
+  F(URIDecode, 2, 1) \
   \
   F(NumberToStringSkipCache, 1, 1) \
   F(NumberToInteger, 1, 1) \
@@ -169,6 +173,7 @@ namespace internal {
   \
   F(NumberCompare, 3, 1) \
   F(SmiLexicographicCompare, 2, 1) \
+  F(SortNumberElements, 2, 1) \
   \
   /* Math */ \
   F(Math_acos, 1, 1) \
@@ -201,6 +206,7 @@ namespace internal {
   F(StringLocaleCompare, 2, 1) \
   F(StringReplaceGlobalRegExpWithString, 4, 1) \
   F(StringReplaceOneCharWithString, 3, 1) \
+  F(StringReplaceFirstWithString, 3, 1) \
   F(StringMatch, 3, 1) \
   F(StringTrim, 3, 1) \
   F(StringToArray, 2, 1) \
@@ -273,6 +279,7 @@ namespace internal {
   F(SetProperty, -1 /* 4 or 5 */, 1) \
   F(DefineOrRedefineDataProperty, 4, 1) \
   F(DefineOrRedefineAccessorProperty, 5, 1) \
+  F(DefineOwnPropertyFastCase, 3, 1) \
   F(IgnoreAttributesAndSetProperty, -1 /* 3 or 4 */, 1) \
   F(GetDataProperty, 2, 1) \
   F(SetHiddenProperty, 3, 1) \
@@ -303,9 +310,6 @@ namespace internal {
   /* ES5 */ \
   F(ObjectFreeze, 1, 1) \
   \
-  /* Harmony Microtasks */ \
-  F(GetMicrotaskState, 0, 1) \
-  \
   /* Harmony modules */ \
   F(IsJSModule, 1, 1) \
   \
@@ -349,7 +353,8 @@ namespace internal {
   F(WeakCollectionSet, 3, 1) \
   \
   /* Harmony events */ \
-  F(SetMicrotaskPending, 1, 1) \
+  F(EnqueueMicrotask, 1, 1) \
+  F(EnqueuePromiseReactionJob, 2, 1) \
   F(RunMicrotasks, 0, 1) \
   \
   /* Harmony observe */ \
@@ -374,6 +379,11 @@ namespace internal {
   F(TypedArrayGetLength, 1, 1) \
   F(TypedArraySetFastCases, 3, 1) \
   \
+  F(AtomicsLoad, 2, 1) \
+  F(AtomicsStore, 3, 1) \
+  F(AtomicsCompareExchange, 4, 1) \
+  F(AtomicsAdd, 3, 1) \
+  \
   F(DataViewInitialize, 4, 1) \
   F(DataViewGetBuffer, 1, 1) \
   F(DataViewGetByteLength, 1, 1) \
@@ -780,6 +790,12 @@ class Runtime : public AllStatic {
       Handle<Object> object,
       uint32_t index);
 
+  // Serializes |object| into |stream|, see v8::JSON::Stringify.
+  MUST_USE_RESULT static MaybeObject* StringifyJSONToStream(
+      Isolate* isolate,
+      Handle<Object> object,
+      v8::OutputStream* stream);
+
   static Handle<Object> SetObjectProperty(
       Isolate* isolate,
       Handle<Object> object,
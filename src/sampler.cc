@@ -51,6 +51,16 @@
 
 #include <unistd.h>
 
+#if V8_OS_LINUX && !V8_OS_ANDROID
+
+#define USE_PERF_EVENTS
+
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+
+#endif
+
 // GLibc on ARM defines mcontext_t has a typedef for 'struct sigcontext'.
 // Old versions of the C library <signal.h> didn't define the type.
 #if V8_OS_ANDROID && !defined(__BIONIC_HAVE_UCONTEXT_T) && \
@@ -187,13 +197,89 @@ class PlatformDataCommon : public Malloced {
 
 class Sampler::PlatformData : public PlatformDataCommon {
  public:
-  PlatformData() : vm_tid_(pthread_self()) {}
+  PlatformData() : vm_tid_(pthread_self()) {
+#if defined(USE_PERF_EVENTS)
+    vm_kernel_tid_ = static_cast<pid_t>(syscall(SYS_gettid));
+    perf_event_fd_ = -1;
+#endif
+  }
   pthread_t vm_tid() const { return vm_tid_; }
 
+#if defined(USE_PERF_EVENTS)
+  ~PlatformData() { ClosePerfEvent(); }
+
+  // A perf event that signals the VM thread with SIGPROF every interval_ms
+  // milliseconds of its CPU time. While it is open, the kernel drives the
+  // sampling and DoSample() has nothing to do.
+  bool HasPerfEvent() const { return perf_event_fd_ >= 0; }
+  bool OpenPerfEvent(int interval_ms);
+  void ClosePerfEvent();
+#endif
+
  private:
   pthread_t vm_tid_;
+#if defined(USE_PERF_EVENTS)
+  pid_t vm_kernel_tid_;
+  int perf_event_fd_;
+#endif
 };
 
+
+#if defined(USE_PERF_EVENTS)
+
+static int PerfEventOpen(struct perf_event_attr* attr, pid_t tid) {
+  return static_cast<int>(
+      syscall(__NR_perf_event_open, attr, tid, -1, -1, 0UL));
+}
+
+
+bool Sampler::PlatformData::OpenPerfEvent(int interval_ms) {
+  ASSERT(!HasPerfEvent());
+  if (interval_ms <= 0) return false;
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_SOFTWARE;
+  attr.size = sizeof(attr);
+  attr.config = PERF_COUNT_SW_TASK_CLOCK;
+  // The task clock counts nanoseconds the thread spent on a CPU.
+  attr.sample_period = static_cast<uint64_t>(interval_ms) * 1000000;
+  attr.wakeup_events = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  int fd = PerfEventOpen(&attr, vm_kernel_tid_);
+  if (fd < 0) {
+    // Some kernels reject the exclusion bits for software clock events.
+    attr.exclude_kernel = 0;
+    attr.exclude_hv = 0;
+    fd = PerfEventOpen(&attr, vm_kernel_tid_);
+  }
+  if (fd < 0) return false;
+  // Deliver the overflow notifications as SIGPROF to the VM thread itself,
+  // rather than to an arbitrary thread of the process.
+  struct f_owner_ex owner;
+  owner.type = F_OWNER_TID;
+  owner.pid = vm_kernel_tid_;
+  if (fcntl(fd, F_SETFD, FD_CLOEXEC) != 0 ||
+      fcntl(fd, F_SETOWN_EX, &owner) != 0 ||
+      fcntl(fd, F_SETSIG, SIGPROF) != 0 ||
+      fcntl(fd, F_SETFL, O_ASYNC) != 0) {
+    close(fd);
+    return false;
+  }
+  perf_event_fd_ = fd;
+  return true;
+}
+
+
+void Sampler::PlatformData::ClosePerfEvent() {
+  if (!HasPerfEvent()) return;
+  ioctl(perf_event_fd_, PERF_EVENT_IOC_DISABLE, 0);
+  close(perf_event_fd_);
+  perf_event_fd_ = -1;
+}
+
+#endif  // USE_PERF_EVENTS
+
 #elif V8_OS_WIN || V8_OS_CYGWIN
 
 // ----------------------------------------------------------------------------
@@ -659,14 +745,24 @@ void Sampler::Stop() {
 
 
 void Sampler::IncreaseProfilingDepth() {
-  NoBarrier_AtomicIncrement(&profiling_, 1);
+  Atomic32 depth = NoBarrier_AtomicIncrement(&profiling_, 1);
 #if defined(USE_SIGNALS)
   SignalHandler::IncreaseSamplerCount();
 #endif
+#if defined(USE_PERF_EVENTS)
+  // The perf event must only fire while the signal handler is installed.
+  if (depth == 1 && FLAG_perf_event_sampler && SignalHandler::Installed()) {
+    platform_data()->OpenPerfEvent(interval_);
+  }
+#endif
+  USE(depth);
 }
 
 
 void Sampler::DecreaseProfilingDepth() {
+#if defined(USE_PERF_EVENTS)
+  if (NoBarrier_Load(&profiling_) == 1) platform_data()->ClosePerfEvent();
+#endif
 #if defined(USE_SIGNALS)
   SignalHandler::DecreaseSamplerCount();
 #endif
@@ -695,6 +791,9 @@ void Sampler::SampleStack(const RegisterState& state) {
 
 void Sampler::DoSample() {
   if (!SignalHandler::Installed()) return;
+#if defined(USE_PERF_EVENTS)
+  if (platform_data()->HasPerfEvent()) return;
+#endif
   pthread_kill(platform_data()->vm_tid(), SIGPROF);
 }
 
@@ -302,6 +302,147 @@ void Utf8ToUtf16CharacterStream::SetRawPosition(unsigned target_position) {
 }
 
 
+// ----------------------------------------------------------------------------
+// ExternalStreamingUtf16CharacterStream
+
+ExternalStreamingUtf16CharacterStream::ExternalStreamingUtf16CharacterStream(
+    v8::ExternalSourceStream* source,
+    v8::ExternalSourceStream::Encoding encoding)
+    : BufferedUtf16CharacterStream(),
+      source_(source),
+      encoding_(encoding),
+      chunk_(NULL),
+      chunk_length_(0),
+      chunk_pos_(0),
+      done_(false),
+      current_position_(0),
+      split_char_length_(0) {
+  ReadBlock();
+}
+
+
+ExternalStreamingUtf16CharacterStream::
+    ~ExternalStreamingUtf16CharacterStream() { }
+
+
+unsigned ExternalStreamingUtf16CharacterStream::SlowSeekForward(
+    unsigned delta) {
+  // Buffered characters cannot be read again from the source, so skip by
+  // reading through them instead of dropping the buffer.
+  unsigned skipped = 0;
+  while (skipped < delta) {
+    if (Advance() == kEndOfInput) {
+      PushBack(kEndOfInput);
+      break;
+    }
+    skipped++;
+  }
+  return skipped;
+}
+
+
+unsigned ExternalStreamingUtf16CharacterStream::BufferSeekForward(
+    unsigned delta) {
+  // Only called from BufferedUtf16CharacterStream::SlowSeekForward.
+  UNREACHABLE();
+  return 0;
+}
+
+
+unsigned ExternalStreamingUtf16CharacterStream::FillBuffer(unsigned position,
+                                                           unsigned length) {
+  static const unibrow::uchar kMaxUtf16Character = 0xffff;
+  // The buffer is always refilled from where the previous fill ended, unless
+  // the scanner has read past the end of the source.
+  if (position != current_position_) return 0u;
+  unsigned i = 0;
+  while (i < length - 1) {
+    unibrow::uchar c;
+    if (!NextCharacter(&c)) break;
+    if (c > kMaxUtf16Character) {
+      buffer_[i++] = unibrow::Utf16::LeadSurrogate(c);
+      buffer_[i++] = unibrow::Utf16::TrailSurrogate(c);
+    } else {
+      buffer_[i++] = static_cast<uc16>(c);
+    }
+  }
+  current_position_ += i;
+  return i;
+}
+
+
+bool ExternalStreamingUtf16CharacterStream::FetchChunk() {
+  while (chunk_pos_ == chunk_length_) {
+    if (done_) return false;
+    chunk_length_ = source_->GetMoreData(&chunk_);
+    chunk_pos_ = 0;
+    if (chunk_length_ == 0) {
+      chunk_ = NULL;
+      done_ = true;
+    }
+  }
+  return true;
+}
+
+
+// Length of the UTF-8 sequence starting with |first_byte|. Invalid start
+// bytes count as sequences of length one.
+static unsigned Utf8SequenceLength(byte first_byte) {
+  if (first_byte < 0xC0) return 1;
+  if (first_byte < 0xE0) return 2;
+  if (first_byte < 0xF0) return 3;
+  if (first_byte < 0xF8) return 4;
+  return 1;
+}
+
+
+bool ExternalStreamingUtf16CharacterStream::NextCharacter(
+    unibrow::uchar* c) {
+  if (split_char_length_ == 0) {
+    if (!FetchChunk()) return false;
+    byte first = chunk_[chunk_pos_];
+    if (encoding_ == v8::ExternalSourceStream::ONE_BYTE ||
+        first <= unibrow::Utf8::kMaxOneByteChar) {
+      chunk_pos_++;
+      *c = first;
+      return true;
+    }
+    unsigned sequence_length = Utf8SequenceLength(first);
+    if (chunk_length_ - chunk_pos_ >= sequence_length) {
+      unsigned cursor = 0;
+      *c = unibrow::Utf8::CalculateValue(chunk_ + chunk_pos_,
+                                         sequence_length,
+                                         &cursor);
+      chunk_pos_ += cursor;
+      return true;
+    }
+    // The sequence continues in the next chunk. Keep its start, since the
+    // current chunk may be gone once the next one is fetched.
+    while (chunk_pos_ < chunk_length_) {
+      split_char_[split_char_length_++] = chunk_[chunk_pos_++];
+    }
+  }
+
+  ASSERT(encoding_ == v8::ExternalSourceStream::UTF8);
+  if (split_char_[0] <= unibrow::Utf8::kMaxOneByteChar) {
+    *c = split_char_[0];
+    split_char_length_--;
+    memmove(split_char_, split_char_ + 1, split_char_length_);
+    return true;
+  }
+  unsigned sequence_length = Utf8SequenceLength(split_char_[0]);
+  while (split_char_length_ < sequence_length && FetchChunk()) {
+    split_char_[split_char_length_++] = chunk_[chunk_pos_++];
+  }
+  unsigned cursor = 0;
+  *c = unibrow::Utf8::CalculateValue(split_char_, split_char_length_, &cursor);
+  // An invalid sequence may leave some of the buffered bytes unconsumed.
+  split_char_length_ -= cursor;
+  memmove(split_char_, split_char_ + cursor, split_char_length_);
+  return true;
+}
+
+
 // ----------------------------------------------------------------------------
 // ExternalTwoByteStringUtf16CharacterStream
 
@@ -97,6 +97,43 @@ class Utf8ToUtf16CharacterStream: public BufferedUtf16CharacterStream {
 };
 
 
+// Utf16 stream that decodes UTF-8 or Latin-1 source supplied chunk by chunk
+// by an embedder. Chunks are only read forward, so seeking is done by
+// reading through the source.
+class ExternalStreamingUtf16CharacterStream
+    : public BufferedUtf16CharacterStream {
+ public:
+  ExternalStreamingUtf16CharacterStream(
+      v8::ExternalSourceStream* source,
+      v8::ExternalSourceStream::Encoding encoding);
+  virtual ~ExternalStreamingUtf16CharacterStream();
+
+ protected:
+  virtual unsigned SlowSeekForward(unsigned delta);
+  virtual unsigned BufferSeekForward(unsigned delta);
+  virtual unsigned FillBuffer(unsigned position, unsigned length);
+
+ private:
+  // Makes sure the current chunk has unread bytes, fetching new chunks as
+  // needed. Returns false at the end of the source.
+  bool FetchChunk();
+  // Decodes the next character. Returns false at the end of the source.
+  bool NextCharacter(unibrow::uchar* c);
+
+  v8::ExternalSourceStream* source_;
+  v8::ExternalSourceStream::Encoding encoding_;
+  const uint8_t* chunk_;
+  size_t chunk_length_;
+  size_t chunk_pos_;
+  bool done_;
+  // The UTF-16 position of the next character to be decoded.
+  unsigned current_position_;
+  // Start of a UTF-8 sequence that is split over several chunks.
+  byte split_char_[unibrow::Utf8::kMaxEncodedSize];
+  unsigned split_char_length_;
+};
+
+
 // UTF16 buffer to read characters from an external string.
 class ExternalTwoByteStringUtf16CharacterStream: public Utf16CharacterStream {
  public:
@@ -308,6 +308,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
   while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
+    source_->SkipCommentCodeUnits(false);
     Advance();
   }
 
@@ -321,6 +322,13 @@ Token::Value Scanner::SkipMultiLineComment() {
 
   while (c0_ >= 0) {
     uc32 ch = c0_;
+    if (ch != '*' && !unicode_cache_->IsLineTerminator(ch)) {
+      // Neither the end of the comment nor a line terminator follows
+      // before the next code unit that SkipCommentCodeUnits stops at.
+      source_->SkipCommentCodeUnits(true);
+      Advance();
+      continue;
+    }
     Advance();
     if (unicode_cache_->IsLineTerminator(ch)) {
       // Following ECMA-262, section 7.4, a comment containing
@@ -841,110 +849,126 @@ uc32 Scanner::ScanIdentifierUnicodeEscape() {
 // ----------------------------------------------------------------------------
 // Keyword Matcher
 
-#define KEYWORDS(KEYWORD_GROUP, KEYWORD)                            \
-  KEYWORD_GROUP('b')                                                \
+#define KEYWORDS(KEYWORD)                                           \
   KEYWORD("break", Token::BREAK)                                    \
-  KEYWORD_GROUP('c')                                                \
   KEYWORD("case", Token::CASE)                                      \
   KEYWORD("catch", Token::CATCH)                                    \
   KEYWORD("class", Token::FUTURE_RESERVED_WORD)                     \
   KEYWORD("const", Token::CONST)                                    \
   KEYWORD("continue", Token::CONTINUE)                              \
-  KEYWORD_GROUP('d')                                                \
   KEYWORD("debugger", Token::DEBUGGER)                              \
   KEYWORD("default", Token::DEFAULT)                                \
   KEYWORD("delete", Token::DELETE)                                  \
   KEYWORD("do", Token::DO)                                          \
-  KEYWORD_GROUP('e')                                                \
   KEYWORD("else", Token::ELSE)                                      \
   KEYWORD("enum", Token::FUTURE_RESERVED_WORD)                      \
-  KEYWORD("export", harmony_modules                                 \
-                    ? Token::EXPORT : Token::FUTURE_RESERVED_WORD)  \
+  KEYWORD("export", Token::EXPORT)                                  \
   KEYWORD("extends", Token::FUTURE_RESERVED_WORD)                   \
-  KEYWORD_GROUP('f')                                                \
   KEYWORD("false", Token::FALSE_LITERAL)                            \
   KEYWORD("finally", Token::FINALLY)                                \
   KEYWORD("for", Token::FOR)                                        \
   KEYWORD("function", Token::FUNCTION)                              \
-  KEYWORD_GROUP('i')                                                \
   KEYWORD("if", Token::IF)                                          \
   KEYWORD("implements", Token::FUTURE_STRICT_RESERVED_WORD)         \
-  KEYWORD("import", harmony_modules                                 \
-                    ? Token::IMPORT : Token::FUTURE_RESERVED_WORD)  \
+  KEYWORD("import", Token::IMPORT)                                  \
   KEYWORD("in", Token::IN)                                          \
   KEYWORD("instanceof", Token::INSTANCEOF)                          \
   KEYWORD("interface", Token::FUTURE_STRICT_RESERVED_WORD)          \
-  KEYWORD_GROUP('l')                                                \
-  KEYWORD("let", harmony_scoping                                    \
-                 ? Token::LET : Token::FUTURE_STRICT_RESERVED_WORD) \
-  KEYWORD_GROUP('n')                                                \
+  KEYWORD("let", Token::LET)                                        \
   KEYWORD("new", Token::NEW)                                        \
   KEYWORD("null", Token::NULL_LITERAL)                              \
-  KEYWORD_GROUP('p')                                                \
   KEYWORD("package", Token::FUTURE_STRICT_RESERVED_WORD)            \
   KEYWORD("private", Token::FUTURE_STRICT_RESERVED_WORD)            \
   KEYWORD("protected", Token::FUTURE_STRICT_RESERVED_WORD)          \
   KEYWORD("public", Token::FUTURE_STRICT_RESERVED_WORD)             \
-  KEYWORD_GROUP('r')                                                \
   KEYWORD("return", Token::RETURN)                                  \
-  KEYWORD_GROUP('s')                                                \
   KEYWORD("static", Token::FUTURE_STRICT_RESERVED_WORD)             \
   KEYWORD("super", Token::FUTURE_RESERVED_WORD)                     \
   KEYWORD("switch", Token::SWITCH)                                  \
-  KEYWORD_GROUP('t')                                                \
   KEYWORD("this", Token::THIS)                                      \
   KEYWORD("throw", Token::THROW)                                    \
   KEYWORD("true", Token::TRUE_LITERAL)                              \
   KEYWORD("try", Token::TRY)                                        \
   KEYWORD("typeof", Token::TYPEOF)                                  \
-  KEYWORD_GROUP('v')                                                \
   KEYWORD("var", Token::VAR)                                        \
   KEYWORD("void", Token::VOID)                                      \
-  KEYWORD_GROUP('w')                                                \
   KEYWORD("while", Token::WHILE)                                    \
   KEYWORD("with", Token::WITH)                                      \
-  KEYWORD_GROUP('y')                                                \
   KEYWORD("yield", Token::YIELD)
 
 
-static Token::Value KeywordOrIdentifierToken(const char* input,
-                                             int input_length,
-                                             bool harmony_scoping,
-                                             bool harmony_modules) {
+struct KeywordEntry {
+  const char* name;
+  int length;
+  Token::Value token;
+};
+
+
+static const KeywordEntry kKeywords[] = {
+#define KEYWORD_ENTRY(keyword, token)                         \
+  /* 'keyword' is a char array, so sizeof(keyword) is */      \
+  /* strlen(keyword) plus 1 for the NUL char. */              \
+  { keyword, sizeof(keyword) - 1, token },
+  KEYWORDS(KEYWORD_ENTRY)
+#undef KEYWORD_ENTRY
+};
+
+static const int kKeywordCount = ARRAY_SIZE(kKeywords);
+static const uint8_t kNoKeyword = 0xFF;
+static const int kMinKeywordLength = 2;
+static const int kMaxKeywordLength = 10;
+STATIC_ASSERT(kKeywordCount < kNoKeyword);
+
+
+// Maps every keyword to a different slot of the keyword table, which the
+// UnicodeCache constructor checks. If a new keyword collides, the factors
+// have to be picked anew.
+static inline int KeywordHash(const char* input, int input_length) {
+  int first = static_cast<unsigned char>(input[0]);
+  int second = static_cast<unsigned char>(input[1]);
+  int last = static_cast<unsigned char>(input[input_length - 1]);
+  return (first + 5 * second + 8 * last + input_length) &
+      (UnicodeCache::kKeywordTableSize - 1);
+}
+
+
+UnicodeCache::UnicodeCache() {
+  memset(keyword_slots_, kNoKeyword, sizeof(keyword_slots_));
+  for (int i = 0; i < kKeywordCount; i++) {
+    ASSERT(kKeywords[i].length >= kMinKeywordLength);
+    ASSERT(kKeywords[i].length <= kMaxKeywordLength);
+    int slot = KeywordHash(kKeywords[i].name, kKeywords[i].length);
+    CHECK_EQ(kNoKeyword, keyword_slots_[slot]);
+    keyword_slots_[slot] = static_cast<uint8_t>(i);
+  }
+}
+
+
+Token::Value UnicodeCache::KeywordOrIdentifierToken(const char* input,
+                                                    int input_length,
+                                                    bool harmony_scoping,
+                                                    bool harmony_modules) {
   ASSERT(input_length >= 1);
-  const int kMinLength = 2;
-  const int kMaxLength = 10;
-  if (input_length < kMinLength || input_length > kMaxLength) {
+  if (input_length < kMinKeywordLength || input_length > kMaxKeywordLength) {
+    return Token::IDENTIFIER;
+  }
+  uint8_t index = keyword_slots_[KeywordHash(input, input_length)];
+  if (index == kNoKeyword) return Token::IDENTIFIER;
+  const KeywordEntry& keyword = kKeywords[index];
+  if (keyword.length != input_length ||
+      memcmp(keyword.name, input, input_length) != 0) {
     return Token::IDENTIFIER;
   }
-  switch (input[0]) {
+  switch (keyword.token) {
+    case Token::EXPORT:
+    case Token::IMPORT:
+      return harmony_modules ? keyword.token : Token::FUTURE_RESERVED_WORD;
+    case Token::LET:
+      return harmony_scoping ? keyword.token
+                             : Token::FUTURE_STRICT_RESERVED_WORD;
     default:
-#define KEYWORD_GROUP_CASE(ch)                                \
-      break;                                                  \
-    case ch:
-#define KEYWORD(keyword, token)                               \
-    {                                                         \
-      /* 'keyword' is a char array, so sizeof(keyword) is */  \
-      /* strlen(keyword) plus 1 for the NUL char. */          \
-      const int keyword_length = sizeof(keyword) - 1;         \
-      STATIC_ASSERT(keyword_length >= kMinLength);            \
-      STATIC_ASSERT(keyword_length <= kMaxLength);            \
-      if (input_length == keyword_length &&                   \
-          input[1] == keyword[1] &&                           \
-          (keyword_length <= 2 || input[2] == keyword[2]) &&  \
-          (keyword_length <= 3 || input[3] == keyword[3]) &&  \
-          (keyword_length <= 4 || input[4] == keyword[4]) &&  \
-          (keyword_length <= 5 || input[5] == keyword[5]) &&  \
-          (keyword_length <= 6 || input[6] == keyword[6]) &&  \
-          (keyword_length <= 7 || input[7] == keyword[7]) &&  \
-          (keyword_length <= 8 || input[8] == keyword[8]) &&  \
-          (keyword_length <= 9 || input[9] == keyword[9])) {  \
-        return token;                                         \
-      }                                                       \
-    }
-    KEYWORDS(KEYWORD_GROUP_CASE, KEYWORD)
+      return keyword.token;
   }
-  return Token::IDENTIFIER;
 }
 
 
@@ -968,6 +992,14 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
   Advance();
   AddLiteralChar(first_char);
 
+  // Fast path for ASCII identifier characters, which are by far the most
+  // common ones and need no lookup in the unicode cache.
+  while (IsAsciiIdentifierPart(c0_)) {
+    uc32 next_char = c0_;
+    Advance();
+    AddLiteralChar(next_char);
+  }
+
   // Scan the rest of the identifier characters.
   while (unicode_cache_->IsIdentifierPart(c0_)) {
     if (c0_ != '\\') {
@@ -984,10 +1016,10 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
 
   if (next_.literal_chars->is_ascii()) {
     Vector<const char> chars = next_.literal_chars->ascii_literal();
-    return KeywordOrIdentifierToken(chars.start(),
-                                    chars.length(),
-                                    harmony_scoping_,
-                                    harmony_modules_);
+    return unicode_cache_->KeywordOrIdentifierToken(chars.start(),
+                                                    chars.length(),
+                                                    harmony_scoping_,
+                                                    harmony_modules_);
   }
 
   return Token::IDENTIFIER;
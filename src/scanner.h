@@ -107,6 +107,38 @@ class Utf16CharacterStream {
   // Must not be used right after calling SeekForward.
   virtual void PushBack(int32_t code_unit) = 0;
 
+  // Skips the buffered code units that certainly do not end a comment,
+  // i.e. that are neither a line terminator nor, if |stop_at_star|, a '*'.
+  // Stops early on any code unit that might, so the caller still has to
+  // check each code unit it reads next with Advance. Never reads a new
+  // block of input.
+  inline void SkipCommentCodeUnits(bool stop_at_star) {
+    const uc16* cursor = buffer_cursor_;
+    // Test four code units at a time: a code unit might end a comment if
+    // it is below 0x0E (which includes LF and CR), at least 0x2028 (which
+    // includes LS and PS), or, optionally, a '*'.
+    static const uint64_t kOnes = V8_2PART_UINT64_C(0x00010001, 00010001);
+    static const uint64_t kHighBits = kOnes * 0x8000;
+    const uint64_t star_mask = stop_at_star ? kHighBits : 0;
+    while (buffer_end_ - cursor >= 4) {
+      uint64_t units;
+      memcpy(&units, cursor, sizeof(units));
+      uint64_t below_0e = (units - kOnes * 0x0E) & ~units;
+      uint64_t from_2028 = (units + kOnes * (0x7FFF - 0x2027)) | units;
+      uint64_t stars = units ^ (kOnes * '*');
+      stars = (stars - kOnes) & ~stars & star_mask;
+      if (((below_0e | from_2028) & kHighBits) != 0 || stars != 0) break;
+      cursor += 4;
+    }
+    while (cursor < buffer_end_) {
+      uc16 c = *cursor;
+      if (c < 0x0E || c >= 0x2028 || (stop_at_star && c == '*')) break;
+      cursor++;
+    }
+    pos_ += static_cast<unsigned>(cursor - buffer_cursor_);
+    buffer_cursor_ = cursor;
+  }
+
  protected:
   static const uc32 kEndOfInput = -1;
 
@@ -128,7 +160,7 @@ class Utf16CharacterStream {
 
 class UnicodeCache {
  public:
-  UnicodeCache() {}
+  UnicodeCache();
   typedef unibrow::Utf8Decoder<512> Utf8Decoder;
 
   StaticResource<Utf8Decoder>* utf8_decoder() {
@@ -143,6 +175,16 @@ class UnicodeCache {
     return kIsWhiteSpaceOrLineTerminator.get(c);
   }
 
+  // Returns the keyword token for an ASCII identifier, or Token::IDENTIFIER
+  // if it is no keyword. Contextual keywords depend on the harmony flags.
+  Token::Value KeywordOrIdentifierToken(const char* input,
+                                        int input_length,
+                                        bool harmony_scoping,
+                                        bool harmony_modules);
+
+  // Size of the perfect hash table of keywords, see scanner.cc.
+  static const int kKeywordTableSize = 256;
+
  private:
   unibrow::Predicate<IdentifierStart, 128> kIsIdentifierStart;
   unibrow::Predicate<IdentifierPart, 128> kIsIdentifierPart;
@@ -151,6 +193,8 @@ class UnicodeCache {
   unibrow::Predicate<WhiteSpaceOrLineTerminator, 128>
       kIsWhiteSpaceOrLineTerminator;
   StaticResource<Utf8Decoder> utf8_decoder_;
+  // Index into the keyword list for every slot of the keyword hash table.
+  uint8_t keyword_slots_[kKeywordTableSize];
 
   DISALLOW_COPY_AND_ASSIGN(UnicodeCache);
 };
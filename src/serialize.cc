@@ -35,12 +35,14 @@
 #include "global-handles.h"
 #include "ic-inl.h"
 #include "natives.h"
+#include "parser.h"
 #include "platform.h"
 #include "runtime.h"
 #include "serialize.h"
 #include "snapshot.h"
 #include "stub-cache.h"
 #include "v8threads.h"
+#include "version.h"
 
 namespace v8 {
 namespace internal {
@@ -537,6 +539,12 @@ void ExternalReferenceTable::PopulateTable(Isolate* isolate) {
       UNCLASSIFIED,
       62,
       "Code::MarkCodeAsExecuted");
+#ifndef V8_INTERPRETED_REGEXP
+  Add(ExternalReference::address_of_regexp_backtrack_count(isolate).address(),
+      UNCLASSIFIED,
+      63,
+      "RegExpStack::backtrack_count_address()");
+#endif  // V8_INTERPRETED_REGEXP
 
   // Add a small set of deopt entry addresses to encoder without generating the
   // deopt table code, which isn't possible at deserialization time.
@@ -609,6 +617,18 @@ ExternalReferenceDecoder::ExternalReferenceDecoder(Isolate* isolate)
 }
 
 
+ExternalReferenceDecoder* ExternalReferenceDecoder::instance(
+    Isolate* isolate) {
+  ExternalReferenceDecoder* external_reference_decoder =
+      isolate->external_reference_decoder();
+  if (external_reference_decoder == NULL) {
+    external_reference_decoder = new ExternalReferenceDecoder(isolate);
+    isolate->set_external_reference_decoder(external_reference_decoder);
+  }
+  return external_reference_decoder;
+}
+
+
 ExternalReferenceDecoder::~ExternalReferenceDecoder() {
   for (int type = kFirstTypeCode; type < kTypeCodeCount; ++type) {
     DeleteArray(encodings_[type]);
@@ -783,7 +803,7 @@ void Deserializer::Deserialize(Isolate* isolate) {
   // No active handles.
   ASSERT(isolate_->handle_scope_implementer()->blocks()->is_empty());
   ASSERT_EQ(NULL, external_reference_decoder_);
-  external_reference_decoder_ = new ExternalReferenceDecoder(isolate);
+  external_reference_decoder_ = ExternalReferenceDecoder::instance(isolate);
   isolate_->heap()->IterateSmiRoots(this);
   isolate_->heap()->IterateStrongRoots(this, VISIT_ONLY_STRONG);
   isolate_->heap()->RepairFreeListsAfterBoot();
@@ -826,7 +846,7 @@ void Deserializer::DeserializePartial(Isolate* isolate, Object** root) {
   }
   isolate_->heap()->ReserveSpace(reservations_, &high_water_[0]);
   if (external_reference_decoder_ == NULL) {
-    external_reference_decoder_ = new ExternalReferenceDecoder(isolate);
+    external_reference_decoder_ = ExternalReferenceDecoder::instance(isolate);
   }
 
   // Keep track of the code space start and end pointers in case new
@@ -842,12 +862,32 @@ void Deserializer::DeserializePartial(Isolate* isolate, Object** root) {
 }
 
 
+void Deserializer::DeserializeCode(Isolate* isolate,
+                                   Object** root,
+                                   Vector<Handle<Object> > attached_objects) {
+  isolate_ = isolate;
+  ASSERT(!attached_objects.is_empty());
+  attached_objects_ = attached_objects;
+  for (int i = NEW_SPACE; i < kNumberOfSpaces; i++) {
+    ASSERT(reservations_[i] != kUninitializedReservation);
+  }
+  isolate_->heap()->ReserveSpace(reservations_, &high_water_[0]);
+  if (external_reference_decoder_ == NULL) {
+    external_reference_decoder_ = ExternalReferenceDecoder::instance(isolate);
+  }
+
+  { DisallowHeapAllocation no_gc;
+    VisitPointer(root);
+  }
+
+  FlushICacheForNewCodeObjects();
+}
+
+
 Deserializer::~Deserializer() {
   ASSERT(source_->AtEOF());
-  if (external_reference_decoder_) {
-    delete external_reference_decoder_;
-    external_reference_decoder_ = NULL;
-  }
+  // The external reference decoder is owned by the isolate.
+  external_reference_decoder_ = NULL;
 }
 
 
@@ -888,6 +928,14 @@ void Deserializer::ReadObject(int space_number,
   }
   ReadChunk(current, limit, space_number, address);
 
+  // Hashes depend on the hash seed of the isolate that produced the code
+  // cache, so they have to be recomputed on demand.  Internalized strings
+  // never show up here, they are attached references.
+  if (deserializing_user_code() && obj->IsString()) {
+    ASSERT(!obj->IsInternalizedString());
+    String::cast(obj)->set_hash_field(String::kEmptyHashField);
+  }
+
   // TODO(mvstanton): consider treating the heap()->allocation_sites_list()
   // as a (weak) root. If this root is relocated correctly,
   // RelinkAllocationSite() isn't necessary.
@@ -955,6 +1003,16 @@ void Deserializer::ReadChunk(Object** current,
             Address address = external_reference_decoder_->                    \
                 Decode(reference_id);                                          \
             new_object = reinterpret_cast<Object*>(address);                   \
+          } else if (where == kBuiltin) {                                      \
+            int builtin_id = source_->GetInt();                                \
+            ASSERT_LE(0, builtin_id);                                          \
+            ASSERT_LT(builtin_id, Builtins::builtin_count);                    \
+            Builtins::Name name = static_cast<Builtins::Name>(builtin_id);     \
+            new_object = isolate->builtins()->builtin(name);                   \
+          } else if (where == kAttachedReference) {                            \
+            int index = source_->GetInt();                                     \
+            new_object = *attached_objects_[index];                            \
+            emit_write_barrier = isolate->heap()->InNewSpace(new_object);      \
           } else if (where == kBackref) {                                      \
             emit_write_barrier = (space_number == NEW_SPACE);                  \
             new_object = GetAddressFromEnd(data & kSpaceMask);                 \
@@ -1196,6 +1254,23 @@ void Deserializer::ReadChunk(Object** current,
                 kFromCode,
                 kStartOfObject,
                 0)
+      // Find a builtin and write a pointer to it to the current object.
+      CASE_STATEMENT(kBuiltin, kPlain, kStartOfObject, 0)
+      CASE_BODY(kBuiltin, kPlain, kStartOfObject, 0)
+      CASE_STATEMENT(kBuiltin, kPlain, kInnerPointer, 0)
+      CASE_BODY(kBuiltin, kPlain, kInnerPointer, 0)
+      // Find a builtin and write a pointer to its first instruction to the
+      // current code object.
+      CASE_STATEMENT(kBuiltin, kFromCode, kInnerPointer, 0)
+      CASE_BODY(kBuiltin, kFromCode, kInnerPointer, 0)
+      // Find an object attached to the serialized user code and write a
+      // pointer to it to the current object.
+      CASE_STATEMENT(kAttachedReference, kPlain, kStartOfObject, 0)
+      CASE_BODY(kAttachedReference, kPlain, kStartOfObject, 0)
+#if V8_TARGET_ARCH_MIPS
+      CASE_STATEMENT(kAttachedReference, kFromCode, kStartOfObject, 0)
+      CASE_BODY(kAttachedReference, kFromCode, kStartOfObject, 0)
+#endif
 
 #undef CASE_STATEMENT
 #undef CASE_BODY
@@ -1567,10 +1642,12 @@ void Serializer::ObjectSerializer::Serialize() {
              "ObjectSerialization");
   sink_->PutInt(size >> kObjectAlignmentBits, "Size in words");
 
-  ASSERT(code_address_map_);
-  const char* code_name = code_address_map_->Lookup(object_->address());
-  LOG(serializer_->isolate_,
-      CodeNameEvent(object_->address(), sink_->Position(), code_name));
+  // The code address map only exists while the startup snapshot is built.
+  if (code_address_map_ != NULL) {
+    const char* code_name = code_address_map_->Lookup(object_->address());
+    LOG(serializer_->isolate_,
+        CodeNameEvent(object_->address(), sink_->Position(), code_name));
+  }
   LOG(serializer_->isolate_,
       SnapshotPositionEvent(object_->address(), sink_->Position()));
 
@@ -1788,9 +1865,7 @@ int Serializer::ObjectSerializer::OutputRawData(
     }
 
     const char* description = code_object_ ? "Code" : "Byte";
-    for (int i = 0; i < bytes_to_output; i++) {
-      sink_->PutSection(object_start[base + i], description);
-    }
+    sink_->PutRaw(object_start + base, bytes_to_output, description);
     if (code_object_) delete[] object_start;
   }
   if (to_skip != 0 && return_skip == kIgnoringReturn) {
@@ -1849,4 +1924,281 @@ bool SnapshotByteSource::AtEOF() {
   return true;
 }
 
+
+CodeSerializer::CodeSerializer(Isolate* isolate,
+                               SnapshotByteSink* sink,
+                               Script* script)
+    : Serializer(isolate, sink),
+      script_(script),
+      failed_(false) {
+  set_root_index_wave_front(Heap::kStrongRootListLength);
+}
+
+
+ScriptDataImpl* CodeSerializer::Serialize(Handle<SharedFunctionInfo> info) {
+  Isolate* isolate = info->GetIsolate();
+  Script* script = Script::cast(info->script());
+  String* source = String::cast(script->source());
+
+  List<byte> payload;
+  ListSnapshotSink payload_sink(&payload);
+  List<byte> strings;
+  ListSnapshotSink strings_sink(&strings);
+  int reservations[kNumberOfSpaces];
+
+  { DisallowHeapAllocation no_gc;
+    CodeSerializer serializer(isolate, &payload_sink, script);
+    Object* root = *info;
+    serializer.VisitPointer(&root);
+    serializer.Pad();
+    if (serializer.failed()) return NULL;
+
+    for (int i = 0; i < kNumberOfSpaces; i++) {
+      reservations[i] = serializer.CurrentAllocationAddress(i);
+      // Each space is reserved in one contiguous chunk on deserialization.
+      if (reservations[i] > Page::kMaxRegularHeapObjectSize) return NULL;
+    }
+
+    // Internalized strings are emitted as their contents and internalized
+    // again when the code cache is consumed.
+    for (int i = 0; i < serializer.strings_.length(); i++) {
+      String* string = serializer.strings_[i];
+      bool is_one_byte = string->IsOneByteRepresentation();
+      int bytes = string->length() * (is_one_byte ? 1 : kUC16Size);
+      strings_sink.PutInt(string->length(), "StringLength");
+      strings_sink.Put(is_one_byte ? 1 : 0, "StringIsOneByte");
+      String::FlatContent content = string->GetFlatContent();
+      const byte* chars = is_one_byte
+          ? reinterpret_cast<const byte*>(content.ToOneByteVector().start())
+          : reinterpret_cast<const byte*>(content.ToUC16Vector().start());
+      for (int j = 0; j < bytes; j++) strings_sink.Put(chars[j], "Char");
+    }
+    strings_sink.PutInt(0, "StringsEnd");
+    for (unsigned i = 0; i < sizeof(int32_t) - 1; i++) {
+      strings_sink.Put(SerializerDeserializer::nop(), "Padding");
+    }
+  }
+
+  // Lay out the header, the strings and the payload in one aligned store.
+  int strings_words = RoundUp(strings.length(), kIntSize) / kIntSize;
+  int payload_words = RoundUp(payload.length(), kIntSize) / kIntSize;
+  int length = kHeaderSize + strings_words + payload_words;
+  unsigned* store = NewArray<unsigned>(length);
+  store[kMagicOffset] = kMagicNumber;
+  store[kVersionHashOffset] = VersionHash();
+  store[kHasErrorOffset] = 0;
+  store[kSourceLengthOffset] = source->length();
+  store[kStringsLengthOffset] = strings.length();
+  store[kPayloadLengthOffset] = payload.length();
+  for (int i = 0; i < kNumberOfSpaces; i++) {
+    store[kReservationsOffset + i] = reservations[i];
+  }
+  byte* strings_start = reinterpret_cast<byte*>(store + kHeaderSize);
+  byte* payload_start =
+      reinterpret_cast<byte*>(store + kHeaderSize + strings_words);
+  memset(strings_start, SerializerDeserializer::nop(),
+         (strings_words + payload_words) * kIntSize);
+  CopyBytes(strings_start, strings.begin(), strings.length());
+  CopyBytes(payload_start, payload.begin(), payload.length());
+
+  return new ScriptDataImpl(Vector<unsigned>(store, length));
+}
+
+
+void CodeSerializer::SerializeObject(Object* o,
+                                     HowToCode how_to_code,
+                                     WhereToPoint where_to_point,
+                                     int skip) {
+  CHECK(o->IsHeapObject());
+  HeapObject* heap_object = HeapObject::cast(o);
+  if (failed_) return;
+
+  int root_index;
+  if ((root_index = RootIndex(heap_object, how_to_code)) != kInvalidRootIndex) {
+    PutRoot(root_index, heap_object, how_to_code, where_to_point, skip);
+    return;
+  }
+
+  if (address_mapper_.IsMapped(heap_object)) {
+    int space = SpaceOfObject(heap_object);
+    int address = address_mapper_.MappedTo(heap_object);
+    SerializeReferenceToPreviousObject(space,
+                                       address,
+                                       how_to_code,
+                                       where_to_point,
+                                       skip);
+    return;
+  }
+
+  // Context-specific objects and large objects cannot be part of a code
+  // cache.  Code that refers to them is simply not cached.
+  if (heap_object->IsMap() ||
+      heap_object->IsJSReceiver() ||
+      heap_object->IsContext() ||
+      heap_object->IsPropertyCell() ||
+      heap_object->IsAllocationSite() ||
+      heap_object->IsExternalString() ||
+      isolate()->heap()->lo_space()->Contains(heap_object)) {
+    failed_ = true;
+    return;
+  }
+
+  if (skip != 0) {
+    sink_->Put(kSkip, "SkipFromSerializeObject");
+    sink_->PutInt(skip, "SkipDistanceFromSerializeObject");
+  }
+
+  if (heap_object->IsCode() &&
+      Code::cast(heap_object)->kind() == Code::BUILTIN) {
+    SerializeBuiltin(Code::cast(heap_object), how_to_code, where_to_point);
+    return;
+  }
+
+  if (heap_object == script_) {
+    SerializeAttachedReference(kScriptIndex, how_to_code, where_to_point);
+    return;
+  }
+
+  if (heap_object->IsInternalizedString()) {
+    int index = AttachedStringIndex(String::cast(heap_object));
+    if (failed_) return;
+    SerializeAttachedReference(index, how_to_code, where_to_point);
+    return;
+  }
+
+  // Object has not yet been serialized.  Serialize it here.
+  ObjectSerializer serializer(this,
+                              heap_object,
+                              sink_,
+                              how_to_code,
+                              where_to_point);
+  serializer.Serialize();
+}
+
+
+void CodeSerializer::SerializeBuiltin(Code* builtin,
+                                      HowToCode how_to_code,
+                                      WhereToPoint where_to_point) {
+  ASSERT((how_to_code == kPlain && where_to_point == kStartOfObject) ||
+         (how_to_code == kPlain && where_to_point == kInnerPointer) ||
+         (how_to_code == kFromCode && where_to_point == kInnerPointer));
+  Builtins* builtins = isolate()->builtins();
+  for (int id = 0; id < Builtins::builtin_count; id++) {
+    if (builtins->builtin(static_cast<Builtins::Name>(id)) == builtin) {
+      sink_->Put(kBuiltin + how_to_code + where_to_point, "Builtin");
+      sink_->PutInt(id, "builtin_index");
+      return;
+    }
+  }
+  // Builtin code objects are always found in the builtins table.
+  UNREACHABLE();
+}
+
+
+void CodeSerializer::SerializeAttachedReference(int index,
+                                                HowToCode how_to_code,
+                                                WhereToPoint where_to_point) {
+#if V8_TARGET_ARCH_MIPS
+  ASSERT(where_to_point == kStartOfObject);
+#else
+  ASSERT(how_to_code == kPlain && where_to_point == kStartOfObject);
+#endif
+  sink_->Put(kAttachedReference + how_to_code + where_to_point,
+             "AttachedReference");
+  sink_->PutInt(index, "attached_index");
+}
+
+
+int CodeSerializer::AttachedStringIndex(String* string) {
+  for (int i = 0; i < strings_.length(); i++) {
+    if (strings_[i] == string) return kScriptIndex + 1 + i;
+  }
+  // The length is emitted with PutInt, which is limited to 22 bits.
+  if (string->length() >= (1 << 21)) {
+    failed_ = true;
+    return 0;
+  }
+  strings_.Add(string);
+  return kScriptIndex + strings_.length();
+}
+
+
+uint32_t CodeSerializer::VersionHash() {
+  uint32_t hash = static_cast<uint32_t>(Version::GetMajor());
+  hash = hash * 31 + static_cast<uint32_t>(Version::GetMinor());
+  hash = hash * 31 + static_cast<uint32_t>(Version::GetBuild());
+  hash = hash * 31 + static_cast<uint32_t>(Version::GetPatch());
+  return hash;
+}
+
+
+bool CodeSerializer::IsCodeCache(ScriptDataImpl* data) {
+  if (data->Length() < kHeaderSize * static_cast<int>(sizeof(unsigned))) {
+    return false;
+  }
+  const unsigned* store = reinterpret_cast<const unsigned*>(data->Data());
+  return store[kMagicOffset] == kMagicNumber;
+}
+
+
+Handle<SharedFunctionInfo> CodeSerializer::Deserialize(Isolate* isolate,
+                                                       ScriptDataImpl* data,
+                                                       Handle<Script> script) {
+  ASSERT(IsCodeCache(data));
+  const unsigned* store = reinterpret_cast<const unsigned*>(data->Data());
+  int store_words = data->Length() / static_cast<int>(sizeof(unsigned));
+  int strings_length = static_cast<int>(store[kStringsLengthOffset]);
+  int payload_length = static_cast<int>(store[kPayloadLengthOffset]);
+  int strings_words = RoundUp(strings_length, kIntSize) / kIntSize;
+  int payload_words = RoundUp(payload_length, kIntSize) / kIntSize;
+  int source_length = String::cast(script->source())->length();
+  if (store[kVersionHashOffset] != VersionHash() ||
+      static_cast<int>(store[kSourceLengthOffset]) != source_length ||
+      strings_length < 0 || payload_length < 0 ||
+      kHeaderSize + strings_words + payload_words != store_words) {
+    return Handle<SharedFunctionInfo>::null();
+  }
+  const byte* strings_start = reinterpret_cast<const byte*>(
+      store + kHeaderSize);
+  const byte* payload_start = reinterpret_cast<const byte*>(
+      store + kHeaderSize + strings_words);
+
+  // Recreate the attached objects before anything is deserialized, since
+  // internalizing strings may cause a GC.
+  List<Handle<Object> > attached_objects;
+  attached_objects.Add(script);
+  Factory* factory = isolate->factory();
+  SnapshotByteSource strings_source(strings_start, strings_length);
+  for (int length = strings_source.GetInt();
+       length != 0;
+       length = strings_source.GetInt()) {
+    bool is_one_byte = strings_source.Get() != 0;
+    Handle<String> string;
+    if (is_one_byte) {
+      Vector<const uint8_t> chars(strings_start + strings_source.position(),
+                                  length);
+      string = factory->InternalizeOneByteString(chars);
+      strings_source.Advance(length);
+    } else {
+      uc16* chars = NewArray<uc16>(length);
+      strings_source.CopyRaw(reinterpret_cast<byte*>(chars),
+                             length * kUC16Size);
+      string = factory->InternalizeTwoByteString(
+          Vector<const uc16>(chars, length));
+      DeleteArray(chars);
+    }
+    attached_objects.Add(string);
+  }
+
+  SnapshotByteSource payload(payload_start, payload_length);
+  Deserializer deserializer(&payload);
+  for (int i = 0; i < kNumberOfSpaces; i++) {
+    deserializer.set_reservation(
+        i, static_cast<int>(store[kReservationsOffset + i]));
+  }
+  Object* root;
+  deserializer.DeserializeCode(isolate, &root, attached_objects.ToVector());
+  return Handle<SharedFunctionInfo>(SharedFunctionInfo::cast(root), isolate);
+}
+
 } }  // namespace v8::internal
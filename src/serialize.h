@@ -134,6 +134,10 @@ class ExternalReferenceEncoder {
 
 class ExternalReferenceDecoder {
  public:
+  // Returns the decoder of |isolate|, which is created on first use and
+  // shared by all deserializers running in that isolate.
+  static ExternalReferenceDecoder* instance(Isolate* isolate);
+
   explicit ExternalReferenceDecoder(Isolate* isolate);
   ~ExternalReferenceDecoder();
 
@@ -222,7 +226,8 @@ class SerializerDeserializer: public ObjectVisitor {
     kExternalReference = 0xb,       // Pointer to an external reference.
     kSkip = 0xc,                    // Skip n bytes.
     kNop = 0xd,                     // Does nothing, used to pad.
-    // 0xe-0xf                         Free.
+    kAttachedReference = 0xe,       // Object is provided by the embedder.
+    kBuiltin = 0xf,                 // Builtin code object.
     kBackref = 0x10,                // Object is described relative to end.
     // 0x11-0x16                       One per space.
     kBackrefWithSkip = 0x18,        // Object is described relative to end.
@@ -330,6 +335,13 @@ class Deserializer: public SerializerDeserializer {
   // Deserialize a single object and the objects reachable from it.
   void DeserializePartial(Isolate* isolate, Object** root);
 
+  // Deserialize an object graph produced by the CodeSerializer.  References
+  // to attached objects are resolved against the given vector, whose
+  // elements must be allocated before the graph is deserialized.
+  void DeserializeCode(Isolate* isolate,
+                       Object** root,
+                       Vector<Handle<Object> > attached_objects);
+
   void set_reservation(int space_number, int reservation) {
     ASSERT(space_number >= 0);
     ASSERT(space_number <= LAST_SPACE);
@@ -379,9 +391,14 @@ class Deserializer: public SerializerDeserializer {
 
   void FlushICacheForNewCodeObjects();
 
+  bool deserializing_user_code() { return !attached_objects_.is_empty(); }
+
   // Cached current isolate.
   Isolate* isolate_;
 
+  // Objects from the attached object descriptions in the serialized user code.
+  Vector<Handle<Object> > attached_objects_;
+
   SnapshotByteSource* source_;
   // This is the address of the next object that will be allocated in each
   // space.  It is used to calculate the addresses of back-references.
@@ -403,11 +420,40 @@ class SnapshotByteSink {
   virtual void PutSection(int byte, const char* description) {
     Put(byte, description);
   }
+  // Appends a run of raw bytes.  Sinks that buffer their output should
+  // override this to copy the run in one go.
+  virtual void PutRaw(const byte* data,
+                      int number_of_bytes,
+                      const char* description) {
+    for (int i = 0; i < number_of_bytes; i++) {
+      PutSection(data[i], description);
+    }
+  }
   void PutInt(uintptr_t integer, const char* description);
   virtual int Position() = 0;
 };
 
 
+// A SnapshotByteSink that appends to a byte list.
+class ListSnapshotSink : public SnapshotByteSink {
+ public:
+  explicit ListSnapshotSink(List<byte>* data) : data_(data) { }
+  virtual ~ListSnapshotSink() { }
+  virtual void Put(int byte, const char* description) {
+    data_->Add(static_cast<uint8_t>(byte));
+  }
+  virtual void PutRaw(const byte* data,
+                      int number_of_bytes,
+                      const char* description) {
+    data_->AddAll(Vector<byte>(const_cast<byte*>(data), number_of_bytes));
+  }
+  virtual int Position() { return data_->length(); }
+
+ private:
+  List<byte>* data_;
+};
+
+
 // Mapping objects to their location after deserialization.
 // This is used during building, but not at runtime by V8.
 class SerializationAddressMapper {
@@ -667,6 +713,74 @@ class StartupSerializer : public Serializer {
 };
 
 
+class ScriptDataImpl;
+
+// Serializes the code of a compiled script, i.e. its toplevel shared function
+// info and everything reachable from it, into a code cache that can be loaded
+// into a different isolate, even in a different process, running the same
+// build of V8.  Roots and builtins are referenced by index.  The script object
+// and all internalized strings are attached references that are recreated
+// when the code cache is consumed.
+class CodeSerializer : public Serializer {
+ public:
+  CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, Script* script);
+
+  static ScriptDataImpl* Serialize(Handle<SharedFunctionInfo> info);
+  static Handle<SharedFunctionInfo> Deserialize(Isolate* isolate,
+                                                ScriptDataImpl* data,
+                                                Handle<Script> script);
+
+  // Returns true if the data was produced by the CodeSerializer rather than
+  // by the preparser.  Does not check whether the data is valid.
+  static bool IsCodeCache(ScriptDataImpl* data);
+
+  virtual void SerializeObject(Object* o,
+                               HowToCode how_to_code,
+                               WhereToPoint where_to_point,
+                               int skip);
+
+  bool failed() const { return failed_; }
+
+  // Layout of the header of a code cache, in units of unsigned.  The has
+  // error slot is at the same position as in preparse data and is always
+  // zero, so that ScriptData::HasError() is meaningful for code caches.
+  static const unsigned kMagicNumber = 0xC0DECAC;
+  static const int kMagicOffset = 0;
+  static const int kVersionHashOffset = 1;
+  static const int kHasErrorOffset = 2;
+  static const int kSourceLengthOffset = 3;
+  static const int kStringsLengthOffset = 4;
+  static const int kPayloadLengthOffset = 5;
+  static const int kReservationsOffset = 6;
+  static const int kHeaderSize = kReservationsOffset + kNumberOfSpaces;
+
+  // The script is always the first attached object.
+  static const int kScriptIndex = 0;
+
+ private:
+  virtual bool ShouldBeInThePartialSnapshotCache(HeapObject* o) {
+    return false;
+  }
+
+  void SerializeBuiltin(Code* builtin,
+                        HowToCode how_to_code,
+                        WhereToPoint where_to_point);
+  void SerializeAttachedReference(int index,
+                                  HowToCode how_to_code,
+                                  WhereToPoint where_to_point);
+  int AttachedStringIndex(String* string);
+
+  static uint32_t VersionHash();
+
+  Script* script_;
+  // Internalized strings, referenced as attached objects kScriptIndex + 1 on.
+  List<String*> strings_;
+  bool failed_;
+
+  DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
+};
+
+
 } }  // namespace v8::internal
 
 #endif  // V8_SERIALIZE_H_
@@ -30,6 +30,8 @@
 #include "v8.h"
 
 #include "api.h"
+#include "lz-codec.h"
+#include "once.h"
 #include "serialize.h"
 #include "snapshot.h"
 #include "platform.h"
@@ -75,6 +77,32 @@ static void ReserveSpaceForSnapshot(Deserializer* deserializer,
 }
 
 
+#ifdef COMPRESS_STARTUP_DATA_LZ
+static const byte* DecompressSnapshotData(const byte* data,
+                                          int size,
+                                          int raw_size) {
+  byte* raw_data = NewArray<byte>(raw_size);
+  CHECK(LZCodec::Decompress(data, size, raw_data, raw_size));
+  return raw_data;
+}
+
+
+V8_DECLARE_ONCE(decompress_snapshot_once);
+V8_DECLARE_ONCE(decompress_context_snapshot_once);
+
+
+void Snapshot::DecompressSnapshot() {
+  set_raw_data(DecompressSnapshotData(data_, size_, raw_size_));
+}
+
+
+void Snapshot::DecompressContextSnapshot() {
+  set_context_raw_data(
+      DecompressSnapshotData(context_data_, context_size_, context_raw_size_));
+}
+#endif
+
+
 void Snapshot::ReserveSpaceForLinkedInSnapshot(Deserializer* deserializer) {
   deserializer->set_reservation(NEW_SPACE, new_space_used_);
   deserializer->set_reservation(OLD_POINTER_SPACE, pointer_space_used_);
@@ -106,6 +134,9 @@ bool Snapshot::Initialize(const char* snapshot_file) {
     if (FLAG_profile_deserialization) {
       timer.Start();
     }
+#ifdef COMPRESS_STARTUP_DATA_LZ
+    CallOnce(&decompress_snapshot_once, &DecompressSnapshot);
+#endif
     SnapshotByteSource source(raw_data_, raw_size_);
     Deserializer deserializer(&source);
     ReserveSpaceForLinkedInSnapshot(&deserializer);
@@ -129,6 +160,13 @@ Handle<Context> Snapshot::NewContextFromSnapshot(Isolate* isolate) {
   if (context_size_ == 0) {
     return Handle<Context>();
   }
+  ElapsedTimer timer;
+  if (FLAG_profile_deserialization) {
+    timer.Start();
+  }
+#ifdef COMPRESS_STARTUP_DATA_LZ
+  CallOnce(&decompress_context_snapshot_once, &DecompressContextSnapshot);
+#endif
   SnapshotByteSource source(context_raw_data_,
                             context_raw_size_);
   Deserializer deserializer(&source);
@@ -143,6 +181,10 @@ Handle<Context> Snapshot::NewContextFromSnapshot(Isolate* isolate) {
                                context_property_cell_space_used_);
   deserializer.DeserializePartial(isolate, &root);
   CHECK(root->IsContext());
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    PrintF("[Context snapshot deserialization took %0.3f ms]\n", ms);
+  }
   return Handle<Context>(Context::cast(root));
 }
 
@@ -92,6 +92,13 @@ class Snapshot {
 
   static void ReserveSpaceForLinkedInSnapshot(Deserializer* deserializer);
 
+#ifdef COMPRESS_STARTUP_DATA_LZ
+  // Decompress the linked in snapshots, which are kept decompressed for
+  // the lifetime of the process.
+  static void DecompressSnapshot();
+  static void DecompressContextSnapshot();
+#endif
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(Snapshot);
 };
 
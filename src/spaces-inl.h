@@ -307,6 +307,19 @@ MaybeObject* PagedSpace::AllocateRaw(int size_in_bytes) {
 }
 
 
+// -----------------------------------------------------------------------------
+// LocalAllocationBuffer
+
+MaybeObject* LocalAllocationBuffer::AllocateRaw(int size_in_bytes) {
+  Address top = allocation_info_.top();
+  if (allocation_info_.limit() - top < size_in_bytes) {
+    return Failure::RetryAfterGC(identity_);
+  }
+  allocation_info_.set_top(top + size_in_bytes);
+  return HeapObject::FromAddress(top);
+}
+
+
 // -----------------------------------------------------------------------------
 // NewSpace
 
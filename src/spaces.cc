@@ -148,9 +148,10 @@ bool CodeRange::SetUp(const size_t requested) {
   ASSERT(code_range_->size() == requested);
   LOG(isolate_, NewEvent("CodeRange", code_range_->address(), requested));
   Address base = reinterpret_cast<Address>(code_range_->address());
-  Address aligned_base =
-      RoundUp(reinterpret_cast<Address>(code_range_->address()),
-              MemoryChunk::kAlignment);
+  size_t alignment = FLAG_code_range_huge_pages
+      ? Max(kHugePageSize, static_cast<size_t>(MemoryChunk::kAlignment))
+      : MemoryChunk::kAlignment;
+  Address aligned_base = RoundUp(base, alignment);
   size_t size = code_range_->size() - (aligned_base - base);
   allocation_list_.Add(FreeBlock(aligned_base, size));
   current_allocation_block_index_ = 0;
@@ -229,10 +230,13 @@ Address CodeRange::AllocateRawMemory(const size_t requested_size,
   }
   ASSERT(*allocated <= current.size);
   ASSERT(IsAddressAligned(current.start, MemoryChunk::kAlignment));
-  if (!isolate_->memory_allocator()->CommitExecutableMemory(code_range_,
+  bool committed = FLAG_code_range_huge_pages
+      ? CommitHugePageMemory(current.start, *allocated)
+      : isolate_->memory_allocator()->CommitExecutableMemory(code_range_,
                                                             current.start,
                                                             commit_size,
-                                                            *allocated)) {
+                                                            *allocated);
+  if (!committed) {
     *allocated = 0;
     return NULL;
   }
@@ -246,10 +250,22 @@ Address CodeRange::AllocateRawMemory(const size_t requested_size,
 
 
 bool CodeRange::CommitRawMemory(Address start, size_t length) {
+  if (FLAG_code_range_huge_pages) return CommitHugePageMemory(start, length);
   return isolate_->memory_allocator()->CommitMemory(start, length, EXECUTABLE);
 }
 
 
+bool CodeRange::CommitHugePageMemory(Address start, size_t length) {
+  if (!isolate_->memory_allocator()->CommitMemory(start, length, EXECUTABLE)) {
+    return false;
+  }
+  // Committing replaces the mapping, so the advice is given every time. It
+  // is only a hint; regular pages work as well.
+  VirtualMemory::AdviseHugePages(start, length);
+  return true;
+}
+
+
 bool CodeRange::UncommitRawMemory(Address start, size_t length) {
   return code_range_->Uncommit(start, length);
 }
@@ -281,7 +297,8 @@ MemoryAllocator::MemoryAllocator(Isolate* isolate)
       size_(0),
       size_executable_(0),
       lowest_ever_allocated_(reinterpret_cast<void*>(-1)),
-      highest_ever_allocated_(reinterpret_cast<void*>(0)) {
+      highest_ever_allocated_(reinterpret_cast<void*>(0)),
+      pooled_size_(0) {
 }
 
 
@@ -298,6 +315,7 @@ bool MemoryAllocator::SetUp(intptr_t capacity, intptr_t capacity_executable) {
 
 
 void MemoryAllocator::TearDown() {
+  ReleasePooledChunks();
   // Check that spaces were torn down before MemoryAllocator.
   ASSERT(size_ == 0);
   // TODO(gc) this will be true again when we fix FreeMemory.
@@ -480,6 +498,7 @@ MemoryChunk* MemoryChunk::Initialize(Heap* heap,
   chunk->InitializeReservedMemory();
   chunk->slots_buffer_ = NULL;
   chunk->skip_list_ = NULL;
+  chunk->card_table_ = NULL;
   chunk->write_barrier_counter_ = kWriteBarrierCounterGranularity;
   chunk->progress_bar_ = 0;
   chunk->high_water_mark_ = static_cast<int>(area_start - base);
@@ -676,11 +695,17 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
                          OS::CommitPageSize());
     size_t commit_size = RoundUp(MemoryChunk::kObjectStartOffset +
                                  commit_area_size, OS::CommitPageSize());
-    base = AllocateAlignedMemory(chunk_size,
-                                 commit_size,
-                                 MemoryChunk::kAlignment,
-                                 executable,
-                                 &reservation);
+    if (commit_size == chunk_size &&
+        owner != NULL && owner->identity() == LO_SPACE) {
+      base = TakePooledChunk(&chunk_size, &reservation);
+    }
+    if (base == NULL) {
+      base = AllocateAlignedMemory(chunk_size,
+                                   commit_size,
+                                   MemoryChunk::kAlignment,
+                                   executable,
+                                   &reservation);
+    }
 
     if (base == NULL) return NULL;
 
@@ -756,11 +781,14 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
     PerformAllocationCallback(space, kAllocationActionFree, chunk->size());
   }
 
-  isolate_->heap()->RememberUnmappedPage(
-      reinterpret_cast<Address>(chunk), chunk->IsEvacuationCandidate());
-
   delete chunk->slots_buffer();
   delete chunk->skip_list();
+  delete chunk->card_table();
+
+  if (PoolChunk(chunk)) return;
+
+  isolate_->heap()->RememberUnmappedPage(
+      reinterpret_cast<Address>(chunk), chunk->IsEvacuationCandidate());
 
   VirtualMemory* reservation = chunk->reserved_memory();
   if (reservation->IsReserved()) {
@@ -773,6 +801,61 @@ void MemoryAllocator::Free(MemoryChunk* chunk) {
 }
 
 
+bool MemoryAllocator::PoolChunk(MemoryChunk* chunk) {
+  VirtualMemory* reservation = chunk->reserved_memory();
+  if (chunk->owner() == NULL ||
+      chunk->owner()->identity() != LO_SPACE ||
+      chunk->executable() == EXECUTABLE ||
+      !reservation->IsReserved()) {
+    return false;
+  }
+  size_t size = reservation->size();
+  size_t limit = static_cast<size_t>(FLAG_large_object_chunk_pool_size) * MB;
+  if (pooled_size_ + size > limit) return false;
+
+  ASSERT(size_ >= size);
+  size_ -= size;
+  isolate_->counters()->memory_allocated()->Decrement(static_cast<int>(size));
+  pooled_size_ += size;
+  pooled_chunks_.Add(chunk);
+  return true;
+}
+
+
+Address MemoryAllocator::TakePooledChunk(size_t* chunk_size,
+                                         VirtualMemory* reservation) {
+  // Do not waste more than half of a reused chunk.
+  int best = -1;
+  for (int i = 0; i < pooled_chunks_.length(); i++) {
+    size_t size = pooled_chunks_[i]->size();
+    if (size < *chunk_size || size > 2 * *chunk_size) continue;
+    if (best == -1 || size < pooled_chunks_[best]->size()) best = i;
+  }
+  if (best == -1) return NULL;
+
+  MemoryChunk* chunk = pooled_chunks_[best];
+  pooled_chunks_[best] = pooled_chunks_.last();
+  pooled_chunks_.RemoveLast();
+  *chunk_size = chunk->size();
+  reservation->TakeControl(chunk->reserved_memory());
+  pooled_size_ -= reservation->size();
+  size_ += reservation->size();
+  return chunk->address();
+}
+
+
+void MemoryAllocator::ReleasePooledChunks() {
+  for (int i = 0; i < pooled_chunks_.length(); i++) {
+    MemoryChunk* chunk = pooled_chunks_[i];
+    isolate_->heap()->RememberUnmappedPage(
+        reinterpret_cast<Address>(chunk), false);
+    chunk->reserved_memory()->Release();
+  }
+  pooled_chunks_.Clear();
+  pooled_size_ = 0;
+}
+
+
 bool MemoryAllocator::CommitBlock(Address start,
                                   size_t size,
                                   Executability executable) {
@@ -931,6 +1014,56 @@ void MemoryChunk::IncrementLiveBytesFromMutator(Address address, int by) {
 }
 
 
+// -----------------------------------------------------------------------------
+// LocalAllocationBuffer implementation
+
+LocalAllocationBuffer::LocalAllocationBuffer(Heap* heap,
+                                             AllocationSpace identity,
+                                             Address start,
+                                             int size)
+    : heap_(heap), identity_(identity) {
+  allocation_info_.set_top(start);
+  allocation_info_.set_limit(start + size);
+}
+
+
+LocalAllocationBuffer LocalAllocationBuffer::FromPagedSpace(PagedSpace* space,
+                                                            int size) {
+  ASSERT(space->identity() != CODE_SPACE);
+  ASSERT(IsAligned(size, kPointerSize));
+  Object* result;
+  MaybeObject* maybe = space->AllocateRawSynchronized(size);
+  if (!maybe->ToObject(&result)) return LocalAllocationBuffer();
+  return LocalAllocationBuffer(space->heap(),
+                               space->identity(),
+                               HeapObject::cast(result)->address(),
+                               size);
+}
+
+
+LocalAllocationBuffer LocalAllocationBuffer::FromNewSpace(NewSpace* space,
+                                                          int size) {
+  ASSERT(IsAligned(size, kPointerSize));
+  Object* result;
+  MaybeObject* maybe = space->AllocateRawSynchronized(size);
+  if (!maybe->ToObject(&result)) return LocalAllocationBuffer();
+  return LocalAllocationBuffer(space->heap(),
+                               NEW_SPACE,
+                               HeapObject::cast(result)->address(),
+                               size);
+}
+
+
+void LocalAllocationBuffer::Close() {
+  if (!IsValid()) return;
+  int unused = static_cast<int>(allocation_info_.limit() -
+                                allocation_info_.top());
+  if (unused > 0) heap_->CreateFillerObjectAt(allocation_info_.top(), unused);
+  allocation_info_.set_top(NULL);
+  allocation_info_.set_limit(NULL);
+}
+
+
 // -----------------------------------------------------------------------------
 // PagedSpace implementation
 
@@ -955,6 +1088,8 @@ PagedSpace::PagedSpace(Heap* heap,
 
   allocation_info_.set_top(NULL);
   allocation_info_.set_limit(NULL);
+  hot_allocation_info_.set_top(NULL);
+  hot_allocation_info_.set_limit(NULL);
 
   anchor_.InitializeAsAnchor(this);
 }
@@ -1144,6 +1279,10 @@ void PagedSpace::ReleasePage(Page* page, bool unlink) {
     allocation_info_.set_top(NULL);
     allocation_info_.set_limit(NULL);
   }
+  if (Page::FromAllocationTop(hot_allocation_info_.top()) == page) {
+    hot_allocation_info_.set_top(NULL);
+    hot_allocation_info_.set_limit(NULL);
+  }
 
   if (unlink) {
     page->Unlink();
@@ -1171,6 +1310,7 @@ void PagedSpace::Verify(ObjectVisitor* visitor) {
   bool allocation_pointer_found_in_space =
       (allocation_info_.top() == allocation_info_.limit());
   PageIterator page_iterator(this);
+  int index = 0;
   while (page_iterator.has_next()) {
     Page* page = page_iterator.next();
     CHECK(page->owner() == this);
@@ -1178,6 +1318,7 @@ void PagedSpace::Verify(ObjectVisitor* visitor) {
       allocation_pointer_found_in_space = true;
     }
     CHECK(page->WasSweptPrecisely());
+    if (!heap()->ShouldVerifyPage(index++)) continue;
     HeapObjectIterator it(page, NULL);
     Address end_of_previous_object = page->area_start();
     Address top = page->area_end();
@@ -1326,8 +1467,9 @@ void NewSpace::Grow() {
 }
 
 
-void NewSpace::Shrink() {
-  int new_capacity = Max(InitialCapacity(), 2 * SizeAsInt());
+void NewSpace::Shrink(int minimum_capacity) {
+  int new_capacity = Max(Max(InitialCapacity(), minimum_capacity),
+                         2 * SizeAsInt());
   int rounded_new_capacity = RoundUp(new_capacity, Page::kPageSize);
   if (rounded_new_capacity < Capacity() &&
       to_space_.ShrinkTo(rounded_new_capacity))  {
@@ -1347,6 +1489,12 @@ void NewSpace::Shrink() {
 }
 
 
+MaybeObject* NewSpace::AllocateRawSynchronized(int size_in_bytes) {
+  LockGuard<Mutex> lock_guard(&mutex_);
+  return AllocateRaw(size_in_bytes);
+}
+
+
 void NewSpace::UpdateAllocationInfo() {
   MemoryChunk::UpdateHighWaterMark(allocation_info_.top());
   allocation_info_.set_top(to_space_.page_low());
@@ -2210,7 +2358,9 @@ intptr_t FreeList::Concatenate(FreeList* free_list) {
   free_bytes += small_list_.Concatenate(free_list->small_list());
   free_bytes += medium_list_.Concatenate(free_list->medium_list());
   free_bytes += large_list_.Concatenate(free_list->large_list());
-  free_bytes += huge_list_.Concatenate(free_list->huge_list());
+  for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+    free_bytes += huge_lists_[i].Concatenate(free_list->huge_list(i));
+  }
   return free_bytes;
 }
 
@@ -2219,7 +2369,9 @@ void FreeList::Reset() {
   small_list_.Reset();
   medium_list_.Reset();
   large_list_.Reset();
-  huge_list_.Reset();
+  for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+    huge_lists_[i].Reset();
+  }
 }
 
 
@@ -2248,7 +2400,7 @@ int FreeList::Free(Address start, int size_in_bytes) {
     large_list_.Free(node, size_in_bytes);
     page->add_available_in_large_free_list(size_in_bytes);
   } else {
-    huge_list_.Free(node, size_in_bytes);
+    huge_lists_[HugeSizeClass(size_in_bytes)].Free(node, size_in_bytes);
     page->add_available_in_huge_free_list(size_in_bytes);
   }
 
@@ -2257,45 +2409,29 @@ int FreeList::Free(Address start, int size_in_bytes) {
 }
 
 
-FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
-  FreeListNode* node = NULL;
-  Page* page = NULL;
-
-  if (size_in_bytes <= kSmallAllocationMax) {
-    node = small_list_.PickNodeFromList(node_size);
-    if (node != NULL) {
-      ASSERT(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_small_free_list(-(*node_size));
-      ASSERT(IsVeryLong() || available() == SumFreeLists());
-      return node;
-    }
+int FreeList::HugeSizeClass(int size_in_bytes) {
+  if (!FLAG_free_list_size_classes) return 0;
+  int size_class = 0;
+  int limit = 2 * kHugeListMin;
+  while (size_in_bytes >= limit &&
+         size_class < kNumberOfHugeSizeClasses - 1) {
+    size_class++;
+    limit *= 2;
   }
+  return size_class;
+}
 
-  if (size_in_bytes <= kMediumAllocationMax) {
-    node = medium_list_.PickNodeFromList(node_size);
-    if (node != NULL) {
-      ASSERT(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_medium_free_list(-(*node_size));
-      ASSERT(IsVeryLong() || available() == SumFreeLists());
-      return node;
-    }
-  }
 
-  if (size_in_bytes <= kLargeAllocationMax) {
-    node = large_list_.PickNodeFromList(node_size);
-    if (node != NULL) {
-      ASSERT(size_in_bytes <= *node_size);
-      page = Page::FromAddress(node->address());
-      page->add_available_in_large_free_list(-(*node_size));
-      ASSERT(IsVeryLong() || available() == SumFreeLists());
-      return node;
-    }
-  }
+FreeListNode* FreeList::FindNodeInHugeList(int size_class,
+                                           int size_in_bytes,
+                                           int* node_size) {
+  FreeListCategory* huge_list = &huge_lists_[size_class];
+  if (huge_list->IsEmpty()) return NULL;
 
-  int huge_list_available = huge_list_.available();
-  FreeListNode* top_node = huge_list_.top();
+  FreeListNode* node = NULL;
+  Page* page = NULL;
+  int huge_list_available = huge_list->available();
+  FreeListNode* top_node = huge_list->top();
   for (FreeListNode** cur = &top_node;
        *cur != NULL;
        cur = (*cur)->next_address()) {
@@ -2311,7 +2447,7 @@ FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
 
     *cur = cur_node;
     if (cur_node == NULL) {
-      huge_list_.set_end(NULL);
+      huge_list->set_end(NULL);
       break;
     }
 
@@ -2330,11 +2466,58 @@ FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
     }
   }
 
-  huge_list_.set_top(top_node);
-  if (huge_list_.top() == NULL) {
-    huge_list_.set_end(NULL);
+  huge_list->set_top(top_node);
+  if (huge_list->top() == NULL) {
+    huge_list->set_end(NULL);
+  }
+  huge_list->set_available(huge_list_available);
+  return node;
+}
+
+
+FreeListNode* FreeList::FindNodeFor(int size_in_bytes, int* node_size) {
+  FreeListNode* node = NULL;
+  Page* page = NULL;
+
+  if (size_in_bytes <= kSmallAllocationMax) {
+    node = small_list_.PickNodeFromList(node_size);
+    if (node != NULL) {
+      ASSERT(size_in_bytes <= *node_size);
+      page = Page::FromAddress(node->address());
+      page->add_available_in_small_free_list(-(*node_size));
+      ASSERT(IsVeryLong() || available() == SumFreeLists());
+      return node;
+    }
+  }
+
+  if (size_in_bytes <= kMediumAllocationMax) {
+    node = medium_list_.PickNodeFromList(node_size);
+    if (node != NULL) {
+      ASSERT(size_in_bytes <= *node_size);
+      page = Page::FromAddress(node->address());
+      page->add_available_in_medium_free_list(-(*node_size));
+      ASSERT(IsVeryLong() || available() == SumFreeLists());
+      return node;
+    }
+  }
+
+  if (size_in_bytes <= kLargeAllocationMax) {
+    node = large_list_.PickNodeFromList(node_size);
+    if (node != NULL) {
+      ASSERT(size_in_bytes <= *node_size);
+      page = Page::FromAddress(node->address());
+      page->add_available_in_large_free_list(-(*node_size));
+      ASSERT(IsVeryLong() || available() == SumFreeLists());
+      return node;
+    }
+  }
+
+  for (int i = HugeSizeClass(size_in_bytes);
+       i < kNumberOfHugeSizeClasses;
+       i++) {
+    node = FindNodeInHugeList(i, size_in_bytes, node_size);
+    if (node != NULL) break;
   }
-  huge_list_.set_available(huge_list_available);
 
   if (node != NULL) {
     ASSERT(IsVeryLong() || available() == SumFreeLists());
@@ -2449,7 +2632,10 @@ HeapObject* FreeList::Allocate(int size_in_bytes) {
 
 
 intptr_t FreeList::EvictFreeListItems(Page* p) {
-  intptr_t sum = huge_list_.EvictFreeListItemsInList(p);
+  intptr_t sum = 0;
+  for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+    sum += huge_lists_[i].EvictFreeListItemsInList(p);
+  }
   p->set_available_in_huge_free_list(0);
 
   if (sum < p->area_size()) {
@@ -2466,8 +2652,10 @@ intptr_t FreeList::EvictFreeListItems(Page* p) {
 
 
 bool FreeList::ContainsPageFreeListItems(Page* p) {
-  return huge_list_.EvictFreeListItemsInList(p) ||
-         small_list_.EvictFreeListItemsInList(p) ||
+  for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+    if (huge_lists_[i].EvictFreeListItemsInList(p)) return true;
+  }
+  return small_list_.EvictFreeListItemsInList(p) ||
          medium_list_.EvictFreeListItemsInList(p) ||
          large_list_.EvictFreeListItemsInList(p);
 }
@@ -2477,7 +2665,9 @@ void FreeList::RepairLists(Heap* heap) {
   small_list_.RepairFreeList(heap);
   medium_list_.RepairFreeList(heap);
   large_list_.RepairFreeList(heap);
-  huge_list_.RepairFreeList(heap);
+  for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+    huge_lists_[i].RepairFreeList(heap);
+  }
 }
 
 
@@ -2514,7 +2704,9 @@ bool FreeList::IsVeryLong() {
   if (small_list_.FreeListLength() == kVeryLongFreeList) return  true;
   if (medium_list_.FreeListLength() == kVeryLongFreeList) return  true;
   if (large_list_.FreeListLength() == kVeryLongFreeList) return  true;
-  if (huge_list_.FreeListLength() == kVeryLongFreeList) return  true;
+  for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+    if (huge_lists_[i].FreeListLength() == kVeryLongFreeList) return  true;
+  }
   return false;
 }
 
@@ -2526,7 +2718,9 @@ intptr_t FreeList::SumFreeLists() {
   intptr_t sum = small_list_.SumFreeList();
   sum += medium_list_.SumFreeList();
   sum += large_list_.SumFreeList();
-  sum += huge_list_.SumFreeList();
+  for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+    sum += huge_lists_[i].SumFreeList();
+  }
   return sum;
 }
 #endif
@@ -2539,6 +2733,7 @@ void PagedSpace::PrepareForMarkCompact() {
   // We don't have a linear allocation area while sweeping.  It will be restored
   // on the first allocation after the sweep.
   EmptyAllocationInfo();
+  EmptyHotAllocationInfo();
 
   // Stop lazy sweeping and clear marking bits for unswept pages.
   if (first_unswept_page_ != NULL) {
@@ -2567,7 +2762,8 @@ void PagedSpace::PrepareForMarkCompact() {
 
 intptr_t PagedSpace::SizeOfObjects() {
   ASSERT(!heap()->IsSweepingComplete() || (unswept_free_bytes_ == 0));
-  return Size() - unswept_free_bytes_ - (limit() - top());
+  return Size() - unswept_free_bytes_ - (limit() - top()) -
+      (hot_allocation_info_.limit() - hot_allocation_info_.top());
 }
 
 
@@ -2633,11 +2829,20 @@ bool PagedSpace::EnsureSweeperProgress(intptr_t size_in_bytes) {
   MarkCompactCollector* collector = heap()->mark_compact_collector();
   if (collector->AreSweeperThreadsActivated()) {
     if (collector->IsConcurrentSweepingInProgress()) {
-      if (collector->RefillFreeLists(this) < size_in_bytes) {
-        if (!collector->sequential_sweeping()) {
-          collector->WaitUntilSweepingCompleted();
-          return true;
-        }
+      intptr_t freed_bytes = collector->RefillFreeLists(this);
+      if (freed_bytes < size_in_bytes) {
+        // The sweepers lag behind, so sweep some of the remaining pages
+        // here instead of waiting for them.
+        freed_bytes += collector->SweepOnMainThread(
+            this, size_in_bytes - freed_bytes);
+      }
+      if (freed_bytes < size_in_bytes) {
+        // Pages swept by the sweepers in the meantime.
+        freed_bytes += collector->RefillFreeLists(this);
+      }
+      if (freed_bytes < size_in_bytes && !collector->sequential_sweeping()) {
+        collector->WaitUntilSweepingCompleted();
+        return true;
       }
       return false;
     }
@@ -2648,6 +2853,58 @@ bool PagedSpace::EnsureSweeperProgress(intptr_t size_in_bytes) {
 }
 
 
+MaybeObject* PagedSpace::AllocateRawSynchronized(int size_in_bytes) {
+  LockGuard<Mutex> lock_guard(&space_mutex_);
+  return AllocateRaw(size_in_bytes);
+}
+
+
+MaybeObject* PagedSpace::AllocateRawHot(int size_in_bytes) {
+  // Without inline allocation the free list keeps no linear area around.
+  if (heap()->inline_allocation_disabled()) return AllocateRaw(size_in_bytes);
+
+  // Temporarily install the hot area as the linear allocation area so that
+  // the regular fast path, free list and expansion logic all apply to it.
+  AllocationInfo normal_allocation_info = allocation_info_;
+  allocation_info_ = hot_allocation_info_;
+  HeapObject* object = AllocateLinearly(size_in_bytes);
+  MaybeObject* result = object;
+  if (object != NULL) {
+    if (identity() == CODE_SPACE) {
+      SkipList::Update(object->address(), size_in_bytes);
+    }
+  } else {
+    // Refill the area with a block large enough for several objects, so that
+    // the following hot allocations are contiguous with this one.  The unused
+    // end of the block is handed back by moving top down; it stays accounted
+    // as allocated, like any linear allocation area.
+    int area_size = Min(kHotAllocationAreaSize, AreaSize());
+    if (size_in_bytes < area_size && AllocateRaw(area_size)->To(&object)) {
+      ASSERT(allocation_info_.top() == allocation_info_.limit() ||
+             allocation_info_.top() == object->address() + area_size);
+      Address limit = allocation_info_.top() == allocation_info_.limit()
+          ? object->address() + area_size
+          : allocation_info_.limit();
+      allocation_info_.set_top(object->address() + size_in_bytes);
+      allocation_info_.set_limit(limit);
+      result = object;
+    } else {
+      result = AllocateRaw(size_in_bytes);
+    }
+  }
+  hot_allocation_info_ = allocation_info_;
+  allocation_info_ = normal_allocation_info;
+
+  // Heap iterators only skip the normal linear allocation area.
+  int unused = static_cast<int>(hot_allocation_info_.limit() -
+                                hot_allocation_info_.top());
+  if (unused > 0) {
+    heap()->CreateFillerObjectAt(hot_allocation_info_.top(), unused);
+  }
+  return result;
+}
+
+
 HeapObject* PagedSpace::SlowAllocateRaw(int size_in_bytes) {
   // Allocation in this space has failed.
 
@@ -3096,6 +3353,7 @@ bool LargeObjectSpace::Contains(HeapObject* object) {
 // We do not assume that the large object iterator works, because it depends
 // on the invariants we are checking during verification.
 void LargeObjectSpace::Verify() {
+  int index = 0;
   for (LargePage* chunk = first_page_;
        chunk != NULL;
        chunk = chunk->next_page()) {
@@ -3104,6 +3362,7 @@ void LargeObjectSpace::Verify() {
     HeapObject* object = chunk->GetObject();
     Page* page = Page::FromAddress(object->address());
     CHECK(object->address() == page->area_start());
+    if (!heap()->ShouldVerifyPage(index++)) continue;
 
     // The first word should be a map, and we expect all map pointers to be
     // in map space.
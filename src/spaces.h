@@ -292,6 +292,7 @@ class Bitmap {
 };
 
 
+class CardTable;
 class SkipList;
 class SlotsBuffer;
 
@@ -416,6 +417,10 @@ class MemoryChunk {
     // to grey transition is performed in the value.
     HAS_PROGRESS_BAR,
 
+    // Code on this chunk was patched during a full GC without flushing the
+    // instruction cache.  The collector flushes it once when it is done.
+    NEEDS_ICACHE_FLUSH,
+
     // Last flag, keep at bottom.
     NUM_MEMORY_CHUNK_FLAGS
   };
@@ -576,7 +581,7 @@ class MemoryChunk {
 
   static const size_t kHeaderSize = kWriteBarrierCounterOffset + kPointerSize +
                                     kIntSize + kIntSize + kPointerSize +
-                                    5 * kPointerSize +
+                                    5 * kPointerSize + kPointerSize +
                                     kPointerSize + kPointerSize;
 
   static const int kBodyOffset =
@@ -665,6 +670,14 @@ class MemoryChunk {
     skip_list_ = skip_list;
   }
 
+  inline CardTable* card_table() {
+    return card_table_;
+  }
+
+  inline void set_card_table(CardTable* card_table) {
+    card_table_ = card_table;
+  }
+
   inline SlotsBuffer* slots_buffer() {
     return slots_buffer_;
   }
@@ -736,6 +749,10 @@ class MemoryChunk {
   intptr_t available_in_huge_free_list_;
   intptr_t non_available_small_blocks_;
 
+  // Cards of this chunk that may contain pointers to new space. Only used for
+  // large object pages whose slots no longer fit in the store buffer.
+  CardTable* card_table_;
+
   static MemoryChunk* Initialize(Heap* heap,
                                  Address base,
                                  size_t size,
@@ -970,7 +987,16 @@ class CodeRange {
   bool UncommitRawMemory(Address start, size_t length);
   void FreeRawMemory(Address buf, size_t length);
 
+  // Size of the huge pages the range is aligned to with
+  // --code-range-huge-pages.
+  static const size_t kHugePageSize = 2 * MB;
+
  private:
+  // With --code-range-huge-pages a chunk is committed as a whole with
+  // uniform protection and without guard pages, so that adjacent chunks
+  // can be backed by the same huge page.
+  bool CommitHugePageMemory(Address start, size_t length);
+
   Isolate* isolate_;
 
   // The reserved range of virtual memory that all code objects are put in.
@@ -1065,6 +1091,82 @@ class SkipList {
 };
 
 
+// A card table remembers which regions of a large object page may contain
+// pointers to new space.  It is used instead of the store buffer for pages
+// that would otherwise overflow it, so that a scavenge only has to visit the
+// dirty cards rather than the whole object.
+class CardTable {
+ public:
+  explicit CardTable(MemoryChunk* chunk)
+      : area_start_(chunk->area_start()),
+        number_of_cards_(
+            ((chunk->area_size() - 1) >> kCardSizeLog2) + 1),
+        cells_(new uint32_t[CellCount()]) {
+    Clear();
+  }
+
+  ~CardTable() {
+    delete[] cells_;
+  }
+
+  void Clear() {
+    for (int idx = 0; idx < CellCount(); idx++) cells_[idx] = 0;
+    is_dirty_ = false;
+  }
+
+  void MarkCard(Address slot) {
+    int card = CardNumber(slot);
+    cells_[card >> kBitsPerCellLog2] |= 1u << (card & (kBitsPerCell - 1));
+    is_dirty_ = true;
+  }
+
+  bool IsCardDirty(int card) {
+    ASSERT(0 <= card && card < number_of_cards_);
+    return (cells_[card >> kBitsPerCellLog2] &
+            (1u << (card & (kBitsPerCell - 1)))) != 0;
+  }
+
+  // True if any card has been marked since the last Clear().
+  bool is_dirty() { return is_dirty_; }
+
+  int number_of_cards() { return number_of_cards_; }
+
+  Address CardStart(int card) {
+    return area_start_ + (static_cast<intptr_t>(card) << kCardSizeLog2);
+  }
+
+  int CardNumber(Address slot) {
+    ASSERT(slot >= area_start_);
+    return static_cast<int>((slot - area_start_) >> kCardSizeLog2);
+  }
+
+  static CardTable* Ensure(MemoryChunk* chunk) {
+    CardTable* table = chunk->card_table();
+    if (table == NULL) {
+      table = new CardTable(chunk);
+      chunk->set_card_table(table);
+    }
+    return table;
+  }
+
+  static const int kCardSizeLog2 = 9;
+  static const int kCardSize = 1 << kCardSizeLog2;
+
+ private:
+  static const int kBitsPerCellLog2 = 5;
+  static const int kBitsPerCell = 1 << kBitsPerCellLog2;
+
+  int CellCount() {
+    return ((number_of_cards_ - 1) >> kBitsPerCellLog2) + 1;
+  }
+
+  Address area_start_;
+  int number_of_cards_;
+  uint32_t* cells_;
+  bool is_dirty_;
+};
+
+
 // ----------------------------------------------------------------------------
 // A space acquires chunks of memory from the operating system. The memory
 // allocator allocated and deallocates pages for the paged heap spaces and large
@@ -1090,6 +1192,9 @@ class MemoryAllocator {
 
   void Free(MemoryChunk* chunk);
 
+  // Unmaps the freed large object chunks kept for reuse.
+  void ReleasePooledChunks();
+
   // Returns the maximum available bytes of heaps.
   intptr_t Available() { return capacity_ < size_ ? 0 : capacity_ - size_; }
 
@@ -1212,6 +1317,20 @@ class MemoryAllocator {
   void* lowest_ever_allocated_;
   void* highest_ever_allocated_;
 
+  // Freed non-executable large object chunks that are still mapped and
+  // committed.  They are not accounted in size_ and are handed out again by
+  // AllocateChunk, so that allocating and dropping big buffers does not map
+  // and unmap memory in every GC cycle.
+  List<MemoryChunk*> pooled_chunks_;
+  size_t pooled_size_;
+
+  // Returns true and keeps the chunk mapped if it can be pooled.
+  bool PoolChunk(MemoryChunk* chunk);
+
+  // Finds the smallest pooled chunk of at least the given size, but not much
+  // bigger, and transfers its reservation.  Returns its base or NULL.
+  Address TakePooledChunk(size_t* chunk_size, VirtualMemory* reservation);
+
   struct MemoryAllocationCallbackRegistration {
     MemoryAllocationCallbackRegistration(MemoryAllocationCallback callback,
                                          ObjectSpace space,
@@ -1394,6 +1513,43 @@ class AllocationInfo {
 };
 
 
+// A linear allocation buffer that a thread carves out of a space so that it
+// can allocate objects without synchronizing with other threads. Buffers are
+// obtained with AllocateRawSynchronized and have to be closed before the
+// next GC or heap iteration, which turns their unused rest into a filler
+// object. Objects in code space need skip list updates and are therefore
+// not supported.
+class LocalAllocationBuffer {
+ public:
+  // An invalid buffer; every allocation from it fails.
+  LocalAllocationBuffer() : heap_(NULL), identity_(NEW_SPACE) { }
+
+  // Returns an invalid buffer if the space cannot provide |size| bytes.
+  static LocalAllocationBuffer FromPagedSpace(PagedSpace* space, int size);
+  static LocalAllocationBuffer FromNewSpace(NewSpace* space, int size);
+
+  bool IsValid() { return allocation_info_.top() != NULL; }
+
+  // Allocates from the buffer or returns a retry failure for the space the
+  // buffer was taken from once the buffer is exhausted.
+  MUST_USE_RESULT inline MaybeObject* AllocateRaw(int size_in_bytes);
+
+  // Turns the unused part of the buffer into a filler object and
+  // invalidates the buffer.
+  void Close();
+
+ private:
+  LocalAllocationBuffer(Heap* heap,
+                        AllocationSpace identity,
+                        Address start,
+                        int size);
+
+  Heap* heap_;
+  AllocationSpace identity_;
+  AllocationInfo allocation_info_;
+};
+
+
 // An abstraction of the accounting statistics of a page-structured space.
 // The 'capacity' of a space is the number of object-area bytes (i.e., not
 // including page bookkeeping structures) currently in the space. The 'size'
@@ -1613,6 +1769,10 @@ class FreeListCategory {
 //     These spaces are call large.
 // At least 16384 words.  This list is for objects of 2048 words or larger.
 //     Empty pages are added to this list.  These spaces are called huge.
+//     The huge list is segregated into size classes that each cover a power
+//     of two range of sizes.  Allocation takes a node from the smallest size
+//     class that fits, so that empty pages are only broken up when no smaller
+//     huge block is left and can otherwise be released.
 class FreeList {
  public:
   explicit FreeList(PagedSpace* owner);
@@ -1624,8 +1784,12 @@ class FreeList {
 
   // Return the number of bytes available on the free list.
   intptr_t available() {
-    return small_list_.available() + medium_list_.available() +
-           large_list_.available() + huge_list_.available();
+    intptr_t sum = small_list_.available() + medium_list_.available() +
+                   large_list_.available();
+    for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+      sum += huge_lists_[i].available();
+    }
+    return sum;
   }
 
   // Place a node on the free list.  The block of size 'size_in_bytes'
@@ -1643,8 +1807,14 @@ class FreeList {
   MUST_USE_RESULT HeapObject* Allocate(int size_in_bytes);
 
   bool IsEmpty() {
-    return small_list_.IsEmpty() && medium_list_.IsEmpty() &&
-           large_list_.IsEmpty() && huge_list_.IsEmpty();
+    if (!small_list_.IsEmpty() || !medium_list_.IsEmpty() ||
+        !large_list_.IsEmpty()) {
+      return false;
+    }
+    for (int i = 0; i < kNumberOfHugeSizeClasses; i++) {
+      if (!huge_lists_[i].IsEmpty()) return false;
+    }
+    return true;
   }
 
 #ifdef DEBUG
@@ -1662,7 +1832,12 @@ class FreeList {
   FreeListCategory* small_list() { return &small_list_; }
   FreeListCategory* medium_list() { return &medium_list_; }
   FreeListCategory* large_list() { return &large_list_; }
-  FreeListCategory* huge_list() { return &huge_list_; }
+  FreeListCategory* huge_list(int size_class) {
+    ASSERT(0 <= size_class && size_class < kNumberOfHugeSizeClasses);
+    return &huge_lists_[size_class];
+  }
+
+  static const int kNumberOfHugeSizeClasses = 4;
 
  private:
   // The size range of blocks, in bytes.
@@ -1671,6 +1846,16 @@ class FreeList {
 
   FreeListNode* FindNodeFor(int size_in_bytes, int* node_size);
 
+  // Returns the first node of at least |size_in_bytes| in the given huge
+  // size class and unlinks it. Nodes on evacuation candidates are dropped.
+  FreeListNode* FindNodeInHugeList(int size_class,
+                                   int size_in_bytes,
+                                   int* node_size);
+
+  // Returns the huge size class of blocks of |size_in_bytes|, which is also
+  // the first size class that can satisfy an allocation of that size.
+  static int HugeSizeClass(int size_in_bytes);
+
   PagedSpace* owner_;
   Heap* heap_;
 
@@ -1681,10 +1866,11 @@ class FreeList {
   static const int kSmallAllocationMax = kSmallListMin - kPointerSize;
   static const int kMediumAllocationMax = kSmallListMax;
   static const int kLargeAllocationMax = kMediumListMax;
+  static const int kHugeListMin = kLargeListMax + kPointerSize;
   FreeListCategory small_list_;
   FreeListCategory medium_list_;
   FreeListCategory large_list_;
-  FreeListCategory huge_list_;
+  FreeListCategory huge_lists_[kNumberOfHugeSizeClasses];
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(FreeList);
 };
@@ -1811,6 +1997,19 @@ class PagedSpace : public Space {
   // failure object if not.
   MUST_USE_RESULT inline MaybeObject* AllocateRaw(int size_in_bytes);
 
+  // Like AllocateRaw, but serialized with other synchronized allocations in
+  // this space. Only safe while the main thread does not allocate in it.
+  MUST_USE_RESULT MaybeObject* AllocateRawSynchronized(int size_in_bytes);
+
+  // Like AllocateRaw, but allocates from a second linear allocation area so
+  // that the objects allocated through it end up next to each other rather
+  // than interleaved with the objects allocated by AllocateRaw.  Used to keep
+  // hot (optimized) code together in code space.
+  MUST_USE_RESULT MaybeObject* AllocateRawHot(int size_in_bytes);
+
+  // Size of the blocks the hot allocation area is refilled with.
+  static const int kHotAllocationAreaSize = 16 * KB;
+
   // Give a block of memory to the space's free list.  It might be added to
   // the free list or accounted as waste.
   // If add_to_freelist is false then just accounting stats are updated and
@@ -1843,6 +2042,15 @@ class PagedSpace : public Space {
     SetTopAndLimit(NULL, NULL);
   }
 
+  // Empty the hot allocation area, returning unused area to free list.
+  void EmptyHotAllocationInfo() {
+    int old_hot_size = static_cast<int>(hot_allocation_info_.limit() -
+                                        hot_allocation_info_.top());
+    Free(hot_allocation_info_.top(), old_hot_size);
+    hot_allocation_info_.set_top(NULL);
+    hot_allocation_info_.set_limit(NULL);
+  }
+
   void Allocate(int bytes) {
     accounting_stats_.AllocateBytes(bytes);
   }
@@ -1916,6 +2124,8 @@ class PagedSpace : public Space {
     unswept_free_bytes_ = 0;
   }
 
+  intptr_t unswept_free_bytes() { return unswept_free_bytes_; }
+
   bool AdvanceSweeper(intptr_t bytes_to_sweep);
 
   // When parallel sweeper threads are active and the main thread finished
@@ -1964,6 +2174,14 @@ class PagedSpace : public Space {
   // Normal allocation information.
   AllocationInfo allocation_info_;
 
+  // Allocation information for AllocateRawHot.  Unlike the normal linear
+  // allocation area, the unused part of this area is kept covered by a
+  // filler so that the space stays iterable.
+  AllocationInfo hot_allocation_info_;
+
+  // Serializes AllocateRawSynchronized.
+  Mutex space_mutex_;
+
   bool was_swept_conservatively_;
 
   // The first page to be swept when the lazy sweeper advances. Is set
@@ -2416,8 +2634,10 @@ class NewSpace : public Space {
   // their maximum capacity.
   void Grow();
 
-  // Shrink the capacity of the semispaces.
-  void Shrink();
+  // Shrink the capacity of the semispaces, but not below the given
+  // capacity or twice the size of the live objects.
+  void Shrink(int minimum_capacity);
+  void Shrink() { Shrink(InitialCapacity()); }
 
   // True if the address or object lies in the address range of either
   // semispace (not necessarily below the allocation pointer).
@@ -2539,6 +2759,10 @@ class NewSpace : public Space {
 
   MUST_USE_RESULT INLINE(MaybeObject* AllocateRaw(int size_in_bytes));
 
+  // Like AllocateRaw, but serialized with other synchronized allocations in
+  // new space. Only safe while the main thread does not allocate in it.
+  MUST_USE_RESULT MaybeObject* AllocateRawSynchronized(int size_in_bytes);
+
   // Reset the allocation pointer to the beginning of the active semispace.
   void ResetAllocationInfo();
 
@@ -2643,6 +2867,9 @@ class NewSpace : public Space {
   // mark-compact collection.
   AllocationInfo allocation_info_;
 
+  // Serializes AllocateRawSynchronized.
+  Mutex mutex_;
+
   // When incremental marking is active we will set allocation_info_.limit
   // to be lower than actual limit and then will gradually increase it
   // in steps to guarantee that we do incremental marking steps even
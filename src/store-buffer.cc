@@ -166,20 +166,23 @@ void StoreBuffer::EnsureSpace(intptr_t space_needed) {
 
   old_buffer_is_filtered_ = true;
   bool page_has_scan_on_scavenge_flag = false;
+  bool page_has_card_table = false;
 
   PointerChunkIterator it(heap_);
   MemoryChunk* chunk;
   while ((chunk = it.next()) != NULL) {
-    if (chunk->scan_on_scavenge()) {
-      page_has_scan_on_scavenge_flag = true;
-      break;
-    }
+    if (chunk->scan_on_scavenge()) page_has_scan_on_scavenge_flag = true;
+    if (chunk->card_table() != NULL) page_has_card_table = true;
   }
 
   if (page_has_scan_on_scavenge_flag) {
     Filter(MemoryChunk::SCAN_ON_SCAVENGE);
   }
 
+  if (page_has_card_table) {
+    MoveEntriesToCardTables();
+  }
+
   if (SpaceAvailable(space_needed)) return;
 
   // Sample 1 entry in 97 and filter out the pages where we estimate that more
@@ -214,6 +217,7 @@ void StoreBuffer::ExemptPopularPages(int prime_sample_step, int threshold) {
     chunk->set_store_buffer_counter(0);
   }
   bool created_new_scan_on_scavenge_pages = false;
+  bool created_new_card_tables = false;
   MemoryChunk* previous_chunk = NULL;
   for (Address* p = old_start_; p < old_top_; p += prime_sample_step) {
     Address addr = *p;
@@ -225,8 +229,18 @@ void StoreBuffer::ExemptPopularPages(int prime_sample_step, int threshold) {
     }
     int old_counter = containing_chunk->store_buffer_counter();
     if (old_counter >= threshold) {
-      containing_chunk->set_scan_on_scavenge(true);
-      created_new_scan_on_scavenge_pages = true;
+      // Scanning a whole large object on every scavenge is expensive, so
+      // large object pages remember their slots in a card table instead.
+      if (FLAG_store_buffer_card_marking &&
+          containing_chunk->owner() == heap_->lo_space()) {
+        if (containing_chunk->card_table() == NULL) {
+          CardTable::Ensure(containing_chunk);
+          created_new_card_tables = true;
+        }
+      } else {
+        containing_chunk->set_scan_on_scavenge(true);
+        created_new_scan_on_scavenge_pages = true;
+      }
     }
     containing_chunk->set_store_buffer_counter(old_counter + 1);
     previous_chunk = containing_chunk;
@@ -234,6 +248,9 @@ void StoreBuffer::ExemptPopularPages(int prime_sample_step, int threshold) {
   if (created_new_scan_on_scavenge_pages) {
     Filter(MemoryChunk::SCAN_ON_SCAVENGE);
   }
+  if (created_new_card_tables) {
+    MoveEntriesToCardTables();
+  }
   old_buffer_is_filtered_ = true;
 }
 
@@ -262,6 +279,43 @@ void StoreBuffer::Filter(int flag) {
 }
 
 
+void StoreBuffer::MoveEntriesToCardTables() {
+  Address* new_top = old_start_;
+  MemoryChunk* previous_chunk = NULL;
+  for (Address* p = old_start_; p < old_top_; p++) {
+    Address addr = *p;
+    MemoryChunk* containing_chunk = NULL;
+    if (previous_chunk != NULL && previous_chunk->Contains(addr)) {
+      containing_chunk = previous_chunk;
+    } else {
+      containing_chunk = MemoryChunk::FromAnyPointerAddress(heap_, addr);
+      previous_chunk = containing_chunk;
+    }
+    CardTable* card_table = containing_chunk->card_table();
+    if (card_table == NULL || containing_chunk->scan_on_scavenge()) {
+      *new_top++ = addr;
+    } else {
+      card_table->MarkCard(addr);
+    }
+  }
+  old_top_ = new_top;
+
+  // Filtering hash sets are inconsistent with the store buffer after this
+  // operation.
+  ClearFilteringHashSets();
+}
+
+
+bool StoreBuffer::HasDirtyCardTables() {
+  LargePage* page = heap_->lo_space()->first_page();
+  for (; page != NULL; page = page->next_page()) {
+    CardTable* card_table = page->card_table();
+    if (card_table != NULL && card_table->is_dirty()) return true;
+  }
+  return false;
+}
+
+
 void StoreBuffer::SortUniq() {
   Compact();
   if (old_buffer_is_sorted_) return;
@@ -442,6 +496,27 @@ void StoreBuffer::FindPointersToNewSpaceInRegion(
 }
 
 
+void StoreBuffer::FindPointersToNewSpaceInDirtyCards(
+    LargePage* page,
+    ObjectSlotCallback slot_callback,
+    bool clear_maps) {
+  CardTable* card_table = page->card_table();
+  HeapObject* array = page->GetObject();
+  ASSERT(array->IsFixedArray());
+  Address object_start = array->address();
+  Address object_end = object_start + array->Size();
+  int number_of_cards = card_table->number_of_cards();
+  for (int card = 0; card < number_of_cards; card++) {
+    if (!card_table->IsCardDirty(card)) continue;
+    Address start = Max(card_table->CardStart(card), object_start);
+    Address end = Min(card_table->CardStart(card + 1), object_end);
+    if (start < end) {
+      FindPointersToNewSpaceInRegion(start, end, slot_callback, clear_maps);
+    }
+  }
+}
+
+
 // Compute start address of the first map following given addr.
 static inline Address MapStartAlign(Address addr) {
   Address page = Page::FromAddress(addr)->area_start();
@@ -618,10 +693,13 @@ void StoreBuffer::IteratePointersToNewSpaceAndClearMaps(
 
 void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
                                             bool clear_maps) {
-  // We do not sort or remove duplicated entries from the store buffer because
-  // we expect that callback will rebuild the store buffer thus removing
-  // all duplicates and pointers to old space.
+  // The callback rebuilds the store buffer, which removes duplicates and
+  // pointers to old space anyway.  We still sort the entries so that the
+  // slots are visited page by page rather than in the order the write
+  // barrier recorded them; as the rebuilt buffer is written in visiting
+  // order it stays mostly sorted from one scavenge to the next.
   bool some_pages_to_scan = PrepareForIteration();
+  if (FLAG_sort_store_buffer_for_scavenge) SortUniq();
 
   // TODO(gc): we want to skip slots on evacuation candidates
   // but we can't simply figure that out from slot address
@@ -650,6 +728,8 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
           (*callback_)(heap_, chunk, kStoreBufferScanningPageEvent);
         }
         if (chunk->owner() == heap_->lo_space()) {
+          // The whole object is scanned, which subsumes any dirty cards.
+          if (chunk->card_table() != NULL) chunk->card_table()->Clear();
           LargePage* large_page = reinterpret_cast<LargePage*>(chunk);
           HeapObject* array = large_page->GetObject();
           ASSERT(array->IsFixedArray());
@@ -674,6 +754,32 @@ void StoreBuffer::IteratePointersToNewSpace(ObjectSlotCallback slot_callback,
       (*callback_)(heap_, NULL, kStoreBufferScanningPageEvent);
     }
   }
+
+  // Large object pages with a card table only need their dirty cards to be
+  // visited.  Surviving pointers to new space are entered into the store
+  // buffer again, and go back into the card table if it overflows.
+  if (HasDirtyCardTables()) {
+    if (callback_ != NULL) {
+      (*callback_)(heap_, NULL, kStoreBufferStartScanningPagesEvent);
+    }
+    LargePage* page = heap_->lo_space()->first_page();
+    for (; page != NULL; page = page->next_page()) {
+      CardTable* card_table = page->card_table();
+      if (card_table == NULL || !card_table->is_dirty()) continue;
+      if (page->scan_on_scavenge()) {
+        card_table->Clear();
+        continue;
+      }
+      if (callback_ != NULL) {
+        (*callback_)(heap_, page, kStoreBufferScanningPageEvent);
+      }
+      FindPointersToNewSpaceInDirtyCards(page, slot_callback, clear_maps);
+      card_table->Clear();
+    }
+    if (callback_ != NULL) {
+      (*callback_)(heap_, NULL, kStoreBufferScanningPageEvent);
+    }
+  }
 }
 
 
@@ -37,6 +37,7 @@
 namespace v8 {
 namespace internal {
 
+class LargePage;
 class Page;
 class PagedSpace;
 class StoreBuffer;
@@ -170,6 +171,11 @@ class StoreBuffer {
   void Uniq();
   void ExemptPopularPages(int prime_sample_step, int threshold);
 
+  // Moves the entries for chunks that have a card table out of the store
+  // buffer and into the card table.
+  void MoveEntriesToCardTables();
+  bool HasDirtyCardTables();
+
   // Set the map field of the object to NULL if contains a map.
   inline void ClearDeadObject(HeapObject *object);
 
@@ -180,6 +186,10 @@ class StoreBuffer {
                                       ObjectSlotCallback slot_callback,
                                       bool clear_maps);
 
+  void FindPointersToNewSpaceInDirtyCards(LargePage* page,
+                                          ObjectSlotCallback slot_callback,
+                                          bool clear_maps);
+
   // For each region of pointers on a page in use from an old space call
   // visit_pointer_region callback.
   // If either visit_pointer_region or callback can cause an allocation
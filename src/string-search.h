@@ -210,6 +210,22 @@ class StringSearch : private StringSearchBase {
 };
 
 
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+// Returns the high bits of the character lanes of the word at |chars| that
+// hold |c|.  Lanes above a match may be set spuriously, but matches are
+// never missed.  Hosts that read unaligned words are all little-endian, so
+// lane k holds chars[k].
+template <typename Char>
+inline uintptr_t MatchingCharLanes(const Char* chars, Char c) {
+  const int kCharBits = kBitsPerByte * sizeof(Char);
+  const uintptr_t kOnes =
+      kUintptrAllBitsSet / ((static_cast<uintptr_t>(1) << kCharBits) - 1);
+  uintptr_t word = *reinterpret_cast<const uintptr_t*>(chars) ^ (kOnes * c);
+  return (word - kOnes) & ~word & (kOnes << (kCharBits - 1));
+}
+#endif
+
+
 //---------------------------------------------------------------------
 // Single Character Pattern Search Strategy
 //---------------------------------------------------------------------
@@ -237,6 +253,14 @@ int StringSearch<PatternChar, SubjectChar>::SingleCharSearch(
     }
     SubjectChar search_char = static_cast<SubjectChar>(pattern_first_char);
     int n = subject.length();
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+    // There is no memchr for two-byte characters, skip a word at a time.
+    const int kCharsPerWord = sizeof(uintptr_t) / sizeof(SubjectChar);
+    while (i + kCharsPerWord <= n &&
+           MatchingCharLanes(subject.start() + i, search_char) == 0) {
+      i += kCharsPerWord;
+    }
+#endif
     while (i < n) {
       if (subject[i++] == search_char) return i - 1;
     }
@@ -277,6 +301,33 @@ int StringSearch<PatternChar, SubjectChar>::LinearSearch(
   PatternChar pattern_first_char = pattern[0];
   int i = index;
   int n = subject.length() - pattern_length;
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+  // Filter a word of candidate positions at a time on both the first and
+  // the last character of the pattern, which rejects most positions even
+  // when the first character is frequent, and verify the survivors.
+  // Pattern characters fit the subject characters, otherwise the search
+  // would have been a FailSearch.
+  const int kCharsPerWord = sizeof(uintptr_t) / sizeof(SubjectChar);
+  const int kCharBits = kBitsPerByte * sizeof(SubjectChar);
+  SubjectChar first = static_cast<SubjectChar>(pattern_first_char);
+  SubjectChar last = static_cast<SubjectChar>(pattern[pattern_length - 1]);
+  while (i + kCharsPerWord - 1 <= n) {
+    uintptr_t candidates =
+        MatchingCharLanes(subject.start() + i, first) &
+        MatchingCharLanes(subject.start() + i + pattern_length - 1, last);
+    if (candidates != 0) {
+      for (int lane = 0; lane < kCharsPerWord; lane++) {
+        if (((candidates >> (lane * kCharBits + kCharBits - 1)) & 1) != 0 &&
+            CharCompare(pattern.start(),
+                        subject.start() + i + lane,
+                        pattern_length)) {
+          return i + lane;
+        }
+      }
+    }
+    i += kCharsPerWord;
+  }
+#endif
   while (i <= n) {
     if (sizeof(SubjectChar) == 1 && sizeof(PatternChar) == 1) {
       const SubjectChar* pos = reinterpret_cast<const SubjectChar*>(
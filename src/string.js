@@ -236,6 +236,7 @@ function StringReplace(search, replace) {
   // ...... non-global search
   // .. string search
   // .... special case that replaces with one single character
+  // .... string replace without $-expressions
   // ...... function replace
   // ...... string replace (with $-expansion)
 
@@ -306,6 +307,11 @@ function StringReplace(search, replace) {
     // replaced by a simple string and only pays off for long strings.
     return %StringReplaceOneCharWithString(subject, search, replace);
   }
+  if (IS_STRING(replace) && %StringIndexOf(replace, '$', 0) < 0) {
+    // Without $-expressions the result is simply assembled from the
+    // replacement and the parts of the subject around the match.
+    return %StringReplaceFirstWithString(subject, search, replace);
+  }
   var start = %StringIndexOf(subject, search, 0);
   if (start < 0) return subject;
   var end = start + search.length;
@@ -643,8 +649,6 @@ function StringSplit(separator, limit) {
 }
 
 
-var ArrayPushBuiltin = $Array.prototype.push;
-
 function StringSplitOnRegExp(subject, separator, limit, length) {
   %_Log('regexp', 'regexp-split,%0S,%1r', [subject, separator]);
 
@@ -655,54 +659,9 @@ function StringSplitOnRegExp(subject, separator, limit, length) {
     return [subject];
   }
 
-  var currentIndex = 0;
-  var startIndex = 0;
-  var startMatch = 0;
-  var result = [];
-
-  outer_loop:
-  while (true) {
-
-    if (startIndex === length) {
-      %_CallFunction(result, %_SubString(subject, currentIndex, length),
-                     ArrayPushBuiltin);
-      break;
-    }
-
-    var matchInfo = DoRegExpExec(separator, subject, startIndex);
-    if (matchInfo == null || length === (startMatch = matchInfo[CAPTURE0])) {
-      %_CallFunction(result, %_SubString(subject, currentIndex, length),
-                     ArrayPushBuiltin);
-      break;
-    }
-    var endIndex = matchInfo[CAPTURE1];
-
-    // We ignore a zero-length match at the currentIndex.
-    if (startIndex === endIndex && endIndex === currentIndex) {
-      startIndex++;
-      continue;
-    }
-
-    %_CallFunction(result, %_SubString(subject, currentIndex, startMatch),
-                   ArrayPushBuiltin);
-
-    if (result.length === limit) break;
-
-    var matchinfo_len = NUMBER_OF_CAPTURES(matchInfo) + REGEXP_FIRST_CAPTURE;
-    for (var i = REGEXP_FIRST_CAPTURE + 2; i < matchinfo_len; ) {
-      var start = matchInfo[i++];
-      var end = matchInfo[i++];
-      if (end != -1) {
-        %_CallFunction(result, %_SubString(subject, start, end),
-                       ArrayPushBuiltin);
-      } else {
-        %_CallFunction(result, UNDEFINED, ArrayPushBuiltin);
-      }
-      if (result.length === limit) break outer_loop;
-    }
-
-    startIndex = currentIndex = endIndex;
-  }
+  var result = %StringSplitRegExp(subject, separator, limit, lastMatchInfo);
+  if (result === null) return [subject];
+  lastMatchInfoOverride = null;
   return result;
 }
 
@@ -35,6 +35,11 @@ namespace internal {
 // contain a dot or a sign. It must not start with '0', and must not be empty.
 double Strtod(Vector<const char> buffer, int exponent);
 
+// Computes the double closest to significand * 10^exponent without
+// allocating or falling back to bignum arithmetic. Returns false if that is
+// not possible (which is rare); the caller must then use Strtod.
+bool FastStrtod(uint64_t significand, int exponent, double* result);
+
 } }  // namespace v8::internal
 
 #endif  // V8_STRTOD_H_
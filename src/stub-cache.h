@@ -268,9 +268,12 @@ class StubCache {
         reinterpret_cast<Address>(table) + offset * multiplier);
   }
 
-  static const int kPrimaryTableBits = 11;
+  // Sized for applications with thousands of receiver maps.  The probe
+  // stubs embed the masks as immediates, so the sizes are fixed at build
+  // time.
+  static const int kPrimaryTableBits = 12;
   static const int kPrimaryTableSize = (1 << kPrimaryTableBits);
-  static const int kSecondaryTableBits = 9;
+  static const int kSecondaryTableBits = 10;
   static const int kSecondaryTableSize = (1 << kSecondaryTableBits);
 
   Entry primary_[kPrimaryTableSize];
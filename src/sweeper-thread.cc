@@ -44,7 +44,8 @@ SweeperThread::SweeperThread(Isolate* isolate)
        collector_(heap_->mark_compact_collector()),
        start_sweeping_semaphore_(0),
        end_sweeping_semaphore_(0),
-       stop_semaphore_(0) {
+       stop_semaphore_(0),
+       started_(false) {
   ASSERT(!FLAG_job_based_sweeping);
   NoBarrier_Store(&stop_thread_, static_cast<AtomicWord>(false));
 }
@@ -72,6 +73,7 @@ void SweeperThread::Run() {
 
 
 void SweeperThread::Stop() {
+  if (!started_) return;
   Release_Store(&stop_thread_, static_cast<AtomicWord>(true));
   start_sweeping_semaphore_.Signal();
   stop_semaphore_.Wait();
@@ -80,6 +82,10 @@ void SweeperThread::Stop() {
 
 
 void SweeperThread::StartSweeping() {
+  if (!started_) {
+    started_ = true;
+    Start();
+  }
   start_sweeping_semaphore_.Signal();
 }
 
@@ -47,6 +47,8 @@ class SweeperThread : public Thread {
 
   void Run();
   void Stop();
+  // Starts the thread on first use, so that isolates that never sweep
+  // concurrently do not pay for it.
   void StartSweeping();
   void WaitForSweeperThread();
 
@@ -60,6 +62,7 @@ class SweeperThread : public Thread {
   Semaphore end_sweeping_semaphore_;
   Semaphore stop_semaphore_;
   volatile AtomicWord stop_thread_;
+  bool started_;
 };
 
 } }  // namespace v8::internal
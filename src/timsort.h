@@ -0,0 +1,505 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_TIMSORT_H_
+#define V8_TIMSORT_H_
+
+#include "allocation.h"
+#include "platform.h"
+
+namespace v8 {
+namespace internal {
+
+
+// A stable, adaptive merge sort following Tim Peters' listsort for CPython.
+// Ascending and strictly descending runs already present in the input are
+// found and extended to a minimum length with binary insertion sort, then
+// merged pairwise.  When one run keeps winning during a merge, the merge
+// switches to galloping, so partially sorted input takes close to linear
+// time.  T must be copyable with memcpy; Less is a strict weak order
+// callable as less(const T&, const T&).
+template <typename T, typename Less>
+class TimSort {
+ public:
+  static void Sort(T* array, int length, Less less) {
+    if (length < 2) return;
+    if (length < kMinMerge) {
+      TimSort sorter(array, less);
+      int run = sorter.CountRunAndMakeAscending(0, length);
+      sorter.BinaryInsertionSort(0, length, run);
+      return;
+    }
+    TimSort sorter(array, less);
+    int min_run = MinRunLength(length);
+    int low = 0;
+    int remaining = length;
+    do {
+      int run = sorter.CountRunAndMakeAscending(low, low + remaining);
+      if (run < min_run) {
+        int forced = Min(remaining, min_run);
+        sorter.BinaryInsertionSort(low, low + forced, low + run);
+        run = forced;
+      }
+      sorter.PushRun(low, run);
+      sorter.MergeCollapse();
+      low += run;
+      remaining -= run;
+    } while (remaining != 0);
+    sorter.MergeForceCollapse();
+    ASSERT(sorter.stack_size_ == 1 && sorter.run_length_[0] == length);
+  }
+
+ private:
+  // Arrays shorter than this are sorted with binary insertion sort alone.
+  static const int kMinMerge = 32;
+  // Number of consecutive wins after which a merge starts galloping.
+  static const int kMinGallop = 7;
+  // Enough for any int length given the run length invariants.
+  static const int kMaxStackSize = 85;
+
+  TimSort(T* array, Less less)
+      : array_(array),
+        less_(less),
+        min_gallop_(kMinGallop),
+        buffer_(NULL),
+        buffer_length_(0),
+        stack_size_(0) { }
+
+  ~TimSort() {
+    if (buffer_ != NULL) DeleteArray(buffer_);
+  }
+
+  static int MinRunLength(int n) {
+    int low_bits = 0;
+    while (n >= kMinMerge) {
+      low_bits |= n & 1;
+      n >>= 1;
+    }
+    return n + low_bits;
+  }
+
+  static void Move(T* to, const T* from, int count) {
+    OS::MemMove(to, from, count * sizeof(T));
+  }
+
+  T* EnsureBuffer(int length) {
+    if (buffer_length_ < length) {
+      if (buffer_ != NULL) DeleteArray(buffer_);
+      buffer_length_ = Max(length, buffer_length_ * 2);
+      buffer_ = NewArray<T>(buffer_length_);
+    }
+    return buffer_;
+  }
+
+  // Sorts array_[low, high) given that array_[low, start) is sorted.
+  void BinaryInsertionSort(int low, int high, int start) {
+    if (start == low) start++;
+    for (; start < high; start++) {
+      T pivot = array_[start];
+      int left = low;
+      int right = start;
+      while (left < right) {
+        int mid = left + ((right - left) >> 1);
+        if (less_(pivot, array_[mid])) {
+          right = mid;
+        } else {
+          left = mid + 1;
+        }
+      }
+      Move(&array_[left + 1], &array_[left], start - left);
+      array_[left] = pivot;
+    }
+  }
+
+  // Returns the length of the run starting at low, reversing it in place
+  // if it is strictly descending.
+  int CountRunAndMakeAscending(int low, int high) {
+    int run_high = low + 1;
+    if (run_high == high) return 1;
+    if (less_(array_[run_high++], array_[low])) {
+      while (run_high < high && less_(array_[run_high], array_[run_high - 1])) {
+        run_high++;
+      }
+      for (int i = low, j = run_high - 1; i < j; i++, j--) {
+        T tmp = array_[i];
+        array_[i] = array_[j];
+        array_[j] = tmp;
+      }
+    } else {
+      while (run_high < high &&
+             !less_(array_[run_high], array_[run_high - 1])) {
+        run_high++;
+      }
+    }
+    return run_high - low;
+  }
+
+  void PushRun(int base, int length) {
+    ASSERT(stack_size_ < kMaxStackSize);
+    run_base_[stack_size_] = base;
+    run_length_[stack_size_] = length;
+    stack_size_++;
+  }
+
+  // Merges runs until the lengths on the stack decrease faster than the
+  // Fibonacci numbers, which bounds the stack depth.
+  void MergeCollapse() {
+    while (stack_size_ > 1) {
+      int n = stack_size_ - 2;
+      if ((n > 0 &&
+           run_length_[n - 1] <= run_length_[n] + run_length_[n + 1]) ||
+          (n > 1 &&
+           run_length_[n - 2] <= run_length_[n - 1] + run_length_[n])) {
+        if (run_length_[n - 1] < run_length_[n + 1]) n--;
+      } else if (run_length_[n] > run_length_[n + 1]) {
+        break;
+      }
+      MergeAt(n);
+    }
+  }
+
+  void MergeForceCollapse() {
+    while (stack_size_ > 1) {
+      int n = stack_size_ - 2;
+      if (n > 0 && run_length_[n - 1] < run_length_[n + 1]) n--;
+      MergeAt(n);
+    }
+  }
+
+  // Merges the runs at stack positions i and i + 1.
+  void MergeAt(int i) {
+    int base1 = run_base_[i];
+    int length1 = run_length_[i];
+    int base2 = run_base_[i + 1];
+    int length2 = run_length_[i + 1];
+    ASSERT(base1 + length1 == base2);
+    run_length_[i] = length1 + length2;
+    if (i == stack_size_ - 3) {
+      run_base_[i + 1] = run_base_[i + 2];
+      run_length_[i + 1] = run_length_[i + 2];
+    }
+    stack_size_--;
+
+    // Elements of the first run that precede the second run are in place,
+    // and so are elements of the second run that follow the first run.
+    int k = GallopRight(array_[base2], array_, base1, length1, 0);
+    base1 += k;
+    length1 -= k;
+    if (length1 == 0) return;
+    length2 = GallopLeft(
+        array_[base1 + length1 - 1], array_, base2, length2, length2 - 1);
+    if (length2 == 0) return;
+
+    if (length1 <= length2) {
+      MergeLow(base1, length1, base2, length2);
+    } else {
+      MergeHigh(base1, length1, base2, length2);
+    }
+  }
+
+  // Returns the position in the sorted range a[base, base + length) at
+  // which key would be inserted before all equal elements, searching
+  // outwards from a[base + hint].
+  int GallopLeft(const T& key, T* a, int base, int length, int hint) {
+    int last_offset = 0;
+    int offset = 1;
+    if (less_(a[base + hint], key)) {
+      int max_offset = length - hint;
+      while (offset < max_offset && less_(a[base + hint + offset], key)) {
+        last_offset = offset;
+        offset = (offset << 1) + 1;
+        if (offset <= 0) offset = max_offset;
+      }
+      if (offset > max_offset) offset = max_offset;
+      last_offset += hint;
+      offset += hint;
+    } else {
+      int max_offset = hint + 1;
+      while (offset < max_offset && !less_(a[base + hint - offset], key)) {
+        last_offset = offset;
+        offset = (offset << 1) + 1;
+        if (offset <= 0) offset = max_offset;
+      }
+      if (offset > max_offset) offset = max_offset;
+      int tmp = last_offset;
+      last_offset = hint - offset;
+      offset = hint - tmp;
+    }
+    last_offset++;
+    while (last_offset < offset) {
+      int mid = last_offset + ((offset - last_offset) >> 1);
+      if (less_(a[base + mid], key)) {
+        last_offset = mid + 1;
+      } else {
+        offset = mid;
+      }
+    }
+    return offset;
+  }
+
+  // Like GallopLeft, but inserts after all elements equal to key.
+  int GallopRight(const T& key, T* a, int base, int length, int hint) {
+    int last_offset = 0;
+    int offset = 1;
+    if (less_(key, a[base + hint])) {
+      int max_offset = hint + 1;
+      while (offset < max_offset && less_(key, a[base + hint - offset])) {
+        last_offset = offset;
+        offset = (offset << 1) + 1;
+        if (offset <= 0) offset = max_offset;
+      }
+      if (offset > max_offset) offset = max_offset;
+      int tmp = last_offset;
+      last_offset = hint - offset;
+      offset = hint - tmp;
+    } else {
+      int max_offset = length - hint;
+      while (offset < max_offset && !less_(key, a[base + hint + offset])) {
+        last_offset = offset;
+        offset = (offset << 1) + 1;
+        if (offset <= 0) offset = max_offset;
+      }
+      if (offset > max_offset) offset = max_offset;
+      last_offset += hint;
+      offset += hint;
+    }
+    last_offset++;
+    while (last_offset < offset) {
+      int mid = last_offset + ((offset - last_offset) >> 1);
+      if (less_(key, a[base + mid])) {
+        offset = mid;
+      } else {
+        last_offset = mid + 1;
+      }
+    }
+    return offset;
+  }
+
+  // Merges adjacent runs, copying the shorter first run out of the way.
+  // The first element of the second run belongs before the first run and
+  // the last element of the first run belongs after the second run.
+  void MergeLow(int base1, int length1, int base2, int length2) {
+    T* tmp = EnsureBuffer(length1);
+    Move(tmp, &array_[base1], length1);
+    int cursor1 = 0;
+    int cursor2 = base2;
+    int dest = base1;
+
+    array_[dest++] = array_[cursor2++];
+    if (--length2 == 0) {
+      Move(&array_[dest], &tmp[cursor1], length1);
+      return;
+    }
+    if (length1 == 1) {
+      Move(&array_[dest], &array_[cursor2], length2);
+      array_[dest + length2] = tmp[cursor1];
+      return;
+    }
+
+    int min_gallop = min_gallop_;
+    while (true) {
+      int count1 = 0;  // Consecutive wins of the first run.
+      int count2 = 0;  // Consecutive wins of the second run.
+      bool done = false;
+      do {
+        if (less_(array_[cursor2], tmp[cursor1])) {
+          array_[dest++] = array_[cursor2++];
+          count2++;
+          count1 = 0;
+          if (--length2 == 0) done = true;
+        } else {
+          array_[dest++] = tmp[cursor1++];
+          count1++;
+          count2 = 0;
+          if (--length1 == 1) done = true;
+        }
+      } while (!done && (count1 | count2) < min_gallop);
+      if (done) break;
+
+      do {
+        count1 = GallopRight(array_[cursor2], tmp, cursor1, length1, 0);
+        if (count1 != 0) {
+          Move(&array_[dest], &tmp[cursor1], count1);
+          dest += count1;
+          cursor1 += count1;
+          length1 -= count1;
+          if (length1 <= 1) {
+            done = true;
+            break;
+          }
+        }
+        array_[dest++] = array_[cursor2++];
+        if (--length2 == 0) {
+          done = true;
+          break;
+        }
+        count2 = GallopLeft(tmp[cursor1], array_, cursor2, length2, 0);
+        if (count2 != 0) {
+          Move(&array_[dest], &array_[cursor2], count2);
+          dest += count2;
+          cursor2 += count2;
+          length2 -= count2;
+          if (length2 == 0) {
+            done = true;
+            break;
+          }
+        }
+        array_[dest++] = tmp[cursor1++];
+        if (--length1 == 1) {
+          done = true;
+          break;
+        }
+        min_gallop--;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+      if (done) break;
+      if (min_gallop < 0) min_gallop = 0;
+      min_gallop += 2;  // Penalize leaving galloping mode.
+    }
+    min_gallop_ = Max(min_gallop, 1);
+
+    if (length1 == 1) {
+      ASSERT(length2 > 0);
+      Move(&array_[dest], &array_[cursor2], length2);
+      array_[dest + length2] = tmp[cursor1];
+    } else {
+      ASSERT(length2 == 0 && length1 > 1);
+      Move(&array_[dest], &tmp[cursor1], length1);
+    }
+  }
+
+  // Mirror image of MergeLow that copies the shorter second run out of the
+  // way and merges from the end.
+  void MergeHigh(int base1, int length1, int base2, int length2) {
+    T* tmp = EnsureBuffer(length2);
+    Move(tmp, &array_[base2], length2);
+    int cursor1 = base1 + length1 - 1;
+    int cursor2 = length2 - 1;
+    int dest = base2 + length2 - 1;
+
+    array_[dest--] = array_[cursor1--];
+    if (--length1 == 0) {
+      Move(&array_[dest - (length2 - 1)], tmp, length2);
+      return;
+    }
+    if (length2 == 1) {
+      dest -= length1;
+      cursor1 -= length1;
+      Move(&array_[dest + 1], &array_[cursor1 + 1], length1);
+      array_[dest] = tmp[cursor2];
+      return;
+    }
+
+    int min_gallop = min_gallop_;
+    while (true) {
+      int count1 = 0;  // Consecutive wins of the first run.
+      int count2 = 0;  // Consecutive wins of the second run.
+      bool done = false;
+      do {
+        if (less_(tmp[cursor2], array_[cursor1])) {
+          array_[dest--] = array_[cursor1--];
+          count1++;
+          count2 = 0;
+          if (--length1 == 0) done = true;
+        } else {
+          array_[dest--] = tmp[cursor2--];
+          count2++;
+          count1 = 0;
+          if (--length2 == 1) done = true;
+        }
+      } while (!done && (count1 | count2) < min_gallop);
+      if (done) break;
+
+      do {
+        count1 = length1 -
+            GallopRight(tmp[cursor2], array_, base1, length1, length1 - 1);
+        if (count1 != 0) {
+          dest -= count1;
+          cursor1 -= count1;
+          length1 -= count1;
+          Move(&array_[dest + 1], &array_[cursor1 + 1], count1);
+          if (length1 == 0) {
+            done = true;
+            break;
+          }
+        }
+        array_[dest--] = tmp[cursor2--];
+        if (--length2 == 1) {
+          done = true;
+          break;
+        }
+        count2 = length2 -
+            GallopLeft(array_[cursor1], tmp, 0, length2, length2 - 1);
+        if (count2 != 0) {
+          dest -= count2;
+          cursor2 -= count2;
+          length2 -= count2;
+          Move(&array_[dest + 1], &tmp[cursor2 + 1], count2);
+          if (length2 <= 1) {
+            done = true;
+            break;
+          }
+        }
+        array_[dest--] = array_[cursor1--];
+        if (--length1 == 0) {
+          done = true;
+          break;
+        }
+        min_gallop--;
+      } while (count1 >= kMinGallop || count2 >= kMinGallop);
+      if (done) break;
+      if (min_gallop < 0) min_gallop = 0;
+      min_gallop += 2;  // Penalize leaving galloping mode.
+    }
+    min_gallop_ = Max(min_gallop, 1);
+
+    if (length2 == 1) {
+      ASSERT(length1 > 0);
+      dest -= length1;
+      cursor1 -= length1;
+      Move(&array_[dest + 1], &array_[cursor1 + 1], length1);
+      array_[dest] = tmp[cursor2];
+    } else {
+      ASSERT(length1 == 0 && length2 > 0);
+      Move(&array_[dest - (length2 - 1)], tmp, length2);
+    }
+  }
+
+  T* array_;
+  Less less_;
+  int min_gallop_;
+  T* buffer_;
+  int buffer_length_;
+  int stack_size_;
+  int run_base_[kMaxStackSize];
+  int run_length_[kMaxStackSize];
+
+  DISALLOW_COPY_AND_ASSIGN(TimSort);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_TIMSORT_H_
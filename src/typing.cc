@@ -530,9 +530,10 @@ void AstTyper::VisitProperty(Property* expr) {
 void AstTyper::VisitCall(Call* expr) {
   // Collect type feedback.
   RECURSE(Visit(expr->expression()));
-  if (!expr->expression()->IsProperty() &&
-      expr->HasCallFeedbackSlot() &&
+  if (expr->HasCallFeedbackSlot() &&
       oracle()->CallIsMonomorphic(expr->CallFeedbackSlot())) {
+    // For property calls this is only a hint; Call::IsMonomorphic still
+    // reflects the feedback of the property load.
     expr->set_target(oracle()->GetCallTarget(expr->CallFeedbackSlot()));
   }
 
@@ -36,70 +36,89 @@ namespace v8 {
 namespace internal {
 
 template<typename Record>
-struct UnboundQueue<Record>::Node: public Malloced {
-  explicit Node(const Record& value)
-      : value(value), next(NULL) {
-  }
+struct UnboundQueue<Record>::Chunk: public Malloced {
+  Chunk() : count(0), next(0) {}
 
-  Record value;
-  Node* next;
+  Record records[kChunkCapacity];
+  Atomic32 count;   // Number of records published to the consumer.
+  AtomicWord next;  // Chunk*
 };
 
 
 template<typename Record>
 UnboundQueue<Record>::UnboundQueue() {
-  first_ = new Node(Record());
-  divider_ = last_ = reinterpret_cast<AtomicWord>(first_);
+  first_ = last_ = new Chunk();
+  first_index_ = 0;
 }
 
 
 template<typename Record>
 UnboundQueue<Record>::~UnboundQueue() {
-  while (first_ != NULL) DeleteFirst();
+  while (first_ != NULL) {
+    Chunk* next = reinterpret_cast<Chunk*>(first_->next);
+    delete first_;
+    first_ = next;
+  }
 }
 
 
 template<typename Record>
-void UnboundQueue<Record>::DeleteFirst() {
-  Node* tmp = first_;
-  first_ = tmp->next;
-  delete tmp;
+void UnboundQueue<Record>::Advance() {
+  if (first_index_ < kChunkCapacity) {
+    first_index_++;
+    return;
+  }
+  // The record just read was the first one of the next chunk. The producer
+  // does not touch the exhausted chunk after linking its successor.
+  Chunk* next = reinterpret_cast<Chunk*>(NoBarrier_Load(&first_->next));
+  delete first_;
+  first_ = next;
+  first_index_ = 1;
 }
 
 
 template<typename Record>
 bool UnboundQueue<Record>::Dequeue(Record* rec) {
-  if (divider_ == Acquire_Load(&last_)) return false;
-  Node* next = reinterpret_cast<Node*>(divider_)->next;
-  *rec = next->value;
-  Release_Store(&divider_, reinterpret_cast<AtomicWord>(next));
+  Record* next = Peek();
+  if (next == NULL) return false;
+  *rec = *next;
+  Advance();
   return true;
 }
 
 
 template<typename Record>
 void UnboundQueue<Record>::Enqueue(const Record& rec) {
-  Node*& next = reinterpret_cast<Node*>(last_)->next;
-  next = new Node(rec);
-  Release_Store(&last_, reinterpret_cast<AtomicWord>(next));
-
-  while (first_ != reinterpret_cast<Node*>(Acquire_Load(&divider_))) {
-    DeleteFirst();
+  Chunk* chunk = last_;
+  Atomic32 count = NoBarrier_Load(&chunk->count);
+  if (count < kChunkCapacity) {
+    chunk->records[count] = rec;
+    Release_Store(&chunk->count, count + 1);
+    return;
   }
+  Chunk* next = new Chunk();
+  next->records[0] = rec;
+  next->count = 1;
+  Release_Store(&chunk->next, reinterpret_cast<AtomicWord>(next));
+  last_ = next;
 }
 
 
 template<typename Record>
 bool UnboundQueue<Record>::IsEmpty() const {
-  return NoBarrier_Load(&divider_) == NoBarrier_Load(&last_);
+  return Peek() == NULL;
 }
 
 
 template<typename Record>
 Record* UnboundQueue<Record>::Peek() const {
-  if (divider_ == Acquire_Load(&last_)) return NULL;
-  Node* next = reinterpret_cast<Node*>(divider_)->next;
-  return &next->value;
+  Chunk* chunk = first_;
+  if (first_index_ < Acquire_Load(&chunk->count)) {
+    return &chunk->records[first_index_];
+  }
+  if (first_index_ < kChunkCapacity) return NULL;
+  Chunk* next = reinterpret_cast<Chunk*>(Acquire_Load(&chunk->next));
+  return next == NULL ? NULL : &next->records[0];
 }
 
 } }  // namespace v8::internal
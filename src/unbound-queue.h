@@ -40,6 +40,9 @@ namespace internal {
 // elements, so producer never blocks.  Implemented after Herb
 // Sutter's article:
 // http://www.ddj.com/high-performance-computing/210604448
+// Records are stored in chunks of about kChunkSize bytes, so that the
+// producer allocates once per chunk rather than once per record. The
+// consumer releases the chunks it has exhausted.
 template<typename Record>
 class UnboundQueue BASE_EMBEDDED {
  public:
@@ -52,13 +55,18 @@ class UnboundQueue BASE_EMBEDDED {
   INLINE(Record* Peek() const);
 
  private:
-  INLINE(void DeleteFirst());
+  static const int kChunkSize = 4 * KB;
+  static const int kChunkCapacity =
+      sizeof(Record) < kChunkSize
+          ? static_cast<int>(kChunkSize / sizeof(Record)) : 1;
 
-  struct Node;
+  INLINE(void Advance());
 
-  Node* first_;
-  AtomicWord divider_;  // Node*
-  AtomicWord last_;     // Node*
+  struct Chunk;
+
+  Chunk* first_;     // Owned by the consumer.
+  int first_index_;  // Index of the next record to read from first_.
+  Chunk* last_;      // Owned by the producer.
 
   DISALLOW_COPY_AND_ASSIGN(UnboundQueue);
 };
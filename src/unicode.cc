@@ -281,6 +281,22 @@ uchar Utf8::CalculateValue(const byte* str,
 }
 
 
+// Returns the number of leading bytes of |stream| that are ASCII, checking
+// eight bytes at a time.
+static inline unsigned AsciiPrefixLength(const uint8_t* stream,
+                                         unsigned length) {
+  unsigned i = 0;
+  while (i + 8 <= length) {
+    uint8_t bits = stream[i] | stream[i + 1] | stream[i + 2] | stream[i + 3] |
+        stream[i + 4] | stream[i + 5] | stream[i + 6] | stream[i + 7];
+    if (bits > Utf8::kMaxOneByteChar) break;
+    i += 8;
+  }
+  while (i < length && stream[i] <= Utf8::kMaxOneByteChar) i++;
+  return i;
+}
+
+
 void Utf8DecoderBase::Reset(uint16_t* buffer,
                             unsigned buffer_length,
                             const uint8_t* stream,
@@ -292,6 +308,25 @@ void Utf8DecoderBase::Reset(uint16_t* buffer,
   // Loop until stream is read, writing to buffer as long as buffer has space.
   unsigned utf16_length = 0;
   while (stream_length != 0) {
+    if (*stream <= Utf8::kMaxOneByteChar) {
+      // Each ASCII byte is one UTF-16 code unit.
+      unsigned ascii_length = AsciiPrefixLength(stream, stream_length);
+      stream_length -= ascii_length;
+      if (writing_to_buffer) {
+        unsigned buffered = buffer_length - utf16_length;
+        if (buffered > ascii_length) buffered = ascii_length;
+        for (unsigned i = 0; i < buffered; i++) *buffer++ = *stream++;
+        utf16_length += buffered;
+        ascii_length -= buffered;
+        if (utf16_length == buffer_length) {
+          writing_to_buffer = false;
+          unbuffered_start_ = stream;
+        }
+      }
+      stream += ascii_length;
+      utf16_length += ascii_length;
+      continue;
+    }
     unsigned cursor = 0;
     uint32_t character = Utf8::ValueOf(stream, stream_length, &cursor);
     ASSERT(cursor > 0 && cursor <= stream_length);
@@ -332,6 +367,13 @@ void Utf8DecoderBase::WriteUtf16Slow(const uint8_t* stream,
                                      uint16_t* data,
                                      unsigned data_length) {
   while (data_length != 0) {
+    if (*stream <= Utf8::kMaxOneByteChar) {
+      // The stream holds at least one byte per remaining code unit.
+      unsigned ascii_length = AsciiPrefixLength(stream, data_length);
+      for (unsigned i = 0; i < ascii_length; i++) *data++ = *stream++;
+      data_length -= ascii_length;
+      continue;
+    }
     unsigned cursor = 0;
     uint32_t character = Utf8::ValueOf(stream, Utf8::kMaxEncodedSize, &cursor);
     // There's a total lack of bounds checking for stream
@@ -77,6 +77,8 @@ class URIUnescape : public AllStatic {
                                  int i,
                                  int length,
                                  int* step));
+
+  friend class URICodec;
 };
 
 
@@ -207,6 +209,8 @@ class URIEscape : public AllStatic {
   static const char kNotEscaped[256];
 
   static bool IsNotEscaped(uint16_t c) { return kNotEscaped[c] != 0; }
+
+  friend class URICodec;
 };
 
 
@@ -304,6 +308,168 @@ Handle<String> URIEscape::Escape(Isolate* isolate, Handle<String> string) {
   return dest;
 }
 
+
+// Fast paths for encodeURI, encodeURIComponent, decodeURI and
+// decodeURIComponent on one-byte strings.  They return a null handle when
+// the input needs the general implementation in uri.js, which also reports
+// malformed URIs.
+class URICodec : public AllStatic {
+ public:
+  static Handle<String> EncodeOneByte(Isolate* isolate,
+                                      Handle<String> string,
+                                      bool component);
+  static Handle<String> DecodeOneByte(Isolate* isolate,
+                                      Handle<String> string,
+                                      bool component);
+
+ private:
+  enum CharacterFlag {
+    kUnescapedInComponent = 1,
+    kUnescapedInURI = 2,
+    kReservedInURI = 4
+  };
+
+  static const char kCharacterFlags[128];
+
+  static bool HasFlag(int c, int flag) {
+    return c < 128 && (kCharacterFlags[c] & flag) != 0;
+  }
+
+  static uint8_t* AddEncodedOctet(uint8_t* out, int octet) {
+    out[0] = '%';
+    out[1] = URIEscape::kHexChars[octet >> 4];
+    out[2] = URIEscape::kHexChars[octet & 0xf];
+    return out + 3;
+  }
+};
+
+
+// Unescaped in components: A-Z a-z 0-9 ! ' ( ) * - . _ ~
+// Unescaped in URIs: the above and the reserved characters.
+// Reserved in URIs: # $ & + , / : ; = ? @
+const char URICodec::kCharacterFlags[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 3, 0, 6, 6, 0, 6, 3, 3, 3, 3, 6, 6, 3, 3, 6,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 6, 6, 0, 6, 0, 6,
+    6, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 3,
+    0, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 3, 0 };
+
+
+Handle<String> URICodec::EncodeOneByte(Isolate* isolate,
+                                       Handle<String> string,
+                                       bool component) {
+  ASSERT(string->IsFlat());
+  int unescaped = component ? kUnescapedInComponent : kUnescapedInURI;
+  int length = string->length();
+  int prefix_length = 0;
+  int encoded_length = 0;
+
+  { DisallowHeapAllocation no_allocation;
+    Vector<const uint8_t> vector = GetCharVector<uint8_t>(string);
+    // Most of a typical URI is left alone, so find the first character
+    // that needs escaping before counting.
+    while (prefix_length < length &&
+           HasFlag(vector[prefix_length], unescaped)) {
+      prefix_length++;
+    }
+    if (prefix_length == length) return string;
+
+    encoded_length = prefix_length;
+    for (int i = prefix_length; i < length; i++) {
+      int c = vector[i];
+      if (HasFlag(c, unescaped)) {
+        encoded_length++;
+      } else {
+        // Characters above 0x7f take two UTF-8 octets.
+        encoded_length += c <= 0x7f ? 3 : 6;
+      }
+      if (encoded_length > String::kMaxLength) return Handle<String>::null();
+    }
+  }
+
+  Handle<SeqOneByteString> dest =
+      isolate->factory()->NewRawOneByteString(encoded_length);
+  DisallowHeapAllocation no_allocation;
+  Vector<const uint8_t> vector = GetCharVector<uint8_t>(string);
+  uint8_t* out = dest->GetChars();
+  OS::MemCopy(out, vector.start(), prefix_length);
+  out += prefix_length;
+  for (int i = prefix_length; i < length; i++) {
+    int c = vector[i];
+    if (HasFlag(c, unescaped)) {
+      *out++ = c;
+    } else if (c <= 0x7f) {
+      out = AddEncodedOctet(out, c);
+    } else {
+      out = AddEncodedOctet(out, 0xc0 | (c >> 6));
+      out = AddEncodedOctet(out, 0x80 | (c & 0x3f));
+    }
+  }
+  ASSERT(out == dest->GetChars() + encoded_length);
+  return dest;
+}
+
+
+Handle<String> URICodec::DecodeOneByte(Isolate* isolate,
+                                       Handle<String> string,
+                                       bool component) {
+  ASSERT(string->IsFlat());
+  int reserved = component ? 0 : kReservedInURI;
+  int length = string->length();
+  int prefix_length;
+  int decoded_length;
+
+  { DisallowHeapAllocation no_allocation;
+    Vector<const uint8_t> vector = GetCharVector<uint8_t>(string);
+    StringSearch<uint8_t, uint8_t> search(isolate, STATIC_ASCII_VECTOR("%"));
+    prefix_length = search.Search(vector, 0);
+    if (prefix_length < 0) return string;
+
+    decoded_length = prefix_length;
+    for (int i = prefix_length; i < length; decoded_length++) {
+      if (vector[i] != '%') {
+        i++;
+        continue;
+      }
+      if (i + 2 >= length) return Handle<String>::null();
+      int c = URIUnescape::TwoDigitHex(vector[i + 1], vector[i + 2]);
+      // Invalid escapes and multi-octet UTF-8 sequences are left to the
+      // general implementation.
+      if (c < 0 || c > 0x7f) return Handle<String>::null();
+      // Escaped reserved characters are kept as they are.
+      if (HasFlag(c, reserved)) decoded_length += 2;
+      i += 3;
+    }
+  }
+
+  Handle<SeqOneByteString> dest =
+      isolate->factory()->NewRawOneByteString(decoded_length);
+  DisallowHeapAllocation no_allocation;
+  Vector<const uint8_t> vector = GetCharVector<uint8_t>(string);
+  uint8_t* out = dest->GetChars();
+  OS::MemCopy(out, vector.start(), prefix_length);
+  out += prefix_length;
+  for (int i = prefix_length; i < length;) {
+    if (vector[i] != '%') {
+      *out++ = vector[i++];
+      continue;
+    }
+    int c = URIUnescape::TwoDigitHex(vector[i + 1], vector[i + 2]);
+    if (HasFlag(c, reserved)) {
+      OS::MemCopy(out, vector.start() + i, 3);
+      out += 3;
+    } else {
+      *out++ = c;
+    }
+    i += 3;
+  }
+  ASSERT(out == dest->GetChars() + decoded_length);
+  return dest;
+}
+
 } }  // namespace v8::internal
 
 #endif  // V8_URI_H_
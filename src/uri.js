@@ -282,6 +282,9 @@ function Decode(uri, reserved) {
 
 // ECMA-262 - 15.1.3.1.
 function URIDecode(uri) {
+  var string = ToString(uri);
+  var result = %URIDecode(string, false);
+  if (!IS_UNDEFINED(result)) return result;
   var reservedPredicate = function(cc) {
     // #$
     if (35 <= cc && cc <= 36) return true;
@@ -300,15 +303,16 @@ function URIDecode(uri) {
 
     return false;
   };
-  var string = ToString(uri);
   return Decode(string, reservedPredicate);
 }
 
 
 // ECMA-262 - 15.1.3.2.
 function URIDecodeComponent(component) {
-  var reservedPredicate = function(cc) { return false; };
   var string = ToString(component);
+  var result = %URIDecode(string, true);
+  if (!IS_UNDEFINED(result)) return result;
+  var reservedPredicate = function(cc) { return false; };
   return Decode(string, reservedPredicate);
 }
 
@@ -328,6 +332,9 @@ function isAlphaNumeric(cc) {
 
 // ECMA-262 - 15.1.3.3.
 function URIEncode(uri) {
+  var string = ToString(uri);
+  var result = %URIEncode(string, false);
+  if (!IS_UNDEFINED(result)) return result;
   var unescapePredicate = function(cc) {
     if (isAlphaNumeric(cc)) return true;
     // !
@@ -350,13 +357,15 @@ function URIEncode(uri) {
     return false;
   };
 
-  var string = ToString(uri);
   return Encode(string, unescapePredicate);
 }
 
 
 // ECMA-262 - 15.1.3.4
 function URIEncodeComponent(component) {
+  var string = ToString(component);
+  var result = %URIEncode(string, true);
+  if (!IS_UNDEFINED(result)) return result;
   var unescapePredicate = function(cc) {
     if (isAlphaNumeric(cc)) return true;
     // !
@@ -373,7 +382,6 @@ function URIEncodeComponent(component) {
     return false;
   };
 
-  var string = ToString(component);
   return Encode(string, unescapePredicate);
 }
 
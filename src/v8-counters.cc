@@ -38,6 +38,11 @@ Counters::Counters(Isolate* isolate) {
     HISTOGRAM_TIMER_LIST(HT)
 #undef HT
 
+#define HR(name, caption, min, max, num_buckets) \
+    name##_ = Histogram(#caption, min, max, num_buckets, isolate);
+    HISTOGRAM_RANGE_LIST(HR)
+#undef HR
+
 #define HP(name, caption) \
     name##_ = Histogram(#caption, 0, 101, 100, isolate);
     HISTOGRAM_PERCENTAGE_LIST(HP)
@@ -92,6 +97,10 @@ void Counters::ResetHistograms() {
     HISTOGRAM_TIMER_LIST(HT)
 #undef HT
 
+#define HR(name, caption, min, max, num_buckets) name##_.Reset();
+    HISTOGRAM_RANGE_LIST(HR)
+#undef HR
+
 #define HP(name, caption) name##_.Reset();
     HISTOGRAM_PERCENTAGE_LIST(HP)
 #undef HP
@@ -50,6 +50,17 @@ namespace internal {
   HT(compile_eval, V8.CompileEval)                                    \
   HT(compile_lazy, V8.CompileLazy)
 
+#define HISTOGRAM_RANGE_LIST(HR)                                      \
+  /* Tier-up latencies in milliseconds, measured from the */          \
+  /* generation of a function's unoptimized code. */                  \
+  HR(optimization_decision_latency, V8.OptimizationDecisionLatency,   \
+     0, 100000, 50)                                                   \
+  HR(time_to_optimization, V8.TimeToOptimization, 0, 100000, 50)      \
+  /* Concurrent recompilation latencies in milliseconds. */           \
+  HR(optimization_queue_wait, V8.OptimizationQueueWait, 0, 10000, 50) \
+  HR(optimization_install_delay, V8.OptimizationInstallDelay,         \
+     0, 10000, 50)
+
 #define HISTOGRAM_PERCENTAGE_LIST(HP)                                 \
   /* Heap fragmentation. */                                           \
   HP(external_fragmentation_total,                                    \
@@ -131,6 +142,27 @@ namespace internal {
   SC(arguments_adaptors, V8.ArgumentsAdaptors)                        \
   SC(compilation_cache_hits, V8.CompilationCacheHits)                 \
   SC(compilation_cache_misses, V8.CompilationCacheMisses)             \
+  SC(regexp_cache_hits, V8.RegExpCacheHits)                           \
+  SC(regexp_cache_misses, V8.RegExpCacheMisses)                       \
+  /* Regexp cache hits that only the retained entries could serve. */ \
+  SC(regexp_cache_retained_hits, V8.RegExpCacheRetainedHits)          \
+  SC(script_cache_hits, V8.ScriptCacheHits)                           \
+  SC(script_cache_misses, V8.ScriptCacheMisses)                       \
+  /* Script cache hits that only the retained entries could serve. */ \
+  SC(script_cache_retained_hits, V8.ScriptCacheRetainedHits)          \
+  SC(script_cache_evictions, V8.ScriptCacheEvictions)                 \
+  /* Eval cache statistics only count global eval and new Function.  */ \
+  SC(eval_cache_hits, V8.EvalCacheHits)                               \
+  SC(eval_cache_misses, V8.EvalCacheMisses)                           \
+  SC(eval_cache_retained_hits, V8.EvalCacheRetainedHits)              \
+  SC(eval_cache_evictions, V8.EvalCacheEvictions)                     \
+  /* Unoptimized code thrown away by code flushing, and recompiled  */ \
+  /* for functions whose code was flushed before.                   */ \
+  SC(code_flushing_functions_flushed, V8.CodeFlushingFunctionsFlushed) \
+  SC(code_flushing_bytes_flushed, V8.CodeFlushingBytesFlushed)        \
+  SC(code_flushing_functions_recompiled,                              \
+     V8.CodeFlushingFunctionsRecompiled)                              \
+  SC(code_flushing_bytes_recompiled, V8.CodeFlushingBytesRecompiled)  \
   SC(string_ctor_calls, V8.StringConstructorCalls)                    \
   SC(string_ctor_conversions, V8.StringConstructorConversions)        \
   SC(string_ctor_cached_number, V8.StringConstructorCachedNumber)     \
@@ -150,6 +182,10 @@ namespace internal {
   SC(total_compile_size, V8.TotalCompileSize)                         \
   /* Amount of source code compiled with the full codegen. */         \
   SC(total_full_codegen_source_size, V8.TotalFullCodegenSourceSize)   \
+  /* Optimization decisions of the runtime profiler's compile budget. */ \
+  SC(compile_budget_spent, V8.CompileBudgetSpent)                     \
+  SC(compile_budget_deferred, V8.CompileBudgetDeferred)               \
+  SC(compile_budget_queue_full, V8.CompileBudgetQueueFull)            \
   /* Number of contexts created from scratch. */                      \
   SC(contexts_created_from_scratch, V8.ContextsCreatedFromScratch)    \
   /* Number of contexts created by partial snapshot. */               \
@@ -200,6 +236,7 @@ namespace internal {
   SC(cow_arrays_created_stub, V8.COWArraysCreatedStub)                \
   SC(cow_arrays_created_runtime, V8.COWArraysCreatedRuntime)          \
   SC(cow_arrays_converted, V8.COWArraysConverted)                     \
+  SC(cow_arrays_created_builtin, V8.COWArraysCreatedBuiltin)          \
   SC(call_miss, V8.CallMiss)                                          \
   SC(keyed_call_miss, V8.KeyedCallMiss)                               \
   SC(load_miss, V8.LoadMiss)                                          \
@@ -217,6 +254,7 @@ namespace internal {
   SC(megamorphic_stub_cache_probes, V8.MegamorphicStubCacheProbes)    \
   SC(megamorphic_stub_cache_misses, V8.MegamorphicStubCacheMisses)    \
   SC(megamorphic_stub_cache_updates, V8.MegamorphicStubCacheUpdates)  \
+  SC(megamorphic_stub_cache_evictions, V8.MegamorphicStubCacheEvictions) \
   SC(array_function_runtime, V8.ArrayFunctionRuntime)                 \
   SC(array_function_native, V8.ArrayFunctionNative)                   \
   SC(for_in, V8.ForIn)                                                \
@@ -255,6 +293,7 @@ namespace internal {
   SC(soft_deopts_requested, V8.SoftDeoptsRequested)                   \
   SC(soft_deopts_inserted, V8.SoftDeoptsInserted)                     \
   SC(soft_deopts_executed, V8.SoftDeoptsExecuted)                     \
+  SC(deopt_marked_code_batched, V8.DeoptMarkedCodeBatched)            \
   /* Number of write barriers in generated code. */                   \
   SC(write_barriers_dynamic, V8.WriteBarriersDynamic)                 \
   SC(write_barriers_static, V8.WriteBarriersStatic)                   \
@@ -297,6 +336,11 @@ class Counters {
   HISTOGRAM_TIMER_LIST(HT)
 #undef HT
 
+#define HR(name, caption, min, max, num_buckets) \
+  Histogram* name() { return &name##_; }
+  HISTOGRAM_RANGE_LIST(HR)
+#undef HR
+
 #define HP(name, caption) \
   Histogram* name() { return &name##_; }
   HISTOGRAM_PERCENTAGE_LIST(HP)
@@ -347,6 +391,9 @@ class Counters {
 #define RATE_ID(name, caption) k_##name,
     HISTOGRAM_TIMER_LIST(RATE_ID)
 #undef RATE_ID
+#define RANGE_ID(name, caption, min, max, num_buckets) k_##name,
+    HISTOGRAM_RANGE_LIST(RANGE_ID)
+#undef RANGE_ID
 #define PERCENTAGE_ID(name, caption) k_##name,
     HISTOGRAM_PERCENTAGE_LIST(PERCENTAGE_ID)
 #undef PERCENTAGE_ID
@@ -383,6 +430,11 @@ class Counters {
   HISTOGRAM_TIMER_LIST(HT)
 #undef HT
 
+#define HR(name, caption, min, max, num_buckets) \
+  Histogram name##_;
+  HISTOGRAM_RANGE_LIST(HR)
+#undef HR
+
 #define HP(name, caption) \
   Histogram name##_;
   HISTOGRAM_PERCENTAGE_LIST(HP)
@@ -82,6 +82,7 @@ bool V8::Initialize(Deserializer* des) {
 #ifdef V8_USE_DEFAULT_PLATFORM
   DefaultPlatform* platform = static_cast<DefaultPlatform*>(platform_);
   platform->SetThreadPoolSize(isolate->max_available_threads());
+  platform->SetMaxQueueDepth(FLAG_background_task_queue_depth);
   // We currently only start the threads early, if we know that we'll use them.
   if (FLAG_job_based_sweeping) platform->EnsureInitialized();
 #endif
@@ -107,6 +108,7 @@ void V8::TearDown() {
   ExternalReference::TearDownMathExpData();
   RegisteredExtension::UnregisterAll();
   Isolate::GlobalTearDown();
+  ZoneSegmentPool::Trim(0);
 
   delete call_completed_callbacks_;
   call_completed_callbacks_ = NULL;
@@ -151,7 +153,7 @@ void V8::RemoveCallCompletedCallback(CallCompletedCallback callback) {
 void V8::FireCallCompletedCallback(Isolate* isolate) {
   bool has_call_completed_callbacks = call_completed_callbacks_ != NULL;
   bool run_microtasks = isolate->autorun_microtasks() &&
-                        isolate->microtask_pending();
+      isolate->microtask_queue()->HasPendingMicrotasks();
   if (!has_call_completed_callbacks && !run_microtasks) return;
 
   HandleScopeImplementer* handle_scope_implementer =
@@ -159,7 +161,7 @@ void V8::FireCallCompletedCallback(Isolate* isolate) {
   if (!handle_scope_implementer->CallDepthIsZero()) return;
   // Fire callbacks.  Increase call depth to prevent recursive callbacks.
   handle_scope_implementer->IncrementCallDepth();
-  if (run_microtasks) Execution::RunMicrotasks(isolate);
+  if (run_microtasks) isolate->microtask_queue()->RunMicrotasks();
   if (has_call_completed_callbacks) {
     for (int i = 0; i < call_completed_callbacks_->length(); i++) {
       call_completed_callbacks_->at(i)();
@@ -170,7 +172,7 @@ void V8::FireCallCompletedCallback(Isolate* isolate) {
 
 
 void V8::RunMicrotasks(Isolate* isolate) {
-  if (!isolate->microtask_pending())
+  if (!isolate->microtask_queue()->HasPendingMicrotasks())
     return;
 
   HandleScopeImplementer* handle_scope_implementer =
@@ -179,7 +181,7 @@ void V8::RunMicrotasks(Isolate* isolate) {
 
   // Increase call depth to prevent recursive callbacks.
   handle_scope_implementer->IncrementCallDepth();
-  Execution::RunMicrotasks(isolate);
+  isolate->microtask_queue()->RunMicrotasks();
   handle_scope_implementer->DecrementCallDepth();
 }
 
@@ -235,4 +237,12 @@ v8::Platform* V8::GetCurrentPlatform() {
   return platform_;
 }
 
+
+void V8::RunIdleTasks(v8::Isolate* isolate, double idle_time_in_ms) {
+#ifdef V8_USE_DEFAULT_PLATFORM
+  DefaultPlatform* platform = static_cast<DefaultPlatform*>(platform_);
+  platform->RunIdleTasks(isolate, idle_time_in_ms);
+#endif
+}
+
 } }  // namespace v8::internal
@@ -116,6 +116,9 @@ class V8 : public AllStatic {
   static void ShutdownPlatform();
   static v8::Platform* GetCurrentPlatform();
 
+  // Runs pending idle tasks of |isolate| if the default platform is used.
+  static void RunIdleTasks(v8::Isolate* isolate, double idle_time_in_ms);
+
  private:
   static void InitializeOncePerProcessImpl();
   static void InitializeOncePerProcess();
@@ -286,7 +286,10 @@ enum CallFunctionFlags {
   CALL_AS_METHOD,
   // Always wrap the receiver and call to the JSFunction. Only use this flag
   // both the receiver type and the target method are statically known.
-  WRAP_AND_CALL
+  WRAP_AND_CALL,
+  // The call target is cached in the feedback vector and the receiver is
+  // wrapped as for CALL_AS_METHOD.
+  RECORD_CALL_TARGET_AS_METHOD
 };
 
 
@@ -418,6 +421,12 @@ enum StateTag {
 // On X86/X64, values below 32 are bits in EDX, values above 32 are bits in ECX.
 enum CpuFeature { SSE4_1 = 32 + 19,  // x86
                   SSE3 = 32 + 0,     // x86
+                  AVX = 32 + 28,     // x86
+                  POPCNT = 32 + 23,  // x86
+                  LZCNT = 8,   // x86 (not a CPUID leaf 1 bit)
+                  BMI1 = 9,    // x86 (not a CPUID leaf 1 bit)
+                  BMI2 = 10,   // x86 (not a CPUID leaf 1 bit)
+                  AVX2 = 11,   // x86 (not a CPUID leaf 1 bit)
                   SSE2 = 26,   // x86
                   CMOV = 15,   // x86
                   VFP3 = 1,    // ARM
@@ -1188,7 +1188,7 @@ function ObjectDefineProperty(obj, p, attributes) {
     // currently requires:
     desc = descObj;
     */
-  } else {
+  } else if (!%DefineOwnPropertyFastCase(obj, name, attributes)) {
     var desc = ToPropertyDescriptor(attributes);
     DefineOwnProperty(obj, name, desc, true);
   }
@@ -1777,6 +1777,14 @@ function FunctionBind(this_arg) { // Length is 1.
   if (!IS_SPEC_FUNCTION(this)) {
     throw new $TypeError('Bind must be called on a function');
   }
+  // The bindings never change once bound, so they are fetched on the first
+  // call only.  When the target is a plain function that needs no receiver
+  // conversion on every call, short argument lists are passed to it with
+  // %_CallFunction instead of going through %Apply.
+  var bindings;
+  var fastTarget;
+  var fastReceiver;
+  var boundArgc = -1;
   var boundFunction = function () {
     // Poison .arguments and .caller, but is otherwise not detectable.
     "use strict";
@@ -1785,9 +1793,50 @@ function FunctionBind(this_arg) { // Length is 1.
     if (%_IsConstructCall()) {
       return %NewObjectFromBound(boundFunction);
     }
-    var bindings = %BoundFunctionGetBindings(boundFunction);
+    if (IS_UNDEFINED(bindings)) {
+      bindings = %BoundFunctionGetBindings(boundFunction);
+      var target = bindings[0];
+      var receiver = bindings[1];
+      if (IS_FUNCTION(target)) {
+        if (IS_NULL_OR_UNDEFINED(receiver)) {
+          fastReceiver = %GetDefaultReceiver(target) || receiver;
+          fastTarget = target;
+        } else if (IS_SPEC_OBJECT(receiver) ||
+                   !%IsClassicModeFunction(target)) {
+          fastReceiver = receiver;
+          fastTarget = target;
+        }
+      }
+      if (!IS_UNDEFINED(fastTarget)) boundArgc = bindings.length - 2;
+    }
 
     var argc = %_ArgumentsLength();
+    if (boundArgc == 0) {
+      if (argc == 0) return %_CallFunction(fastReceiver, fastTarget);
+      if (argc == 1) {
+        return %_CallFunction(fastReceiver, %_Arguments(0), fastTarget);
+      }
+      if (argc == 2) {
+        return %_CallFunction(fastReceiver, %_Arguments(0), %_Arguments(1),
+                              fastTarget);
+      }
+      if (argc == 3) {
+        return %_CallFunction(fastReceiver, %_Arguments(0), %_Arguments(1),
+                              %_Arguments(2), fastTarget);
+      }
+    } else if (boundArgc == 1) {
+      if (argc == 0) {
+        return %_CallFunction(fastReceiver, bindings[2], fastTarget);
+      }
+      if (argc == 1) {
+        return %_CallFunction(fastReceiver, bindings[2], %_Arguments(0),
+                              fastTarget);
+      }
+      if (argc == 2) {
+        return %_CallFunction(fastReceiver, bindings[2], %_Arguments(0),
+                              %_Arguments(1), fastTarget);
+      }
+    }
     if (argc == 0) {
       return %Apply(bindings[0], bindings[1], bindings, 2, bindings.length - 2);
     }
@@ -1885,38 +1934,3 @@ function SetUpFunction() {
 }
 
 SetUpFunction();
-
-
-//----------------------------------------------------------------------------
-
-// TODO(rossberg): very simple abstraction for generic microtask queue.
-// Eventually, we should move to a real event queue that allows to maintain
-// relative ordering of different kinds of tasks.
-
-function GetMicrotaskQueue() {
-  var microtaskState = %GetMicrotaskState();
-  if (IS_UNDEFINED(microtaskState.queue)) {
-    microtaskState.queue = new InternalArray;
-  }
-  return microtaskState.queue;
-}
-
-function RunMicrotasks() {
-  while (%SetMicrotaskPending(false)) {
-    var microtaskState = %GetMicrotaskState();
-    if (IS_UNDEFINED(microtaskState.queue))
-      return;
-
-    var microtasks = microtaskState.queue;
-    microtaskState.queue = new InternalArray;
-
-    for (var i = 0; i < microtasks.length; i++) {
-      microtasks[i]();
-    }
-  }
-}
-
-function EnqueueExternalMicrotask(fn) {
-  GetMicrotaskQueue().push(fn);
-  %SetMicrotaskPending(true);
-}
@@ -380,6 +380,42 @@ void ThreadManager::Iterate(ObjectVisitor* v) {
 }
 
 
+void ThreadManager::IterateArchivedHandleScopes(ObjectVisitor* v,
+                                                int first,
+                                                int stride) {
+  int index = 0;
+  for (ThreadState* state = FirstThreadStateInUse();
+       state != NULL;
+       state = state->Next(), index++) {
+    if (index % stride != first) continue;
+    HandleScopeImplementer::Iterate(v, state->data());
+  }
+}
+
+
+void ThreadManager::IterateArchivedStacks(ObjectVisitor* v) {
+  for (ThreadState* state = FirstThreadStateInUse();
+       state != NULL;
+       state = state->Next()) {
+    char* data = state->data();
+    data += HandleScopeImplementer::ArchiveSpacePerThread();
+    data = isolate_->Iterate(v, data);
+    data = Relocatable::Iterate(v, data);
+  }
+}
+
+
+int ThreadManager::CountArchivedThreads() {
+  int count = 0;
+  for (ThreadState* state = FirstThreadStateInUse();
+       state != NULL;
+       state = state->Next()) {
+    count++;
+  }
+  return count;
+}
+
+
 void ThreadManager::IterateArchivedThreads(ThreadVisitor* v) {
   for (ThreadState* state = FirstThreadStateInUse();
        state != NULL;
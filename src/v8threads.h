@@ -99,6 +99,13 @@ class ThreadManager {
 
   void Iterate(ObjectVisitor* v);
   void IterateArchivedThreads(ThreadVisitor* v);
+  // Together these visit the same pointers as Iterate.  The handle scopes
+  // of archived threads are only read, so disjoint stripes of them may be
+  // visited from several threads at once, while the stacks have to be
+  // walked by the thread that holds the isolate lock.
+  void IterateArchivedHandleScopes(ObjectVisitor* v, int first, int stride);
+  void IterateArchivedStacks(ObjectVisitor* v);
+  int CountArchivedThreads();
   bool IsLockedByCurrentThread() {
     return mutex_owner_.Equals(ThreadId::Current());
   }
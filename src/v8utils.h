@@ -158,9 +158,10 @@ inline void MoveWords(T* dst, const T* src, size_t num_words) {
   // enough to justify the extra call/setup overhead.
   static const size_t kBlockCopyLimit = 16;
 
+  // A forward copy is also correct for overlapping spans if it moves the
+  // data towards lower addresses.
   if (num_words < kBlockCopyLimit &&
-      ((dst < src) || (dst >= (src + num_words * kPointerSize)))) {
-    T* end = dst + num_words;
+      ((dst < src) || (dst >= (src + num_words)))) {
     do {
       num_words--;
       *dst++ = *src++;
@@ -183,13 +184,23 @@ inline void CopyBytes(T* dst, const T* src, size_t num_bytes) {
   // enough to justify the extra call/setup overhead.
   static const int kBlockCopyLimit = OS::kMinComplexMemCopy;
 
-  if (num_bytes < static_cast<size_t>(kBlockCopyLimit)) {
-    do {
-      num_bytes--;
-      *dst++ = *src++;
-    } while (num_bytes > 0);
-  } else {
+  if (num_bytes >= static_cast<size_t>(kBlockCopyLimit)) {
     OS::MemCopy(dst, src, num_bytes);
+    return;
+  }
+#ifdef V8_HOST_CAN_READ_UNALIGNED
+  // Copy whole words first, the remaining bytes are copied one at a time.
+  while (num_bytes >= sizeof(uintptr_t)) {
+    *reinterpret_cast<uintptr_t*>(dst) =
+        *reinterpret_cast<const uintptr_t*>(src);
+    dst += sizeof(uintptr_t);
+    src += sizeof(uintptr_t);
+    num_bytes -= sizeof(uintptr_t);
+  }
+#endif
+  while (num_bytes > 0) {
+    num_bytes--;
+    *dst++ = *src++;
   }
 }
 
@@ -0,0 +1,1071 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "value-serializer.h"
+
+#include "factory.h"
+#include "global-handles.h"
+#include "handles-inl.h"
+#include "objects.h"
+#include "runtime.h"
+#include "v8conversions.h"
+
+namespace v8 {
+namespace internal {
+
+
+// Every value starts with one of these tags.  Integers are written as
+// base-128 varints, least significant group first; signed ones are zigzag
+// encoded first.  The format is only meant to be read back by the same
+// V8 build, so doubles and two-byte characters use the host byte order.
+enum SerializationTag {
+  // version:uint32_t.  Starts the data.
+  kVersionTag = 0xFF,
+  kUndefinedTag = '_',
+  kNullTag = '0',
+  kTrueTag = 'T',
+  kFalseTag = 'F',
+  // value:int32_t (zigzag)
+  kInt32Tag = 'I',
+  // value:double
+  kDoubleTag = 'N',
+  // length:uint32_t, then raw Latin-1 characters
+  kLatin1StringTag = '"',
+  // length:uint32_t in characters, then raw UTF-16 code units
+  kUC16StringTag = 'c',
+  // id:uint32_t of a receiver written earlier
+  kBackReferenceTag = '^',
+  // Key/value pairs follow, then kEndJSObjectTag and the number of pairs.
+  kBeginJSObjectTag = 'o',
+  kEndJSObjectTag = '{',
+  // length:uint32_t, then that many values
+  kDenseJSArrayTag = 'A',
+  // length:uint32_t, then that many int32_t (zigzag)
+  kSmiJSArrayTag = 'i',
+  // length:uint32_t, then that many doubles
+  kDoubleJSArrayTag = 'd',
+  // length:uint32_t, then key/value pairs, then kEndSparseJSArrayTag, the
+  // number of pairs and the length again.
+  kBeginSparseJSArrayTag = 'a',
+  kEndSparseJSArrayTag = '@',
+  // byte_length:uint32_t, then raw bytes
+  kArrayBufferTag = 'B',
+  // transfer_id:uint32_t
+  kArrayBufferTransferTag = 't',
+  // Follows the array buffer a typed array is a view of.
+  // array_id:uint8_t (Runtime::TypedArrayId), byte_offset:uint32_t,
+  // byte_length:uint32_t
+  kArrayBufferViewTag = 'V',
+  // Keys and values alternate, then kEndJSMapTag and their total number.
+  kBeginJSMapTag = ';',
+  kEndJSMapTag = ':',
+  // Keys follow, then kEndJSSetTag and their number.
+  kBeginJSSetTag = '\'',
+  kEndJSSetTag = ','
+};
+
+
+// The serializer and the deserializer keep their tables in global handles,
+// so that they survive the handle scopes opened while walking the graph.
+template <typename T>
+static Handle<T> NewGlobalHandle(Isolate* isolate, Handle<T> value) {
+  return Handle<T>::cast(isolate->global_handles()->Create(*value));
+}
+
+
+template <typename T>
+static void ReplaceGlobalHandle(Isolate* isolate,
+                                Handle<T>* location,
+                                Handle<T> value) {
+  if (*value == **location) return;
+  GlobalHandles::Destroy(Handle<Object>::cast(*location).location());
+  *location = NewGlobalHandle(isolate, value);
+}
+
+
+static uint8_t TypedArrayIdFor(ExternalArrayType type) {
+  switch (type) {
+    case kExternalUint8Array: return Runtime::ARRAY_ID_UINT8;
+    case kExternalInt8Array: return Runtime::ARRAY_ID_INT8;
+    case kExternalUint16Array: return Runtime::ARRAY_ID_UINT16;
+    case kExternalInt16Array: return Runtime::ARRAY_ID_INT16;
+    case kExternalUint32Array: return Runtime::ARRAY_ID_UINT32;
+    case kExternalInt32Array: return Runtime::ARRAY_ID_INT32;
+    case kExternalFloat32Array: return Runtime::ARRAY_ID_FLOAT32;
+    case kExternalFloat64Array: return Runtime::ARRAY_ID_FLOAT64;
+    case kExternalUint8ClampedArray: return Runtime::ARRAY_ID_UINT8_CLAMPED;
+  }
+  UNREACHABLE();
+  return 0;
+}
+
+
+ValueSerializer::ValueSerializer(Isolate* isolate)
+    : isolate_(isolate), buffer_(64), next_id_(0) {
+  HandleScope scope(isolate);
+  Factory* factory = isolate->factory();
+  id_map_ = NewGlobalHandle(isolate, factory->NewObjectHashTable(16));
+  array_buffer_transfer_map_ =
+      NewGlobalHandle(isolate, factory->NewObjectHashTable(4));
+}
+
+
+ValueSerializer::~ValueSerializer() {
+  GlobalHandles::Destroy(Handle<Object>::cast(id_map_).location());
+  GlobalHandles::Destroy(
+      Handle<Object>::cast(array_buffer_transfer_map_).location());
+}
+
+
+void ValueSerializer::WriteHeader() {
+  WriteTag(kVersionTag);
+  WriteVarint(kVersion);
+}
+
+
+void ValueSerializer::WriteVarint(uint32_t value) {
+  while (value >= 0x80) {
+    buffer_.Add(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer_.Add(static_cast<uint8_t>(value));
+}
+
+
+void ValueSerializer::WriteZigZag(int32_t value) {
+  WriteVarint((static_cast<uint32_t>(value) << 1) ^
+              static_cast<uint32_t>(value >> 31));
+}
+
+
+void ValueSerializer::WriteDouble(double value) {
+  WriteRawBytes(&value, sizeof(value));
+}
+
+
+void ValueSerializer::WriteRawBytes(const void* source, int length) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(source);
+  buffer_.AddAll(Vector<uint8_t>(const_cast<uint8_t*>(bytes), length));
+}
+
+
+void ValueSerializer::TransferArrayBuffer(
+    uint32_t transfer_id, Handle<JSArrayBuffer> array_buffer) {
+  HandleScope scope(isolate_);
+  Handle<ObjectHashTable> table = ObjectHashTable::Put(
+      array_buffer_transfer_map_, array_buffer,
+      isolate_->factory()->NewNumberFromUint(transfer_id));
+  ReplaceGlobalHandle(isolate_, &array_buffer_transfer_map_, table);
+}
+
+
+bool ValueSerializer::WriteObject(Handle<Object> object) {
+  if (object->IsSmi()) {
+    WriteSmi(Smi::cast(*object));
+  } else if (object->IsHeapNumber()) {
+    WriteTag(kDoubleTag);
+    WriteDouble(HeapNumber::cast(*object)->value());
+  } else if (object->IsUndefined()) {
+    WriteTag(kUndefinedTag);
+  } else if (object->IsNull()) {
+    WriteTag(kNullTag);
+  } else if (object->IsTrue()) {
+    WriteTag(kTrueTag);
+  } else if (object->IsFalse()) {
+    WriteTag(kFalseTag);
+  } else if (object->IsString()) {
+    WriteString(Handle<String>::cast(object));
+  } else if (object->IsJSReceiver()) {
+    return WriteJSReceiver(Handle<JSReceiver>::cast(object));
+  } else {
+    return ThrowDataCloneError(object);
+  }
+  return true;
+}
+
+
+void ValueSerializer::WriteSmi(Smi* smi) {
+  WriteTag(kInt32Tag);
+  WriteZigZag(smi->value());
+}
+
+
+void ValueSerializer::WriteString(Handle<String> string) {
+  string = FlattenGetString(string);
+  DisallowHeapAllocation no_allocation;
+  String::FlatContent flat = string->GetFlatContent();
+  ASSERT(flat.IsFlat());
+  if (flat.IsAscii()) {
+    Vector<const uint8_t> chars = flat.ToOneByteVector();
+    WriteTag(kLatin1StringTag);
+    WriteVarint(chars.length());
+    WriteRawBytes(chars.start(), chars.length());
+  } else {
+    Vector<const uc16> chars = flat.ToUC16Vector();
+    WriteTag(kUC16StringTag);
+    WriteVarint(chars.length());
+    WriteRawBytes(chars.start(), chars.length() * sizeof(uc16));
+  }
+}
+
+
+bool ValueSerializer::WriteJSReceiver(Handle<JSReceiver> receiver) {
+  int id = FindId(receiver);
+  if (id >= 0) {
+    WriteTag(kBackReferenceTag);
+    WriteVarint(id);
+    return true;
+  }
+
+  StackLimitCheck check(isolate_);
+  if (check.HasOverflowed()) {
+    isolate_->StackOverflow();
+    return false;
+  }
+
+  HandleScope scope(isolate_);
+  switch (receiver->map()->instance_type()) {
+    case JS_OBJECT_TYPE: {
+      // Objects created from API templates may carry embedder data in
+      // internal fields, which has no meaning in another isolate.
+      Handle<JSObject> object = Handle<JSObject>::cast(receiver);
+      if (object->GetInternalFieldCount() > 0) break;
+      AssignId(object);
+      return WriteJSObject(object);
+    }
+    case JS_ARRAY_TYPE:
+      AssignId(receiver);
+      return WriteJSArray(Handle<JSArray>::cast(receiver));
+    case JS_ARRAY_BUFFER_TYPE:
+      AssignId(receiver);
+      return WriteJSArrayBuffer(Handle<JSArrayBuffer>::cast(receiver));
+    case JS_TYPED_ARRAY_TYPE:
+      // Gets its id once its buffer has been written.
+      return WriteJSTypedArray(Handle<JSTypedArray>::cast(receiver));
+    case JS_MAP_TYPE:
+      AssignId(receiver);
+      return WriteJSMap(Handle<JSMap>::cast(receiver));
+    case JS_SET_TYPE:
+      AssignId(receiver);
+      return WriteJSSet(Handle<JSSet>::cast(receiver));
+    default:
+      break;
+  }
+  return ThrowDataCloneError(receiver);
+}
+
+
+bool ValueSerializer::WriteJSObject(Handle<JSObject> object) {
+  WriteTag(kBeginJSObjectTag);
+  if (object->HasFastProperties() &&
+      !object->HasIndexedInterceptor() &&
+      !object->HasNamedInterceptor() &&
+      object->elements()->length() == 0) {
+    // Read the properties straight from the object's fields, as long as
+    // its map does not change under us.
+    Handle<Map> map(object->map(), isolate_);
+    int count = 0;
+    for (int i = 0; i < map->NumberOfOwnDescriptors(); i++) {
+      HandleScope scope(isolate_);
+      Handle<Name> name(map->instance_descriptors()->GetKey(i), isolate_);
+      if (!name->IsString()) continue;
+      PropertyDetails details = map->instance_descriptors()->GetDetails(i);
+      if (details.IsDontEnum()) continue;
+      Handle<String> key = Handle<String>::cast(name);
+      Handle<Object> value;
+      if (details.type() == FIELD && *map == object->map()) {
+        value = Handle<Object>(
+            object->RawFastPropertyAt(
+                map->instance_descriptors()->GetFieldIndex(i)),
+            isolate_);
+      } else {
+        value = GetProperty(isolate_, object, key);
+        if (value.is_null()) return false;
+      }
+      WriteString(key);
+      if (!WriteObject(value)) return false;
+      count++;
+    }
+    WriteTag(kEndJSObjectTag);
+    WriteVarint(count);
+    return true;
+  }
+
+  bool threw = false;
+  Handle<FixedArray> keys = GetKeysInFixedArrayFor(object, LOCAL_ONLY, &threw);
+  if (threw) return false;
+  if (!WriteProperties(object, keys)) return false;
+  WriteTag(kEndJSObjectTag);
+  WriteVarint(keys->length());
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSArray(Handle<JSArray> array) {
+  uint32_t length = 0;
+  CHECK(array->length()->ToArrayIndex(&length));
+
+  // Packed arrays without named properties (other than length) are
+  // written element by element; Smi and double arrays without tagging
+  // each element.
+  bool only_elements = array->HasFastProperties() &&
+      array->map()->NumberOfOwnDescriptors() == 1;
+  if (only_elements) {
+    ElementsKind kind = array->GetElementsKind();
+    if (length > 0 && kind == FAST_SMI_ELEMENTS) {
+      Handle<FixedArray> elements(FixedArray::cast(array->elements()));
+      WriteTag(kSmiJSArrayTag);
+      WriteVarint(length);
+      for (uint32_t i = 0; i < length; i++) {
+        WriteZigZag(Smi::cast(elements->get(i))->value());
+      }
+      return true;
+    }
+    if (length > 0 && kind == FAST_DOUBLE_ELEMENTS) {
+      Handle<FixedDoubleArray> elements(
+          FixedDoubleArray::cast(array->elements()));
+      WriteTag(kDoubleJSArrayTag);
+      WriteVarint(length);
+      for (uint32_t i = 0; i < length; i++) {
+        WriteDouble(elements->get_scalar(i));
+      }
+      return true;
+    }
+    if (length == 0 || kind == FAST_ELEMENTS) {
+      // Getters run while writing the elements may change the array,
+      // so keep walking the elements it had when we started.
+      Handle<FixedArray> elements(FixedArray::cast(array->elements()));
+      WriteTag(kDenseJSArrayTag);
+      WriteVarint(length);
+      for (uint32_t i = 0; i < length; i++) {
+        HandleScope scope(isolate_);
+        if (!WriteObject(Handle<Object>(elements->get(i), isolate_))) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+
+  bool threw = false;
+  Handle<FixedArray> keys = GetKeysInFixedArrayFor(array, LOCAL_ONLY, &threw);
+  if (threw) return false;
+  WriteTag(kBeginSparseJSArrayTag);
+  WriteVarint(length);
+  if (!WriteProperties(array, keys)) return false;
+  WriteTag(kEndSparseJSArrayTag);
+  WriteVarint(keys->length());
+  WriteVarint(length);
+  return true;
+}
+
+
+bool ValueSerializer::WriteProperties(Handle<JSObject> object,
+                                      Handle<FixedArray> keys) {
+  for (int i = 0; i < keys->length(); i++) {
+    HandleScope scope(isolate_);
+    Handle<Object> key(keys->get(i), isolate_);
+    Handle<Object> value = GetProperty(isolate_, object, key);
+    if (value.is_null()) return false;
+    if (!WriteObject(key) || !WriteObject(value)) return false;
+  }
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSArrayBuffer(Handle<JSArrayBuffer> array_buffer) {
+  Object* transfer_id = array_buffer_transfer_map_->Lookup(*array_buffer);
+  if (!transfer_id->IsTheHole()) {
+    WriteTag(kArrayBufferTransferTag);
+    WriteVarint(NumberToUint32(transfer_id));
+    return true;
+  }
+
+  size_t byte_length = NumberToSize(isolate_, array_buffer->byte_length());
+  if (byte_length > static_cast<size_t>(kMaxInt)) {
+    return ThrowDataCloneError(array_buffer);
+  }
+  WriteTag(kArrayBufferTag);
+  WriteVarint(static_cast<uint32_t>(byte_length));
+  WriteRawBytes(array_buffer->backing_store(), static_cast<int>(byte_length));
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSTypedArray(Handle<JSTypedArray> typed_array) {
+  Handle<JSArrayBuffer> buffer(JSArrayBuffer::cast(typed_array->buffer()),
+                               isolate_);
+  if (!WriteJSReceiver(buffer)) return false;
+  AssignId(typed_array);
+  WriteTag(kArrayBufferViewTag);
+  WriteTag(TypedArrayIdFor(typed_array->type()));
+  WriteVarint(NumberToUint32(typed_array->byte_offset()));
+  WriteVarint(NumberToUint32(typed_array->byte_length()));
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSMap(Handle<JSMap> map) {
+  // Copy the entries first, writing the values may run getters that
+  // modify the map.
+  Handle<OrderedHashMap> table(OrderedHashMap::cast(map->table()), isolate_);
+  Handle<FixedArray> entries =
+      isolate_->factory()->NewFixedArray(2 * table->NumberOfElements());
+  {
+    DisallowHeapAllocation no_allocation;
+    int count = 0;
+    for (int i = 0; i < table->UsedCapacity(); i++) {
+      Object* key = table->KeyAt(i);
+      if (key->IsTheHole()) continue;
+      entries->set(count++, key);
+      entries->set(count++, table->ValueAt(i));
+    }
+    ASSERT_EQ(entries->length(), count);
+  }
+
+  WriteTag(kBeginJSMapTag);
+  for (int i = 0; i < entries->length(); i++) {
+    HandleScope scope(isolate_);
+    if (!WriteObject(Handle<Object>(entries->get(i), isolate_))) return false;
+  }
+  WriteTag(kEndJSMapTag);
+  WriteVarint(entries->length());
+  return true;
+}
+
+
+bool ValueSerializer::WriteJSSet(Handle<JSSet> set) {
+  Handle<OrderedHashSet> table(OrderedHashSet::cast(set->table()), isolate_);
+  Handle<FixedArray> entries =
+      isolate_->factory()->NewFixedArray(table->NumberOfElements());
+  {
+    DisallowHeapAllocation no_allocation;
+    int count = 0;
+    for (int i = 0; i < table->UsedCapacity(); i++) {
+      Object* key = table->KeyAt(i);
+      if (key->IsTheHole()) continue;
+      entries->set(count++, key);
+    }
+    ASSERT_EQ(entries->length(), count);
+  }
+
+  WriteTag(kBeginJSSetTag);
+  for (int i = 0; i < entries->length(); i++) {
+    HandleScope scope(isolate_);
+    if (!WriteObject(Handle<Object>(entries->get(i), isolate_))) return false;
+  }
+  WriteTag(kEndJSSetTag);
+  WriteVarint(entries->length());
+  return true;
+}
+
+
+int ValueSerializer::FindId(Handle<JSReceiver> receiver) {
+  Object* id = id_map_->Lookup(*receiver);
+  if (id->IsTheHole()) return -1;
+  return Smi::cast(id)->value();
+}
+
+
+void ValueSerializer::AssignId(Handle<JSReceiver> receiver) {
+  HandleScope scope(isolate_);
+  Handle<ObjectHashTable> table = ObjectHashTable::Put(
+      id_map_, receiver, Handle<Object>(Smi::FromInt(next_id_++), isolate_));
+  ReplaceGlobalHandle(isolate_, &id_map_, table);
+}
+
+
+bool ValueSerializer::ThrowDataCloneError(Handle<Object> object) {
+  Handle<Object> error = isolate_->factory()->NewTypeError(
+      "data_clone_error", HandleVector(&object, 1));
+  isolate_->Throw(*error);
+  return false;
+}
+
+
+ValueDeserializer::ValueDeserializer(Isolate* isolate,
+                                     Vector<const uint8_t> data)
+    : isolate_(isolate),
+      position_(data.start()),
+      end_(data.start() + data.length()),
+      version_(0),
+      next_id_(0) {
+  HandleScope scope(isolate);
+  id_map_ = NewGlobalHandle(isolate, isolate->factory()->NewFixedArray(16));
+}
+
+
+ValueDeserializer::~ValueDeserializer() {
+  GlobalHandles::Destroy(Handle<Object>::cast(id_map_).location());
+  if (!array_buffer_transfer_map_.is_null()) {
+    GlobalHandles::Destroy(
+        Handle<Object>::cast(array_buffer_transfer_map_).location());
+  }
+}
+
+
+bool ValueDeserializer::ReadHeader() {
+  uint8_t tag;
+  if (!ReadTag(&tag) || tag != kVersionTag) return false;
+  if (!ReadVarint(&version_)) return false;
+  return version_ <= ValueSerializer::kVersion;
+}
+
+
+void ValueDeserializer::TransferArrayBuffer(
+    uint32_t transfer_id, Handle<JSArrayBuffer> array_buffer) {
+  HandleScope scope(isolate_);
+  if (array_buffer_transfer_map_.is_null()) {
+    array_buffer_transfer_map_ = NewGlobalHandle(
+        isolate_, isolate_->factory()->NewSeededNumberDictionary(4));
+  }
+  Handle<SeededNumberDictionary> dictionary = SeededNumberDictionary::Set(
+      array_buffer_transfer_map_, transfer_id, array_buffer,
+      PropertyDetails(NONE, NORMAL, 0));
+  ReplaceGlobalHandle(isolate_, &array_buffer_transfer_map_, dictionary);
+}
+
+
+bool ValueDeserializer::ReadTag(uint8_t* tag) {
+  if (position_ >= end_) return false;
+  *tag = *position_++;
+  return true;
+}
+
+
+bool ValueDeserializer::PeekTag(uint8_t* tag) {
+  if (position_ >= end_) return false;
+  *tag = *position_;
+  return true;
+}
+
+
+bool ValueDeserializer::ReadVarint(uint32_t* value) {
+  uint32_t result = 0;
+  int shift = 0;
+  while (position_ < end_) {
+    uint8_t byte = *position_++;
+    if (shift < 32) result |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    shift += 7;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool ValueDeserializer::ReadZigZag(int32_t* value) {
+  uint32_t unsigned_value;
+  if (!ReadVarint(&unsigned_value)) return false;
+  *value = static_cast<int32_t>((unsigned_value >> 1) ^
+                                -static_cast<int32_t>(unsigned_value & 1));
+  return true;
+}
+
+
+bool ValueDeserializer::ReadDouble(double* value) {
+  const uint8_t* bytes;
+  if (!ReadRawBytes(sizeof(*value), &bytes)) return false;
+  memcpy(value, bytes, sizeof(*value));
+  return true;
+}
+
+
+bool ValueDeserializer::ReadRawBytes(int length, const uint8_t** bytes) {
+  if (length < 0 || end_ - position_ < length) return false;
+  *bytes = position_;
+  position_ += length;
+  return true;
+}
+
+
+Handle<Object> ValueDeserializer::ReadObject() {
+  Handle<Object> result = ReadObjectInternal();
+  // A typed array follows the buffer it is a view of.
+  uint8_t tag;
+  if (!result.is_null() && result->IsJSArrayBuffer() &&
+      PeekTag(&tag) && tag == kArrayBufferViewTag) {
+    ConsumeTag();
+    return ReadJSArrayBufferView(Handle<JSArrayBuffer>::cast(result));
+  }
+  return result;
+}
+
+
+Handle<Object> ValueDeserializer::ReadObjectInternal() {
+  StackLimitCheck check(isolate_);
+  if (check.HasOverflowed()) {
+    isolate_->StackOverflow();
+    return Handle<Object>();
+  }
+
+  Factory* factory = isolate_->factory();
+  uint8_t tag;
+  if (!ReadTag(&tag)) {
+    ThrowDeserializationError();
+    return Handle<Object>();
+  }
+  switch (tag) {
+    case kUndefinedTag:
+      return factory->undefined_value();
+    case kNullTag:
+      return factory->null_value();
+    case kTrueTag:
+      return factory->true_value();
+    case kFalseTag:
+      return factory->false_value();
+    case kInt32Tag: {
+      int32_t value;
+      if (!ReadZigZag(&value)) break;
+      return factory->NewNumberFromInt(value);
+    }
+    case kDoubleTag: {
+      double value;
+      if (!ReadDouble(&value)) break;
+      return factory->NewNumber(value);
+    }
+    case kLatin1StringTag:
+      return ReadOneByteString();
+    case kUC16StringTag:
+      return ReadTwoByteString();
+    case kBackReferenceTag:
+      return ReadBackReference();
+    case kBeginJSObjectTag:
+      return ReadJSObject();
+    case kDenseJSArrayTag:
+      return ReadDenseJSArray();
+    case kSmiJSArrayTag:
+      return ReadSmiJSArray();
+    case kDoubleJSArrayTag:
+      return ReadDoubleJSArray();
+    case kBeginSparseJSArrayTag:
+      return ReadSparseJSArray();
+    case kArrayBufferTag:
+      return ReadJSArrayBuffer();
+    case kArrayBufferTransferTag:
+      return ReadTransferredJSArrayBuffer();
+    case kBeginJSMapTag:
+      return ReadJSMap();
+    case kBeginJSSetTag:
+      return ReadJSSet();
+    default:
+      break;
+  }
+  ThrowDeserializationError();
+  return Handle<Object>();
+}
+
+
+Handle<String> ValueDeserializer::ReadOneByteString() {
+  uint32_t length;
+  const uint8_t* chars;
+  if (!ReadVarint(&length) ||
+      length > static_cast<uint32_t>(String::kMaxLength) ||
+      !ReadRawBytes(length, &chars)) {
+    ThrowDeserializationError();
+    return Handle<String>();
+  }
+  Handle<SeqOneByteString> string =
+      isolate_->factory()->NewRawOneByteString(length);
+  CopyChars(string->GetChars(), chars, length);
+  return string;
+}
+
+
+Handle<String> ValueDeserializer::ReadTwoByteString() {
+  uint32_t length;
+  const uint8_t* bytes;
+  if (!ReadVarint(&length) ||
+      length > static_cast<uint32_t>(String::kMaxLength) ||
+      !ReadRawBytes(length * sizeof(uc16), &bytes)) {
+    ThrowDeserializationError();
+    return Handle<String>();
+  }
+  Handle<SeqTwoByteString> string =
+      isolate_->factory()->NewRawTwoByteString(length);
+  // The source is not necessarily aligned for uc16 access.
+  memcpy(string->GetChars(), bytes, length * sizeof(uc16));
+  return string;
+}
+
+
+Handle<JSObject> ValueDeserializer::ReadJSObject() {
+  Handle<JSObject> object =
+      isolate_->factory()->NewJSObject(isolate_->object_function());
+  AddObjectWithId(object);
+  if (!ReadProperties(object, kEndJSObjectTag)) return Handle<JSObject>();
+  return object;
+}
+
+
+Handle<JSArray> ValueDeserializer::ReadDenseJSArray() {
+  uint32_t length;
+  // Every element takes at least one byte, which keeps bogus lengths from
+  // allocating huge arrays.
+  if (!ReadVarint(&length) ||
+      length > static_cast<uint32_t>(end_ - position_)) {
+    ThrowDeserializationError();
+    return Handle<JSArray>();
+  }
+  Factory* factory = isolate_->factory();
+  Handle<FixedArray> elements = factory->NewFixedArray(length);
+  Handle<JSArray> array =
+      factory->NewJSArrayWithElements(elements, FAST_ELEMENTS);
+  AddObjectWithId(array);
+  for (uint32_t i = 0; i < length; i++) {
+    HandleScope scope(isolate_);
+    Handle<Object> element = ReadObject();
+    if (element.is_null()) return Handle<JSArray>();
+    elements->set(i, *element);
+  }
+  return array;
+}
+
+
+Handle<JSArray> ValueDeserializer::ReadSmiJSArray() {
+  uint32_t length;
+  if (!ReadVarint(&length) ||
+      length > static_cast<uint32_t>(end_ - position_)) {
+    ThrowDeserializationError();
+    return Handle<JSArray>();
+  }
+  Factory* factory = isolate_->factory();
+  Handle<FixedArray> elements = factory->NewFixedArray(length);
+  for (uint32_t i = 0; i < length; i++) {
+    int32_t value;
+    if (!ReadZigZag(&value) || !Smi::IsValid(value)) {
+      ThrowDeserializationError();
+      return Handle<JSArray>();
+    }
+    elements->set(i, Smi::FromInt(value));
+  }
+  Handle<JSArray> array =
+      factory->NewJSArrayWithElements(elements, FAST_SMI_ELEMENTS);
+  AddObjectWithId(array);
+  return array;
+}
+
+
+Handle<JSArray> ValueDeserializer::ReadDoubleJSArray() {
+  uint32_t length;
+  if (!ReadVarint(&length) || length == 0 ||
+      length > static_cast<uint32_t>(end_ - position_) / sizeof(double)) {
+    ThrowDeserializationError();
+    return Handle<JSArray>();
+  }
+  Factory* factory = isolate_->factory();
+  Handle<FixedDoubleArray> elements = factory->NewFixedDoubleArray(length);
+  for (uint32_t i = 0; i < length; i++) {
+    double value;
+    CHECK(ReadDouble(&value));
+    elements->set(i, value);
+  }
+  Handle<JSArray> array =
+      factory->NewJSArrayWithElements(elements, FAST_DOUBLE_ELEMENTS);
+  AddObjectWithId(array);
+  return array;
+}
+
+
+Handle<JSArray> ValueDeserializer::ReadSparseJSArray() {
+  uint32_t length;
+  if (!ReadVarint(&length)) {
+    ThrowDeserializationError();
+    return Handle<JSArray>();
+  }
+  Factory* factory = isolate_->factory();
+  Handle<JSArray> array = factory->NewJSArray(0);
+  AddObjectWithId(array);
+  if (!ReadProperties(array, kEndSparseJSArrayTag)) return Handle<JSArray>();
+  uint32_t expected_length;
+  if (!ReadVarint(&expected_length) || expected_length != length) {
+    ThrowDeserializationError();
+    return Handle<JSArray>();
+  }
+  Handle<Object> result = JSReceiver::SetProperty(
+      array, factory->length_string(), factory->NewNumberFromUint(length),
+      NONE, kNonStrictMode);
+  if (result.is_null()) return Handle<JSArray>();
+  return array;
+}
+
+
+bool ValueDeserializer::ReadProperties(Handle<JSObject> object,
+                                       uint8_t end_tag) {
+  uint32_t count = 0;
+  while (true) {
+    uint8_t tag;
+    if (!PeekTag(&tag)) {
+      ThrowDeserializationError();
+      return false;
+    }
+    if (tag == end_tag) {
+      ConsumeTag();
+      break;
+    }
+
+    HandleScope scope(isolate_);
+    Handle<Object> key = ReadObject();
+    if (key.is_null()) return false;
+    Handle<Object> value = ReadObject();
+    if (value.is_null()) return false;
+
+    // Define own properties rather than assigning them, so that setters
+    // on the prototype chain never see the data.
+    Handle<Object> result;
+    uint32_t index;
+    if (key->ToArrayIndex(&index) ||
+        (key->IsString() && Handle<String>::cast(key)->AsArrayIndex(&index))) {
+      result = JSObject::SetOwnElement(object, index, value, kNonStrictMode);
+    } else if (key->IsString()) {
+      result = JSObject::SetLocalPropertyIgnoreAttributes(
+          object, Handle<String>::cast(key), value, NONE);
+    } else {
+      ThrowDeserializationError();
+      return false;
+    }
+    if (result.is_null()) return false;
+    count++;
+  }
+
+  uint32_t expected_count;
+  if (!ReadVarint(&expected_count) || expected_count != count) {
+    ThrowDeserializationError();
+    return false;
+  }
+  return true;
+}
+
+
+Handle<JSArrayBuffer> ValueDeserializer::ReadJSArrayBuffer() {
+  uint32_t byte_length;
+  const uint8_t* bytes;
+  if (!ReadVarint(&byte_length) ||
+      byte_length > static_cast<uint32_t>(kMaxInt) ||
+      !ReadRawBytes(byte_length, &bytes)) {
+    ThrowDeserializationError();
+    return Handle<JSArrayBuffer>();
+  }
+  Factory* factory = isolate_->factory();
+  Handle<JSArrayBuffer> array_buffer = factory->NewJSArrayBuffer();
+  if (!Runtime::SetupArrayBufferAllocatingData(
+          isolate_, array_buffer, byte_length, false)) {
+    isolate_->Throw(*factory->NewRangeError("invalid_array_buffer_length",
+                                            HandleVector<Object>(NULL, 0)));
+    return Handle<JSArrayBuffer>();
+  }
+  if (byte_length > 0) {
+    memcpy(array_buffer->backing_store(), bytes, byte_length);
+  }
+  AddObjectWithId(array_buffer);
+  return array_buffer;
+}
+
+
+Handle<JSArrayBuffer> ValueDeserializer::ReadTransferredJSArrayBuffer() {
+  uint32_t transfer_id;
+  int entry = SeededNumberDictionary::kNotFound;
+  if (ReadVarint(&transfer_id) && !array_buffer_transfer_map_.is_null()) {
+    entry = array_buffer_transfer_map_->FindEntry(transfer_id);
+  }
+  if (entry == SeededNumberDictionary::kNotFound) {
+    ThrowDeserializationError();
+    return Handle<JSArrayBuffer>();
+  }
+  Handle<JSArrayBuffer> array_buffer(
+      JSArrayBuffer::cast(array_buffer_transfer_map_->ValueAt(entry)),
+      isolate_);
+  AddObjectWithId(array_buffer);
+  return array_buffer;
+}
+
+
+Handle<JSReceiver> ValueDeserializer::ReadJSArrayBufferView(
+    Handle<JSArrayBuffer> buffer) {
+  uint8_t array_id;
+  uint32_t byte_offset;
+  uint32_t byte_length;
+  if (!ReadTag(&array_id) ||
+      array_id < Runtime::ARRAY_ID_UINT8 ||
+      array_id > Runtime::ARRAY_ID_UINT8_CLAMPED ||
+      !ReadVarint(&byte_offset) ||
+      !ReadVarint(&byte_length)) {
+    ThrowDeserializationError();
+    return Handle<JSReceiver>();
+  }
+  ExternalArrayType type = kExternalInt8Array;  // Bogus initialization.
+  size_t element_size = 1;  // Bogus initialization.
+  Runtime::ArrayIdToTypeAndSize(array_id, &type, &element_size);
+  size_t buffer_length = NumberToSize(isolate_, buffer->byte_length());
+  if (byte_offset > buffer_length ||
+      byte_length > buffer_length - byte_offset ||
+      byte_offset % element_size != 0 ||
+      byte_length % element_size != 0) {
+    ThrowDeserializationError();
+    return Handle<JSReceiver>();
+  }
+  size_t length = byte_length / element_size;
+
+  Factory* factory = isolate_->factory();
+  Handle<JSTypedArray> typed_array = factory->NewJSTypedArray(type);
+  for (int i = 0; i < v8::ArrayBufferView::kInternalFieldCount; i++) {
+    typed_array->SetInternalField(i, Smi::FromInt(0));
+  }
+  Handle<Object> byte_offset_object = factory->NewNumberFromSize(byte_offset);
+  Handle<Object> byte_length_object = factory->NewNumberFromSize(byte_length);
+  Handle<Object> length_object = factory->NewNumberFromSize(length);
+  Handle<ExternalArray> elements = factory->NewExternalArray(
+      static_cast<int>(length), type,
+      static_cast<uint8_t*>(buffer->backing_store()) + byte_offset);
+  typed_array->set_buffer(*buffer);
+  typed_array->set_byte_offset(*byte_offset_object);
+  typed_array->set_byte_length(*byte_length_object);
+  typed_array->set_length(*length_object);
+  typed_array->set_elements(*elements);
+  typed_array->set_weak_next(buffer->weak_first_view());
+  buffer->set_weak_first_view(*typed_array);
+  AddObjectWithId(typed_array);
+  return typed_array;
+}
+
+
+Handle<JSMap> ValueDeserializer::ReadJSMap() {
+  Object* map_function =
+      isolate_->native_context()->get(Context::MAP_FUNCTION_INDEX);
+  if (!map_function->IsJSFunction()) {
+    ThrowDeserializationError();
+    return Handle<JSMap>();
+  }
+  Factory* factory = isolate_->factory();
+  Handle<JSMap> map = Handle<JSMap>::cast(factory->NewJSObject(
+      Handle<JSFunction>(JSFunction::cast(map_function), isolate_)));
+  map->set_table(*factory->NewOrderedHashMap());
+  AddObjectWithId(map);
+
+  uint32_t count = 0;
+  while (true) {
+    uint8_t tag;
+    if (!PeekTag(&tag)) {
+      ThrowDeserializationError();
+      return Handle<JSMap>();
+    }
+    if (tag == kEndJSMapTag) {
+      ConsumeTag();
+      break;
+    }
+    HandleScope scope(isolate_);
+    Handle<Object> key = ReadObject();
+    if (key.is_null()) return Handle<JSMap>();
+    Handle<Object> value = ReadObject();
+    if (value.is_null()) return Handle<JSMap>();
+    Handle<OrderedHashMap> table(OrderedHashMap::cast(map->table()));
+    map->set_table(*OrderedHashMap::Put(table, key, value));
+    count += 2;
+  }
+
+  uint32_t expected_count;
+  if (!ReadVarint(&expected_count) || expected_count != count) {
+    ThrowDeserializationError();
+    return Handle<JSMap>();
+  }
+  return map;
+}
+
+
+Handle<JSSet> ValueDeserializer::ReadJSSet() {
+  Object* set_function =
+      isolate_->native_context()->get(Context::SET_FUNCTION_INDEX);
+  if (!set_function->IsJSFunction()) {
+    ThrowDeserializationError();
+    return Handle<JSSet>();
+  }
+  Factory* factory = isolate_->factory();
+  Handle<JSSet> set = Handle<JSSet>::cast(factory->NewJSObject(
+      Handle<JSFunction>(JSFunction::cast(set_function), isolate_)));
+  set->set_table(*factory->NewOrderedHashSet());
+  AddObjectWithId(set);
+
+  uint32_t count = 0;
+  while (true) {
+    uint8_t tag;
+    if (!PeekTag(&tag)) {
+      ThrowDeserializationError();
+      return Handle<JSSet>();
+    }
+    if (tag == kEndJSSetTag) {
+      ConsumeTag();
+      break;
+    }
+    HandleScope scope(isolate_);
+    Handle<Object> key = ReadObject();
+    if (key.is_null()) return Handle<JSSet>();
+    Handle<OrderedHashSet> table(OrderedHashSet::cast(set->table()));
+    set->set_table(*OrderedHashSet::Add(table, key));
+    count++;
+  }
+
+  uint32_t expected_count;
+  if (!ReadVarint(&expected_count) || expected_count != count) {
+    ThrowDeserializationError();
+    return Handle<JSSet>();
+  }
+  return set;
+}
+
+
+Handle<JSReceiver> ValueDeserializer::ReadBackReference() {
+  uint32_t id;
+  if (!ReadVarint(&id) || id >= static_cast<uint32_t>(next_id_)) {
+    ThrowDeserializationError();
+    return Handle<JSReceiver>();
+  }
+  return Handle<JSReceiver>(JSReceiver::cast(id_map_->get(id)), isolate_);
+}
+
+
+void ValueDeserializer::AddObjectWithId(Handle<JSReceiver> receiver) {
+  if (next_id_ == id_map_->length()) {
+    HandleScope scope(isolate_);
+    Handle<FixedArray> grown = isolate_->factory()->CopySizeFixedArray(
+        id_map_, 2 * id_map_->length());
+    ReplaceGlobalHandle(isolate_, &id_map_, grown);
+  }
+  id_map_->set(next_id_++, *receiver);
+}
+
+
+void ValueDeserializer::ThrowDeserializationError() {
+  Handle<Object> error = isolate_->factory()->NewTypeError(
+      "data_clone_deserialization_error", HandleVector<Object>(NULL, 0));
+  isolate_->Throw(*error);
+}
+
+} }  // namespace v8::internal
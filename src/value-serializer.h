@@ -0,0 +1,170 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_VALUE_SERIALIZER_H_
+#define V8_VALUE_SERIALIZER_H_
+
+#include "v8.h"
+
+namespace v8 {
+namespace internal {
+
+
+// A compact binary encoding of JavaScript values for handing data to
+// another isolate, in the spirit of the HTML structured clone algorithm.
+// Every value starts with a one-byte tag; integers are varints and
+// strings and array buffers are raw byte copies, so the common cases
+// are much cheaper than a JSON round trip.  Objects, arrays, array
+// buffers, typed arrays, maps and sets are numbered in the order they
+// are written, and repeated or cyclic references are written as
+// back-references to that number.
+//
+// The deserializer expects the data to come from a serializer of the same
+// version, but never trusts it: malformed input makes it throw rather
+// than crash.
+class ValueSerializer {
+ public:
+  explicit ValueSerializer(Isolate* isolate);
+  ~ValueSerializer();
+
+  static const uint32_t kVersion = 1;
+
+  void WriteHeader();
+
+  // Appends |object|.  Returns false with a pending exception if it, or
+  // anything reachable from it, cannot be cloned.
+  bool WriteObject(Handle<Object> object);
+
+  // Writes |array_buffer| as a reference to |transfer_id| instead of
+  // copying its contents.  Moving the backing store to the receiver is
+  // left to the embedder.
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+  Isolate* isolate() const { return isolate_; }
+  const uint8_t* buffer() { return buffer_.ToConstVector().start(); }
+  int buffer_size() const { return buffer_.length(); }
+
+ private:
+  void WriteTag(uint8_t tag) { buffer_.Add(tag); }
+  void WriteVarint(uint32_t value);
+  void WriteZigZag(int32_t value);
+  void WriteDouble(double value);
+  void WriteRawBytes(const void* source, int length);
+
+  void WriteSmi(Smi* smi);
+  void WriteString(Handle<String> string);
+  bool WriteJSReceiver(Handle<JSReceiver> receiver);
+  bool WriteJSObject(Handle<JSObject> object);
+  bool WriteJSArray(Handle<JSArray> array);
+  bool WriteJSArrayBuffer(Handle<JSArrayBuffer> array_buffer);
+  bool WriteJSTypedArray(Handle<JSTypedArray> typed_array);
+  bool WriteJSMap(Handle<JSMap> map);
+  bool WriteJSSet(Handle<JSSet> set);
+  // Writes the given keys and the values they map to in |object|.
+  bool WriteProperties(Handle<JSObject> object, Handle<FixedArray> keys);
+
+  // Returns the id |receiver| was written with, or -1 if it has not been
+  // written yet.
+  int FindId(Handle<JSReceiver> receiver);
+  void AssignId(Handle<JSReceiver> receiver);
+
+  bool ThrowDataCloneError(Handle<Object> object);
+
+  Isolate* isolate_;
+  List<uint8_t> buffer_;
+  // Maps receivers that have been written to their ids.
+  Handle<ObjectHashTable> id_map_;
+  int next_id_;
+  Handle<ObjectHashTable> array_buffer_transfer_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueSerializer);
+};
+
+
+class ValueDeserializer {
+ public:
+  ValueDeserializer(Isolate* isolate, Vector<const uint8_t> data);
+  ~ValueDeserializer();
+
+  // Returns false if the data was not written by a compatible serializer.
+  bool ReadHeader();
+
+  // Returns the next value, or a null handle with a pending exception.
+  Handle<Object> ReadObject();
+
+  // Resolves references to |transfer_id| to |array_buffer|.
+  void TransferArrayBuffer(uint32_t transfer_id,
+                           Handle<JSArrayBuffer> array_buffer);
+
+  Isolate* isolate() const { return isolate_; }
+
+ private:
+  bool ReadTag(uint8_t* tag);
+  bool PeekTag(uint8_t* tag);
+  void ConsumeTag() { position_++; }
+  bool ReadVarint(uint32_t* value);
+  bool ReadZigZag(int32_t* value);
+  bool ReadDouble(double* value);
+  bool ReadRawBytes(int length, const uint8_t** bytes);
+
+  Handle<Object> ReadObjectInternal();
+  Handle<String> ReadOneByteString();
+  Handle<String> ReadTwoByteString();
+  Handle<JSObject> ReadJSObject();
+  Handle<JSArray> ReadDenseJSArray();
+  Handle<JSArray> ReadSmiJSArray();
+  Handle<JSArray> ReadDoubleJSArray();
+  Handle<JSArray> ReadSparseJSArray();
+  Handle<JSArrayBuffer> ReadJSArrayBuffer();
+  Handle<JSArrayBuffer> ReadTransferredJSArrayBuffer();
+  Handle<JSReceiver> ReadJSArrayBufferView(Handle<JSArrayBuffer> buffer);
+  Handle<JSMap> ReadJSMap();
+  Handle<JSSet> ReadJSSet();
+  Handle<JSReceiver> ReadBackReference();
+  // Reads key/value pairs into |object| up to |end_tag|, then checks the
+  // trailing property count.
+  bool ReadProperties(Handle<JSObject> object, uint8_t end_tag);
+
+  void AddObjectWithId(Handle<JSReceiver> receiver);
+  void ThrowDeserializationError();
+
+  Isolate* isolate_;
+  const uint8_t* position_;
+  const uint8_t* const end_;
+  uint32_t version_;
+  // Receivers read so far, indexed by id.
+  Handle<FixedArray> id_map_;
+  int next_id_;
+  Handle<SeededNumberDictionary> array_buffer_transfer_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueDeserializer);
+};
+
+} }  // namespace v8::internal
+
+#endif  // V8_VALUE_SERIALIZER_H_
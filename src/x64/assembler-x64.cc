@@ -71,6 +71,24 @@ void CpuFeatures::Probe() {
   if (cpu.has_sse3()) {
     probed_features |= static_cast<uint64_t>(1) << SSE3;
   }
+  if (cpu.has_popcnt()) {
+    probed_features |= static_cast<uint64_t>(1) << POPCNT;
+  }
+  if (cpu.has_lzcnt()) {
+    probed_features |= static_cast<uint64_t>(1) << LZCNT;
+  }
+  if (cpu.has_avx()) {
+    probed_features |= static_cast<uint64_t>(1) << AVX;
+  }
+  if (cpu.has_avx2()) {
+    probed_features |= static_cast<uint64_t>(1) << AVX2;
+  }
+  if (cpu.has_bmi1()) {
+    probed_features |= static_cast<uint64_t>(1) << BMI1;
+  }
+  if (cpu.has_bmi2()) {
+    probed_features |= static_cast<uint64_t>(1) << BMI2;
+  }
 
   // SSE2 must be available on every x64 CPU.
   ASSERT(cpu.has_sse2());
@@ -307,6 +325,7 @@ Assembler::Assembler(Isolate* isolate, void* buffer, int buffer_size)
 
 
 void Assembler::GetCode(CodeDesc* desc) {
+  EmitConstantPool();
   // Finalize code (at this point overflow() may be true, but the gap ensures
   // that we are still not overlapping instructions and relocation info).
   ASSERT(pc_ <= reloc_info_writer.pos());  // No overlap.
@@ -321,6 +340,38 @@ void Assembler::GetCode(CodeDesc* desc) {
 }
 
 
+static bool ConstantPoolObjectsMatch(void* key1, void* key2) {
+  return key1 == key2;
+}
+
+
+void Assembler::EmitConstantPool() {
+  if (pending_constant_pool_loads_.is_empty()) return;
+  RecordComment(";;; Constant pool");
+  Align(kPointerSize);
+  // Slot offsets by object, so that repeated uses of an object share a slot
+  // and a single reloc entry.
+  HashMap slots(ConstantPoolObjectsMatch);
+  for (int i = 0; i < pending_constant_pool_loads_.length(); i++) {
+    const ConstantPoolLoad& load = pending_constant_pool_loads_[i];
+    Object* object = *reinterpret_cast<Object**>(load.value);
+    HashMap::Entry* entry = slots.Lookup(
+        object, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(object)),
+        true);
+    if (entry->value == NULL) {
+      EnsureSpace ensure_space(this);
+      entry->value = reinterpret_cast<void*>(pc_offset());
+      emitp(load.value, RelocInfo::EMBEDDED_OBJECT);
+    }
+    int slot_offset =
+        static_cast<int>(reinterpret_cast<intptr_t>(entry->value));
+    int disp_end = load.disp_offset + static_cast<int>(sizeof(int32_t));
+    long_at_put(load.disp_offset, slot_offset - disp_end);
+  }
+  pending_constant_pool_loads_.Clear();
+}
+
+
 void Assembler::Align(int m) {
   ASSERT(IsPowerOf2(m));
   int delta = (m - (pc_offset() & (m - 1))) & (m - 1);
@@ -750,6 +801,15 @@ void Assembler::bts(const Operand& dst, Register src) {
 }
 
 
+void Assembler::bsfl(Register dst, Register src) {
+  EnsureSpace ensure_space(this);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0xBC);
+  emit_modrm(dst, src);
+}
+
+
 void Assembler::bsrl(Register dst, Register src) {
   EnsureSpace ensure_space(this);
   emit_optional_rex_32(dst, src);
@@ -759,6 +819,39 @@ void Assembler::bsrl(Register dst, Register src) {
 }
 
 
+void Assembler::popcntl(Register dst, Register src) {
+  ASSERT(IsEnabled(POPCNT));
+  EnsureSpace ensure_space(this);
+  emit(0xF3);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0xB8);
+  emit_modrm(dst, src);
+}
+
+
+void Assembler::lzcntl(Register dst, Register src) {
+  ASSERT(IsEnabled(LZCNT));
+  EnsureSpace ensure_space(this);
+  emit(0xF3);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0xBD);
+  emit_modrm(dst, src);
+}
+
+
+void Assembler::tzcntl(Register dst, Register src) {
+  ASSERT(IsEnabled(BMI1));
+  EnsureSpace ensure_space(this);
+  emit(0xF3);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0xBC);
+  emit_modrm(dst, src);
+}
+
+
 void Assembler::call(Label* L) {
   positions_recorder()->WriteRecordedPositions();
   EnsureSpace ensure_space(this);
@@ -1469,6 +1562,16 @@ void Assembler::emit_mov(const Operand& dst, Immediate value, int size) {
 
 void Assembler::movp(Register dst, void* value, RelocInfo::Mode rmode) {
   EnsureSpace ensure_space(this);
+  if (rmode == RelocInfo::EMBEDDED_OBJECT && constant_pool_available()) {
+    // movq dst, [rip+disp32], with the displacement filled in by
+    // EmitConstantPool.
+    emit(0x48 | dst.high_bit() << 2);  // REX.W, REX.R for dst.
+    emit(0x8B);
+    emit(0x05 | dst.low_bits() << 3);  // ModR/M with rip-relative rm.
+    pending_constant_pool_loads_.Add(ConstantPoolLoad(pc_offset(), value));
+    emitl(0);
+    return;
+  }
   emit_rex(dst, kPointerSize);
   emit(0xB8 | dst.low_bits());
   emitp(value, rmode);
@@ -3008,6 +3111,50 @@ void Assembler::divsd(XMMRegister dst, XMMRegister src) {
 }
 
 
+void Assembler::emit_vex_f2_0f(XMMRegister reg,
+                               XMMRegister vreg,
+                               byte rm_rex_bits) {
+  // The R, X, B and vvvv fields are stored inverted.
+  byte r = reg.high_bit() ? 0 : 0x80;
+  byte vvvv = (~vreg.code() & 0xF) << 3;
+  const byte kL128 = 0x0;
+  const byte kPpF2 = 0x3;
+  if (rm_rex_bits == 0) {
+    emit(0xC5);
+    emit(r | vvvv | kL128 | kPpF2);
+  } else {
+    const byte kMap0F = 0x1;
+    emit(0xC4);
+    emit(r | ((~rm_rex_bits & 0x3) << 5) | kMap0F);
+    emit(vvvv | kL128 | kPpF2);  // W0.
+  }
+}
+
+
+void Assembler::vsd(byte op,
+                    XMMRegister dst,
+                    XMMRegister src1,
+                    XMMRegister src2) {
+  ASSERT(IsEnabled(AVX));
+  EnsureSpace ensure_space(this);
+  emit_vex_f2_0f(dst, src1, src2.high_bit());
+  emit(op);
+  emit_sse_operand(dst, src2);
+}
+
+
+void Assembler::vsd(byte op,
+                    XMMRegister dst,
+                    XMMRegister src1,
+                    const Operand& src2) {
+  ASSERT(IsEnabled(AVX));
+  EnsureSpace ensure_space(this);
+  emit_vex_f2_0f(dst, src1, src2.rex_);
+  emit(op);
+  emit_sse_operand(dst, src2);
+}
+
+
 void Assembler::andpd(XMMRegister dst, XMMRegister src) {
   EnsureSpace ensure_space(this);
   emit(0x66);
@@ -3104,6 +3251,37 @@ void Assembler::movmskpd(Register dst, XMMRegister src) {
 }
 
 
+void Assembler::pcmpeqb(XMMRegister dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x74);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::pmovmskb(Register dst, XMMRegister src) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0xD7);
+  emit_sse_operand(dst, src);
+}
+
+
+void Assembler::pshufd(XMMRegister dst, XMMRegister src, byte shuffle) {
+  EnsureSpace ensure_space(this);
+  emit(0x66);
+  emit_optional_rex_32(dst, src);
+  emit(0x0F);
+  emit(0x70);
+  emit_sse_operand(dst, src);
+  emit(shuffle);
+}
+
+
 void Assembler::movmskps(Register dst, XMMRegister src) {
   EnsureSpace ensure_space(this);
   emit_optional_rex_32(dst, src);
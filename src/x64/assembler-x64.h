@@ -456,6 +456,9 @@ class CpuFeatures : public AllStatic {
     if (f == SSE4_1 && !FLAG_enable_sse4_1) return false;
     if (f == CMOV && !FLAG_enable_cmov) return false;
     if (f == SAHF && !FLAG_enable_sahf) return false;
+    if ((f == AVX || f == AVX2) && !FLAG_enable_avx) return false;
+    if ((f == POPCNT || f == LZCNT) && !FLAG_enable_popcnt) return false;
+    if ((f == BMI1 || f == BMI2) && !FLAG_enable_bmi) return false;
     return Check(f, supported_);
   }
 
@@ -556,7 +559,10 @@ class Assembler : public AssemblerBase {
   // These functions convert between absolute Addresses of Code objects and
   // the relative displacements stored in the code.
   static inline Address target_address_at(Address pc);
-  static inline void set_target_address_at(Address pc, Address target);
+  static inline void set_target_address_at(
+      Address pc,
+      Address target,
+      ICacheFlushMode icache_flush_mode = FLUSH_ICACHE_IF_NEEDED);
 
   // Return the code target address at a call site from the return address
   // of that call in the instruction stream.
@@ -709,7 +715,9 @@ class Assembler : public AssemblerBase {
   // position (after the move) to the destination.
   void movl(const Operand& dst, Label* src);
 
-  // Loads a pointer into a register with a relocation mode.
+  // Loads a pointer into a register with a relocation mode.  With
+  // --enable-embedded-constant-pool, embedded objects are loaded
+  // rip-relative from the constant pool emitted by GetCode instead.
   void movp(Register dst, void* ptr, RelocInfo::Mode rmode);
 
   // Loads a 64-bit immediate into a register.
@@ -1194,7 +1202,11 @@ class Assembler : public AssemblerBase {
   // Bit operations.
   void bt(const Operand& dst, Register src);
   void bts(const Operand& dst, Register src);
+  void bsfl(Register dst, Register src);
   void bsrl(Register dst, Register src);
+  void popcntl(Register dst, Register src);  // Requires POPCNT.
+  void lzcntl(Register dst, Register src);  // Requires LZCNT.
+  void tzcntl(Register dst, Register src);  // Requires BMI1.
 
   // Miscellaneous
   void clc();
@@ -1407,6 +1419,27 @@ class Assembler : public AssemblerBase {
   void mulsd(XMMRegister dst, const Operand& src);
   void divsd(XMMRegister dst, XMMRegister src);
 
+  // AVX three operand forms of the scalar double arithmetic above, computing
+  // dst = src1 op src2 without clobbering src1.
+  void vaddsd(XMMRegister dst, XMMRegister src1, XMMRegister src2) {
+    vsd(0x58, dst, src1, src2);
+  }
+  void vaddsd(XMMRegister dst, XMMRegister src1, const Operand& src2) {
+    vsd(0x58, dst, src1, src2);
+  }
+  void vsubsd(XMMRegister dst, XMMRegister src1, XMMRegister src2) {
+    vsd(0x5C, dst, src1, src2);
+  }
+  void vmulsd(XMMRegister dst, XMMRegister src1, XMMRegister src2) {
+    vsd(0x59, dst, src1, src2);
+  }
+  void vmulsd(XMMRegister dst, XMMRegister src1, const Operand& src2) {
+    vsd(0x59, dst, src1, src2);
+  }
+  void vdivsd(XMMRegister dst, XMMRegister src1, XMMRegister src2) {
+    vsd(0x5E, dst, src1, src2);
+  }
+
   void andpd(XMMRegister dst, XMMRegister src);
   void orpd(XMMRegister dst, XMMRegister src);
   void xorpd(XMMRegister dst, XMMRegister src);
@@ -1418,6 +1451,11 @@ class Assembler : public AssemblerBase {
 
   void movmskpd(Register dst, XMMRegister src);
 
+  // Packed integer instructions.
+  void pcmpeqb(XMMRegister dst, XMMRegister src);
+  void pmovmskb(Register dst, XMMRegister src);
+  void pshufd(XMMRegister dst, XMMRegister src, byte shuffle);
+
   // SSE 4.1 instruction
   void extractps(Register dst, XMMRegister src, byte imm8);
 
@@ -1588,6 +1626,14 @@ class Assembler : public AssemblerBase {
   // numbers have a high bit set.
   inline void emit_optional_rex_32(const Operand& op);
 
+  // Emits the VEX prefix of a 128-bit, W0 instruction in the 0F opcode map
+  // with an implied 0xF2 prefix. 'rm_rex_bits' are the REX.X and REX.B bits
+  // of the r/m operand; the two byte form is used when both are clear.
+  void emit_vex_f2_0f(XMMRegister reg, XMMRegister vreg, byte rm_rex_bits);
+
+  void vsd(byte op, XMMRegister dst, XMMRegister src1, XMMRegister src2);
+  void vsd(byte op, XMMRegister dst, XMMRegister src1, const Operand& src2);
+
   template<class P1>
   void emit_rex(P1 p1, int size) {
     if (size == kInt64Size) {
@@ -1698,6 +1744,19 @@ class Assembler : public AssemblerBase {
   void emit_mov(Register dst, Immediate value, int size);
   void emit_mov(const Operand& dst, Immediate value, int size);
 
+  // Whether embedded objects may be loaded from the constant pool.  The
+  // pool is emitted by GetCode, so code patched in place or whose size
+  // must be predictable keeps its immediates.
+  bool constant_pool_available() const {
+    return FLAG_enable_embedded_constant_pool &&
+           own_buffer_ &&
+           !predictable_code_size();
+  }
+
+  // Emits the constant pool, one reloc-recorded slot per distinct object,
+  // and points the pending rip-relative loads at their slots.
+  void EmitConstantPool();
+
   friend class CodePatcher;
   friend class EnsureSpace;
   friend class RegExpMacroAssemblerX64;
@@ -1707,6 +1766,16 @@ class Assembler : public AssemblerBase {
 
   List< Handle<Code> > code_targets_;
 
+  // A rip-relative load from the constant pool whose displacement is
+  // patched once the pool is emitted.
+  struct ConstantPoolLoad {
+    ConstantPoolLoad(int disp_offset, void* value)
+        : disp_offset(disp_offset), value(value) { }
+    int disp_offset;
+    void* value;
+  };
+  List<ConstantPoolLoad> pending_constant_pool_loads_;
+
   PositionsRecorder positions_recorder_;
   friend class PositionsRecorder;
 };
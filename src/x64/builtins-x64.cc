@@ -1019,7 +1019,37 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ bind(&push_receiver);
     __ push(rbx);
 
+    // Packed fast elements of an array are pushed straight from the backing
+    // store, provided the length still is the limit computed above.
+    Label generic, fast_entry, fast_loop, call;
+    __ movp(rdx, Operand(rbp, kArgumentsOffset));
+    __ JumpIfSmi(rdx, &generic);
+    __ CmpObjectType(rdx, JS_ARRAY_TYPE, rcx);
+    __ j(not_equal, &generic);
+    __ movzxbl(rcx, FieldOperand(rcx, Map::kBitField2Offset));
+    __ andl(rcx, Immediate(Map::kElementsKindMask));
+    __ cmpl(rcx, Immediate(FAST_SMI_ELEMENTS << Map::kElementsKindShift));
+    __ j(equal, &fast_entry, Label::kNear);
+    __ cmpl(rcx, Immediate(FAST_ELEMENTS << Map::kElementsKindShift));
+    __ j(not_equal, &generic);
+    __ bind(&fast_entry);
+    __ movp(rax, Operand(rbp, kLimitOffset));
+    __ cmpq(rax, FieldOperand(rdx, JSArray::kLengthOffset));
+    __ j(not_equal, &generic);
+    __ movp(rdx, FieldOperand(rdx, JSObject::kElementsOffset));
+    __ SmiToInteger64(r9, rax);
+    __ Set(r8, 0);
+    __ testq(r9, r9);
+    __ j(zero, &call);
+    __ bind(&fast_loop);
+    __ push(FieldOperand(rdx, r8, times_pointer_size, FixedArray::kHeaderSize));
+    __ incq(r8);
+    __ cmpq(r8, r9);
+    __ j(not_equal, &fast_loop);
+    __ jmp(&call);
+
     // Copy all arguments from the array to the stack.
+    __ bind(&generic);
     Label entry, loop;
     __ movp(rax, Operand(rbp, kIndexOffset));
     __ jmp(&entry);
@@ -1048,6 +1078,7 @@ void Builtins::Generate_FunctionApply(MacroAssembler* masm) {
     __ j(not_equal, &loop);
 
     // Call the function.
+    __ bind(&call);
     Label call_proxy;
     ParameterCount actual(rax);
     __ SmiToInteger32(rax, rax);
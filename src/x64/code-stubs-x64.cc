@@ -166,6 +166,26 @@ void KeyedLoadFieldStub::InitializeInterfaceDescriptor(
 }
 
 
+void LoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { rax };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
+void KeyedLoadConstantStub::InitializeInterfaceDescriptor(
+    Isolate* isolate,
+    CodeStubInterfaceDescriptor* descriptor) {
+  static Register registers[] = { rdx };
+  descriptor->register_param_count_ = 1;
+  descriptor->register_params_ = registers;
+  descriptor->deoptimization_handler_ = NULL;
+}
+
+
 void KeyedStoreFastElementStub::InitializeInterfaceDescriptor(
     Isolate* isolate,
     CodeStubInterfaceDescriptor* descriptor) {
@@ -2437,6 +2457,8 @@ void CodeStub::GenerateStubsAheadOfTime(Isolate* isolate) {
   CreateAllocationSiteStub::GenerateAheadOfTime(isolate);
   BinaryOpICStub::GenerateAheadOfTime(isolate);
   BinaryOpICWithAllocationSiteStub::GenerateAheadOfTime(isolate);
+  KeyedLoadFastElementStub::GenerateAheadOfTime(isolate);
+  TransitionElementsKindStub::GenerateAheadOfTime(isolate);
 }
 
 
@@ -3337,6 +3359,15 @@ void SubStringStub::Generate(MacroAssembler* masm) {
   __ SmiCompare(rcx, Smi::FromInt(1));
   __ j(equal, &single_char);
 
+  // Empty substrings need no allocation.
+  Label not_empty;
+  __ SmiTest(rcx);
+  __ j(not_zero, &not_empty);
+  __ LoadRoot(rax, Heap::kempty_stringRootIndex);
+  __ IncrementCounter(counters->sub_string_native(), 1);
+  __ ret(SUB_STRING_ARGUMENT_COUNT * kPointerSize);
+  __ bind(&not_empty);
+
   __ SmiToInteger32(rcx, rcx);
 
   // rax: string
@@ -628,6 +628,116 @@ void MathExpGenerator::EmitMathExp(MacroAssembler* masm,
   __ bind(&done);
 }
 
+
+void MathLogGenerator::EmitMathLog(MacroAssembler* masm,
+                                   XMMRegister input,
+                                   XMMRegister result,
+                                   XMMRegister double_scratch1,
+                                   XMMRegister double_scratch2,
+                                   Register temp1,
+                                   Register temp2) {
+  ASSERT(!input.is(result));
+  ASSERT(!input.is(double_scratch1) && !input.is(double_scratch2));
+  ASSERT(!result.is(double_scratch1) && !result.is(double_scratch2));
+  ASSERT(!double_scratch1.is(double_scratch2));
+  ASSERT(!temp1.is(temp2));
+
+  Label normalized, special, positive, zero_or_negative, nan, done;
+
+  // Positive normal numbers have a biased exponent (including the sign bit)
+  // in the range [1, 0x7fe].
+  __ movq(temp1, input);
+  __ movq(kScratchRegister, temp1);
+  __ shr(kScratchRegister, Immediate(HeapNumber::kMantissaBits));
+  __ subq(kScratchRegister, Immediate(1));
+  __ cmpq(kScratchRegister, Immediate(0x7fe));
+  __ j(above_equal, &special);
+  __ Set(temp2, -HeapNumber::kExponentBias);
+
+  // Split x = 2^k * m with m in [sqrt(2)/2, sqrt(2)). temp1 holds the bits
+  // of a positive normal number and temp2 the bias of its exponent.
+  __ bind(&normalized);
+  __ movq(kScratchRegister, temp1);
+  __ shr(kScratchRegister, Immediate(HeapNumber::kMantissaBits));
+  __ addq(temp2, kScratchRegister);
+  __ shl(temp1, Immediate(64 - HeapNumber::kMantissaBits));
+  __ shr(temp1, Immediate(64 - HeapNumber::kMantissaBits));
+  // Carries into bit 52 iff the significand is at least sqrt(2).
+  __ movq(kScratchRegister, V8_INT64_C(0x00095f6400000000));
+  __ addq(kScratchRegister, temp1);
+  __ shr(kScratchRegister, Immediate(HeapNumber::kMantissaBits));
+  __ addq(temp2, kScratchRegister);
+  __ neg(kScratchRegister);
+  __ addq(kScratchRegister, Immediate(0x3ff));
+  __ shl(kScratchRegister, Immediate(HeapNumber::kMantissaBits));
+  __ or_(temp1, kScratchRegister);
+  __ movq(input, temp1);
+
+  // With f = m - 1 and s = f / (2 + f), log(m) = f - hfsq + s * (hfsq + R)
+  // where hfsq = f * f / 2 and R is a polynomial in s * s.
+  __ Move(kScratchRegister, ExternalReference::math_log_constants(0));
+  __ movsd(double_scratch1, Operand(kScratchRegister, 1 * kDoubleSize));
+  __ subsd(input, double_scratch1);
+  __ movsd(result, Operand(kScratchRegister, 2 * kDoubleSize));
+  __ addsd(result, input);
+  __ movsd(double_scratch1, input);
+  __ divsd(double_scratch1, result);
+  __ movsd(result, double_scratch1);
+  __ mulsd(result, double_scratch1);
+  __ movsd(double_scratch2, Operand(kScratchRegister, 3 * kDoubleSize));
+  __ mulsd(double_scratch2, result);
+  for (int i = 4; i <= 9; i++) {
+    __ addsd(double_scratch2, Operand(kScratchRegister, i * kDoubleSize));
+    __ mulsd(double_scratch2, result);
+  }
+  __ movsd(result, input);
+  __ mulsd(result, input);
+  __ mulsd(result, Operand(kScratchRegister, 10 * kDoubleSize));
+  __ addsd(double_scratch2, result);
+  __ mulsd(double_scratch2, double_scratch1);
+  // log(x) = k * ln2_hi - ((hfsq - (s * (hfsq + R) + k * ln2_lo)) - f).
+  __ Cvtlsi2sd(double_scratch1, temp2);
+  __ mulsd(double_scratch1, Operand(kScratchRegister, 11 * kDoubleSize));
+  __ addsd(double_scratch2, double_scratch1);
+  __ subsd(result, double_scratch2);
+  __ subsd(result, input);
+  __ Cvtlsi2sd(double_scratch1, temp2);
+  __ mulsd(double_scratch1, Operand(kScratchRegister, 12 * kDoubleSize));
+  __ subsd(double_scratch1, result);
+  __ movsd(result, double_scratch1);
+  __ jmp(&done);
+
+  // NaN, zero, negative, infinite and subnormal inputs.
+  __ bind(&special);
+  __ xorps(double_scratch1, double_scratch1);
+  __ ucomisd(input, double_scratch1);
+  __ j(above, &positive, Label::kNear);
+  __ j(parity_odd, &zero_or_negative, Label::kNear);
+  __ bind(&nan);
+  __ Move(kScratchRegister,
+          ExternalReference::address_of_canonical_non_hole_nan());
+  __ movsd(result, Operand(kScratchRegister, 0));
+  __ jmp(&done);
+  __ bind(&zero_or_negative);
+  __ j(not_equal, &nan, Label::kNear);
+  __ Move(kScratchRegister, ExternalReference::address_of_negative_infinity());
+  __ movsd(result, Operand(kScratchRegister, 0));
+  __ jmp(&done);
+  __ bind(&positive);
+  // The biased exponent minus one is still in kScratchRegister. It is
+  // positive for infinity and -1 for subnormals.
+  __ movsd(result, input);
+  __ cmpq(kScratchRegister, Immediate(0));
+  __ j(greater, &done);
+  __ Move(kScratchRegister, ExternalReference::math_log_constants(0));
+  __ mulsd(input, Operand(kScratchRegister, 0));
+  __ movq(temp1, input);
+  __ Set(temp2, -HeapNumber::kExponentBias - 54);
+  __ jmp(&normalized);
+
+  __ bind(&done);
+}
+
 #undef __
 
 
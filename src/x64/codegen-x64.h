@@ -68,6 +68,22 @@ class MathExpGenerator : public AllStatic {
 };
 
 
+class MathLogGenerator : public AllStatic {
+ public:
+  // Register input is clobbered.
+  static void EmitMathLog(MacroAssembler* masm,
+                          XMMRegister input,
+                          XMMRegister result,
+                          XMMRegister double_scratch1,
+                          XMMRegister double_scratch2,
+                          Register temp1,
+                          Register temp2);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MathLogGenerator);
+};
+
+
 enum StackArgumentsAccessorReceiverMode {
   ARGUMENTS_CONTAIN_RECEIVER,
   ARGUMENTS_DONT_CONTAIN_RECEIVER
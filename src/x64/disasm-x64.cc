@@ -428,6 +428,7 @@ class DisassemblerX64 {
   int PrintImmediateOp(byte* data);
   const char* TwoByteMnemonic(byte opcode);
   int TwoByteOpcodeInstruction(byte* data);
+  int AVXInstruction(byte* data);
   int F6F7Instruction(byte* data);
   int ShiftInstruction(byte* data);
   int JumpShort(byte* data);
@@ -1089,6 +1090,14 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
       } else if (opcode == 0x50) {
         AppendToBuffer("movmskpd %s,", NameOfCPURegister(regop));
         current += PrintRightXMMOperand(current);
+      } else if (opcode == 0xD7) {
+        AppendToBuffer("pmovmskb %s,", NameOfCPURegister(regop));
+        current += PrintRightXMMOperand(current);
+      } else if (opcode == 0x70) {
+        AppendToBuffer("pshufd %s,", NameOfXMMRegister(regop));
+        current += PrintRightXMMOperand(current);
+        AppendToBuffer(",0x%x", *current);
+        current += 1;
       } else if (opcode == 0x73) {
         current += 1;
         ASSERT(regop == 6);
@@ -1106,6 +1115,8 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
           mnemonic = "ucomisd";
         } else if (opcode == 0x2F) {
           mnemonic = "comisd";
+        } else if (opcode == 0x74) {
+          mnemonic = "pcmpeqb";
         } else {
           UnimplementedInstruction();
         }
@@ -1217,6 +1228,16 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
       get_modrm(*current, &mod, &regop, &rm);
       AppendToBuffer("movq %s,", NameOfXMMRegister(regop));
       current += PrintRightXMMOperand(current);
+    } else if (opcode == 0xB8 || opcode == 0xBC || opcode == 0xBD) {
+      // POPCNT, TZCNT and LZCNT.
+      const char* mnem = "popcnt";
+      if (opcode == 0xBC) mnem = "tzcnt";
+      if (opcode == 0xBD) mnem = "lzcnt";
+      int mod, regop, rm;
+      get_modrm(*current, &mod, &regop, &rm);
+      AppendToBuffer("%s%c %s,",
+          mnem, operand_size_code(), NameOfCPURegister(regop));
+      current += PrintRightOperand(current);
     } else {
       UnimplementedInstruction();
     }
@@ -1324,7 +1345,7 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
     } else {
       AppendToBuffer(",%s,cl", NameOfCPURegister(regop));
     }
-  } else if (opcode == 0xBD) {
+  } else if (opcode == 0xBC || opcode == 0xBD) {
     AppendToBuffer("%s%c ", mnemonic, operand_size_code());
     int mod, regop, rm;
     get_modrm(*current, &mod, &regop, &rm);
@@ -1340,6 +1361,39 @@ int DisassemblerX64::TwoByteOpcodeInstruction(byte* data) {
 // Mnemonics for two-byte opcode instructions starting with 0x0F.
 // The argument is the second byte of the two-byte opcode.
 // Returns NULL if the instruction is not handled here.
+// Handles the VEX encoded instructions emitted by the assembler, which are
+// only the scalar double arithmetic in the 0F opcode map with an implied 0xF2
+// prefix.
+int DisassemblerX64::AVXInstruction(byte* data) {
+  byte* current = data + 1;
+  // The R, X, B and vvvv fields are stored inverted.
+  byte rex = 0x40 | ((*current & 0x80) ? 0 : 0x04);
+  int map = 1;
+  if (*data == 0xC4) {
+    if ((*current & 0x40) == 0) rex |= 0x02;
+    if ((*current & 0x20) == 0) rex |= 0x01;
+    map = *current & 0x1F;
+    current++;
+  }
+  byte vex = *current++;
+  setRex(rex);
+  int vvvv = (~vex >> 3) & 0xF;
+  int pp = vex & 0x3;
+  byte opcode = *current++;
+  if (map == 1 && pp == 3 &&
+      (opcode == 0x58 || opcode == 0x59 || opcode == 0x5C || opcode == 0x5E)) {
+    int mod, regop, rm;
+    get_modrm(*current, &mod, &regop, &rm);
+    AppendToBuffer("v%s %s,%s,", TwoByteMnemonic(opcode),
+                   NameOfXMMRegister(regop), NameOfXMMRegister(vvvv));
+    current += PrintRightXMMOperand(current);
+  } else {
+    UnimplementedInstruction();
+  }
+  return static_cast<int>(current - data);
+}
+
+
 const char* DisassemblerX64::TwoByteMnemonic(byte opcode) {
   switch (opcode) {
     case 0x1F:
@@ -1372,6 +1426,8 @@ const char* DisassemblerX64::TwoByteMnemonic(byte opcode) {
       return "movzxb";
     case 0xB7:
       return "movzxw";
+    case 0xBC:
+      return "bsf";
     case 0xBD:
       return "bsr";
     case 0xBE:
@@ -1502,6 +1558,12 @@ int DisassemblerX64::InstructionDecode(v8::internal::Vector<char> out_buffer,
   // need to do special processing on it.
   if (!processed) {
     switch (*data) {
+      case 0xC4:
+      case 0xC5:
+        // VEX prefix, since LES and LDS are invalid in 64-bit mode.
+        data += AVXInstruction(data);
+        break;
+
       case 0xC2:
         AppendToBuffer("ret 0x%x", *reinterpret_cast<uint16_t*>(data + 1));
         data += 3;
@@ -1962,7 +1962,7 @@ void FullCodeGenerator::VisitYield(Yield* expr) {
       __ push(result_register());
       // Fall through.
     case Yield::INITIAL: {
-      Label suspend, continuation, post_runtime, resume;
+      Label suspend, continuation, post_runtime, resume, save_in_runtime;
 
       __ jmp(&suspend);
 
@@ -1981,6 +1981,44 @@ void FullCodeGenerator::VisitYield(Yield* expr) {
       __ lea(rbx, Operand(rbp, StandardFrameConstants::kExpressionsOffset));
       __ cmpq(rsp, rbx);
       __ j(equal, &post_runtime);
+
+      // Save an operand stack without stack handlers into a new-space array
+      // inline.  Handlers in this frame lie below the frame pointer.
+      ExternalReference handler_address(Isolate::kHandlerAddress, isolate());
+      __ movp(rcx, masm_->ExternalOperand(handler_address));
+      __ cmpq(rcx, rbp);
+      __ j(below, &save_in_runtime);
+      // The operands lie between rbx and the yielded value at rsp.
+      __ movp(rdx, rbx);
+      __ subq(rdx, rsp);
+      __ shr(rdx, Immediate(kPointerSizeLog2));
+      __ cmpq(rdx, Immediate((Page::kMaxRegularHeapObjectSize -
+                              FixedArray::kHeaderSize) / kPointerSize));
+      __ j(above, &save_in_runtime);
+      __ Allocate(FixedArray::kHeaderSize, times_pointer_size, rdx, rcx, rdi,
+                  no_reg, &save_in_runtime, TAG_OBJECT);
+      __ LoadRoot(kScratchRegister, Heap::kFixedArrayMapRootIndex);
+      __ movp(FieldOperand(rcx, HeapObject::kMapOffset), kScratchRegister);
+      __ Integer32ToSmi(rdi, rdx);
+      __ movp(FieldOperand(rcx, FixedArray::kLengthOffset), rdi);
+      // Operand i is stored at index i, counting from the bottom of the
+      // stack as JavaScriptFrame::SaveOperandStack does.
+      Label copy_operand;
+      __ Set(rdi, 0);
+      __ bind(&copy_operand);
+      __ movp(r8, Operand(rbx, 0));
+      __ movp(FieldOperand(rcx, rdi, times_pointer_size,
+                           FixedArray::kHeaderSize), r8);
+      __ subq(rbx, Immediate(kPointerSize));
+      __ incq(rdi);
+      __ cmpq(rdi, rdx);
+      __ j(less, &copy_operand);
+      __ movp(FieldOperand(rax, JSGeneratorObject::kOperandStackOffset), rcx);
+      __ RecordWriteField(rax, JSGeneratorObject::kOperandStackOffset, rcx, rdx,
+                          kDontSaveFPRegs);
+      __ jmp(&post_runtime);
+
+      __ bind(&save_in_runtime);
       __ push(rax);  // generator object
       __ CallRuntime(Runtime::kSuspendJSGeneratorObject, 1);
       __ movp(context_register(),
@@ -2158,12 +2196,26 @@ void FullCodeGenerator::EmitGeneratorResume(Expression *generator,
   __ movp(rdx, FieldOperand(rdx, FixedArray::kLengthOffset));
   __ SmiToInteger32(rdx, rdx);
 
-  // If we are sending a value and there is no operand stack, we can jump back
-  // in directly.
+  // If we are sending a value and there are no stack handlers to rewind, we
+  // can push the saved operands and jump back in directly.
   if (resume_mode == JSGeneratorObject::NEXT) {
-    Label slow_resume;
+    Label slow_resume, resume_directly, push_operand;
     __ cmpq(rdx, Immediate(0));
-    __ j(not_zero, &slow_resume);
+    __ j(zero, &resume_directly);
+    __ SmiCompare(
+        FieldOperand(rbx, JSGeneratorObject::kStackHandlerIndexOffset),
+        Smi::FromInt(-1));
+    __ j(not_equal, &slow_resume);
+    __ movp(rcx, FieldOperand(rbx, JSGeneratorObject::kOperandStackOffset));
+    __ Set(r8, 0);
+    __ bind(&push_operand);
+    __ push(FieldOperand(rcx, r8, times_pointer_size, FixedArray::kHeaderSize));
+    __ incq(r8);
+    __ cmpq(r8, rdx);
+    __ j(less, &push_operand);
+    __ LoadRoot(rcx, Heap::kEmptyFixedArrayRootIndex);
+    __ movp(FieldOperand(rbx, JSGeneratorObject::kOperandStackOffset), rcx);
+    __ bind(&resume_directly);
     __ movp(rdx, FieldOperand(rdi, JSFunction::kCodeEntryOffset));
     __ SmiToInteger64(rcx,
         FieldOperand(rbx, JSGeneratorObject::kContinuationOffset));
@@ -2564,7 +2616,7 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
     // Push the target function under the receiver.
     __ push(Operand(rsp, 0));
     __ movp(Operand(rsp, kPointerSize), rax);
-    flags = CALL_AS_METHOD;
+    flags = RECORD_CALL_TARGET_AS_METHOD;
   }
 
   // Load the arguments.
@@ -2576,6 +2628,10 @@ void FullCodeGenerator::EmitCallWithIC(Call* expr) {
 
   // Record source position for debugger.
   SetSourcePosition(expr->position());
+  if (flags == RECORD_CALL_TARGET_AS_METHOD) {
+    __ Move(rbx, FeedbackVector());
+    __ Move(rdx, Smi::FromInt(expr->CallFeedbackSlot()));
+  }
   CallFunctionStub stub(arg_count, flags);
   __ movp(rdi, Operand(rsp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
@@ -2618,7 +2674,9 @@ void FullCodeGenerator::EmitKeyedCallWithIC(Call* expr,
 
   // Record source position for debugger.
   SetSourcePosition(expr->position());
-  CallFunctionStub stub(arg_count, CALL_AS_METHOD);
+  __ Move(rbx, FeedbackVector());
+  __ Move(rdx, Smi::FromInt(expr->CallFeedbackSlot()));
+  CallFunctionStub stub(arg_count, RECORD_CALL_TARGET_AS_METHOD);
   __ movp(rdi, Operand(rsp, (arg_count + 1) * kPointerSize));
   __ CallStub(&stub);
 
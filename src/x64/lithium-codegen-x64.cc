@@ -89,10 +89,23 @@ void LCodeGen::FinishCode(Handle<Code> code) {
   code->set_safepoint_table_offset(safepoints_.GetCodeOffset());
   if (code->is_optimized_code()) RegisterWeakObjectsInOptimizedCode(code);
   PopulateDeoptimizationData(code);
+  PopulateHandlerTable(code);
   info()->CommitDependencies(code);
 }
 
 
+void LCodeGen::PopulateHandlerTable(Handle<Code> code) {
+  int length = landing_pads_.length();
+  if (length == 0) return;
+  Handle<FixedArray> handler_table =
+      factory()->NewFixedArray(length, TENURED);
+  for (int i = 0; i < length; i++) {
+    handler_table->set(i, Smi::FromInt(landing_pads_[i]->pos()));
+  }
+  code->set_handler_table(*handler_table);
+}
+
+
 void LChunkBuilder::Abort(BailoutReason reason) {
   info()->set_bailout_reason(reason);
   status_ = ABORTED;
@@ -513,6 +526,14 @@ void LCodeGen::WriteTranslation(LEnvironment* environment,
   int object_index = 0;
   int dematerialized_index = 0;
   for (int i = 0; i < translation_size; ++i) {
+    if (environment->HasStackHandlerAt(i)) {
+      // The handler words are translated from the highest address down.
+      for (int j = StackHandlerConstants::kSlotCount - 1; j >= 0; --j) {
+        translation->StoreStackHandlerSlot(j, environment->handler_index());
+      }
+      i += StackHandlerConstants::kSlotCount - 1;
+      continue;
+    }
     LOperand* value = environment->values()->at(i);
     AddToTranslation(environment,
                      translation,
@@ -1826,6 +1847,27 @@ void LCodeGen::DoArithmeticD(LArithmeticD* instr) {
   XMMRegister left = ToDoubleRegister(instr->left());
   XMMRegister right = ToDoubleRegister(instr->right());
   XMMRegister result = ToDoubleRegister(instr->result());
+  if (CpuFeatures::IsSupported(AVX) && instr->op() != Token::MOD) {
+    CpuFeatureScope scope(masm(), AVX);
+    switch (instr->op()) {
+      case Token::ADD:
+        __ vaddsd(result, left, right);
+        break;
+      case Token::SUB:
+        __ vsubsd(result, left, right);
+        break;
+      case Token::MUL:
+        __ vmulsd(result, left, right);
+        break;
+      case Token::DIV:
+        __ vdivsd(result, left, right);
+        break;
+      default:
+        UNREACHABLE();
+        break;
+    }
+    return;
+  }
   // All operations except MOD are computed in-place.
   ASSERT(instr->op() == Token::MOD || left.is(result));
   switch (instr->op()) {
@@ -3711,35 +3753,15 @@ void LCodeGen::DoMathExp(LMathExp* instr) {
 
 
 void LCodeGen::DoMathLog(LMathLog* instr) {
-  ASSERT(instr->value()->Equals(instr->result()));
-  XMMRegister input_reg = ToDoubleRegister(instr->value());
-  XMMRegister xmm_scratch = double_scratch0();
-  Label positive, done, zero;
-  __ xorps(xmm_scratch, xmm_scratch);
-  __ ucomisd(input_reg, xmm_scratch);
-  __ j(above, &positive, Label::kNear);
-  __ j(not_carry, &zero, Label::kNear);
-  ExternalReference nan =
-      ExternalReference::address_of_canonical_non_hole_nan();
-  Operand nan_operand = masm()->ExternalOperand(nan);
-  __ movsd(input_reg, nan_operand);
-  __ jmp(&done, Label::kNear);
-  __ bind(&zero);
-  ExternalReference ninf =
-      ExternalReference::address_of_negative_infinity();
-  Operand ninf_operand = masm()->ExternalOperand(ninf);
-  __ movsd(input_reg, ninf_operand);
-  __ jmp(&done, Label::kNear);
-  __ bind(&positive);
-  __ fldln2();
-  __ subq(rsp, Immediate(kDoubleSize));
-  __ movsd(Operand(rsp, 0), input_reg);
-  __ fld_d(Operand(rsp, 0));
-  __ fyl2x();
-  __ fstp_d(Operand(rsp, 0));
-  __ movsd(input_reg, Operand(rsp, 0));
-  __ addq(rsp, Immediate(kDoubleSize));
-  __ bind(&done);
+  XMMRegister input = ToDoubleRegister(instr->value());
+  XMMRegister result = ToDoubleRegister(instr->result());
+  XMMRegister double_scratch1 = double_scratch0();
+  XMMRegister double_scratch2 = ToDoubleRegister(instr->double_temp());
+  Register temp1 = ToRegister(instr->temp1());
+  Register temp2 = ToRegister(instr->temp2());
+
+  MathLogGenerator::EmitMathLog(masm(), input, result, double_scratch1,
+                                double_scratch2, temp1, temp2);
 }
 
 
@@ -4115,8 +4137,9 @@ void LCodeGen::DoStoreKeyedExternalArray(LStoreKeyed* instr) {
   if (elements_kind == EXTERNAL_FLOAT32_ELEMENTS ||
       elements_kind == FLOAT32_ELEMENTS) {
     XMMRegister value(ToDoubleRegister(instr->value()));
-    __ cvtsd2ss(value, value);
-    __ movss(operand, value);
+    XMMRegister xmm_scratch = double_scratch0();
+    __ cvtsd2ss(xmm_scratch, value);
+    __ movss(operand, xmm_scratch);
   } else if (elements_kind == EXTERNAL_FLOAT64_ELEMENTS ||
              elements_kind == FLOAT64_ELEMENTS) {
     __ movsd(operand, ToDoubleRegister(instr->value()));
@@ -5519,6 +5542,48 @@ void LCodeGen::DoStackCheck(LStackCheck* instr) {
 }
 
 
+void LCodeGen::DoEnterTry(LEnterTry* instr) {
+  class DeferredLandingPad V8_FINAL : public LDeferredCode {
+   public:
+    DeferredLandingPad(LCodeGen* codegen, LEnterTry* instr)
+        : LDeferredCode(codegen), instr_(instr) { }
+    virtual void Generate() V8_OVERRIDE {
+      codegen()->DoDeferredLandingPad(instr_);
+    }
+    virtual LInstruction* instr() V8_OVERRIDE { return instr_; }
+   private:
+    LEnterTry* instr_;
+  };
+
+  DeferredLandingPad* deferred = new(zone()) DeferredLandingPad(this, instr);
+  int handler_index = landing_pads_.length();
+  landing_pads_.Add(deferred->entry(), zone());
+  // The handler records the function context, which the unwinding code
+  // stores back into the frame.
+  __ movp(rsi, Operand(rbp, StandardFrameConstants::kContextOffset));
+  __ PushTryHandler(StackHandler::CATCH, handler_index);
+  __ bind(deferred->exit());
+}
+
+
+void LCodeGen::DoDeferredLandingPad(LEnterTry* instr) {
+  // The exception is in rax and the handler has already been unlinked, so
+  // deoptimize to the start of the catch block with the exception as the top
+  // of the expression stack.  The values of the catch environment were kept
+  // in their stack slots by the register allocator.
+  LEnvironment* environment = instr->environment();
+  environment->SetValueAt(
+      environment->translation_size() - 1,
+      LRegister::Create(Register::ToAllocationIndex(rax), zone()));
+  DeoptimizeIf(no_condition, environment, Deoptimizer::LAZY);
+}
+
+
+void LCodeGen::DoLeaveTry(LLeaveTry* instr) {
+  __ PopTryHandler();
+}
+
+
 void LCodeGen::DoOsrEntry(LOsrEntry* instr) {
   // This is a pseudo-instruction that ensures that the environment here is
   // properly registered for deoptimization and records the assembler's PC
@@ -56,6 +56,7 @@ class LCodeGen: public LCodeGenBase {
         scope_(info->scope()),
         translations_(info->zone()),
         deferred_(8, info->zone()),
+        landing_pads_(0, info->zone()),
         osr_pc_offset_(-1),
         frame_is_built_(false),
         safepoints_(info->zone()),
@@ -116,6 +117,7 @@ class LCodeGen: public LCodeGenBase {
   void DoDeferredInstanceOfKnownGlobal(LInstanceOfKnownGlobal* instr,
                                        Label* map_check);
   void DoDeferredInstanceMigration(LCheckMaps* instr, Register object);
+  void DoDeferredLandingPad(LEnterTry* instr);
 
 // Parallel move support.
   void DoParallelMove(LParallelMove* move);
@@ -238,6 +240,7 @@ class LCodeGen: public LCodeGenBase {
                         int* object_index_pointer,
                         int* dematerialized_index_pointer);
   void PopulateDeoptimizationData(Handle<Code> code);
+  void PopulateHandlerTable(Handle<Code> code);
   int DefineDeoptimizationLiteral(Handle<Object> literal);
 
   void PopulateDeoptimizationLiteralsWithInlinedFunctions();
@@ -344,6 +347,8 @@ class LCodeGen: public LCodeGenBase {
   Scope* const scope_;
   TranslationBuffer translations_;
   ZoneList<LDeferredCode*> deferred_;
+  // Entries of the handler table, indexed by try handler.
+  ZoneList<Label*> landing_pads_;
   int osr_pc_offset_;
   bool frame_is_built_;
 
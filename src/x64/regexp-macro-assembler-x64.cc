@@ -91,6 +91,7 @@ namespace internal {
  *    - success counter      (only useful for global regexp to count matches)
  *    - Offset of location before start of input (effectively character
  *      position -1).  Used to initialize capture registers to a non-position.
+ *    - backtrack counter    (only used if there is a backtrack limit)
  *    - At start of string (if 1, we are starting at the start of the
  *      string, otherwise 0)
  *    - register 0  rbp[-n]   (Only positions must be stored in the first
@@ -147,6 +148,7 @@ RegExpMacroAssemblerX64::~RegExpMacroAssemblerX64() {
   exit_label_.Unuse();
   check_preempt_label_.Unuse();
   stack_overflow_label_.Unuse();
+  backtrack_limit_label_.Unuse();
 }
 
 
@@ -173,6 +175,13 @@ void RegExpMacroAssemblerX64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerX64::Backtrack() {
   CheckPreemption();
+  if (has_backtrack_limit() || count_backtracks()) {
+    __ incq(Operand(rbp, kBacktrackCount));
+  }
+  if (has_backtrack_limit()) {
+    __ cmpq(Operand(rbp, kBacktrackCount), Immediate(backtrack_limit()));
+    __ j(equal, &backtrack_limit_label_);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(rbx);
   __ addq(rbx, code_object_pointer());
@@ -532,6 +541,84 @@ void RegExpMacroAssemblerX64::CheckBitInTable(
 }
 
 
+static void BroadcastByte(MacroAssembler* masm, XMMRegister dst, int value) {
+  uint32_t bytes = static_cast<uint32_t>(value) * 0x01010101u;
+  masm->movl(rbx, Immediate(static_cast<int32_t>(bytes)));
+  masm->movd(dst, rbx);
+  masm->pshufd(dst, dst, 0);
+}
+
+
+bool RegExpMacroAssemblerX64::SkipUntilCharacterAfterAnd(
+    int cp_offset,
+    Vector<const uc16> chars,
+    uc16 and_with) {
+  // Only xmm0 to xmm5 are caller-saved on all platforms, which leaves room
+  // for the mask, three characters, the input block and a scratch register.
+  static const int kMaxChars = 3;
+  static const int kBlockSize = 16;
+  if (mode_ != ASCII || chars.length() == 0 || chars.length() > kMaxChars) {
+    return false;
+  }
+  ASSERT(cp_offset >= 0);
+  bool needs_mask = (and_with & String::kMaxOneByteCharCode) !=
+      String::kMaxOneByteCharCode;
+  int mask = and_with & String::kMaxOneByteCharCode;
+
+  Label block_loop, found_in_block, tail_loop, found, done;
+  // rax holds the offset from the end of the input of the character that is
+  // being tested.  In ASCII mode character and byte offsets agree.
+  __ lea(rax, Operand(rdi, cp_offset));
+  __ testq(rax, rax);
+  __ j(greater_equal, &done);
+  if (needs_mask) BroadcastByte(&masm_, xmm0, mask);
+  for (int i = 0; i < chars.length(); i++) {
+    BroadcastByte(&masm_, XMMRegister::from_code(i + 1), chars[i] & mask);
+  }
+
+  // Test 16 characters at a time while they are all inside the input.
+  __ bind(&block_loop);
+  __ lea(rbx, Operand(rax, kBlockSize));
+  __ cmpq(rbx, Immediate(0));
+  __ j(greater, &tail_loop);
+  __ movdqu(xmm4, Operand(rsi, rax, times_1, 0));
+  if (needs_mask) __ andps(xmm4, xmm0);
+  for (int i = 0; i < chars.length(); i++) {
+    __ movaps(xmm5, xmm4);
+    __ pcmpeqb(xmm5, XMMRegister::from_code(i + 1));
+    __ pmovmskb(i == 0 ? rbx : r9, xmm5);
+    if (i != 0) __ orl(rbx, r9);
+  }
+  __ testl(rbx, rbx);
+  __ j(not_zero, &found_in_block);
+  __ addq(rax, Immediate(kBlockSize));
+  __ jmp(&block_loop);
+
+  __ bind(&found_in_block);
+  __ bsfl(rbx, rbx);
+  __ addq(rax, rbx);
+  __ jmp(&found);
+
+  // Test the remaining characters one at a time.
+  __ bind(&tail_loop);
+  __ testq(rax, rax);
+  __ j(greater_equal, &found);
+  __ movzxbl(rbx, Operand(rsi, rax, times_1, 0));
+  if (needs_mask) __ andl(rbx, Immediate(mask));
+  for (int i = 0; i < chars.length(); i++) {
+    __ cmpl(rbx, Immediate(chars[i] & mask));
+    __ j(equal, &found);
+  }
+  __ incq(rax);
+  __ jmp(&tail_loop);
+
+  __ bind(&found);
+  __ lea(rdi, Operand(rax, -cp_offset));
+  __ bind(&done);
+  return true;
+}
+
+
 bool RegExpMacroAssemblerX64::CheckSpecialCharacterClass(uc16 type,
                                                          Label* on_no_match) {
   // Range checks (c in min..max) are generally implemented by an unsigned
@@ -710,6 +797,7 @@ Handle<HeapObject> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
 
   __ push(Immediate(0));  // Number of successful matches in a global regexp.
   __ push(Immediate(0));  // Make room for "input start - 1" constant.
+  __ push(Immediate(0));  // Number of backtracks taken so far.
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -894,6 +982,13 @@ Handle<HeapObject> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
   }
 
   __ bind(&return_rax);
+  if (count_backtracks()) {
+    // Add the backtracks of this execution to the isolate-wide count.
+    __ LoadAddress(r9,
+        ExternalReference::address_of_regexp_backtrack_count(isolate()));
+    __ movp(rbx, Operand(rbp, kBacktrackCount));
+    __ addq(Operand(r9, 0), rbx);
+  }
 #ifdef _WIN64
   // Restore callee save registers.
   __ lea(rsp, Operand(rbp, kLastCalleeSaveRegister));
@@ -994,6 +1089,12 @@ Handle<HeapObject> RegExpMacroAssemblerX64::GetCode(Handle<String> source) {
     __ jmp(&return_rax);
   }
 
+  if (backtrack_limit_label_.is_linked()) {
+    __ bind(&backtrack_limit_label_);
+    __ Set(rax, BACKTRACK_LIMIT);
+    __ jmp(&return_rax);
+  }
+
   FixupCodeRelativePositions();
 
   CodeDesc code_desc;
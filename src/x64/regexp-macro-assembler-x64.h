@@ -77,6 +77,9 @@ class RegExpMacroAssemblerX64: public NativeRegExpMacroAssembler {
                                         uc16 to,
                                         Label* on_not_in_range);
   virtual void CheckBitInTable(Handle<ByteArray> table, Label* on_bit_set);
+  virtual bool SkipUntilCharacterAfterAnd(int cp_offset,
+                                          Vector<const uc16> chars,
+                                          uc16 and_with);
 
   // Checks whether the given offset from the current position is before
   // the end of the string.
@@ -195,9 +198,10 @@ class RegExpMacroAssemblerX64: public NativeRegExpMacroAssembler {
   // When adding local variables remember to push space for them in
   // the frame in GetCode.
   static const int kInputStartMinusOne = kSuccessfulCaptures - kPointerSize;
+  static const int kBacktrackCount = kInputStartMinusOne - kPointerSize;
 
   // First register address. Following registers are below it on the stack.
-  static const int kRegisterZero = kInputStartMinusOne - kPointerSize;
+  static const int kRegisterZero = kBacktrackCount - kPointerSize;
 
   // Initial size of code buffer.
   static const size_t kRegExpCodeSize = 1024;
@@ -293,6 +297,7 @@ class RegExpMacroAssemblerX64: public NativeRegExpMacroAssembler {
   Label exit_label_;
   Label check_preempt_label_;
   Label stack_overflow_label_;
+  Label backtrack_limit_label_;
 };
 
 #endif  // V8_INTERPRETED_REGEXP
@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "v8.h"
+#include "platform/mutex.h"
 #include "zone-inl.h"
 
 namespace v8 {
@@ -67,6 +68,113 @@ class Segment {
 };
 
 
+// Pooled segments are chained through their first word.
+struct PooledSegment {
+  PooledSegment* next;
+};
+
+
+static LazyMutex pool_mutex = LAZY_MUTEX_INITIALIZER;
+static PooledSegment* pool_free_lists[ZoneSegmentPool::kSizeClasses];
+static ZoneSegmentPool::Statistics pool_statistics;
+
+
+int ZoneSegmentPool::SizeClassIndex(int size) {
+  int index = 0;
+  int class_size = Zone::kMinimumSegmentSize;
+  while (class_size < size) {
+    class_size <<= 1;
+    index++;
+  }
+  return (class_size == size && index < kSizeClasses)
+      ? index : -1;
+}
+
+
+int ZoneSegmentPool::RoundUpToSizeClass(int size) {
+  if (size > Zone::kMaximumSegmentSize) return size;
+  int class_size = Zone::kMinimumSegmentSize;
+  while (class_size < size) class_size <<= 1;
+  return class_size;
+}
+
+
+void* ZoneSegmentPool::Allocate(int size) {
+  int index = SizeClassIndex(size);
+  if (index >= 0) {
+    LockGuard<Mutex> lock_guard(pool_mutex.Pointer());
+    PooledSegment* segment = pool_free_lists[index];
+    if (segment != NULL) {
+      pool_free_lists[index] = segment->next;
+      pool_statistics.segments_reused++;
+      pool_statistics.segments_pooled--;
+      pool_statistics.pooled_bytes -= size;
+      return segment;
+    }
+    pool_statistics.segments_allocated++;
+  } else {
+    LockGuard<Mutex> lock_guard(pool_mutex.Pointer());
+    pool_statistics.segments_allocated++;
+  }
+  return Malloced::New(size);
+}
+
+
+void ZoneSegmentPool::Release(void* block, int size) {
+  int index = SizeClassIndex(size);
+  if (index >= 0) {
+    intptr_t max_pooled_bytes =
+        static_cast<intptr_t>(FLAG_zone_segment_pool_size) * MB;
+    LockGuard<Mutex> lock_guard(pool_mutex.Pointer());
+    if (pool_statistics.pooled_bytes + size <= max_pooled_bytes) {
+      PooledSegment* segment = reinterpret_cast<PooledSegment*>(block);
+      segment->next = pool_free_lists[index];
+      pool_free_lists[index] = segment;
+      pool_statistics.segments_pooled++;
+      pool_statistics.pooled_bytes += size;
+      pool_statistics.peak_pooled_bytes =
+          Max(pool_statistics.peak_pooled_bytes, pool_statistics.pooled_bytes);
+      return;
+    }
+  }
+  Malloced::Delete(block);
+}
+
+
+void ZoneSegmentPool::Trim(intptr_t max_pooled_bytes) {
+  PooledSegment* to_free = NULL;
+  {
+    LockGuard<Mutex> lock_guard(pool_mutex.Pointer());
+    for (int index = kSizeClasses - 1;
+         index >= 0 && pool_statistics.pooled_bytes > max_pooled_bytes;
+         index--) {
+      int size = Zone::kMinimumSegmentSize << index;
+      while (pool_free_lists[index] != NULL &&
+             pool_statistics.pooled_bytes > max_pooled_bytes) {
+        PooledSegment* segment = pool_free_lists[index];
+        pool_free_lists[index] = segment->next;
+        segment->next = to_free;
+        to_free = segment;
+        pool_statistics.segments_pooled--;
+        pool_statistics.pooled_bytes -= size;
+      }
+    }
+  }
+  // Free outside of the lock.
+  while (to_free != NULL) {
+    PooledSegment* next = to_free->next;
+    Malloced::Delete(to_free);
+    to_free = next;
+  }
+}
+
+
+void ZoneSegmentPool::GetStatistics(Statistics* statistics) {
+  LockGuard<Mutex> lock_guard(pool_mutex.Pointer());
+  *statistics = pool_statistics;
+}
+
+
 Zone::Zone(Isolate* isolate)
     : allocation_size_(0),
       segment_bytes_allocated_(0),
@@ -157,7 +265,7 @@ void Zone::DeleteKeptSegment() {
 // Creates a new segment, sets it size, and pushes it to the front
 // of the segment chain. Returns the new segment.
 Segment* Zone::NewSegment(int size) {
-  Segment* result = reinterpret_cast<Segment*>(Malloced::New(size));
+  Segment* result = reinterpret_cast<Segment*>(ZoneSegmentPool::Allocate(size));
   adjust_segment_bytes_allocated(size);
   if (result != NULL) {
     result->Initialize(segment_head_, size);
@@ -170,7 +278,7 @@ Segment* Zone::NewSegment(int size) {
 // Deletes the given segment. Does not touch the segment chain.
 void Zone::DeleteSegment(Segment* segment, int size) {
   adjust_segment_bytes_allocated(-size);
-  Malloced::Delete(segment);
+  ZoneSegmentPool::Release(segment, size);
 }
 
 
@@ -183,11 +291,13 @@ Address Zone::NewExpand(int size) {
   // Compute the new segment size. We use a 'high water mark'
   // strategy, where we increase the segment size every time we expand
   // except that we employ a maximum segment size when we delete. This
-  // is to avoid excessive malloc() and free() overhead.
+  // is to avoid excessive malloc() and free() overhead. Sizes are rounded
+  // up to a power of two size class, which at least doubles the size of
+  // the previous segment, so that the segment can be reused from the pool.
   Segment* head = segment_head_;
   const size_t old_size = (head == NULL) ? 0 : head->size();
   static const size_t kSegmentOverhead = sizeof(Segment) + kAlignment;
-  const size_t new_size_no_overhead = size + (old_size << 1);
+  const size_t new_size_no_overhead = size + old_size;
   size_t new_size = kSegmentOverhead + new_size_no_overhead;
   const size_t min_new_size = kSegmentOverhead + static_cast<size_t>(size);
   // Guard against integer overflow.
@@ -209,6 +319,7 @@ Address Zone::NewExpand(int size) {
     V8::FatalProcessOutOfMemory("Zone");
     return NULL;
   }
+  new_size = ZoneSegmentPool::RoundUpToSizeClass(static_cast<int>(new_size));
   Segment* segment = NewSegment(static_cast<int>(new_size));
   if (segment == NULL) {
     V8::FatalProcessOutOfMemory("Zone");
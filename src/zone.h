@@ -42,6 +42,48 @@ namespace internal {
 class Segment;
 class Isolate;
 
+
+// Process-wide pool of zone segments. Zones return their segments here
+// when they are deleted, and later zones (on any thread) reuse them instead
+// of going back to malloc(). Segment sizes are rounded up to a power of two
+// between Zone::kMinimumSegmentSize and Zone::kMaximumSegmentSize so that
+// pooled segments fit later requests. The pool never holds more than
+// --zone-segment-pool-size megabytes.
+class ZoneSegmentPool : public AllStatic {
+ public:
+  struct Statistics {
+    intptr_t segments_allocated;  // Segments obtained from malloc().
+    intptr_t segments_reused;     // Segments handed out from the pool.
+    intptr_t segments_pooled;     // Segments currently in the pool.
+    intptr_t pooled_bytes;        // Bytes currently in the pool.
+    intptr_t peak_pooled_bytes;   // High-water mark of pooled_bytes.
+  };
+
+  // Number of power of two segment sizes between Zone::kMinimumSegmentSize
+  // and Zone::kMaximumSegmentSize.
+  static const int kSizeClasses = 8;
+
+  // Returns a block of exactly 'size' bytes, from the pool if possible.
+  static void* Allocate(int size);
+
+  // Gives a block obtained from Allocate() back to the pool, or frees it
+  // if it has no size class or the pool is full.
+  static void Release(void* block, int size);
+
+  // Frees pooled segments until at most 'max_pooled_bytes' remain, largest
+  // segments first.
+  static void Trim(intptr_t max_pooled_bytes);
+
+  static void GetStatistics(Statistics* statistics);
+
+  // Returns the size class for a segment of 'size' bytes, or 'size' itself
+  // if it is larger than the largest size class.
+  static int RoundUpToSizeClass(int size);
+
+ private:
+  static int SizeClassIndex(int size);
+};
+
 // The Zone supports very fast allocation of small chunks of
 // memory. The chunks cannot be deallocated individually, but instead
 // the Zone supports deallocating all chunks in one fast
@@ -86,6 +128,7 @@ class Zone {
 
  private:
   friend class Isolate;
+  friend class ZoneSegmentPool;
 
   // All pointers returned from New() have this alignment.  In addition, if the
   // object being allocated has a size that is divisible by 8 then its alignment
@@ -100,6 +143,8 @@ class Zone {
 
   // Never keep segments larger than this size in bytes around.
   static const int kMaximumKeptSegmentSize = 64 * KB;
+  STATIC_ASSERT((kMinimumSegmentSize << (ZoneSegmentPool::kSizeClasses - 1)) ==
+                kMaximumSegmentSize);
 
   // Report zone excess when allocation exceeds this limit.
   static const int kExcessLimit = 256 * MB;
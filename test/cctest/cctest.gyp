@@ -87,8 +87,10 @@
         'test-libplatform-worker-thread.cc',
         'test-list.cc',
         'test-liveedit.cc',
+        'test-lock-free-queues.cc',
         'test-lockers.cc',
         'test-log.cc',
+        'test-lz-codec.cc',
         'test-microtask-delivery.cc',
         'test-mark-compact.cc',
         'test-mementos.cc',
@@ -102,6 +104,7 @@
         'test-regexp.cc',
         'test-reloc-info.cc',
         'test-representation.cc',
+        'test-ryu-dtoa.cc',
         'test-semaphore.cc',
         'test-serialize.cc',
         'test-socket.cc',
@@ -116,10 +119,12 @@
         'test-unbound-queue.cc',
         'test-unique.cc',
         'test-utils.cc',
+        'test-value-serializer.cc',
         'test-version.cc',
         'test-weakmaps.cc',
         'test-weaksets.cc',
         'test-weaktypedarrays.cc',
+        'test-zone.cc',
         'trace-extension.cc'
       ],
       'conditions': [
@@ -214,6 +219,76 @@
         }],
       ],
     },
+    {
+      'target_name': 'microbench',
+      'type': 'executable',
+      'include_dirs': [
+        '../../src',
+      ],
+      'sources': [
+        'microbench.cc',
+        'microbench.h',
+        'microbench-runtime.cc',
+      ],
+      'conditions': [
+        ['component=="shared_library"', {
+          # Like cctest, the benchmarks use internal APIs and need the
+          # underlying static target.
+          'conditions': [
+            ['v8_use_snapshot=="true"', {
+              'dependencies': ['../../tools/gyp/v8.gyp:v8_snapshot'],
+            },
+            {
+              'dependencies': [
+                '../../tools/gyp/v8.gyp:v8_nosnapshot.<(v8_target_arch)',
+              ],
+            }],
+          ],
+        }, {
+          'dependencies': ['../../tools/gyp/v8.gyp:v8'],
+        }],
+      ],
+    },
+    {
+      'target_name': 'startupbench',
+      'type': 'executable',
+      'include_dirs': [
+        '../../src',
+      ],
+      'sources': [
+        'startupbench.cc',
+      ],
+      'conditions': [
+        ['component=="shared_library"', {
+          'conditions': [
+            ['v8_use_snapshot=="true"', {
+              'dependencies': ['../../tools/gyp/v8.gyp:v8_snapshot'],
+            },
+            {
+              'dependencies': [
+                '../../tools/gyp/v8.gyp:v8_nosnapshot.<(v8_target_arch)',
+              ],
+            }],
+          ],
+        }, {
+          'dependencies': ['../../tools/gyp/v8.gyp:v8'],
+        }],
+      ],
+    },
+    {
+      # The same benchmark without a snapshot, for comparison.
+      'target_name': 'startupbench_nosnapshot',
+      'type': 'executable',
+      'include_dirs': [
+        '../../src',
+      ],
+      'sources': [
+        'startupbench.cc',
+      ],
+      'dependencies': [
+        '../../tools/gyp/v8.gyp:v8_nosnapshot.<(v8_target_arch)',
+      ],
+    },
     {
       'target_name': 'resources',
       'type': 'none',
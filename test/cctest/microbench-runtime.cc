@@ -0,0 +1,184 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmarks for runtime slow paths.
+
+#include "v8.h"
+
+#include "json-parser.h"
+#include "microbench.h"
+#include "string-search.h"
+
+namespace i = v8::internal;
+
+
+static v8::Local<v8::Value> Run(const char* source) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  return v8::Script::Compile(v8::String::NewFromUtf8(isolate, source))->Run();
+}
+
+
+// Runs |function_source|, a function taking an iteration count.
+static void RunLoop(const char* function_source, int iterations) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Local<v8::Function> function =
+      v8::Local<v8::Function>::Cast(Run(function_source));
+  v8::Local<v8::Value> argv[] = { v8::Integer::New(isolate, iterations) };
+  function->Call(isolate->GetCurrentContext()->Global(), 1, argv);
+}
+
+
+BENCHMARK(JsonParse) {
+  i::Isolate* isolate = i::Isolate::Current();
+  i::Handle<i::String> source = isolate->factory()->NewStringFromAscii(
+      i::CStrVector("{\"name\":\"value\",\"list\":[1,2.5,-3e10,true,null],"
+                    "\"nested\":{\"a\":\"\\u00e9t\\u00e9\",\"b\":[{},[]]}}"));
+  for (int n = 0; n < iterations; n++) {
+    i::HandleScope scope(isolate);
+    i::JsonParser<true>::Parse(source);
+  }
+}
+
+
+BENCHMARK(StringSearch) {
+  i::Isolate* isolate = i::Isolate::Current();
+  static const char kSubject[] =
+      "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do "
+      "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim "
+      "ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+      "aliquip ex ea commodo consequat.";
+  i::Vector<const uint8_t> subject =
+      i::Vector<const uint8_t>::cast(i::CStrVector(kSubject));
+  i::Vector<const uint8_t> pattern =
+      i::Vector<const uint8_t>::cast(i::CStrVector("consequat"));
+  int found = 0;
+  for (int n = 0; n < iterations; n++) {
+    found += i::SearchString(isolate, subject, pattern, 0);
+  }
+  CHECK_GT(found, 0);
+}
+
+
+BENCHMARK(Scavenge) {
+  i::Isolate* isolate = i::Isolate::Current();
+  i::Heap* heap = isolate->heap();
+  for (int n = 0; n < iterations; n++) {
+    i::HandleScope scope(isolate);
+    // Keep a few objects alive so the scavenge has something to copy.
+    for (int j = 0; j < 100; j++) isolate->factory()->NewFixedArray(10);
+    heap->CollectGarbage(i::NEW_SPACE);
+  }
+}
+
+
+BENCHMARK(StubCacheProbe) {
+  // Enough receiver maps to make the load megamorphic, so every load
+  // probes the stub cache.
+  RunLoop("(function(n) {"
+          "  var objects = [{x:1}, {x:1, a:1}, {x:1, b:1}, {x:1, c:1},"
+          "                 {x:1, d:1}, {x:1, e:1}, {x:1, f:1}, {x:1, g:1}];"
+          "  function load(o) { return o.x; }"
+          "  var sum = 0;"
+          "  for (var i = 0; i < n; i++) sum += load(objects[i & 7]);"
+          "  return sum;"
+          "})",
+          iterations);
+}
+
+
+BENCHMARK(HandleScopeChurn) {
+  i::Isolate* isolate = i::Isolate::Current();
+  i::Object* value = isolate->heap()->undefined_value();
+  for (int n = 0; n < iterations; n++) {
+    i::HandleScope scope(isolate);
+    for (int j = 0; j < 16; j++) i::Handle<i::Object> handle(value, isolate);
+  }
+}
+
+
+BENCHMARK(Utf8RoundTrip) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  static const char kText[] =
+      "ascii text, \xc3\xa9t\xc3\xa9, \xe2\x82\xac 10, \xf0\x9f\x98\x80";
+  char buffer[sizeof(kText)];
+  for (int n = 0; n < iterations; n++) {
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::String> string = v8::String::NewFromUtf8(isolate, kText);
+    string->WriteUtf8(buffer, sizeof(buffer));
+  }
+}
+
+
+static void EmptyCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+}
+
+
+BENCHMARK(ApiCallback) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Local<v8::FunctionTemplate> function_template =
+      v8::FunctionTemplate::New(isolate, EmptyCallback);
+  isolate->GetCurrentContext()->Global()->Set(
+      v8::String::NewFromUtf8(isolate, "callback"),
+      function_template->GetFunction());
+  RunLoop("(function(n) { for (var i = 0; i < n; i++) callback(); })",
+          iterations);
+}
+
+
+static const char kMessageSource[] =
+    "({id: 12345, name: 'frame', timestamps: [1, 2, 3, 4, 5, 6, 7, 8],"
+    "  weights: [0.5, 1.5, 2.5, 3.5], tags: ['a', 'b', 'c'],"
+    "  nested: {x: 1, y: 2, label: 'point'}})";
+
+
+// The baseline for ValueSerializerRoundTrip.
+BENCHMARK(JsonRoundTrip) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Local<v8::Value> message = Run(kMessageSource);
+  isolate->GetCurrentContext()->Global()->Set(
+      v8::String::NewFromUtf8(isolate, "message"), message);
+  RunLoop("(function(n) {"
+          "  for (var i = 0; i < n; i++) JSON.parse(JSON.stringify(message));"
+          "})",
+          iterations);
+}
+
+
+BENCHMARK(ValueSerializerRoundTrip) {
+  v8::Isolate* isolate = v8::Isolate::GetCurrent();
+  v8::Local<v8::Value> message = Run(kMessageSource);
+  for (int n = 0; n < iterations; n++) {
+    v8::HandleScope scope(isolate);
+    v8::ValueSerializer serializer(isolate);
+    serializer.WriteHeader();
+    serializer.WriteValue(message);
+    v8::ValueDeserializer deserializer(
+        isolate, serializer.GetBuffer(), serializer.GetBufferSize());
+    deserializer.ReadHeader();
+    deserializer.ReadValue();
+  }
+}
@@ -0,0 +1,146 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Driver for the microbenchmarks.  Run all benchmarks with
+//   microbench
+// or only those whose name contains one of the arguments with
+//   microbench JsonParse Utf8
+// V8 flags can be passed as well.  --list prints the benchmark names.
+
+#include <stdlib.h>
+#include <cmath>
+
+#include "v8.h"
+
+#include "microbench.h"
+#include "platform/elapsed-timer.h"
+
+namespace i = v8::internal;
+
+Microbenchmark* Microbenchmark::last_ = NULL;
+
+
+Microbenchmark::Microbenchmark(MicrobenchmarkBody* body, const char* name)
+    : body_(body), name_(name), prev_(last_) {
+  last_ = this;
+}
+
+
+double Microbenchmark::Sample(int iterations) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  i::ElapsedTimer timer;
+  timer.Start();
+  body_(iterations);
+  return timer.Elapsed().InMicroseconds() * 1000.0 / iterations;
+}
+
+
+static int CompareDoubles(const double* a, const double* b) {
+  if (*a < *b) return -1;
+  if (*a > *b) return 1;
+  return 0;
+}
+
+
+static double Median(i::List<double>* values) {
+  values->Sort(CompareDoubles);
+  int length = values->length();
+  if (length % 2 == 1) return values->at(length / 2);
+  return (values->at(length / 2 - 1) + values->at(length / 2)) / 2;
+}
+
+
+void Microbenchmark::Run() {
+  Sample(kWarmupIterations);
+
+  // Calibrate: double the iteration count until a sample is long enough
+  // for the timer resolution not to matter.
+  int iterations = 1;
+  while (iterations < (1 << 30) &&
+         Sample(iterations) * iterations < kMinSampleTimeMs * 1e6) {
+    iterations *= 2;
+  }
+
+  i::List<double> samples(kSamples);
+  for (int i = 0; i < kSamples; i++) samples.Add(Sample(iterations));
+  double median = Median(&samples);
+  // The median absolute deviation is robust against the occasional
+  // outlier caused by GC or the scheduler.
+  i::List<double> deviations(kSamples);
+  for (int i = 0; i < kSamples; i++) {
+    deviations.Add(std::fabs(samples[i] - median));
+  }
+  double mad = Median(&deviations);
+  printf("%-24s %12.1f ns/iter  +- %5.1f%%  (%d iterations x %d samples)\n",
+         name_, median, median > 0 ? mad * 100.0 / median : 0.0,
+         iterations, kSamples);
+}
+
+
+static bool Selected(Microbenchmark* benchmark, int argc, char* argv[]) {
+  bool has_filter = false;
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] == '-') continue;
+    has_filter = true;
+    if (strstr(benchmark->name(), argv[i]) != NULL) return true;
+  }
+  return !has_filter;
+}
+
+
+int main(int argc, char* argv[]) {
+  v8::V8::InitializeICU();
+  i::FlagList::SetFlagsFromCommandLine(&argc, argv, true);
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--list") == 0) {
+      for (Microbenchmark* benchmark = Microbenchmark::last();
+           benchmark != NULL;
+           benchmark = benchmark->prev()) {
+        printf("%s\n", benchmark->name());
+      }
+      return 0;
+    }
+  }
+
+  v8::V8::Initialize();
+  v8::Isolate* isolate = v8::Isolate::New();
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+    for (Microbenchmark* benchmark = Microbenchmark::last();
+         benchmark != NULL;
+         benchmark = benchmark->prev()) {
+      if (Selected(benchmark, argc, argv)) benchmark->Run();
+    }
+  }
+  isolate->Dispose();
+  v8::V8::Dispose();
+  return 0;
+}
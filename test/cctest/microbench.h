@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef V8_TEST_CCTEST_MICROBENCH_H_
+#define V8_TEST_CCTEST_MICROBENCH_H_
+
+#include "v8.h"
+
+// A microbenchmark body runs the measured operation |iterations| times.
+// Bodies run inside a handle scope and an entered context of the
+// benchmark isolate; setup done in the body is amortized over the
+// iterations.
+typedef void (MicrobenchmarkBody)(int iterations);
+
+class Microbenchmark {
+ public:
+  Microbenchmark(MicrobenchmarkBody* body, const char* name);
+
+  // Warms the body up, picks an iteration count so that one sample takes
+  // at least kMinSampleTimeMs and prints the median and the median
+  // absolute deviation of the time per iteration over kSamples samples.
+  void Run();
+
+  const char* name() { return name_; }
+  Microbenchmark* prev() { return prev_; }
+  static Microbenchmark* last() { return last_; }
+
+ private:
+  static const int kWarmupIterations = 1000;
+  static const int kMinSampleTimeMs = 20;
+  static const int kSamples = 15;
+
+  // Returns the time per iteration in nanoseconds.
+  double Sample(int iterations);
+
+  MicrobenchmarkBody* body_;
+  const char* name_;
+  Microbenchmark* prev_;
+  static Microbenchmark* last_;
+};
+
+
+#define BENCHMARK(Name)                                                 \
+  static void Bench##Name(int iterations);                              \
+  Microbenchmark register_bench_##Name(Bench##Name, #Name);             \
+  static void Bench##Name(int iterations)
+
+#endif  // V8_TEST_CCTEST_MICROBENCH_H_
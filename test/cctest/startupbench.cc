@@ -0,0 +1,191 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Startup benchmark.  Creates fresh isolates and contexts and reports the
+// median and minimum time of each startup phase:
+//
+//   isolate init     heap setup, plus snapshot deserialization when the
+//                    binary has a snapshot (startupbench) or building the
+//                    builtins and stubs without one (startupbench_nosnapshot)
+//   context snapshot deserializing the context snapshot on its own
+//   context new      v8::Context::New, which runs Genesis
+//   natives compile  the part of v8::Context::New spent compiling natives
+//   first compile    v8::Script::Compile of a small script
+//   first run        running it
+//   dispose          v8::Isolate::Dispose
+//
+// Usage: startupbench [--iterations=N] [V8 flags]
+
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "platform/elapsed-timer.h"
+#include "snapshot.h"
+
+namespace i = v8::internal;
+
+enum Phase {
+  kIsolateInit,
+  kContextSnapshot,
+  kContextNew,
+  kNativesCompile,
+  kFirstCompile,
+  kFirstRun,
+  kDispose,
+  kPhaseCount
+};
+
+static const char* const kPhaseNames[] = {
+  "isolate init",
+  "context snapshot",
+  "context new",
+  "natives compile",
+  "first compile",
+  "first run",
+  "dispose"
+};
+
+static const char kFirstScript[] =
+    "function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }"
+    "var result = [1, 2, 3].map(function(x) { return fib(x + 10); });"
+    "JSON.stringify({ result: result });";
+
+
+// Accumulates the time spent in outermost compile trace events.
+static int compile_depth = 0;
+static i::TimeTicks compile_start;
+static i::TimeDelta compile_time;
+
+
+static bool IsCompileEvent(const char* name) {
+  return strcmp(name, "V8.Compile") == 0 ||
+         strcmp(name, "V8.CompileLazy") == 0;
+}
+
+
+static void TraceCompiles(v8::Isolate::TraceEventPhase phase,
+                          const char* category,
+                          const char* name,
+                          const char* arg_name,
+                          int arg_value) {
+  if (!IsCompileEvent(name)) return;
+  if (phase == v8::Isolate::kTraceEventBegin) {
+    if (compile_depth++ == 0) compile_start = i::TimeTicks::HighResolutionNow();
+  } else if (phase == v8::Isolate::kTraceEventEnd) {
+    if (--compile_depth == 0) {
+      compile_time += i::TimeTicks::HighResolutionNow() - compile_start;
+    }
+  }
+}
+
+
+static void RunIteration(i::List<double>* samples) {
+  i::ElapsedTimer timer;
+
+  v8::Isolate* isolate = v8::Isolate::New();
+  i::Isolate* internal_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  isolate->Enter();
+  timer.Start();
+  if (!i::Snapshot::Initialize()) CHECK(i::V8::Initialize(NULL));
+  samples[kIsolateInit].Add(timer.Elapsed().InMillisecondsF());
+  isolate->SetTraceEventCallback(TraceCompiles);
+
+  {
+    v8::HandleScope scope(isolate);
+
+    timer.Restart();
+    { i::HandleScope context_scope(internal_isolate);
+      i::Snapshot::NewContextFromSnapshot(internal_isolate);
+    }
+    samples[kContextSnapshot].Add(timer.Elapsed().InMillisecondsF());
+
+    compile_time = i::TimeDelta();
+    timer.Restart();
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    samples[kContextNew].Add(timer.Elapsed().InMillisecondsF());
+    samples[kNativesCompile].Add(compile_time.InMillisecondsF());
+    v8::Context::Scope context_scope(context);
+
+    timer.Restart();
+    v8::Local<v8::Script> script =
+        v8::Script::Compile(v8::String::NewFromUtf8(isolate, kFirstScript));
+    samples[kFirstCompile].Add(timer.Elapsed().InMillisecondsF());
+
+    timer.Restart();
+    CHECK(!script->Run().IsEmpty());
+    samples[kFirstRun].Add(timer.Elapsed().InMillisecondsF());
+  }
+
+  isolate->SetTraceEventCallback(NULL);
+  isolate->Exit();
+  timer.Restart();
+  isolate->Dispose();
+  samples[kDispose].Add(timer.Elapsed().InMillisecondsF());
+}
+
+
+static int CompareDoubles(const double* a, const double* b) {
+  if (*a < *b) return -1;
+  if (*a > *b) return 1;
+  return 0;
+}
+
+
+int main(int argc, char* argv[]) {
+  v8::V8::InitializeICU();
+  // Removes the V8 flags, leaving our own.
+  i::FlagList::SetFlagsFromCommandLine(&argc, argv, true);
+  int iterations = 20;
+  for (int j = 1; j < argc; j++) {
+    if (strncmp(argv[j], "--iterations=", 13) == 0) {
+      iterations = atoi(argv[j] + 13);
+    }
+  }
+  if (iterations < 1) iterations = 1;
+
+  i::ElapsedTimer timer;
+  timer.Start();
+  v8::V8::Initialize();
+  printf("V8::Initialize: %.3f ms, snapshot: %s\n",
+         timer.Elapsed().InMillisecondsF(),
+         i::Snapshot::HaveASnapshotToStartFrom() ? "yes" : "no");
+
+  i::List<double> samples[kPhaseCount];
+  for (int j = 0; j < iterations; j++) RunIteration(samples);
+
+  printf("%-18s %10s %10s\n", "phase", "median ms", "min ms");
+  for (int phase = 0; phase < kPhaseCount; phase++) {
+    samples[phase].Sort(CompareDoubles);
+    printf("%-18s %10.3f %10.3f\n",
+           kPhaseNames[phase],
+           samples[phase][iterations / 2],
+           samples[phase][0]);
+  }
+  v8::V8::Dispose();
+  return 0;
+}
@@ -837,6 +837,62 @@ THREADED_TEST(ScavengeExternalAsciiString) {
 }
 
 
+class TestUtf8Resource: public String::ExternalUtf8StringResource {
+ public:
+  TestUtf8Resource(const char* data, int* counter)
+      : data_(data), length_(strlen(data)), counter_(counter) { }
+
+  ~TestUtf8Resource() {
+    i::DeleteArray(data_);
+    ++*counter_;
+  }
+
+  const char* data() const { return data_; }
+  size_t length() const { return length_; }
+
+ private:
+  const char* data_;
+  size_t length_;
+  int* counter_;
+};
+
+
+THREADED_TEST(ExternalUtf8String) {
+  LocalContext env;
+  i::FLAG_stress_compaction = false;
+  i::FLAG_gc_global = false;
+  int dispose_count = 0;
+  bool in_new_space = false;
+  {
+    v8::HandleScope scope(env->GetIsolate());
+    const char* ascii = "ascii request line";
+    Local<String> string = String::NewExternal(
+        env->GetIsolate(),
+        new TestUtf8Resource(i::StrDup(ascii), &dispose_count));
+    CHECK(string->IsExternalAscii());
+    CHECK_EQ(ascii, string->GetExternalAsciiStringResource()->data());
+    CHECK_EQ(static_cast<int>(strlen(ascii)), string->Length());
+    i::Handle<i::String> istring = v8::Utils::OpenHandle(*string);
+    CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+    in_new_space = CcTest::heap()->InNewSpace(*istring);
+    CHECK_EQ(0, dispose_count);
+
+    // Non-ASCII data is decoded and the resource released right away.
+    Local<String> decoded = String::NewExternal(
+        env->GetIsolate(),
+        new TestUtf8Resource(i::StrDup("caf\xc3\xa9"), &dispose_count));
+    CHECK_EQ(1, dispose_count);
+    CHECK(!decoded->IsExternal());
+    CHECK_EQ(4, decoded->Length());
+    env->Global()->Set(v8_str("decoded"), decoded);
+    ExpectInt32("decoded.charCodeAt(3)", 0xe9);
+  }
+  CcTest::heap()->CollectGarbage(
+      in_new_space ? i::NEW_SPACE : i::OLD_DATA_SPACE);
+  CHECK_EQ(2, dispose_count);
+}
+
+
 class TestAsciiResourceWithDisposeControl: public TestAsciiResource {
  public:
   // Only used by non-threaded tests, so it can use static fields.
@@ -7103,6 +7159,52 @@ THREADED_TEST(IndependentWeakHandle) {
 }
 
 
+static void ResetPhantomAndSetFlag(
+    const v8::PhantomCallbackData<FlagAndPersistent>& data) {
+  CHECK(data.GetParameter()->handle.IsNearDeath());
+  data.GetParameter()->handle.Reset();
+  data.GetParameter()->flag = true;
+}
+
+
+THREADED_TEST(PhantomHandle) {
+  v8::Isolate* iso = CcTest::isolate();
+  v8::HandleScope scope(iso);
+  v8::Handle<Context> context = Context::New(iso);
+  Context::Scope context_scope(context);
+
+  FlagAndPersistent object_a, object_b, object_c;
+
+  {
+    v8::HandleScope handle_scope(iso);
+    object_a.handle.Reset(iso, v8::Object::New(iso));
+    object_b.handle.Reset(iso, v8::Object::New(iso));
+    object_c.handle.Reset(iso, v8::Object::New(iso));
+  }
+
+  object_a.flag = false;
+  object_b.flag = false;
+  object_c.flag = false;
+  object_a.handle.SetPhantom(&object_a, &ResetPhantomAndSetFlag);
+  object_b.handle.SetPhantom(&object_b, &ResetPhantomAndSetFlag);
+  object_c.handle.SetPhantom(&object_c, &ResetPhantomAndSetFlag);
+  CHECK(object_a.handle.IsWeak());
+  object_b.handle.MarkIndependent();
+  object_c.handle.ClearWeak();
+
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+  CHECK(!object_a.flag);
+  CHECK(object_b.flag);
+  CHECK(object_b.handle.IsEmpty());
+
+  CcTest::heap()->CollectAllGarbage(i::Heap::kNoGCFlags);
+  CHECK(object_a.flag);
+  CHECK(object_a.handle.IsEmpty());
+  CHECK(!object_c.flag);
+  object_c.handle.Reset();
+}
+
+
 static void InvokeScavenge() {
   CcTest::heap()->CollectGarbage(i::NEW_SPACE);
 }
@@ -14977,6 +15079,74 @@ TEST(ObjectClone) {
 }
 
 
+THREADED_TEST(OptimizeForPropertyAccess) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  Local<v8::Object> obj =
+      CompileRun("var o = { a: 1, b: 2, c: 3 }; delete o.b; o").As<Object>();
+  i::Handle<i::JSObject> internal_obj = v8::Utils::OpenHandle(*obj);
+  CHECK(!internal_obj->HasFastProperties());
+
+  obj->OptimizeForPropertyAccess();
+  CHECK(internal_obj->HasFastProperties());
+  CHECK_EQ(1, obj->Get(v8_str("a"))->Int32Value());
+  CHECK(!obj->Has(v8_str("b")));
+  CHECK_EQ(3, obj->Get(v8_str("c"))->Int32Value());
+
+  // Objects in fast mode are left as they are.
+  i::Map* map = internal_obj->map();
+  obj->OptimizeForPropertyAccess();
+  CHECK_EQ(map, internal_obj->map());
+}
+
+
+THREADED_TEST(ObjectNewWithProperties) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<String> keys[] = {
+    v8_str("row_id"), v8_str("row_name"), v8_str("row_score")
+  };
+  Local<Value> first_values[] = {
+    v8::Integer::New(isolate, 1), v8_str("one"), v8::Number::New(isolate, 1.5)
+  };
+  Local<Value> second_values[] = {
+    v8::Integer::New(isolate, 2), v8_str("two"), v8::Number::New(isolate, 2.5)
+  };
+  Local<v8::Object> first = v8::Object::New(isolate, 3, keys, first_values);
+  Local<v8::Object> second = v8::Object::New(isolate, 3, keys, second_values);
+  env->Global()->Set(v8_str("first"), first);
+  env->Global()->Set(v8_str("second"), second);
+
+  CHECK_EQ(2, second->Get(v8_str("row_id"))->Int32Value());
+  CHECK_EQ(v8_str("two"), second->Get(v8_str("row_name")));
+  CHECK_EQ(2.5, second->Get(v8_str("row_score"))->NumberValue());
+  ExpectString("Object.keys(second).join()", "row_id,row_name,row_score");
+
+  // Both objects, and literals of the same shape, share one map.
+  i::Handle<i::JSObject> internal_first = v8::Utils::OpenHandle(*first);
+  i::Handle<i::JSObject> internal_second = v8::Utils::OpenHandle(*second);
+  CHECK(internal_second->HasFastProperties());
+  CHECK_EQ(internal_first->map(), internal_second->map());
+  Local<v8::Object> literal = CompileRun(
+      "({ row_id: 3, row_name: 'three', row_score: 3.5 })").As<Object>();
+  CHECK_EQ(internal_first->map(), v8::Utils::OpenHandle(*literal)->map());
+
+  // Double fields are not shared between objects.
+  CompileRun("second.row_score += 1;");
+  CHECK_EQ(1.5, first->Get(v8_str("row_score"))->NumberValue());
+  CHECK_EQ(3.5, second->Get(v8_str("row_score"))->NumberValue());
+
+  // Index keys become elements.
+  Local<String> mixed_keys[] = { v8_str("0"), v8_str("row_id") };
+  Local<v8::Object> mixed =
+      v8::Object::New(isolate, 2, mixed_keys, first_values);
+  env->Global()->Set(v8_str("mixed"), mixed);
+  ExpectInt32("mixed[0]", 1);
+  ExpectString("mixed.row_id", "one");
+}
+
+
 class AsciiVectorResource : public v8::String::ExternalAsciiStringResource {
  public:
   explicit AsciiVectorResource(i::Vector<const char> vector)
@@ -18688,6 +18858,44 @@ TEST(GCCallbacks) {
 }
 
 
+static int gc_statistics_count = 0;
+static v8::GCStatistics last_gc_statistics;
+
+static void GCStatisticsCallback(v8::Isolate* isolate,
+                                 const v8::GCStatistics* statistics) {
+  CHECK_EQ(gc_callbacks_isolate, isolate);
+  gc_statistics_count++;
+  last_gc_statistics = *statistics;
+}
+
+
+TEST(GCStatisticsCallback) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  gc_callbacks_isolate = isolate;
+  isolate->SetGCStatisticsCallback(GCStatisticsCallback);
+
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+  CHECK_EQ(1, gc_statistics_count);
+  CHECK_EQ(v8::kGCTypeScavenge, last_gc_statistics.type);
+  CHECK_GE(last_gc_statistics.pause, 0);
+  CHECK_GE(last_gc_statistics.start_time, 0);
+
+  CcTest::heap()->CollectAllGarbage(i::Heap::kNoGCFlags);
+  CHECK_EQ(2, gc_statistics_count);
+  CHECK_EQ(v8::kGCTypeMarkSweepCompact, last_gc_statistics.type);
+  CHECK_GE(last_gc_statistics.pause,
+           last_gc_statistics.phase_times[v8::GCStatistics::kMark]);
+  CHECK_GT(static_cast<int>(last_gc_statistics.size_after), 0);
+  CHECK_GT(static_cast<int>(
+      last_gc_statistics.space_size_after[v8::GCStatistics::kMapSpace]), 0);
+
+  isolate->SetGCStatisticsCallback(NULL);
+  CcTest::heap()->CollectAllGarbage(i::Heap::kNoGCFlags);
+  CHECK_EQ(2, gc_statistics_count);
+}
+
+
 THREADED_TEST(AddToJSFunctionResultCache) {
   i::FLAG_stress_compaction = false;
   i::FLAG_allow_natives_syntax = true;
@@ -19275,6 +19483,61 @@ TEST(MultipleIsolatesOnIndividualThreads) {
 }
 
 
+static const int kSharedCounterIncrements = 1000;
+
+
+class SharedCounterThread : public v8::internal::Thread {
+ public:
+  SharedCounterThread(v8::Isolate* isolate, int32_t* data, size_t length)
+      : Thread("SharedCounterThread"),
+        isolate_(isolate),
+        data_(data),
+        length_(length) { }
+
+  void Run() {
+    v8::Isolate::Scope isolate_scope(isolate_);
+    v8::HandleScope scope(isolate_);
+    v8::Local<v8::Context> context = v8::Context::New(isolate_);
+    v8::Context::Scope context_scope(context);
+    Local<v8::ArrayBuffer> ab =
+        v8::ArrayBuffer::NewShared(isolate_, data_, length_);
+    CHECK(ab->IsShared());
+    CHECK(ab->IsExternal());
+    context->Global()->Set(v8_str("ab"), ab);
+    i::ScopedVector<char> source(256);
+    i::OS::SNPrintF(source,
+                    "var counter = new Int32Array(ab);"
+                    "for (var i = 0; i < %d; i++) Atomics.add(counter, 0, 1);",
+                    kSharedCounterIncrements);
+    CompileRun(source.start());
+  }
+
+ private:
+  v8::Isolate* isolate_;
+  int32_t* data_;
+  size_t length_;
+};
+
+
+TEST(SharedArrayBufferAcrossIsolates) {
+  i::FLAG_harmony_atomics = true;
+  int32_t data[4] = { 0, 0, 0, 0 };
+  v8::Isolate* isolate1 = v8::Isolate::New();
+  v8::Isolate* isolate2 = v8::Isolate::New();
+
+  SharedCounterThread thread1(isolate1, data, sizeof(data));
+  SharedCounterThread thread2(isolate2, data, sizeof(data));
+  thread1.Start();
+  thread2.Start();
+  thread1.Join();
+  thread2.Join();
+  CHECK_EQ(2 * kSharedCounterIncrements, data[0]);
+
+  isolate1->Dispose();
+  isolate2->Dispose();
+}
+
+
 TEST(IsolateDifferentContexts) {
   v8::Isolate* isolate = v8::Isolate::New();
   Local<v8::Context> context;
@@ -20557,6 +20820,44 @@ TEST(EnqueueMicrotask) {
 }
 
 
+static void MicrotaskCallback(void* data) {
+  int* calls = reinterpret_cast<int*>(data);
+  (*calls)++;
+}
+
+
+TEST(EnqueueMicrotaskCallback) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CompileRun("var ext1Calls = 0;");
+  int calls = 0;
+
+  v8::V8::EnqueueMicrotask(env->GetIsolate(), MicrotaskCallback, &calls);
+  CHECK_EQ(0, calls);
+  CompileRun("1+1;");
+  CHECK_EQ(1, calls);
+
+  // C++ and JS microtasks are run in the order they were enqueued, also when
+  // the queue has to grow.
+  for (int i = 0; i < 20; i++) {
+    v8::V8::EnqueueMicrotask(env->GetIsolate(), MicrotaskCallback, &calls);
+    v8::V8::EnqueueMicrotask(env->GetIsolate(),
+                             Function::New(env->GetIsolate(), MicrotaskOne));
+  }
+  CompileRun("1+1;");
+  CHECK_EQ(21, calls);
+  CHECK_EQ(20, CompileRun("ext1Calls")->Int32Value());
+
+  v8::V8::SetAutorunMicrotasks(env->GetIsolate(), false);
+  v8::V8::EnqueueMicrotask(env->GetIsolate(), MicrotaskCallback, &calls);
+  CompileRun("1+1;");
+  CHECK_EQ(21, calls);
+  v8::V8::RunMicrotasks(env->GetIsolate());
+  CHECK_EQ(22, calls);
+  v8::V8::SetAutorunMicrotasks(env->GetIsolate(), true);
+}
+
+
 TEST(SetAutorunMicrotasks) {
   LocalContext env;
   v8::HandleScope scope(env->GetIsolate());
@@ -20608,6 +20909,7 @@ TEST(SetAutorunMicrotasks) {
 static int probes_counter = 0;
 static int misses_counter = 0;
 static int updates_counter = 0;
+static int evictions_counter = 0;
 
 
 static int* LookupCounter(const char* name) {
@@ -20617,6 +20919,8 @@ static int* LookupCounter(const char* name) {
     return &misses_counter;
   } else if (strcmp(name, "c:V8.MegamorphicStubCacheUpdates") == 0) {
     return &updates_counter;
+  } else if (strcmp(name, "c:V8.MegamorphicStubCacheEvictions") == 0) {
+    return &evictions_counter;
   }
   return NULL;
 }
@@ -20652,12 +20956,15 @@ static void StubCacheHelper(bool primary) {
   int initial_probes = probes_counter;
   int initial_misses = misses_counter;
   int initial_updates = updates_counter;
+  int initial_evictions = evictions_counter;
   CompileRun(kMegamorphicTestProgram);
   int probes = probes_counter - initial_probes;
   int misses = misses_counter - initial_misses;
   int updates = updates_counter - initial_updates;
+  int evictions = evictions_counter - initial_evictions;
   CHECK_LT(updates, 10);
   CHECK_LT(misses, 10);
+  CHECK_LE(evictions, updates);
   // TODO(verwaest): Update this test to overflow the degree of polymorphism
   // before megamorphism. The number of probes will only work once we teach the
   // serializer to embed references to counters in the stubs, given that the
@@ -21217,6 +21524,113 @@ THREADED_TEST(JSONParseNumber) {
 }
 
 
+THREADED_TEST(JSONParseExternalBuffer) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+  Handle<Object> global = context->Global();
+
+  // The buffer is released right after parsing.
+  char* buffer = i::StrDup("{\"x\":[1,\"two\"],\"y\":\"a\\\"b\"}");
+  Local<Value> obj = v8::JSON::Parse(isolate, buffer);
+  i::DeleteArray(buffer);
+  CcTest::heap()->CollectAllGarbage(i::Heap::kNoGCFlags);
+  global->Set(v8_str("obj"), obj);
+  ExpectString("JSON.stringify(obj)", "{\"x\":[1,\"two\"],\"y\":\"a\\\"b\"}");
+
+  // Non-ASCII input.
+  const char* utf8 = "[\"\xc3\xa9\xe2\x82\xac\"]";
+  obj = v8::JSON::Parse(isolate, utf8, i::StrLength(utf8));
+  global->Set(v8_str("obj"), obj);
+  ExpectString("obj[0]", "\xc3\xa9\xe2\x82\xac");
+
+  // Syntax errors are reported as for string sources.
+  v8::TryCatch try_catch;
+  CHECK(v8::JSON::Parse(isolate, "{\"x\":}").IsEmpty());
+  CHECK(try_catch.HasCaught());
+}
+
+
+class JSONTestStream : public v8::OutputStream {
+ public:
+  JSONTestStream(OutputEncoding encoding, int abort_after)
+      : encoding_(encoding), abort_after_(abort_after), chunks_(0),
+        eos_signaled_(false) { }
+  virtual void EndOfStream() { eos_signaled_ = true; }
+  virtual int GetChunkSize() { return 7; }
+  virtual OutputEncoding GetOutputEncoding() { return encoding_; }
+  virtual WriteResult WriteAsciiChunk(char* data, int size) {
+    CHECK(size > 0 && size <= GetChunkSize());
+    if (++chunks_ == abort_after_) return kAbort;
+    i::Vector<char> chunk = buffer_.AddBlock(size, '\0');
+    i::OS::MemCopy(chunk.start(), data, size);
+    return kContinue;
+  }
+  i::Vector<char> ToVector() {
+    buffer_.Add('\0');
+    return buffer_.ToVector();
+  }
+  int chunks() { return chunks_; }
+  bool eos_signaled() { return eos_signaled_; }
+
+ private:
+  OutputEncoding encoding_;
+  int abort_after_;
+  int chunks_;
+  bool eos_signaled_;
+  i::Collector<char> buffer_;
+};
+
+
+THREADED_TEST(JSONStringifyToStream) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+  Local<Value> value = CompileRun(
+      "var small = { a: [1, 'two', null], u: '\\xe9\\u20ac\\ud83d\\ude00' };"
+      "var big = [];"
+      "for (var i = 0; i < 1000; i++) big.push({ i: i, s: 'x' + i + small.u });"
+      "small");
+
+  JSONTestStream utf8_stream(v8::OutputStream::kUtf8, -1);
+  CHECK(v8::JSON::Stringify(isolate, value, &utf8_stream));
+  CHECK(utf8_stream.eos_signaled());
+  i::Vector<char> utf8 = utf8_stream.ToVector();
+  CHECK_EQ("{\"a\":[1,\"two\",null],"
+           "\"u\":\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\"}", utf8.start());
+  utf8.Dispose();
+
+  JSONTestStream ascii_stream(v8::OutputStream::kAscii, -1);
+  CHECK(v8::JSON::Stringify(isolate, value, &ascii_stream));
+  i::Vector<char> ascii = ascii_stream.ToVector();
+  CHECK_EQ("{\"a\":[1,\"two\",null],"
+           "\"u\":\"\\u00e9\\u20ac\\ud83d\\ude00\"}", ascii.start());
+  ascii.Dispose();
+
+  // Values spanning many parts of the stringifier, surrogate pairs
+  // included.
+  value = CompileRun("big");
+  JSONTestStream big_stream(v8::OutputStream::kUtf8, -1);
+  CHECK(v8::JSON::Stringify(isolate, value, &big_stream));
+  i::Vector<char> big = big_stream.ToVector();
+  context->Global()->Set(v8_str("streamed"), v8_str(big.start()));
+  big.Dispose();
+  ExpectTrue("streamed === JSON.stringify(big)");
+
+  // Aborting the stream stops serialization.
+  JSONTestStream abort_stream(v8::OutputStream::kUtf8, 3);
+  CHECK(!v8::JSON::Stringify(isolate, value, &abort_stream));
+  CHECK(!abort_stream.eos_signaled());
+  CHECK_EQ(3, abort_stream.chunks());
+
+  // Nothing to serialize.
+  JSONTestStream undefined_stream(v8::OutputStream::kUtf8, -1);
+  CHECK(!v8::JSON::Stringify(isolate, v8::Undefined(isolate),
+                             &undefined_stream));
+  CHECK(!undefined_stream.eos_signaled());
+}
+
+
 #if V8_OS_POSIX
 class ThreadInterruptTest {
  public:
@@ -21886,6 +22300,35 @@ TEST(EscapeableHandleScope) {
 }
 
 
+static void SealedCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  v8::SealHandleScope seal(info.GetIsolate());
+  info.GetReturnValue().Set(info.Length());
+  {
+    // Handles can still be created in an inner scope.
+    v8::HandleScope inner_scope(info.GetIsolate());
+    CHECK(!v8::Object::New(info.GetIsolate()).IsEmpty());
+  }
+}
+
+
+TEST(SealHandleScope) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  context->Global()->Set(
+      v8_str("sealed"),
+      v8::FunctionTemplate::New(isolate, SealedCallback)->GetFunction());
+  int handles = v8::HandleScope::NumberOfHandles(isolate);
+  {
+    v8::HandleScope inner_scope(isolate);
+    ExpectInt32("var sum = 0;"
+                "for (var i = 0; i < 1000; i++) sum += sealed(i, i);"
+                "sum", 2000);
+  }
+  CHECK_EQ(handles, v8::HandleScope::NumberOfHandles(isolate));
+}
+
+
 static void SetterWhichExpectsThisAndHolderToDiffer(
     Local<String>, Local<Value>, const v8::PropertyCallbackInfo<void>& info) {
   CHECK(info.Holder() != info.This());
@@ -712,4 +712,90 @@ TEST(AssemblerX64SSE) {
   F6 f = FUNCTION_CAST<F6>(Code::cast(code)->entry());
   CHECK_EQ(2, f(1.0, 2.0));
 }
+
+
+typedef double (*F8)(double x, double y);
+TEST(AssemblerX64AVX_sd) {
+  CcTest::InitializeVM();
+  if (!CpuFeatures::IsSupported(AVX)) return;
+
+  Isolate* isolate = reinterpret_cast<Isolate*>(CcTest::isolate());
+  HandleScope scope(isolate);
+  v8::internal::byte buffer[256];
+  MacroAssembler assm(isolate, buffer, sizeof buffer);
+  {
+    CpuFeatureScope avx_scope(&assm, AVX);
+    // Use high registers to exercise both VEX prefix forms.
+    __ vaddsd(xmm8, xmm0, xmm1);  // x + y
+    __ vmulsd(xmm9, xmm8, xmm0);  // (x + y) * x
+    __ vsubsd(xmm2, xmm9, xmm1);  // (x + y) * x - y
+    __ vdivsd(xmm0, xmm2, xmm8);  // ((x + y) * x - y) / (x + y)
+    __ movq(rax, xmm1);
+    __ push(rax);
+    __ vaddsd(xmm0, xmm0, Operand(rsp, 0));  // ... + y
+    __ pop(rcx);
+    __ ret(0);
+  }
+
+  CodeDesc desc;
+  assm.GetCode(&desc);
+  Code* code = Code::cast(isolate->heap()->CreateCode(
+      desc,
+      Code::ComputeFlags(Code::STUB),
+      Handle<Code>())->ToObjectChecked());
+  CHECK(code->IsCode());
+#ifdef OBJECT_PRINT
+  Code::cast(code)->Print();
+#endif
+
+  F8 f = FUNCTION_CAST<F8>(Code::cast(code)->entry());
+  CHECK_EQ(7.0 / 5.0 + 3.0, f(2.0, 3.0));
+}
+
+
+typedef Object* (*F7)();
+TEST(AssemblerX64EmbeddedConstantPool) {
+  FLAG_enable_embedded_constant_pool = true;
+  CcTest::InitializeVM();
+
+  Isolate* isolate = reinterpret_cast<Isolate*>(CcTest::isolate());
+  HandleScope scope(isolate);
+  Handle<Object> first = isolate->factory()->true_value();
+  Handle<Object> second = isolate->factory()->false_value();
+  MacroAssembler assm(isolate, NULL, 0);
+  {
+    __ movp(rax, first.location(), RelocInfo::EMBEDDED_OBJECT);
+    __ movp(r11, second.location(), RelocInfo::EMBEDDED_OBJECT);
+    __ movp(rdx, first.location(), RelocInfo::EMBEDDED_OBJECT);
+    __ cmpq(rax, rdx);
+    Label equal_loads;
+    __ j(equal, &equal_loads);
+    __ movp(rax, r11);
+    __ bind(&equal_loads);
+    __ ret(0);
+  }
+
+  CodeDesc desc;
+  assm.GetCode(&desc);
+  Code* code = Code::cast(isolate->heap()->CreateCode(
+      desc,
+      Code::ComputeFlags(Code::STUB),
+      Handle<Code>())->ToObjectChecked());
+  CHECK(code->IsCode());
+#ifdef OBJECT_PRINT
+  code->Print();
+#endif
+
+  // Two distinct objects give two pool slots.
+  int embedded_objects = 0;
+  int mask = RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT);
+  for (RelocIterator it(code, mask); !it.done(); it.next()) {
+    embedded_objects++;
+  }
+  CHECK_EQ(2, embedded_objects);
+
+  F7 f = FUNCTION_CAST<F7>(code->entry());
+  CHECK_EQ(*first, f());
+  FLAG_enable_embedded_constant_pool = false;
+}
 #undef __
@@ -32,6 +32,7 @@
 
 #include "compiler.h"
 #include "disasm.h"
+#include "ic-stats.h"
 #include "cctest.h"
 
 using namespace v8::internal;
@@ -67,6 +68,7 @@ static Handle<JSFunction> Compile(const char* source) {
                               false,
                               Handle<Context>(isolate->native_context()),
                               NULL, NULL,
+                              NO_CACHED_DATA,
                               NOT_NATIVES_CODE);
   return isolate->factory()->NewFunctionFromSharedFunctionInfo(
       shared_function, isolate->native_context());
@@ -435,3 +437,32 @@ TEST(SplitConstantsInFullCompiler) {
   CheckCodeForUnsafeLiteral(GetJSFunction(context->Global(), "f"));
 }
 #endif
+
+
+TEST(ICStatsRecordsMegamorphicSite) {
+  FLAG_ic_stats = true;
+  LocalContext context;
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun("function get(o) { return o.x; }"
+             "var shapes = [{x:1}, {x:1, a:1}, {x:1, b:1}, {x:1, c:1},"
+             "              {x:1, d:1}, {x:1, e:1}, {x:1, f:1}];"
+             "for (var i = 0; i < shapes.length; i++) get(shapes[i]);");
+
+  ICStats* stats = CcTest::i_isolate()->GetICStats();
+  const ICStats::Entry* site = NULL;
+  for (int i = 0; i < stats->length(); i++) {
+    const ICStats::Entry* entry = stats->at(i);
+    if (strcmp(entry->function_name, "get") == 0 &&
+        strcmp(entry->type, "LoadIC") == 0 && !entry->keyed) {
+      CHECK_EQ(NULL, site);
+      site = entry;
+    }
+  }
+  CHECK_NE(NULL, site);
+  CHECK_GT(site->transitions[MONOMORPHIC], 0);
+  CHECK_GT(site->transitions[POLYMORPHIC], 0);
+  CHECK_GT(site->transitions[MEGAMORPHIC], 0);
+  CHECK_GT(site->max_map_count, 1);
+  FLAG_ic_stats = false;
+}
@@ -304,6 +304,76 @@ TEST(ExponentNumberStr) {
 }
 
 
+static bool FastStringToDoubleChar(const char* str, double* result) {
+  return FastStringToDouble(
+      Vector<const uint8_t>(reinterpret_cast<const uint8_t*>(str),
+                            StrLength(str)),
+      result);
+}
+
+
+TEST(FastStringToDouble) {
+  double result;
+  CHECK(FastStringToDoubleChar("0", &result));
+  CHECK_EQ(0.0, result);
+  CHECK(FastStringToDoubleChar("-0", &result));
+  CHECK(std::signbit(result));
+  CHECK(FastStringToDoubleChar("12345678", &result));
+  CHECK_EQ(12345678.0, result);
+  CHECK(FastStringToDoubleChar("-1234567890123456789", &result));
+  CHECK_EQ(-1234567890123456789.0, result);
+  CHECK(FastStringToDoubleChar("12345678.87654321", &result));
+  CHECK_EQ(12345678.87654321, result);
+  CHECK(FastStringToDoubleChar("0.30000000000000004", &result));
+  CHECK_EQ(0.30000000000000004, result);
+  CHECK(FastStringToDoubleChar("0.000000000000000000000000000001234",
+                               &result));
+  CHECK_EQ(1.234e-30, result);
+  CHECK(FastStringToDoubleChar("-1.25e+3", &result));
+  CHECK_EQ(-1250.0, result);
+  CHECK(FastStringToDoubleChar("1E-5", &result));
+  CHECK_EQ(1e-5, result);
+  CHECK(FastStringToDoubleChar(".5", &result));
+  CHECK_EQ(0.5, result);
+  CHECK(FastStringToDoubleChar("5.", &result));
+  CHECK_EQ(5.0, result);
+
+  // Everything else is left to StringToDouble.
+  CHECK(!FastStringToDoubleChar("", &result));
+  CHECK(!FastStringToDoubleChar("-", &result));
+  CHECK(!FastStringToDoubleChar(".", &result));
+  CHECK(!FastStringToDoubleChar("1e", &result));
+  CHECK(!FastStringToDoubleChar(" 1", &result));
+  CHECK(!FastStringToDoubleChar("1 ", &result));
+  CHECK(!FastStringToDoubleChar("+1", &result));
+  CHECK(!FastStringToDoubleChar("0x10", &result));
+  CHECK(!FastStringToDoubleChar("Infinity", &result));
+  CHECK(!FastStringToDoubleChar("1e400", &result));
+  CHECK(!FastStringToDoubleChar("12345678901234567890", &result));
+  CHECK(!FastStringToDoubleChar("3.14159265358979323846", &result));
+}
+
+
+TEST(DoubleToCString) {
+  char buffer_container[kDoubleToCStringMinBufferSize];
+  Vector<char> buffer(buffer_container, kDoubleToCStringMinBufferSize);
+  CHECK_EQ("0", DoubleToCString(-0.0, buffer));
+  CHECK_EQ("42", DoubleToCString(42.0, buffer));
+  CHECK_EQ("-2147483649", DoubleToCString(-2147483649.0, buffer));
+  CHECK_EQ("9007199254740991", DoubleToCString(9007199254740991.0, buffer));
+  CHECK_EQ("-9007199254740991", DoubleToCString(-9007199254740991.0, buffer));
+  // Beyond 2^53 the shortest representation is no longer the integer.
+  CHECK_EQ("1152921504606847000", DoubleToCString(1152921504606846976.0,
+                                                   buffer));
+  CHECK_EQ("1e+21", DoubleToCString(1e21, buffer));
+  CHECK_EQ("0.1", DoubleToCString(0.1, buffer));
+  CHECK_EQ("-1.5", DoubleToCString(-1.5, buffer));
+  CHECK_EQ("1.7976931348623157e+308",
+           DoubleToCString(1.7976931348623157e308, buffer));
+  CHECK_EQ("5e-324", DoubleToCString(5e-324, buffer));
+}
+
+
 class OneBit1: public BitField<uint32_t, 0, 1> {};
 class OneBit2: public BitField<uint32_t, 7, 1> {};
 class EightBit1: public BitField<uint32_t, 0, 8> {};
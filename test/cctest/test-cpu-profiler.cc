@@ -658,6 +658,31 @@ TEST(SampleWhenFrameIsNotSetup) {
 }
 
 
+// Samples are collected when the kernel drives the sampling (or, where
+// perf events are not available, when the sampler falls back to signals
+// from the profiler thread).
+TEST(CollectCpuProfileWithPerfEventSampler) {
+  i::FLAG_perf_event_sampler = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  v8::Script::Compile(v8::String::NewFromUtf8(
+                          env->GetIsolate(), cpu_profiler_test_source2))->Run();
+  v8::Local<v8::Function> function = v8::Local<v8::Function>::Cast(
+      env->Global()->Get(v8::String::NewFromUtf8(env->GetIsolate(), "start")));
+
+  v8::Handle<v8::Value> args[] = { v8::Integer::New(env->GetIsolate(), 1) };
+  const v8::CpuProfile* profile =
+      RunProfiler(env.local(), function, args, ARRAY_SIZE(args), 50);
+
+  const v8::CpuProfileNode* root = profile->GetTopDownRoot();
+  CHECK_NE(NULL, FindChild(env->GetIsolate(), root, "start"));
+
+  const_cast<v8::CpuProfile*>(profile)->Delete();
+  i::FLAG_perf_event_sampler = false;
+}
+
+
 static const char* native_accessor_test_source = "function start(count) {\n"
 "  for (var i = 0; i < count; i++) {\n"
 "    var o = instance.foo;\n"
@@ -40,10 +40,14 @@ class DateCacheMock: public DateCache {
   };
 
   DateCacheMock(int local_offset, Rule* rules, int rules_count)
-      : local_offset_(local_offset), rules_(rules), rules_count_(rules_count) {}
+      : local_offset_(local_offset), rules_(rules), rules_count_(rules_count),
+        os_calls_(0) {}
+
+  int os_calls() { return os_calls_; }
 
  protected:
   virtual int GetDaylightSavingsOffsetFromOS(int64_t time_sec) {
+    os_calls_++;
     int days = DaysFromTime(time_sec * 1000);
     int time_in_day_sec = TimeInDay(time_sec * 1000, days) / 1000;
     int year, month, day;
@@ -97,6 +101,7 @@ class DateCacheMock: public DateCache {
   int local_offset_;
   Rule* rules_;
   int rules_count_;
+  int os_calls_;
 };
 
 static int64_t TimeFromYearMonthDay(DateCache* date_cache,
@@ -167,3 +172,67 @@ TEST(DaylightSavingsTime) {
   CheckDST(august_20 + 2 * 3600 - 1000);
   CheckDST(august_20);
 }
+
+
+TEST(DaylightSavingsTimeTable) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  DateCacheMock::Rule rules[] = {
+    {0, 2, 0, 10, 0, 3600},  // DST from March to November in any year.
+  };
+  DateCacheMock* date_cache = new DateCacheMock(0, rules, ARRAY_SIZE(rules));
+  reinterpret_cast<Isolate*>(isolate)->set_date_cache(date_cache);
+
+  int64_t start_of_2013 = TimeFromYearMonthDay(date_cache, 2013, 0, 1);
+  int64_t start_of_2014 = TimeFromYearMonthDay(date_cache, 2014, 0, 1);
+  date_cache->ToLocal(start_of_2013);
+  // Once the transitions around a time are tabulated, looking up any
+  // time in the same ~388 day block does not query the OS again.
+  int64_t block_start =
+      (start_of_2013 / 1000) & ~static_cast<int64_t>((1 << 25) - 1);
+  int64_t block_end = (block_start + (1 << 25)) * 1000;
+  int os_calls = date_cache->os_calls();
+  for (int64_t time = block_start * 1000; time < block_end;
+       time += DateCache::kMsPerDay / 3) {
+    date_cache->ToLocal(time);
+  }
+  CHECK_EQ(os_calls, date_cache->os_calls());
+
+  for (int64_t time = start_of_2013; time < start_of_2014;
+       time += DateCache::kMsPerDay / 7) {
+    CheckDST(time);
+  }
+}
+
+
+TEST(YearMonthDayFromDays) {
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  DateCache* date_cache = CcTest::i_isolate()->date_cache();
+  static const int kMaxDays = 100000010;
+  for (int days = -kMaxDays; days <= kMaxDays; days += 997) {
+    // Visit whole months to exercise both the cached and uncached paths.
+    for (int i = 0; i < 40; i++) {
+      int year, month, day;
+      date_cache->YearMonthDayFromDays(days + i, &year, &month, &day);
+      CHECK_LE(0, month);
+      CHECK_LT(month, 12);
+      CHECK_EQ(days + i,
+               date_cache->DaysFromYearMonth(year, month) + day - 1);
+    }
+  }
+  int year, month, day;
+  date_cache->YearMonthDayFromDays(0, &year, &month, &day);
+  CHECK_EQ(1970, year);
+  CHECK_EQ(0, month);
+  CHECK_EQ(1, day);
+  date_cache->YearMonthDayFromDays(11016, &year, &month, &day);
+  CHECK_EQ(2000, year);
+  CHECK_EQ(1, month);
+  CHECK_EQ(29, day);
+  date_cache->YearMonthDayFromDays(-1, &year, &month, &day);
+  CHECK_EQ(1969, year);
+  CHECK_EQ(11, month);
+  CHECK_EQ(31, day);
+}
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 
 #include "v8.h"
+#include "v8-profiler.h"
 
 #include "api.h"
 #include "cctest.h"
@@ -695,3 +696,98 @@ TEST(DeoptimizeLoadICStoreICNested) {
   CHECK_EQ(1, env->Global()->Get(v8_str("count"))->Int32Value());
   CHECK_EQ(13, env->Global()->Get(v8_str("result"))->Int32Value());
 }
+
+
+TEST(DeoptimizationStatistics) {
+  if (!CcTest::i_isolate()->use_crankshaft()) return;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::CpuProfiler* profiler = env->GetIsolate()->GetCpuProfiler();
+  profiler->ClearDeoptimizationStats();
+
+  // Deoptimize the same function twice at the same point.
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function g() { %DeoptimizeFunction(f); }"
+        "function f() { g(); };"
+        "for (var i = 0; i < 2; i++) {"
+        "  f(); f();"
+        "  %OptimizeFunctionOnNextCall(f);"
+        "  f();"
+        "}");
+  }
+  NonIncrementalGC();
+
+  v8::DeoptimizationStats stats[4];
+  int count = profiler->GetTopDeoptimizations(stats, 4);
+  CHECK_GE(count, 1);
+  CHECK_EQ(2, stats[0].count);
+  CHECK(stats[0].IsDeoptLoop());
+  CHECK_EQ(static_cast<int>(v8::DeoptimizationStats::kLazy),
+           static_cast<int>(stats[0].bailout_type));
+  Handle<JSFunction> f = GetJSFunction(env->Global(), "f");
+  CHECK_EQ(f->shared()->start_position(), stats[0].function_position);
+
+  profiler->ClearDeoptimizationStats();
+  CHECK_EQ(0, profiler->GetTopDeoptimizations(stats, 4));
+}
+
+
+TEST(DeoptimizationBatchScope) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  Isolate* isolate = CcTest::i_isolate();
+
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function f() { return 1; }"
+        "f(); f();"
+        "%OptimizeFunctionOnNextCall(f);"
+        "f();");
+  }
+  Handle<JSFunction> f = GetJSFunction(env->Global(), "f");
+  if (!f->IsOptimized()) return;
+
+  // Requests made inside the scope are held back until it is left.
+  {
+    i::DeoptimizationBatchScope outer(isolate);
+    f->code()->set_marked_for_deoptimization(true);
+    Deoptimizer::ScheduleDeoptimizeMarkedCode(isolate);
+    {
+      i::DeoptimizationBatchScope inner(isolate);
+      Deoptimizer::ScheduleDeoptimizeMarkedCode(isolate);
+    }
+    CHECK(f->IsOptimized());
+  }
+  CHECK(!f->IsOptimized());
+}
+
+
+TEST(TranslationIteratorRoundTrip) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+  i::Zone zone(isolate);
+
+  static const int32_t kValues[] = {
+    0, 1, -1, 63, -63, 64, -64, 8191, -8192, i::kMaxInt, -i::kMaxInt
+  };
+  static const int kValueCount = sizeof(kValues) / sizeof(kValues[0]);
+  i::TranslationBuffer buffer(&zone);
+  for (int i = 0; i < kValueCount; i++) buffer.Add(kValues[i], &zone);
+  Handle<i::ByteArray> bytes = buffer.CreateByteArray(isolate->factory());
+
+  i::TranslationIterator it(*bytes, 0);
+  for (int i = 0; i < kValueCount; i++) CHECK_EQ(kValues[i], it.Next());
+  CHECK(!it.HasNext());
+
+  // Skipping must stop at the same value boundaries as decoding.
+  i::TranslationIterator skipping(*bytes, 0);
+  skipping.Skip(5);
+  CHECK_EQ(kValues[5], skipping.Next());
+  skipping.Skip(kValueCount - 7);
+  CHECK_EQ(kValues[kValueCount - 1], skipping.Next());
+  CHECK(!skipping.HasNext());
+}
@@ -220,3 +220,123 @@ TEST(ObjectHashTableCausesGC) {
   CHECK(gc_count < isolate->heap()->gc_count());
 }
 #endif
+
+
+TEST(OrderedHashSet) {
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(context->GetIsolate());
+  Handle<OrderedHashSet> table = factory->NewOrderedHashSet();
+  CHECK_EQ(OrderedHashSet::kMinCapacity, table->Capacity());
+
+  const int kKeys = 20;
+  Handle<JSObject> keys[kKeys];
+  for (int i = 0; i < kKeys; i++) {
+    keys[i] = factory->NewJSArray(1);
+    table = OrderedHashSet::Add(table, keys[i]);
+    CHECK_EQ(i + 1, table->NumberOfElements());
+  }
+  table = OrderedHashSet::Add(table, keys[0]);
+  CHECK_EQ(kKeys, table->NumberOfElements());
+
+  // Keys still have to be found after objects were moved.
+  CcTest::heap()->CollectGarbage(NEW_SPACE);
+  for (int i = 0; i < kKeys; i++) {
+    CHECK(table->Contains(*keys[i]));
+    CHECK_EQ(*keys[i], table->KeyAt(i));
+  }
+  CHECK(!table->Contains(*factory->NewJSArray(1)));
+
+  // Removing a key leaves its entry as a hole and keeps the order.
+  table = OrderedHashSet::Remove(table, keys[3]);
+  CHECK(!table->Contains(*keys[3]));
+  CHECK_EQ(kKeys - 1, table->NumberOfElements());
+  CHECK_EQ(1, table->NumberOfDeletedElements());
+  CHECK(table->KeyAt(3)->IsTheHole());
+  CHECK_EQ(*keys[4], table->KeyAt(4));
+
+  // Removing most keys shrinks the table.
+  int capacity = table->Capacity();
+  for (int i = 4; i < kKeys; i++) {
+    table = OrderedHashSet::Remove(table, keys[i]);
+  }
+  CHECK_EQ(3, table->NumberOfElements());
+  CHECK(table->Capacity() < capacity);
+  for (int i = 0; i < 3; i++) CHECK_EQ(*keys[i], table->KeyAt(i));
+
+  // Smis, strings and numbers are keys too.
+  Handle<Object> smi(Smi::FromInt(42), isolate);
+  Handle<Object> number = factory->NewNumber(0.5);
+  Handle<Object> string = factory->NewStringFromAscii(CStrVector("foo"));
+  table = OrderedHashSet::Add(table, smi);
+  table = OrderedHashSet::Add(table, number);
+  table = OrderedHashSet::Add(table, string);
+  CHECK(table->Contains(Smi::FromInt(42)));
+  CHECK(table->Contains(*factory->NewNumber(0.5)));
+  CHECK(table->Contains(*factory->NewStringFromAscii(CStrVector("foo"))));
+  CHECK(!table->Contains(Smi::FromInt(43)));
+}
+
+
+TEST(OrderedHashSetRehashesInPlace) {
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(context->GetIsolate());
+  Handle<OrderedHashSet> table = factory->NewOrderedHashSet();
+  int capacity = table->Capacity();
+
+  // Fill the table, then delete and re-add keys so that the data table
+  // runs out of room while half of it is holes.
+  for (int i = 0; i < capacity; i++) {
+    table = OrderedHashSet::Add(table, handle(Smi::FromInt(i), isolate));
+  }
+  for (int i = 0; i < capacity / 2; i++) {
+    table = OrderedHashSet::Remove(table, handle(Smi::FromInt(i), isolate));
+  }
+  CHECK_EQ(capacity, table->Capacity());
+  Handle<OrderedHashSet> old_table = table;
+  table = OrderedHashSet::Add(table, handle(Smi::FromInt(capacity), isolate));
+  CHECK(table.is_identical_to(old_table));
+  CHECK_EQ(0, table->NumberOfDeletedElements());
+  CHECK_EQ(capacity / 2 + 1, table->NumberOfElements());
+  for (int i = 0; i <= capacity / 2; i++) {
+    CHECK_EQ(Smi::FromInt(capacity / 2 + i), table->KeyAt(i));
+  }
+}
+
+
+TEST(OrderedHashMap) {
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(context->GetIsolate());
+  Handle<OrderedHashMap> table = factory->NewOrderedHashMap();
+  Handle<JSObject> a = factory->NewJSArray(7);
+  Handle<JSObject> b = factory->NewJSArray(11);
+  table = OrderedHashMap::Put(table, a, b);
+  CHECK_EQ(1, table->NumberOfElements());
+  CHECK_EQ(*b, table->Lookup(*a));
+  CHECK(table->Lookup(*b)->IsTheHole());
+
+  // Keys that are overwritten should not change number of elements.
+  table = OrderedHashMap::Put(table, a, factory->NewJSArray(13));
+  CHECK_EQ(1, table->NumberOfElements());
+  CHECK_NE(*b, table->Lookup(*a));
+
+  // Keys mapped to the hole should be removed.
+  table = OrderedHashMap::Put(table, a, factory->the_hole_value());
+  CHECK_EQ(0, table->NumberOfElements());
+  CHECK(table->Lookup(*a)->IsTheHole());
+
+  // Keys should map back to their respective values.
+  for (int i = 0; i < 100; i++) {
+    Handle<JSReceiver> key = factory->NewJSArray(7);
+    Handle<JSObject> value = factory->NewJSArray(11);
+    table = OrderedHashMap::Put(table, key, value);
+    CHECK_EQ(i + 1, table->NumberOfElements());
+    CHECK_EQ(*key, table->KeyAt(table->FindEntry(*key)));
+    CHECK_EQ(*value, table->Lookup(*key));
+  }
+}
@@ -391,6 +391,10 @@ TEST(DisasmX64) {
     __ ucomisd(xmm0, xmm1);
 
     __ andpd(xmm0, xmm1);
+
+    __ pcmpeqb(xmm1, xmm0);
+    __ pmovmskb(rdx, xmm1);
+    __ pshufd(xmm0, xmm1, 0);
   }
 
   // cmov.
@@ -420,6 +424,37 @@ TEST(DisasmX64) {
     }
   }
 
+  // AVX instructions
+  {
+    if (CpuFeatures::IsSupported(AVX)) {
+      CpuFeatureScope scope(&assm, AVX);
+      __ vaddsd(xmm0, xmm1, xmm2);
+      __ vaddsd(xmm8, xmm9, xmm10);
+      __ vaddsd(xmm0, xmm1, Operand(rbx, rcx, times_4, 10000));
+      __ vaddsd(xmm0, xmm1, Operand(r9, r11, times_4, 10000));
+      __ vsubsd(xmm0, xmm1, xmm2);
+      __ vmulsd(xmm0, xmm1, xmm2);
+      __ vmulsd(xmm0, xmm1, Operand(rbx, rcx, times_4, 10000));
+      __ vdivsd(xmm0, xmm1, xmm2);
+    }
+  }
+
+  {
+    if (CpuFeatures::IsSupported(POPCNT)) {
+      CpuFeatureScope scope(&assm, POPCNT);
+      __ popcntl(rax, rdx);
+      __ popcntl(r9, r11);
+    }
+    if (CpuFeatures::IsSupported(LZCNT)) {
+      CpuFeatureScope scope(&assm, LZCNT);
+      __ lzcntl(rax, rdx);
+    }
+    if (CpuFeatures::IsSupported(BMI1)) {
+      CpuFeatureScope scope(&assm, BMI1);
+      __ tzcntl(rax, rdx);
+    }
+  }
+
   // Nop instructions
   for (int i = 0; i < 16; i++) {
     __ Nop(i);
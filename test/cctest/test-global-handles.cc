@@ -321,6 +321,51 @@ TEST(ImplicitReferences) {
 }
 
 
+TEST(NewSpaceNodesCompactedOnGrowth) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  GlobalHandles* global_handles = isolate->global_handles();
+  HandleScope scope(isolate);
+
+  heap->CollectGarbage(NEW_SPACE);
+  int initial = global_handles->NumberOfNewSpaceNodes();
+
+  // The nodes of these handles end up on the new space list, and are then
+  // reused for old space objects.
+  const int kHandles = 256;
+  Handle<Object> handles[kHandles];
+  for (int i = 0; i < kHandles; i++) {
+    handles[i] = global_handles->Create(*factory->NewFixedArray(1));
+    CHECK(heap->InNewSpace(*handles[i]));
+  }
+  for (int i = 0; i < kHandles; i++) {
+    GlobalHandles::Destroy(handles[i].location());
+  }
+  for (int i = 0; i < kHandles; i++) {
+    handles[i] = global_handles->Create(*factory->NewFixedArray(1, TENURED));
+  }
+  CHECK_EQ(initial + kHandles, global_handles->NumberOfNewSpaceNodes());
+
+  // Growing the list for young handles drops the stale entries.
+  const int kYoungHandles = 3 * kHandles;
+  Handle<Object> young[kYoungHandles];
+  for (int i = 0; i < kYoungHandles; i++) {
+    young[i] = global_handles->Create(*factory->NewFixedArray(1));
+  }
+  CHECK_LT(global_handles->NumberOfNewSpaceNodes(),
+           initial + kHandles + kYoungHandles);
+
+  for (int i = 0; i < kHandles; i++) {
+    GlobalHandles::Destroy(handles[i].location());
+  }
+  for (int i = 0; i < kYoungHandles; i++) {
+    GlobalHandles::Destroy(young[i].location());
+  }
+}
+
+
 TEST(EternalHandles) {
   CcTest::InitializeVM();
   Isolate* isolate = CcTest::i_isolate();
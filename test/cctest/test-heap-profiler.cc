@@ -2288,6 +2288,39 @@ TEST(TrackHeapAllocations) {
 }
 
 
+TEST(TrackHeapAllocationsSampled) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  LocalContext env;
+
+  int saved_sampling_interval = i::FLAG_heap_profiler_sampling_interval;
+  i::FLAG_heap_profiler_sampling_interval = 1024;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  heap_profiler->StartTrackingHeapObjects(true);
+
+  CompileRun(
+    "var a = [];\n"
+    "for (var i = 0; i < 1000; ++i)\n"
+    "    a.push({ x: i });\n");
+
+  AllocationTracker* tracker =
+      reinterpret_cast<i::HeapProfiler*>(heap_profiler)->allocation_tracker();
+  CHECK_NE(NULL, tracker);
+  tracker->PrepareForSerialization();
+  tracker->trace_tree()->Print(tracker);
+
+  // About one allocation per kilobyte is recorded, so the loop leaves a
+  // few dozen samples rather than one per object.
+  const char* names[] = { "(anonymous function)" };
+  AllocationTraceNode* node =
+      FindNode(tracker, Vector<const char*>(names, ARRAY_SIZE(names)));
+  CHECK_NE(NULL, node);
+  CHECK_GT(node->allocation_count(), 0);
+  CHECK_LT(node->allocation_count(), 1000);
+  heap_profiler->StopTrackingHeapObjects();
+  i::FLAG_heap_profiler_sampling_interval = saved_sampling_interval;
+}
+
+
 static const char* inline_heap_allocation_source =
 "function f_0(x) {\n"
 "  return f_1(x+1);\n"
@@ -2566,3 +2599,33 @@ TEST(AddressToTraceMap) {
   CHECK_EQ(0, static_cast<int>(map.size()));
   CHECK_EQ(0, map.GetTraceNodeId(ToAddress(0x400)));
 }
+
+
+TEST(TopAllocationSites) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  CompileRun(
+      "var small = [];"
+      "var large = [];"
+      "for (var i = 0; i < 100; i++) {"
+      "  small.push({a: i});"
+      "  large.push({a: i, b: i, c: i, d: i, e: i, f: i, g: i, h: i});"
+      "}");
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+
+  v8::AllocationSiteStats stats[2];
+  int count = heap_profiler->GetTopAllocationSites(stats, 2);
+  CHECK_LE(count, 2);
+  for (int i = 0; i < count; i++) {
+    CHECK_NE(v8::HeapProfiler::kUnknownObjectId,
+             static_cast<int>(stats[i].id));
+    CHECK_GT(static_cast<int>(stats[i].survived_bytes), 0);
+  }
+  if (count == 2) {
+    CHECK_GE(static_cast<int>(stats[0].survived_bytes),
+             static_cast<int>(stats[1].survived_bytes));
+  }
+  CHECK_EQ(0, heap_profiler->GetTopAllocationSites(stats, 0));
+}
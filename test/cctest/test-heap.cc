@@ -1083,6 +1083,62 @@ TEST(TestCodeFlushing) {
 }
 
 
+TEST(TestAdaptiveCodeFlushing) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_optimize_for_size = false;
+  i::FLAG_adaptive_code_flushing = true;
+  i::FLAG_code_flushing_pin_threshold = 2;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* source = "function foo() {"
+                       "  var x = 42;"
+                       "  var y = 42;"
+                       "  var z = x + y;"
+                       "};"
+                       "function bar() { return 1; };"
+                       "%NeverFlushFunction(bar);"
+                       "foo(); bar()";
+  Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+  Handle<String> bar_name = factory->InternalizeUtf8String("bar");
+  { v8::HandleScope scope(CcTest::isolate());
+    CompileRun(source);
+  }
+  Handle<JSFunction> foo(JSFunction::cast(
+      CcTest::i_isolate()->context()->global_object()->
+          GetProperty(*foo_name)->ToObjectChecked()));
+  Handle<JSFunction> bar(JSFunction::cast(
+      CcTest::i_isolate()->context()->global_object()->
+          GetProperty(*bar_name)->ToObjectChecked()));
+  CHECK_EQ(0, foo->shared()->flush_count());
+
+  // Each flush is counted, until the function is pinned.
+  const int kAgingThreshold = 8;
+  for (int round = 1; round <= 3; round++) {
+    for (int i = 0; i < kAgingThreshold; i++) {
+      CcTest::heap()->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+    }
+    if (round <= 2) {
+      CHECK(!foo->shared()->is_compiled());
+      CHECK_EQ(round, foo->shared()->flush_count());
+      CompileRun("foo()");
+      CHECK(foo->shared()->is_compiled());
+    } else {
+      CHECK(foo->shared()->is_compiled());
+      CHECK_EQ(2, foo->shared()->flush_count());
+    }
+  }
+
+  // Functions pinned explicitly are never flushed.
+  CHECK(bar->shared()->is_compiled());
+  CHECK_EQ(0, bar->shared()->flush_count());
+  i::FLAG_adaptive_code_flushing = false;
+}
+
+
 TEST(TestCodeFlushingPreAged) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code) return;
@@ -1723,6 +1779,30 @@ TEST(GrowAndShrinkNewSpace) {
 }
 
 
+TEST(ScavengePauseTargetGrowsNewSpace) {
+  // A pause target that is never reached lets new space grow to its maximum.
+  i::FLAG_scavenge_pause_target = 100000;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  NewSpace* new_space = heap->new_space();
+  if (heap->MaxSemiSpaceSize() == heap->InitialSemiSpaceSize()) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  intptr_t old_capacity = new_space->Capacity();
+  Handle<FixedArray> survivor = CcTest::i_isolate()->factory()->NewFixedArray(
+      1000, NOT_TENURED);
+  CHECK(heap->InNewSpace(*survivor));
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_LT(old_capacity, new_space->Capacity());
+
+  // Explicit shrinking honours the requested minimum capacity.
+  heap->CollectGarbage(NEW_SPACE);
+  intptr_t grown_capacity = new_space->Capacity();
+  new_space->Shrink(static_cast<int>(grown_capacity));
+  CHECK_EQ(grown_capacity, new_space->Capacity());
+}
+
+
 TEST(CollectingAllAvailableGarbageShrinksNewSpace) {
   CcTest::InitializeVM();
   Heap* heap = CcTest::heap();
@@ -2568,6 +2648,55 @@ TEST(OptimizedPretenuringCallNew) {
 }
 
 
+TEST(AllocationSitePretenuringDecay) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  Handle<AllocationSite> site = CcTest::i_isolate()->factory()->
+      NewAllocationSite();
+
+  site->IncrementSurvivedBytes(64);
+  CHECK_EQ(64, site->survived_bytes());
+  site->IncrementSurvivedBytes(Smi::kMaxValue);
+  CHECK_EQ(Smi::kMaxValue, site->survived_bytes());
+
+  site->set_pretenure_decision(AllocationSite::kDontTenure);
+  CHECK(!heap->DecayPretenuringDecisions());
+  CHECK_EQ(AllocationSite::kDontTenure, site->pretenure_decision());
+
+  site->set_pretenure_decision(AllocationSite::kTenure);
+  CHECK(heap->DecayPretenuringDecisions());
+  CHECK_EQ(AllocationSite::kUndecided, site->pretenure_decision());
+  CHECK_EQ(NOT_TENURED, site->GetPretenureMode());
+  CHECK(site->deopt_dependent_code());
+  site->set_deopt_dependent_code(false);
+}
+
+
+TEST(ScavengePromotesAllInHighPromotionMode) {
+  i::FLAG_scavenge_promote_in_high_promotion_mode = true;
+  CcTest::InitializeVM();
+  if (i::FLAG_gc_global || i::FLAG_stress_compaction) return;
+  Heap* heap = CcTest::heap();
+  Factory* factory = CcTest::i_isolate()->factory();
+  HandleScope scope(CcTest::i_isolate());
+
+  // Objects that survive their first scavenge normally stay in new space.
+  Handle<FixedArray> young = factory->NewFixedArray(8);
+  CHECK(heap->InNewSpace(*young));
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(heap->InNewSpace(*young));
+
+  // In high promotion mode they are promoted right away.
+  heap->SetNewSpaceHighPromotionModeActive(true);
+  Handle<FixedArray> promoted = factory->NewFixedArray(8);
+  CHECK(heap->InNewSpace(*promoted));
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(!heap->InNewSpace(*promoted));
+  heap->SetNewSpaceHighPromotionModeActive(false);
+}
+
+
 static int CountMapTransitions(Map* map) {
   return map->transitions()->number_of_transitions();
 }
@@ -2698,6 +2827,42 @@ TEST(Regress2143b) {
 }
 
 
+TEST(ParallelPointerUpdate) {
+  i::FLAG_parallel_pointer_update = true;
+  i::FLAG_always_compact = true;
+#ifdef VERIFY_HEAP
+  i::FLAG_verify_heap = true;
+#endif
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  v8::HandleScope scope(CcTest::isolate());
+  static const int kNumberOfArrays = 8;
+
+  // Spread arrays that point to each other over several pages so that
+  // more than one evacuation candidate has recorded slots.
+  PagedSpace* old_pointer_space = heap->old_pointer_space();
+  Handle<FixedArray> arrays[kNumberOfArrays];
+  for (int i = 0; i < kNumberOfArrays; i++) {
+    AlwaysAllocateScope always_allocate;
+    SimulateFullSpace(old_pointer_space);
+    arrays[i] = factory->NewFixedArray(2, TENURED);
+    arrays[i]->set(0, Smi::FromInt(i));
+    if (i > 0) arrays[i]->set(1, *arrays[i - 1]);
+  }
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+
+  for (int i = 1; i < kNumberOfArrays; i++) {
+    FixedArray* previous = FixedArray::cast(arrays[i]->get(1));
+    CHECK_EQ(*arrays[i - 1], previous);
+    CHECK_EQ(Smi::FromInt(i - 1), previous->get(0));
+  }
+}
+
+
 TEST(ReleaseOverReservedPages) {
   i::FLAG_trace_gc = true;
   // The optimizer can allocate stuff, messing up the test.
@@ -2744,6 +2909,62 @@ TEST(ReleaseOverReservedPages) {
 }
 
 
+TEST(ReduceMemoryFootprintReleasesEmptyPages) {
+  // The optimizer can allocate stuff, messing up the test.
+  i::FLAG_crankshaft = false;
+  i::FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  v8::HandleScope scope(CcTest::isolate());
+  static const int number_of_test_pages = 4;
+
+  // Prepare pages that only contain garbage.
+  PagedSpace* old_pointer_space = heap->old_pointer_space();
+  CHECK_EQ(1, old_pointer_space->CountTotalPages());
+  for (int i = 0; i < number_of_test_pages; i++) {
+    AlwaysAllocateScope always_allocate;
+    v8::HandleScope inner_scope(CcTest::isolate());
+    SimulateFullSpace(old_pointer_space);
+    CcTest::i_isolate()->factory()->NewFixedArray(1, TENURED);
+  }
+  CHECK_EQ(number_of_test_pages + 1, old_pointer_space->CountTotalPages());
+
+  // A single memory reducing GC releases every empty page and the unused
+  // semispace.
+  heap->ReduceMemoryFootprint("triggered by test");
+  CHECK_EQ(1, old_pointer_space->CountTotalPages());
+  CHECK_EQ(heap->new_space()->Capacity(),
+           heap->new_space()->CommittedMemory());
+}
+
+
+#ifdef V8_USE_DEFAULT_PLATFORM
+TEST(IdleTasksFinishIncrementalMarking) {
+  if (!i::FLAG_incremental_marking) return;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  MarkCompactCollector* collector = heap->mark_compact_collector();
+  if (collector->IsConcurrentSweepingInProgress()) {
+    collector->WaitUntilSweepingCompleted();
+  }
+
+  IncrementalMarking* marking = heap->incremental_marking();
+  int gc_count = heap->gc_count();
+  if (marking->IsStopped()) marking->Start();
+  CHECK(!marking->IsStopped());
+
+  // Starting incremental marking posted an idle task that keeps reposting
+  // itself until marking is finalized.
+  for (int i = 0; i < 1000 && !marking->IsStopped(); i++) {
+    CcTest::isolate()->RunIdleTasks(1000);
+  }
+  CHECK(marking->IsStopped());
+  CHECK_LT(gc_count, heap->gc_count());
+}
+#endif  // V8_USE_DEFAULT_PLATFORM
+
+
 TEST(Regress2237) {
   i::FLAG_stress_compaction = false;
   CcTest::InitializeVM();
@@ -3514,6 +3735,28 @@ TEST(IncrementalMarkingStepMakesBigProgressWithLargeObjects) {
 }
 
 
+TEST(IncrementalMarkingTimeBoundedStepsComplete) {
+  i::FLAG_max_incremental_marking_step_time = 1;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  CompileRun("var a = [];"
+             "for (var i = 0; i < 100000; i++) a.push({ x: i, y: [i] });");
+  MarkCompactCollector* collector = CcTest::heap()->mark_compact_collector();
+  if (collector->IsConcurrentSweepingInProgress()) {
+    collector->WaitUntilSweepingCompleted();
+  }
+  IncrementalMarking* marking = CcTest::heap()->incremental_marking();
+  if (marking->IsStopped()) marking->Start();
+  CHECK(marking->IsMarking());
+  // Bounded steps still make progress and eventually complete marking.
+  while (!marking->IsComplete()) {
+    marking->Step(MB, IncrementalMarking::GC_VIA_STACK_GUARD);
+  }
+  CHECK(marking->IsComplete());
+  CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+}
+
+
 TEST(DisableInlineAllocation) {
   i::FLAG_allow_natives_syntax = true;
   CcTest::InitializeVM();
@@ -3697,3 +3940,391 @@ TEST(ObjectsInOptimizedCodeAreWeak) {
 
   ASSERT(code->marked_for_deoptimization());
 }
+
+
+TEST(LargeObjectStoreBufferOverflowUsesCardTable) {
+  if (!i::FLAG_store_buffer_card_marking) return;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  v8::HandleScope scope(CcTest::isolate());
+
+  // Store more pointers to new space into a large object than the store
+  // buffer can hold.
+  static const int kLength = 2 * StoreBuffer::kOldStoreBufferLength;
+  Handle<FixedArray> array = factory->NewFixedArray(kLength, TENURED);
+  CHECK(heap->lo_space()->Contains(*array));
+  Handle<HeapNumber> number = factory->NewHeapNumber(1.5);
+  CHECK(heap->InNewSpace(*number));
+  for (int i = 0; i < kLength; i++) array->set(i, *number);
+
+  // The page is not rescanned as a whole but remembers its dirty cards.
+  MemoryChunk* chunk = MemoryChunk::FromAddress(array->address());
+  CHECK(!chunk->scan_on_scavenge());
+  CHECK(chunk->card_table() != NULL);
+  CHECK(chunk->card_table()->is_dirty());
+
+  heap->CollectGarbage(NEW_SPACE);
+  for (int i = 0; i < kLength; i++) CHECK(array->get(i) == *number);
+}
+
+
+TEST(RetainedRegExpsSurviveGC) {
+  if (!FLAG_compilation_cache) return;
+  FLAG_regexp_cache_size = 2;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  CompilationCache* cache = isolate->compilation_cache();
+  cache->Clear();
+
+  CompileRun("/a+b/.exec('aab'); /c+d/.exec('ccd'); /e+f/.exec('eef');"
+             "/c+d/.exec('ccd');");
+  Handle<String> ab = factory->InternalizeUtf8String("a+b");
+  Handle<String> cd = factory->InternalizeUtf8String("c+d");
+  Handle<String> ef = factory->InternalizeUtf8String("e+f");
+  JSRegExp::Flags flags(JSRegExp::NONE);
+
+  // Enough full collections to age out every generation and flush code.
+  for (int i = 0; i < 10; i++) {
+    CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  }
+
+  // Only the two most recently used regexps are retained, with their code.
+  CHECK(cache->LookupRegExp(ab, flags).is_null());
+  Handle<FixedArray> data = cache->LookupRegExp(cd, flags);
+  CHECK(!data.is_null());
+  CHECK(data->get(JSRegExp::code_index(true))->IsCode());
+  CHECK(!cache->LookupRegExp(ef, flags).is_null());
+  FLAG_regexp_cache_size = 0;
+}
+
+
+TEST(RetainedScriptsSharedAcrossContexts) {
+  if (!FLAG_compilation_cache) return;
+  FLAG_script_cache_budget = 1;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  CompilationCache* cache = isolate->compilation_cache();
+  cache->Clear();
+
+  const char* small_source = "var retainedScriptValue = 42;";
+  i::ScopedVector<char> large_source(2 * KB);
+  i::OS::SNPrintF(large_source, "var largeScriptValue = '%0*d';",
+                  static_cast<int>(KB + 100), 0);
+  CompileRun(small_source);
+  CompileRun(large_source.start());
+
+  // Enough full collections to age out every generation.
+  for (int i = 0; i < 10; i++) {
+    CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  }
+
+  // The small script is served to another context, the script that does
+  // not fit the budget is not retained.
+  v8::Local<v8::Context> other = v8::Context::New(CcTest::isolate());
+  Handle<Context> other_context = v8::Utils::OpenHandle(*other);
+  Handle<String> small = factory->NewStringFromAscii(CStrVector(small_source));
+  Handle<String> large =
+      factory->NewStringFromAscii(CStrVector(large_source.start()));
+  Handle<SharedFunctionInfo> shared = cache->LookupScript(
+      small, Handle<Object>(), 0, 0, false, other_context);
+  CHECK(!shared.is_null());
+  CHECK(cache->LookupScript(
+      large, Handle<Object>(), 0, 0, false, other_context).is_null());
+
+  // Entries with a different origin are not shared.
+  Handle<Object> name = factory->InternalizeUtf8String("other.js");
+  CHECK(cache->LookupScript(
+      small, name, 0, 0, false, other_context).is_null());
+  FLAG_script_cache_budget = 0;
+}
+
+
+TEST(RetainedGlobalEvalSurvivesGC) {
+  if (!FLAG_compilation_cache) return;
+  FLAG_eval_cache_budget = 1;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  CompilationCache* cache = isolate->compilation_cache();
+  cache->Clear();
+
+  const char* classic_source = "1 + 41";
+  const char* strict_source = "'use strict'; 2 + 40";
+  i::ScopedVector<char> large_source(2 * KB);
+  i::OS::SNPrintF(large_source, "'%0*d'", static_cast<int>(KB + 100), 0);
+  i::ScopedVector<char> script(4 * KB);
+  i::OS::SNPrintF(script, "var e = eval; e(\"%s\"); e(\"%s\"); e(\"%s\");",
+                  classic_source, strict_source, large_source.start());
+  CompileRun(script.start());
+
+  // Enough full collections to age out every generation.
+  for (int i = 0; i < 10; i++) {
+    CcTest::heap()->CollectAllGarbage(Heap::kNoGCFlags);
+  }
+
+  Handle<Context> context(isolate->context()->native_context());
+  Handle<String> classic =
+      factory->NewStringFromAscii(CStrVector(classic_source));
+  Handle<String> strict =
+      factory->NewStringFromAscii(CStrVector(strict_source));
+  Handle<String> large =
+      factory->NewStringFromAscii(CStrVector(large_source.start()));
+  CHECK(!cache->LookupEval(classic, context, CLASSIC_MODE,
+                           RelocInfo::kNoPosition).is_null());
+  CHECK(!cache->LookupEval(strict, context, STRICT_MODE,
+                           RelocInfo::kNoPosition).is_null());
+  // The retained entry is keyed on the language mode like the tables.
+  CHECK(cache->LookupEval(strict, context, CLASSIC_MODE,
+                          RelocInfo::kNoPosition).is_null());
+  // Sources that do not fit the budget are not retained.
+  CHECK(cache->LookupEval(large, context, CLASSIC_MODE,
+                          RelocInfo::kNoPosition).is_null());
+  FLAG_eval_cache_budget = 0;
+}
+
+
+#ifdef VERIFY_HEAP
+TEST(SampledHeapVerification) {
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  v8::HandleScope scope(CcTest::isolate());
+  const int kSample = 3;
+  FLAG_verify_heap_sample = kSample;
+
+  // Every page is verified exactly once within kSample collections.
+  int verified[2 * kSample] = { 0 };
+  for (int gc = 0; gc < kSample; gc++) {
+    heap->CollectGarbage(NEW_SPACE);
+    heap->Verify();
+    for (int i = 0; i < 2 * kSample; i++) {
+      if (heap->ShouldVerifyPage(i)) verified[i]++;
+    }
+  }
+  for (int i = 0; i < 2 * kSample; i++) CHECK_EQ(1, verified[i]);
+  FLAG_verify_heap_sample = 0;
+  for (int i = 0; i < 2 * kSample; i++) CHECK(heap->ShouldVerifyPage(i));
+}
+#endif  // VERIFY_HEAP
+
+
+TEST(DoubleFieldStoresReuseMutableBox) {
+  i::FLAG_allow_natives_syntax = true;
+  CcTest::InitializeVM();
+  if (!i::FLAG_track_double_fields) return;
+  if (i::FLAG_always_opt) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  v8::Local<v8::Value> res = CompileRun(
+      "function Particle(x) { this.x = x; }"
+      "function step(p) { p.x += 0.5; }"
+      "var p = new Particle(1.5);"
+      "p");
+  Handle<JSObject> o =
+      v8::Utils::OpenHandle(*v8::Handle<v8::Object>::Cast(res));
+  DescriptorArray* descriptors = o->map()->instance_descriptors();
+  CHECK(descriptors->GetDetails(0).representation().IsDouble());
+  Handle<Object> box(o->RawFastPropertyAt(0), CcTest::i_isolate());
+  CHECK(box->IsHeapNumber());
+
+  // Stores from the runtime, from the store IC and from optimized code all
+  // write into the existing box instead of allocating a new one.
+  CompileRun("step(p); step(p);");
+  CHECK_EQ(*box, o->RawFastPropertyAt(0));
+  CompileRun("%OptimizeFunctionOnNextCall(step); step(p);");
+  CHECK_EQ(*box, o->RawFastPropertyAt(0));
+  CHECK_EQ(3.0, HeapNumber::cast(*box)->value());
+}
+
+
+TEST(ArrayBufferPoolRecyclesBackingStores) {
+  FLAG_array_buffer_pool = true;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  ArrayBufferPool* pool = heap->array_buffer_pool();
+  pool->Flush();
+  int hits = pool->hits();
+
+  CompileRun("var buffer = new ArrayBuffer(8192);"
+             "new Uint8Array(buffer)[5] = 42;"
+             "buffer = new ArrayBuffer(1000);"
+             "buffer = null;");
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  // Only the buffer with a size class length is kept.
+  CHECK_EQ(8192, static_cast<int>(pool->pooled_bytes()));
+
+  // The reused backing store is cleared again.
+  v8::Local<v8::Value> result =
+      CompileRun("new Uint8Array(new ArrayBuffer(8192))[5]");
+  CHECK_EQ(0, result->Int32Value());
+  CHECK_EQ(hits + 1, pool->hits());
+  CHECK_EQ(0, static_cast<int>(pool->pooled_bytes()));
+
+  heap->CollectAllAvailableGarbage("testing");
+  CHECK_EQ(0, static_cast<int>(pool->pooled_bytes()));
+  FLAG_array_buffer_pool = false;
+}
+
+
+static Handle<Code> OptimizedCodeOf(const char* name) {
+  Handle<JSFunction> function = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Function>::Cast(CcTest::global()->Get(v8_str(name))));
+  return Handle<Code>(function->code());
+}
+
+
+TEST(SegregatedOptimizedCodeIsContiguous) {
+  if (i::FLAG_always_opt || !i::FLAG_crankshaft) return;
+  i::FLAG_segregate_optimized_code = true;
+  i::FLAG_allow_natives_syntax = true;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_crankshaft()) return;
+  v8::HandleScope scope(CcTest::isolate());
+
+  CompileRun("function f(x) { return x + 1; }"
+             "f(1); f(2); %OptimizeFunctionOnNextCall(f); f(3);");
+  // Create some baseline code in between.
+  CompileRun("for (var i = 0; i < 20; i++) {"
+             "  eval('(function g' + i + '() { return ' + i + '; })')();"
+             "}");
+  CompileRun("function g(x) { return x * 2; }"
+             "g(1); g(2); %OptimizeFunctionOnNextCall(g); g(3);");
+
+  Handle<Code> f_code = OptimizedCodeOf("f");
+  Handle<Code> g_code = OptimizedCodeOf("g");
+  CHECK_EQ(Code::OPTIMIZED_FUNCTION, f_code->kind());
+  CHECK_EQ(Code::OPTIMIZED_FUNCTION, g_code->kind());
+  CHECK_EQ(f_code->address() + f_code->Size(), g_code->address());
+
+  // The hot allocation area is given back before a full GC, and the heap
+  // stays iterable meanwhile.
+  CcTest::heap()->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK_EQ(Code::OPTIMIZED_FUNCTION, OptimizedCodeOf("g")->kind());
+  i::FLAG_segregate_optimized_code = false;
+}
+
+
+TEST(CodePatchedDuringGCIsFlushedOnce) {
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+
+  CompileRun("function f(o) { return o.x; }"
+             "for (var i = 0; i < 10; i++) f({x: i});");
+  bool old_always_compact = FLAG_always_compact;
+  FLAG_always_compact = true;
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  FLAG_always_compact = old_always_compact;
+
+  // No chunk is left waiting for an instruction cache flush.
+  PageIterator it(heap->code_space());
+  while (it.has_next()) {
+    CHECK(!it.next()->IsFlagSet(MemoryChunk::NEEDS_ICACHE_FLUSH));
+  }
+  CHECK_EQ(42, CompileRun("f({x: 42})")->Int32Value());
+}
+
+
+TEST(MemoryPressureNotification) {
+  CcTest::InitializeVM();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  Heap* heap = CcTest::heap();
+  heap->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK(heap->incremental_marking()->IsStopped());
+
+  CompileRun("var s = 'a,b,c'.split(','); var n = String(1.5);");
+
+  // No pressure leaves the heap alone.
+  unsigned int gc_count = heap->gc_count();
+  isolate->MemoryPressureNotification(v8::Isolate::kMemoryPressureNone);
+  CHECK_EQ(gc_count, heap->gc_count());
+  CHECK(heap->incremental_marking()->IsStopped());
+
+  // Moderate pressure drops caches and starts marking without a GC.
+  isolate->MemoryPressureNotification(v8::Isolate::kMemoryPressureModerate);
+  CHECK_EQ(gc_count, heap->gc_count());
+  if (FLAG_incremental_marking) {
+    CHECK(!heap->incremental_marking()->IsStopped());
+  }
+
+  // Critical pressure finishes with full collections.
+  isolate->MemoryPressureNotification(v8::Isolate::kMemoryPressureCritical);
+  CHECK_LT(gc_count, heap->gc_count());
+  CHECK_EQ(3, CompileRun("s.length")->Int32Value());
+}
+
+
+TEST(OptimizedCodeMapAging) {
+  if (i::FLAG_always_opt || !i::FLAG_crankshaft) return;
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_flush_optimized_code_cache = true;
+  i::FLAG_optimized_code_map_max_age = 2;
+  CcTest::InitializeVM();
+  if (!CcTest::i_isolate()->use_crankshaft()) return;
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+
+  CompileRun("function f(x) { return x + 1; }"
+             "f(1); f(2); %OptimizeFunctionOnNextCall(f); f(3);");
+  Handle<JSFunction> f = v8::Utils::OpenHandle(
+      *v8::Handle<v8::Function>::Cast(CcTest::global()->Get(v8_str("f"))));
+  Handle<SharedFunctionInfo> shared(f->shared());
+  CHECK(!shared->optimized_code_map()->IsSmi());
+
+  // An unused code map survives the configured number of GCs.
+  heap->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  heap->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK(!shared->optimized_code_map()->IsSmi());
+  heap->CollectAllGarbage(Heap::kAbortIncrementalMarkingMask);
+  CHECK(shared->optimized_code_map()->IsSmi());
+}
+
+
+class SignalingResource : public v8::String::ExternalAsciiStringResource {
+ public:
+  SignalingResource(const char* data, i::Semaphore* disposed)
+    : data_(data), length_(strlen(data)), disposed_(disposed) { }
+
+  virtual void Dispose() {
+    disposed_->Signal();
+    delete this;
+  }
+
+  const char* data() const { return data_; }
+
+  size_t length() const { return length_; }
+
+ private:
+  const char* data_;
+  size_t length_;
+  i::Semaphore* disposed_;
+};
+
+
+TEST(ExternalStringDisposedConcurrently) {
+  i::FLAG_concurrent_external_string_disposal = true;
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  i::Semaphore disposed(0);
+  static const int kStrings = 10;
+  {
+    v8::HandleScope scope(CcTest::isolate());
+    for (int i = 0; i < kStrings; i++) {
+      v8::String::NewExternal(
+          CcTest::isolate(),
+          new SignalingResource("external string contents", &disposed));
+    }
+  }
+  heap->CollectAllAvailableGarbage();
+  // The resources are disposed of in one batch on a background thread.
+  for (int i = 0; i < kStrings; i++) disposed.Wait();
+}
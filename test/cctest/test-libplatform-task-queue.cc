@@ -93,3 +93,71 @@ TEST(TaskQueueTerminateMultipleReaders) {
 
   CHECK_EQ(0, task_counter.GetCount());
 }
+
+
+TEST(TaskQueueStealFromOtherLanes) {
+  TaskCounter task_counter;
+
+  TaskQueue queue(2);
+
+  TestTask* task1 = new TestTask(&task_counter);
+  TestTask* task2 = new TestTask(&task_counter);
+  queue.Append(task1);
+  queue.Append(task2);
+  CHECK_EQ(2, task_counter.GetCount());
+
+  // Both tasks are handed out to a reader of the first lane even though the
+  // appends were spread over both lanes.
+  v8::Task* first = queue.GetNext(0);
+  v8::Task* second = queue.GetNext(0);
+  CHECK(first != second);
+  CHECK(first == task1 || first == task2);
+  CHECK(second == task1 || second == task2);
+  delete first;
+  delete second;
+  CHECK_EQ(0, task_counter.GetCount());
+
+  queue.Terminate();
+  CHECK_EQ(NULL, queue.GetNext(1));
+}
+
+
+TEST(TaskQueueShortRunningTasksFirst) {
+  TaskCounter task_counter;
+
+  TaskQueue queue;
+
+  TestTask* long_task = new TestTask(&task_counter);
+  TestTask* short_task = new TestTask(&task_counter);
+  queue.Append(long_task, v8::Platform::kLongRunningTask);
+  queue.Append(short_task, v8::Platform::kShortRunningTask);
+
+  CHECK_EQ(short_task, queue.GetNext());
+  delete short_task;
+  CHECK_EQ(long_task, queue.GetNext());
+  delete long_task;
+
+  queue.Terminate();
+  CHECK_EQ(NULL, queue.GetNext());
+}
+
+
+TEST(TaskQueueMaxDepth) {
+  TaskCounter task_counter;
+
+  TaskQueue queue(1, 1);
+
+  TestTask* task1 = new TestTask(&task_counter);
+  TestTask* task2 = new TestTask(&task_counter);
+  CHECK(queue.TryAppend(task1, v8::Platform::kShortRunningTask));
+  CHECK(!queue.TryAppend(task2, v8::Platform::kShortRunningTask));
+
+  CHECK_EQ(task1, queue.GetNext());
+  delete task1;
+  CHECK(queue.TryAppend(task2, v8::Platform::kShortRunningTask));
+  CHECK_EQ(task2, queue.GetNext());
+  delete task2;
+
+  queue.Terminate();
+  CHECK_EQ(NULL, queue.GetNext());
+}
@@ -0,0 +1,221 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Tests of the lock-free multi-producer queues.
+
+#include "v8.h"
+#include "bounded-mpmc-queue-inl.h"
+#include "cctest.h"
+#include "mpsc-queue-inl.h"
+
+using i::BoundedMPMCQueue;
+using i::MPSCQueue;
+
+
+TEST(MPSCQueueSingleThread) {
+  typedef int Record;
+  MPSCQueue<Record> q;
+  CHECK(q.IsEmpty());
+  Record rec = 0;
+  CHECK(!q.Dequeue(&rec));
+  for (int i = 1; i <= 5; ++i) {
+    q.Enqueue(i);
+    CHECK(!q.IsEmpty());
+  }
+  for (int i = 1; i <= 5; ++i) {
+    CHECK(q.Dequeue(&rec));
+    CHECK_EQ(i, rec);
+  }
+  CHECK(q.IsEmpty());
+  CHECK(!q.Dequeue(&rec));
+  // The queue stays usable after it has been drained.
+  q.Enqueue(6);
+  CHECK(q.Dequeue(&rec));
+  CHECK_EQ(6, rec);
+  CHECK(q.IsEmpty());
+}
+
+
+TEST(BoundedMPMCQueueSingleThread) {
+  typedef int Record;
+  const unsigned kLength = 4;
+  BoundedMPMCQueue<Record, kLength> q;
+  Record rec = 0;
+  CHECK(!q.Dequeue(&rec));
+  // Run a few laps around the ring, filling it completely each time.
+  for (int lap = 0; lap < 3; ++lap) {
+    for (unsigned i = 0; i < kLength; ++i) {
+      CHECK(q.Enqueue(lap * 10 + i));
+    }
+    CHECK(!q.Enqueue(-1));
+    for (unsigned i = 0; i < kLength; ++i) {
+      CHECK(q.Dequeue(&rec));
+      CHECK_EQ(static_cast<int>(lap * 10 + i), rec);
+    }
+    CHECK(!q.Dequeue(&rec));
+  }
+}
+
+
+namespace {
+
+typedef i::AtomicWord Record;
+typedef BoundedMPMCQueue<Record, 16> TestBoundedQueue;
+
+const int kProducers = 4;
+const int kRecordsPerProducer = 10000;
+
+// Records are encoded as producer * kRecordsPerProducer + sequence number.
+class MPSCProducerThread: public i::Thread {
+ public:
+  MPSCProducerThread(MPSCQueue<Record>* queue, int producer)
+      : Thread("mpsc producer"), queue_(queue), producer_(producer) { }
+
+  virtual void Run() {
+    for (int i = 0; i < kRecordsPerProducer; ++i) {
+      queue_->Enqueue(producer_ * kRecordsPerProducer + i);
+    }
+  }
+
+ private:
+  MPSCQueue<Record>* queue_;
+  int producer_;
+};
+
+
+class BoundedProducerThread: public i::Thread {
+ public:
+  BoundedProducerThread(TestBoundedQueue* queue, int producer)
+      : Thread("bounded producer"), queue_(queue), producer_(producer) { }
+
+  virtual void Run() {
+    for (int i = 0; i < kRecordsPerProducer; ++i) {
+      while (!queue_->Enqueue(producer_ * kRecordsPerProducer + i)) {
+        i::Thread::YieldCPU();
+      }
+    }
+  }
+
+ private:
+  TestBoundedQueue* queue_;
+  int producer_;
+};
+
+
+class BoundedConsumerThread: public i::Thread {
+ public:
+  BoundedConsumerThread(TestBoundedQueue* queue, i::AtomicWord* remaining)
+      : Thread("bounded consumer"), queue_(queue), remaining_(remaining),
+        sum_(0) { }
+
+  virtual void Run() {
+    while (i::Acquire_Load(remaining_) > 0) {
+      Record rec;
+      if (!queue_->Dequeue(&rec)) {
+        i::Thread::YieldCPU();
+        continue;
+      }
+      sum_ += rec;
+      i::Barrier_AtomicIncrement(remaining_, -1);
+    }
+  }
+
+  int64_t sum() const { return sum_; }
+
+ private:
+  TestBoundedQueue* queue_;
+  i::AtomicWord* remaining_;
+  int64_t sum_;
+};
+
+}  // namespace
+
+
+TEST(MPSCQueueMultipleProducers) {
+  MPSCQueue<Record> queue;
+  MPSCProducerThread* producers[kProducers];
+  for (int p = 0; p < kProducers; ++p) {
+    producers[p] = new MPSCProducerThread(&queue, p);
+    producers[p]->Start();
+  }
+
+  // Records of one producer arrive in the order they were enqueued.
+  int next[kProducers] = { 0 };
+  int received = 0;
+  while (received < kProducers * kRecordsPerProducer) {
+    Record rec;
+    if (!queue.Dequeue(&rec)) continue;
+    int producer = static_cast<int>(rec / kRecordsPerProducer);
+    CHECK_LT(producer, kProducers);
+    CHECK_EQ(next[producer], static_cast<int>(rec % kRecordsPerProducer));
+    next[producer]++;
+    received++;
+  }
+  CHECK(queue.IsEmpty());
+
+  for (int p = 0; p < kProducers; ++p) {
+    producers[p]->Join();
+    delete producers[p];
+  }
+}
+
+
+TEST(BoundedMPMCQueueMultithreading) {
+  const int kConsumers = 2;
+  const int kTotal = kProducers * kRecordsPerProducer;
+  TestBoundedQueue queue;
+  i::AtomicWord remaining = kTotal;
+
+  BoundedConsumerThread* consumers[kConsumers];
+  for (int c = 0; c < kConsumers; ++c) {
+    consumers[c] = new BoundedConsumerThread(&queue, &remaining);
+    consumers[c]->Start();
+  }
+  BoundedProducerThread* producers[kProducers];
+  for (int p = 0; p < kProducers; ++p) {
+    producers[p] = new BoundedProducerThread(&queue, p);
+    producers[p]->Start();
+  }
+
+  for (int p = 0; p < kProducers; ++p) {
+    producers[p]->Join();
+    delete producers[p];
+  }
+  int64_t sum = 0;
+  for (int c = 0; c < kConsumers; ++c) {
+    consumers[c]->Join();
+    sum += consumers[c]->sum();
+    delete consumers[c];
+  }
+
+  // Every record was dequeued exactly once.
+  CHECK_EQ(0, static_cast<int>(remaining));
+  int64_t expected = static_cast<int64_t>(kTotal - 1) * kTotal / 2;
+  CHECK_EQ(expected, sum);
+  Record rec;
+  CHECK(!queue.Dequeue(&rec));
+}
@@ -36,6 +36,7 @@
 #include "smart-pointers.h"
 #include "snapshot.h"
 #include "platform.h"
+#include "platform/elapsed-timer.h"
 #include "utils.h"
 #include "cctest.h"
 #include "parser.h"
@@ -658,6 +659,110 @@ TEST(LockUnlockLockDefaultIsolateMultithreaded) {
 }
 
 
+class LockSwitchThread : public JoinableThread {
+ public:
+  LockSwitchThread(v8::Isolate* isolate, int iterations)
+    : JoinableThread("LockSwitchThread"),
+      isolate_(isolate),
+      iterations_(iterations) {
+  }
+
+  virtual void Run() {
+    for (int i = 0; i < iterations_; i++) {
+      v8::Locker lock(isolate_);
+      v8::Isolate::Scope isolate_scope(isolate_);
+      v8::HandleScope handle_scope(isolate_);
+      v8::Local<v8::Value> value = v8::Integer::New(isolate_, i);
+      CHECK_EQ(i, value->Int32Value());
+      {
+        // Same-thread re-acquire after an Unlocker is lazily archived.
+        isolate_->Exit();
+        v8::Unlocker unlocker(isolate_);
+      }
+      isolate_->Enter();
+      CHECK_EQ(i, value->Int32Value());
+    }
+  }
+
+ private:
+  v8::Isolate* isolate_;
+  int iterations_;
+};
+
+
+// Measures the cost of handing an isolate lock back and forth between
+// threads. Every iteration takes a top-level Locker, so the handle block
+// retained across lock releases is exercised as well.
+TEST(LockSwitchLatency) {
+  const int kNThreads = 4;
+  const int kIterations = 1000;
+  v8::Isolate* isolate = v8::Isolate::New();
+  i::ElapsedTimer timer;
+  timer.Start();
+  i::List<JoinableThread*> threads(kNThreads);
+  for (int i = 0; i < kNThreads; i++) {
+    threads.Add(new LockSwitchThread(isolate, kIterations));
+  }
+  StartJoinAndDeleteThreads(threads);
+  double elapsed_us = timer.Elapsed().InMicroseconds();
+  i::PrintF("LockSwitchLatency: %.2f us per lock switch\n",
+            elapsed_us / (kNThreads * kIterations));
+  isolate->Dispose();
+}
+
+
+class CompactingThread : public JoinableThread {
+ public:
+  CompactingThread(v8::Isolate* isolate, int id, int iterations)
+    : JoinableThread("CompactingThread"),
+      isolate_(isolate),
+      id_(id),
+      iterations_(iterations) {
+  }
+
+  virtual void Run() {
+    v8::Locker lock(isolate_);
+    v8::Isolate::Scope isolate_scope(isolate_);
+    v8::HandleScope handle_scope(isolate_);
+    i::Heap* heap = reinterpret_cast<i::Isolate*>(isolate_)->heap();
+    v8::Local<v8::Array> array = v8::Array::New(isolate_, 1);
+    array->Set(0, v8::Integer::New(isolate_, id_));
+    for (int i = 0; i < iterations_; i++) {
+      {
+        // Let the other threads in, so that they collect garbage while the
+        // handles of this thread are archived.
+        isolate_->Exit();
+        v8::Unlocker unlocker(isolate_);
+      }
+      isolate_->Enter();
+      heap->CollectAllGarbage(i::Heap::kNoGCFlags, "CompactingThread");
+      CHECK_EQ(id_, array->Get(0)->Int32Value());
+    }
+  }
+
+ private:
+  v8::Isolate* isolate_;
+  int id_;
+  int iterations_;
+};
+
+
+// Roots of archived threads are updated in parallel during compaction.
+TEST(ParallelRootsUpdating) {
+  i::FLAG_parallel_pointer_update = true;
+  i::FLAG_always_compact = true;
+  const int kNThreads = 16;
+  const int kIterations = 4;
+  v8::Isolate* isolate = v8::Isolate::New();
+  i::List<JoinableThread*> threads(kNThreads);
+  for (int i = 0; i < kNThreads; i++) {
+    threads.Add(new CompactingThread(isolate, i, kIterations));
+  }
+  StartJoinAndDeleteThreads(threads);
+  isolate->Dispose();
+}
+
+
 TEST(Regress1433) {
   for (int i = 0; i < 10; i++) {
     v8::Isolate* isolate = v8::Isolate::New();
@@ -492,3 +492,49 @@ TEST(EquivalenceOfLoggingAndTraversal) {
     CHECK(false);
   }
 }
+
+
+static int trace_event_depth = 0;
+static int execute_events = 0;
+static int gc_events = 0;
+static int compile_events = 0;
+
+
+static void RecordTraceEvent(v8::Isolate::TraceEventPhase phase,
+                             const char* category,
+                             const char* name,
+                             const char* arg_name,
+                             int arg_value) {
+  if (phase == v8::Isolate::kTraceEventInstant) return;
+  if (phase == v8::Isolate::kTraceEventBegin) {
+    trace_event_depth++;
+  } else {
+    CHECK_EQ(v8::Isolate::kTraceEventEnd, phase);
+    trace_event_depth--;
+  }
+  CHECK_GE(trace_event_depth, 0);
+  if (phase != v8::Isolate::kTraceEventBegin) return;
+  if (strcmp(name, "V8.Execute") == 0) execute_events++;
+  if (strcmp(category, "v8.gc") == 0) gc_events++;
+  if (strcmp(category, "v8.compile") == 0) compile_events++;
+}
+
+
+TEST(TraceEventCallback) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  v8::Handle<v8::Context> env = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(env);
+
+  isolate->SetTraceEventCallback(RecordTraceEvent);
+  CompileRun("function f() { return 1; } f();");
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+  CcTest::heap()->CollectAllGarbage(i::Heap::kNoGCFlags);
+  isolate->SetTraceEventCallback(NULL);
+  CompileRun("f();");
+
+  CHECK_EQ(0, trace_event_depth);
+  CHECK_EQ(1, execute_events);
+  CHECK_GE(gc_events, 2);
+  CHECK_GT(compile_events, 0);
+}
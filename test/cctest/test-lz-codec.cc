@@ -0,0 +1,116 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <stdlib.h>
+
+#include "v8.h"
+
+#include "cctest.h"
+#include "lz-codec.h"
+
+using namespace v8::internal;
+
+
+static void CheckRoundTrip(const byte* input, int length) {
+  int capacity = LZCodec::CompressBound(length);
+  ScopedVector<byte> compressed(capacity);
+  int compressed_length =
+      LZCodec::Compress(input, length, compressed.start(), capacity);
+  CHECK_GE(compressed_length, 0);
+  CHECK_LE(compressed_length, capacity);
+
+  ScopedVector<byte> output(length + 1);
+  CHECK(LZCodec::Decompress(compressed.start(), compressed_length,
+                            output.start(), length));
+  CHECK_EQ(0, memcmp(input, output.start(), length));
+
+  // The exact decompressed size is required.
+  CHECK(!LZCodec::Decompress(compressed.start(), compressed_length,
+                             output.start(), length + 1));
+}
+
+
+TEST(LZCodecRoundTrip) {
+  CheckRoundTrip(NULL, 0);
+
+  const int kLength = 100000;
+  ScopedVector<byte> data(kLength);
+  for (int i = 0; i < kLength; i++) data[i] = static_cast<byte>(i % 37);
+  CheckRoundTrip(data.start(), 1);
+  CheckRoundTrip(data.start(), 17);
+  CheckRoundTrip(data.start(), kLength);
+
+  // Repetitive data compresses well.
+  int capacity = LZCodec::CompressBound(kLength);
+  ScopedVector<byte> compressed(capacity);
+  CHECK_LT(LZCodec::Compress(data.start(), kLength, compressed.start(),
+                             capacity),
+           kLength / 10);
+
+  // Random data with some back references.
+  srand(42);
+  for (int i = 0; i < kLength; i++) {
+    data[i] = (i > 300 && (rand() & 3) != 0) ? data[i - 300]
+                                             : static_cast<byte>(rand());
+  }
+  CheckRoundTrip(data.start(), kLength);
+
+  // Incompressible data.
+  for (int i = 0; i < kLength; i++) data[i] = static_cast<byte>(rand());
+  CheckRoundTrip(data.start(), kLength);
+}
+
+
+TEST(LZCodecMalformedInput) {
+  const int kLength = 1000;
+  byte data[kLength];
+  for (int i = 0; i < kLength; i++) data[i] = static_cast<byte>(i % 10);
+  int capacity = LZCodec::CompressBound(kLength);
+  ScopedVector<byte> compressed(capacity);
+  int compressed_length =
+      LZCodec::Compress(data, kLength, compressed.start(), capacity);
+  CHECK_GT(compressed_length, 2);
+
+  byte output[kLength];
+  // Output too small.
+  CHECK(!LZCodec::Decompress(compressed.start(), compressed_length,
+                             output, kLength - 1));
+  // Truncated in the middle of the literals.
+  CHECK(!LZCodec::Decompress(compressed.start(), 2, output, kLength));
+
+  // A match reaching before the start of the output.
+  byte bad_offset[] = { 0x10, 'a', 0x05, 0x00, 0x00 };
+  CHECK(!LZCodec::Decompress(bad_offset, sizeof(bad_offset), output, 9));
+  // A zero offset.
+  byte zero_offset[] = { 0x10, 'a', 0x00, 0x00, 0x00 };
+  CHECK(!LZCodec::Decompress(zero_offset, sizeof(zero_offset), output, 9));
+  // An overlapping match is fine.
+  byte overlap[] = { 0x10, 'a', 0x01, 0x00, 0x00 };
+  CHECK(LZCodec::Decompress(overlap, sizeof(overlap), output, 5));
+  for (int i = 0; i < 5; i++) CHECK_EQ('a', output[i]);
+}
@@ -123,6 +123,33 @@ TEST(NoPromotion) {
 }
 
 
+TEST(MarkingDequeGrowsOnOverflow) {
+  if (!FLAG_grow_marking_deque || FLAG_force_marking_deque_overflows) return;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  MarkCompactCollector* collector = heap->mark_compact_collector();
+  v8::HandleScope sc(CcTest::isolate());
+
+  // More live objects than fit into a single from-space page of the marking
+  // deque.
+  static const int kLength = 256 * 1024;
+  Factory* factory = isolate->factory();
+  Handle<FixedArray> array = factory->NewFixedArray(kLength, TENURED);
+  for (int i = 0; i < kLength; i++) {
+    v8::HandleScope inner_scope(CcTest::isolate());
+    array->set(i, *factory->NewFixedArray(1, TENURED));
+  }
+
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_GT(static_cast<int>(collector->marking_deque_committed_size()), 0);
+  for (int i = 0; i < kLength; i++) CHECK(array->get(i)->IsFixedArray());
+
+  heap->ReduceMemoryFootprint("test");
+  CHECK_EQ(0, static_cast<int>(collector->marking_deque_committed_size()));
+}
+
+
 TEST(MarkCompactCollector) {
   FLAG_incremental_marking = false;
   CcTest::InitializeVM();
@@ -31,6 +31,7 @@
 
 #include "cctest.h"
 #include "platform/mutex.h"
+#include "platform/semaphore.h"
 
 using namespace ::v8::internal;
 
@@ -116,3 +117,43 @@ TEST(MultipleRecursiveMutexes) {
   recursive_mutex2.Unlock();
   recursive_mutex1.Unlock();
 }
+
+
+class LockingThread V8_FINAL : public Thread {
+ public:
+  LockingThread(Mutex* mutex, Semaphore* started)
+      : Thread("LockingThread"), mutex_(mutex), started_(started) {}
+  virtual ~LockingThread() {}
+
+  virtual void Run() V8_OVERRIDE {
+    started_->Signal();
+    LockGuard<Mutex> lock_guard(mutex_);
+  }
+
+ private:
+  Mutex* mutex_;
+  Semaphore* started_;
+};
+
+
+TEST(MutexContentionStatistics) {
+  Mutex mutex;
+  { LockGuard<Mutex> lock_guard(&mutex);
+  }
+  CHECK(mutex.TryLock());
+  mutex.Unlock();
+  CHECK_EQ(0, mutex.contention_count());
+
+  Semaphore started(0);
+  LockingThread thread(&mutex, &started);
+  mutex.Lock();
+  thread.Start();
+  started.Wait();
+  OS::Sleep(50);
+  mutex.Unlock();
+  thread.Join();
+
+  LockGuard<Mutex> lock_guard(&mutex);
+  CHECK_EQ(1, mutex.contention_count());
+  CHECK_LT(0, mutex.contention_time().InMicroseconds());
+}
@@ -105,6 +105,77 @@ TEST(ScanKeywords) {
 }
 
 
+static void AppendString(i::Vector<char> buffer, int* pos, const char* str) {
+  int length = i::StrLength(str);
+  CHECK(*pos + length < buffer.length());
+  i::OS::MemCopy(buffer.start() + *pos, str, length);
+  *pos += length;
+  buffer[*pos] = '\0';
+}
+
+
+static void CheckScanTokens(i::UnicodeCache* unicode_cache,
+                            i::Vector<char> source,
+                            const i::Token::Value* tokens,
+                            const bool* newline_before) {
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const i::byte*>(source.start()), source.length());
+  i::Scanner scanner(unicode_cache);
+  scanner.Initialize(&stream);
+  for (int k = 0; tokens[k] != i::Token::EOS; k++) {
+    CHECK_EQ(tokens[k], scanner.Next());
+    CHECK_EQ(newline_before[k], scanner.HasAnyLineTerminatorBeforeNext());
+  }
+  CHECK_EQ(i::Token::EOS, scanner.Next());
+}
+
+
+TEST(ScanComments) {
+  // Comments of many lengths, ended in all possible ways, so that the
+  // wordwise comment skipping is exercised at every alignment and across
+  // the scanner's buffer boundaries.
+  static const char* kTerminators[] = {
+    "\n", "\r", "\xe2\x80\xa8", "\xe2\x80\xa9"
+  };
+  static const char* kFillers[] = { "x", "*", "\t", "\xe4\xb8\x80" };
+  static const i::Token::Value kTokens[] = {
+    i::Token::IDENTIFIER, i::Token::IDENTIFIER, i::Token::IDENTIFIER,
+    i::Token::EOS
+  };
+  static const bool kSingleLine[] = { true, false, false };
+  static const bool kMultiLine[] = { false, true, false };
+  i::UnicodeCache unicode_cache;
+  i::ScopedVector<char> buffer(8 * 1024);
+  for (int length = 0; length < 1100; length += (length < 40) ? 1 : 97) {
+    for (int f = 0; f < static_cast<int>(ARRAY_SIZE(kFillers)); f++) {
+      for (int t = 0; t < static_cast<int>(ARRAY_SIZE(kTerminators)); t++) {
+        // a //...<terminator> b //...
+        int pos = 0;
+        AppendString(buffer, &pos, "a //");
+        for (int k = 0; k < length; k++) {
+          AppendString(buffer, &pos, kFillers[f]);
+        }
+        AppendString(buffer, &pos, kTerminators[t]);
+        AppendString(buffer, &pos, "b /* */ c //");
+        for (int k = 0; k < length; k++) {
+          AppendString(buffer, &pos, kFillers[f]);
+        }
+        CheckScanTokens(&unicode_cache, buffer.SubVector(0, pos),
+                        kTokens, kSingleLine);
+      }
+      // a /*...*/ b /*...\n*/ c
+      int pos = 0;
+      AppendString(buffer, &pos, "a /*");
+      for (int k = 0; k < length; k++) AppendString(buffer, &pos, kFillers[f]);
+      AppendString(buffer, &pos, "*/ b /*");
+      for (int k = 0; k < length; k++) AppendString(buffer, &pos, kFillers[f]);
+      AppendString(buffer, &pos, "\n*/ c");
+      CheckScanTokens(&unicode_cache, buffer.SubVector(0, pos),
+                      kTokens, kMultiLine);
+    }
+  }
+}
+
 TEST(ScanHTMLEndComments) {
   v8::V8::Initialize();
   v8::Isolate* isolate = CcTest::isolate();
@@ -324,6 +395,53 @@ TEST(StandAlonePreParserNoNatives) {
 }
 
 
+class PreCompileThread : public i::Thread {
+ public:
+  explicit PreCompileThread(const char* source)
+      : Thread("PreCompileThread"), source_(source), data_(NULL) {}
+
+  virtual void Run() {
+    data_ = v8::ScriptData::PreCompile(source_, i::StrLength(source_));
+  }
+
+  v8::ScriptData* data() { return data_; }
+
+ private:
+  const char* source_;
+  v8::ScriptData* data_;
+};
+
+
+TEST(PreparsingOnBackgroundThread) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  const char* source =
+      "function lazy(a) { return function inner(b) { return a + b; } }"
+      "lazy(20)(22);";
+  PreCompileThread thread(source);
+  thread.Start();
+  thread.Join();
+  v8::ScriptData* preparse = thread.data();
+  CHECK(preparse != NULL);
+  CHECK(!preparse->HasError());
+
+  v8::Local<v8::Script> script = v8::Script::Compile(
+      v8::String::NewFromUtf8(isolate, source), NULL, preparse);
+  CHECK_EQ(42, script->Run()->Int32Value());
+  delete preparse;
+
+  PreCompileThread error_thread("var x = y z;");
+  error_thread.Start();
+  error_thread.Join();
+  CHECK(error_thread.data() != NULL);
+  CHECK(error_thread.data()->HasError());
+  delete error_thread.data();
+}
+
+
 TEST(PreparsingObjectLiterals) {
   // Regression test for a bug where the symbol stream produced by PreParser
   // didn't match what Parser wanted to consume.
@@ -474,6 +592,51 @@ TEST(Regress928) {
 }
 
 
+TEST(PreParseHotFunctions) {
+  v8::V8::Initialize();
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  LocalContext context;
+
+  // Only calls outside of lazily parsed function bodies predict that a
+  // function is called while the script is loaded.
+  const char* program =
+      "function before() { }\n"
+      "function cold() { after(); }\n"
+      "if (false) { before(); late(); }\n"
+      "function after() { }\n"
+      "function late() { }\n"
+      "function twice() { }\n"
+      "function twice() { }\n"
+      "twice();\n";
+  v8::ScriptData* sd =
+      v8::ScriptData::PreCompile(program, i::StrLength(program));
+  CHECK(!sd->HasError());
+  i::ScriptDataImpl* data = reinterpret_cast<i::ScriptDataImpl*>(sd);
+  data->Initialize();
+  const char* names[] = { "before", "cold", "after", "late", "twice" };
+  bool hot[] = { true, false, false, true, false };
+  for (unsigned i = 0; i < ARRAY_SIZE(names); i++) {
+    i::ScopedVector<char> declaration(32);
+    i::OS::SNPrintF(declaration, "function %s", names[i]);
+    int position = static_cast<int>(
+        strstr(program, declaration.start()) - program) + 9;
+    CHECK_EQ(hot[i], data->IsHotFunction(position));
+  }
+
+  // Hot functions are compiled together with the script. The last one is
+  // called by the script itself.
+  v8::Script::Compile(v8_str(program), NULL, sd)->Run();
+  for (unsigned i = 0; i < ARRAY_SIZE(names) - 1; i++) {
+    i::Handle<i::JSFunction> function = v8::Utils::OpenHandle(
+        *v8::Handle<v8::Function>::Cast(
+            context->Global()->Get(v8_str(names[i]))));
+    CHECK_EQ(hot[i], function->shared()->is_compiled());
+  }
+  delete sd;
+}
+
+
 TEST(PreParseOverflow) {
   v8::V8::Initialize();
 
@@ -706,6 +869,93 @@ TEST(Utf8CharacterStream) {
   }
 }
 
+// Hands out a buffer in chunks of a fixed size.
+class ChunkedSourceStream : public v8::ExternalSourceStream {
+ public:
+  ChunkedSourceStream(const char* data, size_t length, size_t chunk_size)
+      : data_(reinterpret_cast<const uint8_t*>(data)),
+        length_(length),
+        chunk_size_(chunk_size),
+        pos_(0) {}
+
+  virtual size_t GetMoreData(const uint8_t** chunk) {
+    size_t chunk_length = i::Min(chunk_size_, length_ - pos_);
+    *chunk = data_ + pos_;
+    pos_ += chunk_length;
+    return chunk_length;
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t length_;
+  size_t chunk_size_;
+  size_t pos_;
+};
+
+
+TEST(ExternalStreamingCharacterStream) {
+  static const int kMaxUC16Char = 0x800;
+  static const int kBufferSize = 4 * (kMaxUC16Char + 1);
+  char buffer[kBufferSize];
+  unsigned utf8_length = 0;
+  for (int i = 0; i <= kMaxUC16Char; i++) {
+    utf8_length += unibrow::Utf8::Encode(buffer + utf8_length,
+                                         i,
+                                         unibrow::Utf16::kNoPreviousCharacter);
+  }
+
+  // Odd chunk sizes split multi-byte characters between chunks.
+  static const size_t kChunkSizes[] = { 1, 3, 7, 1024 };
+  for (size_t j = 0; j < ARRAY_SIZE(kChunkSizes); j++) {
+    ChunkedSourceStream source(buffer, utf8_length, kChunkSizes[j]);
+    i::ExternalStreamingUtf16CharacterStream stream(
+        &source, v8::ExternalSourceStream::UTF8);
+    for (int i = 0; i <= kMaxUC16Char; i++) {
+      CHECK_EQU(i, stream.pos());
+      int32_t c = stream.Advance();
+      CHECK_EQ(i, c);
+      if (i % 3 == 0) {
+        stream.PushBack(c);
+        CHECK_EQ(i, stream.Advance());
+      }
+    }
+    CHECK_EQ(-1, stream.Advance());
+  }
+
+  // Latin-1 input is taken byte by byte.
+  const char* latin1 = "caf\xe9 \xff";
+  ChunkedSourceStream latin1_source(latin1, strlen(latin1), 2);
+  i::ExternalStreamingUtf16CharacterStream latin1_stream(
+      &latin1_source, v8::ExternalSourceStream::ONE_BYTE);
+  CHECK_EQ('c', latin1_stream.Advance());
+  CHECK_EQU(2, latin1_stream.SeekForward(2));
+  CHECK_EQ(0xe9, latin1_stream.Advance());
+  CHECK_EQ(' ', latin1_stream.Advance());
+  CHECK_EQ(0xff, latin1_stream.Advance());
+  CHECK_EQ(-1, latin1_stream.Advance());
+}
+
+
+TEST(PreparsingExternalSourceStream) {
+  v8::V8::Initialize();
+
+  const char* source =
+      "function lazy(a) { return function inner(b) { return a + b; } }";
+  ChunkedSourceStream stream(source, strlen(source), 5);
+  v8::ScriptData* preparse =
+      v8::ScriptData::PreCompile(&stream, v8::ExternalSourceStream::UTF8);
+  CHECK(preparse != NULL);
+  CHECK(!preparse->HasError());
+  delete preparse;
+
+  const char* error_source = "var x = y z;";
+  ChunkedSourceStream error_stream(error_source, strlen(error_source), 5);
+  v8::ScriptData* error_preparse = v8::ScriptData::PreCompile(
+      &error_stream, v8::ExternalSourceStream::UTF8);
+  CHECK(error_preparse->HasError());
+  delete error_preparse;
+}
+
 #undef CHECK_EQU
 
 void TestStreamScanner(i::Utf16CharacterStream* stream,
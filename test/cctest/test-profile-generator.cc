@@ -512,6 +512,53 @@ TEST(SampleIds) {
 }
 
 
+TEST(SamplesRingBuffer) {
+  TestSetup test_setup;
+  int saved_max_samples = i::FLAG_cpu_profiler_max_samples;
+  i::FLAG_cpu_profiler_max_samples = 2;
+  CpuProfilesCollection profiles(CcTest::heap());
+  profiles.StartProfiling("", true);
+  ProfileGenerator generator(&profiles);
+  CodeEntry* entry1 = profiles.NewCodeEntry(i::Logger::FUNCTION_TAG, "aaa");
+  CodeEntry* entry2 = profiles.NewCodeEntry(i::Logger::FUNCTION_TAG, "bbb");
+  CodeEntry* entry3 = profiles.NewCodeEntry(i::Logger::FUNCTION_TAG, "ccc");
+  generator.code_map()->AddCode(ToAddress(0x1500), entry1, 0x200);
+  generator.code_map()->AddCode(ToAddress(0x1700), entry2, 0x100);
+  generator.code_map()->AddCode(ToAddress(0x1900), entry3, 0x50);
+
+  // (root)#1 -> aaa #2 -> bbb #3 - sample1
+  //                    -> ccc #4 - sample2
+  //                    -> aaa #5 - sample3
+  TickSample sample1;
+  sample1.pc = ToAddress(0x1780);
+  sample1.stack[0] = ToAddress(0x1510);
+  sample1.frames_count = 1;
+  generator.RecordTickSample(sample1);
+  TickSample sample2;
+  sample2.pc = ToAddress(0x1910);
+  sample2.stack[0] = ToAddress(0x1510);
+  sample2.frames_count = 1;
+  generator.RecordTickSample(sample2);
+  TickSample sample3;
+  sample3.pc = ToAddress(0x1600);
+  sample3.stack[0] = ToAddress(0x1510);
+  sample3.frames_count = 1;
+  generator.RecordTickSample(sample3);
+
+  CpuProfile* profile = profiles.StopProfiling("");
+  // The tree still has all samples, only the oldest sample is dropped.
+  int nodeId = 1;
+  CheckNodeIds(profile->top_down()->root(), &nodeId);
+  CHECK_EQ(5, nodeId - 1);
+  CHECK_EQ(2, profile->samples_count());
+  CHECK_EQ(4, profile->sample(0)->id());
+  CHECK_EQ(5, profile->sample(1)->id());
+  CHECK(profile->sample_timestamp(0) <= profile->sample_timestamp(1));
+  CHECK(profile->start_time() <= profile->sample_timestamp(0));
+  i::FLAG_cpu_profiler_max_samples = saved_max_samples;
+}
+
+
 TEST(NoSamples) {
   TestSetup test_setup;
   CpuProfilesCollection profiles(CcTest::heap());
@@ -31,6 +31,7 @@
 
 #include "v8.h"
 
+#include "compilation-cache.h"
 #include "debug.h"
 #include "ic-inl.h"
 #include "runtime.h"
@@ -41,6 +42,7 @@
 #include "spaces.h"
 #include "objects.h"
 #include "natives.h"
+#include "parser.h"
 #include "bootstrapper.h"
 
 using namespace v8::internal;
@@ -186,6 +188,13 @@ class FileByteSink : public SnapshotByteSink {
       fputc(byte, fp_);
     }
   }
+  virtual void PutRaw(const byte* data,
+                      int number_of_bytes,
+                      const char* description) {
+    if (fp_ != NULL) {
+      fwrite(data, 1, number_of_bytes, fp_);
+    }
+  }
   virtual int Position() {
     return ftell(fp_);
   }
@@ -635,6 +644,42 @@ DEPENDENT_TEST(ContextDeserialization, ContextSerialization) {
 }
 
 
+TEST(SerializeToplevel) {
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+
+  const char* source =
+      "function f(x) { return x * 2; }"
+      "var o = { name: 'code cache' };"
+      "f(o.name.length + 11);";
+  v8::ScriptData* cache =
+      v8::ScriptData::GenerateCodeCache(v8_str(source));
+  CHECK(cache != NULL);
+  CHECK(!cache->HasError());
+
+  // Load the code cache like an embedder reading it back from disk.
+  v8::ScriptData* loaded =
+      v8::ScriptData::New(cache->Data(), cache->Length());
+  CHECK(CodeSerializer::IsCodeCache(static_cast<ScriptDataImpl*>(loaded)));
+
+  // Make sure the script is not found in the compilation cache.
+  isolate->compilation_cache()->Clear();
+  v8::Local<v8::Script> script =
+      v8::Script::Compile(v8_str(source), NULL, loaded);
+  CHECK_EQ(42, script->Run()->Int32Value());
+  CHECK_EQ(42, CompileRun("f(21)")->Int32Value());
+
+  // A code cache for a different source is ignored.
+  isolate->compilation_cache()->Clear();
+  script = v8::Script::Compile(v8_str("6 * 7 + 1"), NULL, loaded);
+  CHECK_EQ(43, script->Run()->Int32Value());
+
+  delete loaded;
+  delete cache;
+}
+
+
 TEST(TestThatAlwaysSucceeds) {
 }
 
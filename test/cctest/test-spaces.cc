@@ -402,6 +402,75 @@ TEST(LargeObjectSpace) {
 }
 
 
+TEST(LargeObjectChunkPool) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  MemoryAllocator* allocator = isolate->memory_allocator();
+  allocator->ReleasePooledChunks();
+  static const int kArraySize = 2 * Page::kPageSize;
+
+  Address chunk;
+  {
+    HandleScope scope(isolate);
+    Handle<ByteArray> array = factory->NewByteArray(kArraySize, TENURED);
+    CHECK(heap->lo_space()->Contains(*array));
+    chunk = MemoryChunk::FromAddress(array->address())->address();
+  }
+
+  // The chunk of the dead array is kept for reuse but not accounted.
+  intptr_t size = allocator->Size();
+  heap->CollectAllGarbage(Heap::kNoGCFlags);
+  CHECK_LT(allocator->Size(), size);
+
+  HandleScope scope(isolate);
+  Handle<ByteArray> array = factory->NewByteArray(kArraySize, TENURED);
+  CHECK(heap->lo_space()->Contains(*array));
+  CHECK_EQ(chunk, MemoryChunk::FromAddress(array->address())->address());
+}
+
+
+TEST(LocalAllocationBuffer) {
+  CcTest::InitializeVM();
+  Heap* heap = CcTest::heap();
+  v8::HandleScope scope(CcTest::isolate());
+  static const int kBufferSize = 16 * kPointerSize;
+  static const int kObjectSize = 3 * kPointerSize;
+
+  LocalAllocationBuffer invalid;
+  CHECK(!invalid.IsValid());
+  CHECK(invalid.AllocateRaw(kObjectSize)->IsFailure());
+
+  LocalAllocationBuffer buffers[] = {
+    LocalAllocationBuffer::FromNewSpace(heap->new_space(), kBufferSize),
+    LocalAllocationBuffer::FromPagedSpace(heap->old_pointer_space(),
+                                          kBufferSize)
+  };
+  for (size_t i = 0; i < ARRAY_SIZE(buffers); i++) {
+    LocalAllocationBuffer* buffer = &buffers[i];
+    CHECK(buffer->IsValid());
+    HeapObject* first =
+        HeapObject::cast(buffer->AllocateRaw(kObjectSize)->ToObjectChecked());
+    heap->CreateFillerObjectAt(first->address(), kObjectSize);
+    HeapObject* second =
+        HeapObject::cast(buffer->AllocateRaw(kObjectSize)->ToObjectChecked());
+    heap->CreateFillerObjectAt(second->address(), kObjectSize);
+    // Objects are allocated linearly from the buffer.
+    CHECK_EQ(first->address() + kObjectSize, second->address());
+    CHECK(buffer->AllocateRaw(kBufferSize)->IsFailure());
+
+    // Closing the buffer turns the rest into a filler.
+    buffer->Close();
+    CHECK(!buffer->IsValid());
+    HeapObject* rest =
+        HeapObject::FromAddress(second->address() + kObjectSize);
+    CHECK(rest->IsFiller());
+    CHECK_EQ(kBufferSize - 2 * kObjectSize, rest->Size());
+  }
+}
+
+
 TEST(SizeOfFirstPageIsLargeEnough) {
   if (i::FLAG_always_opt) return;
   CcTest::InitializeVM();
@@ -925,6 +925,57 @@ TEST(Utf8Conversion) {
 }
 
 
+TEST(Utf8ConversionAsciiRuns) {
+  // Long ASCII runs around non-ASCII characters, so that the word-at-a-time
+  // ASCII paths in both directions start and stop at every offset.
+  CcTest::InitializeVM();
+  v8::HandleScope handle_scope(CcTest::isolate());
+  for (int prefix = 0; prefix < 20; prefix++) {
+    i::EmbeddedVector<char, 64> utf8;
+    int length = 0;
+    for (int i = 0; i < prefix; i++) utf8[length++] = 'a' + (i % 26);
+    // U+00E9 -> C3 A9
+    utf8[length++] = static_cast<char>(0xC3);
+    utf8[length++] = static_cast<char>(0xA9);
+    for (int i = 0; i < 17; i++) utf8[length++] = '0' + (i % 10);
+    // U+20AC -> E2 82 AC
+    utf8[length++] = static_cast<char>(0xE2);
+    utf8[length++] = static_cast<char>(0x82);
+    utf8[length++] = static_cast<char>(0xAC);
+
+    v8::Handle<v8::String> string = v8::String::NewFromUtf8(
+        CcTest::isolate(), utf8.start(), v8::String::kNormalString, length);
+    CHECK_EQ(prefix + 19, string->Length());
+    uint16_t utf16[64];
+    string->Write(utf16);
+    if (prefix > 0) CHECK_EQ('a' + (prefix - 1) % 26, utf16[prefix - 1]);
+    CHECK_EQ(0xE9, utf16[prefix]);
+    CHECK_EQ('0' + 16 % 10, utf16[prefix + 17]);
+    CHECK_EQ(0x20AC, utf16[prefix + 18]);
+    CHECK_EQ(length, string->Utf8Length());
+
+    char buffer[64];
+    int chars_written;
+    int written = string->WriteUtf8(buffer, sizeof(buffer), &chars_written,
+                                    v8::String::NO_NULL_TERMINATION);
+    CHECK_EQ(length, written);
+    CHECK_EQ(prefix + 19, chars_written);
+    CHECK_EQ(0, memcmp(utf8.start(), buffer, length));
+  }
+
+  // One-byte strings with Latin-1 characters after an ASCII prefix.
+  const uint8_t latin1[] = {'x', 'y', 'z', 'w', 'v', 'u', 't', 's', 'r', 0xE9,
+                            'q', 0xFF};
+  v8::Handle<v8::String> one_byte = v8::String::NewFromOneByte(
+      CcTest::isolate(), latin1, v8::String::kNormalString, 12);
+  CHECK_EQ(14, one_byte->Utf8Length());
+  char buffer[16];
+  CHECK_EQ(14, one_byte->WriteUtf8(buffer, sizeof(buffer), NULL,
+                                   v8::String::NO_NULL_TERMINATION));
+  CHECK_EQ(0, memcmp("xyzwvutsr\xC3\xA9q\xC3\xBF", buffer, 14));
+}
+
+
 TEST(ExternalShortStringAdd) {
   LocalContext context;
   v8::HandleScope handle_scope(CcTest::isolate());
@@ -1376,3 +1427,56 @@ TEST(Latin1IgnoreCase) {
     CHECK_EQ(Min(upper, lower), test);
   }
 }
+
+
+TEST(HashIndependentOfRepresentation) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  uint32_t seed = isolate->heap()->HashSeed();
+  // Short strings, long strings and lengths around the block hash limit,
+  // where an odd character is carried over between cons string halves.
+  for (int length = 1; length < 3 * StringHasher::kBlockHashMinLength;
+       length++) {
+    for (int wide = 0; wide < 2; wide++) {
+      i::ScopedVector<uc16> chars(length);
+      for (int i = 0; i < length; i++) chars[i] = 'a' + i % 26;
+      if (wide) chars[length / 2] = 0x20ac;
+
+      Handle<SeqTwoByteString> two_byte =
+          factory->NewRawTwoByteString(length);
+      CopyChars(two_byte->GetChars(), chars.start(), length);
+      uint32_t hash = two_byte->Hash();
+
+      if (!wide) {
+        Handle<SeqOneByteString> one_byte =
+            factory->NewRawOneByteString(length);
+        CopyChars(one_byte->GetChars(), chars.start(), length);
+        CHECK(hash == one_byte->Hash());
+      }
+
+      for (int split = 1; split < length; split += 3) {
+        Handle<String> cons = factory->NewConsString(
+            factory->NewSubString(two_byte, 0, split),
+            factory->NewSubString(two_byte, split, length));
+        CHECK(hash == cons->Hash());
+      }
+
+      i::ScopedVector<char> utf8(3 * length);
+      int utf8_length = 0;
+      int previous = unibrow::Utf16::kNoPreviousCharacter;
+      for (int i = 0; i < length; i++) {
+        utf8_length += unibrow::Utf8::Encode(
+            utf8.start() + utf8_length, chars[i], previous);
+        previous = chars[i];
+      }
+      int utf16_length;
+      uint32_t field = StringHasher::ComputeUtf8Hash(
+          i::Vector<const char>(utf8.start(), utf8_length), seed,
+          &utf16_length);
+      CHECK_EQ(length, utf16_length);
+      CHECK(hash == field >> String::kHashShift);
+    }
+  }
+}
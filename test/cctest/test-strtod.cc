@@ -477,3 +477,46 @@ TEST(RandomStrtod) {
     }
   }
 }
+
+
+TEST(FastStrtod) {
+  double result;
+  CHECK(FastStrtod(0, 0, &result));
+  CHECK_EQ(0.0, result);
+  CHECK(FastStrtod(0, 1000, &result));
+  CHECK_EQ(0.0, result);
+  CHECK(FastStrtod(1, 0, &result));
+  CHECK_EQ(1.0, result);
+  CHECK(FastStrtod(123456, -3, &result));
+  CHECK_EQ(123.456, result);
+  CHECK(FastStrtod(V8_2PART_UINT64_C(0x0003fde8, 492d5f3b), -16, &result));
+  CHECK_EQ(0.11231676933730741, result);
+  CHECK(FastStrtod(17976931348623157, 292, &result));
+  CHECK_EQ(1.7976931348623157e308, result);
+  CHECK(FastStrtod(V8_2PART_UINT64_C(0xFFFFFFFF, FFFFFFFF), 0, &result));
+  CHECK_EQ(18446744073709551615.0, result);
+  // Out of range, subnormal and exact half-way cases are left to Strtod.
+  CHECK(!FastStrtod(1, 309, &result));
+  CHECK(!FastStrtod(1, -323, &result));
+  CHECK(!FastStrtod(9007199254740993, 0, &result));
+
+  // Whenever the fast version succeeds, it agrees with Strtod.
+  char buffer[kBufferSize];
+  for (int length = 1; length <= 19; length++) {
+    for (int i = 0; i < 100; ++i) {
+      uint64_t significand = 0;
+      for (int j = 0; j < length; ++j) {
+        int digit = DeterministicRandom() % 10;
+        if (j == 0 && digit == 0) digit = 1;
+        buffer[j] = '0' + digit;
+        significand = significand * 10 + digit;
+      }
+      int exponent = DeterministicRandom() % (340*2 + 1) - 340;
+      double strtod_result = Strtod(Vector<const char>(buffer, length),
+                                    exponent);
+      if (FastStrtod(significand, exponent, &result)) {
+        CHECK_EQ(strtod_result, result);
+      }
+    }
+  }
+}
@@ -146,6 +146,28 @@ TEST(TimeTicksIsMonotonic) {
 }
 
 
+TEST(TimeTicksHighResolutionNowTracksTime) {
+  // Spin past the calibration of the high resolution clock (if any), while
+  // checking that the ticks stay monotonic and advance at the same rate as
+  // the system time across the switch.
+  Time start_time = Time::Now();
+  TimeTicks start_ticks = TimeTicks::HighResolutionNow();
+  TimeTicks previous_ticks = start_ticks;
+  ElapsedTimer timer;
+  timer.Start();
+  while (!timer.HasExpired(TimeDelta::FromMilliseconds(500))) {
+    TimeTicks ticks = TimeTicks::HighResolutionNow();
+    CHECK_GE(ticks, previous_ticks);
+    previous_ticks = ticks;
+  }
+  int64_t elapsed_ticks =
+      (TimeTicks::HighResolutionNow() - start_ticks).InMilliseconds();
+  int64_t elapsed_time = (Time::Now() - start_time).InMilliseconds();
+  CHECK_LE(elapsed_ticks - 50, elapsed_time);
+  CHECK_GE(elapsed_ticks + 50, elapsed_time);
+}
+
+
 template <typename T>
 static void ResolutionTest(T (*Now)(), TimeDelta target_granularity) {
   // We're trying to measure that intervals increment in a VERY small amount
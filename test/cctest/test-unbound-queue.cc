@@ -74,3 +74,27 @@ TEST(MultipleRecords) {
   }
   CHECK(cq.IsEmpty());
 }
+
+
+TEST(RecordsSpanningChunks) {
+  typedef int Record;
+  UnboundQueue<Record> cq;
+  // Interleave enqueueing and dequeueing over many chunks of records.
+  const int kRecordCount = 100000;
+  int next_to_dequeue = 0;
+  for (int i = 0; i < kRecordCount; ++i) {
+    cq.Enqueue(i);
+    if (i % 3 == 0) {
+      Record rec = -1;
+      CHECK(cq.Dequeue(&rec));
+      CHECK_EQ(next_to_dequeue++, rec);
+    }
+  }
+  Record rec = -1;
+  while (cq.Dequeue(&rec)) {
+    CHECK_EQ(next_to_dequeue++, rec);
+  }
+  CHECK_EQ(kRecordCount, next_to_dequeue);
+  CHECK(cq.IsEmpty());
+  CHECK_EQ(NULL, cq.Peek());
+}
@@ -31,6 +31,7 @@
 
 #include "cctest.h"
 #include "platform.h"
+#include "timsort.h"
 #include "utils-inl.h"
 
 using namespace v8::internal;
@@ -147,6 +148,46 @@ TEST(MemMove) {
 }
 
 
+TEST(MoveWords) {
+  v8::V8::Initialize();
+  static const int kWords = 64;
+  intptr_t area1[kWords];
+  intptr_t area2[kWords];
+
+  for (int src_offset = 0; src_offset < 16; src_offset++) {
+    for (int dst_offset = 0; dst_offset < 16; dst_offset++) {
+      for (int length = 1; length <= kWords - 16; length++) {
+        for (int i = 0; i < kWords; i++) area1[i] = area2[i] = i;
+        MoveWords(area1 + dst_offset, area1 + src_offset, length);
+        memmove(area2 + dst_offset, area2 + src_offset,
+                length * sizeof(intptr_t));
+        CHECK_EQ(0, memcmp(area1, area2, sizeof(area1)));
+      }
+    }
+  }
+}
+
+
+TEST(CopyBytes) {
+  v8::V8::Initialize();
+  static const int kBytes = 3 * OS::kMinComplexMemCopy;
+  byte* src = new byte[kBytes];
+  byte* dst = new byte[kBytes + 16];
+  for (int i = 0; i < kBytes; i++) src[i] = (i * 7) & 0xFF;
+
+  for (int offset = 0; offset < 16; offset++) {
+    for (int length = 0; length <= kBytes - offset; length++) {
+      memset(dst, 0, kBytes + 16);
+      CopyBytes(dst + offset, src, length);
+      CHECK_EQ(0, memcmp(dst + offset, src, length));
+      CHECK_EQ(0, dst[offset + length]);
+    }
+  }
+  delete[] src;
+  delete[] dst;
+}
+
+
 TEST(Collector) {
   Collector<int> collector(8);
   const int kLoops = 5;
@@ -218,3 +259,57 @@ TEST(SequenceCollectorRegression) {
   CHECK_EQ(0, strncmp("0123456789012345678901234567890123",
                       seq.start(), seq.length()));
 }
+
+
+struct SortItem {
+  int key;
+  int index;
+};
+
+
+struct SortItemLess {
+  bool operator()(const SortItem& a, const SortItem& b) const {
+    return a.key < b.key;
+  }
+};
+
+
+static void CheckTimSort(SortItem* items, int length) {
+  for (int i = 0; i < length; i++) items[i].index = i;
+  TimSort<SortItem, SortItemLess>::Sort(items, length, SortItemLess());
+  for (int i = 1; i < length; i++) {
+    CHECK(items[i - 1].key <= items[i].key);
+    // Equal keys keep their original order.
+    if (items[i - 1].key == items[i].key) {
+      CHECK(items[i - 1].index < items[i].index);
+    }
+  }
+}
+
+
+TEST(TimSort) {
+  static const int kLength = 5000;
+  SortItem* items = NewArray<SortItem>(kLength);
+  uint32_t seed = 17;
+  for (int length = 0; length <= kLength; length = length * 3 + 1) {
+    // Random keys with many duplicates.
+    for (int i = 0; i < length; i++) {
+      seed = seed * 1103515245 + 12345;
+      items[i].key = (seed >> 16) % 50;
+    }
+    CheckTimSort(items, length);
+    // Already sorted input, now without duplicates.
+    for (int i = 0; i < length; i++) items[i].key = i;
+    CheckTimSort(items, length);
+    // Descending input.
+    for (int i = 0; i < length; i++) items[i].key = length - i;
+    CheckTimSort(items, length);
+    // Alternating ascending and descending runs, which makes merges
+    // switch to galloping.
+    for (int i = 0; i < length; i++) {
+      items[i].key = ((i / 100) % 2 == 0) ? i : length - i;
+    }
+    CheckTimSort(items, length);
+  }
+  DeleteArray(items);
+}
@@ -0,0 +1,229 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "cctest.h"
+#include "value-serializer.h"
+
+using namespace v8::internal;
+
+
+// Serializes |value| and reads it back in the current context.
+static v8::Local<v8::Value> RoundTrip(v8::Local<v8::Value> value) {
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::ValueSerializer serializer(isolate);
+  serializer.WriteHeader();
+  CHECK(serializer.WriteValue(value));
+  v8::ValueDeserializer deserializer(
+      isolate, serializer.GetBuffer(), serializer.GetBufferSize());
+  CHECK(deserializer.ReadHeader());
+  return deserializer.ReadValue();
+}
+
+
+// Clones the value of |source| into the global 'clone', next to the
+// original in 'original', and runs |check| on them.
+static void CheckRoundTrip(const char* source, const char* check) {
+  v8::Local<v8::Object> global = CcTest::global();
+  v8::Local<v8::Value> original = CompileRun(source);
+  global->Set(v8_str("original"), original);
+  v8::Local<v8::Value> clone = RoundTrip(original);
+  CHECK(!clone.IsEmpty());
+  global->Set(v8_str("clone"), clone);
+  CHECK(CompileRun(check)->BooleanValue());
+}
+
+
+TEST(ValueSerializerPrimitives) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("undefined", "clone === undefined");
+  CheckRoundTrip("null", "clone === null");
+  CheckRoundTrip("true", "clone === true");
+  CheckRoundTrip("false", "clone === false");
+  CheckRoundTrip("-42", "clone === -42");
+  CheckRoundTrip("0x7fffffff", "clone === 0x7fffffff");
+  CheckRoundTrip("-0", "1 / clone === -Infinity");
+  CheckRoundTrip("NaN", "isNaN(clone)");
+  CheckRoundTrip("0.5", "clone === 0.5");
+  CheckRoundTrip("''", "clone === ''");
+  CheckRoundTrip("'one byte \\xff'", "clone === original");
+  CheckRoundTrip("'two byte \\u2603'", "clone === original");
+  CheckRoundTrip("var s = 'cons'; for (var i = 0; i < 10; i++) s += s; s",
+                 "clone === original");
+}
+
+
+TEST(ValueSerializerObjectsAndArrays) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("({a: 1, b: 'two', c: {d: [3]}})",
+                 "clone !== original &&"
+                 "JSON.stringify(clone) == JSON.stringify(original)");
+  CheckRoundTrip("({1: 'one', x: 'x'})",
+                 "clone[1] === 'one' && clone.x === 'x'");
+  CheckRoundTrip("var o = {}; o.getter = 1;"
+                 "Object.defineProperty(o, 'hidden', {value: 2}); o",
+                 "clone.getter === 1 && !('hidden' in clone)");
+  CheckRoundTrip("[1, 2, 3]", "clone.length == 3 && clone[2] === 3");
+  CheckRoundTrip("[1.5, -0, NaN]",
+                 "clone[0] === 1.5 && 1 / clone[1] === -Infinity &&"
+                 "isNaN(clone[2])");
+  CheckRoundTrip("[{}, 'a', null]",
+                 "typeof clone[0] == 'object' && clone[1] === 'a' &&"
+                 "clone[2] === null");
+  CheckRoundTrip("[]", "Array.isArray(clone) && clone.length == 0");
+  CheckRoundTrip("var a = [1, , 3]; a[100] = 4; a.name = 'n'; a",
+                 "clone.length == 101 && !(1 in clone) && clone[100] === 4 &&"
+                 "clone.name === 'n'");
+}
+
+
+TEST(ValueSerializerBackReferences) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("var shared = {}; [shared, shared]",
+                 "clone[0] === clone[1] && clone[0] !== shared");
+  CheckRoundTrip("var cyclic = {}; cyclic.self = cyclic; cyclic",
+                 "clone.self === clone");
+  CheckRoundTrip("var array = []; array[0] = array; array",
+                 "clone[0] === clone");
+}
+
+
+TEST(ValueSerializerArrayBuffers) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("var buffer = new ArrayBuffer(8);"
+                 "new Uint8Array(buffer)[7] = 42; buffer",
+                 "clone instanceof ArrayBuffer && clone.byteLength == 8 &&"
+                 "new Uint8Array(clone)[7] == 42 && clone !== buffer");
+  CheckRoundTrip("new Float64Array([0.5, 1.5]).subarray(1)",
+                 "clone instanceof Float64Array && clone.length == 1 &&"
+                 "clone[0] == 1.5 && clone.byteOffset == 8 &&"
+                 "clone.buffer.byteLength == 16");
+  CheckRoundTrip("var b = new ArrayBuffer(4);"
+                 "[new Uint8Array(b), new Uint16Array(b), b]",
+                 "clone[0].buffer === clone[1].buffer &&"
+                 "clone[1].buffer === clone[2] && clone[1].length == 2");
+}
+
+
+TEST(ValueSerializerMapsAndSets) {
+  FLAG_harmony_collections = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CheckRoundTrip("var m = new Map(); m.set(1, 'one'); m.set('two', 2);"
+                 "m.set(m, m); m.delete(1); m",
+                 "clone instanceof Map && clone.size == 2 &&"
+                 "clone.get('two') === 2 && clone.get(clone) === clone");
+  CheckRoundTrip("var s = new Set(); s.add(1); s.add('x'); s",
+                 "clone instanceof Set && clone.size == 2 &&"
+                 "clone.has(1) && clone.has('x')");
+}
+
+
+TEST(ValueSerializerTransferArrayBuffer) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::Local<v8::ArrayBuffer> buffer = v8::Local<v8::ArrayBuffer>::Cast(
+      CompileRun("var buffer = new ArrayBuffer(4);"
+                 "new Uint8Array(buffer)[0] = 7;"
+                 "buffer"));
+  v8::Local<v8::ArrayBuffer> target = v8::ArrayBuffer::New(isolate, 4);
+
+  v8::ValueSerializer serializer(isolate);
+  serializer.WriteHeader();
+  serializer.TransferArrayBuffer(3, buffer);
+  CHECK(serializer.WriteValue(CompileRun("[buffer, new Uint8Array(buffer)]")));
+  // No contents are copied for a transferred buffer.
+  CHECK_LT(serializer.GetBufferSize(), 16u);
+
+  v8::ValueDeserializer deserializer(
+      isolate, serializer.GetBuffer(), serializer.GetBufferSize());
+  deserializer.TransferArrayBuffer(3, target);
+  CHECK(deserializer.ReadHeader());
+  v8::Local<v8::Value> clone = deserializer.ReadValue();
+  CHECK(!clone.IsEmpty());
+  CcTest::global()->Set(v8_str("clone"), clone);
+  CcTest::global()->Set(v8_str("target"), target);
+  CHECK(CompileRun("clone[0] === target && clone[1].buffer === target")
+            ->BooleanValue());
+}
+
+
+TEST(ValueSerializerErrors) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+
+  const char* uncloneable[] = {
+    "(function() {})",
+    "new Date(0)",
+    "[1, /regexp/]",
+    "({toString: Math.max})",
+    "({get x() { throw 'getter'; }})"
+  };
+  for (size_t i = 0; i < ARRAY_SIZE(uncloneable); i++) {
+    v8::TryCatch try_catch;
+    v8::ValueSerializer serializer(isolate);
+    serializer.WriteHeader();
+    CHECK(!serializer.WriteValue(CompileRun(uncloneable[i])));
+    CHECK(try_catch.HasCaught());
+  }
+
+  // Truncated or corrupted data must throw, not crash.
+  v8::ValueSerializer serializer(isolate);
+  serializer.WriteHeader();
+  CHECK(serializer.WriteValue(
+      CompileRun("({a: [1, 'b', [2.5]], c: new Uint8Array(2)})")));
+  const uint8_t* data = serializer.GetBuffer();
+  size_t size = serializer.GetBufferSize();
+  for (size_t length = 2; length < size; length++) {
+    v8::TryCatch try_catch;
+    v8::ValueDeserializer deserializer(isolate, data, length);
+    CHECK(deserializer.ReadHeader());
+    CHECK(deserializer.ReadValue().IsEmpty());
+    CHECK(try_catch.HasCaught());
+  }
+  ScopedVector<uint8_t> corrupted(static_cast<int>(size));
+  for (size_t i = 2; i < size; i++) {
+    memcpy(corrupted.start(), data, size);
+    corrupted[static_cast<int>(i)] ^= 0x55;
+    v8::TryCatch try_catch;
+    v8::ValueDeserializer deserializer(isolate, corrupted.start(), size);
+    CHECK(deserializer.ReadHeader());
+    deserializer.ReadValue();
+  }
+
+  uint8_t future_version[] = { 0xFF, ValueSerializer::kVersion + 1 };
+  v8::ValueDeserializer deserializer(
+      isolate, future_version, sizeof(future_version));
+  CHECK(!deserializer.ReadHeader());
+}
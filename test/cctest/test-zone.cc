@@ -0,0 +1,92 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "v8.h"
+
+#include "cctest.h"
+#include "zone-inl.h"
+
+using namespace v8::internal;
+
+
+TEST(ZoneSegmentSizeClasses) {
+  CHECK_EQ(8 * KB, ZoneSegmentPool::RoundUpToSizeClass(1));
+  CHECK_EQ(8 * KB, ZoneSegmentPool::RoundUpToSizeClass(8 * KB));
+  CHECK_EQ(16 * KB, ZoneSegmentPool::RoundUpToSizeClass(8 * KB + 1));
+  CHECK_EQ(1 * MB, ZoneSegmentPool::RoundUpToSizeClass(1 * MB));
+  CHECK_EQ(1 * MB + 1, ZoneSegmentPool::RoundUpToSizeClass(1 * MB + 1));
+}
+
+
+TEST(ZoneSegmentPoolReuse) {
+  CcTest::InitializeVM();
+  FLAG_zone_segment_pool_size = 16;
+  ZoneSegmentPool::Trim(0);
+
+  ZoneSegmentPool::Statistics before;
+  ZoneSegmentPool::GetStatistics(&before);
+  CHECK_EQ(0, static_cast<int>(before.pooled_bytes));
+  {
+    // Large enough not to be kept by the zone itself.
+    Zone zone(CcTest::i_isolate());
+    zone.New(100 * KB);
+  }
+  ZoneSegmentPool::Statistics released;
+  ZoneSegmentPool::GetStatistics(&released);
+  CHECK_EQ(128 * KB, static_cast<int>(released.pooled_bytes));
+  CHECK_EQ(1, static_cast<int>(released.segments_pooled));
+  CHECK(released.peak_pooled_bytes >= 128 * KB);
+  {
+    Zone zone(CcTest::i_isolate());
+    zone.New(100 * KB);
+    ZoneSegmentPool::Statistics reused;
+    ZoneSegmentPool::GetStatistics(&reused);
+    CHECK(reused.segments_reused == before.segments_reused + 1);
+    CHECK_EQ(0, static_cast<int>(reused.pooled_bytes));
+  }
+
+  ZoneSegmentPool::Trim(0);
+  ZoneSegmentPool::Statistics trimmed;
+  ZoneSegmentPool::GetStatistics(&trimmed);
+  CHECK_EQ(0, static_cast<int>(trimmed.pooled_bytes));
+  CHECK_EQ(0, static_cast<int>(trimmed.segments_pooled));
+}
+
+
+TEST(ZoneSegmentPoolLimit) {
+  CcTest::InitializeVM();
+  FLAG_zone_segment_pool_size = 0;
+  ZoneSegmentPool::Trim(0);
+  {
+    Zone zone(CcTest::i_isolate());
+    zone.New(100 * KB);
+  }
+  ZoneSegmentPool::Statistics statistics;
+  ZoneSegmentPool::GetStatistics(&statistics);
+  CHECK_EQ(0, static_cast<int>(statistics.pooled_bytes));
+  FLAG_zone_segment_pool_size = 16;
+}
@@ -0,0 +1,67 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Sort ASCII strings, which may take a fast path that does not call into
+// ICU, and check that the order agrees with ICU for non-ASCII strings.
+
+var collator = Intl.Collator(['en']);
+var strings = ['b', 'B', 'a', 'A', 'a-b', 'ab', 'a b', 'Ab', '10', '9',
+               '', '_a', 'ä'];
+var result = strings.sort(collator.compare);
+
+assertEquals('', result[0]);
+assertEquals('_a', result[1]);
+assertEquals('10', result[2]);
+assertEquals('9', result[3]);
+assertEquals('a', result[4]);
+assertEquals('A', result[5]);
+assertEquals('ä', result[6]);
+assertEquals('a b', result[7]);
+assertEquals('a-b', result[8]);
+assertEquals('ab', result[9]);
+assertEquals('Ab', result[10]);
+assertEquals('b', result[11]);
+assertEquals('B', result[12]);
+
+assertEquals(0, collator.compare('abc', 'abc'));
+assertEquals(-1, collator.compare('abc', 'abd'));
+assertEquals(1, collator.compare('abd', 'abc'));
+assertEquals(-1, collator.compare('abc', 'abcd'));
+
+// Tailorings of ASCII characters and contractions must be honoured.
+assertEquals(1, Intl.Collator(['da']).compare('aa', 'z'));
+assertEquals(1, Intl.Collator(['cs']).compare('ch', 'hz'));
+
+// Non-default options must be honoured.
+assertEquals(0, Intl.Collator(['en'], {sensitivity: 'base'}).compare('a', 'A'));
+assertEquals(-1, Intl.Collator(['en'], {numeric: true}).compare('9', '10'));
+
+// Collators created for the same locale and options are reused internally,
+// but must behave the same.
+assertEquals('a'.localeCompare('B', 'en'), 'a'.localeCompare('B', 'en'));
+assertEquals(-1, 'a'.localeCompare('B', 'en'));
+assertEquals(1, 'aa'.localeCompare('z', 'da'));
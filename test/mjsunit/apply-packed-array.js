@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Tests Function.prototype.apply with arrays of the various elements kinds.
+
+function collect() {
+  var result = [];
+  for (var i = 0; i < arguments.length; i++) result.push(arguments[i]);
+  return result;
+}
+
+function receiver() {
+  "use strict";
+  return this;
+}
+
+// Packed smi and object elements.
+assertEquals([1, 2, 3], collect.apply(null, [1, 2, 3]));
+assertEquals(["a", {}, null], collect.apply(null, ["a", {}, null]));
+assertEquals([], collect.apply(null, []));
+var o = {};
+assertSame(o, receiver.apply(o, [1, 2]));
+
+// Packed double elements.
+assertEquals([1.5, 2.5], collect.apply(null, [1.5, 2.5]));
+
+// Holes are read through the prototype chain.
+var holey = [1, , 3];
+assertEquals([1, undefined, 3], collect.apply(null, holey));
+Array.prototype[1] = "proto";
+assertEquals([1, "proto", 3], collect.apply(null, holey));
+delete Array.prototype[1];
+
+// Copy-on-write literal backing stores.
+function literal() { return [4, 5, 6]; }
+assertEquals([4, 5, 6], collect.apply(null, literal()));
+
+// A large packed array.
+var big = [];
+for (var i = 0; i < 10000; i++) big.push(i);
+var result = collect.apply(null, big);
+assertEquals(10000, result.length);
+assertEquals(9999, result[9999]);
+
+// Array-like objects and arguments objects.
+assertEquals([7, 8], collect.apply(null, { length: 2, 0: 7, 1: 8 }));
+function forward() { return collect.apply(null, arguments); }
+assertEquals([9, 10], forward(9, 10));
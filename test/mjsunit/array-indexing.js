@@ -184,3 +184,53 @@ assertEquals(10, Array.prototype.lastIndexOf.call(funky_object, 42));
 assertEquals(-1, Array.prototype.lastIndexOf.call(funky_object, 37));
 
 assertEquals(-1, Array.prototype.lastIndexOf.call(infinite_object, 42));
+
+// indexOf on the various fast elements kinds.
+var smis = [1, 2, 3, 2, 1];
+assertEquals(1, smis.indexOf(2));
+assertEquals(3, smis.indexOf(2, 2));
+assertEquals(3, smis.indexOf(2, -2));
+assertEquals(0, smis.indexOf(1, -10));
+assertEquals(-1, smis.indexOf(2, 10));
+assertEquals(2, smis.indexOf(3.0));
+assertEquals(-1, smis.indexOf(3.5));
+assertEquals(-1, smis.indexOf("2"));
+assertEquals(-1, smis.indexOf(undefined));
+
+var doubles = [1.5, -0, NaN, 2.5];
+assertEquals(0, doubles.indexOf(1.5));
+assertEquals(1, doubles.indexOf(0));
+assertEquals(1, doubles.indexOf(-0));
+assertEquals(-1, doubles.indexOf(NaN));
+assertEquals(-1, doubles.indexOf("1.5"));
+var holey_doubles = [1.5, , 2.5];
+assertEquals(-1, holey_doubles.indexOf(undefined));
+assertEquals(2, holey_doubles.indexOf(2.5));
+
+var strings = ["foo", "bar", "foobar"];
+assertEquals(2, strings.indexOf("foo" + "bar".substring(0, 3)));
+assertEquals(-1, strings.indexOf({}));
+var key = {};
+var objects = [null, undefined, key, 7, 7.5, "7"];
+assertEquals(0, objects.indexOf(null));
+assertEquals(1, objects.indexOf(undefined));
+assertEquals(2, objects.indexOf(key));
+assertEquals(3, objects.indexOf(7));
+assertEquals(4, objects.indexOf(7.5));
+assertEquals(5, objects.indexOf("7"));
+assertEquals(-1, [1, , 3].indexOf(undefined));
+assertEquals(1, [1, undefined, 3].indexOf(undefined));
+
+// Holes read through the prototype chain.
+Array.prototype[1] = "proto";
+assertEquals(1, [0, , 2].indexOf("proto"));
+delete Array.prototype[1];
+assertEquals(-1, [0, , 2].indexOf("proto"));
+
+// The start index is converted before searching.
+var converted = false;
+assertEquals(2, smis.indexOf(3, { valueOf: function() {
+  converted = true;
+  return 1;
+}}));
+assertTrue(converted);
@@ -225,3 +225,30 @@
   assertEquals(2, count);
 
 })();
+
+// Holes and undefined elements in fast arrays.
+(function() {
+  var visited = [];
+  [undefined, , 3, , undefined].forEach(function(x, i) { visited.push(i); });
+  assertEquals([0, 2, 4], visited);
+  assertEquals([true, true], [undefined, , null].filter(function(x) {
+    return true;
+  }).map(function(x) { return x === undefined || x === null; }));
+  var mapped = [1, , undefined].map(function(x) { return typeof x; });
+  assertEquals(3, mapped.length);
+  assertEquals("number", mapped[0]);
+  assertFalse(1 in mapped);
+  assertEquals("undefined", mapped[2]);
+  Array.prototype[1] = "proto";
+  visited = [];
+  [0, , 2].forEach(function(x) { visited.push(x); });
+  assertEquals([0, "proto", 2], visited);
+  delete Array.prototype[1];
+  // Deleting elements ahead of the iteration hides them.
+  var a = [1, 2, 3, 4];
+  visited = [];
+  a.forEach(function(x, i) { visited.push(x); delete a[i + 1]; });
+  assertEquals([1, 3], visited);
+  assertFalse([undefined, ,].some(function(x, i) { return i == 1; }));
+  assertTrue([, , ].every(function() { return false; }));
+})();
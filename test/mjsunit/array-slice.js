@@ -302,3 +302,53 @@
   }
   f(1,2,3);
 })();
+
+// Check that copies of large arrays that share their backing store stay
+// independent of the original once either of them is written to.
+(function() {
+  function make(n) {
+    var a = [];
+    for (var i = 0; i < n; i++) a.push(i);
+    return a;
+  }
+
+  var a = make(200);
+  var b = a.slice();
+  var c = a.slice(0);
+  var d = [].concat(a);
+  var e = a.concat([]);
+  assertEquals(a, b);
+  assertEquals(a, c);
+  assertEquals(a, d);
+  assertEquals(a, e);
+
+  a[0] = 'x';
+  b[1] = 'y';
+  c.push(200);
+  d.length = 10;
+  e.pop();
+  assertEquals('x', a[0]);
+  assertEquals(1, a[1]);
+  assertEquals(200, a.length);
+  assertEquals(0, b[0]);
+  assertEquals('y', b[1]);
+  assertEquals(0, c[0]);
+  assertEquals(201, c.length);
+  assertEquals(10, d.length);
+  assertEquals(199, e.length);
+  assertEquals(199, c[199]);
+
+  // Slicing a slice shares the same store again.
+  var f = b.slice();
+  f[2] = 'z';
+  assertEquals(2, b[2]);
+  assertEquals('z', f[2]);
+
+  // Holey arrays keep their holes in the copy.
+  var g = make(100);
+  delete g[50];
+  var h = g.slice();
+  assertFalse(50 in h);
+  h[50] = 50;
+  assertFalse(50 in g);
+})();
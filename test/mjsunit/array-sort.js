@@ -404,3 +404,42 @@ function cmpTest(a, b) {
   return a.val - b.val;
 }
 arr.sort(cmpTest);
+
+// Default order sorting of smi and double arrays compares the numbers'
+// string representations.
+function TestNumberDefaultSort() {
+  assertEquals([-1, -10, -2, 0, 1, 10, 100, 2, 9],
+               [10, 9, -1, 2, 0, 100, -2, 1, -10].sort());
+  assertEquals([-1073741824, 1073741823, 2, 3],
+               [3, 1073741823, 2, -1073741824].sort());
+  assertEquals([-0.5, 0.25, 1.5, 10.5, 2.5, Infinity, NaN],
+               [NaN, 2.5, Infinity, 10.5, -0.5, 1.5, 0.25].sort());
+  assertEquals([1e+21, 1e-7, 2, 3.5], [3.5, 1e-7, 2, 1e21].sort());
+  // Holes and undefineds end up at the end.
+  var holey = [3.5, , 1.5, undefined, 2.5];
+  holey.sort();
+  assertEquals([1.5, 2.5, 3.5, undefined], holey.slice(0, 4));
+  assertEquals(5, holey.length);
+  assertFalse(4 in holey);
+  // Copy-on-write literals are copied before sorting.
+  function literal() { return [3, 1, 2]; }
+  assertEquals([1, 2, 3], literal().sort());
+  assertEquals([3, 1, 2], literal());
+  // Zeros compare equal, so the sort keeps their relative order.
+  var zeros = [0.5, -0, 0, 0.5, -0];
+  zeros.sort();
+  assertEquals(-Infinity, 1 / zeros[0]);
+  assertEquals(Infinity, 1 / zeros[1]);
+  assertEquals(-Infinity, 1 / zeros[2]);
+  // Large partially sorted inputs.
+  var big = [];
+  for (var i = 0; i < 10000; i++) big.push(i % 1000 < 500 ? i : 10000 - i);
+  var expected = big.slice().map(String).sort().map(Number);
+  assertEquals(expected, big.sort());
+  var doubles = [];
+  for (var i = 0; i < 10000; i++) doubles.push((i * 7919) % 10007 + 0.5);
+  expected = doubles.slice().map(String).sort().map(Number);
+  assertEquals(expected, doubles.sort());
+}
+
+TestNumberDefaultSort();
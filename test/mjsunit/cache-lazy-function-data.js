@@ -0,0 +1,55 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --cache-lazy-function-data --allow-natives-syntax
+
+// The preparse results of skipped inner functions are reused when the
+// outer function is parsed again for optimization. The variables the inner
+// functions refer to must be context allocated in both parses.
+
+function outer(v) {
+  var captured = v;
+  var local = v * 2;
+  var literal = function() { return [captured, { a: local }]; };
+  function get() { return captured; }
+  return local + get() + literal()[1].a;
+}
+
+assertEquals(5, outer(1));
+assertEquals(10, outer(2));
+%OptimizeFunctionOnNextCall(outer);
+assertEquals(15, outer(3));
+assertEquals(20, outer(4));
+
+
+function strictInner(x) {
+  function inner() { "use strict"; return this === undefined ? x : 0; }
+  return inner();
+}
+
+assertEquals(1, strictInner(1));
+%OptimizeFunctionOnNextCall(strictInner);
+assertEquals(2, strictInner(2));
+
+
+function withEval(x) {
+  var hidden = 42;
+  function run(code) { return eval(code); }
+  return run("hidden") + x;
+}
+
+assertEquals(43, withEval(1));
+%OptimizeFunctionOnNextCall(withEval);
+assertEquals(44, withEval(2));
+
+
+function unicodeNames() {
+  var café = 3;
+  function get() { return café; }
+  return get();
+}
+
+assertEquals(3, unicodeNames());
+%OptimizeFunctionOnNextCall(unicodeNames);
+assertEquals(3, unicodeNames());
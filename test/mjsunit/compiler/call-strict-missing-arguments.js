@@ -0,0 +1,76 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Calls from optimized code to strict functions that cannot observe their
+// actual argument count pad missing arguments with undefined themselves.
+
+function strict3(a, b, c) {
+  "use strict";
+  return [a, b, c];
+}
+
+function sloppy3(a, b, c) {
+  return arguments.length;
+}
+
+function strictArguments3(a, b, c) {
+  "use strict";
+  return arguments.length;
+}
+
+function callAll() {
+  return [strict3(1), sloppy3(1), strictArguments3(1, 2), strict3()];
+}
+
+function check(result) {
+  assertEquals([1, undefined, undefined], result[0]);
+  assertEquals(1, result[1]);
+  assertEquals(2, result[2]);
+  assertEquals([undefined, undefined, undefined], result[3]);
+}
+
+check(callAll());
+check(callAll());
+%OptimizeFunctionOnNextCall(callAll);
+check(callAll());
+
+// Method calls on a known receiver take the same path.
+var o = {
+  m: function(x, y) {
+    "use strict";
+    return y === undefined ? x : x + y;
+  }
+};
+
+function callMethod(v) { return o.m(v); }
+
+assertEquals(1, callMethod(1));
+assertEquals(2, callMethod(2));
+%OptimizeFunctionOnNextCall(callMethod);
+assertEquals(3, callMethod(3));
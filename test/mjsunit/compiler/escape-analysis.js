@@ -436,3 +436,30 @@
   delete deopt.deopt;
   field(1); field(2);
 })();
+
+
+// Test allocations merged by a phi, e.g. from an inlined function with
+// several return statements.
+(function testMergedAllocations() {
+  var deopt = { deopt:false };
+  function constructor(x) {
+    this.x = x;
+  }
+  function make(c, x) {
+    if (c) return new constructor(x);
+    return new constructor(x + 1);
+  }
+  function merged(c, x) {
+    var o = make(c, x);
+    deopt.deopt
+    assertEquals(c ? x : x + 1, o.x);
+    return o.x;
+  }
+  merged(true, 1); merged(false, 2);
+  %OptimizeFunctionOnNextCall(merged);
+  assertEquals(3, merged(true, 3));
+  assertEquals(5, merged(false, 4));
+  delete deopt.deopt;
+  assertEquals(5, merged(true, 5));
+  assertEquals(7, merged(false, 6));
+})();
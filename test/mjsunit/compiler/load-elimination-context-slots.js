@@ -0,0 +1,69 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --load-elimination
+
+// Stores to context slots are forwarded to subsequent loads, but calls
+// and stores through inner closures must invalidate them.
+
+function outer(a) {
+  var x = a;
+  function get() { return x; }
+  function set(v) { x = v; }
+  function test(b) {
+    x = b;
+    var r1 = x;
+    set(r1 + 1);
+    var r2 = x;
+    x = r2 * 2;
+    return [r1, r2, x, get()];
+  }
+  return test;
+}
+
+var test = outer(0);
+assertEquals([1, 2, 4, 4], test(1));
+assertEquals([3, 4, 8, 8], test(3));
+%OptimizeFunctionOnNextCall(test);
+assertEquals([5, 6, 12, 12], test(5));
+assertEquals([7, 8, 16, 16], test(7));
+
+function loop(n) {
+  var sum = 0;
+  function add(v) { sum += v; }
+  for (var i = 0; i < n; i++) {
+    var s = sum;
+    add(i);
+    if (sum === s && i !== 0) return -1;
+  }
+  return sum;
+}
+
+assertEquals(45, loop(10));
+assertEquals(45, loop(10));
+%OptimizeFunctionOnNextCall(loop);
+assertEquals(45, loop(10));
@@ -0,0 +1,84 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --hydrogen-loop-peeling
+
+function sum(a) {
+  var result = 0;
+  for (var i = 0; i < a.length; i++) result += a[i];
+  return result;
+}
+
+function firstNegative(a) {
+  var i = 0;
+  while (i < a.length) {
+    if (a[i] < 0) break;
+    i++;
+  }
+  return i;
+}
+
+function countSkipping(a, skip) {
+  var count = 0;
+  outer: for (var i = 0; i < a.length; i++) {
+    for (var j = 0; j < a[i].length; j++) {
+      if (a[i][j] === skip) continue outer;
+      count++;
+    }
+  }
+  return count;
+}
+
+function firstIteration(n) {
+  var x = 0;
+  while (true) {
+    x++;
+    if (x >= n) return x;
+  }
+}
+
+function test() {
+  assertEquals(0, sum([]));
+  assertEquals(1, sum([1]));
+  assertEquals(10, sum([1, 2, 3, 4]));
+  assertEquals(0, firstNegative([-1, 2]));
+  assertEquals(1, firstNegative([1, -2]));
+  assertEquals(2, firstNegative([1, 2]));
+  assertEquals(0, countSkipping([[0, 1]], 0));
+  assertEquals(3, countSkipping([[1, 0, 2], [1, 2]], 0));
+  assertEquals(1, firstIteration(0));
+  assertEquals(1, firstIteration(1));
+  assertEquals(5, firstIteration(5));
+}
+
+test();
+test();
+%OptimizeFunctionOnNextCall(sum);
+%OptimizeFunctionOnNextCall(firstNegative);
+%OptimizeFunctionOnNextCall(countSkipping);
+%OptimizeFunctionOnNextCall(firstIteration);
+test();
@@ -0,0 +1,164 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --optimize-try-catch --expose-gc
+
+// Exceptions thrown inside the try block of an optimized function are caught
+// by deoptimizing to the catch block.
+
+function Thrower(x) {
+  if (x > 5) throw x;
+  return x;
+}
+
+function CatchInOptimized(x) {
+  var before = x + 1;
+  try {
+    return Thrower(x) + before;
+  } catch (e) {
+    return before - e;
+  }
+}
+
+assertEquals(3, CatchInOptimized(1));
+assertEquals(5, CatchInOptimized(2));
+%OptimizeFunctionOnNextCall(CatchInOptimized);
+assertEquals(7, CatchInOptimized(3));
+assertEquals(1, CatchInOptimized(6));
+assertEquals(9, CatchInOptimized(4));
+assertEquals(1, CatchInOptimized(7));
+
+
+// Deoptimization inside the try block rebuilds the handler, so the
+// unoptimized code still catches the exception.
+
+function DeoptInTry(o, x) {
+  var result = 0;
+  try {
+    Thrower(o.a + x);
+  } catch (e) {
+    result = e;
+  }
+  return result;
+}
+
+assertEquals(0, DeoptInTry({ a: 1 }, 1));
+assertEquals(0, DeoptInTry({ a: 1 }, 2));
+%OptimizeFunctionOnNextCall(DeoptInTry);
+assertEquals(0, DeoptInTry({ a: 1 }, 3));
+assertEquals(42, DeoptInTry({ b: 2, a: 1 }, 41));
+
+
+// Returning from inside the try block pops the handler.
+
+function ReturnInTry(x) {
+  try {
+    if (x) return x;
+  } catch (e) {
+    return -1;
+  }
+  return 0;
+}
+
+function CallReturnInTry(x) {
+  var result = ReturnInTry(x);
+  try {
+    Thrower(10);
+  } catch (e) {
+    result += e;
+  }
+  return result;
+}
+
+assertEquals(11, CallReturnInTry(1));
+assertEquals(10, CallReturnInTry(0));
+%OptimizeFunctionOnNextCall(ReturnInTry);
+assertEquals(12, CallReturnInTry(2));
+assertEquals(10, CallReturnInTry(0));
+
+
+// Values only used by the catch block survive a garbage collection inside
+// the try block.
+
+function GCInTry(x) {
+  var saved = { value: x };
+  try {
+    gc();
+    Thrower(x);
+  } catch (e) {
+    return saved.value + e;
+  }
+  return saved.value;
+}
+
+assertEquals(1, GCInTry(1));
+assertEquals(2, GCInTry(2));
+%OptimizeFunctionOnNextCall(GCInTry);
+assertEquals(3, GCInTry(3));
+assertEquals(14, GCInTry(7));
+
+
+// Variables assigned inside the try block and read after it are not
+// affected by a thrown exception.
+
+function AssignInTry(x) {
+  var y = 0;
+  try {
+    y = x;
+    Thrower(x);
+    y = 2 * x;
+  } catch (e) {
+    return y;
+  }
+  return y;
+}
+
+assertEquals(2, AssignInTry(1));
+assertEquals(4, AssignInTry(2));
+%OptimizeFunctionOnNextCall(AssignInTry);
+assertEquals(6, AssignInTry(3));
+assertEquals(7, AssignInTry(7));
+
+
+// Try/catch inside a loop.
+
+function TryInLoop(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    try {
+      Thrower(i);
+    } catch (e) {
+      sum += e;
+    }
+  }
+  return sum;
+}
+
+assertEquals(0, TryInLoop(5));
+assertEquals(6, TryInLoop(7));
+%OptimizeFunctionOnNextCall(TryInLoop);
+assertEquals(6 + 7 + 8, TryInLoop(9));
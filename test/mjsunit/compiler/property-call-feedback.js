@@ -0,0 +1,71 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Method calls record their target in the feedback vector, so a call
+// site whose receivers are megamorphic but which always calls the same
+// function can still be specialized.
+
+function shared() { return this.v; }
+
+var receivers = [];
+for (var i = 0; i < 10; i++) {
+  var o = {};
+  o["p" + i] = i;
+  o.v = i;
+  o.m = shared;
+  receivers.push(o);
+}
+
+function call_named(o) { return o.m(); }
+function call_keyed(o, key) { return o[key](); }
+
+function run() {
+  for (var i = 0; i < receivers.length; i++) {
+    assertEquals(i, call_named(receivers[i]));
+    assertEquals(i, call_keyed(receivers[i], "m"));
+  }
+}
+
+run();
+run();
+%OptimizeFunctionOnNextCall(call_named);
+%OptimizeFunctionOnNextCall(call_keyed);
+run();
+
+// A different target must still be called correctly.
+var other = { m: function() { return "other"; } };
+assertEquals("other", call_named(other));
+assertEquals("other", call_keyed(other, "m"));
+run();
+
+// Primitive receivers are wrapped for sloppy mode targets.
+String.prototype.m = shared;
+String.prototype.v = "wrapped";
+assertEquals("wrapped", call_named("x"));
+assertEquals("wrapped", call_keyed("x", "m"));
@@ -0,0 +1,61 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Tests optimized string additions with a long constant operand, which
+// only check the other operand for emptiness.
+
+function prefix(s) {
+  return "a long constant prefix: " + s;
+}
+
+function suffix(s) {
+  return s + " with a long constant suffix";
+}
+
+function chain(a, b) {
+  return "first long constant part " + a + " second long constant part " + b;
+}
+
+function check() {
+  assertEquals("a long constant prefix: ", prefix(""));
+  assertEquals("a long constant prefix: x", prefix("x"));
+  assertEquals(" with a long constant suffix", suffix(""));
+  assertEquals("ሴ with a long constant suffix", suffix("ሴ"));
+  assertEquals("first long constant part  second long constant part ",
+               chain("", ""));
+  assertEquals("first long constant part 1 second long constant part 2",
+               chain("1", "2"));
+}
+
+check();
+check();
+%OptimizeFunctionOnNextCall(prefix);
+%OptimizeFunctionOnNextCall(suffix);
+%OptimizeFunctionOnNextCall(chain);
+check();
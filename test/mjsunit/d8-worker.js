@@ -0,0 +1,86 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test that d8 workers exchange structured clones of their messages.
+
+if (this.Worker) {
+  var worker = new Worker(
+      "onmessage = function(m) {\n" +
+      "  if (m instanceof ArrayBuffer) {\n" +
+      "    var view = new Uint8Array(m);\n" +
+      "    postMessage([m.byteLength, view[0], view[m.byteLength - 1]]);\n" +
+      "  } else {\n" +
+      "    postMessage(m);\n" +
+      "  }\n" +
+      "};");
+
+  // Primitives, arrays and plain objects round trip by value.
+  var messages = [undefined, null, true, false, 42, -0.5, "",
+                  "héllo ☃", [1, [2, "three"]],
+                  {a: 1, b: {c: [null]}}];
+  for (var i = 0; i < messages.length; i++) {
+    worker.postMessage(messages[i]);
+    assertEquals(messages[i], worker.getMessage());
+  }
+
+  var object = {x: 1};
+  worker.postMessage(object);
+  var clone = worker.getMessage();
+  assertEquals(object, clone);
+  clone.x = 2;
+  assertEquals(1, object.x);
+
+  // Array buffers are copied unless they are transferred.
+  var buffer = new ArrayBuffer(16);
+  var view = new Uint8Array(buffer);
+  view[0] = 7;
+  view[15] = 9;
+  worker.postMessage(buffer);
+  assertEquals([16, 7, 9], worker.getMessage());
+  assertEquals(16, buffer.byteLength);
+
+  worker.postMessage(buffer, [buffer]);
+  assertEquals([16, 7, 9], worker.getMessage());
+  assertEquals(0, buffer.byteLength);
+
+  // Values that cannot be cloned throw in the sender.
+  assertThrows(function() { worker.postMessage(function() {}); });
+  var cyclic = {};
+  cyclic.self = cyclic;
+  assertThrows(function() { worker.postMessage(cyclic); });
+  assertThrows(function() { worker.postMessage(1, [1]); });
+  assertThrows(function() { Worker(""); });
+
+  worker.terminate();
+  assertEquals(undefined, worker.getMessage());
+
+  // A worker stuck in a loop can still be stopped.
+  var busy = new Worker("postMessage('started'); while (true) {}");
+  assertEquals('started', busy.getMessage());
+  busy.terminate();
+  assertEquals(undefined, busy.getMessage());
+}
@@ -0,0 +1,98 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// Flags: --allow-natives-syntax
+
+// Crankshaft inlines DataView accessors and the typed array length getter.
+// Check optimized code against the results of unoptimized code.
+
+var buffer = new ArrayBuffer(32);
+var view = new DataView(buffer, 4, 24);
+var bytes = new Uint8Array(buffer);
+for (var i = 0; i < bytes.length; i++) bytes[i] = (i * 37 + 0x85) & 0xff;
+
+var getters = ["getInt8", "getUint8", "getInt16", "getUint16",
+               "getInt32", "getUint32", "getFloat32", "getFloat64"];
+
+function makeGetter(name) {
+  return new Function("view", "offset", "little_endian",
+      "return view." + name + "(offset, little_endian);");
+}
+
+for (var g = 0; g < getters.length; g++) {
+  var get = makeGetter(getters[g]);
+  var expected = [];
+  for (var offset = 0; offset < 16; offset++) {
+    expected.push(get(view, offset, true), get(view, offset, false));
+  }
+  %OptimizeFunctionOnNextCall(get);
+  for (var offset = 0; offset < 16; offset++) {
+    assertEquals(expected[offset * 2], get(view, offset, true));
+    assertEquals(expected[offset * 2 + 1], get(view, offset, false));
+  }
+  // Reading past the end of the view still throws.
+  assertThrows(function() { get(view, 24, true); }, RangeError);
+}
+
+
+var setters = ["setInt8", "setUint8", "setInt16", "setUint16",
+               "setInt32", "setUint32", "setFloat32", "setFloat64"];
+var values = [0, 1, -1, 127, -128, 255, 65535, -32768, 0x7fffffff,
+              -0x80000000, 0xffffffff, 4294967296.5, 1.5, -2.25, 1e300, NaN];
+
+function makeSetter(name) {
+  return new Function("view", "offset", "value", "little_endian",
+      "view." + name + "(offset, value, little_endian);");
+}
+
+for (var s = 0; s < setters.length; s++) {
+  var set = makeSetter(setters[s]);
+  var expected = [];
+  for (var v = 0; v < values.length; v++) {
+    set(view, 3, values[v], v % 2 == 0);
+    expected.push(Array.prototype.slice.call(bytes));
+  }
+  %OptimizeFunctionOnNextCall(set);
+  for (var v = 0; v < values.length; v++) {
+    set(view, 3, values[v], v % 2 == 0);
+    assertEquals(expected[v], Array.prototype.slice.call(bytes));
+  }
+  assertThrows(function() { set(view, 24, 0, true); }, RangeError);
+}
+
+
+function length(array) {
+  return array.length;
+}
+
+var int16_array = new Int16Array(7);
+assertEquals(7, length(int16_array));
+%OptimizeFunctionOnNextCall(length);
+assertEquals(7, length(int16_array));
+assertEquals(3, length(new Float64Array(3)));
+
+var fake = Object.create(Int16Array.prototype);
+assertThrows(function() { length(fake); }, TypeError);
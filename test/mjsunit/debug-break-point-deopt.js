@@ -0,0 +1,77 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --expose-debug-as debug --allow-natives-syntax
+// Flags: --no-break-points-deoptimize-all
+
+// Setting a break point only deoptimizes the code containing the function
+// with the break point, including code it has been inlined into.
+
+Debug = debug.Debug;
+
+var break_count = 0;
+
+function listener(event, exec_state, event_data, data) {
+  if (event == Debug.DebugEvent.Break) break_count++;
+}
+
+Debug.setListener(listener);
+
+function f(x) {
+  return x + 1;
+}
+
+function g(x) {
+  return x * 2;
+}
+
+function h(x) {
+  return f(x) + 1;
+}
+
+for (var i = 0; i < 3; i++) {
+  g(i);
+  h(i);
+}
+%OptimizeFunctionOnNextCall(g);
+%OptimizeFunctionOnNextCall(h);
+g(1);
+h(1);
+assertOptimized(g);
+assertOptimized(h);
+
+var bp = Debug.setBreakPoint(f, 1);
+assertOptimized(g);
+assertUnoptimized(h);
+
+assertEquals(3, h(1));
+assertEquals(1, break_count);
+assertEquals(4, g(2));
+assertEquals(1, break_count);
+
+Debug.clearBreakPoint(bp);
+Debug.setListener(null);
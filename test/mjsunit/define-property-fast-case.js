@@ -0,0 +1,99 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// Flags: --allow-natives-syntax
+
+// Object.defineProperty defines new properties from plain attributes objects
+// in the runtime. Check that it behaves like the generic code.
+
+function checkDescriptor(obj, name, expected) {
+  var desc = Object.getOwnPropertyDescriptor(obj, name);
+  for (var key in expected) assertSame(expected[key], desc[key], key);
+}
+
+// Absent fields default to false and undefined.
+var o = {};
+Object.defineProperty(o, "a", {});
+checkDescriptor(o, "a", {value: undefined, writable: false,
+                         enumerable: false, configurable: false});
+Object.defineProperty(o, "b", {value: 1, writable: 1, enumerable: "yes"});
+checkDescriptor(o, "b", {value: 1, writable: true,
+                         enumerable: true, configurable: false});
+function getter() { return 42; }
+Object.defineProperty(o, "c", {get: getter, configurable: true});
+checkDescriptor(o, "c", {get: getter, set: undefined,
+                         enumerable: false, configurable: true});
+assertEquals(42, o.c);
+assertTrue(%HasFastProperties(o));
+
+// Fields are looked up on the prototype chain of the attributes object.
+var p = {};
+Object.defineProperty(p, "x", Object.create({enumerable: true, value: 7}));
+checkDescriptor(p, "x", {value: 7, enumerable: true});
+
+// Getters on the attributes object are called.
+var calls = 0;
+var attributes = { get value() { calls++; return 3; } };
+Object.defineProperty(p, "y", attributes);
+assertEquals(1, calls);
+assertEquals(3, p.y);
+
+// Invalid attributes still throw.
+assertThrows(function() {
+  Object.defineProperty({}, "z", {get: 1});
+}, TypeError);
+assertThrows(function() {
+  Object.defineProperty({}, "z", {get: getter, value: 1});
+}, TypeError);
+assertThrows(function() {
+  Object.defineProperty(Object.preventExtensions({}), "z", {value: 1});
+}, TypeError);
+
+// Redefining goes through the generic code.
+assertThrows(function() { Object.defineProperty(o, "a", {value: 2}); },
+             TypeError);
+Object.defineProperty(o, "c", {get: function() { return 43; }});
+assertEquals(43, o.c);
+
+// Objects that get different accessors for the same property keep fast
+// properties.
+function Point(x, y) {
+  Object.defineProperty(this, "x", {
+      get: function() { return x; }, set: function(v) { x = v; } });
+  Object.defineProperty(this, "y", {
+      get: function() { return y; }, enumerable: true });
+}
+
+var points = [];
+for (var i = 0; i < 10; i++) points.push(new Point(i, -i));
+for (var i = 0; i < 10; i++) {
+  assertTrue(%HasFastProperties(points[i]));
+  assertEquals(i, points[i].x);
+  assertEquals(-i, points[i].y);
+  points[i].x = i + 1;
+  assertEquals(i + 1, points[i].x);
+  assertEquals(["y"], Object.keys(points[i]));
+}
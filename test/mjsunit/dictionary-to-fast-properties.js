@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --stable-dictionary-load-misses=8
+
+// Check that objects that went to dictionary mode because of a delete are
+// turned back into fast mode once they are only read from.
+
+// Each function created here has a load IC of its own, so every call is
+// one load miss on the object passed in.
+function NewReader() {
+  return new Function("o", "return o.a;");
+}
+
+function ReadRepeatedly(o, times) {
+  for (var i = 0; i < times; i++) assertEquals(1, NewReader()(o));
+}
+
+var o = { a: 1, b: 2, c: 3 };
+assertTrue(%HasFastProperties(o));
+delete o.c;
+assertFalse(%HasFastProperties(o));
+ReadRepeatedly(o, 2);
+assertFalse(%HasFastProperties(o));
+ReadRepeatedly(o, 8);
+assertTrue(%HasFastProperties(o));
+assertEquals(1, o.a);
+assertEquals(2, o.b);
+assertFalse("c" in o);
+
+// Adding or deleting a property starts the count again.
+delete o.b;
+o.b = 2;
+ReadRepeatedly(o, 5);
+o.d = 4;
+ReadRepeatedly(o, 5);
+assertFalse(%HasFastProperties(o));
+ReadRepeatedly(o, 5);
+assertTrue(%HasFastProperties(o));
+assertEquals(4, o.d);
+
+// Objects with many properties stay in dictionary mode.
+var big = { a: 1, b: 2 };
+for (var i = 0; i < 100; i++) big["p" + i] = i;
+delete big.p0;
+assertFalse(%HasFastProperties(big));
+ReadRepeatedly(big, 20);
+assertFalse(%HasFastProperties(big));
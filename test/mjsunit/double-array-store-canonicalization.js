@@ -0,0 +1,75 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Stores of double arithmetic results into double arrays skip NaN
+// canonicalization; check that NaNs and holes still behave.
+
+function kernel(dst, a, b) {
+  var sum = 0.5;
+  for (var i = 0; i < dst.length; i++) {
+    sum = sum * 0.5 + a[i] / b[i];
+    dst[i] = sum - a[i];
+  }
+  return sum;
+}
+
+function run() {
+  var dst = [0.5, 0.5, 0.5, 0.5];
+  var a = [1.5, 0, Infinity, 2.5];
+  var b = [2.5, 0, Infinity, 1.5];
+  kernel(dst, a, b);
+  return dst;
+}
+
+run();
+run();
+%OptimizeFunctionOnNextCall(kernel);
+var dst = run();
+assertEquals(0.5 * 0.5 + 1.5 / 2.5 - 1.5, dst[0]);
+assertTrue(isNaN(dst[1]));
+assertTrue(isNaN(dst[2]));
+assertTrue(isNaN(dst[3]));
+assertTrue(1 in dst);
+assertTrue(2 in dst);
+
+// Holes read from a holey double array must not be stored as holes.
+function add(dst, src) {
+  for (var i = 0; i < dst.length; i++) dst[i] = src[i] + 0.5;
+}
+
+var holey = [1.5, , 3.5];
+var packed = [0.5, 0.5, 0.5];
+add(packed, holey);
+add(packed, holey);
+%OptimizeFunctionOnNextCall(add);
+add(packed, holey);
+assertEquals(2, packed[0]);
+assertTrue(isNaN(packed[1]));
+assertTrue(1 in packed);
+assertEquals(4, packed[2]);
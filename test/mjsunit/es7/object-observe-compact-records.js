@@ -0,0 +1,77 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --harmony-observation
+
+// Records of objects with a single observer are queued compactly and
+// materialized on delivery; check that they keep their order relative to
+// other records and that they look like ordinary change records.
+
+var records;
+function callback(r) { records = r; }
+function other(r) {}
+
+var single = {};
+var shared = {};
+Object.observe(single, callback);
+Object.observe(shared, callback);
+Object.observe(shared, other);
+
+single.a = 1;
+shared.b = 2;
+single.a = 3;
+Object.getNotifier(single).notify({ type: 'custom', value: 4 });
+delete single.a;
+Object.deliverChangeRecords(callback);
+
+assertEquals(5, records.length);
+assertEquals('add', records[0].type);
+assertSame(single, records[0].object);
+assertEquals('a', records[0].name);
+assertFalse('oldValue' in records[0]);
+assertEquals('add', records[1].type);
+assertSame(shared, records[1].object);
+assertEquals('update', records[2].type);
+assertEquals(1, records[2].oldValue);
+assertEquals('custom', records[3].type);
+assertEquals(4, records[3].value);
+assertEquals('delete', records[4].type);
+assertEquals(3, records[4].oldValue);
+for (var i = 0; i < records.length; i++) {
+  assertTrue(Object.isFrozen(records[i]));
+}
+
+// Accept lists are still honored for compactly queued records.
+var filtered = {};
+records = undefined;
+Object.observe(filtered, callback, ['update']);
+filtered.x = 1;
+filtered.x = 2;
+Object.deliverChangeRecords(callback);
+assertEquals(1, records.length);
+assertEquals('update', records[0].type);
+assertEquals(1, records[0].oldValue);
@@ -0,0 +1,92 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --expose-gc
+
+// Tests that for-in key lists shared between objects whose prototypes
+// have enumerable properties follow changes to the prototype chain.
+
+function keys(x) {
+  var result = [];
+  for (var p in x) result.push(p);
+  return result.join(",");
+}
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+Point.prototype.norm = function() { return this.x * this.x + this.y * this.y; };
+
+var a = new Point(1, 2);
+var b = new Point(3, 4);
+assertEquals("x,y,norm", keys(a));
+assertEquals("x,y,norm", keys(b));
+assertEquals("x,y,norm", keys(a));
+
+// Adding to the prototype changes its map.
+Point.prototype.scale = function(f) { this.x *= f; this.y *= f; };
+assertEquals("x,y,norm,scale", keys(a));
+assertEquals("x,y,norm,scale", keys(b));
+
+// Making a prototype property non-enumerable.
+Object.defineProperty(Point.prototype, "norm", { enumerable: false });
+assertEquals("x,y,scale", keys(a));
+
+// Deleting a prototype property.
+delete Point.prototype.scale;
+assertEquals("x,y", keys(a));
+Point.prototype.scale = 1;
+assertEquals("x,y,scale", keys(b));
+
+// Elements on the receiver or the prototype do not change the map.
+var c = new Point(5, 6);
+assertEquals("x,y,scale", keys(c));
+c[0] = 0;
+assertEquals("0,x,y,scale", keys(c));
+Point.prototype[1] = 1;
+assertEquals("x,y,1,scale", keys(b));
+delete Point.prototype[1];
+assertEquals("x,y,scale", keys(b));
+
+// Changing the prototype of the receiver.
+var d = new Point(7, 8);
+assertEquals("x,y,scale", keys(d));
+d.__proto__ = { z: 0 };
+assertEquals("x,y,z", keys(d));
+
+// Properties of an object on the chain that change in place.
+var proto = { p: 0 };
+var e = Object.create(proto);
+e.q = 1;
+assertEquals("q,p", keys(e));
+gc();
+assertEquals("q,p", keys(e));
+proto.p = "changed";
+assertEquals("q,p", keys(e));
+proto.r = 2;
+assertEquals("q,p,r", keys(e));
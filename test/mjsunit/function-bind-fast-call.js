@@ -0,0 +1,94 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Bound functions call short argument lists directly.  Check that they
+// behave like the general path.
+
+function sloppyThis() { return this; }
+function strictThis() { "use strict"; return this; }
+function args() {
+  return Array.prototype.slice.call(arguments).join(",");
+}
+
+var o = {};
+assertSame(o, sloppyThis.bind(o)());
+assertSame(this, sloppyThis.bind(undefined)());
+assertSame(this, sloppyThis.bind(null)());
+assertSame(undefined, strictThis.bind(undefined)());
+assertSame(null, strictThis.bind(null)());
+assertSame(5, strictThis.bind(5)());
+
+// Primitive receivers of sloppy functions are wrapped on every call.
+var boundFive = sloppyThis.bind(5);
+assertEquals("object", typeof boundFive());
+assertEquals(5, boundFive().valueOf());
+assertFalse(boundFive() === boundFive());
+
+// Every combination of bound and call time arguments.
+for (var bound = 0; bound < 4; bound++) {
+  var bindArgs = [o];
+  for (var i = 0; i < bound; i++) bindArgs.push("b" + i);
+  var f = Function.prototype.bind.apply(args, bindArgs);
+  for (var argc = 0; argc < 5; argc++) {
+    var callArgs = [];
+    for (var j = 0; j < argc; j++) callArgs.push("a" + j);
+    var expected = bindArgs.slice(1).concat(callArgs).join(",");
+    assertEquals(expected, f.apply(null, callArgs));
+  }
+}
+
+// Binding a bound function.
+var twice = args.bind(o, 1).bind(null, 2);
+assertEquals("1,2", twice());
+assertEquals("1,2,3", twice(3));
+assertSame(o, sloppyThis.bind(o).bind(null)());
+
+// Construct calls are unaffected.
+function Point(x, y) { this.x = x; this.y = y; }
+var P = Point.bind(null, 1);
+var p = new P(2);
+assertTrue(p instanceof Point);
+assertEquals(1, p.x);
+assertEquals(2, p.y);
+
+// Builtin targets.
+assertEquals("a-b", Array.prototype.join.bind(["a", "b"])("-"));
+assertEquals(3, Math.max.bind(null, 1)(3, 2));
+
+// Calls from optimized code.
+var add = function(a, b) { return a + b; }.bind(null, 1);
+function callAdd(x) { return add(x); }
+callAdd(1);
+callAdd(2);
+%OptimizeFunctionOnNextCall(callAdd);
+assertEquals(4, callAdd(3));
+
+// Exceptions propagate.
+var thrower = function(x) { throw x; }.bind(null);
+assertThrows(function() { thrower(new Error("boom")); }, Error);
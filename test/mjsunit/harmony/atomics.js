@@ -0,0 +1,50 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-atomics
+
+var i32 = new Int32Array(4);
+assertEquals(0, Atomics.load(i32, 0));
+assertEquals(7, Atomics.store(i32, 0, 7));
+assertEquals(7, Atomics.load(i32, 0));
+assertEquals(7, i32[0]);
+
+// add returns the old value and wraps around on overflow.
+assertEquals(7, Atomics.add(i32, 0, 3));
+assertEquals(10, i32[0]);
+i32[1] = 0x7fffffff;
+assertEquals(0x7fffffff, Atomics.add(i32, 1, 1));
+assertEquals(-0x80000000, i32[1]);
+
+// compareExchange only stores when the expected value matches.
+assertEquals(10, Atomics.compareExchange(i32, 0, 5, 20));
+assertEquals(10, i32[0]);
+assertEquals(10, Atomics.compareExchange(i32, 0, 10, 20));
+assertEquals(20, i32[0]);
+
+// Values and indices are converted like typed array stores.
+assertEquals(-1, Atomics.store(i32, "2", 0xffffffff));
+assertEquals(-1, i32[2]);
+assertEquals(3, Atomics.store(i32, 3, { valueOf: function() { return 3.7; } }));
+assertEquals(3, i32[3]);
+
+var u32 = new Uint32Array(i32.buffer);
+assertEquals(0xffffffff, Atomics.load(u32, 2));
+assertEquals(0xffffffff, Atomics.add(u32, 2, 1));
+assertEquals(0, u32[2]);
+assertEquals(0xfffffffe, Atomics.store(u32, 2, -2));
+
+// Views with an offset address the right element.
+var view = new Int32Array(i32.buffer, 8, 2);
+assertEquals(-2, Atomics.load(view, 0));
+assertEquals(3, Atomics.load(view, 1));
+
+assertThrows(function() { Atomics.load(i32, 4); }, RangeError);
+assertThrows(function() { Atomics.load(i32, -1); }, RangeError);
+assertThrows(function() { Atomics.load(new Int16Array(4), 0); }, TypeError);
+assertThrows(function() { Atomics.load(new Float64Array(4), 0); }, TypeError);
+assertThrows(function() { Atomics.load([1, 2], 0); }, TypeError);
+
+assertTrue(Object.prototype.toString.call(Atomics) == "[object Atomics]");
+assertFalse(Object.keys(Atomics).length > 0);
@@ -506,3 +506,33 @@ for (var i = 9; i >= 0; i--) {
   assertEquals('minus', m.get(0));
   assertEquals('minus', m.get(-0));
 })();
+
+
+// Tables that see many deletions are compacted and shrunk without losing
+// any of the remaining entries.
+(function() {
+  var m = new Map;
+  var s = new Set;
+  for (var round = 0; round < 10; round++) {
+    for (var i = 0; i < 1000; i++) {
+      m.set(i, i + round);
+      s.add('k' + i);
+    }
+    for (var i = 0; i < 1000; i++) {
+      if (i % 10 != 0) {
+        assertTrue(m.delete(i));
+        assertTrue(s.delete('k' + i));
+      }
+    }
+    assertEquals(100, m.size);
+    assertEquals(100, s.size);
+  }
+  for (var i = 0; i < 1000; i++) {
+    assertEquals(i % 10 == 0, m.has(i));
+    assertEquals(i % 10 == 0 ? i + 9 : undefined, m.get(i));
+    assertEquals(i % 10 == 0, s.has('k' + i));
+  }
+  m.set(NaN, 'nan');
+  assertEquals('nan', m.get(NaN));
+  assertEquals(101, m.size);
+})();
@@ -648,3 +648,20 @@ function TestRecursion() {
   assertThrows(TestThrowRecursion, Error);
 }
 TestRecursion();
+
+function TestSavedOperandsSurviveGC() {
+  function* g(o) {
+    return [o.a, o.b, (yield o.a) + (yield o.b), o.a + (yield 0)];
+  }
+  var iter = g({ a: "a", b: "b" });
+  assertEquals("a", iter.next().value);
+  gc();
+  assertEquals("b", iter.next("x").value);
+  gc();
+  assertEquals(0, iter.next("y").value);
+  gc();
+  var result = iter.next("z");
+  assertTrue(result.done);
+  assertEquals(["a", "b", "xy", "az"], result.value);
+}
+TestSavedOperandsSurviveGC();
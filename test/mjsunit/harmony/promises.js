@@ -788,4 +788,47 @@ function assertAsyncDone(iteration) {
 })();
 
 
+(function() {
+  var p1 = Promise.resolve(1)
+  var p2 = p1.chain(function(x) { throw x + 1 })
+  p2.chain(
+    assertUnreachable,
+    function(r) { assertAsync(r === 2, "chain/throw") }
+  )
+  assertAsyncRan()
+})();
+
+(function() {
+  var p1 = Promise.resolve(1)
+  var p2 = p1.chain(5)
+  p2.chain(
+    assertUnreachable,
+    function(r) { assertAsync(r instanceof TypeError, "chain/non-function") }
+  )
+  assertAsyncRan()
+})();
+
+(function() {
+  var p1 = Promise.resolve(1)
+  var p2 = p1.chain(function(x) { return p2 })
+  p2.chain(
+    assertUnreachable,
+    function(r) { assertAsync(r instanceof TypeError, "chain/cyclic") }
+  )
+  assertAsyncRan()
+})();
+
+(function() {
+  var d = Promise.defer()
+  var count = 0
+  for (var i = 0; i < 20; i++) {
+    d.promise.chain(function(x) {
+      if (++count === 20) assertAsync(x === 7, "chain/many-handlers")
+    })
+  }
+  d.resolve(7)
+  assertAsyncRan()
+})();
+
+
 assertAsyncDone()
@@ -0,0 +1,76 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --harmony-proxies
+
+// Traps are looked up on the handler anew for every operation, whether
+// they are constant functions in the handler's map, plain fields or
+// inherited from the handler's prototype.
+
+function TestTrapReplacement(handler) {
+  var p = Proxy.create(handler);
+  for (var i = 0; i < 3; i++) assertEquals("first:x", p.x);
+  handler.get = function(receiver, name) { return "second:" + name };
+  for (var i = 0; i < 3; i++) assertEquals("second:y", p.y);
+  delete handler.get;
+  handler.getPropertyDescriptor = function(name) {
+    return { value: "derived:" + name, configurable: true };
+  };
+  assertEquals("derived:z", p.z);
+}
+
+TestTrapReplacement({
+  get: function(receiver, name) { return "first:" + name }
+});
+
+var fieldHandler = {};
+fieldHandler.get = 0;
+fieldHandler.get = function(receiver, name) { return "first:" + name };
+TestTrapReplacement(fieldHandler);
+
+function Handler() {}
+Handler.prototype.get = function(receiver, name) { return "first:" + name };
+var inherited = new Handler();
+var p = Proxy.create(inherited);
+assertEquals("first:a", p.a);
+Handler.prototype.get = function(receiver, name) { return "second:" + name };
+assertEquals("second:b", p.b);
+inherited.get = function(receiver, name) { return "own:" + name };
+assertEquals("own:c", p.c);
+
+// Traps for has, set and delete go through the same lookup.
+var log = [];
+var p = Proxy.create({
+  has: function(name) { log.push("has " + name); return true },
+  set: function(receiver, name, value) { log.push("set " + name); return true },
+  delete: function(name) { log.push("delete " + name); return true },
+  getPropertyDescriptor: function(name) { return undefined }
+});
+assertTrue("u" in p);
+p.v = 1;
+delete p.w;
+assertEquals(["has u", "set v", "delete w"], log);
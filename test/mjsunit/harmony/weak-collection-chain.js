@@ -0,0 +1,72 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --harmony-collections --expose-gc
+
+// Tests that values reachable only through chains of weak map entries are
+// kept alive, whichever order the weak maps are encountered in.
+
+var kLength = 200;
+
+function MakeChain(reverse) {
+  var maps = [];
+  var keys = [];
+  for (var i = 0; i <= kLength; i++) {
+    maps.push(new WeakMap());
+    keys.push({ index: i });
+  }
+  // Map i maps key i to key i + 1, and is reachable from key i.
+  for (var i = 0; i < kLength; i++) {
+    var m = maps[reverse ? kLength - i : i];
+    m.set(keys[i], keys[i + 1]);
+    keys[i].map = m;
+  }
+  maps = null;
+  return keys[0];
+}
+
+function CheckChain(head) {
+  var current = head;
+  for (var i = 0; i < kLength; i++) {
+    assertEquals(i, current.index);
+    current = current.map.get(current);
+    assertTrue(current !== undefined);
+  }
+  assertEquals(kLength, current.index);
+}
+
+var forward = MakeChain(false);
+var backward = MakeChain(true);
+gc();
+gc();
+CheckChain(forward);
+CheckChain(backward);
+
+// Dropping the head makes the whole chain unreachable.
+forward = null;
+gc();
+CheckChain(backward);
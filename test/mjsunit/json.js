@@ -482,3 +482,41 @@ assertTrue(Object.prototype.isPrototypeOf(o2));
 
 var json = '{"stuff before slash\\\\stuff after slash":"whatever"}';
 TestStringify(json, JSON.parse(json));
+
+// String values of every length around the word size, with special
+// characters at every position.
+for (var length = 0; length < 20; length++) {
+  var plain = "";
+  for (var i = 0; i < length; i++) plain += String.fromCharCode(97 + i);
+  assertEquals(plain, JSON.parse('"' + plain + '"'));
+  assertEquals(plain + "\xe9", JSON.parse('"' + plain + '\xe9"'));
+  for (var i = 0; i <= length; i++) {
+    var before = plain.substring(0, i);
+    var after = plain.substring(i);
+    assertEquals(before + "\n" + after,
+                 JSON.parse('"' + before + '\\n' + after + '"'));
+    assertThrows(function() { JSON.parse('"' + before + '\n' + after + '"'); },
+                 SyntaxError);
+  }
+  assertThrows(function() { JSON.parse('"' + plain); }, SyntaxError);
+}
+
+// Quoting strings of every length around the word size, with characters
+// that need escaping at every position, for one-byte and two-byte strings.
+for (var length = 0; length < 20; length++) {
+  var plain = "";
+  for (var i = 0; i < length; i++) plain += String.fromCharCode(97 + i);
+  var wide = plain + "\u20ac";
+  assertEquals('"' + plain + '"', JSON.stringify(plain));
+  assertEquals('"' + wide + '"', JSON.stringify(wide));
+  assertEquals('["' + plain + '\xe9\x7f !"]',
+               JSON.stringify([plain + '\xe9\x7f !']));
+  for (var i = 0; i <= length; i++) {
+    var before = plain.substring(0, i);
+    var after = plain.substring(i);
+    assertEquals('"' + before + '\\"\\\\\\u001f' + after + '"',
+                 JSON.stringify(before + '"\\\x1f' + after));
+    assertEquals('["' + before + '\\n\u20ac' + after + '"]',
+                 JSON.stringify([before + '\n\u20ac' + after]));
+  }
+}
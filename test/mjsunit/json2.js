@@ -183,3 +183,15 @@ try {
   externalizeString(str, true);
 } catch (e) { }
 TestStringify("\"external\"", str, null, 0);
+
+// Documents of the same shape share a map, also when the first key is
+// one of several transitions from the initial object map.
+var shape_a = JSON.parse('{"route_a":1,"x":2}');
+var shape_b = JSON.parse('{"route_b":1,"x":2}');
+var shape_a2 = JSON.parse('{"route_a":3,"x":4}');
+var shape_b2 = JSON.parse('{"route_b":3,"x":4}');
+assertTrue(%HaveSameMap(shape_a, shape_a2));
+assertTrue(%HaveSameMap(shape_b, shape_b2));
+assertFalse(%HaveSameMap(shape_a, shape_b));
+assertEquals(3, shape_b2.route_b);
+assertEquals(4, shape_a2.x);
@@ -0,0 +1,96 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --lazy-inner-functions --allow-natives-syntax
+
+// Inner functions of lazily compiled functions are preparsed, so the
+// variables they refer to must be context allocated all the same.
+
+function counter() {
+  var count = 0;
+  function increment() { return ++count; }
+  return { inc: increment, get: function() { return count; } };
+}
+
+var c = counter();
+assertEquals(1, c.inc());
+assertEquals(2, c.inc());
+assertEquals(2, c.get());
+
+
+function nested(a) {
+  var b = a + 1;
+  return function(c) {
+    return function() { return a + b + c; };
+  };
+}
+
+assertEquals(6, nested(1)(3)());
+assertEquals(15, nested(5)(4)());
+
+
+function shadowed(x) {
+  var y = 10;
+  return function(y) { return x + y; };
+}
+
+assertEquals(3, shadowed(1)(2));
+
+
+function withEval(x) {
+  var hidden = 42;
+  return function(code) { return eval(code); };
+}
+
+assertEquals(42, withEval(1)("hidden"));
+assertEquals(1, withEval(1)("x"));
+
+
+function namedExpression() {
+  var n = 3;
+  return function fact(k) { return k <= 1 ? n - 2 : k * fact(k - 1); };
+}
+
+assertEquals(120, namedExpression()(5));
+
+
+function inCatch() {
+  try {
+    throw 7;
+  } catch (e) {
+    return function() { return e; };
+  }
+}
+
+assertEquals(7, inCatch()());
+
+
+function escapedName() {
+  var café = "latte";
+  return function() { return café; };
+}
+
+assertEquals("latte", escapedName()());
+
+
+// Optimized code must agree with the full code on the context layout.
+function optimized(v) {
+  var captured = v;
+  var local = v * 2;
+  function get() { return captured; }
+  return local + get();
+}
+
+assertEquals(3, optimized(1));
+assertEquals(6, optimized(2));
+%OptimizeFunctionOnNextCall(optimized);
+assertEquals(9, optimized(3));
+
+
+// Early errors in skipped functions are still reported.
+function earlyError() {
+  function inner() { "use strict"; var eval = 1; }
+}
+
+assertThrows(earlyError, SyntaxError);
@@ -0,0 +1,66 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test loads of constant own properties through handlers that are shared
+// between maps that keep the constant at the same descriptor index.
+
+function f1() { return 1; }
+function f2() { return 2; }
+function f3() { return 3; }
+
+function make(f) {
+  var o = {};
+  o.m = f;
+  return o;
+}
+
+function load(o) { return o.m; }
+function keyed_load(o, key) { return o[key]; }
+
+var a = make(f1);
+var b = make(f2);
+var c = { x: 0 };
+c.m = f3;
+
+for (var i = 0; i < 5; i++) {
+  assertEquals(f1, load(a));
+  assertEquals(f2, load(b));
+  assertEquals(f3, load(c));
+  assertEquals(f1, keyed_load(a, "m"));
+  assertEquals(f2, keyed_load(b, "m"));
+  assertEquals(f3, keyed_load(c, "m"));
+}
+
+// Redefining the property must not be seen through the old handler.
+b.m = f3;
+a.m = 42;
+for (var i = 0; i < 5; i++) {
+  assertEquals(42, load(a));
+  assertEquals(f3, load(b));
+  assertEquals(42, keyed_load(a, "m"));
+  assertEquals(f3, keyed_load(b, "m"));
+}
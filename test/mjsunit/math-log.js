@@ -0,0 +1,78 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax
+
+// Tests the optimized code for Math.log() against the C library.
+
+function log(x) {
+  return Math.log(x);
+}
+
+var cases = [
+  [0.5, -0.69314718055994529],
+  [0.70710678118654757, -0.34657359027997259],
+  [1.4142135623730951, 0.3465735902799727],
+  [1.0000001000000001, 9.9999995058387044e-08],
+  [0.99999990000000005, -1.0000000494736474e-07],
+  [3, 1.0986122886681098],
+  [10, 2.3025850929940459],
+  [123456.789, 11.723646487185881],
+  [0.10000000000000001, -2.3025850929940455],
+  [1e-300, -690.77552789821368],
+  [1e300, 690.77552789821368],
+  [1.7976931348623157e+308, 709.78271289338397],
+  // Subnormals.
+  [4.9406564584124654e-324, -744.44007192138122],
+  [2.2250738585072014e-308, -708.39641853226408],
+];
+
+function test() {
+  for (var i = 0; i < cases.length; i++) {
+    var x = cases[i][0];
+    var expected = cases[i][1];
+    var actual = log(x);
+    assertTrue(Math.abs(actual - expected) <= Math.abs(expected) * 2.3e-16,
+               "log(" + x + ") = " + actual + ", expected " + expected);
+  }
+  assertEquals(0, log(1));
+  assertEquals(1, log(Math.E));
+  assertEquals(-Infinity, log(0));
+  assertEquals(-Infinity, log(-0));
+  assertEquals(Infinity, log(Infinity));
+  assertEquals(NaN, log(-1));
+  assertEquals(NaN, log(-Infinity));
+  assertEquals(NaN, log(NaN));
+  assertEquals(NaN, log(-Number.MIN_VALUE));
+}
+
+test();
+test();
+%OptimizeFunctionOnNextCall(log);
+test();
+%OptimizeFunctionOnNextCall(test);
+test();
@@ -0,0 +1,67 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --allow-natives-syntax --literal-slack-tracking
+
+// Check that literal sites created after instances of a cached literal map
+// have grown out-of-object get a map with in-object slack, and that such
+// boilerplates are cloned correctly.
+
+function makeFirst() { return { slack_a: "a", slack_b: "b" }; }
+function makeSecond() { return { slack_a: "c", slack_b: "d" }; }
+
+function grow(o) {
+  o.slack_c = 1;
+  o.slack_d = 2;
+  o.slack_e = 3;
+  o.slack_f = 4;
+  return o;
+}
+
+var first = makeFirst();
+var second = makeSecond();
+assertTrue(%HaveSameMap(first, second));
+
+// Push instances of the shared map past their in-object capacity.
+for (var i = 0; i < 3; i++) grow(makeFirst());
+
+function makeThird() { return { slack_a: "e", slack_b: "f" }; }
+var third = makeThird();
+assertFalse(%HaveSameMap(second, third));
+
+for (var i = 0; i < 3; i++) {
+  var o = grow(makeThird());
+  assertEquals("e", o.slack_a);
+  assertEquals("f", o.slack_b);
+  assertEquals(1, o.slack_c);
+  assertEquals(4, o.slack_f);
+  assertTrue(%HasFastProperties(o));
+}
+
+// Later literal sites share the refined map.
+function makeFourth() { return { slack_a: "g", slack_b: "h" }; }
+assertTrue(%HaveSameMap(third, makeFourth()));
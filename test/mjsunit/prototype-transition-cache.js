@@ -0,0 +1,69 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --expose-gc
+
+// Tests that changing the prototype of objects sharing a map behaves the
+// same once more prototypes were used than the prototype transitions cache
+// holds, and after the GC shrinks the cache.
+
+function Make() {
+  return { a: 1 };
+}
+
+var kPrototypes = 600;
+var prototypes = [];
+for (var i = 0; i < kPrototypes; i++) {
+  prototypes.push({ index: i });
+}
+
+function Check() {
+  for (var i = 0; i < kPrototypes; i++) {
+    var o = Make();
+    o.__proto__ = prototypes[i];
+    assertSame(prototypes[i], Object.getPrototypeOf(o));
+    assertEquals(i, o.index);
+    assertEquals(1, o.a);
+    // Objects with the same prototype share their map again.
+    var p = Make();
+    p.__proto__ = prototypes[i];
+    assertEquals(i, p.index);
+  }
+}
+
+Check();
+Check();
+
+// Drop most prototypes, so that their entries are cleared and the cache
+// shrinks.
+prototypes.length = 10;
+kPrototypes = 10;
+gc();
+Check();
+prototypes.push({ index: 10 });
+kPrototypes = 11;
+Check();
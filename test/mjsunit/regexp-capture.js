@@ -58,3 +58,19 @@ assertEquals(["bbaa", "a", "", "a"],
 
 // From crbug.com/128821 - don't hang:
 "".match(/((a|i|A|I|u|o|U|O)(s|c|b|c|d|f|g|h|j|k|l|m|n|p|q|r|s|t|v|w|x|y|z|B|C|D|F|G|H|J|K|L|M|N|P|Q|R|S|T|V|W|X|Y|Z)*) de\/da([.,!?\s]|$)/);
+
+// Captures spanning the whole match and empty captures.
+for (var i = 0; i < 3; i++) {
+  assertEquals(["abc", "abc", "b", ""], /((?:a(b)c))()/.exec("xabcx"));
+  var m = /(\w+)(\s*)(\w*)/.exec("hello world");
+  assertEquals(["hello world", "hello", " ", "world"], m);
+  m = /(\w+)(\s*)(\w*)/.exec("hello");
+  assertEquals(["hello", "hello", "", ""], m);
+  assertEquals("", m[2]);
+  assertEquals(0, m[3].length);
+  assertEquals(["aaa", "aaa", "aaa"], /((a+))/.exec("baaab"));
+  assertEquals(["x", "x"], "x".match(/(x)/));
+}
+var seen = [];
+"ab ab".replace(/(ab)()/g, function(m, c1, c2) { seen.push(m, c1, c2); });
+assertEquals(["ab", "ab", "", "ab", "ab", ""], seen);
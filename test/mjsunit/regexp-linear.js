@@ -0,0 +1,71 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Flags: --regexp-linear
+
+// The linear-time matcher must produce the same matches and captures as
+// the backtracking engine.
+function check(expected, re, subject) {
+  assertEquals(expected, re.exec(subject), re + " on " + subject);
+}
+
+check(["abcd", "a", "bcd", ""], /(a|ab)(c|bcd)(d*)/, "abcd");
+check(["aaab"], /a+?b/, "xaaab");
+check(["aaab", "aaa"], /(a*)*b/, "aaab");
+check(["", ""], /(a*)+/, "b");
+check(["ab", undefined], /(?:(a)|b)+/, "ab");
+check(["b", undefined], /(a)|b/, "b");
+check(["xxx"], /x{2,3}y?/, "xxxxy");
+check(["xx"], /x{2,3}?/, "xxxx");
+check(["abc"], /^abc$/m, "x\nabc\ny");
+check(null, /^abc$/, "x\nabc\ny");
+check(["foo"], /\bfoo\B/, "a foobar");
+check(["def"], /[^a-c]+/, "abcdefabc");
+check(["ABca"], /[a-c]+/i, "xxABcaD");
+check(["\u0100\u0101"], /\u0101+/i, "\u0100\u0101!");
+check(["12-", "12", undefined], /(\d+)-(\d+)?/, "tel 12-");
+check(["ab"], /.*/, "ab\ncd");
+check([""], /$/, "abc");
+check(["aa", "a"], /(|a)*/, "aa");
+check(["ab", "a"], /(a?)??b/, "ab");
+
+assertEquals(["1", "22", "333"], "a1b22c333".match(/\d+/g));
+assertEquals("[a][b]", "aXbX".replace(/(.)X/g, "[$1]"));
+var global = /a/g;
+global.lastIndex = 2;
+assertEquals(2, global.exec("aaaa").index);
+assertEquals(3, global.lastIndex);
+
+// Patterns that backtrack exponentially complete quickly.
+var subject = "";
+for (var i = 0; i < 40; i++) subject += "a";
+assertEquals(null, /(a*)*b/.exec(subject));
+assertEquals(null, /(a|aa)+$/.exec(subject + "!"));
+
+// Back references and lookaheads are still supported through irregexp.
+check(["abab", "ab"], /(ab)\1/, "xabab");
+check(["a"], /a(?=b)/, "ab");
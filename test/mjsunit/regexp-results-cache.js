@@ -75,3 +75,23 @@ assertEquals("Friends,", words[0]);
 words[0] = "Enemies,";
 words = string.split(" ");
 assertEquals("Friends,", words[0]);
+
+// Replacing with a string restores the last match info on cache hits.
+var re = /(B)rutus/g;
+var with_string = string.replace(re, "$1.");
+for (var i = 0; i < 3; i++) {
+  "x".match(/x/);
+  assertEquals(with_string, string.replace(re, "$1."));
+  assertEquals("Brutus", RegExp.lastMatch);
+  assertEquals("B", RegExp.$1);
+}
+// The replacement string is part of the key.
+assertEquals(string.replace(re, "$1!"), string.replace(re, "$1!"));
+assertFalse(with_string == string.replace(re, "$1!"));
+
+// Subjects that are not internalized are cached by content.
+var copy = (string + " ").slice(0, -1);
+words = copy.split(" ");
+words[0] = "Enemies,";
+assertEquals("Friends,", (string + " ").slice(0, -1).split(" ")[0]);
+assertEquals(string.split(" "), copy.split(" "));
@@ -0,0 +1,54 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Test the skip loops in front of patterns with few possible characters
+// around the boundaries of the blocks scanned at a time.
+
+function filler(n) {
+  var s = "";
+  for (var i = 0; i < n; i++) s += String.fromCharCode(97 + i % 20);
+  return s;
+}
+
+for (var prefix = 0; prefix < 40; prefix++) {
+  for (var suffix = 0; suffix < 20; suffix++) {
+    var before = filler(prefix);
+    var after = filler(suffix);
+    var subject = before + "XYZW" + after;
+    assertEquals(prefix, subject.search(/XYZW/));
+    assertEquals(prefix, subject.search(/[XQ]YZW/));
+    assertEquals(prefix + 1, subject.search(/YZW/));
+    // Masked characters with the same low bits must not match.
+    assertEquals(-1, (before + "\u00d8YZW" + after).search(/XYZW/));
+    assertEquals(-1, (before + "XYZ" + after).search(/XYZW/));
+    assertEquals(prefix, (before + "\u0158YZW").search(/\u0158YZW/));
+    var matches = (subject + subject).match(/XYZW/g);
+    assertEquals(2, matches.length);
+  }
+}
+assertEquals(-1, "".search(/XYZW/));
+assertEquals(-1, "XYZ".search(/XYZW/));
@@ -83,3 +83,32 @@ for (var i = 1; i <= 128; i <<= 1); {
     }
   }
 }
+
+// Strings that already are in the requested case are returned as they are,
+// also when a character to convert or a non-ASCII character only comes
+// after a long unchanged prefix.
+for (var length = 0; length < 24; length++) {
+  var lower = "";
+  for (var i = 0; i < length; i++) lower += String.fromCharCode(97 + i);
+  var upper = lower.toUpperCase();
+  assertEquals(lower, lower.toLowerCase());
+  assertEquals(upper, upper.toUpperCase());
+  assertEquals(lower + "x", (lower + "X").toLowerCase());
+  assertEquals(upper + "X", (upper + "x").toUpperCase());
+  assertEquals(lower + "\xe0", (lower + "\xc0").toLowerCase());
+  assertEquals(upper + "\xc0", (upper + "\xe0").toUpperCase());
+  assertEquals(upper + "SS", (upper + "\xdf").toUpperCase());
+}
+
+// Trimming one-byte strings agrees with trimming two-byte strings.
+for (var c = 0; c < 256; c++) {
+  var ch = String.fromCharCode(c);
+  var expected = (ch + "x\u1234" + ch).trim();
+  assertEquals(expected.length - 1, (ch + "x" + ch).trim().length);
+  assertEquals((ch + "x\u1234").trimLeft().length - 1,
+               (ch + "x").trimLeft().length);
+  assertEquals(("\u1234x" + ch).trimRight().length - 1,
+               ("x" + ch).trimRight().length);
+}
+assertEquals("", " \t\n\xa0 ".trim());
+assertEquals("a b", "a b".trim());
@@ -94,6 +94,16 @@ for (var i = 0; i < 10; i++) {
   test();
 }
 
+// Joining one-byte strings that are not sequential, such as cons strings,
+// yields a one-byte string.
+var parts = [];
+for (var i = 0; i < 10; i++) parts.push("abcdefghijklmnop" + i);
+var joined = parts.join("-");
+assertTrue(isAsciiString(joined));
+assertEquals(parts.join("-"), joined);
+parts.push("\u1234");
+assertFalse(isAsciiString(parts.join("-")));
+
 // Clean up string to make Valgrind happy.
 gc();
 gc();
@@ -123,3 +123,32 @@ for (var lengthIndex = 0; lengthIndex < lengths.length; lengthIndex++) {
     assertEquals(index, allCharsString.indexOf(pattern));
   }
 }
+
+// Short patterns whose first and last characters are frequent, at every
+// position around the word size, in one-byte and two-byte subjects.
+function naiveIndexOf(subject, pattern, start) {
+  for (var i = start; i + pattern.length <= subject.length; i++) {
+    if (subject.substring(i, i + pattern.length) == pattern) return i;
+  }
+  return -1;
+}
+
+var fillers = ["a", "\u20ac"];
+var patterns = ["b", "ab", "aba", "abca", "\u20acb", "a\u20aca"];
+for (var f = 0; f < fillers.length; f++) {
+  for (var p = 0; p < patterns.length; p++) {
+    var pattern = patterns[p];
+    for (var length = 0; length < 20; length++) {
+      var filler = "";
+      for (var i = 0; i < length; i++) filler += fillers[f];
+      for (var i = 0; i <= length; i++) {
+        var subject = filler.substring(0, i) + pattern + filler.substring(i);
+        for (var start = 0; start <= subject.length; start++) {
+          assertEquals(naiveIndexOf(subject, pattern, start),
+                       subject.indexOf(pattern, start));
+        }
+        assertEquals(-1, subject.indexOf(pattern + "b"));
+      }
+    }
+  }
+}
@@ -0,0 +1,70 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Searches from the start of a cons string read its leaves in place.
+// Check matches within leaves, straddling one or several leaves, and in
+// leaves of either encoding.
+
+function naiveIndexOf(subject, pattern, start) {
+  for (var i = start; i + pattern.length <= subject.length; i++) {
+    if (subject.substring(i, i + pattern.length) == pattern) return i;
+  }
+  return -1;
+}
+
+function makeRope(pieces) {
+  var rope = "";
+  for (var i = 0; i < pieces.length; i++) rope += pieces[i];
+  return rope;
+}
+
+var pieces = ["abcdefghijklmnop", "qrstuvwxyz012345", "\u20acbcdefghijklmnop",
+              "6789ABCDEFGHIJKL", "ab", "MNOPQRSTUVWXYZ!?", "cdefghijklmnopqr"];
+var flat = pieces.join("");
+var patterns = ["a", "p", "pq", "opqrs", "5\u20acb", "z012345\u20acbcdefghij",
+                "L", "LabM", "Labcd", "abcdefghijklmnopqrstuvwxyz", "xx",
+                "\u20ac", "?cdefghijklmnopqr", "r",
+                "opqrstuvwxyz012345\u20acb"];
+for (var i = 0; i < patterns.length; i++) {
+  var pattern = patterns[i];
+  assertEquals(naiveIndexOf(flat, pattern, 0),
+               makeRope(pieces).indexOf(pattern), pattern);
+  assertEquals(naiveIndexOf(flat, pattern, 3),
+               makeRope(pieces).indexOf(pattern, 3), pattern);
+}
+
+// One-byte ropes with a two-byte pattern.
+var ascii = makeRope(["abcdefghijklmnopqrstuvwxyz", "0123456789abcdefghijkl"]);
+assertEquals(-1, ascii.indexOf("k\u20ac"));
+assertEquals(26, ascii.indexOf("0123"));
+
+// Comparing ropes.
+assertTrue(makeRope(pieces) == makeRope(pieces));
+assertTrue(makeRope(pieces) == flat);
+pieces[3] = "6789ABCDEFGHIJKM";
+assertFalse(makeRope(pieces) == flat);
@@ -0,0 +1,63 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Tests String.prototype.replace with a string pattern and a replacement
+// string without $-expressions.
+
+assertEquals("xbc", "abc".replace("a", "x"));
+assertEquals("axc", "abc".replace("b", "x"));
+assertEquals("abx", "abc".replace("c", "x"));
+assertEquals("a-b-c", "a,b-c".replace(",", "-"));
+assertEquals("abc", "abc".replace("d", "x"));
+assertEquals("abc", "abc".replace("abcd", "x"));
+assertEquals("xabc", "abc".replace("", "x"));
+assertEquals("", "abc".replace("abc", ""));
+assertEquals("ac", "abc".replace("b", ""));
+assertEquals("ሴyz", "ሴ噸z".replace("噸", "y"));
+assertEquals("foo bar", "foofoo bar".replace("foo", ""));
+
+// Only the first occurrence is replaced.
+assertEquals("a.b,c", "a,b,c".replace(",", "."));
+
+// Non-string replacements are converted.
+assertEquals("a1c", "abc".replace("b", 1));
+assertEquals("anullc", "abc".replace("b", null));
+
+// $-expressions still work.
+assertEquals("a[b]c", "abc".replace("b", "[$&]"));
+assertEquals("a$c", "abc".replace("b", "$$"));
+
+// Long subjects, where the surrounding parts become sliced strings, and
+// subjects that are cons strings.
+var long = "";
+for (var i = 0; i < 100; i++) long += "0123456789";
+var replaced = long.replace("5678", "-");
+assertEquals(long.length - 3, replaced.length);
+assertEquals("01234-9", replaced.substring(0, 7));
+assertEquals(long.substring(9), replaced.substring(6));
+var cons = long + "needle" + long;
+assertEquals(long + "pin" + long, cons.replace("needle", "pin"));
@@ -164,3 +164,31 @@ separator = { toString: function() { assertEquals(1, counter);
 
 assertEquals(["a", "c"], String.prototype.split.call(subject, separator));
 assertEquals(2, counter);
+
+// Regexp separators with captures, limits and empty matches.
+assertEquals(["a", ",", "b", undefined, "c"], "a,b;c".split(/(,)|;/));
+assertEquals(["a", ","], "a,b;c".split(/(,)|;/, 2));
+assertEquals(["a", "x", "b"], "axxb".split(/(x)x/, 3));
+assertEquals(["a", "b", "c"], "abc".split(/x*/));
+assertEquals(["abc"], "abc".split(/$/));
+assertEquals(["abc"], "abc".split(/^/));
+assertEquals(["a", "b", "c"], "a\nb\nc".split(/^/m).map(function(s) {
+  return s.trim();
+}));
+assertEquals(["", "", "", "", ""], "abab".split(/a|b/));
+var long_subject = new Array(1000).join("a,") + "a";
+var parts = long_subject.split(/,/);
+assertEquals(1000, parts.length);
+assertEquals("a", parts[999]);
+assertEquals(10, long_subject.split(/(,)/, 10).length);
+
+// The last match info reflects the last match found by the split.
+"x1y2z".split(/(\d)/);
+assertEquals("2", RegExp.lastMatch);
+assertEquals("2", RegExp.$1);
+"abc".split(/^/);
+assertEquals("", RegExp.lastMatch);
+assertEquals("abc", RegExp.input);
+"q1".split(/(\d)/);
+"zzz".split(/(\d)/);
+assertEquals("1", RegExp.$1);
@@ -0,0 +1,109 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Check that the native conversions used by the typed array constructors
+// and by set() agree with storing the elements one by one.
+
+var constructors = [Uint8Array, Int8Array, Uint16Array, Int16Array,
+                    Uint32Array, Int32Array, Float32Array, Float64Array,
+                    Uint8ClampedArray];
+
+var values = [0, 1, -1, 127, 128, 255, 256, -129, 32767, 32768, 65535,
+              65536, 2147483647, 2147483648, 4294967295, 4294967296, -0.5,
+              0.5, 1.5, 2.5, 254.5, 255.5, -1e10, 1e10, 1.1, NaN, Infinity,
+              -Infinity];
+
+function CopyByElement(constructor, source) {
+  var result = new constructor(source.length);
+  for (var i = 0; i < source.length; i++) result[i] = source[i];
+  return result;
+}
+
+function AssertSameElements(expected, actual) {
+  assertEquals(expected.length, actual.length);
+  for (var i = 0; i < expected.length; i++) {
+    assertEquals(expected[i], actual[i], "index " + i);
+  }
+}
+
+// From JS arrays of smis, doubles and mixed numbers.
+constructors.forEach(function(constructor) {
+  var smis = [0, 1, -1, 255, 256, -129];
+  AssertSameElements(CopyByElement(constructor, smis), new constructor(smis));
+  AssertSameElements(CopyByElement(constructor, values),
+                     new constructor(values));
+  var target = new constructor(values.length + 2);
+  target.set(values, 2);
+  AssertSameElements(CopyByElement(constructor, values), target.subarray(2));
+});
+
+// Between every pair of typed array types.
+constructors.forEach(function(source_constructor) {
+  var source = new source_constructor(values);
+  constructors.forEach(function(target_constructor) {
+    var expected = CopyByElement(target_constructor, source);
+    AssertSameElements(expected, new target_constructor(source));
+    var target = new target_constructor(source.length);
+    target.set(source);
+    AssertSameElements(expected, target);
+  });
+});
+
+// Overlapping arrays of different types over the same buffer.
+(function() {
+  var buffer = new ArrayBuffer(16);
+  var bytes = new Uint8Array(buffer);
+  for (var i = 0; i < 16; i++) bytes[i] = i + 1;
+  var words = new Uint16Array(buffer, 0, 4);
+  var expected = CopyByElement(Uint8Array, bytes.subarray(0, 8));
+  words.set(new Uint8Array(buffer, 0, 4));
+  AssertSameElements([1, 2, 3, 4], words);
+  var wide = new Int32Array(buffer, 4, 2);
+  var narrow = new Int8Array(buffer, 2, 2);
+  var narrow_values = [narrow[0], narrow[1]];
+  wide.set(narrow);
+  AssertSameElements(narrow_values, wide);
+})();
+
+// Holes and non-numbers still go through the generic path.
+(function() {
+  var holey = [1, , 3];
+  var result = new Float64Array(holey);
+  assertEquals(1, result[0]);
+  assertTrue(isNaN(result[1]));
+  assertEquals(3, result[2]);
+
+  var calls = 0;
+  var object = { valueOf: function() { calls++; return 7; } };
+  var target = new Int8Array(3);
+  target.set([1, object, 3]);
+  AssertSameElements([1, 7, 3], target);
+  assertEquals(1, calls);
+
+  assertThrows(function() { new Int8Array(2).set([1, 2, 3]); }, RangeError);
+  assertThrows(function() { new Int8Array(2).set([1, 2], 1); }, RangeError);
+})();
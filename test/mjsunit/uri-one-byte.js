@@ -0,0 +1,73 @@
+// Copyright 2014 the V8 project authors. All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+//       copyright notice, this list of conditions and the following
+//       disclaimer in the documentation and/or other materials provided
+//       with the distribution.
+//     * Neither the name of Google Inc. nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Tests the native one-byte paths of the URI functions and the cases that
+// fall back to the general implementation.
+
+// Nothing to do.
+assertEquals("abc-DEF_0.9~!*'()", encodeURIComponent("abc-DEF_0.9~!*'()"));
+assertEquals("a/b?c=d#e", encodeURI("a/b?c=d#e"));
+assertEquals("plain", decodeURIComponent("plain"));
+assertEquals("plain", decodeURI("plain"));
+
+// Escaping after an unescaped prefix.
+assertEquals("a%2Fb%3Fc%3Dd%23e", encodeURIComponent("a/b?c=d#e"));
+assertEquals("a%20b%25c", encodeURI("a b%c"));
+assertEquals("%00%0A%7F", encodeURIComponent("\u0000\n\u007f"));
+
+// Latin-1 characters become two UTF-8 octets.
+assertEquals("caf%C3%A9%20%C3%BF", encodeURIComponent("caf\u00e9 \u00ff"));
+assertEquals("%C2%80", encodeURI("\u0080"));
+
+// Decoding keeps reserved characters escaped only for decodeURI.
+assertEquals("a/b c", decodeURIComponent("a%2fb%20c"));
+assertEquals("a%2fb c", decodeURI("a%2fb%20c"));
+assertEquals("%3B%40 x", decodeURI("%3B%40%20x"));
+assertEquals("caf\u00e9!", decodeURIComponent("caf\u00e9%21"));
+
+// Multi-octet sequences and two-byte strings use the general path.
+assertEquals("caf\u00e9", decodeURIComponent("caf%C3%A9"));
+assertEquals("\u20ac", decodeURIComponent("%E2%82%AC"));
+assertEquals("%E2%82%AC", encodeURIComponent("\u20ac"));
+assertEquals("x%F0%9F%98%80", encodeURIComponent("x\ud83d\ude00"));
+
+// Malformed input still throws.
+assertThrows(function() { decodeURIComponent("%"); }, URIError);
+assertThrows(function() { decodeURIComponent("ab%4"); }, URIError);
+assertThrows(function() { decodeURIComponent("%zz"); }, URIError);
+assertThrows(function() { decodeURI("%C3"); }, URIError);
+assertThrows(function() { encodeURIComponent("\udc00"); }, URIError);
+
+// Cons and sliced strings are flattened first.
+assertEquals("a%20b%2Fc", encodeURIComponent("a b" + String("/c")));
+var long = "0123456789abcdefghij0123456789 " + Math.random().toFixed(1);
+assertEquals(long.replace(" ", "%20"), encodeURI(long));
+assertEquals(long, decodeURI(encodeURI(long).substring(0)));
+
+// Non-string arguments are converted.
+assertEquals("12", encodeURIComponent(12));
+assertEquals("undefined", decodeURI(undefined));
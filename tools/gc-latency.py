@@ -0,0 +1,152 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 the V8 project authors. All rights reserved.
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#     * Redistributions in binary form must reproduce the above
+#       copyright notice, this list of conditions and the following
+#       disclaimer in the documentation and/or other materials provided
+#       with the distribution.
+#     * Neither the name of Google Inc. nor the names of its
+#       contributors may be used to endorse or promote products derived
+#       from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""GC latency benchmark runner.
+
+Runs the allocation-heavy workloads in benchmarks/gc-latency through d8
+with --trace-gc --trace-gc-nvp.  It rebuilds the GC timeline from the
+mutator= and pause= fields of the GCTracer output and reports pause time
+percentiles and minimum mutator utilization (MMU) per workload.
+
+The MMU for a window size w is the smallest fraction of any w ms window
+during which the mutator runs.  Incremental marking steps are not pauses
+in the tracer output and are not included.
+
+Usage: gc-latency.py [--shell path/to/d8] [--flags "extra d8 flags"]
+                     [workload.js ...]
+"""
+
+from __future__ import print_function
+
+import bisect
+import optparse
+import os
+import re
+import subprocess
+import sys
+
+
+WORKLOAD_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            "..", "benchmarks", "gc-latency")
+MMU_WINDOWS = [1, 2, 5, 10, 20, 50, 100, 200, 500, 1000]
+FLAGS_PATTERN = re.compile(r"//\s+Flags:(.*)")
+
+
+def WorkloadFlags(path):
+  flags = []
+  with open(path) as f:
+    for line in f:
+      match = FLAGS_PATTERN.match(line)
+      if match: flags.extend(match.group(1).split())
+  return flags
+
+
+def RunWorkload(shell, extra_flags, path):
+  """Returns the list of (start, end) GC pause intervals in ms."""
+  command = ([shell, "--trace-gc", "--trace-gc-nvp"] + extra_flags +
+             WorkloadFlags(path) + [path])
+  output = subprocess.check_output(command, universal_newlines=True)
+  pauses = []
+  now = 0.0
+  for line in output.splitlines():
+    fields = dict(re.findall(r"(\w+)=([-\w.]+)", line))
+    if "pause" not in fields or "mutator" not in fields: continue
+    start = now + float(fields["mutator"])
+    now = start + float(fields["pause"])
+    pauses.append((start, now))
+  return pauses
+
+
+def Percentile(sorted_values, percent):
+  # Nearest-rank percentile.
+  if not sorted_values: return 0.0
+  rank = int(round(percent / 100.0 * len(sorted_values) + 0.5)) - 1
+  return sorted_values[max(0, min(rank, len(sorted_values) - 1))]
+
+
+def GCTimeIn(pauses, starts, begin, end):
+  """Returns the GC time inside [begin, end]."""
+  total = 0.0
+  i = max(0, bisect.bisect_right(starts, begin) - 1)
+  while i < len(pauses) and pauses[i][0] < end:
+    total += max(0.0, min(end, pauses[i][1]) - max(begin, pauses[i][0]))
+    i += 1
+  return total
+
+
+def MinimumMutatorUtilization(pauses, window):
+  if not pauses: return 1.0
+  duration = pauses[-1][1]
+  if window >= duration:
+    return 1.0 - sum(end - start for start, end in pauses) / duration
+  starts = [start for start, _ in pauses]
+  # The worst window starts at the beginning of a pause or ends at the end
+  # of one.
+  candidates = set()
+  for start, end in pauses:
+    candidates.add(min(start, duration - window))
+    candidates.add(max(0.0, end - window))
+  worst = 1.0
+  for begin in candidates:
+    gc_time = GCTimeIn(pauses, starts, begin, begin + window)
+    worst = min(worst, 1.0 - gc_time / window)
+  return max(0.0, worst)
+
+
+def Report(name, pauses):
+  durations = sorted(end - start for start, end in pauses)
+  print("%s: %d pauses, total %.1f ms in %.1f ms" %
+        (name, len(durations), sum(durations),
+         pauses[-1][1] if pauses else 0.0))
+  print("  pause p50 %.1f ms, p99 %.1f ms, max %.1f ms" %
+        (Percentile(durations, 50), Percentile(durations, 99),
+         durations[-1] if durations else 0.0))
+  print("  MMU " + ", ".join(
+      "%d ms: %.2f" % (window, MinimumMutatorUtilization(pauses, window))
+      for window in MMU_WINDOWS))
+
+
+def Main():
+  parser = optparse.OptionParser(usage=__doc__)
+  parser.add_option("--shell", default="d8",
+                    help="the d8 binary to run the workloads with")
+  parser.add_option("--flags", default="",
+                    help="extra flags passed to d8")
+  options, args = parser.parse_args()
+  workloads = args or sorted(
+      os.path.join(WORKLOAD_DIR, name) for name in os.listdir(WORKLOAD_DIR)
+      if name.endswith(".js"))
+  for path in workloads:
+    pauses = RunWorkload(options.shell, options.flags.split(), path)
+    Report(os.path.basename(path), pauses)
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(Main())
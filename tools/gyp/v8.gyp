@@ -255,6 +255,8 @@
         '../../src/api.h',
         '../../src/arguments.cc',
         '../../src/arguments.h',
+        '../../src/array-buffer-pool.cc',
+        '../../src/array-buffer-pool.h',
         '../../src/assembler.cc',
         '../../src/assembler.h',
         '../../src/assert-scope.h',
@@ -268,6 +270,8 @@
         '../../src/bignum.h',
         '../../src/bootstrapper.cc',
         '../../src/bootstrapper.h',
+        '../../src/bounded-mpmc-queue-inl.h',
+        '../../src/bounded-mpmc-queue.h',
         '../../src/builtins.cc',
         '../../src/builtins.h',
         '../../src/bytecodes-irregexp.h',
@@ -421,6 +425,8 @@
         '../../src/hydrogen-representation-changes.h',
         '../../src/hydrogen-sce.cc',
         '../../src/hydrogen-sce.h',
+        '../../src/hydrogen-try-catch.cc',
+        '../../src/hydrogen-try-catch.h',
         '../../src/hydrogen-uint32-analysis.cc',
         '../../src/hydrogen-uint32-analysis.h',
         '../../src/i18n.cc',
@@ -430,6 +436,8 @@
         '../../src/ic-inl.h',
         '../../src/ic.cc',
         '../../src/ic.h',
+        '../../src/ic-stats.cc',
+        '../../src/ic-stats.h',
         '../../src/incremental-marking.cc',
         '../../src/incremental-marking.h',
         '../../src/interface.cc',
@@ -467,11 +475,17 @@
         '../../src/log-utils.h',
         '../../src/log.cc',
         '../../src/log.h',
+        '../../src/lz-codec.cc',
+        '../../src/lz-codec.h',
         '../../src/macro-assembler.h',
         '../../src/mark-compact.cc',
         '../../src/mark-compact.h',
         '../../src/messages.cc',
         '../../src/messages.h',
+        '../../src/microtask-queue.cc',
+        '../../src/microtask-queue.h',
+        '../../src/mpsc-queue-inl.h',
+        '../../src/mpsc-queue.h',
         '../../src/natives.h',
         '../../src/objects-debug.cc',
         '../../src/objects-inl.h',
@@ -511,6 +525,8 @@
         '../../src/property-details.h',
         '../../src/property.cc',
         '../../src/property.h',
+        '../../src/regexp-linear.cc',
+        '../../src/regexp-linear.h',
         '../../src/regexp-macro-assembler-irregexp-inl.h',
         '../../src/regexp-macro-assembler-irregexp.cc',
         '../../src/regexp-macro-assembler-irregexp.h',
@@ -518,6 +534,8 @@
         '../../src/regexp-macro-assembler-tracer.h',
         '../../src/regexp-macro-assembler.cc',
         '../../src/regexp-macro-assembler.h',
+        '../../src/regexp-profile.cc',
+        '../../src/regexp-profile.h',
         '../../src/regexp-stack.cc',
         '../../src/regexp-stack.h',
         '../../src/rewriter.cc',
@@ -526,6 +544,8 @@
         '../../src/runtime-profiler.h',
         '../../src/runtime.cc',
         '../../src/runtime.h',
+        '../../src/ryu-dtoa.cc',
+        '../../src/ryu-dtoa.h',
         '../../src/safepoint-table.cc',
         '../../src/safepoint-table.h',
         '../../src/sampler.cc',
@@ -560,6 +580,7 @@
         '../../src/stub-cache.h',
         '../../src/sweeper-thread.h',
         '../../src/sweeper-thread.cc',
+        '../../src/timsort.h',
         '../../src/token.cc',
         '../../src/token.h',
         '../../src/transitions-inl.h',
@@ -596,6 +617,8 @@
         '../../src/v8threads.h',
         '../../src/v8utils.cc',
         '../../src/v8utils.h',
+        '../../src/value-serializer.cc',
+        '../../src/value-serializer.h',
         '../../src/variables.cc',
         '../../src/variables.h',
         '../../src/version.cc',
@@ -1075,7 +1098,8 @@
           '../../src/array-iterator.js',
           '../../src/harmony-string.js',
           '../../src/harmony-array.js',
-          '../../src/harmony-math.js'
+          '../../src/harmony-math.js',
+          '../../src/harmony-atomics.js'
         ],
       },
       'actions': [
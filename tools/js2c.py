@@ -374,7 +374,8 @@ def JS2C(source, target, env):
     module_offset += raw_length
   total_length = raw_total_length = module_offset
 
-  if env['COMPRESSION'] == 'off':
+  # The lz compression only applies to the snapshot, not to the natives.
+  if env['COMPRESSION'] in ('off', 'lz'):
     raw_sources_declaration = RAW_SOURCES_DECLARATION
     sources_data = ToCAsciiArray("".join(all_sources))
   else:
@@ -40,6 +40,7 @@ import sys
 import time
 
 from testrunner.local import execution
+from testrunner.local import gcstats
 from testrunner.local import progress
 from testrunner.local import testsuite
 from testrunner.local import utils
@@ -119,6 +120,14 @@ def BuildOptions():
   result.add_option("--pass-fail-tests",
                     help="Regard pass|fail tests (run|skip|dontcare)",
                     default="dontcare")
+  result.add_option("--gc-stats",
+                    help="Collect the GC statistics of every test, report "
+                    "them and write them to the given JSON file",
+                    default="")
+  result.add_option("--gc-stats-baseline",
+                    help="JSON file written by an earlier --gc-stats run to "
+                    "report per-test GC time, pause and throughput deltas "
+                    "against", default="")
   result.add_option("--gc-stress",
                     help="Switch on GC stress mode",
                     default=False, action="store_true")
@@ -185,6 +194,9 @@ def BuildOptions():
                     default=False, action="store_true")
   result.add_option("-t", "--timeout", help="Timeout in seconds",
                     default= -1, type="int")
+  result.add_option("--verify-heap-sample",
+                    help="With --verify-heap, only verify every n-th page "
+                    "per GC", default=0, type="int")
   result.add_option("-v", "--verbose", help="Verbose output",
                     default=False, action="store_true")
   result.add_option("--valgrind", help="Run tests through valgrind",
@@ -242,6 +254,18 @@ def ProcessOptions(options):
   if options.gc_stress:
     options.extra_flags += GC_STRESS_FLAGS
 
+  if options.gc_stats_baseline and not options.gc_stats:
+    print("--gc-stats-baseline requires --gc-stats.")
+    return False
+  if options.gc_stats:
+    print("Collecting GC statistics disables network distribution, "
+          "running tests locally.")
+    options.no_network = True
+    options.extra_flags += gcstats.FLAGS
+  if options.verify_heap_sample:
+    options.extra_flags.append(
+        "--verify-heap-sample=%d" % options.verify_heap_sample)
+
   if options.j == 0:
     options.j = multiprocessing.cpu_count()
 
@@ -475,6 +499,8 @@ def Execute(arch, mode, args, options, suites, workspace):
                                                  ctx, peers, workspace)
     else:
       runner = execution.Runner(suites, progress_indicator, ctx)
+      if options.gc_stats:
+        runner.gc_stats = gcstats.GCStats(options.gc_stats_baseline)
 
     exit_code = runner.Run(options.j)
     if runner.terminate:
@@ -485,6 +511,9 @@ def Execute(arch, mode, args, options, suites, workspace):
 
   if options.time:
     verbose.PrintTestDurations(suites, overall_duration)
+  if options.gc_stats:
+    runner.gc_stats.Report()
+    runner.gc_stats.Write(options.gc_stats)
   return exit_code
 
 
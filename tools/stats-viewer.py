@@ -54,6 +54,7 @@ COUNTER_LABELS = {"t": "%i ms.", "c": "%i"}
 
 # The magic numbers used to check if a file is not a counters file
 COUNTERS_FILE_MAGIC_NUMBER = 0xDEADFACE
+COUNTERS_FILE_VERSION = 2
 CHROME_COUNTERS_FILE_MAGIC_NUMBER = 0x13131313
 
 
@@ -327,24 +328,43 @@ class SharedDataAccess(object):
 class Counter(object):
   """A pointer to a single counter withing a binary counters file."""
 
-  def __init__(self, data, offset):
+  def __init__(self, data, offset, max_buckets):
     """Create a new instance.
 
     Args:
       data: the shared data access object containing the counter
       offset: the byte offset of the start of this counter
+      max_buckets: the number of histogram bucket slots in each counter
     """
     self.data = data
     self.offset = offset
+    self.max_buckets = max_buckets
 
   def Value(self):
-    """Return the integer value of this counter."""
+    """Return the integer value of this counter.  For histograms this is
+    the number of samples."""
     return self.data.IntAt(self.offset)
 
+  def SampleTotal(self):
+    """Return the sum of all samples of a histogram."""
+    return self.data.IntAt(self.offset + 4)
+
+  def IsHistogram(self):
+    return self.data.IntAt(self.offset + 8) != 0
+
+  def Buckets(self):
+    """Return the (min, max, bucket counts) of a histogram."""
+    bucket_count = self.data.IntAt(self.offset + 20)
+    counts = [self.data.IntAt(self.offset + 24 + 4 * i)
+              for i in xrange(bucket_count)]
+    return (self.data.IntAt(self.offset + 12),
+            self.data.IntAt(self.offset + 16),
+            counts)
+
   def Name(self):
     """Return the ascii name of this counter."""
     result = ""
-    index = self.offset + 4
+    index = self.offset + 24 + 4 * self.max_buckets
     current = self.data.ByteAt(index)
     while current:
       result += chr(current)
@@ -364,20 +384,26 @@ class CounterCollection(object):
       data: the shared data access object
     """
     self.data = data
-    self.max_counters = data.IntAt(4)
-    self.max_name_size = data.IntAt(8)
+    self.version = data.IntAt(4)
+    if self.version != COUNTERS_FILE_VERSION:
+      print "Unsupported counters file version %d." % self.version
+      sys.exit(1)
+    self.max_counters = data.IntAt(8)
+    self.max_name_size = data.IntAt(12)
+    self.max_buckets = data.IntAt(16)
 
   def CountersInUse(self):
     """Return the number of counters in active use."""
-    return self.data.IntAt(12)
+    return self.data.IntAt(20)
 
   def Counter(self, index):
     """Return the index'th counter."""
-    return Counter(self.data, 16 + index * self.CounterSize())
+    return Counter(self.data, 24 + index * self.CounterSize(),
+                   self.max_buckets)
 
   def CounterSize(self):
     """Return the size of a single counter."""
-    return 4 + self.max_name_size
+    return 24 + 4 * self.max_buckets + self.max_name_size
 
 
 class ChromeCounter(object):
@@ -85,6 +85,9 @@ class Runner(object):
     self.crashed = 0
     self.terminate = False
     self.lock = threading.Lock()
+    # Optional gcstats.GCStats instance that takes the GC statistics out of
+    # the output of every test before it is checked.
+    self.gc_stats = None
 
   def Run(self, jobs):
     self.indicator.Starting()
@@ -138,6 +141,8 @@ class Runner(object):
         self.indicator.AboutToRun(test)
         test.output = result[1]
         test.duration = result[2]
+        if self.gc_stats:
+          self.gc_stats.Extract(test)
         has_unexpected_output = test.suite.HasUnexpectedOutput(test)
         if has_unexpected_output:
           self.failed.append(test)
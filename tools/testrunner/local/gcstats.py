@@ -0,0 +1,127 @@
+# Copyright 2014 the V8 project authors. All rights reserved.
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#     * Redistributions in binary form must reproduce the above
+#       copyright notice, this list of conditions and the following
+#       disclaimer in the documentation and/or other materials provided
+#       with the distribution.
+#     * Neither the name of Google Inc. nor the names of its
+#       contributors may be used to endorse or promote products derived
+#       from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+
+import json
+import re
+
+
+# Heap::TearDown prints one line of this form per isolate when running with
+# --print-cumulative-gc-stat, surrounded by empty lines.
+STAT_LINE = re.compile(r"\n?(gc_count=[^\n]*)\n\n?")
+
+# Statistics that are summed up over the isolates of a test, all others
+# are maximized.
+SUMMED_STATS = ["gc_count", "mark_sweep_count", "total_gc_time",
+                "total_marking_time", "total_sweeping_time"]
+
+# Statistics that are compared against the baseline.
+REPORTED_STATS = ["total_gc_time", "max_gc_pause", "gc_count"]
+
+FLAGS = ["--print-cumulative-gc-stat"]
+
+
+def ParseStatLine(line):
+  stats = {}
+  for pair in line.split():
+    key, _, value = pair.partition("=")
+    try:
+      stats[key] = float(value)
+    except ValueError:
+      pass
+  return stats
+
+
+class GCStats(object):
+  """Collects per-test GC statistics and compares them to a baseline."""
+
+  def __init__(self, baseline_file):
+    self.stats = {}
+    self.baseline = {}
+    if baseline_file:
+      with open(baseline_file) as f:
+        self.baseline = json.load(f)
+
+  def Extract(self, test):
+    """Removes the statistics from the test's stdout, so that suites which
+    compare the output are not affected, and records them."""
+    output = test.output
+    if output is None or not output.stdout:
+      return
+    lines = STAT_LINE.findall(output.stdout)
+    if not lines:
+      return
+    output.stdout = STAT_LINE.sub("\n", output.stdout).lstrip("\n")
+    stats = {}
+    for line in lines:
+      for key, value in ParseStatLine(line).iteritems():
+        if key in SUMMED_STATS:
+          stats[key] = stats.get(key, 0) + value
+        else:
+          stats[key] = max(stats.get(key, value), value)
+    # The share of the test's wall time not spent in GC.
+    duration_ms = test.duration * 1000
+    if duration_ms > 0:
+      stats["throughput"] = max(
+          0.0, 1.0 - stats.get("total_gc_time", 0) / duration_ms)
+    self.stats[test.GetLabel()] = stats
+
+  def Write(self, filename):
+    with open(filename, "w") as f:
+      json.dump(self.stats, f, indent=2, sort_keys=True)
+
+  def Report(self, count=20):
+    if not self.stats:
+      print "No GC statistics were collected."
+      return
+    if not self.baseline:
+      total = sum([s.get("total_gc_time", 0) for s in self.stats.values()])
+      pause = max([s.get("max_gc_pause", 0) for s in self.stats.values()])
+      print ("GC statistics for %d tests: total GC time %.1f ms, "
+             "max pause %.1f ms" % (len(self.stats), total, pause))
+      return
+    deltas = []
+    for label, stats in self.stats.iteritems():
+      base = self.baseline.get(label)
+      if base is None:
+        continue
+      delta = dict([(key, stats.get(key, 0) - base.get(key, 0))
+                    for key in REPORTED_STATS + ["throughput"]])
+      deltas.append((label, delta))
+    deltas.sort(key=lambda d: -abs(d[1]["total_gc_time"]))
+    print "--- GC deltas against the baseline (%d tests) ---" % len(deltas)
+    print "%-50s %10s %10s %8s %11s" % (
+        "test", "gc time", "max pause", "gcs", "throughput")
+    for label, delta in deltas[:count]:
+      print "%-50s %+10.1f %+10.1f %+8d %+10.1f%%" % (
+          label[-50:], delta["total_gc_time"], delta["max_gc_pause"],
+          delta["gc_count"], delta["throughput"] * 100)
+    if deltas:
+      print "Total GC time delta: %+.1f ms, mean throughput delta: %+.1f%%" % (
+          sum([d["total_gc_time"] for _, d in deltas]),
+          sum([d["throughput"] for _, d in deltas]) * 100 / len(deltas))